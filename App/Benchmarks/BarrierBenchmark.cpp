@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/RenderPass/Public/BarrierBatch.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 BATCH_RESOURCES = 256;
+		constexpr uint32 BATCH_PUSHES = 384; // half again as many pushes as resources: duplicates get merged
+		constexpr uint32 BATCH_ROUNDS = 4096;
+		constexpr int32 MAX_UNIQUE_ID = 1 << 30;
+
+		// BarrierBatch never dereferences the resource, so addresses of plain
+		// storage stand in for device objects.
+		struct FakeResources final
+		{
+			std::vector<uint64> Storage;
+
+			explicit FakeResources(uint32 count)
+				: Storage(count)
+			{
+			}
+
+			IDeviceObject* Get(uint32 i) { return reinterpret_cast<IDeviceObject*>(&Storage[i]); }
+		};
+
+		uint32 g_Failures = 0;
+
+		void check(bool bCondition, const char* what)
+		{
+			std::printf("  %-58s %s\n", what, bCondition ? "ok" : "FAILED");
+			if (!bCondition)
+			{
+				++g_Failures;
+			}
+		}
+
+		void verifyBatch()
+		{
+			FakeResources res(4);
+			IDeviceObject* a = res.Get(0);
+			IDeviceObject* b = res.Get(1);
+			IDeviceObject* c = res.Get(2);
+			IDeviceObject* d = res.Get(3);
+
+			BarrierBatch batch;
+
+			// Read-only states of one resource are merged into one barrier.
+			batch.Reset();
+			batch.Push(a, 7, RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_SHADER_RESOURCE);
+			batch.Push(a, 7, RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_RENDER_TARGET, RESOURCE_STATE_COPY_SOURCE);
+			{
+				const std::span<const StateTransitionDesc> out = batch.Finalize();
+				check(out.size() == 1 && batch.GetStats().Merged == 1, "duplicate reads merge into one barrier");
+				check(out.size() == 1 && out[0].NewState == (RESOURCE_STATE_SHADER_RESOURCE | RESOURCE_STATE_COPY_SOURCE), "merged barrier carries both read states");
+			}
+
+			// Already in the requested state: dropped. UAV: always kept.
+			batch.Reset();
+			batch.Push(a, 7, RESOURCE_STATE_SHADER_RESOURCE, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+			batch.Push(b, 3, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS, RESOURCE_STATE_UNORDERED_ACCESS);
+			{
+				const std::span<const StateTransitionDesc> out = batch.Finalize();
+				check(batch.GetStats().Skipped == 1, "barrier to the tracked state is skipped");
+				check(out.size() == 1 && out[0].pResource == b, "UAV barrier is never skipped");
+			}
+
+			// Output is sorted by unique ID; IDs far beyond the batch size cost nothing.
+			batch.Reset();
+			batch.Push(c, MAX_UNIQUE_ID, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+			batch.Push(d, 2, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET);
+			batch.Push(a, 1 << 20, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_DEPTH_WRITE);
+			{
+				const std::span<const StateTransitionDesc> out = batch.Finalize();
+				check(out.size() == 3 && out[0].pResource == d && out[1].pResource == a && out[2].pResource == c, "barriers are sorted by unique ID (up to 2^30)");
+			}
+
+			// Conflicting writes are logged and the last push wins.
+			batch.Reset();
+			batch.Push(a, 5, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET);
+			batch.Push(a, 5, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS);
+			{
+				const std::span<const StateTransitionDesc> out = batch.Finalize();
+				check(out.size() == 1 && out[0].NewState == RESOURCE_STATE_UNORDERED_ACCESS, "conflicting write: last push wins (warning logged)");
+			}
+
+			// A finalized batch starts empty; IDs from the previous batch are not merged.
+			batch.Push(a, 5, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+			{
+				const std::span<const StateTransitionDesc> out = batch.Finalize();
+				check(out.size() == 1 && out[0].NewState == RESOURCE_STATE_SHADER_RESOURCE, "pushes after Finalize() start a new batch");
+			}
+		}
+	} // namespace
+
+	// Checks the batching rules, then times Push + Finalize for passes of
+	// BATCH_RESOURCES resources whose unique IDs are spread over [1, 2^30].
+	SHZ_BENCHMARK(BarrierBatch)
+	{
+		g_Failures = 0;
+		verifyBatch();
+		std::printf("%s\n", g_Failures == 0 ? "all checks passed" : "CHECKS FAILED");
+
+		FakeResources res(BATCH_RESOURCES);
+		std::vector<int32> ids(BATCH_RESOURCES);
+		std::mt19937 rng(1234);
+		std::uniform_int_distribution<int32> idDist(1, MAX_UNIQUE_ID);
+		for (int32& id : ids)
+		{
+			id = idDist(rng);
+		}
+
+		const RESOURCE_STATE READ_STATES[] = { RESOURCE_STATE_SHADER_RESOURCE, RESOURCE_STATE_VERTEX_BUFFER, RESOURCE_STATE_COPY_SOURCE };
+
+		std::vector<uint32> order(BATCH_PUSHES);
+		for (uint32 i = 0; i < BATCH_PUSHES; ++i)
+		{
+			order[i] = i % BATCH_RESOURCES;
+		}
+		std::shuffle(order.begin(), order.end(), rng);
+
+		BarrierBatch batch;
+		uint64 emitted = 0;
+		const double seconds = RunOnThreads(1, [&](uint32)
+			{
+				for (uint32 round = 0; round < BATCH_ROUNDS; ++round)
+				{
+					batch.Reset();
+					for (uint32 i = 0; i < BATCH_PUSHES; ++i)
+					{
+						const uint32 r = order[i];
+						batch.Push(res.Get(r), ids[r], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNKNOWN, READ_STATES[(r + i) % 3]);
+					}
+					emitted += batch.Finalize().size();
+				}
+			});
+		DoNotOptimize(emitted);
+
+		const BarrierBatchStats& stats = batch.GetStats();
+		std::printf("%u pushes -> %u barriers per batch (%u merged)\n", stats.Pushed, stats.Emitted, stats.Merged);
+		std::printf("%.1f ns per push (Push + Finalize), %.2f us per batch\n",
+			seconds * 1e9 / (static_cast<double>(BATCH_PUSHES) * BATCH_ROUNDS),
+			seconds * 1e6 / BATCH_ROUNDS);
+	}
+} // namespace shz
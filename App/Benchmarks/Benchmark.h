@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Common/Public/Timer.hpp"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// Benchmarks
+	// - Each benchmark registers itself with SHZ_BENCHMARK(Name) and
+	//   prints its own results.
+	// - App-Benchmarks [name ...] runs the named benchmarks (all of them
+	//   without arguments). Build Release|x64 before quoting numbers.
+	// ------------------------------------------------------------
+	using BenchmarkFn = void (*)();
+
+	struct BenchmarkEntry final
+	{
+		const char* Name = nullptr;
+		BenchmarkFn Run = nullptr;
+	};
+
+	inline std::vector<BenchmarkEntry>& GetBenchmarks()
+	{
+		static std::vector<BenchmarkEntry> s_Benchmarks;
+		return s_Benchmarks;
+	}
+
+	struct BenchmarkRegistrar final
+	{
+		BenchmarkRegistrar(const char* name, BenchmarkFn run)
+		{
+			GetBenchmarks().push_back(BenchmarkEntry{ name, run });
+		}
+	};
+
+#define SHZ_BENCHMARK(Name)                                                       \
+	static void Benchmark_##Name();                                               \
+	static const ::shz::BenchmarkRegistrar s_BenchmarkRegistrar_##Name{ #Name, &Benchmark_##Name }; \
+	static void Benchmark_##Name()
+
+	// Folds value into a volatile sink so the work producing it is not optimized away.
+	inline volatile uint8 g_BenchmarkSink = 0;
+
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		const uint8* pBytes = reinterpret_cast<const uint8*>(&value);
+		uint8 folded = 0;
+		for (size_t i = 0; i < sizeof(T); ++i)
+		{
+			folded = static_cast<uint8>(folded ^ pBytes[i]);
+		}
+		g_BenchmarkSink = static_cast<uint8>(g_BenchmarkSink ^ folded);
+	}
+
+	// Runs body(threadIndex) on threadCount threads released together and
+	// returns the wall time in seconds from the release to the last finish.
+	template <typename BodyType>
+	double RunOnThreads(uint32 threadCount, const BodyType& body)
+	{
+		std::atomic<uint32> ready = 0;
+		std::atomic<bool> go = false;
+
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount);
+		for (uint32 t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					ready.fetch_add(1, std::memory_order_acq_rel);
+					while (!go.load(std::memory_order_acquire))
+					{
+						std::this_thread::yield();
+					}
+					body(t);
+				});
+		}
+
+		while (ready.load(std::memory_order_acquire) != threadCount)
+		{
+			std::this_thread::yield();
+		}
+
+		Timer timer;
+		go.store(true, std::memory_order_release);
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		return timer.GetElapsedTime();
+	}
+} // namespace shz
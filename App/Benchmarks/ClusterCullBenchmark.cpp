@@ -0,0 +1,259 @@
+#include <cmath>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/Core/Math/Public/ViewFrustum.h"
+#include "Engine/Renderer/Public/RenderScene.h"
+#include "Engine/RuntimeData/Public/StaticMeshClusterBuilder.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 SPHERE_RINGS = 256;
+		constexpr uint32 SPHERE_SEGMENTS = 256;
+		constexpr uint32 TERRAIN_QUADS = 256;
+		constexpr float TERRAIN_SIZE = 512.f;
+		constexpr uint32 VIEW_COUNT = 16;
+		constexpr uint32 TIMING_ROUNDS = 64;
+		constexpr float PI = 3.14159265f;
+
+		StaticMesh makeMesh(std::vector<float3>&& positions, std::vector<float3>&& normals, std::vector<uint32>&& indices)
+		{
+			StaticMesh mesh;
+
+			StaticMesh::Section section = {};
+			section.IndexCount = static_cast<uint32>(indices.size());
+
+			mesh.SetPositions(std::move(positions));
+			mesh.SetNormals(std::move(normals));
+			mesh.SetIndicesU32(std::move(indices));
+			mesh.SetSections({ section });
+			mesh.RecomputeBounds();
+
+			StaticMeshClusterBuilder::Build(&mesh);
+			return mesh;
+		}
+
+		// Unit UV sphere, outward facing, clockwise front faces (the engine's LH convention).
+		StaticMesh makeSphere()
+		{
+			std::vector<float3> positions;
+			std::vector<float3> normals;
+			for (uint32 r = 0; r <= SPHERE_RINGS; ++r)
+			{
+				const float theta = PI * static_cast<float>(r) / SPHERE_RINGS;
+				for (uint32 s = 0; s <= SPHERE_SEGMENTS; ++s)
+				{
+					const float phi = 2.f * PI * static_cast<float>(s) / SPHERE_SEGMENTS;
+					const float3 n(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+					positions.push_back(n);
+					normals.push_back(n);
+				}
+			}
+
+			std::vector<uint32> indices;
+			const uint32 stride = SPHERE_SEGMENTS + 1;
+			for (uint32 r = 0; r < SPHERE_RINGS; ++r)
+			{
+				for (uint32 s = 0; s < SPHERE_SEGMENTS; ++s)
+				{
+					const uint32 i0 = r * stride + s;
+					const uint32 i1 = i0 + 1;
+					const uint32 i2 = i0 + stride;
+					const uint32 i3 = i2 + 1;
+					indices.insert(indices.end(), { i0, i1, i2, i1, i3, i2 });
+				}
+			}
+			return makeMesh(std::move(positions), std::move(normals), std::move(indices));
+		}
+
+		// TERRAIN_SIZE square grid centred on the origin with gentle hills.
+		StaticMesh makeTerrain()
+		{
+			auto height = [](float x, float z) { return 6.f * std::sin(x * 0.03f) * std::cos(z * 0.025f); };
+
+			std::vector<float3> positions;
+			std::vector<float3> normals;
+			const float cell = TERRAIN_SIZE / TERRAIN_QUADS;
+			for (uint32 z = 0; z <= TERRAIN_QUADS; ++z)
+			{
+				for (uint32 x = 0; x <= TERRAIN_QUADS; ++x)
+				{
+					const float px = static_cast<float>(x) * cell - TERRAIN_SIZE * 0.5f;
+					const float pz = static_cast<float>(z) * cell - TERRAIN_SIZE * 0.5f;
+					positions.push_back(float3(px, height(px, pz), pz));
+
+					const float dx = height(px + 0.5f, pz) - height(px - 0.5f, pz);
+					const float dz = height(px, pz + 0.5f) - height(px, pz - 0.5f);
+					normals.push_back(float3(-dx, 1.f, -dz).Normalized());
+				}
+			}
+
+			std::vector<uint32> indices;
+			const uint32 stride = TERRAIN_QUADS + 1;
+			for (uint32 z = 0; z < TERRAIN_QUADS; ++z)
+			{
+				for (uint32 x = 0; x < TERRAIN_QUADS; ++x)
+				{
+					const uint32 i0 = z * stride + x;
+					const uint32 i1 = i0 + 1;
+					const uint32 i2 = i0 + stride;
+					const uint32 i3 = i2 + 1;
+					indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+				}
+			}
+			return makeMesh(std::move(positions), std::move(normals), std::move(indices));
+		}
+
+		// What Renderer::CreateStaticMeshRenderData keeps for culling, without GPU buffers.
+		StaticMeshRenderData makeRenderData(const StaticMesh& mesh)
+		{
+			StaticMeshRenderData out = {};
+			out.IndexCount = mesh.GetIndexCount();
+			out.LocalBounds = mesh.GetBounds();
+
+			for (const StaticMesh::Section& s : mesh.GetSections())
+			{
+				StaticMeshRenderData::Section d = {};
+				d.FirstIndex = s.FirstIndex;
+				d.IndexCount = s.IndexCount;
+				d.LocalBounds = s.LocalBounds;
+				d.FirstCluster = s.FirstCluster;
+				d.ClusterCount = s.ClusterCount;
+				d.bFrontCounterClockwise = false;
+				out.Sections.push_back(d);
+			}
+
+			for (const StaticMesh::Cluster& c : mesh.GetClusters())
+			{
+				StaticMeshRenderData::Cluster d = {};
+				d.FirstIndex = c.FirstIndex;
+				d.IndexCount = c.IndexCount;
+				d.Center = c.Center;
+				d.Radius = c.Radius;
+				d.ConeAxis = c.ConeAxis;
+				d.ConeCutoff = c.ConeCutoff;
+				out.Clusters.push_back(d);
+			}
+			return out;
+		}
+
+		struct CullView final
+		{
+			float3 Eye = {};
+			ViewFrustum Frustum = {};
+		};
+
+		CullView makeView(const float3& eye, const float3& at)
+		{
+			CullView v = {};
+			v.Eye = eye;
+			const Matrix4x4 viewProj = Matrix4x4::LookAtLH(eye, at, float3(0.f, 1.f, 0.f)) * Matrix4x4::PerspectiveFovLH(PI / 3.f, 16.f / 9.f, 0.1f, 2000.f);
+			ExtractViewFrustumPlanesFromMatrix(viewProj, v.Frustum);
+			return v;
+		}
+
+		// VIEW_COUNT views with the eye on a circle (radius, height) around the origin, looking at 'at(angle)'.
+		template <typename AtFnType>
+		std::vector<CullView> orbit(float radius, float height, const AtFnType& at)
+		{
+			std::vector<CullView> views;
+			for (uint32 i = 0; i < VIEW_COUNT; ++i)
+			{
+				const float a = 2.f * PI * static_cast<float>(i) / VIEW_COUNT;
+				const float3 eye(radius * std::cos(a), height, radius * std::sin(a));
+				views.push_back(makeView(eye, at(eye, a)));
+			}
+			return views;
+		}
+
+		// Every kept cluster run is its own draw: what the range merging is measured against.
+		constexpr RenderScene::ClusterRangeSettings UNMERGED_RANGES = { 0, ~0u, 2.f };
+
+		void runScenario(const char* name, const StaticMeshRenderData& mesh, const std::vector<CullView>& views, bool bConeTest, const RenderScene::ClusterRangeSettings& settings)
+		{
+			ArenaAllocator arena;
+			arena.InitializeGrowable(1u << 16);
+			ArenaVector<RenderScene::IndexRange> ranges(STD_ARENA_ALLOCATOR(RenderScene::IndexRange, arena, "ClusterRanges"));
+			ranges.reserve(mesh.Clusters.size());
+
+			RenderScene::ClusterCullStats stats = {};
+			for (const CullView& v : views)
+			{
+				RenderScene::CullSectionClusters(mesh, 0, Matrix4x4::Identity(), v.Frustum, bConeTest ? &v.Eye : nullptr, ranges, &stats, &settings);
+			}
+
+			const double seconds = RunOnThreads(1, [&](uint32)
+				{
+					for (uint32 round = 0; round < TIMING_ROUNDS; ++round)
+					{
+						for (const CullView& v : views)
+						{
+							RenderScene::CullSectionClusters(mesh, 0, Matrix4x4::Identity(), v.Frustum, bConeTest ? &v.Eye : nullptr, ranges, nullptr, &settings);
+							DoNotOptimize(ranges.size());
+						}
+					}
+				});
+
+			const double n = static_cast<double>(views.size());
+			std::printf("%-22s %-8s %9.0f %9.0f %10.0f %10.0f %10.0f %7.1f%% %8.1f %6.0f %9.2f\n",
+				name,
+				&settings == &UNMERGED_RANGES ? "none" : "default",
+				static_cast<double>(stats.ClustersTested) / n,
+				static_cast<double>(stats.ClustersKept) / n,
+				static_cast<double>(stats.TrianglesTested) / n,
+				static_cast<double>(stats.TrianglesKept) / n,
+				static_cast<double>(stats.TrianglesDrawn) / n,
+				100.0 * (1.0 - static_cast<double>(stats.TrianglesDrawn) / static_cast<double>(stats.TrianglesTested)),
+				static_cast<double>(stats.RangesEmitted) / n,
+				static_cast<double>(stats.SectionsDrawnWhole),
+				seconds * 1e6 / (n * TIMING_ROUNDS));
+		}
+
+		void runScenario(const char* name, const StaticMeshRenderData& mesh, const std::vector<CullView>& views, bool bConeTest)
+		{
+			static const RenderScene::ClusterRangeSettings s_Default = {};
+			runScenario(name, mesh, views, bConeTest, UNMERGED_RANGES);
+			runScenario(name, mesh, views, bConeTest, s_Default);
+		}
+	} // namespace
+
+	// RenderScene::CullSectionClusters on meshes clustered by StaticMeshClusterBuilder:
+	// clusters / triangles kept and triangles drawn per view (averaged over VIEW_COUNT
+	// views), the share of triangles not drawn, index ranges (draws) per view, views
+	// drawn as a whole section and the CPU cost of one call. Each scenario runs without
+	// range merging ("none") and with the default ClusterRangeSettings.
+	SHZ_BENCHMARK(ClusterCull)
+	{
+		const StaticMesh sphereMesh = makeSphere();
+		const StaticMesh terrainMesh = makeTerrain();
+		const StaticMeshRenderData sphere = makeRenderData(sphereMesh);
+		const StaticMeshRenderData terrain = makeRenderData(terrainMesh);
+
+		std::printf("sphere: %u triangles, %u clusters; terrain: %u triangles, %u clusters\n",
+			sphere.IndexCount / 3, static_cast<uint32>(sphere.Clusters.size()),
+			terrain.IndexCount / 3, static_cast<uint32>(terrain.Clusters.size()));
+		std::printf("%-22s %-8s %9s %9s %10s %10s %10s %8s %8s %6s %9s\n",
+			"scenario", "merge", "clusters", "kept", "triangles", "kept", "drawn", "culled", "ranges", "whole", "us/call");
+
+		auto atOrigin = [](const float3&, float) { return float3(0.f, 0.f, 0.f); };
+
+		// Whole sphere on screen: only the normal cones can cull.
+		const std::vector<CullView> sphereFar = orbit(4.f, 1.f, atOrigin);
+		runScenario("sphere, frustum only", sphere, sphereFar, false);
+		runScenario("sphere, frustum+cone", sphere, sphereFar, true);
+
+		// Close-up: part of the sphere leaves the frustum as well.
+		const std::vector<CullView> sphereNear = orbit(1.6f, 0.3f, [](const float3& eye, float) { return eye * 0.2f + float3(0.f, 0.6f, 0.f); });
+		runScenario("sphere close, f+cone", sphere, sphereNear, true);
+
+		// Ground-level camera in the middle of the terrain, looking outwards.
+		const std::vector<CullView> terrainGround = orbit(1.f, 12.f, [](const float3& eye, float) { return float3(eye.x * 100.f, 8.f, eye.z * 100.f); });
+		runScenario("terrain ground, f+cone", terrain, terrainGround, true);
+
+		// High overview: the whole terrain is visible and faces the camera.
+		const std::vector<CullView> terrainHigh = orbit(200.f, 600.f, atOrigin);
+		runScenario("terrain high, f+cone", terrain, terrainHigh, true);
+	}
+} // namespace shz
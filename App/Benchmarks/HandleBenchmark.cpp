@@ -0,0 +1,204 @@
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Primitives/Handle.hpp"
+
+namespace shz
+{
+	namespace
+	{
+		struct BenchObject final {};
+		using BenchHandle = Handle<BenchObject>;
+
+		constexpr uint32 THREAD_COUNTS[] = { 1, 2, 4, 8, 16 };
+		constexpr uint32 CHURN_ITERATIONS = 1u << 20;
+		constexpr uint32 LOOKUP_HANDLES = 4096;
+		constexpr uint32 LOOKUP_ROUNDS = 256;
+		constexpr uint32 BATCH_SIZE = 256;
+		constexpr uint32 BATCH_ROUNDS = 4096;
+
+		// The pool as it was before the per-thread caches: one shared_mutex around
+		// a generation vector and a free list. Kept here as the baseline.
+		class MutexHandlePool final
+		{
+		public:
+			MutexHandlePool() { m_Generations.push_back(0); }
+
+			uint64 Create()
+			{
+				std::unique_lock lock(m_Mutex);
+
+				uint32 index = 0;
+				if (!m_FreeList.empty())
+				{
+					index = m_FreeList.back();
+					m_FreeList.pop_back();
+				}
+				else
+				{
+					index = static_cast<uint32>(m_Generations.size());
+					m_Generations.push_back(1);
+				}
+				return (uint64{ m_Generations[index] } << 32) | index;
+			}
+
+			bool Destroy(uint64 h)
+			{
+				std::unique_lock lock(m_Mutex);
+
+				const uint32 index = static_cast<uint32>(h);
+				if (index == 0 || index >= m_Generations.size() || m_Generations[index] != static_cast<uint32>(h >> 32))
+				{
+					return false;
+				}
+
+				m_Generations[index] = (m_Generations[index] + 1 == 0) ? 1 : m_Generations[index] + 1;
+				m_FreeList.push_back(index);
+				return true;
+			}
+
+			bool IsAlive(uint64 h) const
+			{
+				std::shared_lock lock(m_Mutex);
+
+				const uint32 index = static_cast<uint32>(h);
+				return index != 0 && index < m_Generations.size() && m_Generations[index] == static_cast<uint32>(h >> 32);
+			}
+
+		private:
+			std::vector<uint32> m_Generations;
+			std::vector<uint32> m_FreeList;
+			mutable std::shared_mutex m_Mutex;
+		};
+
+		double mops(uint64 ops, double seconds)
+		{
+			return static_cast<double>(ops) / seconds * 1e-6;
+		}
+	} // namespace
+
+	// Create + IsAlive + Destroy per iteration on every thread.
+	SHZ_BENCHMARK(HandleChurn)
+	{
+		std::printf("%8s %16s %16s\n", "threads", "mutex Mops/s", "Handle Mops/s");
+
+		for (const uint32 threadCount : THREAD_COUNTS)
+		{
+			MutexHandlePool baseline;
+			const double baselineSeconds = RunOnThreads(threadCount, [&](uint32)
+				{
+					for (uint32 i = 0; i < CHURN_ITERATIONS; ++i)
+					{
+						const uint64 h = baseline.Create();
+						DoNotOptimize(baseline.IsAlive(h));
+						baseline.Destroy(h);
+					}
+				});
+
+			BenchHandle::ResetPool();
+			const double handleSeconds = RunOnThreads(threadCount, [&](uint32)
+				{
+					for (uint32 i = 0; i < CHURN_ITERATIONS; ++i)
+					{
+						const BenchHandle h = BenchHandle::Create();
+						DoNotOptimize(BenchHandle::IsAlive(h));
+						BenchHandle::Destroy(h);
+					}
+				});
+
+			const uint64 ops = uint64{ 3 } * CHURN_ITERATIONS * threadCount;
+			std::printf("%8u %16.1f %16.1f\n", threadCount, mops(ops, baselineSeconds), mops(ops, handleSeconds));
+		}
+	}
+
+	// Every thread checks the same live handles (render / ECS lookups).
+	SHZ_BENCHMARK(HandleLookup)
+	{
+		std::printf("%8s %16s %16s\n", "threads", "mutex Mops/s", "Handle Mops/s");
+
+		for (const uint32 threadCount : THREAD_COUNTS)
+		{
+			MutexHandlePool baseline;
+			std::vector<uint64> baselineHandles(LOOKUP_HANDLES);
+			for (uint64& h : baselineHandles)
+			{
+				h = baseline.Create();
+			}
+
+			BenchHandle::ResetPool();
+			std::vector<BenchHandle> handles(LOOKUP_HANDLES);
+			BenchHandle::CreateN(handles.data(), LOOKUP_HANDLES);
+
+			const double baselineSeconds = RunOnThreads(threadCount, [&](uint32)
+				{
+					uint32 alive = 0;
+					for (uint32 round = 0; round < LOOKUP_ROUNDS; ++round)
+					{
+						for (const uint64 h : baselineHandles)
+						{
+							alive += baseline.IsAlive(h) ? 1 : 0;
+						}
+					}
+					DoNotOptimize(alive);
+				});
+
+			const double handleSeconds = RunOnThreads(threadCount, [&](uint32)
+				{
+					uint32 alive = 0;
+					for (uint32 round = 0; round < LOOKUP_ROUNDS; ++round)
+					{
+						for (const BenchHandle h : handles)
+						{
+							alive += BenchHandle::IsAlive(h) ? 1 : 0;
+						}
+					}
+					DoNotOptimize(alive);
+				});
+
+			const uint64 ops = uint64{ LOOKUP_HANDLES } * LOOKUP_ROUNDS * threadCount;
+			std::printf("%8u %16.1f %16.1f\n", threadCount, mops(ops, baselineSeconds), mops(ops, handleSeconds));
+		}
+	}
+
+	// CreateN / DestroyN of BATCH_SIZE handles per round (bulk spawn and despawn).
+	SHZ_BENCHMARK(HandleBatch)
+	{
+		std::printf("%8s %16s %16s\n", "threads", "mutex Mops/s", "Handle Mops/s");
+
+		for (const uint32 threadCount : THREAD_COUNTS)
+		{
+			MutexHandlePool baseline;
+			const double baselineSeconds = RunOnThreads(threadCount, [&](uint32)
+				{
+					std::vector<uint64> batch(BATCH_SIZE);
+					for (uint32 round = 0; round < BATCH_ROUNDS; ++round)
+					{
+						for (uint64& h : batch)
+						{
+							h = baseline.Create();
+						}
+						for (const uint64 h : batch)
+						{
+							baseline.Destroy(h);
+						}
+					}
+				});
+
+			BenchHandle::ResetPool();
+			const double handleSeconds = RunOnThreads(threadCount, [&](uint32)
+				{
+					std::vector<BenchHandle> batch(BATCH_SIZE);
+					for (uint32 round = 0; round < BATCH_ROUNDS; ++round)
+					{
+						BenchHandle::CreateN(batch.data(), BATCH_SIZE);
+						BenchHandle::DestroyN(batch.data(), BATCH_SIZE);
+					}
+				});
+
+			const uint64 ops = uint64{ 2 } * BATCH_SIZE * BATCH_ROUNDS * threadCount;
+			std::printf("%8u %16.1f %16.1f\n", threadCount, mops(ops, baselineSeconds), mops(ops, handleSeconds));
+		}
+	}
+} // namespace shz
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/Renderer/Public/MaterialConstantPages.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 MATERIAL_COUNT = 4096;
+		constexpr uint32 FRAME_COUNT = 256;
+		constexpr uint32 PAGE_SIZE = 256u << 10;
+		constexpr uint32 ALIGNMENT = 256; // D3D12 constant buffer offset alignment
+
+		// Material constant blocks: a few float4 parameters up to a large uber-material.
+		constexpr uint32 CONSTANT_SIZES[] = { 48, 96, 160, 288, 640 };
+
+		struct MaterialState final
+		{
+			MaterialConstantAllocation Alloc = {};
+			std::vector<float> Constants;
+		};
+
+		// What the page buffers hold: only the collected spans are copied in.
+		struct PageMirror final
+		{
+			std::vector<std::vector<uint8>> Pages;
+
+			void Apply(const MaterialConstantPages& pages, const std::vector<MaterialConstantUpload>& uploads)
+			{
+				Pages.resize(pages.GetPageCount(), std::vector<uint8>(pages.GetPageSize(), 0xCD));
+				for (const MaterialConstantUpload& u : uploads)
+				{
+					std::memcpy(Pages[u.Page].data() + u.Begin, pages.GetPageData(u.Page) + u.Begin, u.End - u.Begin);
+				}
+			}
+
+			uint32 CountMismatches(const MaterialConstantPages& pages, const std::vector<MaterialState>& materials) const
+			{
+				uint32 mismatches = 0;
+				for (const MaterialState& m : materials)
+				{
+					const uint32 bytes = static_cast<uint32>(m.Constants.size() * sizeof(float));
+					mismatches += (std::memcmp(Pages[m.Alloc.Page].data() + m.Alloc.Offset, m.Constants.data(), bytes) != 0) ? 1 : 0;
+					mismatches += (std::memcmp(pages.GetPageData(m.Alloc.Page) + m.Alloc.Offset, m.Constants.data(), bytes) != 0) ? 1 : 0;
+				}
+				return mismatches;
+			}
+		};
+	} // namespace
+
+	// MaterialConstantPages (the CPU side of MaterialConstantPool) over
+	// MATERIAL_COUNT materials for FRAME_COUNT frames, with a share of them
+	// changing one parameter each frame and the rest re-writing unchanged
+	// constants (what Renderer does for every material it draws). Reports
+	// upload spans and bytes per frame against one full upload per changed
+	// material, and the CPU time of the writes plus the flush merge.
+	// Mismatches counts materials whose mirrored page bytes differ from their constants.
+	SHZ_BENCHMARK(MaterialConstantPool)
+	{
+		std::printf("%u materials, %u frames, %u KB pages, %u B alignment\n", MATERIAL_COUNT, FRAME_COUNT, PAGE_SIZE >> 10, ALIGNMENT);
+		std::printf("%-9s %6s %10s %10s %12s %12s %9s %10s %11s\n",
+			"changing", "pages", "changed/f", "spans/f", "upload KB/f", "full KB/f", "saved", "us/frame", "mismatches");
+
+		for (const float changingShare : { 0.01f, 0.1f, 0.5f, 1.f })
+		{
+			MaterialConstantPages pages;
+			pages.Initialize(PAGE_SIZE, ALIGNMENT);
+
+			std::mt19937 rng(1234);
+			std::vector<MaterialState> materials(MATERIAL_COUNT);
+			for (uint32 i = 0; i < MATERIAL_COUNT; ++i)
+			{
+				MaterialState& m = materials[i];
+				const uint32 bytes = CONSTANT_SIZES[rng() % std::size(CONSTANT_SIZES)];
+				m.Constants.assign(bytes / sizeof(float), 0.f);
+				for (float& f : m.Constants)
+				{
+					f = static_cast<float>(rng() % 1000) * 0.001f;
+				}
+				m.Alloc = pages.Allocate(bytes);
+			}
+
+			// Churn the free lists once: release and re-create every 7th material.
+			for (uint32 i = 0; i < MATERIAL_COUNT; i += 7)
+			{
+				pages.Free(materials[i].Alloc);
+				materials[i].Alloc = pages.Allocate(static_cast<uint32>(materials[i].Constants.size() * sizeof(float)));
+			}
+
+			std::vector<MaterialConstantUpload> uploads;
+			PageMirror mirror;
+			for (MaterialState& m : materials)
+			{
+				pages.Write(m.Alloc, m.Constants.data(), static_cast<uint32>(m.Constants.size() * sizeof(float)));
+			}
+			pages.CollectUploads(uploads);
+			mirror.Apply(pages, uploads);
+
+			const uint32 changingCount = std::max(1u, static_cast<uint32>(changingShare * MATERIAL_COUNT));
+
+			const uint64 initialChangedWrites = pages.GetStats().Writes - pages.GetStats().UnchangedWrites;
+			uint64 spans = 0;
+			uint64 uploadBytes = 0;
+			uint64 fullBytes = 0;
+			uint32 mismatches = 0;
+			double seconds = 0.0;
+
+			for (uint32 frame = 0; frame < FRAME_COUNT; ++frame)
+			{
+				// Animate one parameter of changingCount materials picked at random.
+				for (uint32 c = 0; c < changingCount; ++c)
+				{
+					MaterialState& m = materials[rng() % MATERIAL_COUNT];
+					m.Constants[rng() % m.Constants.size()] += 0.001f;
+					fullBytes += m.Constants.size() * sizeof(float);
+				}
+
+				uploads.clear();
+				seconds += RunOnThreads(1, [&](uint32)
+					{
+						for (const MaterialState& m : materials)
+						{
+							pages.Write(m.Alloc, m.Constants.data(), static_cast<uint32>(m.Constants.size() * sizeof(float)));
+						}
+						pages.CollectUploads(uploads);
+					});
+
+				spans += uploads.size();
+				uploadBytes += pages.GetStats().FlushedBytes;
+				mirror.Apply(pages, uploads);
+			}
+			mismatches += mirror.CountMismatches(pages, materials);
+
+			const MaterialConstantPoolStats& stats = pages.GetStats();
+			std::printf("%7.0f%% %6u %10.0f %10.1f %12.1f %12.1f %8.1f%% %10.1f %11u\n",
+				changingShare * 100.f,
+				stats.PageCount,
+				static_cast<double>(stats.Writes - stats.UnchangedWrites - initialChangedWrites) / FRAME_COUNT,
+				static_cast<double>(spans) / FRAME_COUNT,
+				static_cast<double>(uploadBytes) / (1024.0 * FRAME_COUNT),
+				static_cast<double>(fullBytes) / (1024.0 * FRAME_COUNT),
+				100.0 * (1.0 - static_cast<double>(uploadBytes) / static_cast<double>(std::max<uint64>(fullBytes, 1))),
+				seconds * 1e6 / FRAME_COUNT,
+				mismatches);
+		}
+	}
+} // namespace shz
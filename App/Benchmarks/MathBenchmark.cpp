@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/Core/Math/Public/Matrix4x4.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 MATRIX_COUNT = 1u << 16;
+		constexpr uint32 ROUNDS = 32;
+
+		// Matrix4x4 as it was before the XMatrix routing (the SHZ_FORCE_NO_SSE
+		// path). Kept here as the baseline and as the reference for agreement.
+		namespace Scalar
+		{
+			Matrix4x4 Mul(const Matrix4x4& a, const Matrix4x4& b)
+			{
+				Matrix4x4 r = Matrix4x4::Zero();
+				for (int i = 0; i < 4; ++i)
+				{
+					for (int j = 0; j < 4; ++j)
+					{
+						r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+					}
+				}
+				return r;
+			}
+
+			Matrix4x4 Transposed(const Matrix4x4& a)
+			{
+				Matrix4x4 r{};
+				for (int i = 0; i < 4; ++i)
+				{
+					for (int j = 0; j < 4; ++j)
+					{
+						r.m[i][j] = a.m[j][i];
+					}
+				}
+				return r;
+			}
+
+			// Gauss-Jordan with partial pivoting.
+			Matrix4x4 Inversed(const Matrix4x4& in)
+			{
+				Matrix4x4 a = in;
+				Matrix4x4 inv = Matrix4x4::Identity();
+
+				for (int col = 0; col < 4; ++col)
+				{
+					int pivotRow = col;
+					float32 pivotAbs = std::fabs(a.m[pivotRow][col]);
+					for (int r = col + 1; r < 4; ++r)
+					{
+						const float32 v = std::fabs(a.m[r][col]);
+						if (v > pivotAbs)
+						{
+							pivotAbs = v;
+							pivotRow = r;
+						}
+					}
+
+					if (pivotRow != col)
+					{
+						for (int c = 0; c < 4; ++c)
+						{
+							std::swap(a.m[col][c], a.m[pivotRow][c]);
+							std::swap(inv.m[col][c], inv.m[pivotRow][c]);
+						}
+					}
+
+					const float32 invPivot = 1.0f / a.m[col][col];
+					for (int c = 0; c < 4; ++c)
+					{
+						a.m[col][c] *= invPivot;
+						inv.m[col][c] *= invPivot;
+					}
+
+					for (int r = 0; r < 4; ++r)
+					{
+						if (r == col)
+							continue;
+
+						const float32 f = a.m[r][col];
+						if (std::fabs(f) < 1e-12f)
+							continue;
+
+						for (int c = 0; c < 4; ++c)
+						{
+							a.m[r][c] -= f * a.m[col][c];
+							inv.m[r][c] -= f * inv.m[col][c];
+						}
+					}
+				}
+				return inv;
+			}
+
+			Matrix4x4 InverseAffine(const Matrix4x4& a)
+			{
+				const Matrix3x3 invL = static_cast<Matrix3x3>(a).Inversed();
+				const Vector3 t = a.ExtractTranslation();
+				const Vector3 invT = invL.MulVector(Vector3(-t.x, -t.y, -t.z));
+
+				Matrix4x4 r = Matrix4x4::Identity();
+				r._m00 = invL._m00; r._m01 = invL._m01; r._m02 = invL._m02;
+				r._m10 = invL._m10; r._m11 = invL._m11; r._m12 = invL._m12;
+				r._m20 = invL._m20; r._m21 = invL._m21; r._m22 = invL._m22;
+				r._m30 = invT.x;    r._m31 = invT.y;    r._m32 = invT.z;
+				return r;
+			}
+
+			// S * Rx * Ry * Rz * T, as TRS was composed before the closed form.
+			Matrix4x4 TRS(const Vector3& t, const Vector3& euler, const Vector3& s)
+			{
+				return Mul(Mul(Mul(Mul(Matrix4x4::Scale(s), Matrix4x4::RotationX(euler.x)), Matrix4x4::RotationY(euler.y)), Matrix4x4::RotationZ(euler.z)), Matrix4x4::Translation(t));
+			}
+
+			// Transforms the 8 corners (what callers did before TransformBox).
+			Box TransformBox(const Matrix4x4& a, const Box& b)
+			{
+				Box out = {};
+				for (uint32 corner = 0; corner < 8; ++corner)
+				{
+					const Vector3 p((corner & 1) ? b.Max.x : b.Min.x, (corner & 2) ? b.Max.y : b.Min.y, (corner & 4) ? b.Max.z : b.Min.z);
+
+					Vector3 w = a.ExtractTranslation();
+					for (int j = 0; j < 3; ++j)
+					{
+						w[j] += p.x * a.m[0][j] + p.y * a.m[1][j] + p.z * a.m[2][j];
+					}
+
+					for (int j = 0; j < 3; ++j)
+					{
+						out.Min[j] = std::min(out.Min[j], w[j]);
+						out.Max[j] = std::max(out.Max[j], w[j]);
+					}
+				}
+				return out;
+			}
+		} // namespace Scalar
+
+		struct MathInputs final
+		{
+			std::vector<Vector3> Translations;
+			std::vector<Vector3> Eulers;
+			std::vector<Vector3> Scales;
+			std::vector<Matrix4x4> Affine;  // TRS with non-uniform scale
+			std::vector<Matrix4x4> General; // random, well conditioned
+			std::vector<Box> Boxes;
+		};
+
+		MathInputs makeInputs()
+		{
+			std::mt19937 rng(1234);
+			std::uniform_real_distribution<float32> pos(-100.f, 100.f);
+			std::uniform_real_distribution<float32> angle(-3.14159f, 3.14159f);
+			std::uniform_real_distribution<float32> scale(0.25f, 4.f);
+			std::uniform_real_distribution<float32> unit(-1.f, 1.f);
+
+			MathInputs in;
+			for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+			{
+				const Vector3 t(pos(rng), pos(rng), pos(rng));
+				const Vector3 e(angle(rng), angle(rng), angle(rng));
+				const Vector3 s(scale(rng), scale(rng), scale(rng));
+				in.Translations.push_back(t);
+				in.Eulers.push_back(e);
+				in.Scales.push_back(s);
+				in.Affine.push_back(Matrix4x4::TRS(t, e, s));
+
+				// Diagonally dominant keeps the general inverse well conditioned.
+				Matrix4x4 g = {};
+				for (int r = 0; r < 4; ++r)
+				{
+					for (int c = 0; c < 4; ++c)
+					{
+						g.m[r][c] = unit(rng) + ((r == c) ? 4.f : 0.f);
+					}
+				}
+				in.General.push_back(g);
+
+				const Vector3 mn(pos(rng), pos(rng), pos(rng));
+				in.Boxes.push_back(Box(mn, mn + Vector3(scale(rng), scale(rng), scale(rng))));
+			}
+			return in;
+		}
+
+		float32 maxAbsDiff(const Matrix4x4& a, const Matrix4x4& b)
+		{
+			float32 d = 0.f;
+			for (int r = 0; r < 4; ++r)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					d = std::max(d, std::fabs(a.m[r][c] - b.m[r][c]));
+				}
+			}
+			return d;
+		}
+
+		float32 maxAbsDiff(const Box& a, const Box& b)
+		{
+			float32 d = 0.f;
+			for (int j = 0; j < 3; ++j)
+			{
+				d = std::max(d, std::fabs(a.Min[j] - b.Min[j]));
+				d = std::max(d, std::fabs(a.Max[j] - b.Max[j]));
+			}
+			return d;
+		}
+
+		// max |M * inv(M) - I|
+		float32 inverseResidual(const Matrix4x4& m, const Matrix4x4& inv)
+		{
+			return maxAbsDiff(Scalar::Mul(m, inv), Matrix4x4::Identity());
+		}
+
+		// Runs op(i) over every input ROUNDS times, storing each result the way
+		// callers do; returns ns per call.
+		template <typename OpType>
+		double timeOp(const OpType& op)
+		{
+			std::vector<decltype(op(0))> results(MATRIX_COUNT);
+
+			const double seconds = RunOnThreads(1, [&](uint32)
+				{
+					for (uint32 round = 0; round < ROUNDS; ++round)
+					{
+						for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+						{
+							results[i] = op(i);
+						}
+					}
+				});
+
+			DoNotOptimize(results[MATRIX_COUNT / 2]);
+			return seconds * 1e9 / (static_cast<double>(MATRIX_COUNT) * ROUNDS);
+		}
+
+		void printRow(const char* name, double scalarNs, double engineNs, float32 agreement)
+		{
+			std::printf("%-16s %12.2f %12.2f %9.2fx %14.3g\n", name, scalarNs, engineNs, scalarNs / engineNs, agreement);
+		}
+	} // namespace
+
+	// Matrix4x4 (XMatrix-backed unless SHZ_FORCE_NO_SSE) against the scalar
+	// code it replaced: ns per call and the largest difference over all inputs
+	// (for the general inverse: the larger residual |M * inv - I| of the two).
+	SHZ_BENCHMARK(MathMatrix4x4)
+	{
+		std::printf("SIMD path: %s\n", SHZ_HAS_SSE ? "XMatrix (SSE)" : "scalar (SHZ_FORCE_NO_SSE)");
+		std::printf("%-16s %12s %12s %10s %14s\n", "op", "scalar ns", "engine ns", "speedup", "max abs diff");
+
+		const MathInputs in = makeInputs();
+		const std::vector<Matrix4x4>& A = in.Affine;
+		const std::vector<Matrix4x4>& G = in.General;
+		const uint32 last = MATRIX_COUNT - 1;
+
+		float32 diff = 0.f;
+		for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+		{
+			diff = std::max(diff, maxAbsDiff(Scalar::Mul(A[i], G[last - i]), A[i] * G[last - i]));
+		}
+		printRow("Mul", timeOp([&](uint32 i) { return Scalar::Mul(A[i], G[last - i]); }), timeOp([&](uint32 i) { return A[i] * G[last - i]; }), diff);
+
+		diff = 0.f;
+		for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+		{
+			diff = std::max(diff, maxAbsDiff(Scalar::Transposed(G[i]), G[i].Transposed()));
+		}
+		printRow("Transposed", timeOp([&](uint32 i) { return Scalar::Transposed(G[i]); }), timeOp([&](uint32 i) { return G[i].Transposed(); }), diff);
+
+		diff = 0.f;
+		for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+		{
+			diff = std::max(diff, std::max(inverseResidual(G[i], Scalar::Inversed(G[i])), inverseResidual(G[i], G[i].Inversed())));
+		}
+		printRow("Inversed", timeOp([&](uint32 i) { return Scalar::Inversed(G[i]); }), timeOp([&](uint32 i) { return G[i].Inversed(); }), diff);
+
+		diff = 0.f;
+		for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+		{
+			diff = std::max(diff, maxAbsDiff(Scalar::InverseAffine(A[i]), A[i].InverseAffineFast()));
+		}
+		printRow("InverseAffine", timeOp([&](uint32 i) { return Scalar::InverseAffine(A[i]); }), timeOp([&](uint32 i) { return A[i].InverseAffineFast(); }), diff);
+
+		diff = 0.f;
+		for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+		{
+			diff = std::max(diff, maxAbsDiff(Scalar::TRS(in.Translations[i], in.Eulers[i], in.Scales[i]), Matrix4x4::TRS(in.Translations[i], in.Eulers[i], in.Scales[i])));
+		}
+		printRow("TRS",
+			timeOp([&](uint32 i) { return Scalar::TRS(in.Translations[i], in.Eulers[i], in.Scales[i]); }),
+			timeOp([&](uint32 i) { return Matrix4x4::TRS(in.Translations[i], in.Eulers[i], in.Scales[i]); }),
+			diff);
+
+		diff = 0.f;
+		for (uint32 i = 0; i < MATRIX_COUNT; ++i)
+		{
+			diff = std::max(diff, maxAbsDiff(Scalar::TransformBox(A[i], in.Boxes[i]), A[i].TransformBox(in.Boxes[i])));
+		}
+		printRow("TransformBox", timeOp([&](uint32 i) { return Scalar::TransformBox(A[i], in.Boxes[i]); }), timeOp([&](uint32 i) { return A[i].TransformBox(in.Boxes[i]); }), diff);
+	}
+} // namespace shz
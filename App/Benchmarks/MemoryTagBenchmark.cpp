@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/Core/Memory/Public/MemoryTracker.h"
+#include "Engine/Core/Memory/Public/TaggedMemoryAllocator.hpp"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 THREAD_COUNTS[] = { 1, 2, 4, 8 };
+		constexpr uint32 ALLOC_ITERATIONS = 1u << 16;
+		constexpr uint32 LIVE_BLOCKS = 64;
+		constexpr uint32 REALLOC_ROUNDS = 4096;
+		constexpr uint32 REALLOC_STEPS = 64;
+
+		// Allocator timings are noisy; each figure is the best of this many
+		// runs, alternating between the two sides so both see the same machine.
+		constexpr uint32 REPEATS = 100;
+
+		// Small, mixed sizes: what flecs and Jolt mostly ask for.
+		size_t blockSize(uint32 i)
+		{
+			return 16 + (i & 15) * 16;
+		}
+
+		double nsPerOp(uint64 ops, double seconds)
+		{
+			return seconds * 1e9 / static_cast<double>(ops);
+		}
+
+		double overheadPercent(double baseNs, double ns)
+		{
+			return (ns - baseNs) * 100.0 / baseNs;
+		}
+
+		// Best times of baseBody and body over REPEATS alternating runs.
+		template <typename BaseBodyType, typename BodyType>
+		std::pair<double, double> bestOf(uint32 threadCount, const BaseBodyType& baseBody, const BodyType& body)
+		{
+			std::pair<double, double> best = { RunOnThreads(threadCount, baseBody), RunOnThreads(threadCount, body) };
+			for (uint32 i = 1; i < REPEATS; ++i)
+			{
+				best.first = std::min(best.first, RunOnThreads(threadCount, baseBody));
+				best.second = std::min(best.second, RunOnThreads(threadCount, body));
+			}
+			return best;
+		}
+	} // namespace
+
+	// Alloc + free with LIVE_BLOCKS blocks in flight per thread: malloc/free
+	// against the ECS-tagged allocator, for blockSize() scaled by 1, 16 and
+	// 256. Up to 16 KiB the tagged allocator serves blocks from its slabs;
+	// beyond that it is the CRT plus a block-size lookup each way.
+	SHZ_BENCHMARK(MemoryTagAlloc)
+	{
+		std::printf("%11s %8s %14s %14s %10s\n", "sizes", "threads", "malloc ns/op", "tagged ns/op", "overhead");
+
+		TaggedMemoryAllocator& tagged = TaggedMemoryAllocator::GetAllocator(EMemoryTag::ECS);
+
+		for (const size_t sizeScale : { 1, 16, 256 })
+		{
+			char sizes[32];
+			std::snprintf(sizes, sizeof(sizes), "%zu-%zu", blockSize(0) * sizeScale, blockSize(15) * sizeScale);
+
+			for (const uint32 threadCount : THREAD_COUNTS)
+			{
+				const auto [mallocSeconds, taggedSeconds] = bestOf(threadCount,
+					[&](uint32)
+					{
+						void* blocks[LIVE_BLOCKS] = {};
+						for (uint32 i = 0; i < ALLOC_ITERATIONS; ++i)
+						{
+							void*& slot = blocks[i % LIVE_BLOCKS];
+							std::free(slot);
+							slot = std::malloc(blockSize(i) * sizeScale);
+							DoNotOptimize(slot);
+						}
+						for (void* p : blocks)
+						{
+							std::free(p);
+						}
+					},
+					[&](uint32)
+					{
+						void* blocks[LIVE_BLOCKS] = {};
+						for (uint32 i = 0; i < ALLOC_ITERATIONS; ++i)
+						{
+							void*& slot = blocks[i % LIVE_BLOCKS];
+							tagged.Free(slot);
+							slot = tagged.Allocate(blockSize(i) * sizeScale, "bench", __FILE__, __LINE__);
+							DoNotOptimize(slot);
+						}
+						for (void* p : blocks)
+						{
+							tagged.Free(p);
+						}
+					});
+
+				const uint64 ops = uint64{ ALLOC_ITERATIONS } * threadCount;
+				const double mallocNs = nsPerOp(ops, mallocSeconds);
+				const double taggedNs = nsPerOp(ops, taggedSeconds);
+				std::printf("%11s %8u %14.1f %14.1f %9.1f%%\n", sizes, threadCount, mallocNs, taggedNs, overheadPercent(mallocNs, taggedNs));
+			}
+		}
+
+		// The benchmark threads have exited and handed their cached blocks back.
+		MemorySnapshot snapshot;
+		MemoryTracker::CaptureSnapshot(snapshot);
+		std::printf("ECS tag after the runs: %llu bytes live, %llu allocs, %llu frees\n",
+			static_cast<unsigned long long>(snapshot[EMemoryTag::ECS].CurrentBytes),
+			static_cast<unsigned long long>(snapshot[EMemoryTag::ECS].AllocCount),
+			static_cast<unsigned long long>(snapshot[EMemoryTag::ECS].FreeCount));
+	}
+
+	// Grows one block REALLOC_STEPS times (flecs vectors, Jolt arrays):
+	// realloc against TaggedMemoryAllocator::Reallocate.
+	SHZ_BENCHMARK(MemoryTagRealloc)
+	{
+		std::printf("%14s %14s %10s\n", "realloc ns/op", "tagged ns/op", "overhead");
+
+		TaggedMemoryAllocator& tagged = TaggedMemoryAllocator::GetAllocator(EMemoryTag::ECS);
+
+		const auto [reallocSeconds, taggedSeconds] = bestOf(1,
+			[&](uint32)
+			{
+				for (uint32 round = 0; round < REALLOC_ROUNDS; ++round)
+				{
+					void* p = nullptr;
+					for (uint32 step = 1; step <= REALLOC_STEPS; ++step)
+					{
+						p = std::realloc(p, step * 64);
+						DoNotOptimize(p);
+					}
+					std::free(p);
+				}
+			},
+			[&](uint32)
+			{
+				for (uint32 round = 0; round < REALLOC_ROUNDS; ++round)
+				{
+					void* p = nullptr;
+					for (uint32 step = 1; step <= REALLOC_STEPS; ++step)
+					{
+						p = tagged.Reallocate(p, step * 64, "bench", __FILE__, __LINE__);
+						DoNotOptimize(p);
+					}
+					tagged.Free(p);
+				}
+			});
+
+		const uint64 ops = uint64{ REALLOC_ROUNDS } * REALLOC_STEPS;
+		const double reallocNs = nsPerOp(ops, reallocSeconds);
+		const double taggedNs = nsPerOp(ops, taggedSeconds);
+		std::printf("%14.1f %14.1f %9.1f%%\n", reallocNs, taggedNs, overheadPercent(reallocNs, taggedNs));
+	}
+} // namespace shz
@@ -0,0 +1,297 @@
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/RHI_Null/Public/IEngineFactoryNull.h"
+#include "Engine/RHI_Null/Public/IDeviceContextNull.h"
+#include "Engine/Renderer/Public/Renderer.h"
+#include "Engine/Renderer/Public/RenderScene.h"
+#include "Engine/Renderer/Public/ViewFamily.h"
+#include "Engine/AssetManager/Public/AssetManager.h"
+#include "Engine/RuntimeData/Public/StaticMeshImporter.h"
+#include "Engine/RuntimeData/Public/TextureImporter.h"
+#include "Engine/RuntimeData/Public/StaticMeshClusterBuilder.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr const char* SHADER_ROOT = "C:/Dev/ShizenEngine/Shaders";
+
+		constexpr uint32 BACK_BUFFER_WIDTH = 1920;
+		constexpr uint32 BACK_BUFFER_HEIGHT = 1080;
+
+		constexpr uint32 GRID_SIZE = 32;
+		constexpr float GRID_SPACING = 3.f;
+		constexpr uint32 MATERIAL_COUNT = 8;
+		constexpr uint32 SPHERE_RINGS = 16;
+		constexpr uint32 SPHERE_SEGMENTS = 24;
+
+		constexpr uint32 WARMUP_FRAMES = 8;
+		constexpr uint32 MEASURED_FRAMES = 64;
+		constexpr float PI = 3.14159265f;
+
+		// Unit UV sphere, clustered like imported meshes so the cluster culling path runs too.
+		StaticMesh makeSphere()
+		{
+			std::vector<float3> positions;
+			std::vector<float3> normals;
+			for (uint32 r = 0; r <= SPHERE_RINGS; ++r)
+			{
+				const float theta = PI * static_cast<float>(r) / SPHERE_RINGS;
+				for (uint32 s = 0; s <= SPHERE_SEGMENTS; ++s)
+				{
+					const float phi = 2.f * PI * static_cast<float>(s) / SPHERE_SEGMENTS;
+					const float3 n(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+					positions.push_back(n);
+					normals.push_back(n);
+				}
+			}
+
+			std::vector<uint32> indices;
+			const uint32 stride = SPHERE_SEGMENTS + 1;
+			for (uint32 r = 0; r < SPHERE_RINGS; ++r)
+			{
+				for (uint32 s = 0; s < SPHERE_SEGMENTS; ++s)
+				{
+					const uint32 i0 = r * stride + s;
+					const uint32 i1 = i0 + 1;
+					const uint32 i2 = i0 + stride;
+					const uint32 i3 = i2 + 1;
+					indices.insert(indices.end(), { i0, i1, i2, i1, i3, i2 });
+				}
+			}
+
+			StaticMesh mesh;
+
+			StaticMesh::Section section = {};
+			section.IndexCount = static_cast<uint32>(indices.size());
+
+			mesh.SetPositions(std::move(positions));
+			mesh.SetNormals(std::move(normals));
+			mesh.SetIndicesU32(std::move(indices));
+			mesh.SetSections({ section });
+			mesh.RecomputeBounds();
+
+			StaticMeshClusterBuilder::Build(&mesh);
+			return mesh;
+		}
+
+		Material makeMaterial(uint32 index)
+		{
+			const float t = static_cast<float>(index) / MATERIAL_COUNT;
+
+			Material material("NullBenchmark.Material", "DefaultLit");
+			material.SetFloat4("g_BaseColorFactor", float4(t, 1.f - t, 0.5f, 1.f));
+			material.SetFloat3("g_EmissiveFactor", float3(0.f, 0.f, 0.f));
+			material.SetFloat("g_EmissiveIntensity", 0.f);
+			material.SetFloat("g_RoughnessFactor", 0.2f + 0.6f * t);
+			material.SetFloat("g_NormalScale", 1.f);
+			material.SetFloat("g_OcclusionStrength", 1.f);
+			material.SetFloat("g_AlphaCutoff", 0.5f);
+			material.SetFloat("g_MetallicFactor", t);
+			material.SetUint("g_MaterialFlags", 0);
+			return material;
+		}
+
+		ViewFamily makeViewFamily()
+		{
+			const float extent = GRID_SIZE * GRID_SPACING;
+			const float3 eye(-0.2f * extent, 0.35f * extent, -0.2f * extent);
+			const float3 at(0.5f * extent, 0.f, 0.5f * extent);
+
+			View view = {};
+			view.CameraPosition = eye;
+			view.NearPlane = 0.1f;
+			view.FarPlane = 2000.f;
+			view.ViewMatrix = Matrix4x4::LookAtLH(eye, at, float3(0.f, 1.f, 0.f));
+			view.ProjMatrix = Matrix4x4::PerspectiveFovLH(PI / 4.f, static_cast<float>(BACK_BUFFER_WIDTH) / BACK_BUFFER_HEIGHT, view.NearPlane, view.FarPlane);
+			view.Viewport.left = 0;
+			view.Viewport.top = 0;
+			view.Viewport.right = BACK_BUFFER_WIDTH;
+			view.Viewport.bottom = BACK_BUFFER_HEIGHT;
+
+			ViewFamily viewFamily = {};
+			viewFamily.Views.push_back(view);
+			viewFamily.DeltaTime = 1.f / 60.f;
+			return viewFamily;
+		}
+
+		void printRow(const char* name, double value)
+		{
+			std::printf("  %-26s %12.1f\n", name, value);
+		}
+	} // namespace
+
+	// Renderer::Render on the null device: every pass records its real commands (shaders
+	// are compiled with DXC and reflected, so the pipelines and SRBs match the D3D12
+	// backend), nothing is submitted to a GPU. Reports the CPU cost of a frame and the
+	// commands it recorded, per frame, for a GRID_SIZE^2 grid of clustered spheres using
+	// MATERIAL_COUNT materials and one directional light. Reads the shaders and the
+	// renderer's built-in assets from C:/Dev/ShizenEngine like the apps do.
+	SHZ_BENCHMARK(NullRenderer)
+	{
+		IEngineFactoryNull* pFactory = GetEngineFactoryNull();
+
+		EngineNullCreateInfo engineCI = {};
+		engineCI.NumDeferredContexts = 2;
+
+		RefCntAutoPtr<IRenderDevice> pDevice;
+		std::vector<IDeviceContext*> contexts(1 + engineCI.NumDeferredContexts, nullptr);
+		pFactory->CreateDeviceAndContextsNull(engineCI, &pDevice, contexts.data());
+		if (!pDevice)
+		{
+			std::printf("Failed to create the null device\n");
+			return;
+		}
+
+		// The factory returns the contexts with one reference each; the smart pointers take it over.
+		RefCntAutoPtr<IDeviceContext> pImmediateContext;
+		pImmediateContext.Attach(contexts[0]);
+		std::vector<RefCntAutoPtr<IDeviceContext>> deferredContexts(engineCI.NumDeferredContexts);
+		for (uint32 i = 0; i < engineCI.NumDeferredContexts; ++i)
+		{
+			deferredContexts[i].Attach(contexts[1 + i]);
+		}
+
+		SwapChainDesc scDesc = {};
+		scDesc.Width = BACK_BUFFER_WIDTH;
+		scDesc.Height = BACK_BUFFER_HEIGHT;
+
+		RefCntAutoPtr<ISwapChain> pSwapChain;
+		pFactory->CreateSwapChainNull(pDevice, pImmediateContext, scDesc, &pSwapChain);
+
+		RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+		pFactory->CreateDefaultShaderSourceStreamFactory(SHADER_ROOT, &pShaderSourceFactory);
+
+		AssetManager assetManager;
+		assetManager.Initialize();
+		assetManager.RegisterImporter(AssetTypeTraits<StaticMesh>::TypeID, StaticMeshImporter{});
+		assetManager.RegisterImporter(AssetTypeTraits<Texture>::TypeID, TextureImporter{});
+
+		RendererCreateInfo rendererCI = {};
+		rendererCI.pEngineFactory = pFactory;
+		rendererCI.pDevice = pDevice;
+		rendererCI.pImmediateContext = pImmediateContext;
+		rendererCI.pDeferredContexts = deferredContexts;
+		rendererCI.pSwapChain = pSwapChain;
+		rendererCI.pShaderSourceFactory = pShaderSourceFactory;
+		rendererCI.pAssetManager = &assetManager;
+		rendererCI.BackBufferWidth = BACK_BUFFER_WIDTH;
+		rendererCI.BackBufferHeight = BACK_BUFFER_HEIGHT;
+
+		// Bytecode, driver cache and archive are keyed by device type; keep the null device out of them.
+		rendererCI.ShaderBytecodeCachePath.clear();
+		rendererCI.PipelineStateCachePath.clear();
+		rendererCI.RenderStateArchivePath.clear();
+
+		std::unique_ptr<Renderer> pRenderer = std::make_unique<Renderer>();
+		if (!pRenderer->Initialize(rendererCI))
+		{
+			std::printf("Renderer initialization failed\n");
+			return;
+		}
+
+		const ShaderStartupStats& startup = pRenderer->GetShaderStartupStats();
+		std::printf("startup: templates %.1f ms, passes %.1f ms, pipelines %.1f ms\n",
+			startup.TemplateRequestMilliseconds + startup.TemplateFinishMilliseconds,
+			startup.PassMilliseconds,
+			startup.PipelineMilliseconds);
+
+		// Scene: one mesh render data per material, objects assigned round-robin.
+		const StaticMesh sphere = makeSphere();
+		std::vector<Material> materials;
+		std::vector<const StaticMeshRenderData*> meshes;
+		materials.reserve(MATERIAL_COUNT);
+		for (uint32 m = 0; m < MATERIAL_COUNT; ++m)
+		{
+			materials.push_back(makeMaterial(m));
+			meshes.push_back(&pRenderer->CreateStaticMeshRenderData(sphere, materials.back(), 1 + m, "NullBenchmark.Sphere"));
+		}
+
+		RenderScene scene;
+		for (uint32 z = 0; z < GRID_SIZE; ++z)
+		{
+			for (uint32 x = 0; x < GRID_SIZE; ++x)
+			{
+				const float3 position(x * GRID_SPACING, 1.f, z * GRID_SPACING);
+				scene.AddObject(*meshes[(z * GRID_SIZE + x) % MATERIAL_COUNT], Matrix4x4::Translation(position), true);
+			}
+		}
+
+		RenderScene::LightObject light = {};
+		light.Direction = float3(0.4f, -1.f, 0.3f);
+		light.Intensity = 2.f;
+		scene.AddLight(light);
+
+		ViewFamily viewFamily = makeViewFamily();
+
+		RefCntAutoPtr<IDeviceContextNull> pNullContext{ pImmediateContext, IID_DeviceContextNull };
+		ASSERT(pNullContext, "Immediate context is not a null context.");
+
+		auto renderFrame = [&]()
+			{
+				viewFamily.FrameIndex++;
+				viewFamily.CurrentTime += viewFamily.DeltaTime;
+
+				pRenderer->BeginFrame();
+				pRenderer->Render(scene, viewFamily);
+				pRenderer->EndFrame();
+				pSwapChain->Present(0);
+			};
+
+		for (uint32 frame = 0; frame < WARMUP_FRAMES; ++frame)
+		{
+			renderFrame();
+		}
+
+		// Deferred contexts hand their commands to the immediate context when their lists
+		// are executed, so its counters cover the whole frame.
+		NullCommandCounters total = {};
+		double seconds = 0.0;
+		for (uint32 frame = 0; frame < MEASURED_FRAMES; ++frame)
+		{
+			pNullContext->ResetCommandStream();
+
+			Timer timer;
+			renderFrame();
+			seconds += timer.GetElapsedTime();
+
+			const NullCommandCounters& counters = pNullContext->GetCommandCounters();
+			for (uint32 c = 0; c < NULL_COMMAND_TYPE_COUNT; ++c)
+			{
+				total.Commands[c] += counters.Commands[c];
+			}
+			total.BytesUploaded += counters.BytesUploaded;
+		}
+
+		auto perFrame = [&](std::initializer_list<NULL_COMMAND_TYPE> types)
+			{
+				uint64 sum = 0;
+				for (NULL_COMMAND_TYPE type : types)
+				{
+					sum += total.Commands[type];
+				}
+				return static_cast<double>(sum) / MEASURED_FRAMES;
+			};
+
+		std::printf("%u objects, %u materials, %u frames\n", GRID_SIZE * GRID_SIZE, MATERIAL_COUNT, MEASURED_FRAMES);
+		std::printf("per frame:\n");
+		printRow("CPU ms", seconds * 1000.0 / MEASURED_FRAMES);
+		printRow("draws", perFrame({ NULL_COMMAND_DRAW, NULL_COMMAND_DRAW_INDEXED, NULL_COMMAND_DRAW_INDIRECT, NULL_COMMAND_DRAW_INDEXED_INDIRECT }));
+		printRow("dispatches", perFrame({ NULL_COMMAND_DISPATCH_COMPUTE, NULL_COMMAND_DISPATCH_COMPUTE_INDIRECT }));
+		printRow("pipeline binds", perFrame({ NULL_COMMAND_SET_PIPELINE_STATE }));
+		printRow("SRB commits", perFrame({ NULL_COMMAND_COMMIT_SHADER_RESOURCES }));
+		printRow("vertex/index buffer binds", perFrame({ NULL_COMMAND_SET_VERTEX_BUFFERS, NULL_COMMAND_SET_INDEX_BUFFER }));
+		printRow("render pass/target binds", perFrame({ NULL_COMMAND_BEGIN_RENDER_PASS, NULL_COMMAND_SET_RENDER_TARGETS }));
+		printRow("buffer maps", perFrame({ NULL_COMMAND_MAP_BUFFER }));
+		printRow("buffer/texture updates", perFrame({ NULL_COMMAND_UPDATE_BUFFER, NULL_COMMAND_UPDATE_TEXTURE, NULL_COMMAND_COPY_BUFFER, NULL_COMMAND_COPY_TEXTURE }));
+		printRow("barriers", perFrame({ NULL_COMMAND_RESOURCE_BARRIER }));
+		printRow("command lists executed", perFrame({ NULL_COMMAND_EXECUTE_COMMAND_LIST }));
+		printRow("KB uploaded", static_cast<double>(total.BytesUploaded) / 1024.0 / MEASURED_FRAMES);
+
+		pRenderer->Cleanup();
+		pRenderer.reset();
+	}
+} // namespace shz
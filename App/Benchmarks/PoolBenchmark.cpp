@@ -0,0 +1,165 @@
+#include <barrier>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/Core/Memory/Public/ConcurrentPagedMemoryPool.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 THREAD_COUNTS[] = { 1, 2, 4, 8, 16 };
+		constexpr size_t OBJECT_BYTES = 48;
+		constexpr uint32 OBJECTS_PER_PAGE = 1024;
+		constexpr uint32 LIVE_PER_THREAD = 256;
+		constexpr uint32 CHURN_ITERATIONS = 1u << 20;
+		constexpr uint32 HANDOFF_ROUNDS = 1024;
+		constexpr uint32 BURST_OBJECTS = 1u << 18;
+
+		double nsPerOp(uint64 ops, double seconds)
+		{
+			return seconds * 1e9 / static_cast<double>(ops);
+		}
+
+		struct MallocSource final
+		{
+			void* Alloc() { return std::malloc(OBJECT_BYTES); }
+			void Free(void* p) { std::free(p); }
+		};
+
+		struct PoolSource final
+		{
+			ConcurrentPagedMemoryPool& Pool;
+
+			void* Alloc() { return Pool.Alloc(); }
+			void Free(void* p) { Pool.Free(p); }
+		};
+
+		// Free + alloc into a ring of LIVE_PER_THREAD blocks per thread.
+		template <typename SourceType>
+		double churn(uint32 threadCount, SourceType source)
+		{
+			return RunOnThreads(threadCount, [&](uint32)
+				{
+					void* live[LIVE_PER_THREAD] = {};
+					for (uint32 i = 0; i < CHURN_ITERATIONS; ++i)
+					{
+						void*& slot = live[i % LIVE_PER_THREAD];
+						if (slot)
+						{
+							source.Free(slot);
+						}
+						slot = source.Alloc();
+						DoNotOptimize(slot);
+					}
+					for (void* p : live)
+					{
+						source.Free(p);
+					}
+				});
+		}
+
+		// Every round each thread allocates LIVE_PER_THREAD blocks, then frees
+		// the ones its neighbour allocated (blocks die on another thread).
+		template <typename SourceType>
+		double handoff(uint32 threadCount, SourceType source)
+		{
+			std::vector<std::vector<void*>> batches(threadCount, std::vector<void*>(LIVE_PER_THREAD));
+			std::barrier sync(static_cast<std::ptrdiff_t>(threadCount));
+
+			return RunOnThreads(threadCount, [&](uint32 t)
+				{
+					std::vector<void*>& mine = batches[t];
+					std::vector<void*>& neighbour = batches[(t + 1) % threadCount];
+
+					for (uint32 round = 0; round < HANDOFF_ROUNDS; ++round)
+					{
+						for (void*& p : mine)
+						{
+							p = source.Alloc();
+						}
+						sync.arrive_and_wait();
+
+						for (void* p : neighbour)
+						{
+							source.Free(p);
+						}
+						sync.arrive_and_wait();
+					}
+				});
+		}
+
+		void initPool(ConcurrentPagedMemoryPool& pool)
+		{
+			pool.Initialize(OBJECT_BYTES, alignof(std::max_align_t), OBJECTS_PER_PAGE);
+		}
+	} // namespace
+
+	SHZ_BENCHMARK(PoolChurn)
+	{
+		std::printf("%8s %14s %14s\n", "threads", "malloc ns/op", "pool ns/op");
+
+		for (const uint32 threadCount : THREAD_COUNTS)
+		{
+			ConcurrentPagedMemoryPool pool;
+			initPool(pool);
+
+			const uint64 ops = uint64{ 2 } * CHURN_ITERATIONS * threadCount;
+			const double mallocSeconds = churn(threadCount, MallocSource{});
+			const double poolSeconds = churn(threadCount, PoolSource{ pool });
+			std::printf("%8u %14.1f %14.1f\n", threadCount, nsPerOp(ops, mallocSeconds), nsPerOp(ops, poolSeconds));
+		}
+	}
+
+	SHZ_BENCHMARK(PoolHandoff)
+	{
+		std::printf("%8s %14s %14s\n", "threads", "malloc ns/op", "pool ns/op");
+
+		for (const uint32 threadCount : THREAD_COUNTS)
+		{
+			ConcurrentPagedMemoryPool pool;
+			initPool(pool);
+
+			const uint64 ops = uint64{ 2 } * LIVE_PER_THREAD * HANDOFF_ROUNDS * threadCount;
+			const double mallocSeconds = handoff(threadCount, MallocSource{});
+			const double poolSeconds = handoff(threadCount, PoolSource{ pool });
+			std::printf("%8u %14.1f %14.1f\n", threadCount, nsPerOp(ops, mallocSeconds), nsPerOp(ops, poolSeconds));
+		}
+	}
+
+	// One thread allocates a burst, another frees it all: the depot keeps at
+	// most MAX_DEPOT_FULL_MAGAZINES magazines and the rest of the pages go back.
+	SHZ_BENCHMARK(PoolBurstTrim)
+	{
+		ConcurrentPagedMemoryPool pool;
+		initPool(pool);
+
+		std::vector<void*> blocks(BURST_OBJECTS);
+		RunOnThreads(1, [&](uint32)
+			{
+				for (void*& p : blocks)
+				{
+					p = pool.Alloc();
+				}
+			});
+		const ConcurrentPagedMemoryPool::Stats peak = pool.GetStats();
+
+		RunOnThreads(1, [&](uint32)
+			{
+				for (void* p : blocks)
+				{
+					pool.Free(p);
+				}
+			});
+		const ConcurrentPagedMemoryPool::Stats after = pool.GetStats();
+
+		std::printf("burst of %u objects, %u per page\n", BURST_OBJECTS, OBJECTS_PER_PAGE);
+		std::printf("pages at peak: %u, after freeing: %u (released %llu)\n",
+			peak.PageCount, after.PageCount, static_cast<unsigned long long>(after.ReleasedPageCount));
+		std::printf("depot full magazines: %u (cap %u), magazines returned to pages: %llu\n",
+			after.DepotFullMagazines, ConcurrentPagedMemoryPool::MAX_DEPOT_FULL_MAGAZINES,
+			static_cast<unsigned long long>(after.PageReturnCount));
+	}
+} // namespace shz
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/RuntimeData/Public/TerrainHeightField.h"
+#include "Engine/RuntimeData/Public/TerrainMeshBuilder.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 FIELD_SIZE = 513;
+		constexpr uint32 STROKE_STEPS = 32;
+
+		// Renderer::PackedStaticVertex: position, normal, tangent, uv
+		constexpr uint64 PACKED_VERTEX_BYTES = sizeof(float) * 11;
+
+		TerrainHeightField makeField()
+		{
+			TerrainHeightField hf(TerrainHeightFieldCreateInfo(FIELD_SIZE, FIELD_SIZE, 1.f, 1.f, 100.f, 0.f));
+			for (uint32 z = 0; z < FIELD_SIZE; ++z)
+			{
+				for (uint32 x = 0; x < FIELD_SIZE; ++x)
+				{
+					hf.SetNormalizedHeightAt(x, z, 0.5f + 0.2f * std::sin(static_cast<float>(x) * 0.02f) * std::cos(static_cast<float>(z) * 0.03f));
+				}
+			}
+			hf.ConsumeDirtyRect();
+			return hf;
+		}
+
+		// What the GPU buffers hold: only the dirty ranges are copied in after a rebuild.
+		struct ChunkMirror final
+		{
+			std::vector<float3> Positions;
+			std::vector<float3> Normals;
+			std::vector<uint8> Indices;
+
+			void CopyAll(const StaticMesh& mesh)
+			{
+				Positions = mesh.GetPositions();
+				Normals = mesh.GetNormals();
+				const uint8* pIndices = static_cast<const uint8*>(mesh.GetIndexData());
+				Indices.assign(pIndices, pIndices + mesh.GetIndexDataSizeBytes());
+			}
+
+			void CopyDirty(const TerrainChunk& chunk)
+			{
+				const StaticMesh& mesh = chunk.Mesh;
+				for (const StaticMesh::VertexRange& r : chunk.DirtyVertexRanges)
+				{
+					std::copy_n(mesh.GetPositions().begin() + r.FirstVertex, r.VertexCount, Positions.begin() + r.FirstVertex);
+					std::copy_n(mesh.GetNormals().begin() + r.FirstVertex, r.VertexCount, Normals.begin() + r.FirstVertex);
+				}
+
+				const uint32 indexSize = (mesh.GetIndexType() == VT_UINT16) ? 2u : 4u;
+				std::memcpy(Indices.data() + chunk.DirtyFirstIndex * indexSize,
+					static_cast<const uint8*>(mesh.GetIndexData()) + chunk.DirtyFirstIndex * indexSize,
+					chunk.DirtyIndexCount * indexSize);
+			}
+
+			bool Matches(const StaticMesh& mesh) const
+			{
+				return Positions == mesh.GetPositions() && Normals == mesh.GetNormals() &&
+					std::memcmp(Indices.data(), mesh.GetIndexData(), Indices.size()) == 0;
+			}
+		};
+
+		struct UploadTotals final
+		{
+			uint64 Chunks = 0;
+			uint64 Uploads = 0;
+			uint64 VertexBytes = 0;
+			uint64 IndexBytes = 0;
+			uint64 FullBytes = 0;
+			uint64 Mismatches = 0;
+		};
+
+		void addChunk(const TerrainChunk& chunk, UploadTotals& totals)
+		{
+			const uint32 indexSize = (chunk.Mesh.GetIndexType() == VT_UINT16) ? 2u : 4u;
+
+			++totals.Chunks;
+			for (const StaticMesh::VertexRange& r : chunk.DirtyVertexRanges)
+			{
+				++totals.Uploads;
+				totals.VertexBytes += r.VertexCount * PACKED_VERTEX_BYTES;
+			}
+			if (chunk.DirtyIndexCount > 0)
+			{
+				++totals.Uploads;
+				totals.IndexBytes += static_cast<uint64>(chunk.DirtyIndexCount) * indexSize;
+			}
+			totals.FullBytes += chunk.Mesh.GetVertexCount() * PACKED_VERTEX_BYTES + chunk.Mesh.GetIndexDataSizeBytes();
+		}
+	} // namespace
+
+	// Brush strokes over a chunked terrain, rebuilt with RebuildDirtyChunks after
+	// every dab: bytes a partial Renderer::UpdateStaticMeshRenderData uploads
+	// against re-uploading every rebuilt chunk whole, and the CPU rebuild time.
+	// Mismatches counts rebuilt chunks whose partially updated copy differs from the new mesh.
+	SHZ_BENCHMARK(TerrainEdit)
+	{
+		TerrainHeightField hf = makeField();
+
+		TerrainChunkBuildSettings settings = {};
+		settings.NumWorkerThreads = 1;
+
+		std::vector<TerrainChunk> chunks;
+		TerrainMeshBuilder::BuildChunkedStaticMeshes(&chunks, hf, settings);
+
+		std::vector<ChunkMirror> mirrors(chunks.size());
+		for (size_t c = 0; c < chunks.size(); ++c)
+		{
+			mirrors[c].CopyAll(chunks[c].Mesh);
+		}
+
+		std::printf("field %ux%u, %u chunks of %u quads, %u LODs\n",
+			FIELD_SIZE, FIELD_SIZE, static_cast<uint32>(chunks.size()), settings.ChunkQuads, settings.LodCount);
+		std::printf("%-8s %8s %8s %12s %12s %12s %9s %10s %11s\n",
+			"radius", "chunks", "uploads", "vertex KB", "index KB", "full KB", "saved", "ms/dab", "mismatches");
+
+		for (const float radius : { 4.f, 12.f, 32.f })
+		{
+			UploadTotals totals = {};
+			std::vector<uint32> rebuilt;
+
+			double seconds = 0.0;
+			for (uint32 step = 0; step < STROKE_STEPS; ++step)
+			{
+				TerrainBrush brush = {};
+				brush.Radius = radius;
+				brush.Strength = 0.02f;
+				brush.CenterX = -100.f + 200.f * static_cast<float>(step) / STROKE_STEPS;
+				brush.CenterZ = 30.f * std::sin(static_cast<float>(step) * 0.3f);
+				hf.ApplyBrush(brush);
+
+				rebuilt.clear();
+				seconds += RunOnThreads(1, [&](uint32)
+					{
+						TerrainMeshBuilder::RebuildDirtyChunks(&chunks, hf, hf.ConsumeDirtyRect(), settings, &rebuilt);
+					});
+
+				for (uint32 c : rebuilt)
+				{
+					addChunk(chunks[c], totals);
+					mirrors[c].CopyDirty(chunks[c]);
+					totals.Mismatches += mirrors[c].Matches(chunks[c].Mesh) ? 0 : 1;
+				}
+			}
+
+			const uint64 partial = totals.VertexBytes + totals.IndexBytes;
+			std::printf("%-8.0f %8.1f %8.1f %12.1f %12.1f %12.1f %8.1f%% %10.3f %11llu\n",
+				radius,
+				static_cast<double>(totals.Chunks) / STROKE_STEPS,
+				static_cast<double>(totals.Uploads) / STROKE_STEPS,
+				static_cast<double>(totals.VertexBytes) / (1024.0 * STROKE_STEPS),
+				static_cast<double>(totals.IndexBytes) / (1024.0 * STROKE_STEPS),
+				static_cast<double>(totals.FullBytes) / (1024.0 * STROKE_STEPS),
+				100.0 * (1.0 - static_cast<double>(partial) / static_cast<double>(std::max<uint64>(totals.FullBytes, 1))),
+				seconds * 1e3 / STROKE_STEPS,
+				static_cast<unsigned long long>(totals.Mismatches));
+		}
+	}
+} // namespace shz
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Engine/Core/Common/Public/ParallelFor.hpp"
+#include "Engine/RuntimeData/Public/TerrainHeightField.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 FIELD_SIZE = 1025;
+		constexpr uint32 POINT_COUNT = 1u << 20;
+
+		// Sampler timings are noisy; each figure is the best of this many runs.
+		constexpr uint32 REPEATS = 5;
+
+		TerrainHeightField makeField()
+		{
+			TerrainHeightField hf(TerrainHeightFieldCreateInfo(FIELD_SIZE, FIELD_SIZE, 1.f, 1.f, 200.f, -50.f));
+
+			std::mt19937 rng(1234);
+			std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+			for (uint32 z = 0; z < FIELD_SIZE; ++z)
+			{
+				for (uint32 x = 0; x < FIELD_SIZE; ++x)
+				{
+					const float h = 0.5f + 0.3f * std::sin(static_cast<float>(x) * 0.013f) * std::cos(static_cast<float>(z) * 0.017f) + noise(rng);
+					hf.SetNormalizedHeightAt(x, z, std::clamp(h, 0.f, 1.f));
+				}
+			}
+			return hf;
+		}
+
+		// Random points over the field plus a margin outside it (clamped edges).
+		std::vector<float2> makePoints(const TerrainHeightField& hf)
+		{
+			std::mt19937 rng(5678);
+			const float halfX = hf.GetWorldSizeX() * 0.55f;
+			const float halfZ = hf.GetWorldSizeZ() * 0.55f;
+			std::uniform_real_distribution<float> px(-halfX, halfX);
+			std::uniform_real_distribution<float> pz(-halfZ, halfZ);
+
+			std::vector<float2> points(POINT_COUNT);
+			for (float2& p : points)
+			{
+				p = float2(px(rng), pz(rng));
+			}
+			return points;
+		}
+
+		template <typename BodyType>
+		double mpointsPerSecond(const BodyType& body)
+		{
+			double best = RunOnThreads(1, body);
+			for (uint32 i = 1; i < REPEATS; ++i)
+			{
+				best = std::min(best, RunOnThreads(1, body));
+			}
+			return static_cast<double>(POINT_COUNT) / best * 1e-6;
+		}
+
+		template <typename T>
+		uint32 countMismatches(const std::vector<T>& a, const std::vector<T>& b)
+		{
+			uint32 mismatches = 0;
+			for (size_t i = 0; i < a.size(); ++i)
+			{
+				mismatches += (std::memcmp(&a[i], &b[i], sizeof(T)) != 0) ? 1 : 0;
+			}
+			return mismatches;
+		}
+
+		void printRow(const char* name, double scalar, double batched, double parallel, uint32 mismatches)
+		{
+			std::printf("%-18s %12.1f %12.1f %12.1f %9.2fx %12u\n", name, scalar, batched, parallel, batched / scalar, mismatches);
+		}
+	} // namespace
+
+	// TerrainHeightField sampling in Mpoints/s: one scalar call per point against
+	// the batched path (SSE unless SHZ_FORCE_NO_SSE) on the calling thread and on
+	// every ParallelFor worker. Mismatches count results that differ in any bit.
+	SHZ_BENCHMARK(TerrainSample)
+	{
+		const TerrainHeightField hf = makeField();
+		const std::vector<float2> points = makePoints(hf);
+
+		std::printf("field %ux%u, %u points, batched path: %s, ParallelFor threads: %u\n",
+			FIELD_SIZE, FIELD_SIZE, POINT_COUNT, SHZ_HAS_SSE ? "SSE" : "scalar (SHZ_FORCE_NO_SSE)", GetParallelForWorkerCount() + 1);
+		std::printf("%-18s %12s %12s %12s %10s %12s\n", "op", "scalar", "batched", "parallel", "speedup", "mismatches");
+
+		{
+			std::vector<float> scalar(POINT_COUNT);
+			std::vector<float> batched(POINT_COUNT);
+
+			const double scalarRate = mpointsPerSecond([&](uint32)
+				{
+					for (uint32 i = 0; i < POINT_COUNT; ++i)
+					{
+						scalar[i] = hf.SampleWorldHeight(points[i].x, points[i].y);
+					}
+				});
+			const double batchedRate = mpointsPerSecond([&](uint32) { hf.SampleWorldHeights(points.data(), batched.data(), POINT_COUNT, 1); });
+			const uint32 mismatches = countMismatches(scalar, batched);
+			const double parallelRate = mpointsPerSecond([&](uint32) { hf.SampleWorldHeights(points.data(), batched.data(), POINT_COUNT, 0); });
+
+			printRow("SampleWorldHeight", scalarRate, batchedRate, parallelRate, mismatches + countMismatches(scalar, batched));
+		}
+
+		{
+			std::vector<float3> scalar(POINT_COUNT);
+			std::vector<float3> batched(POINT_COUNT);
+
+			const double scalarRate = mpointsPerSecond([&](uint32)
+				{
+					for (uint32 i = 0; i < POINT_COUNT; ++i)
+					{
+						scalar[i] = hf.SampleWorldNormal(points[i].x, points[i].y);
+					}
+				});
+			const double batchedRate = mpointsPerSecond([&](uint32) { hf.SampleWorldNormals(points.data(), batched.data(), POINT_COUNT, 1); });
+			const uint32 mismatches = countMismatches(scalar, batched);
+			const double parallelRate = mpointsPerSecond([&](uint32) { hf.SampleWorldNormals(points.data(), batched.data(), POINT_COUNT, 0); });
+
+			printRow("SampleWorldNormal", scalarRate, batchedRate, parallelRate, mismatches + countMismatches(scalar, batched));
+		}
+	}
+} // namespace shz
@@ -0,0 +1,42 @@
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "Benchmark.h"
+
+int main(int argc, char** argv)
+{
+	using namespace shz;
+
+	std::printf("Hardware threads: %u\n", std::thread::hardware_concurrency());
+
+	uint32 ran = 0;
+	for (const BenchmarkEntry& entry : GetBenchmarks())
+	{
+		bool bSelected = (argc < 2);
+		for (int i = 1; i < argc && !bSelected; ++i)
+		{
+			bSelected = std::strcmp(argv[i], entry.Name) == 0;
+		}
+
+		if (!bSelected)
+		{
+			continue;
+		}
+
+		std::printf("\n== %s\n", entry.Name);
+		entry.Run();
+		++ran;
+	}
+
+	if (ran == 0)
+	{
+		std::printf("No benchmark matched. Available:\n");
+		for (const BenchmarkEntry& entry : GetBenchmarks())
+		{
+			std::printf("  %s\n", entry.Name);
+		}
+		return 1;
+	}
+	return 0;
+}
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <cstdio>
 #include <unordered_set>
 
 #include "ThirdParty/imgui/imgui.h"
@@ -11,6 +12,7 @@
 #include "Engine/RuntimeData/Public/StaticMeshImporter.h"
 #include "Engine/RuntimeData/Public/TextureImporter.h"
 #include "Engine/RuntimeData/Public/MaterialImporter.h"
+#include "Engine/RuntimeData/Public/MaterialLibraryImporter.h"
 #include "Engine/RuntimeData/Public/TerrainHeightFieldImporter.h"
 
 #include "Engine/RuntimeData/Public/TerrainMeshBuilder.h"
@@ -76,6 +78,12 @@ namespace shz
 			v.NearPlane = cam.GetProjAttribs().NearClipPlane;
 			v.FarPlane = cam.GetProjAttribs().FarClipPlane;
 		}
+
+		static void onMemoryBudgetExceeded(EMemoryTag tag, uint64 currentBytes, uint64 budgetBytes, void* /*pUserData*/)
+		{
+			LOG_WARNING_MESSAGE("Memory budget exceeded for '", GetMemoryTagName(tag), "': ",
+				currentBytes / (1024 * 1024), " MB / ", budgetBytes / (1024 * 1024), " MB");
+		}
 	} // namespace
 
 	SampleBase* CreateSample()
@@ -99,6 +107,14 @@ namespace shz
 	// Lifecycle
 	// ------------------------------------------------------------
 
+	void GrassViewer::ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& attribs)
+	{
+		SampleBase::ModifyEngineInitInfo(attribs);
+
+		// Shadow and GBuffer are recorded side by side on these.
+		attribs.EngineCI.NumDeferredContexts = 2;
+	}
+
 	void GrassViewer::Initialize(const SampleInitInfo& initInfo)
 	{
 		SampleBase::Initialize(initInfo);
@@ -111,9 +127,12 @@ namespace shz
 			m_pAssetManager->RegisterImporter(AssetTypeTraits<StaticMesh>::TypeID, StaticMeshImporter{});
 			m_pAssetManager->RegisterImporter(AssetTypeTraits<Texture>::TypeID, TextureImporter{});
 			m_pAssetManager->RegisterImporter(AssetTypeTraits<Material>::TypeID, MaterialImporter{});
+			m_pAssetManager->RegisterImporter(AssetTypeTraits<MaterialLibrary>::TypeID, MaterialLibraryImporter{});
 			m_pAssetManager->RegisterImporter(AssetTypeTraits<TerrainHeightField>::TypeID, TerrainHeightFieldImporter{});
 		}
 
+		MemoryTracker::SetBudgetCallback(&onMemoryBudgetExceeded, nullptr);
+
 		// Renderer + shader factory
 		m_pRenderer = std::make_unique<Renderer>();
 		{
@@ -140,6 +159,7 @@ namespace shz
 			rendererCI.BackBufferWidth = m_Viewport.Width;
 			rendererCI.BackBufferHeight = m_Viewport.Height;
 			rendererCI.pAssetManager = m_pAssetManager.get();
+			rendererCI.ShaderHotReloadDirectory = kShaderRoot;
 
 			m_pRenderer->Initialize(rendererCI);
 		}
@@ -186,6 +206,7 @@ namespace shz
 			pci.PhysicsCI.MaxContactConstraints = 10240;
 			pci.PhysicsCI.TempAllocatorSizeBytes = 16u * 1024u * 1024u;
 			pci.PhysicsCI.Gravity = float3(0.0f, -9.81f, 0.0f);
+			pci.pAssetManager = m_pAssetManager.get();
 
 			m_pPhysicsSystem->Initialize(pci);
 		}
@@ -312,6 +333,8 @@ namespace shz
 
 	void GrassViewer::Update(double currTime, double elapsedTime, bool doUpdateUI)
 	{
+		MemoryTracker::CaptureSnapshot(m_MemorySnapshot);
+
 		SampleBase::Update(currTime, elapsedTime, doUpdateUI);
 
 		ASSERT(m_pRenderScene, "RenderScene is null.");
@@ -329,6 +352,17 @@ namespace shz
 		ASSERT(m_GlobalLightHandle.IsValid(), "GlobalLightHandle is invalid.");
 		m_pRenderScene->UpdateLight(m_GlobalLightHandle, m_GlobalLight);
 
+		if (m_bPaintUnderCamera && m_TerrainPtr)
+		{
+			TerrainBrush brush = m_TerrainBrush;
+			brush.CenterX = m_Camera.GetPos().x;
+			brush.CenterZ = m_Camera.GetPos().z;
+			brush.Strength *= dt;
+			m_TerrainPtr->ApplyBrush(brush);
+		}
+
+		ApplyTerrainEdits();
+
 		ASSERT(m_pEcs->IsValid(), "ECS world is not valid.");
 		if (m_pEcs->IsValid())
 		{
@@ -336,6 +370,38 @@ namespace shz
 		}
 	}
 
+	void GrassViewer::ApplyTerrainEdits()
+	{
+		if (!m_TerrainPtr || !m_TerrainPtr->HasDirtyRect())
+		{
+			return;
+		}
+
+		TerrainHeightField& terrain = *m_TerrainPtr;
+		const TerrainDirtyRect rect = terrain.ConsumeDirtyRect();
+
+		// Render: affected chunks + height texture sub-rect
+		std::vector<uint32> rebuilt;
+		TerrainMeshBuilder::RebuildDirtyChunks(&m_TerrainChunks, terrain, rect, m_TerrainBuildSettings, &rebuilt);
+
+		for (uint32 c : rebuilt)
+		{
+			const TerrainChunk& chunk = m_TerrainChunks[c];
+			m_pRenderer->UpdateStaticMeshRenderData(TERRAIN_CHUNK_KEY_BASE + c, chunk.Mesh, chunk.DirtyVertexRanges, chunk.DirtyFirstIndex, chunk.DirtyIndexCount);
+		}
+
+		m_pRenderer->UpdateTextureRenderDataFromHeightField(*m_pTerrainHeightMap, terrain, rect);
+
+		// Physics: the collider reads the same asset, so only the Jolt shape needs patching
+		if (m_TerrainPhysicsEntity.is_alive())
+		{
+			const CHeightFieldCollider& hf = m_TerrainPhysicsEntity.get<CHeightFieldCollider>();
+			const CRigidbody& rb = m_TerrainPhysicsEntity.get<CRigidbody>();
+
+			m_pPhysicsSystem->PatchHeightField(hf, rb, rect);
+		}
+	}
+
 	void GrassViewer::ReleaseSwapChainBuffers()
 	{
 		SampleBase::ReleaseSwapChainBuffers();
@@ -406,6 +472,183 @@ namespace shz
 
 			for (const auto& kv : passTable)
 				ImGui::Text("%s: %llu", kv.first.c_str(), (unsigned long long)kv.second);
+
+			const auto stateTable = m_pRenderer->GetPassStateChangeTable();
+			ImGui::Separator();
+			for (const auto& kv : stateTable)
+			{
+				const DrawStateChangeStats& sc = kv.second;
+				if (sc.Draws == 0)
+					continue;
+
+				const uint64 binds = sc.PSOBinds + sc.SRBBinds + sc.VBBinds + sc.IBBinds;
+				ImGui::Text("%s binds: PSO %llu, SRB %llu, VB %llu, IB %llu (skipped %llu)",
+					kv.first.c_str(),
+					(unsigned long long)sc.PSOBinds, (unsigned long long)sc.SRBBinds,
+					(unsigned long long)sc.VBBinds, (unsigned long long)sc.IBBinds,
+					(unsigned long long)(sc.Draws * 4 - binds));
+
+				if (sc.RecordMilliseconds > 0.0)
+				{
+					ImGui::Text("%s record: %.3f ms (%.0f draws/ms)",
+						kv.first.c_str(), sc.RecordMilliseconds, double(sc.Draws) / sc.RecordMilliseconds);
+				}
+			}
+
+			const RenderScene::ClusterCullStats& cc = m_pRenderer->GetClusterCullStats();
+			ImGui::Separator();
+			ImGui::Text("Clusters: %llu / %llu", (unsigned long long)cc.ClustersKept, (unsigned long long)cc.ClustersTested);
+			ImGui::Text("Cluster Triangles: %llu / %llu (%llu drawn)", (unsigned long long)cc.TrianglesKept, (unsigned long long)cc.TrianglesTested, (unsigned long long)cc.TrianglesDrawn);
+			ImGui::Text("Cluster Ranges: %llu (%llu sections whole)", (unsigned long long)cc.RangesEmitted, (unsigned long long)cc.SectionsDrawnWhole);
+
+			const BarrierBatchStats& bs = m_pRenderer->GetBarrierStats();
+			ImGui::Separator();
+			ImGui::Text("Barriers: %u emitted / %u pushed", bs.Emitted, bs.Pushed);
+			ImGui::Text("Barriers Merged: %u, Skipped: %u", bs.Merged, bs.Skipped);
+
+			const ParallelRecordStats& pr = m_pRenderer->GetParallelRecordStats();
+			ImGui::Separator();
+			ImGui::Text("Command Lists: %u (record %.3f ms, submit %.3f ms)", pr.CommandLists, pr.RecordMilliseconds, pr.SubmitMilliseconds);
+
+			// Per-thread totals; index 0 is the render thread.
+			double threadMilliseconds[16] = {};
+			for (const PassRecordTiming& t : m_pRenderer->GetPassRecordTimings())
+			{
+				ImGui::Text("%s: %.3f ms (%s, thread %u)", t.PassName, t.CpuMilliseconds, t.bDeferred ? "deferred" : "immediate", t.ThreadIndex);
+				threadMilliseconds[std::min<uint32>(t.ThreadIndex, 15)] += t.CpuMilliseconds;
+			}
+
+			for (uint32 i = 0; i < 16; ++i)
+			{
+				if (threadMilliseconds[i] > 0.0)
+					ImGui::Text("Thread %u: %.3f ms", i, threadMilliseconds[i]);
+			}
+
+			const ShaderBytecodeCacheStats& sc = m_pRenderer->GetShaderCacheStats();
+			ImGui::Separator();
+			ImGui::Text("Shader Cache: %u hits (%.1f ms), %u misses (%.1f ms)", sc.Hits, sc.HitMilliseconds, sc.Misses, sc.MissMilliseconds);
+
+			const ShaderPreprocessCacheStats sp = m_pRenderer->GetShaderPreprocessStats();
+			ImGui::Text("Shader Sources: %u reads, %u from memory, %u changed", sp.FileReads, sp.CachedReads, sp.ChangedFiles);
+			ImGui::Text("Expanded Units: %u built, %u reused", sp.UnitBuilds, sp.UnitHits);
+
+			const PipelineStateManagerStats& ps = m_pRenderer->GetPipelineStateStats();
+			ImGui::Text("PSOs: %u graphics, %u compute, %u shared hits (create %.1f ms)",
+				ps.UniqueGraphics, ps.UniqueCompute, ps.Hits, ps.CreateMilliseconds);
+
+			const RenderStateArchiveStats& ra = m_pRenderer->GetRenderStateArchiveStats();
+			ImGui::Text("Render States: %u shaders, %u PSOs unpacked (%.1f ms), %u misses",
+				ra.UnpackedShaders, ra.UnpackedPipelines, ra.UnpackMilliseconds, ra.ShaderMisses + ra.PipelineMisses);
+
+			const MaterialConstantPoolStats& mc = m_pRenderer->GetMaterialConstantStats();
+			ImGui::Text("Material Constants: %u in %u pages, %u ranges / %llu bytes uploaded (%.3f ms)",
+				mc.AllocationCount, mc.PageCount, mc.FlushedRanges, static_cast<unsigned long long>(mc.FlushedBytes), mc.FlushMilliseconds);
+
+			const MaterialRenderDataStats& md = m_pRenderer->GetMaterialRenderDataStats();
+			ImGui::Text("Material Render Data: %u unique / %u requested (%u shared)",
+				md.Unique, md.Requests, md.SharedRequests);
+
+			const ShaderReloadStats& sr = m_pRenderer->GetShaderReloadStats();
+			ImGui::Text("Shader Reload: %u (%u templates, %u materials, %u passes, %u failed) last %.1f ms, swap %.3f ms%s",
+				sr.Reloads, sr.ReloadedTemplates, sr.ReloadedMaterials, sr.ReloadedPasses, sr.FailedReloads,
+				sr.LastReloadMilliseconds, sr.LastSwapMilliseconds, m_pRenderer->IsShaderReloadPending() ? " (compiling)" : "");
+
+			const ShaderStartupStats& ss = m_pRenderer->GetShaderStartupStats();
+			ImGui::Text("Shader Startup: %.1f ms (%s, %u async, wait %.1f ms)",
+				ss.TotalMilliseconds, ss.AsyncCompile ? "parallel" : "serial", sc.AsyncMisses, sc.ResolveMilliseconds);
+			ImGui::Text("  Templates %.1f + %.1f ms, Passes %.1f + %.1f ms",
+				ss.TemplateRequestMilliseconds, ss.TemplateFinishMilliseconds, ss.PassMilliseconds, ss.PipelineMilliseconds);
+		}
+		ImGui::End();
+
+		ImGui::SetNextWindowPos(ImVec2(10, 430), ImGuiCond_FirstUseEver);
+
+		if (ImGui::Begin("Terrain Brush", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			static const char* kModes[] = { "Raise", "Lower", "Flatten", "Smooth" };
+
+			int mode = static_cast<int>(m_TerrainBrush.Mode);
+			if (ImGui::Combo("Mode", &mode, kModes, IM_ARRAYSIZE(kModes)))
+			{
+				m_TerrainBrush.Mode = static_cast<ETerrainBrushMode>(mode);
+			}
+
+			ImGui::SliderFloat("Radius", &m_TerrainBrush.Radius, 1.0f, 200.0f);
+			ImGui::SliderFloat("Strength / s", &m_TerrainBrush.Strength, 0.001f, 1.0f, "%.3f");
+			ImGui::SliderFloat("Falloff", &m_TerrainBrush.Falloff, 0.0f, 1.0f);
+			ImGui::SliderFloat("Target Height", &m_TerrainBrush.TargetHeight, 0.0f, 1.0f);
+			ImGui::Checkbox("Paint Under Camera", &m_bPaintUnderCamera);
+		}
+		ImGui::End();
+
+		ImGui::SetNextWindowPos(ImVec2(10, 640), ImGuiCond_FirstUseEver);
+
+		if (ImGui::Begin("Memory", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+		{
+			constexpr double MB = 1.0 / (1024.0 * 1024.0);
+
+			if (ImGui::BeginTable("##MemoryTags", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+			{
+				ImGui::TableSetupColumn("Tag");
+				ImGui::TableSetupColumn("Current (MB)");
+				ImGui::TableSetupColumn("Peak (MB)");
+				ImGui::TableSetupColumn("Budget (MB)");
+				ImGui::TableSetupColumn("Live Allocs");
+				ImGui::TableHeadersRow();
+
+				for (uint32 i = 0; i < static_cast<uint32>(EMemoryTag::Count); ++i)
+				{
+					const EMemoryTag tag = static_cast<EMemoryTag>(i);
+					const MemoryTagStats& s = m_MemorySnapshot[tag];
+					const bool overBudget = (s.BudgetBytes != 0) && (s.CurrentBytes > s.BudgetBytes);
+
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::TextUnformatted(GetMemoryTagName(tag));
+
+					ImGui::TableNextColumn();
+					if (overBudget)
+						ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%.2f", s.CurrentBytes * MB);
+					else
+						ImGui::Text("%.2f", s.CurrentBytes * MB);
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%.2f", s.PeakBytes * MB);
+
+					ImGui::TableNextColumn();
+					if (s.BudgetBytes != 0)
+						ImGui::Text("%.2f", s.BudgetBytes * MB);
+					else
+						ImGui::TextDisabled("-");
+
+					ImGui::TableNextColumn();
+					ImGui::Text("%lld", (long long)(s.AllocCount - s.FreeCount));
+				}
+
+				ImGui::EndTable();
+			}
+
+			// AssetManager's resident estimate is not heap traffic (the asset
+			// heap memory already shows under the tags above), so it is a gauge
+			// against the streaming budget rather than a tag row.
+			if (m_pAssetManager)
+			{
+				const uint64 residentBytes = m_pAssetManager->GetResidentBytes();
+				const uint64 budgetBytes = m_pAssetManager->GetBudgetBytes();
+
+				char label[64];
+				std::snprintf(label, sizeof(label), "%.1f / %.1f MB", residentBytes * MB, budgetBytes * MB);
+
+				const bool overBudget = (budgetBytes != 0) && (residentBytes > budgetBytes);
+
+				ImGui::TextUnformatted("Assets (resident)");
+				ImGui::SameLine();
+				if (overBudget)
+					ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
+				ImGui::ProgressBar(budgetBytes != 0 ? static_cast<float>(static_cast<double>(residentBytes) / budgetBytes) : 0.0f, ImVec2(240.0f, 0.0f), label);
+				if (overBudget)
+					ImGui::PopStyleColor();
+			}
 		}
 		ImGui::End();
 	}
@@ -427,9 +670,11 @@ namespace shz
 		AssetPtr<TerrainHeightField> terrainPtr = m_pAssetManager->LoadBlocking<TerrainHeightField>(terrainRef);
 		ASSERT(terrainPtr && terrainPtr->IsValid(), "Failed to load terrain height field.");
 
-		// Build terrain mesh + set RenderScene terrain
+		// Kept for runtime edits
+		m_TerrainPtr = terrainPtr;
+
+		// Build terrain chunks + set RenderScene terrain
 		{
-			StaticMesh terrainMesh;
 
 			Material tm("TerrainMaterial", "DefaultLit");
 			tm.SetFloat4("g_BaseColorFactor", float4(150.f, 200.f, 100.f, 255.f) / 255.f);
@@ -442,13 +687,20 @@ namespace shz
 			tm.SetFloat("g_MetallicFactor", 0.0f);
 			tm.SetUint("g_MaterialFlags", 0);
 
-			TerrainMeshBuilder meshBuilder;
-			TerrainMeshBuildSettings buildSettings = {};
-			meshBuilder.BuildStaticMesh(&terrainMesh, *terrainPtr, std::move(tm), buildSettings);
+			m_pTerrainMaterial = std::make_unique<Material>(std::move(tm));
+			m_TerrainBuildSettings = {};
+			TerrainMeshBuilder::BuildChunkedStaticMeshes(&m_TerrainChunks, *terrainPtr, m_TerrainBuildSettings);
 
-			m_pRenderScene->SetTerrain(
-				m_pRenderer->CreateTextureRenderDataFromHeightField(*terrainPtr),
-				m_pRenderer->CreateStaticMeshRenderData(terrainMesh));
+			// Updatable buffers with known keys, so edited chunks can be re-uploaded in place
+			std::vector<const StaticMeshRenderData*> chunkRenderData;
+			chunkRenderData.reserve(m_TerrainChunks.size());
+			for (uint32 c = 0; c < static_cast<uint32>(m_TerrainChunks.size()); ++c)
+			{
+				chunkRenderData.push_back(&m_pRenderer->CreateStaticMeshRenderData(m_TerrainChunks[c].Mesh, *m_pTerrainMaterial, TERRAIN_CHUNK_KEY_BASE + c, "TerrainChunk", true));
+			}
+
+			m_pTerrainHeightMap = &m_pRenderer->CreateTextureRenderDataFromHeightField(terrainRef);
+			m_pRenderScene->SetTerrain(*m_pTerrainHeightMap, chunkRenderData);
 		}
 
 		// ------------------------------------------------------------
@@ -462,25 +714,6 @@ namespace shz
 			//  Physics ۴ square   , Ͱ square   .
 			ASSERT(W == H, "HeightField collider: width/height must be equal (square) for your current pipeline.");
 
-			// Convert to float heights (world meters)
-			const auto& src = terrainPtr->GetDataU16(); //  ڵ忡 ־ API 
-			ASSERT(src.size() == size_t(W) * size_t(H), "HeightField data size mismatch.");
-
-			std::vector<float> samples;
-			samples.resize(src.size());
-
-			const float heightScale = terrainPtr->GetHeightScale();
-			const float heightOffset = terrainPtr->GetHeightOffset();
-
-			for (size_t i = 0; i < src.size(); ++i)
-			{
-				const float n = float(src[i]) / 65535.0f;
-				samples[i] = n * heightScale + heightOffset;
-			}
-
-			const float spacingX = terrainPtr->GetWorldSpacingX();
-			const float spacingZ = terrainPtr->GetWorldSpacingZ();
-
 			//  ڵ尡 worldOrigin shape offset ־µ,
 			//  ۿ shape offset   Ƿ Transform ġ .
 			const float worldOriginX = -terrainPtr->GetWorldSizeX() * 0.5f;
@@ -502,15 +735,12 @@ namespace shz
 			rb.bStartActive = false;
 			e.set<CRigidbody>(rb);
 
+			// Shape is built from the asset's own samples (no float copy)
 			CHeightFieldCollider hf = {};
-			hf.Width = W;
-			hf.Height = H;
-			hf.CellSizeX = spacingX;
-			hf.CellSizeZ = spacingZ;
-			hf.HeightScale = 1.0f;   // samples already in world meters
-			hf.HeightOffset = 0.0f;
-			hf.Heights = std::move(samples);
+			hf.HeightFieldRef = terrainRef;
 			e.set<CHeightFieldCollider>(hf);
+
+			m_TerrainPhysicsEntity = e;
 		}
 
 		// ------------------------------------------------------------
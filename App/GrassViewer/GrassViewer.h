@@ -21,11 +21,16 @@
 
 #include "Engine/ECSIntegration/Public/PhysicsSystem.h"
 
+#include "Engine/RuntimeData/Public/TerrainMeshBuilder.h"
+
+#include "Engine/Core/Memory/Public/MemoryTracker.h"
+
 namespace shz
 {
 	class GrassViewer final : public SampleBase
 	{
 	public:
+		void ModifyEngineInitInfo(const ModifyEngineInitInfoAttribs& Attribs) override final;
 		void Initialize(const SampleInitInfo& InitInfo) override final;
 
 		void Render() override final;
@@ -48,6 +53,7 @@ namespace shz
 
 	private:
 		void BuildSceneOnce();
+		void ApplyTerrainEdits();
 		static Matrix4x4 ToMatrixTRS(const CTransform& t);
 
 	private:
@@ -68,5 +74,21 @@ namespace shz
 		Handle<RenderScene::LightObject> m_GlobalLightHandle = {};
 
 		float m_Speed = 3.0f;
+
+		// Terrain editing
+		static constexpr uint64 TERRAIN_CHUNK_KEY_BASE = 0x54455252'00000000ull;
+
+		AssetPtr<TerrainHeightField> m_TerrainPtr = {};
+		std::vector<TerrainChunk> m_TerrainChunks = {};
+		TerrainChunkBuildSettings m_TerrainBuildSettings = {};
+		std::unique_ptr<Material> m_pTerrainMaterial = nullptr;
+		const TextureRenderData* m_pTerrainHeightMap = nullptr;
+		flecs::entity m_TerrainPhysicsEntity = {};
+
+		TerrainBrush m_TerrainBrush = {};
+		bool m_bPaintUnderCamera = false;
+
+		// Captured once per frame for the Memory window
+		MemorySnapshot m_MemorySnapshot = {};
 	};
 } // namespace shz
@@ -10,6 +10,7 @@
 #include "Engine/RuntimeData/Public/StaticMeshImporter.h"
 #include "Engine/RuntimeData/Public/TextureImporter.h"
 #include "Engine/RuntimeData/Public/MaterialImporter.h"
+#include "Engine/RuntimeData/Public/MaterialLibraryImporter.h"
 #include "Engine/AssetManager/Public/AssimpImporter.h"
 
 #include "Engine/RuntimeData/Public/StaticMeshExporter.h"
@@ -461,7 +462,7 @@ namespace shz
 			if (bytes.empty())
 				continue;
 
-			(void)mat.SetRaw(desc.Name.c_str(), desc.Type, bytes.data(), (uint32)bytes.size());
+			(void)mat.SetRaw(tmpl.GetValueParamId(i), bytes.data(), (uint32)bytes.size());
 		}
 
 		// ------------------------------------------------------------
@@ -688,6 +689,7 @@ namespace shz
 		m_pAssetManager->RegisterImporter(AssetTypeTraits<StaticMesh>::TypeID, StaticMeshImporter{});
 		m_pAssetManager->RegisterImporter(AssetTypeTraits<Texture>::TypeID, TextureImporter{});
 		m_pAssetManager->RegisterImporter(AssetTypeTraits<Material>::TypeID, MaterialImporter{});
+		m_pAssetManager->RegisterImporter(AssetTypeTraits<MaterialLibrary>::TypeID, MaterialLibraryImporter{});
 		m_pAssetManager->RegisterImporter(AssetTypeTraits<AssimpAsset>::TypeID, AssimpImporter{});
 
 		m_pAssetManager->RegisterExporter(AssetTypeTraits<StaticMesh>::TypeID, StaticMeshExporter{});
@@ -715,6 +717,7 @@ namespace shz
 		rci.BackBufferWidth = std::max(1u, scDesc.Width);
 		rci.BackBufferHeight = std::max(1u, scDesc.Height);
 		rci.pAssetManager = m_pAssetManager.get();
+		rci.ShaderHotReloadDirectory = kShaderRoot;
 
 		rci.EnvTexturePath = "C:/Dev/ShizenEngine/Assets/Cubemap/Sample/SampleEnvHDR.dds";
 		rci.DiffuseIrradianceTexPath = "C:/Dev/ShizenEngine/Assets/Cubemap/Sample/SampleDiffuseHDR.dds";
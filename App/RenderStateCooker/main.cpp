@@ -0,0 +1,195 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Engine/Core/Runtime/Public/CommandLineParser.hpp"
+#include "Engine/Core/Common/Public/Timer.hpp"
+#include "Engine/GraphicsArchiver/Public/ArchiverFactoryLoader.h"
+#include "Engine/GraphicsTools/Public/RenderStateArchive.h"
+#include "Engine/RHI_Null/Public/IEngineFactoryNull.h"
+#include "Engine/Renderer/Public/Renderer.h"
+#include "Engine/AssetManager/Public/AssetManager.h"
+#include "Engine/RuntimeData/Public/StaticMeshImporter.h"
+#include "Engine/RuntimeData/Public/TextureImporter.h"
+
+// ------------------------------------------------------------
+// RenderStateCooker
+// - Writes the render state archive the renderer reads at startup
+//   (RendererCreateInfo::RenderStateArchivePath), without a GPU.
+// - The renderer is initialized on the null device, which compiles
+//   and reflects every shader with DXC like the D3D12 backend. Every
+//   shader and pass pipeline it creates goes into a RenderStateArchive
+//   cooking for D3D12 on the serialization device.
+// - Material pipelines are created for every material template with
+//   every combination of the material options that change the PSO.
+// - App-RenderStateCooker [--output <archive>] [--shaders <dir>] [--dxcompiler <dll>]
+// ------------------------------------------------------------
+namespace shz
+{
+	namespace
+	{
+		constexpr const char* DEFAULT_SHADER_ROOT = "C:/Dev/ShizenEngine/Shaders";
+
+		// Pass pipelines depend on the render target formats only.
+		constexpr uint32 BACK_BUFFER_WIDTH = 1280;
+		constexpr uint32 BACK_BUFFER_HEIGHT = 720;
+
+		constexpr MATERIAL_BLEND_MODE BLEND_MODES[] =
+		{
+			MATERIAL_BLEND_MODE_OPAQUE,
+			MATERIAL_BLEND_MODE_MASKED,
+			MATERIAL_BLEND_MODE_TRANSLUCENT,
+			MATERIAL_BLEND_MODE_ADDITIVE,
+			MATERIAL_BLEND_MODE_PREMULTIPLIED,
+		};
+
+		constexpr CULL_MODE CULL_MODES[] =
+		{
+			CULL_MODE_BACK,
+			CULL_MODE_NONE,
+		};
+
+		constexpr MATERIAL_TEXTURE_BINDING_MODE TEXTURE_BINDING_MODES[] =
+		{
+			MATERIAL_TEXTURE_BINDING_MODE_DYNAMIC,
+			MATERIAL_TEXTURE_BINDING_MODE_MUTABLE,
+		};
+
+		// Returns the number of material variants created.
+		uint32 cookMaterialTemplates(Renderer& renderer)
+		{
+			uint32 variants = 0;
+			for (const std::string& templateName : renderer.GetAllMaterialTemplateNames())
+			{
+				for (MATERIAL_BLEND_MODE blendMode : BLEND_MODES)
+				{
+					for (CULL_MODE cullMode : CULL_MODES)
+					{
+						for (MATERIAL_TEXTURE_BINDING_MODE bindingMode : TEXTURE_BINDING_MODES)
+						{
+							Material material(templateName + ".Cook", templateName);
+							material.SetBlendMode(blendMode);
+							material.SetCullMode(cullMode);
+							material.SetTextureBindingMode(bindingMode);
+
+							// Explicit keys: every variant is built, even if two of them share a PSO.
+							renderer.CreateMaterialRenderData(material, ++variants, material.GetName());
+						}
+					}
+				}
+
+				std::printf("  %s\n", templateName.c_str());
+			}
+			return variants;
+		}
+	} // namespace
+
+	static int runCooker(int argc, char** argv)
+	{
+		RendererCreateInfo rendererCI = {};
+
+		std::string outputPath = rendererCI.RenderStateArchivePath;
+		std::string shaderRoot = DEFAULT_SHADER_ROOT;
+		std::string dxCompilerPath;
+		{
+			CommandLineParser argsParser{ argc, argv };
+			argsParser.Parse("output", 'o', outputPath);
+			argsParser.Parse("shaders", 's', shaderRoot);
+			argsParser.Parse("dxcompiler", 'd', dxCompilerPath);
+		}
+
+		IArchiverFactory* pArchiverFactory = LoadAndGetArchiverFactory();
+		if (pArchiverFactory == nullptr)
+		{
+			std::printf("Failed to load the archiver.\n");
+			return 1;
+		}
+
+		IEngineFactoryNull* pFactory = GetEngineFactoryNull();
+
+		EngineNullCreateInfo engineCI = {};
+		engineCI.pDxCompilerPath = dxCompilerPath.empty() ? nullptr : dxCompilerPath.c_str();
+
+		RefCntAutoPtr<IRenderDevice> pDevice;
+		RefCntAutoPtr<IDeviceContext> pImmediateContext;
+		pFactory->CreateDeviceAndContextsNull(engineCI, &pDevice, &pImmediateContext);
+		if (!pDevice)
+		{
+			std::printf("Failed to create the null device.\n");
+			return 1;
+		}
+
+		SwapChainDesc scDesc = {};
+		scDesc.Width = BACK_BUFFER_WIDTH;
+		scDesc.Height = BACK_BUFFER_HEIGHT;
+
+		RefCntAutoPtr<ISwapChain> pSwapChain;
+		pFactory->CreateSwapChainNull(pDevice, pImmediateContext, scDesc, &pSwapChain);
+
+		RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+		pFactory->CreateDefaultShaderSourceStreamFactory(shaderRoot.c_str(), &pShaderSourceFactory);
+
+		// Outlives the renderer: it keeps the runtime shaders it re-wrapped.
+		RenderStateArchive archive;
+		if (!archive.BeginCook(pDevice, pArchiverFactory, RENDER_DEVICE_TYPE_D3D12))
+		{
+			return 1;
+		}
+
+		// Initialize() loads the renderer's built-in textures and meshes.
+		AssetManager assetManager;
+		assetManager.Initialize();
+		assetManager.RegisterImporter(AssetTypeTraits<StaticMesh>::TypeID, StaticMeshImporter{});
+		assetManager.RegisterImporter(AssetTypeTraits<Texture>::TypeID, TextureImporter{});
+
+		rendererCI.pEngineFactory = pFactory;
+		rendererCI.pDevice = pDevice;
+		rendererCI.pImmediateContext = pImmediateContext;
+		rendererCI.pSwapChain = pSwapChain;
+		rendererCI.pShaderSourceFactory = pShaderSourceFactory;
+		rendererCI.pAssetManager = &assetManager;
+		rendererCI.BackBufferWidth = BACK_BUFFER_WIDTH;
+		rendererCI.BackBufferHeight = BACK_BUFFER_HEIGHT;
+		rendererCI.pCookArchive = &archive;
+
+		// Every shader is compiled here: the bytecode cache is keyed by device type and
+		// the pipeline cache is a driver blob, neither belongs to the null device.
+		rendererCI.ShaderBytecodeCachePath.clear();
+		rendererCI.PipelineStateCachePath.clear();
+
+		Timer timer;
+
+		std::unique_ptr<Renderer> pRenderer = std::make_unique<Renderer>();
+		if (!pRenderer->Initialize(rendererCI))
+		{
+			std::printf("Renderer initialization failed.\n");
+			return 1;
+		}
+
+		const RenderStateArchiveStats& stats = archive.GetStats();
+		std::printf("Passes: %u shaders, %u pipelines\n", stats.CookedShaders, stats.CookedPipelines);
+
+		std::printf("Material templates:\n");
+		const uint32 variants = cookMaterialTemplates(*pRenderer);
+
+		pRenderer->Cleanup();
+		pRenderer.reset();
+
+		std::printf("%u material variants, %u shaders, %u pipelines, %u skipped (%.1f s)\n",
+			variants, stats.CookedShaders, stats.CookedPipelines, stats.SkippedObjects, timer.GetElapsedTime());
+
+		if (!archive.SaveCooked(outputPath))
+		{
+			return 1;
+		}
+
+		std::printf("Written '%s'\n", outputPath.c_str());
+		return 0;
+	}
+} // namespace shz
+
+int main(int argc, char** argv)
+{
+	return shz::runCooker(argc, argv);
+}
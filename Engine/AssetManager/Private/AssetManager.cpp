@@ -579,7 +579,12 @@ namespace shz
 			return *existing;
 		}
 
-		auto rec = std::make_unique<AssetRecord>();
+		if (!m_RecordPool.IsInitialized())
+		{
+			m_RecordPool.Initialize(RECORDS_PER_PAGE);
+		}
+
+		auto rec = m_RecordPool.MakeUnique();
 		rec->ID = id;
 		rec->TypeID = typeId;
 		rec->StrongRefCount.store(0, std::memory_order_relaxed);
@@ -587,7 +592,7 @@ namespace shz
 		rec->LoadFlags.store(0, std::memory_order_relaxed);
 
 		AssetRecord* pOut = rec.get();
-		m_Records.emplace(id, static_cast<std::unique_ptr<AssetRecord>&&>(rec));
+		m_Records.emplace(id, std::move(rec));
 		return *pOut;
 	}
 
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "Primitives/BasicTypes.h"
+#include "Engine/Core/Memory/Public/ConcurrentObjectPool.h"
 
 #include "Engine/AssetManager/Public/AssetRef.hpp"
 #include "Engine/AssetManager/Public/AssetPtr.hpp"
@@ -175,7 +176,10 @@ namespace shz
 		mutable std::mutex m_MapMutex = {};
 
 		AssetRegistry m_Registry = {};
-		std::unordered_map<AssetID, std::unique_ptr<AssetRecord>> m_Records = {};
+
+		// Declared before m_Records: records are returned to the pool on destruction.
+		ConcurrentObjectPool<AssetRecord> m_RecordPool = {};
+		std::unordered_map<AssetID, ConcurrentObjectPool<AssetRecord>::UniquePtr> m_Records = {};
 		std::unordered_map<AssetTypeID, LoaderFn> m_Loaders = {};
 
 		// NEW
@@ -187,6 +191,8 @@ namespace shz
 
 		uint32 m_MaxEvictPerCollect = 32;
 
+		static constexpr uint32 RECORDS_PER_PAGE = 256;
+
 		// NEW
 		std::atomic<bool> m_ShuttingDown{ false };
 	};
@@ -0,0 +1,48 @@
+﻿#include "pch.h"
+#include "Engine/Core/Common/Public/ParallelFor.hpp"
+
+namespace shz
+{
+	namespace
+	{
+		struct ParallelForPool final
+		{
+			uint32 WorkerCount = 0;
+			RefCntAutoPtr<IThreadPool> pThreadPool;
+
+			ParallelForPool()
+			{
+				const uint32 hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+				WorkerCount = hardwareThreads - 1;
+				if (WorkerCount == 0)
+				{
+					return;
+				}
+
+				ThreadPoolCreateInfo ci = {};
+				ci.NumThreads = WorkerCount;
+				pThreadPool = CreateThreadPool(ci);
+				if (!pThreadPool)
+				{
+					WorkerCount = 0;
+				}
+			}
+		};
+
+		ParallelForPool& getPool()
+		{
+			static ParallelForPool s_Pool;
+			return s_Pool;
+		}
+	} // namespace
+
+	IThreadPool* GetParallelForThreadPool()
+	{
+		return getPool().pThreadPool;
+	}
+
+	uint32 GetParallelForWorkerCount()
+	{
+		return getPool().WorkerCount;
+	}
+} // namespace shz
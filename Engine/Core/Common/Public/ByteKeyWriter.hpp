@@ -0,0 +1,73 @@
+#pragma once
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Common/Public/HashUtils.hpp"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// ByteKeyWriter
+	// - Hasher type for the HashUtils HashCombiner specializations that
+	//   appends bytes instead of hashing them, so a key built with it
+	//   can be compared byte for byte.
+	// - Strings are length prefixed (null and "" differ) to keep
+	//   adjacent strings from running into each other.
+	// ------------------------------------------------------------
+	class ByteKeyWriter final
+	{
+	public:
+		explicit ByteKeyWriter(std::vector<uint8>& bytes)
+			: m_Bytes{ bytes }
+		{
+		}
+
+		template <typename... ArgsType>
+		void operator()(const ArgsType&... args)
+		{
+			(Update(args), ...);
+		}
+
+		void Update(const Char* str)
+		{
+			const uint32 length = (str != nullptr) ? static_cast<uint32>(std::strlen(str)) : ~0u;
+			UpdateRaw(&length, sizeof(length));
+			if (str != nullptr)
+			{
+				UpdateRaw(str, length);
+			}
+		}
+
+		void Update(const std::string& str)
+		{
+			const uint32 length = static_cast<uint32>(str.size());
+			UpdateRaw(&length, sizeof(length));
+			UpdateRaw(str.data(), length);
+		}
+
+		template <typename T>
+		void Update(const T& val)
+		{
+			if constexpr (std::is_fundamental_v<T> || std::is_enum_v<T>)
+			{
+				UpdateRaw(&val, sizeof(val));
+			}
+			else
+			{
+				HashCombiner<ByteKeyWriter, T>{ *this }(val);
+			}
+		}
+
+		void UpdateRaw(const void* pData, size_t size)
+		{
+			const uint8* pBytes = static_cast<const uint8*>(pData);
+			m_Bytes.insert(m_Bytes.end(), pBytes, pBytes + size);
+		}
+
+	private:
+		std::vector<uint8>& m_Bytes;
+	};
+} // namespace shz
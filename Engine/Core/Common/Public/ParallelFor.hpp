@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Common/Public/ThreadPool.hpp"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// Shared worker pool used by ParallelFor.
+	// - Created on first use with hardware concurrency - 1 threads (the caller
+	//   of ParallelFor is the remaining one).
+	// - Returns nullptr on single-core machines; ParallelFor then runs inline.
+	// ------------------------------------------------------------
+	IThreadPool* GetParallelForThreadPool();
+	uint32 GetParallelForWorkerCount();
+
+	// ------------------------------------------------------------
+	// ParallelFor
+	//
+	// Calls fn(begin, end) for blocks of [0, count). Blocks are handed out through
+	// an atomic counter, so uneven blocks balance themselves. The calling thread
+	// works too and helpers come from GetParallelForThreadPool(); numThreads == 0
+	// means every pool worker, 1 runs inline.
+	//
+	// The caller only waits for the blocks, not for the helper tasks: a helper
+	// that starts after every block is claimed returns without touching fn.
+	// This keeps nested calls from a pool thread from deadlocking.
+	// ------------------------------------------------------------
+	template <typename FnType>
+	void ParallelFor(uint32 count, uint32 blockSize, uint32 numThreads, FnType&& fn)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		blockSize = std::max(blockSize, 1u);
+
+		const uint32 numBlocks = (count + blockSize - 1) / blockSize;
+
+		IThreadPool* pThreadPool = GetParallelForThreadPool();
+		const uint32 maxThreads = pThreadPool ? GetParallelForWorkerCount() + 1 : 1;
+
+		if (numThreads == 0)
+		{
+			numThreads = maxThreads;
+		}
+		numThreads = std::min({ numThreads, maxThreads, numBlocks });
+
+		if (numThreads <= 1)
+		{
+			fn(0u, count);
+			return;
+		}
+
+		// Outlives the call: late helpers still read NextBlock.
+		struct SharedState final
+		{
+			std::atomic<uint32> NextBlock = 0;
+			std::atomic<uint32> DoneBlocks = 0;
+		};
+		std::shared_ptr<SharedState> pState = std::make_shared<SharedState>();
+
+		auto* pFn = &fn;
+		auto worker = [pState, pFn, count, blockSize, numBlocks]()
+			{
+				for (;;)
+				{
+					const uint32 block = pState->NextBlock.fetch_add(1, std::memory_order_relaxed);
+					if (block >= numBlocks)
+					{
+						break;
+					}
+
+					const uint32 begin = block * blockSize;
+					const uint32 end = std::min(begin + blockSize, count);
+					(*pFn)(begin, end);
+
+					pState->DoneBlocks.fetch_add(1, std::memory_order_release);
+				}
+			};
+
+		for (uint32 i = 0; i + 1 < numThreads; ++i)
+		{
+			EnqueueAsyncWork(pThreadPool, [worker](uint32)
+				{
+					worker();
+					return ASYNC_TASK_STATUS_COMPLETE;
+				});
+		}
+
+		worker();
+
+		while (pState->DoneBlocks.load(std::memory_order_acquire) < numBlocks)
+		{
+			std::this_thread::yield();
+		}
+	}
+} // namespace shz
@@ -38,6 +38,7 @@
 #include "Primitives/DebugUtilities.hpp"
 #include "Engine/Core/Common/Public/SpinLock.hpp"
 #include "Engine/Core/Common/Public/Cast.hpp"
+#include "Engine/Core/Memory/Public/HeapAllocationCounter.h"
 
 namespace shz
 {
@@ -593,6 +594,7 @@ namespace shz
 
 		void* operator new(size_t Size)
 		{
+			CountHeapAllocation();
 			return malloc(Size);
 		}
 
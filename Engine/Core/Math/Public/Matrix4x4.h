@@ -3,6 +3,7 @@
 #include "Engine/Core/Math/Public/Vector3.h"
 #include "Engine/Core/Math/Public/Vector4.h"
 #include "Engine/Core/Math/Public/Matrix3x3.h"
+#include "Engine/Core/Math/Public/Box.h"
 
 namespace shz
 {
@@ -15,6 +16,10 @@ namespace shz
 	// IMPORTANT:
 	// Your MulVector4() computes dot(v, columnN),
 	// therefore basis extraction must be COLUMN-based to be consistent.
+	//
+	// operator*, Transposed, Inversed, InverseAffineFast and TransformBox
+	// run on XMatrix when SHZ_HAS_SSE is set (see the bottom of this file);
+	// define SHZ_FORCE_NO_SSE to get the scalar versions.
 	// ------------------------------------------------------------
 	struct Matrix4x4 final
 	{
@@ -149,13 +154,20 @@ namespace shz
 		{
 			// Euler is assumed in radians.
 			// With row vectors: v' = v * (S * R * T) applies S then R then T.
-			const Matrix4x4 Rx = RotationX(rotationEuler.x);
-			const Matrix4x4 Ry = RotationY(rotationEuler.y);
-			const Matrix4x4 Rz = RotationZ(rotationEuler.z);
-			const Matrix4x4 R = (Rx * Ry) * Rz;
-			const Matrix4x4 S = Scale(scale);
-			const Matrix4x4 T = Translation(translation);
-			return (S * R) * T;
+			// Closed form of S * (Rx * Ry * Rz) * T: row i of R scaled by scale[i],
+			// translation in the last row.
+			const float32 cx = (float32)std::cos(rotationEuler.x);
+			const float32 sx = (float32)std::sin(rotationEuler.x);
+			const float32 cy = (float32)std::cos(rotationEuler.y);
+			const float32 sy = (float32)std::sin(rotationEuler.y);
+			const float32 cz = (float32)std::cos(rotationEuler.z);
+			const float32 sz = (float32)std::sin(rotationEuler.z);
+
+			return Matrix4x4(
+				scale.x * (cy * cz), scale.x * (cy * sz), scale.x * (-sy), 0,
+				scale.y * (sx * sy * cz - cx * sz), scale.y * (sx * sy * sz + cx * cz), scale.y * (sx * cy), 0,
+				scale.z * (cx * sy * cz + sx * sz), scale.z * (cx * sy * sz - sx * cz), scale.z * (cx * cy), 0,
+				translation.x, translation.y, translation.z, 1);
 		}
 
 		// --------------------------------------------------------
@@ -370,116 +382,235 @@ namespace shz
 		// --------------------------------------------------------
 		// Algebra
 		// --------------------------------------------------------
-		inline Matrix4x4 Transposed() const
+		inline Matrix4x4 Transposed() const;
+		inline Matrix4x4 operator*(const Matrix4x4& rhs) const;
+		inline Matrix4x4 Inversed() const;
+		inline Matrix4x4 InverseAffineFast() const;
+
+		// World-space AABB of an affine-transformed local AABB (Arvo).
+		// The box must be valid (Min <= Max).
+		inline Box TransformBox(const Box& localBox) const;
+	};
+
+	static_assert(sizeof(Matrix4x4) == sizeof(float32) * 16, "Matrix4x4 size is incorrect.");
+	static_assert(alignof(Matrix4x4) == alignof(float32), "Matrix4x4 alignment is incorrect.");
+
+} // namespace shz
+
+#include "Engine/Core/Math/Public/XMatrix.h"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// XMatrix <-> Matrix4x4
+	// ------------------------------------------------------------
+	inline XMatrix XMatrix::Load(const Matrix4x4& M)
+	{
+		XMatrix xm{};
+		xm.r0 = XVector::Load4(M.m[0]);
+		xm.r1 = XVector::Load4(M.m[1]);
+		xm.r2 = XVector::Load4(M.m[2]);
+		xm.r3 = XVector::Load4(M.m[3]);
+		return xm;
+	}
+
+	inline Matrix4x4 XMatrix::Store() const
+	{
+		Matrix4x4 out;
+		r0.Store4(out.m[0]);
+		r1.Store4(out.m[1]);
+		r2.Store4(out.m[2]);
+		r3.Store4(out.m[3]);
+		return out;
+	}
+
+#if SHZ_HAS_SSE
+	// ------------------------------------------------------------
+	// Matrix4x4 algebra (SIMD)
+	// ------------------------------------------------------------
+	inline Matrix4x4 Matrix4x4::Transposed() const
+	{
+		return XMatrix::Load(*this).Transposed().Store();
+	}
+
+	inline Matrix4x4 Matrix4x4::operator*(const Matrix4x4& rhs) const
+	{
+		return XMatrix::Mul(XMatrix::Load(*this), XMatrix::Load(rhs)).Store();
+	}
+
+	inline Matrix4x4 Matrix4x4::Inversed() const
+	{
+		float32 det = 0.f;
+		const XMatrix inv = XMatrix::Inverse(XMatrix::Load(*this), &det);
+		ASSERT(std::fabs(det) > 0.f, "Attempted to invert a matrix with zero determinant.");
+		return inv.Store();
+	}
+
+	inline Matrix4x4 Matrix4x4::InverseAffineFast() const
+	{
+		ASSERT(std::fabs(_m03) < 1e-6f && std::fabs(_m13) < 1e-6f && std::fabs(_m23) < 1e-6f, "Matrix is not affine.");
+		ASSERT(std::fabs(_m33 - 1.0f) < 1e-6f, "Matrix is not affine.");
+
+		float32 det = 0.f;
+		const XMatrix inv = XMatrix::InverseAffine(XMatrix::Load(*this), &det);
+		ASSERT(std::fabs(det) > 0.f, "Attempted to invert a matrix with zero determinant.");
+		return inv.Store();
+	}
+
+	inline Box Matrix4x4::TransformBox(const Box& localBox) const
+	{
+		const XMatrix M = XMatrix::Load(*this);
+
+		const XVector mn = XVector::Load3(localBox.Min);
+		const XVector mx = XVector::Load3(localBox.Max);
+		const XVector center = (mn + mx) * 0.5f;
+		const XVector extent = (mx - mn) * 0.5f;
+
+		XVector c = M.r3;
+		c += M.r0 * XVector::Swizzle<0x00>(center);
+		c += M.r1 * XVector::Swizzle<0x55>(center);
+		c += M.r2 * XVector::Swizzle<0xAA>(center);
+
+		XVector e = XVector::Abs(M.r0) * XVector::Swizzle<0x00>(extent);
+		e += XVector::Abs(M.r1) * XVector::Swizzle<0x55>(extent);
+		e += XVector::Abs(M.r2) * XVector::Swizzle<0xAA>(extent);
+
+		Box out = {};
+		(c - e).Store3(out.Min);
+		(c + e).Store3(out.Max);
+		return out;
+	}
+
+#else
+	// ------------------------------------------------------------
+	// Matrix4x4 algebra (scalar fallback)
+	// ------------------------------------------------------------
+	inline Matrix4x4 Matrix4x4::Transposed() const
+	{
+		Matrix4x4 r{};
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix4x4 r{};
-			for (int i = 0; i < 4; ++i)
+			for (int j = 0; j < 4; ++j)
 			{
-				for (int j = 0; j < 4; ++j)
-				{
-					r.m[i][j] = m[j][i];
-				}
+				r.m[i][j] = m[j][i];
 			}
-			return r;
 		}
+		return r;
+	}
 
-		inline Matrix4x4 operator*(const Matrix4x4& rhs) const
+	inline Matrix4x4 Matrix4x4::operator*(const Matrix4x4& rhs) const
+	{
+		Matrix4x4 r = Zero();
+		for (int i = 0; i < 4; ++i)
 		{
-			Matrix4x4 r = Zero();
-			for (int i = 0; i < 4; ++i)
+			for (int j = 0; j < 4; ++j)
 			{
-				for (int j = 0; j < 4; ++j)
-				{
-					r.m[i][j] =
-						m[i][0] * rhs.m[0][j] +
-						m[i][1] * rhs.m[1][j] +
-						m[i][2] * rhs.m[2][j] +
-						m[i][3] * rhs.m[3][j];
-				}
+				r.m[i][j] =
+					m[i][0] * rhs.m[0][j] +
+					m[i][1] * rhs.m[1][j] +
+					m[i][2] * rhs.m[2][j] +
+					m[i][3] * rhs.m[3][j];
 			}
-			return r;
 		}
+		return r;
+	}
 
-		inline Matrix4x4 Inversed() const
-		{
-			Matrix4x4 a = *this;
-			Matrix4x4 inv = Identity();
+	inline Matrix4x4 Matrix4x4::Inversed() const
+	{
+		Matrix4x4 a = *this;
+		Matrix4x4 inv = Identity();
 
-			for (int col = 0; col < 4; ++col)
+		for (int col = 0; col < 4; ++col)
+		{
+			int pivotRow = col;
+			float32 pivotAbs = (float32)std::fabs(a.m[pivotRow][col]);
+			for (int r = col + 1; r < 4; ++r)
 			{
-				int pivotRow = col;
-				float32 pivotAbs = (float32)std::fabs(a.m[pivotRow][col]);
-				for (int r = col + 1; r < 4; ++r)
+				const float32 v = (float32)std::fabs(a.m[r][col]);
+				if (v > pivotAbs)
 				{
-					const float32 v = (float32)std::fabs(a.m[r][col]);
-					if (v > pivotAbs)
-					{
-						pivotAbs = v;
-						pivotRow = r;
-					}
+					pivotAbs = v;
+					pivotRow = r;
 				}
+			}
 
-				ASSERT(pivotAbs > 1e-12f, "Attempted to invert a matrix with zero determinant.");
-
-				if (pivotRow != col)
-				{
-					for (int c = 0; c < 4; ++c)
-					{
-						std::swap(a.m[col][c], a.m[pivotRow][c]);
-						std::swap(inv.m[col][c], inv.m[pivotRow][c]);
-					}
-				}
+			ASSERT(pivotAbs > 1e-12f, "Attempted to invert a matrix with zero determinant.");
 
-				const float32 pivot = a.m[col][col];
-				const float32 invPivot = 1.0f / pivot;
+			if (pivotRow != col)
+			{
 				for (int c = 0; c < 4; ++c)
 				{
-					a.m[col][c] *= invPivot;
-					inv.m[col][c] *= invPivot;
+					std::swap(a.m[col][c], a.m[pivotRow][c]);
+					std::swap(inv.m[col][c], inv.m[pivotRow][c]);
 				}
+			}
 
-				for (int r = 0; r < 4; ++r)
+			const float32 pivot = a.m[col][col];
+			const float32 invPivot = 1.0f / pivot;
+			for (int c = 0; c < 4; ++c)
+			{
+				a.m[col][c] *= invPivot;
+				inv.m[col][c] *= invPivot;
+			}
+
+			for (int r = 0; r < 4; ++r)
+			{
+				if (r == col)
+					continue;
+
+				const float32 f = a.m[r][col];
+				if (std::fabs(f) < 1e-12f)
+					continue;
+
+				for (int c = 0; c < 4; ++c)
 				{
-					if (r == col)
-						continue;
-
-					const float32 f = a.m[r][col];
-					if (std::fabs(f) < 1e-12f)
-						continue;
-
-					for (int c = 0; c < 4; ++c)
-					{
-						a.m[r][c] -= f * a.m[col][c];
-						inv.m[r][c] -= f * inv.m[col][c];
-					}
+					a.m[r][c] -= f * a.m[col][c];
+					inv.m[r][c] -= f * inv.m[col][c];
 				}
 			}
-
-			return inv;
 		}
 
-		inline Matrix4x4 InverseAffineFast() const
-		{
-			ASSERT(std::fabs(_m03) < 1e-6f && std::fabs(_m13) < 1e-6f && std::fabs(_m23) < 1e-6f, "Matrix is not affine.");
-			ASSERT(std::fabs(_m33 - 1.0f) < 1e-6f, "Matrix is not affine.");
+		return inv;
+	}
 
-			const Matrix3x3 L = static_cast<Matrix3x3>(*this);
-			const Matrix3x3 invL = L.Inversed();
-			const Vector3 t = ExtractTranslation();
+	inline Matrix4x4 Matrix4x4::InverseAffineFast() const
+	{
+		ASSERT(std::fabs(_m03) < 1e-6f && std::fabs(_m13) < 1e-6f && std::fabs(_m23) < 1e-6f, "Matrix is not affine.");
+		ASSERT(std::fabs(_m33 - 1.0f) < 1e-6f, "Matrix is not affine.");
 
-			const Vector3 invT = invL.MulVector(Vector3(-t.x, -t.y, -t.z));
+		const Matrix3x3 L = static_cast<Matrix3x3>(*this);
+		const Matrix3x3 invL = L.Inversed();
+		const Vector3 t = ExtractTranslation();
 
-			Matrix4x4 r = Identity();
-			r._m00 = invL._m00; r._m01 = invL._m01; r._m02 = invL._m02;
-			r._m10 = invL._m10; r._m11 = invL._m11; r._m12 = invL._m12;
-			r._m20 = invL._m20; r._m21 = invL._m21; r._m22 = invL._m22;
-			r._m30 = invT.x;    r._m31 = invT.y;    r._m32 = invT.z;
-			r._m33 = 1.0f;
-			return r;
+		const Vector3 invT = invL.MulVector(Vector3(-t.x, -t.y, -t.z));
+
+		Matrix4x4 r = Identity();
+		r._m00 = invL._m00; r._m01 = invL._m01; r._m02 = invL._m02;
+		r._m10 = invL._m10; r._m11 = invL._m11; r._m12 = invL._m12;
+		r._m20 = invL._m20; r._m21 = invL._m21; r._m22 = invL._m22;
+		r._m30 = invT.x;    r._m31 = invT.y;    r._m32 = invT.z;
+		r._m33 = 1.0f;
+		return r;
+	}
+
+	inline Box Matrix4x4::TransformBox(const Box& localBox) const
+	{
+		const Vector3 center = localBox.Center();
+		const Vector3 extent = localBox.Extents();
+
+		Vector3 c = ExtractTranslation();
+		Vector3 e = {};
+		for (int j = 0; j < 3; ++j)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				c[j] += center[i] * m[i][j];
+				e[j] += extent[i] * std::fabs(m[i][j]);
+			}
 		}
-	};
 
-	static_assert(sizeof(Matrix4x4) == sizeof(float32) * 16, "Matrix4x4 size is incorrect.");
-	static_assert(alignof(Matrix4x4) == alignof(float32), "Matrix4x4 alignment is incorrect.");
+		return Box(c - e, c + e);
+	}
+#endif // SHZ_HAS_SSE
 
 } // namespace shz
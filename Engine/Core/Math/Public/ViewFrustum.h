@@ -243,14 +243,88 @@ namespace shz
 		return (insidePlanes == totalPlanes) ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting;
 	}
 
+	// -------------------------------------------------------------------------
+	// Plane vs AABB
+	// -------------------------------------------------------------------------
+	inline BoxVisibility GetBoxVisibilityAgainstPlane(
+		const Plane& plane,
+		const Box& box)
+	{
+		const Vector3 center = box.Center();
+		const Vector3 half = box.Extents();
+
+		const float dist = Vector3::Dot(center, plane.Normal) + plane.Distance;
+
+		const float projHalf =
+			std::abs(plane.Normal.x) * half.x +
+			std::abs(plane.Normal.y) * half.y +
+			std::abs(plane.Normal.z) * half.z;
+
+		if (dist < -projHalf)
+		{
+			return BoxVisibility::Invisible;
+		}
+
+		if (dist > projHalf)
+		{
+			return BoxVisibility::FullyVisible;
+		}
+
+		return BoxVisibility::Intersecting;
+	}
+
+	// -------------------------------------------------------------------------
+	// Frustum vs world AABB
+	// -------------------------------------------------------------------------
+	inline BoxVisibility GetBoxVisibility(const ViewFrustum& frustum, const Box& worldAabb, FRUSTUM_PLANE_FLAGS planeFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+	{
+		int insidePlanes = 0;
+		int totalPlanes = 0;
+
+		for (uint32 planeIdx = 0; planeIdx < ViewFrustum::NUM_PLANES; ++planeIdx)
+		{
+			if ((planeFlags & (1u << planeIdx)) == 0)
+			{
+				continue;
+			}
+
+			const Plane& plane = frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(planeIdx));
+			const BoxVisibility v = GetBoxVisibilityAgainstPlane(plane, worldAabb);
+
+			if (v == BoxVisibility::Invisible)
+			{
+				return BoxVisibility::Invisible;
+			}
+
+			if (v == BoxVisibility::FullyVisible)
+			{
+				++insidePlanes;
+			}
+
+			++totalPlanes;
+		}
+
+		return (insidePlanes == totalPlanes) ? BoxVisibility::FullyVisible : BoxVisibility::Intersecting;
+	}
+
+	inline bool IntersectsFrustum(
+		const ViewFrustum& frustum,
+		const Box& worldAabb,
+		FRUSTUM_PLANE_FLAGS  planeFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+	{
+		return GetBoxVisibility(frustum, worldAabb, planeFlags) != BoxVisibility::Invisible;
+	}
+
+	// Local AABB + affine world matrix: tested as the world AABB from
+	// Matrix4x4::TransformBox. Callers testing one object against several
+	// frustums should transform once and use the world AABB overloads.
 	inline BoxVisibility GetBoxVisibility(
 		const ViewFrustum& frustum,
 		const Box& localAabb,
 		const Matrix4x4& world,
 		FRUSTUM_PLANE_FLAGS  planeFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
 	{
-		const OrientedBox obb = BuildOBBFromAABBAndMatrix(localAabb, world);
-		return GetBoxVisibility(frustum, obb, planeFlags);
+		return GetBoxVisibility(frustum, world.TransformBox(localAabb), planeFlags);
 	}
 
 	inline bool IntersectsFrustum(
@@ -259,6 +333,6 @@ namespace shz
 		const Matrix4x4& world,
 		FRUSTUM_PLANE_FLAGS  planeFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
 	{
-		return GetBoxVisibility(frustum, localAabb, world, planeFlags) != BoxVisibility::Invisible;
+		return GetBoxVisibility(frustum, world.TransformBox(localAabb), planeFlags) != BoxVisibility::Invisible;
 	}
 } // namespace shz
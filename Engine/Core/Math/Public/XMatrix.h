@@ -1,10 +1,14 @@
 ﻿#pragma once
+#include "Engine/Core/Math/Public/Vector2.h"
+#include "Engine/Core/Math/Public/Vector3.h"
+#include "Engine/Core/Math/Public/Vector4.h"
 #include "Engine/Core/Math/Public/XVector.h"
-#include "Engine/Core/Math/Public/Matrix4x4.h"
 #include <cmath>
 
 namespace shz
 {
+	struct Matrix4x4;
+
 	// ------------------------------------------------------------
 	// XMatrix
 	// - SIMD computation type
@@ -29,30 +33,9 @@ namespace shz
 			return m;
 		}
 
-		static inline XMatrix Load(const Matrix4x4& M)
-		{
-			XMatrix xm{};
-			// Load rows (row-major storage)
-			xm.r0 = XVector::Set(M._m00, M._m01, M._m02, M._m03);
-			xm.r1 = XVector::Set(M._m10, M._m11, M._m12, M._m13);
-			xm.r2 = XVector::Set(M._m20, M._m21, M._m22, M._m23);
-			xm.r3 = XVector::Set(M._m30, M._m31, M._m32, M._m33);
-			return xm;
-		}
-
-		inline Matrix4x4 Store() const
-		{
-			Vector4 a{}, b{}, c{}, d{};
-			r0.Store4(a);
-			r1.Store4(b);
-			r2.Store4(c);
-			r3.Store4(d);
-			return Matrix4x4(
-				a.x, a.y, a.z, a.w,
-				b.x, b.y, b.z, b.w,
-				c.x, c.y, c.z, c.w,
-				d.x, d.y, d.z, d.w);
-		}
+		// Defined in Matrix4x4.h (Matrix4x4 routes its hot paths through XMatrix).
+		static inline XMatrix Load(const Matrix4x4& M);
+		inline Matrix4x4 Store() const;
 
 		inline XVector MulVector(XVector v) const
 		{
@@ -96,21 +79,136 @@ namespace shz
 
 		inline XMatrix Transposed() const
 		{
-			Vector4 vr0{}, vr1{}, vr2{}, vr3{};
-			r0.Store4(vr0);
-			r1.Store4(vr1);
-			r2.Store4(vr2);
-			r3.Store4(vr3);
+			const XVector t0 = XVector::Shuffle<0x44>(r0, r1); // r0.x r0.y r1.x r1.y
+			const XVector t1 = XVector::Shuffle<0x44>(r2, r3); // r2.x r2.y r3.x r3.y
+			const XVector t2 = XVector::Shuffle<0xEE>(r0, r1); // r0.z r0.w r1.z r1.w
+			const XVector t3 = XVector::Shuffle<0xEE>(r2, r3); // r2.z r2.w r3.z r3.w
 
 			XMatrix t{};
-			t.r0 = XVector::Set(vr0.x, vr1.x, vr2.x, vr3.x);
-			t.r1 = XVector::Set(vr0.y, vr1.y, vr2.y, vr3.y);
-			t.r2 = XVector::Set(vr0.z, vr1.z, vr2.z, vr3.z);
-			t.r3 = XVector::Set(vr0.w, vr1.w, vr2.w, vr3.w);
+			t.r0 = XVector::Shuffle<0x88>(t0, t1);
+			t.r1 = XVector::Shuffle<0xDD>(t0, t1);
+			t.r2 = XVector::Shuffle<0x88>(t2, t3);
+			t.r3 = XVector::Shuffle<0xDD>(t2, t3);
 			return t;
 		}
+
+		// --------------------------------------------------------
+		// Inverse
+		// --------------------------------------------------------
+
+		// General inverse through 2x2 sub-blocks and their adjugates
+		// (block-wise cofactor expansion). No pivoting, no branches.
+		// The determinant is returned so callers can reject singular input.
+		static inline XMatrix Inverse(const XMatrix& M, float32* pOutDeterminant = nullptr)
+		{
+			// 2x2 blocks packed as (a, b, c, d) = [a b; c d]
+			const XVector A = XVector::Shuffle<0x44>(M.r0, M.r1);
+			const XVector B = XVector::Shuffle<0xEE>(M.r0, M.r1);
+			const XVector C = XVector::Shuffle<0x44>(M.r2, M.r3);
+			const XVector D = XVector::Shuffle<0xEE>(M.r2, M.r3);
+
+			// (detA, detB, detC, detD)
+			const XVector detSub =
+				XVector::Shuffle<0x88>(M.r0, M.r2) * XVector::Shuffle<0xDD>(M.r1, M.r3) -
+				XVector::Shuffle<0xDD>(M.r0, M.r2) * XVector::Shuffle<0x88>(M.r1, M.r3);
+
+			const XVector detA = XVector::Swizzle<0x00>(detSub);
+			const XVector detB = XVector::Swizzle<0x55>(detSub);
+			const XVector detC = XVector::Swizzle<0xAA>(detSub);
+			const XVector detD = XVector::Swizzle<0xFF>(detSub);
+
+			const XVector D_C = mat2AdjMul(D, C);
+			const XVector A_B = mat2AdjMul(A, B);
+
+			XVector X_ = detD * A - mat2Mul(B, D_C);
+			XVector W_ = detA * D - mat2Mul(C, A_B);
+			XVector Y_ = detB * C - mat2MulAdj(D, A_B);
+			XVector Z_ = detC * B - mat2MulAdj(A, D_C);
+
+			// det(M) = detA*detD + detB*detC - tr(adj(A)B * adj(D)C)
+			const XVector tr = A_B * XVector::Swizzle<0xD8>(D_C);
+			const float32 det = (detA * detD + detB * detC).Sum4() * 0.25f - tr.Sum4();
+
+			if (pOutDeterminant)
+			{
+				*pOutDeterminant = det;
+			}
+
+			const XVector rDet = XVector::Set(1.f, -1.f, -1.f, 1.f) / XVector::Splat(det);
+			X_ *= rDet;
+			Y_ *= rDet;
+			Z_ *= rDet;
+			W_ *= rDet;
+
+			XMatrix inv{};
+			inv.r0 = XVector::Shuffle<0x77>(X_, Y_);
+			inv.r1 = XVector::Shuffle<0x22>(X_, Y_);
+			inv.r2 = XVector::Shuffle<0x77>(Z_, W_);
+			inv.r3 = XVector::Shuffle<0x22>(Z_, W_);
+			return inv;
+		}
+
+		// Inverse of an affine matrix (last column = 0,0,0,1).
+		// The linear part is inverted through its adjugate, so shear and
+		// non-uniform scale are handled; translation becomes -t * inv(L).
+		static inline XMatrix InverseAffine(const XMatrix& M, float32* pOutDeterminant = nullptr)
+		{
+			// Rows of adj(L)^T; L^-1 = transpose(bc, ca, ab) / det(L)
+			const XVector bc = XVector::Cross3(M.r1, M.r2);
+			const XVector ca = XVector::Cross3(M.r2, M.r0);
+			const XVector ab = XVector::Cross3(M.r0, M.r1);
+
+			const float32 det = XVector::Dot3(M.r0, bc);
+			if (pOutDeterminant)
+			{
+				*pOutDeterminant = det;
+			}
+
+			XMatrix adj{};
+			adj.r0 = bc;
+			adj.r1 = ca;
+			adj.r2 = ab;
+			adj.r3 = XVector::Zero();
+
+			const XVector rDet = XVector::Splat(1.f / det);
+
+			XMatrix inv = adj.Transposed();
+			inv.r0 *= rDet;
+			inv.r1 *= rDet;
+			inv.r2 *= rDet;
+
+			XVector t = inv.r0 * XVector::Swizzle<0x00>(M.r3);
+			t += inv.r1 * XVector::Swizzle<0x55>(M.r3);
+			t += inv.r2 * XVector::Swizzle<0xAA>(M.r3);
+			inv.r3 = XVector::Set(0.f, 0.f, 0.f, 1.f) - t;
+			return inv;
+		}
+
+	private:
+		// 2x2 helpers for Inverse(). Blocks are row-major (a, b, c, d).
+
+		// A * B
+		static inline XVector mat2Mul(XVector a, XVector b)
+		{
+			return a * XVector::Swizzle<0xCC>(b) + XVector::Swizzle<0xB1>(a) * XVector::Swizzle<0x66>(b);
+		}
+
+		// adj(A) * B
+		static inline XVector mat2AdjMul(XVector a, XVector b)
+		{
+			return XVector::Swizzle<0x0F>(a) * b - XVector::Swizzle<0xA5>(a) * XVector::Swizzle<0x4E>(b);
+		}
+
+		// A * adj(B)
+		static inline XVector mat2MulAdj(XVector a, XVector b)
+		{
+			return a * XVector::Swizzle<0x33>(b) - XVector::Swizzle<0xB1>(a) * XVector::Swizzle<0x66>(b);
+		}
 	};
 
 	static_assert(sizeof(XMatrix) == sizeof(XVector) * 4);
 
-} // namespace shz
\ No newline at end of file
+} // namespace shz
+
+// XMatrix::Load / Store need the full Matrix4x4 definition.
+#include "Engine/Core/Math/Public/Matrix4x4.h"
\ No newline at end of file
@@ -88,6 +88,11 @@ namespace shz
 			return Set(p[0], p[1], z, w);
 		}
 
+		static inline XVector Load4(const float32* p4)
+		{
+			return Set(p4[0], p4[1], p4[2], p4[3]);
+		}
+
 		// --------------------------------------------------------
 		// Store (signatures match SSE header)
 		// --------------------------------------------------------
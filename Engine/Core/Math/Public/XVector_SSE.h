@@ -78,6 +78,11 @@ namespace shz
 			return fromM128(_mm_set_ps(w, z, p[1], p[0]));
 		}
 
+		static inline XVector Load4(const float32* p4)
+		{
+			return fromM128(_mm_loadu_ps(p4));
+		}
+
 		// --------------------------------------------------------
 		// Store 
 		// --------------------------------------------------------
@@ -1,5 +1,6 @@
 ﻿#include "pch.h"
 #include "Memory/Public/ArenaAllocator.h"
+#include "Memory/Public/HeapAllocationCounter.h"
 
 namespace shz
 {
@@ -32,6 +33,8 @@ namespace shz
 		m_Tail = other.m_Tail;
 		m_FirstChunkBytes = other.m_FirstChunkBytes;
 		m_NextChunkBytes = other.m_NextChunkBytes;
+		m_ChunkAllocationCount = other.m_ChunkAllocationCount;
+		m_MemoryTag = other.m_MemoryTag;
 
 		other.m_Mode = eMode::Uninitialized;
 		other.m_Base = nullptr;
@@ -41,6 +44,7 @@ namespace shz
 		other.m_Tail = nullptr;
 		other.m_FirstChunkBytes = 0;
 		other.m_NextChunkBytes = 0;
+		other.m_ChunkAllocationCount = 0;
 
 		return *this;
 	}
@@ -84,7 +88,7 @@ namespace shz
 			while (c)
 			{
 				Chunk* next = c->Next;
-				AlignedFree(c);
+				freeChunk(c);
 				c = next;
 			}
 		}
@@ -99,6 +103,7 @@ namespace shz
 		m_Tail = nullptr;
 		m_FirstChunkBytes = 0;
 		m_NextChunkBytes = 0;
+		m_ChunkAllocationCount = 0;
 	}
 
 	void* ArenaAllocator::Allocate(size_t bytes, size_t alignment)
@@ -152,6 +157,9 @@ namespace shz
 
 		void* raw = AlignedAlloc(kChunkAlignment, totalBytes);
 		ASSERT(raw != nullptr, "Allocation failed");
+		CountHeapAllocation();
+		++m_ChunkAllocationCount;
+		MemoryTracker::RecordAlloc(m_MemoryTag, payloadBytes);
 
 		Chunk* c = reinterpret_cast<Chunk*>(raw);
 
@@ -166,6 +174,12 @@ namespace shz
 		return c;
 	}
 
+	void ArenaAllocator::freeChunk(Chunk* c)
+	{
+		MemoryTracker::RecordFree(m_MemoryTag, c->Capacity);
+		AlignedFree(c);
+	}
+
 
 	void* ArenaAllocator::allocateGrowable(size_t bytes, size_t alignment)
 	{
@@ -213,7 +227,7 @@ namespace shz
 		while (c)
 		{
 			Chunk* next = c->Next;
-			AlignedFree(c);
+			freeChunk(c);
 			c = next;
 		}
 
@@ -228,11 +242,22 @@ namespace shz
 		{
 			m_Offset = 0;
 		}
+		else if (m_Head->Next == nullptr)
+		{
+			m_Head->Offset = 0;
+		}
 		else
 		{
-			// Keep first chunk allocated (good for frame alloc style reuse).
+			// The last cycle overflowed into extra chunks. Replace them all with one
+			// chunk of the combined size so the next cycle fits without touching the
+			// heap (frame-alloc style reuse reaches a steady state after one overflow).
+			const size_t totalBytes = GetCapacityBytes();
+
 			freeAllChunksExceptFirst();
-			m_Head->Offset = 0;
+			freeChunk(m_Head);
+
+			m_Head = allocateChunk(totalBytes);
+			m_Tail = m_Head;
 		}
 	}
 
@@ -285,7 +310,7 @@ namespace shz
 		while (c)
 		{
 			Chunk* next = c->Next;
-			AlignedFree(c);
+			freeChunk(c);
 			c = next;
 		}
 
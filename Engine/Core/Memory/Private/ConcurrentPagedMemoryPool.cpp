@@ -0,0 +1,547 @@
+﻿#include "pch.h"
+#include "Engine/Core/Memory/Public/ConcurrentPagedMemoryPool.h"
+
+namespace shz
+{
+    // ------------------------------------------------------------
+    // Thread slots
+    // - Every thread that touches a concurrent pool gets a small index
+    //   shared by all pools. The index picks that thread's ThreadCache.
+    // - Indices are returned when the thread exits, so the next thread
+    //   inherits the magazines (and the free blocks in them).
+    // ------------------------------------------------------------
+    namespace
+    {
+        constexpr uint32 INVALID_THREAD_SLOT = ~0u;
+
+        struct ThreadSlotRegistry final
+        {
+            std::mutex Mutex = {};
+            std::vector<uint32> FreeSlots = {};
+            uint32 NextSlot = 0;
+        };
+
+        static ThreadSlotRegistry& threadSlotRegistry()
+        {
+            static ThreadSlotRegistry s_Registry;
+            return s_Registry;
+        }
+
+        struct ThreadSlot final
+        {
+            uint32 Index = INVALID_THREAD_SLOT;
+
+            ThreadSlot()
+            {
+                ThreadSlotRegistry& reg = threadSlotRegistry();
+                std::lock_guard<std::mutex> lock(reg.Mutex);
+
+                if (!reg.FreeSlots.empty())
+                {
+                    Index = reg.FreeSlots.back();
+                    reg.FreeSlots.pop_back();
+                }
+                else if (reg.NextSlot < ConcurrentPagedMemoryPool::MAX_THREAD_CACHES)
+                {
+                    Index = reg.NextSlot++;
+                }
+            }
+
+            ~ThreadSlot()
+            {
+                if (Index == INVALID_THREAD_SLOT)
+                {
+                    return;
+                }
+
+                ThreadSlotRegistry& reg = threadSlotRegistry();
+                std::lock_guard<std::mutex> lock(reg.Mutex);
+                reg.FreeSlots.push_back(Index);
+            }
+        };
+
+        static inline uint32 currentThreadSlot()
+        {
+            thread_local ThreadSlot t_Slot;
+            return t_Slot.Index;
+        }
+    } // namespace
+
+    bool ConcurrentPagedMemoryPool::Initialize(size_t elementByteSize, size_t alignment, uint32 elementsPerPage)
+    {
+        ASSERT(!IsInitialized(), "ConcurrentPagedMemoryPool already initialized.");
+        ASSERT(elementByteSize > 0, "Element size must be > 0.");
+        ASSERT(alignment > 0, "Alignment must be > 0.");
+        ASSERT(elementsPerPage > 0, "ElementsPerPage must be > 0.");
+
+        m_ElementByteSize = elementByteSize;
+        m_Alignment = alignment;
+        m_ElementsPerPage = elementsPerPage;
+
+        m_HeaderSize = alignUp(sizeof(SlotHeader), m_Alignment);
+
+        const size_t payloadAligned = alignUp(m_ElementByteSize, m_Alignment);
+        m_SlotStride = m_HeaderSize + payloadAligned;
+
+        ASSERT((m_SlotStride % m_Alignment) == 0, "Slot stride must be multiple of alignment.");
+
+        m_PageBytes = m_SlotStride * static_cast<size_t>(m_ElementsPerPage);
+
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+        return allocateNewPage_Locked();
+    }
+
+    void ConcurrentPagedMemoryPool::Cleanup()
+    {
+        freeAllMagazines();
+        freeAllPages();
+
+        m_ElementByteSize = 0;
+        m_Alignment = 0;
+        m_ElementsPerPage = 0;
+        m_HeaderSize = 0;
+        m_SlotStride = 0;
+        m_PageBytes = 0;
+
+        m_PageReturnCount = 0;
+        m_ReleasedPageCount = 0;
+        m_OverflowAllocCount = 0;
+        m_OverflowFreeCount = 0;
+    }
+
+    void* ConcurrentPagedMemoryPool::Alloc()
+    {
+        ASSERT(IsInitialized(), "ConcurrentPagedMemoryPool is not initialized.");
+
+        SlotHeader* h = nullptr;
+
+        const uint32 slot = currentThreadSlot();
+        if (slot != INVALID_THREAD_SLOT)
+        {
+            ThreadCache& cache = m_Caches[slot];
+            if (!cache.Loaded || cache.Loaded->Count == 0)
+            {
+                refillLoaded(cache);
+            }
+
+            h = cache.Loaded->Slots[--cache.Loaded->Count];
+            bumpOwned(cache.AllocCount);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_DepotMutex);
+            h = takeOne_Locked();
+            ++m_OverflowAllocCount;
+        }
+
+#if ENGINE_MEMPOOL_DEBUG
+        ASSERT(h->Magic == MAGIC_FREE, "Alloc detected corrupted or double-allocated slot.");
+        h->Magic = MAGIC_ALLOC;
+#endif
+
+#if ENGINE_MEMPOOL_PAGE_STATS
+        h->OwnerPage->LiveCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        void* payload = reinterpret_cast<void*>(reinterpret_cast<byte*>(h) + m_HeaderSize);
+
+#if ENGINE_MEMPOOL_DEBUG
+        std::memset(payload, 0xCD, m_ElementByteSize);
+#endif
+
+        return payload;
+    }
+
+    void ConcurrentPagedMemoryPool::Free(void* ptr)
+    {
+        ASSERT(ptr != nullptr, "ConcurrentPagedMemoryPool::Free called with nullptr.");
+        if (!ptr)
+        {
+            return;
+        }
+
+        SlotHeader* h = reinterpret_cast<SlotHeader*>(reinterpret_cast<byte*>(ptr) - m_HeaderSize);
+        ASSERT(h->OwnerPage != nullptr, "Slot header has no owner page. Corruption?");
+
+#if ENGINE_MEMPOOL_DEBUG
+        ASSERT(h->Magic == MAGIC_ALLOC, "Free detected double free or memory corruption.");
+        h->Magic = MAGIC_FREE;
+        std::memset(ptr, 0xDD, m_ElementByteSize);
+#endif
+
+#if ENGINE_MEMPOOL_PAGE_STATS
+        h->OwnerPage->LiveCount.fetch_sub(1, std::memory_order_relaxed);
+#endif
+
+        const uint32 slot = currentThreadSlot();
+        if (slot != INVALID_THREAD_SLOT)
+        {
+            ThreadCache& cache = m_Caches[slot];
+            if (!cache.Loaded || cache.Loaded->Count == MAGAZINE_CAPACITY)
+            {
+                flushLoaded(cache);
+            }
+
+            cache.Loaded->Slots[cache.Loaded->Count++] = h;
+            bumpOwned(cache.FreeCount);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_DepotMutex);
+            returnToPage_Locked(h);
+            ++m_OverflowFreeCount;
+        }
+    }
+
+    bool ConcurrentPagedMemoryPool::Owns(const void* ptr) const
+    {
+        if (!ptr)
+        {
+            return false;
+        }
+
+#if ENGINE_MEMPOOL_DEBUG
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+        for (Page* p = m_PageHead; p; p = p->Next)
+        {
+            const byte* begin = p->Buffer;
+            const byte* end = p->Buffer + m_PageBytes;
+            const byte* u = reinterpret_cast<const byte*>(ptr);
+
+            if (u >= begin + m_HeaderSize && u < end)
+            {
+                const size_t slotOffset = static_cast<size_t>(u - begin) - m_HeaderSize;
+                if ((slotOffset % m_SlotStride) == 0) return true;
+            }
+        }
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    uint32 ConcurrentPagedMemoryPool::GetPageCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+        return m_PageCount;
+    }
+
+    uint32 ConcurrentPagedMemoryPool::GetLiveCount() const
+    {
+        const Stats s = GetStats();
+        return static_cast<uint32>(s.AllocCount - s.FreeCount);
+    }
+
+    ConcurrentPagedMemoryPool::Stats ConcurrentPagedMemoryPool::GetStats() const
+    {
+        Stats s = {};
+
+        // A block freed on another thread is counted by that thread, so only
+        // the sums are meaningful.
+        for (const ThreadCache& cache : m_Caches)
+        {
+            s.AllocCount += cache.AllocCount.load(std::memory_order_relaxed);
+            s.FreeCount += cache.FreeCount.load(std::memory_order_relaxed);
+            s.DepotExchangeCount += cache.DepotExchangeCount.load(std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+        s.AllocCount += m_OverflowAllocCount;
+        s.FreeCount += m_OverflowFreeCount;
+        s.PageReturnCount = m_PageReturnCount;
+        s.ReleasedPageCount = m_ReleasedPageCount;
+        s.PageCount = m_PageCount;
+        s.DepotFullMagazines = m_FullMagazineCount;
+        s.DepotEmptyMagazines = m_EmptyMagazineCount;
+        return s;
+    }
+
+    void ConcurrentPagedMemoryPool::GetPageStats(std::vector<PageStats>& outStats) const
+    {
+        outStats.clear();
+
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+        outStats.reserve(m_PageCount);
+
+        for (const Page* p = m_PageHead; p; p = p->Next)
+        {
+            PageStats ps = {};
+            ps.SlotCount = p->SlotCount;
+            ps.CarvedCount = p->CarvedCount;
+            ps.FreeCount = p->FreeCount;
+#if ENGINE_MEMPOOL_PAGE_STATS
+            ps.LiveCount = p->LiveCount.load(std::memory_order_relaxed);
+#endif
+            outStats.push_back(ps);
+        }
+    }
+
+    // ------------------------------------------------------------
+    // Magazine exchange
+    // ------------------------------------------------------------
+
+    void ConcurrentPagedMemoryPool::refillLoaded(ThreadCache& cache)
+    {
+        // Both magazines are owned by this thread; try the cheap swap first.
+        if (cache.Previous && cache.Previous->Count > 0)
+        {
+            std::swap(cache.Loaded, cache.Previous);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+
+        if (!cache.Loaded)
+        {
+            cache.Loaded = popEmptyMagazine_Locked();
+            cache.Previous = popEmptyMagazine_Locked();
+        }
+
+        if (m_FullMagazines)
+        {
+            Magazine* full = m_FullMagazines;
+            m_FullMagazines = full->Next;
+            --m_FullMagazineCount;
+
+            Magazine* empty = cache.Loaded;
+            empty->Next = m_EmptyMagazines;
+            m_EmptyMagazines = empty;
+            ++m_EmptyMagazineCount;
+
+            cache.Loaded = full;
+            bumpOwned(cache.DepotExchangeCount);
+            return;
+        }
+
+        carveInto_Locked(*cache.Loaded);
+    }
+
+    void ConcurrentPagedMemoryPool::flushLoaded(ThreadCache& cache)
+    {
+        if (cache.Previous && cache.Previous->Count == 0)
+        {
+            std::swap(cache.Loaded, cache.Previous);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+
+        if (!cache.Loaded)
+        {
+            cache.Loaded = popEmptyMagazine_Locked();
+            cache.Previous = popEmptyMagazine_Locked();
+            return;
+        }
+
+        // The depot is full: hand the slots back to their pages instead of
+        // letting cached-but-unused blocks pin pages forever.
+        if (m_FullMagazineCount >= MAX_DEPOT_FULL_MAGAZINES)
+        {
+            Magazine& mag = *cache.Loaded;
+            while (mag.Count > 0)
+            {
+                returnToPage_Locked(mag.Slots[--mag.Count]);
+            }
+            ++m_PageReturnCount;
+            return;
+        }
+
+        Magazine* full = cache.Loaded;
+        full->Next = m_FullMagazines;
+        m_FullMagazines = full;
+        ++m_FullMagazineCount;
+
+        cache.Loaded = popEmptyMagazine_Locked();
+        bumpOwned(cache.DepotExchangeCount);
+    }
+
+    ConcurrentPagedMemoryPool::Magazine* ConcurrentPagedMemoryPool::popEmptyMagazine_Locked()
+    {
+        if (!m_EmptyMagazines)
+        {
+            return new Magazine();
+        }
+
+        Magazine* mag = m_EmptyMagazines;
+        m_EmptyMagazines = mag->Next;
+        --m_EmptyMagazineCount;
+
+        mag->Next = nullptr;
+        return mag;
+    }
+
+    void ConcurrentPagedMemoryPool::carveInto_Locked(Magazine& mag)
+    {
+        ASSERT(mag.Count == 0, "Carving into a non-empty magazine.");
+
+        while (mag.Count < MAGAZINE_CAPACITY)
+        {
+            mag.Slots[mag.Count++] = takeOne_Locked();
+        }
+    }
+
+    ConcurrentPagedMemoryPool::SlotHeader* ConcurrentPagedMemoryPool::takeOne_Locked()
+    {
+        // Returned slots first, so partly used pages fill up again before
+        // fresh memory is touched.
+        Page* page = m_PagesWithFree;
+        if (!page)
+        {
+            return carveOne_Locked();
+        }
+
+        SlotHeader* h = page->FreeList;
+        page->FreeList = h->NextFree;
+        h->NextFree = nullptr;
+
+        if (--page->FreeCount == 0)
+        {
+            m_PagesWithFree = page->NextWithFree;
+            if (m_PagesWithFree) m_PagesWithFree->PrevWithFree = nullptr;
+            page->NextWithFree = nullptr;
+        }
+
+        return h;
+    }
+
+    ConcurrentPagedMemoryPool::SlotHeader* ConcurrentPagedMemoryPool::carveOne_Locked()
+    {
+        if (!m_CarvePage || m_CarvePage->CarvedCount == m_CarvePage->SlotCount)
+        {
+            const bool ok = allocateNewPage_Locked();
+            ASSERT(ok, "ConcurrentPagedMemoryPool failed to allocate a new page.");
+        }
+
+        Page* page = m_CarvePage;
+        SlotHeader* h = reinterpret_cast<SlotHeader*>(page->Buffer + m_SlotStride * static_cast<size_t>(page->CarvedCount));
+        ++page->CarvedCount;
+
+        h->OwnerPage = page;
+        h->NextFree = nullptr;
+
+#if ENGINE_MEMPOOL_DEBUG
+        h->Magic = MAGIC_FREE;
+        h->Reserved = 0;
+#endif
+
+        return h;
+    }
+
+    void ConcurrentPagedMemoryPool::returnToPage_Locked(SlotHeader* h)
+    {
+        Page* page = h->OwnerPage;
+
+        h->NextFree = page->FreeList;
+        page->FreeList = h;
+
+        if (page->FreeCount++ == 0)
+        {
+            page->PrevWithFree = nullptr;
+            page->NextWithFree = m_PagesWithFree;
+            if (m_PagesWithFree) m_PagesWithFree->PrevWithFree = page;
+            m_PagesWithFree = page;
+        }
+
+        // Every carved slot is back, so no block of this page is live or
+        // cached anywhere. The carve page stays: it is where growth goes.
+        if (page->FreeCount == page->CarvedCount && page != m_CarvePage)
+        {
+            releasePage_Locked(page);
+        }
+    }
+
+    void ConcurrentPagedMemoryPool::releasePage_Locked(Page* page)
+    {
+        if (page->PrevWithFree) page->PrevWithFree->NextWithFree = page->NextWithFree;
+        else if (m_PagesWithFree == page) m_PagesWithFree = page->NextWithFree;
+        if (page->NextWithFree) page->NextWithFree->PrevWithFree = page->PrevWithFree;
+
+        if (page->Prev) page->Prev->Next = page->Next;
+        else m_PageHead = page->Next;
+        if (page->Next) page->Next->Prev = page->Prev;
+
+        ::operator delete(page->Buffer, std::align_val_t(m_Alignment));
+        delete page;
+
+        --m_PageCount;
+        ++m_ReleasedPageCount;
+    }
+
+    bool ConcurrentPagedMemoryPool::allocateNewPage_Locked()
+    {
+        Page* pageNode = new Page();
+        pageNode->SlotCount = m_ElementsPerPage;
+
+        // Slots are carved lazily, so a fresh page is not touched here.
+        void* mem = ::operator new(m_PageBytes, std::align_val_t(m_Alignment));
+        pageNode->Buffer = reinterpret_cast<byte*>(mem);
+
+        pageNode->Next = m_PageHead;
+        if (m_PageHead) m_PageHead->Prev = pageNode;
+        m_PageHead = pageNode;
+        m_CarvePage = pageNode;
+        ++m_PageCount;
+
+        return true;
+    }
+
+    void ConcurrentPagedMemoryPool::freeAllPages()
+    {
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+
+        Page* p = m_PageHead;
+        while (p)
+        {
+            Page* next = p->Next;
+
+            if (p->Buffer)
+            {
+                ::operator delete(p->Buffer, std::align_val_t(m_Alignment));
+                p->Buffer = nullptr;
+            }
+
+            delete p;
+            p = next;
+        }
+
+        m_PageHead = nullptr;
+        m_CarvePage = nullptr;
+        m_PagesWithFree = nullptr;
+        m_PageCount = 0;
+    }
+
+    void ConcurrentPagedMemoryPool::freeAllMagazines()
+    {
+        std::lock_guard<std::mutex> lock(m_DepotMutex);
+
+        auto freeList = [](Magazine* mag)
+            {
+                while (mag)
+                {
+                    Magazine* next = mag->Next;
+                    delete mag;
+                    mag = next;
+                }
+            };
+
+        freeList(m_FullMagazines);
+        freeList(m_EmptyMagazines);
+
+        m_FullMagazines = nullptr;
+        m_EmptyMagazines = nullptr;
+        m_FullMagazineCount = 0;
+        m_EmptyMagazineCount = 0;
+
+        for (ThreadCache& cache : m_Caches)
+        {
+            delete cache.Loaded;
+            delete cache.Previous;
+
+            cache.Loaded = nullptr;
+            cache.Previous = nullptr;
+            cache.AllocCount.store(0, std::memory_order_relaxed);
+            cache.FreeCount.store(0, std::memory_order_relaxed);
+            cache.DepotExchangeCount.store(0, std::memory_order_relaxed);
+        }
+    }
+} // namespace shz
@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include "Engine/Core/Memory/Public/DefaultRawMemoryAllocator.hpp"
+#include "Engine/Core/Memory/Public/HeapAllocationCounter.h"
 
 #include "Primitives/Align.hpp"
 
@@ -35,6 +36,12 @@
 #    define USE_CRT_MALLOC_DBG 1
 #endif
 
+#if defined(__APPLE__)
+#    include <malloc/malloc.h>
+#else
+#    include <malloc.h>
+#endif
+
 #if PLATFORM_ANDROID && __ANDROID_API__ < 28
 #    define USE_ALIGNED_MALLOC_FALLBACK 1
 #endif
@@ -78,6 +85,7 @@ namespace shz
 	void* DefaultRawMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber)
 	{
 		ASSERT_EXPR(Size > 0);
+		CountHeapAllocation();
 #ifdef USE_CRT_MALLOC_DBG
 		return _malloc_dbg(Size, _NORMAL_BLOCK, dbgFileName, dbgLineNumber);
 #else
@@ -90,6 +98,30 @@ namespace shz
 		free(Ptr);
 	}
 
+	void* DefaultRawMemoryAllocator::Reallocate(void* Ptr, size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber)
+	{
+		ASSERT_EXPR(Size > 0);
+		CountHeapAllocation();
+#ifdef USE_CRT_MALLOC_DBG
+		return _realloc_dbg(Ptr, Size, _NORMAL_BLOCK, dbgFileName, dbgLineNumber);
+#else
+		return realloc(Ptr, Size);
+#endif
+	}
+
+	size_t DefaultRawMemoryAllocator::GetBlockSize(const void* Ptr)
+	{
+		ASSERT_EXPR(Ptr != nullptr);
+#if defined(_MSC_VER) || defined(__MINGW64__) || defined(__MINGW32__)
+		// Maps to _msize_dbg in the debug CRT.
+		return _msize(const_cast<void*>(Ptr));
+#elif defined(__APPLE__)
+		return malloc_size(Ptr);
+#else
+		return malloc_usable_size(const_cast<void*>(Ptr));
+#endif
+	}
+
 #ifdef ALIGNED_MALLOC
 #    undef ALIGNED_MALLOC
 #endif
@@ -119,6 +151,7 @@ namespace shz
 		// Size must be an integral multiple of alignment,
 		// or aligned_alloc will return null
 		Size = AlignUp(Size, Alignment);
+		CountHeapAllocation();
 		return ALIGNED_MALLOC(Size, Alignment, dbgFileName, dbgLineNumber);
 	}
 
@@ -30,6 +30,7 @@
 #include "Engine/Core/Common/Public/Errors.hpp"
 #include "Engine/Core/Memory/Public/EngineMemory.h"
 #include "Engine/Core/Memory/Public/DefaultRawMemoryAllocator.hpp"
+#include "Engine/Core/Memory/Public/TaggedMemoryAllocator.hpp"
 
 namespace shz
 {
@@ -61,6 +62,11 @@ namespace shz
 		return GetRawAllocator();
 	}
 
+	IMemoryAllocator& GetTaggedAllocator(EMemoryTag tag)
+	{
+		return TaggedMemoryAllocator::GetAllocator(tag);
+	}
+
 } // namespace shz
 #if 0
 
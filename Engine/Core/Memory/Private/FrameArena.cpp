@@ -0,0 +1,59 @@
+﻿#include "pch.h"
+#include "Memory/Public/FrameArena.h"
+
+namespace shz
+{
+	void FrameArena::Initialize(uint32 numFrames, size_t bytesPerFrame, EMemoryTag tag)
+	{
+		ASSERT(numFrames > 0 && numFrames <= MAX_FRAMES, "Invalid frame count.");
+
+		Shutdown();
+
+		for (uint32 i = 0; i < numFrames; ++i)
+		{
+			m_Arenas[i].SetMemoryTag(tag);
+			m_Arenas[i].InitializeGrowable(bytesPerFrame);
+		}
+
+		m_NumFrames = numFrames;
+		m_Current = 0;
+	}
+
+	void FrameArena::Shutdown()
+	{
+		for (ArenaAllocator& arena : m_Arenas)
+		{
+			arena.Shutdown();
+		}
+
+		m_NumFrames = 0;
+		m_Current = 0;
+		m_PeakUsedBytes = 0;
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		ASSERT(IsInitialized(), "FrameArena is not initialized.");
+
+		m_PeakUsedBytes = std::max(m_PeakUsedBytes, m_Arenas[m_Current].GetUsedBytes());
+
+		m_Current = (m_Current + 1) % m_NumFrames;
+		m_Arenas[m_Current].Reset();
+	}
+
+	ArenaAllocator& FrameArena::Get()
+	{
+		ASSERT(IsInitialized(), "FrameArena is not initialized.");
+		return m_Arenas[m_Current];
+	}
+
+	uint64 FrameArena::GetChunkAllocationCount() const
+	{
+		uint64 count = 0;
+		for (uint32 i = 0; i < m_NumFrames; ++i)
+		{
+			count += m_Arenas[i].GetChunkAllocationCount();
+		}
+		return count;
+	}
+} // namespace shz
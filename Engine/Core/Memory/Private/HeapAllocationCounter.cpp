@@ -0,0 +1,91 @@
+﻿#include "pch.h"
+#include "Memory/Public/HeapAllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace shz
+{
+	// Diagnostic builds only: one shared relaxed counter is good enough.
+	static std::atomic<uint64> g_HeapAllocationCount = 0;
+
+	uint64 GetHeapAllocationCount() noexcept
+	{
+		return g_HeapAllocationCount.load(std::memory_order_relaxed);
+	}
+
+#if defined(SHZ_TRACK_HEAP_ALLOCATIONS)
+	void CountHeapAllocation() noexcept
+	{
+		g_HeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void* countedAlloc(std::size_t bytes) noexcept
+	{
+		CountHeapAllocation();
+		return std::malloc(bytes != 0 ? bytes : 1);
+	}
+
+	static void* countedAlignedAlloc(std::size_t bytes, std::align_val_t alignment) noexcept
+	{
+		CountHeapAllocation();
+
+		const std::size_t align = static_cast<std::size_t>(alignment);
+		const std::size_t size = (bytes != 0) ? (bytes + align - 1) & ~(align - 1) : align;
+#if defined(_MSC_VER)
+		return _aligned_malloc(size, align);
+#else
+		return std::aligned_alloc(align, size);
+#endif
+	}
+
+	static void countedAlignedFree(void* p) noexcept
+	{
+#if defined(_MSC_VER)
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+
+	static void* throwIfNull(void* p)
+	{
+		if (p == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return p;
+	}
+#endif
+} // namespace shz
+
+#if defined(SHZ_TRACK_HEAP_ALLOCATIONS)
+void* operator new(std::size_t bytes) { return shz::throwIfNull(shz::countedAlloc(bytes)); }
+void* operator new[](std::size_t bytes) { return shz::throwIfNull(shz::countedAlloc(bytes)); }
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept { return shz::countedAlloc(bytes); }
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept { return shz::countedAlloc(bytes); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void* operator new(std::size_t bytes, std::align_val_t alignment) { return shz::throwIfNull(shz::countedAlignedAlloc(bytes, alignment)); }
+void* operator new[](std::size_t bytes, std::align_val_t alignment) { return shz::throwIfNull(shz::countedAlignedAlloc(bytes, alignment)); }
+void* operator new(std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return shz::countedAlignedAlloc(bytes, alignment); }
+void* operator new[](std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return shz::countedAlignedAlloc(bytes, alignment); }
+
+void operator delete(void* p, std::align_val_t) noexcept { shz::countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { shz::countedAlignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { shz::countedAlignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { shz::countedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { shz::countedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { shz::countedAlignedFree(p); }
+#endif
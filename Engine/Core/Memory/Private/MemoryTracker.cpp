@@ -0,0 +1,216 @@
+﻿#include "pch.h"
+#include "Memory/Public/MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace shz
+{
+	namespace MemoryTrackerDetail
+	{
+		constinit thread_local ThreadMemoryDeltas t_Deltas = {};
+	} // namespace MemoryTrackerDetail
+
+	namespace
+	{
+		using MemoryTrackerDetail::TAG_COUNT;
+		using MemoryTrackerDetail::ThreadMemoryDeltas;
+
+		// The four counters of a tag share a cache line; tags do not.
+		struct alignas(64) TagCounters final
+		{
+			std::atomic<uint64> AllocBytes = 0;
+			std::atomic<uint64> FreeBytes = 0;
+			std::atomic<uint64> AllocCount = 0;
+			std::atomic<uint64> FreeCount = 0;
+		};
+
+		struct MemoryTrackerState final
+		{
+			TagCounters Tags[TAG_COUNT] = {};
+
+			std::mutex Mutex = {};
+
+			uint64 BudgetBytes[TAG_COUNT] = {};
+			bool OverBudget[TAG_COUNT] = {};
+
+			MemoryBudgetCallback BudgetCallback = nullptr;
+			void* pBudgetUserData = nullptr;
+
+			MemorySnapshot LastSnapshot = {};
+		};
+
+		// Never destroyed: threads may flush during static destruction.
+		static MemoryTrackerState& trackerState()
+		{
+			static MemoryTrackerState* s_pState = new MemoryTrackerState();
+			return *s_pState;
+		}
+
+		static void publishDeltas(ThreadMemoryDeltas& d) noexcept
+		{
+			MemoryTrackerState& state = trackerState();
+
+			for (size_t i = 0; i < TAG_COUNT; ++i)
+			{
+				if (d.AllocCount[i] == 0 && d.FreeCount[i] == 0)
+				{
+					continue;
+				}
+
+				TagCounters& t = state.Tags[i];
+				t.AllocBytes.fetch_add(d.AllocBytes[i], std::memory_order_relaxed);
+				t.FreeBytes.fetch_add(d.FreeBytes[i], std::memory_order_relaxed);
+				t.AllocCount.fetch_add(d.AllocCount[i], std::memory_order_relaxed);
+				t.FreeCount.fetch_add(d.FreeCount[i], std::memory_order_relaxed);
+
+				d.AllocBytes[i] = 0;
+				d.FreeBytes[i] = 0;
+				d.AllocCount[i] = 0;
+				d.FreeCount[i] = 0;
+			}
+
+			// A retired thread has no exit hook left: publish every later record.
+			d.Credit = d.bRetired ? 0 : MemoryTrackerDetail::FLUSH_CREDIT;
+		}
+
+		// Publishes whatever the thread recorded since its last flush.
+		struct ThreadDeltasRetirer final
+		{
+			~ThreadDeltasRetirer()
+			{
+				ThreadMemoryDeltas& d = MemoryTrackerDetail::t_Deltas;
+				d.bRetired = true;
+				publishDeltas(d);
+			}
+		};
+	} // namespace
+
+	void MemoryTrackerDetail::FlushThreadDeltas() noexcept
+	{
+		ThreadMemoryDeltas& d = t_Deltas;
+
+		// Registered on the first flush, not on the first record, so the hot
+		// path stays a plain add. Once the retirer has run (late TLS
+		// destructors) every record is published directly.
+		if (!d.bRetirerRegistered && !d.bRetired)
+		{
+			d.bRetirerRegistered = true;
+			thread_local ThreadDeltasRetirer t_Retirer;
+			(void)t_Retirer;
+		}
+
+		publishDeltas(d);
+	}
+
+	const char* GetMemoryTagName(EMemoryTag tag)
+	{
+		switch (tag)
+		{
+		case EMemoryTag::Unknown:  return "Unknown";
+		case EMemoryTag::Renderer: return "Renderer";
+		case EMemoryTag::Physics:  return "Physics";
+		case EMemoryTag::ECS:      return "ECS";
+		case EMemoryTag::Image:    return "Image";
+		default:                   return "<Invalid>";
+		}
+	}
+
+	void MemoryTracker::SetBudget(EMemoryTag tag, uint64 budgetBytes)
+	{
+		const size_t i = static_cast<size_t>(tag);
+		ASSERT(i < TAG_COUNT, "Invalid memory tag.");
+
+		MemoryTrackerState& state = trackerState();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+
+		state.BudgetBytes[i] = budgetBytes;
+		state.OverBudget[i] = false;
+	}
+
+	void MemoryTracker::SetBudgetCallback(MemoryBudgetCallback callback, void* pUserData)
+	{
+		MemoryTrackerState& state = trackerState();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+
+		state.BudgetCallback = callback;
+		state.pBudgetUserData = pUserData;
+	}
+
+	void MemoryTracker::CaptureSnapshot(MemorySnapshot& outSnapshot)
+	{
+		MemoryTrackerState& state = trackerState();
+
+		bool crossed[TAG_COUNT] = {};
+		MemoryBudgetCallback callback = nullptr;
+		void* pUserData = nullptr;
+
+#if SHZ_MEMORY_TRACKING
+		MemoryTrackerDetail::FlushThreadDeltas();
+#endif
+
+		{
+			std::lock_guard<std::mutex> lock(state.Mutex);
+
+			uint64 allocBytes[TAG_COUNT] = {};
+			uint64 freeBytes[TAG_COUNT] = {};
+			uint64 allocCount[TAG_COUNT] = {};
+			uint64 freeCount[TAG_COUNT] = {};
+
+			for (size_t i = 0; i < TAG_COUNT; ++i)
+			{
+				const TagCounters& t = state.Tags[i];
+				allocBytes[i] = t.AllocBytes.load(std::memory_order_relaxed);
+				freeBytes[i] = t.FreeBytes.load(std::memory_order_relaxed);
+				allocCount[i] = t.AllocCount.load(std::memory_order_relaxed);
+				freeCount[i] = t.FreeCount.load(std::memory_order_relaxed);
+			}
+
+			MemorySnapshot& snap = state.LastSnapshot;
+			++snap.SnapshotIndex;
+
+			for (size_t i = 0; i < TAG_COUNT; ++i)
+			{
+				MemoryTagStats& s = snap.Tags[i];
+
+				// A thread may publish a free before the thread that allocated the
+				// block publishes the alloc.
+				s.CurrentBytes = (allocBytes[i] > freeBytes[i]) ? (allocBytes[i] - freeBytes[i]) : 0;
+				s.PeakBytes = std::max(s.PeakBytes, s.CurrentBytes);
+				s.BudgetBytes = state.BudgetBytes[i];
+				s.AllocCount = allocCount[i];
+				s.FreeCount = freeCount[i];
+
+				const bool over = (s.BudgetBytes != 0) && (s.CurrentBytes > s.BudgetBytes);
+				crossed[i] = over && !state.OverBudget[i];
+				state.OverBudget[i] = over;
+			}
+
+			outSnapshot = snap;
+			callback = state.BudgetCallback;
+			pUserData = state.pBudgetUserData;
+		}
+
+		if (!callback)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < TAG_COUNT; ++i)
+		{
+			if (crossed[i])
+			{
+				const MemoryTagStats& s = outSnapshot.Tags[i];
+				callback(static_cast<EMemoryTag>(i), s.CurrentBytes, s.BudgetBytes, pUserData);
+			}
+		}
+	}
+
+	MemorySnapshot MemoryTracker::GetLastSnapshot()
+	{
+		MemoryTrackerState& state = trackerState();
+		std::lock_guard<std::mutex> lock(state.Mutex);
+		return state.LastSnapshot;
+	}
+} // namespace shz
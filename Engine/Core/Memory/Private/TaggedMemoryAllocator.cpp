@@ -0,0 +1,556 @@
+﻿#include "pch.h"
+#include "Engine/Core/Memory/Public/TaggedMemoryAllocator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <mutex>
+
+#include "Primitives/Align.hpp"
+
+#if defined(_WIN32)
+#    include <Windows.h>
+#else
+#    include <sys/mman.h>
+#endif
+
+namespace shz
+{
+	namespace
+	{
+		// ------------------------------------------------------------
+		// Small blocks
+		// - One address range is reserved up front and handed out in
+		//   SLAB_UNIT slabs (four for the larger classes), committed on first
+		//   use. A slab holds blocks of one size class; g_SlabClass keeps the
+		//   class of every unit, so a block's size is found from its address.
+		// - Classes step by 16 bytes up to 256, then by a quarter of the
+		//   power of two (320, 384, 448, 512, 640, ...) up to 16 KiB.
+		// - A thread pops and pushes its own free list per tag and class.
+		//   An empty list takes a batch from the shared list of the class (or
+		//   carves it from a slab); a list over its limit gives a batch back.
+		//   Lists go back to the shared ones when the thread exits.
+		// - The tracker is told when blocks enter and leave a thread's list,
+		//   not on every call: a tag counts its live blocks plus the ones its
+		//   thread lists hold (CACHE_BYTES_PER_LIST per class and thread, at
+		//   most 64 blocks and at least 4).
+		// ------------------------------------------------------------
+		constexpr size_t SMALL_BLOCK_GRANULARITY = 16;
+		constexpr size_t LINEAR_CLASS_MAX_SIZE = 256;
+		constexpr size_t LINEAR_CLASS_COUNT = LINEAR_CLASS_MAX_SIZE / SMALL_BLOCK_GRANULARITY;
+		constexpr size_t CLASSES_PER_DOUBLING = 4;
+
+		// 256 -> 16 KiB is six doublings.
+		constexpr size_t SMALL_CLASS_COUNT = LINEAR_CLASS_COUNT + 6 * CLASSES_PER_DOUBLING;
+		constexpr size_t TAG_COUNT = static_cast<size_t>(EMemoryTag::Count);
+
+		constexpr size_t SLAB_UNIT = size_t{ 64 } << 10;
+		constexpr size_t REGION_SIZE = (sizeof(void*) == 8) ? (size_t{ 1 } << 30) : (size_t{ 64 } << 20);
+		constexpr size_t SLAB_UNIT_COUNT = REGION_SIZE / SLAB_UNIT;
+
+		// A thread list holds about CACHE_BYTES_PER_LIST and moves half of it
+		// to or from the shared list at once.
+		constexpr size_t CACHE_BYTES_PER_LIST = size_t{ 32 } << 10;
+		constexpr uint32 MAX_CACHED_BLOCKS = 64;
+		constexpr uint32 MIN_CACHED_BLOCKS = 4;
+
+		static_assert(SMALL_CLASS_COUNT <= 256, "Slab classes are stored as bytes.");
+
+		struct SmallClassInfo final
+		{
+			uint32 Size;
+			uint32 CacheLimit;
+			uint32 TransferBatch;
+			uint32 SlabUnits;
+		};
+
+		constexpr std::array<SmallClassInfo, SMALL_CLASS_COUNT> makeSmallClasses()
+		{
+			std::array<SmallClassInfo, SMALL_CLASS_COUNT> classes = {};
+			for (size_t cls = 0; cls < SMALL_CLASS_COUNT; ++cls)
+			{
+				size_t size = (cls + 1) * SMALL_BLOCK_GRANULARITY;
+				if (cls >= LINEAR_CLASS_COUNT)
+				{
+					const size_t doubling = (cls - LINEAR_CLASS_COUNT) / CLASSES_PER_DOUBLING;
+					const size_t step = (cls - LINEAR_CLASS_COUNT) % CLASSES_PER_DOUBLING;
+					size = (LINEAR_CLASS_MAX_SIZE << doubling) + (step + 1) * ((LINEAR_CLASS_MAX_SIZE << doubling) / CLASSES_PER_DOUBLING);
+				}
+
+				const size_t limit = std::clamp<size_t>(CACHE_BYTES_PER_LIST / size, MIN_CACHED_BLOCKS, MAX_CACHED_BLOCKS);
+
+				classes[cls].Size = static_cast<uint32>(size);
+				classes[cls].CacheLimit = static_cast<uint32>(limit);
+				classes[cls].TransferBatch = static_cast<uint32>(limit / 2);
+				classes[cls].SlabUnits = (size >= 4096) ? 4 : 1;
+			}
+			return classes;
+		}
+
+		constexpr std::array<SmallClassInfo, SMALL_CLASS_COUNT> SMALL_CLASSES = makeSmallClasses();
+		static_assert(SMALL_CLASSES[SMALL_CLASS_COUNT - 1].Size == TaggedMemoryAllocator::SMALL_BLOCK_MAX_SIZE, "Class table does not end at SMALL_BLOCK_MAX_SIZE.");
+
+		struct FreeBlock final
+		{
+			FreeBlock* pNext;
+		};
+
+		// Trivial on purpose: no TLS init guard on the hot path.
+		struct ThreadBlockCache final
+		{
+			FreeBlock* pHead[TAG_COUNT][SMALL_CLASS_COUNT];
+
+			// Blocks a list may still take before it gives a batch back. Zero
+			// until the exit hook is registered and again once it has run, so
+			// the free fast path needs no other check.
+			uint32 Room[TAG_COUNT][SMALL_CLASS_COUNT];
+
+			bool bActive;
+			bool bRetired;
+		};
+
+		constinit thread_local ThreadBlockCache t_BlockCache = {};
+
+		struct alignas(64) SharedClassList final
+		{
+			std::mutex Mutex = {};
+			FreeBlock* pHead = nullptr;
+
+			// Uncarved tail of the slab this class is filling.
+			byte* pCarve = nullptr;
+			byte* pCarveEnd = nullptr;
+		};
+
+		struct SmallBlockRegion final
+		{
+			byte* pBase = nullptr;
+			std::atomic<size_t> NextSlabUnit = 0;
+
+			SharedClassList Classes[SMALL_CLASS_COUNT] = {};
+		};
+
+		// Zero until the range is reserved, so the range check fails for every block.
+		std::atomic<uintptr_t> g_RegionBegin = 0;
+		std::atomic<uintptr_t> g_RegionEnd = 0;
+
+		// Size class of every slab unit, written before the slab's first block is handed out.
+		uint8 g_SlabClass[SLAB_UNIT_COUNT] = {};
+
+		static byte* reserveRange(size_t size)
+		{
+#if defined(_WIN32)
+			return static_cast<byte*>(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+#else
+			void* p = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			return (p != MAP_FAILED) ? static_cast<byte*>(p) : nullptr;
+#endif
+		}
+
+		static bool commitRange(byte* p, size_t size)
+		{
+#if defined(_WIN32)
+			return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+			return mprotect(p, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+		}
+
+		// Never destroyed: blocks may be freed during static destruction.
+		// Null if the range could not be reserved.
+		static SmallBlockRegion* smallBlockRegion()
+		{
+			static SmallBlockRegion* s_pRegion = []() -> SmallBlockRegion*
+				{
+					byte* pBase = reserveRange(REGION_SIZE);
+					if (!pBase)
+					{
+						return nullptr;
+					}
+
+					SmallBlockRegion* pRegion = new SmallBlockRegion();
+					pRegion->pBase = pBase;
+
+					g_RegionBegin.store(reinterpret_cast<uintptr_t>(pBase), std::memory_order_relaxed);
+					g_RegionEnd.store(reinterpret_cast<uintptr_t>(pBase) + REGION_SIZE, std::memory_order_relaxed);
+					return pRegion;
+				}();
+			return s_pRegion;
+		}
+
+		static bool isSmallBlock(const void* Ptr)
+		{
+			const uintptr_t p = reinterpret_cast<uintptr_t>(Ptr);
+			return p >= g_RegionBegin.load(std::memory_order_relaxed) && p < g_RegionEnd.load(std::memory_order_relaxed);
+		}
+
+		// Size <= SMALL_BLOCK_MAX_SIZE.
+		static size_t smallClassOf(size_t Size)
+		{
+			if (Size <= LINEAR_CLASS_MAX_SIZE)
+			{
+				return (Size != 0) ? (Size - 1) / SMALL_BLOCK_GRANULARITY : 0;
+			}
+
+			// Size - 1 is in [2^n, 2^(n+1)), n >= 8; its top three bits pick the quarter.
+			const size_t n = static_cast<size_t>(std::bit_width(Size - 1)) - 1;
+			const size_t quarter = ((Size - 1) >> (n - 2)) - CLASSES_PER_DOUBLING;
+			return LINEAR_CLASS_COUNT + (n - 8) * CLASSES_PER_DOUBLING + quarter;
+		}
+
+		static size_t smallClassSize(size_t cls)
+		{
+			return SMALL_CLASSES[cls].Size;
+		}
+
+		static size_t smallClassOfBlock(const void* Ptr)
+		{
+			const uintptr_t offset = reinterpret_cast<uintptr_t>(Ptr) - g_RegionBegin.load(std::memory_order_relaxed);
+			return g_SlabClass[offset / SLAB_UNIT];
+		}
+
+		static void pushShared(SharedClassList& list, FreeBlock* pFirst, FreeBlock* pLast)
+		{
+			std::lock_guard<std::mutex> lock(list.Mutex);
+			pLast->pNext = list.pHead;
+			list.pHead = pFirst;
+		}
+
+		// Returns the thread's lists to the shared ones.
+		struct ThreadBlockCacheRetirer final
+		{
+			~ThreadBlockCacheRetirer()
+			{
+				ThreadBlockCache& c = t_BlockCache;
+				c.bActive = false;
+				c.bRetired = true;
+
+				SmallBlockRegion* pRegion = smallBlockRegion();
+				for (size_t tag = 0; tag < TAG_COUNT; ++tag)
+				{
+					for (size_t cls = 0; cls < SMALL_CLASS_COUNT; ++cls)
+					{
+						FreeBlock* pFirst = c.pHead[tag][cls];
+						if (!pFirst)
+						{
+							continue;
+						}
+
+						FreeBlock* pLast = pFirst;
+						uint32 count = 1;
+						while (pLast->pNext)
+						{
+							pLast = pLast->pNext;
+							++count;
+						}
+						pushShared(pRegion->Classes[cls], pFirst, pLast);
+						MemoryTracker::RecordFree(static_cast<EMemoryTag>(tag), uint64{ count } * smallClassSize(cls), count);
+
+						c.pHead[tag][cls] = nullptr;
+						c.Room[tag][cls] = 0;
+					}
+				}
+			}
+		};
+
+		static void activateThreadCache(ThreadBlockCache& c)
+		{
+			if (!c.bActive && !c.bRetired)
+			{
+				thread_local ThreadBlockCacheRetirer t_Retirer;
+				(void)t_Retirer;
+				c.bActive = true;
+				for (size_t tag = 0; tag < TAG_COUNT; ++tag)
+				{
+					for (size_t cls = 0; cls < SMALL_CLASS_COUNT; ++cls)
+					{
+						c.Room[tag][cls] = SMALL_CLASSES[cls].CacheLimit;
+					}
+				}
+			}
+		}
+
+		static void* allocateSmallSlow(EMemoryTag tag, size_t cls)
+		{
+			SmallBlockRegion* pRegion = smallBlockRegion();
+			if (!pRegion)
+			{
+				return nullptr;
+			}
+
+			ThreadBlockCache& c = t_BlockCache;
+			activateThreadCache(c);
+
+			// A retired thread takes one block at a time.
+			const SmallClassInfo& info = SMALL_CLASSES[cls];
+			const uint32 wanted = c.bActive ? info.TransferBatch : 1;
+			const size_t blockSize = info.Size;
+
+			FreeBlock* pHead = nullptr;
+			uint32 count = 0;
+			{
+				SharedClassList& list = pRegion->Classes[cls];
+				std::lock_guard<std::mutex> lock(list.Mutex);
+
+				while (list.pHead && count < wanted)
+				{
+					FreeBlock* pBlock = list.pHead;
+					list.pHead = pBlock->pNext;
+					pBlock->pNext = pHead;
+					pHead = pBlock;
+					++count;
+				}
+
+				while (count < wanted)
+				{
+					if (list.pCarve + blockSize > list.pCarveEnd)
+					{
+						const size_t unit = pRegion->NextSlabUnit.fetch_add(info.SlabUnits, std::memory_order_relaxed);
+						if (unit + info.SlabUnits > SLAB_UNIT_COUNT)
+						{
+							break;
+						}
+
+						byte* pSlab = pRegion->pBase + unit * SLAB_UNIT;
+						const size_t slabSize = info.SlabUnits * SLAB_UNIT;
+						if (!commitRange(pSlab, slabSize))
+						{
+							break;
+						}
+
+						std::fill(g_SlabClass + unit, g_SlabClass + unit + info.SlabUnits, static_cast<uint8>(cls));
+						list.pCarve = pSlab;
+						list.pCarveEnd = pSlab + slabSize;
+					}
+
+					FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(list.pCarve);
+					list.pCarve += blockSize;
+					pBlock->pNext = pHead;
+					pHead = pBlock;
+					++count;
+				}
+			}
+
+			if (!pHead)
+			{
+				return nullptr;
+			}
+
+			MemoryTracker::RecordAlloc(tag, uint64{ count } * blockSize, count);
+
+			// The list was empty; it keeps the rest of the batch.
+			const size_t t = static_cast<size_t>(tag);
+			c.pHead[t][cls] = pHead->pNext;
+			if (c.bActive)
+			{
+				c.Room[t][cls] = info.CacheLimit - (count - 1);
+			}
+			return pHead;
+		}
+
+		static void freeSmallSlow(EMemoryTag tag, FreeBlock* pBlock, size_t cls)
+		{
+			ThreadBlockCache& c = t_BlockCache;
+			activateThreadCache(c);
+
+			SharedClassList& list = smallBlockRegion()->Classes[cls];
+			if (!c.bActive)
+			{
+				pushShared(list, pBlock, pBlock);
+				MemoryTracker::RecordFree(tag, smallClassSize(cls));
+				return;
+			}
+
+			const size_t t = static_cast<size_t>(tag);
+			pBlock->pNext = c.pHead[t][cls];
+			c.pHead[t][cls] = pBlock;
+			if (c.Room[t][cls] != 0)
+			{
+				--c.Room[t][cls];
+				return;
+			}
+
+			// Over the limit by one: give a batch back.
+			const SmallClassInfo& info = SMALL_CLASSES[cls];
+			FreeBlock* pLast = pBlock;
+			for (uint32 i = 1; i < info.TransferBatch; ++i)
+			{
+				pLast = pLast->pNext;
+			}
+			c.pHead[t][cls] = pLast->pNext;
+			c.Room[t][cls] = info.TransferBatch - 1;
+
+			pushShared(list, pBlock, pLast);
+			MemoryTracker::RecordFree(tag, uint64{ info.TransferBatch } * info.Size, info.TransferBatch);
+		}
+
+		static void* allocateSmall(EMemoryTag tag, size_t cls)
+		{
+			ThreadBlockCache& c = t_BlockCache;
+			const size_t t = static_cast<size_t>(tag);
+
+			FreeBlock* pBlock = c.pHead[t][cls];
+			if (!pBlock)
+			{
+				return allocateSmallSlow(tag, cls);
+			}
+
+			c.pHead[t][cls] = pBlock->pNext;
+			++c.Room[t][cls];
+			return pBlock;
+		}
+
+		static void freeSmall(EMemoryTag tag, void* Ptr, size_t cls)
+		{
+			ThreadBlockCache& c = t_BlockCache;
+			const size_t t = static_cast<size_t>(tag);
+
+			FreeBlock* pBlock = static_cast<FreeBlock*>(Ptr);
+			if (c.Room[t][cls] == 0)
+			{
+				freeSmallSlow(tag, pBlock, cls);
+				return;
+			}
+
+			pBlock->pNext = c.pHead[t][cls];
+			c.pHead[t][cls] = pBlock;
+			--c.Room[t][cls];
+		}
+	} // namespace
+
+	TaggedMemoryAllocator::TaggedMemoryAllocator(EMemoryTag tag)
+		: m_Tag{ tag }
+		, m_RawAllocator{ DefaultRawMemoryAllocator::GetAllocator() }
+	{
+		ASSERT(tag < EMemoryTag::Count, "Invalid memory tag.");
+	}
+
+	void* TaggedMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber)
+	{
+		if (Size <= SMALL_BLOCK_MAX_SIZE)
+		{
+			if (void* Ptr = allocateSmall(m_Tag, smallClassOf(Size)))
+			{
+				return Ptr;
+			}
+		}
+
+		// Zero-byte requests (flecs makes a few) still get a unique block.
+		void* Ptr = m_RawAllocator.Allocate((std::max)(Size, size_t{ 1 }), dbgDescription, dbgFileName, dbgLineNumber);
+		if (Ptr)
+		{
+			MemoryTracker::RecordAlloc(m_Tag, DefaultRawMemoryAllocator::GetBlockSize(Ptr));
+		}
+		return Ptr;
+	}
+
+	void TaggedMemoryAllocator::Free(void* Ptr)
+	{
+		if (!Ptr)
+		{
+			return;
+		}
+
+		if (isSmallBlock(Ptr))
+		{
+			freeSmall(m_Tag, Ptr, smallClassOfBlock(Ptr));
+			return;
+		}
+
+		MemoryTracker::RecordFree(m_Tag, DefaultRawMemoryAllocator::GetBlockSize(Ptr));
+		m_RawAllocator.Free(Ptr);
+	}
+
+	void* TaggedMemoryAllocator::Reallocate(void* Ptr, size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber)
+	{
+		if (!Ptr)
+		{
+			return Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+		}
+
+		const bool bSmall = isSmallBlock(Ptr);
+		const size_t oldSize = GetAllocationSize(Ptr);
+
+		// Stays in its size class: nothing to do.
+		if (bSmall && Size <= SMALL_BLOCK_MAX_SIZE && smallClassOf(Size) == smallClassOfBlock(Ptr))
+		{
+			return Ptr;
+		}
+
+		// Between the slabs and the CRT, or between two size classes: move the block.
+		if (bSmall || Size <= SMALL_BLOCK_MAX_SIZE)
+		{
+			void* pNew = Allocate(Size, dbgDescription, dbgFileName, dbgLineNumber);
+			if (pNew)
+			{
+				std::memcpy(pNew, Ptr, (std::min)(oldSize, Size));
+				Free(Ptr);
+			}
+			return pNew;
+		}
+
+		void* pNew = m_RawAllocator.Reallocate(Ptr, Size, dbgDescription, dbgFileName, dbgLineNumber);
+		if (!pNew)
+		{
+			return nullptr;
+		}
+
+		MemoryTracker::RecordFree(m_Tag, oldSize);
+		MemoryTracker::RecordAlloc(m_Tag, DefaultRawMemoryAllocator::GetBlockSize(pNew));
+		return pNew;
+	}
+
+	void* TaggedMemoryAllocator::AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber)
+	{
+		ASSERT(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+		// The base pointer goes right below the payload. Every block is at least
+		// pointer-aligned, so Alignment bytes of padding always fit it.
+		Alignment = (std::max)(Alignment, sizeof(void*));
+
+		byte* pBase = static_cast<byte*>(Allocate(Size + Alignment, dbgDescription, dbgFileName, dbgLineNumber));
+		if (!pBase)
+		{
+			return nullptr;
+		}
+
+		byte* pPayload = AlignUp(pBase + sizeof(void*), Alignment);
+		ASSERT_EXPR(pPayload <= pBase + Alignment);
+
+		reinterpret_cast<void**>(pPayload)[-1] = pBase;
+		return pPayload;
+	}
+
+	void TaggedMemoryAllocator::FreeAligned(void* Ptr)
+	{
+		if (!Ptr)
+		{
+			return;
+		}
+
+		Free(reinterpret_cast<void**>(Ptr)[-1]);
+	}
+
+	size_t TaggedMemoryAllocator::GetAllocationSize(const void* Ptr)
+	{
+		ASSERT(Ptr != nullptr, "Ptr is null.");
+		return isSmallBlock(Ptr) ? smallClassSize(smallClassOfBlock(Ptr)) : DefaultRawMemoryAllocator::GetBlockSize(Ptr);
+	}
+
+	TaggedMemoryAllocator& TaggedMemoryAllocator::GetAllocator(EMemoryTag tag)
+	{
+		static TaggedMemoryAllocator s_Allocators[] =
+		{
+			TaggedMemoryAllocator{ EMemoryTag::Unknown },
+			TaggedMemoryAllocator{ EMemoryTag::Renderer },
+			TaggedMemoryAllocator{ EMemoryTag::Physics },
+			TaggedMemoryAllocator{ EMemoryTag::ECS },
+			TaggedMemoryAllocator{ EMemoryTag::Image },
+		};
+		static_assert(std::size(s_Allocators) == static_cast<size_t>(EMemoryTag::Count), "Tag count mismatch.");
+
+		ASSERT(tag < EMemoryTag::Count, "Invalid memory tag.");
+		return s_Allocators[static_cast<size_t>(tag)];
+	}
+} // namespace shz
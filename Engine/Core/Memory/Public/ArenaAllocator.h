@@ -1,5 +1,9 @@
 ﻿#pragma once
+#include <vector>
+
 #include "Primitives/Common.h"
+#include "Engine/Core/Memory/Public/STDAllocator.hpp"
+#include "Engine/Core/Memory/Public/MemoryTracker.h"
 
 namespace shz
 {
@@ -88,10 +92,23 @@ namespace shz
             // or a separate "DestructorList" utility.
         }
 
+        // --------------------------------------------------------
+        // STDAllocator interface (see STDArenaAllocator below)
+        // - FreeAligned is a no-op; memory returns on Reset/Restore.
+        // --------------------------------------------------------
+        void* AllocateAligned(size_t bytes, size_t alignment, const Char* /*dbgDescription*/, const Char* /*dbgFileName*/, const int32 /*dbgLineNumber*/)
+        {
+            void* p = Allocate(bytes, alignment);
+            ASSERT(p != nullptr, "Arena is out of memory.");
+            return p;
+        }
+
+        void FreeAligned(void* /*ptr*/) {}
+
         // --------------------------------------------------------
         // Reset / Markers
         // --------------------------------------------------------
-        void Reset();                 // frees all allocations (keeps first chunk in growable)
+        void Reset();                 // frees all allocations (growable: keeps capacity, see .cpp)
         Marker Save() const;          // capture current position
         void Restore(Marker marker);  // roll back to marker
 
@@ -119,6 +136,15 @@ namespace shz
         size_t GetCapacityBytes() const;
         size_t GetRemainingBytes() const;
 
+        // Number of heap chunks allocated so far (growable mode).
+        // Stops increasing once the arena has reached its steady-state size.
+        uint64 GetChunkAllocationCount() const { return m_ChunkAllocationCount; }
+
+        // Growable chunks are reported to MemoryTracker under this tag.
+        // Set before InitializeGrowable().
+        void SetMemoryTag(EMemoryTag tag) { m_MemoryTag = tag; }
+        EMemoryTag GetMemoryTag() const { return m_MemoryTag; }
+
     private:
         enum class eMode : std::uint8_t
         {
@@ -146,6 +172,7 @@ namespace shz
         void* allocateGrowable(size_t bytes, size_t alignment);
 
         Chunk* allocateChunk(size_t payloadBytes);
+        void freeChunk(Chunk* c);
         void freeAllChunksExceptFirst();
 
     private:
@@ -161,6 +188,20 @@ namespace shz
         Chunk* m_Tail = nullptr;
         size_t m_FirstChunkBytes = 0;
         size_t m_NextChunkBytes = 0;
+        uint64 m_ChunkAllocationCount = 0;
+
+        EMemoryTag m_MemoryTag = EMemoryTag::Unknown;
     };
 
+    // ------------------------------------------------------------
+    // STL adapters
+    // - Containers never free individually; size them with reserve()
+    //   where possible since every regrowth leaves the old block behind
+    //   until the arena is reset.
+    // ------------------------------------------------------------
+    template <class T> using STDArenaAllocator = STDAllocator<T, ArenaAllocator>;
+#define STD_ARENA_ALLOCATOR(Type, Arena, Description) STDArenaAllocator<Type>(Arena, Description, __FILE__, __LINE__)
+
+    template <class T> using ArenaVector = std::vector<T, STDArenaAllocator<T>>;
+
 } // namespace shz
\ No newline at end of file
@@ -0,0 +1,101 @@
+﻿#pragma once
+#include <memory>
+
+#include "Primitives/Common.h"
+#include "Engine/Core/Memory/Public/ConcurrentPagedMemoryPool.h"
+
+namespace shz
+{
+    // ------------------------------------------------------------
+    // ConcurrentObjectPool<T>
+    // - ObjectPool<T> on top of ConcurrentPagedMemoryPool.
+    // - Create/Destroy may be called from any thread, and an object may
+    //   be destroyed on a different thread than the one that created it.
+    // - UniquePtr returns the object to the pool; the pool must outlive it.
+    // ------------------------------------------------------------
+
+    template<typename T>
+    class ConcurrentObjectPool
+    {
+    public:
+        struct Deleter final
+        {
+            ConcurrentObjectPool* pPool = nullptr;
+
+            void operator()(T* obj) const
+            {
+                if (obj) pPool->Destroy(obj);
+            }
+        };
+
+        using UniquePtr = std::unique_ptr<T, Deleter>;
+
+    public:
+        ConcurrentObjectPool() = default;
+        ~ConcurrentObjectPool() { Cleanup(); }
+
+        ConcurrentObjectPool(const ConcurrentObjectPool&) = delete;
+        ConcurrentObjectPool& operator=(const ConcurrentObjectPool&) = delete;
+
+        bool Initialize(uint32 objectsPerPage)
+        {
+            return m_Pool.Initialize(sizeof(T), alignof(T), objectsPerPage);
+        }
+
+        void Cleanup()
+        {
+            m_Pool.Cleanup();
+        }
+
+        bool IsInitialized() const { return m_Pool.IsInitialized(); }
+
+        template<typename... Args>
+        T* Create(Args&&... args)
+        {
+            void* mem = m_Pool.Alloc();
+            ASSERT(mem != nullptr, "ConcurrentObjectPool::Create failed to allocate.");
+
+#if defined(__cpp_exceptions)
+            try
+            {
+                return new (mem) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                m_Pool.Free(mem);
+                throw;
+            }
+#else
+            return new (mem) T(std::forward<Args>(args)...);
+#endif
+        }
+
+        template<typename... Args>
+        UniquePtr MakeUnique(Args&&... args)
+        {
+            return UniquePtr(Create(std::forward<Args>(args)...), Deleter{ this });
+        }
+
+        void Destroy(T* obj)
+        {
+            ASSERT(obj != nullptr, "ConcurrentObjectPool::Destroy called with nullptr.");
+            if (!obj) return;
+
+            obj->~T();
+            m_Pool.Free(obj);
+        }
+
+        bool Owns(const T* obj) const
+        {
+            return m_Pool.Owns(obj);
+        }
+
+        uint32 GetLiveCount() const { return m_Pool.GetLiveCount(); }
+
+        ConcurrentPagedMemoryPool::Stats GetStats() const { return m_Pool.GetStats(); }
+        void GetPageStats(std::vector<ConcurrentPagedMemoryPool::PageStats>& outStats) const { m_Pool.GetPageStats(outStats); }
+
+    private:
+        ConcurrentPagedMemoryPool m_Pool;
+    };
+} // namespace shz
@@ -0,0 +1,218 @@
+﻿#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Primitives/Common.h"
+#include "Primitives/BasicTypes.h"
+
+namespace shz
+{
+    // ------------------------------------------------------------
+    // ConcurrentPagedMemoryPool
+    // - Thread-safe counterpart of PagedMemoryPool (same slot layout).
+    // - Each thread owns two magazines (small stacks of free slots).
+    //   Alloc/Free touch only the calling thread's magazines.
+    // - When both magazines are empty (Alloc) or full (Free), a whole
+    //   magazine is exchanged with the shared depot under a mutex.
+    // - The depot keeps at most MAX_DEPOT_FULL_MAGAZINES full magazines;
+    //   beyond that a full magazine is emptied back into the per-page
+    //   free lists, and a page whose slots are all back is released.
+    // - Blocks may be freed on any thread; they simply land in the
+    //   freeing thread's magazine.
+    // - Threads beyond MAX_THREAD_CACHES allocate from and free to the
+    //   pages directly, under the depot mutex.
+    //
+    // Per-page live counts are tracked when ENGINE_MEMPOOL_PAGE_STATS = 1
+    // (one relaxed atomic per Alloc/Free, off by default).
+    // ------------------------------------------------------------
+
+#ifndef ENGINE_MEMPOOL_DEBUG
+#define ENGINE_MEMPOOL_DEBUG 0
+#endif
+
+#ifndef ENGINE_MEMPOOL_PAGE_STATS
+#define ENGINE_MEMPOOL_PAGE_STATS 0
+#endif
+
+    class ConcurrentPagedMemoryPool
+    {
+    public:
+        static constexpr uint32 MAGAZINE_CAPACITY = 64;
+        static constexpr uint32 MAX_THREAD_CACHES = 64;
+        static constexpr uint32 MAX_DEPOT_FULL_MAGAZINES = 16;
+
+        struct PageStats final
+        {
+            uint32 SlotCount = 0;
+            uint32 CarvedCount = 0; // slots ever handed out from this page
+            uint32 FreeCount = 0;   // carved slots parked on the page's free list
+            uint32 LiveCount = 0;   // 0 unless ENGINE_MEMPOOL_PAGE_STATS
+        };
+
+        struct Stats final
+        {
+            uint64 AllocCount = 0;
+            uint64 FreeCount = 0;
+            uint64 DepotExchangeCount = 0; // magazine swaps with the depot
+            uint64 PageReturnCount = 0;    // magazines emptied back into pages
+            uint64 ReleasedPageCount = 0;
+            uint32 PageCount = 0;
+            uint32 DepotFullMagazines = 0;
+            uint32 DepotEmptyMagazines = 0;
+        };
+
+    public:
+        ConcurrentPagedMemoryPool() = default;
+        ~ConcurrentPagedMemoryPool() { Cleanup(); }
+
+        ConcurrentPagedMemoryPool(const ConcurrentPagedMemoryPool&) = delete;
+        ConcurrentPagedMemoryPool& operator=(const ConcurrentPagedMemoryPool&) = delete;
+
+        // --------------------------------------------------------
+        // Initialize / Cleanup are not thread-safe: no other thread may
+        // use the pool while they run.
+        // --------------------------------------------------------
+        bool Initialize(size_t elementByteSize, size_t alignment, uint32 elementsPerPage);
+        void Cleanup();
+
+        bool IsInitialized() const { return m_PageBytes != 0; }
+
+        void* Alloc();
+        void  Free(void* ptr);
+
+        // Debug / stats
+        bool Owns(const void* ptr) const;
+        size_t GetElementSize() const { return m_ElementByteSize; }
+        size_t GetAlignment()   const { return m_Alignment; }
+        uint32 GetElementsPerPage() const { return m_ElementsPerPage; }
+        uint32 GetPageCount() const;
+        uint32 GetLiveCount() const;
+
+        Stats GetStats() const;
+        void GetPageStats(std::vector<PageStats>& outStats) const;
+
+    private:
+        struct Page;
+
+        struct alignas(16) SlotHeader
+        {
+            Page* OwnerPage;
+
+            // Intrusive link, used only by the page free list.
+            SlotHeader* NextFree;
+
+#if ENGINE_MEMPOOL_DEBUG
+            uint32 Magic;
+            uint32 Reserved;
+#endif
+        };
+
+        // Everything but LiveCount is guarded by m_DepotMutex.
+        struct Page
+        {
+            uint8* Buffer = nullptr;
+            uint32 SlotCount = 0;
+            uint32 CarvedCount = 0;
+
+            // Slots returned from trimmed magazines and cache-less threads.
+            SlotHeader* FreeList = nullptr;
+            uint32 FreeCount = 0;
+
+            Page* Prev = nullptr;
+            Page* Next = nullptr;
+
+            // Links in m_PagesWithFree (only while FreeCount > 0).
+            Page* PrevWithFree = nullptr;
+            Page* NextWithFree = nullptr;
+
+#if ENGINE_MEMPOOL_PAGE_STATS
+            std::atomic<uint32> LiveCount = 0;
+#endif
+        };
+
+        struct Magazine
+        {
+            uint32 Count = 0;
+            Magazine* Next = nullptr; // depot link
+            SlotHeader* Slots[MAGAZINE_CAPACITY] = {};
+        };
+
+        // Written only by the owning thread; counters are atomics so that
+        // GetStats() can read them from any thread.
+        struct alignas(64) ThreadCache
+        {
+            Magazine* Loaded = nullptr;
+            Magazine* Previous = nullptr;
+
+            std::atomic<uint64> AllocCount = 0;
+            std::atomic<uint64> FreeCount = 0;
+            std::atomic<uint64> DepotExchangeCount = 0;
+        };
+
+    private:
+        static inline size_t alignUp(size_t value, size_t alignment)
+        {
+            ASSERT(alignment > 0, "Alignment must be > 0");
+            const size_t mod = value % alignment;
+            return (mod == 0) ? value : (value + (alignment - mod));
+        }
+
+        static inline void bumpOwned(std::atomic<uint64>& counter)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        void refillLoaded(ThreadCache& cache);
+        void flushLoaded(ThreadCache& cache);
+
+        Magazine* popEmptyMagazine_Locked();
+        void carveInto_Locked(Magazine& mag);
+        SlotHeader* takeOne_Locked();
+        SlotHeader* carveOne_Locked();
+
+        void returnToPage_Locked(SlotHeader* h);
+        void releasePage_Locked(Page* page);
+
+        bool allocateNewPage_Locked();
+        void freeAllPages();
+        void freeAllMagazines();
+
+    private:
+        // Config
+        size_t m_ElementByteSize = 0;
+        size_t m_Alignment = 0;
+        uint32 m_ElementsPerPage = 0;
+
+        // Derived
+        size_t m_HeaderSize = 0;
+        size_t m_SlotStride = 0;
+        size_t m_PageBytes = 0;
+
+        ThreadCache m_Caches[MAX_THREAD_CACHES];
+
+        // Depot (guarded by m_DepotMutex)
+        mutable std::mutex m_DepotMutex = {};
+
+        Magazine* m_FullMagazines = nullptr;
+        Magazine* m_EmptyMagazines = nullptr;
+        uint32 m_FullMagazineCount = 0;
+        uint32 m_EmptyMagazineCount = 0;
+
+        Page* m_PageHead = nullptr;
+        Page* m_CarvePage = nullptr;
+        Page* m_PagesWithFree = nullptr;
+        uint32 m_PageCount = 0;
+        uint64 m_PageReturnCount = 0;
+        uint64 m_ReleasedPageCount = 0;
+
+        // Counts of threads that did not get a cache slot.
+        uint64 m_OverflowAllocCount = 0;
+        uint64 m_OverflowFreeCount = 0;
+
+#if ENGINE_MEMPOOL_DEBUG
+        static constexpr uint32 MAGIC_FREE = 0xDEADF00D;
+        static constexpr uint32 MAGIC_ALLOC = 0xC0FFEE01;
+#endif
+    };
+} // namespace shz
@@ -36,7 +36,7 @@ namespace shz
 {
 
 // Default raw memory allocator
-class DefaultRawMemoryAllocator : public IMemoryAllocator
+class DefaultRawMemoryAllocator final : public IMemoryAllocator
 {
 public:
     DefaultRawMemoryAllocator();
@@ -47,12 +47,20 @@ public:
     // Releases memory
     virtual void Free(void* Ptr) override;
 
+    // Resizes block of memory allocated with Allocate. Returns null and keeps
+    // the original block when the request cannot be satisfied.
+    void* Reallocate(void* Ptr, size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber);
+
     // Allocates block of memory with specified alignment
     virtual void* AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber) override;
 
     // Releases memory allocated with AllocateAligned
     virtual void FreeAligned(void* Ptr) override;
 
+    // Usable size of a block returned by Allocate() or Reallocate() (at least
+    // the requested size), as reported by the CRT heap.
+    static size_t GetBlockSize(const void* Ptr);
+
     static DefaultRawMemoryAllocator& GetAllocator();
 
 private:
@@ -31,6 +31,7 @@
  // Implementation of the IMemoryAllocator interface and global memory allocation functions
 
 #include "Primitives/IMemoryAllocator.h"
+#include "Engine/Core/Memory/Public/MemoryTracker.h"
 
 namespace shz
 {
@@ -44,6 +45,10 @@ namespace shz
 
 	IMemoryAllocator& GetStringAllocator();
 
+	// Allocator that reports to MemoryTracker under the given tag (TaggedMemoryAllocator).
+	// It has its own small-block slabs over the CRT heap and does not use the raw allocator.
+	IMemoryAllocator& GetTaggedAllocator(EMemoryTag tag);
+
 #define ALLOCATE_RAW(Allocator, Desc, Size)    (Allocator).Allocate(Size, Desc, __FILE__, __LINE__)
 #define ALLOCATE(Allocator, Desc, Type, Count) reinterpret_cast<Type*>(ALLOCATE_RAW(Allocator, Desc, sizeof(Type) * (Count)))
 #define FREE(Allocator, Ptr)                   Allocator.Free(Ptr)
@@ -0,0 +1,50 @@
+﻿#pragma once
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Memory/Public/ArenaAllocator.h"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// FrameArena
+	// - Ring of growable ArenaAllocators, one per frame in flight.
+	// - BeginFrame() moves to the next arena and resets it, so data
+	//   allocated in the previous (NumFrames - 1) frames stays valid.
+	// - Arenas keep their capacity across resets: once every arena has
+	//   seen the peak frame, allocation never touches the heap.
+	// - Not thread-safe.
+	// ------------------------------------------------------------
+	class FrameArena final
+	{
+	public:
+		static constexpr uint32 MAX_FRAMES = 4;
+
+		FrameArena() = default;
+		~FrameArena() = default;
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		void Initialize(uint32 numFrames, size_t bytesPerFrame, EMemoryTag tag = EMemoryTag::Unknown);
+		void Shutdown();
+
+		bool IsInitialized() const { return m_NumFrames != 0; }
+
+		void BeginFrame();
+
+		ArenaAllocator& Get();
+		uint32 GetFrameIndex() const { return m_Current; }
+		uint32 GetNumFrames() const { return m_NumFrames; }
+
+		// Heap chunks allocated by all arenas (flat once steady state is reached).
+		uint64 GetChunkAllocationCount() const;
+
+		// Largest number of bytes any frame has used.
+		size_t GetPeakUsedBytes() const { return m_PeakUsedBytes; }
+
+	private:
+		ArenaAllocator m_Arenas[MAX_FRAMES] = {};
+		uint32 m_NumFrames = 0;
+		uint32 m_Current = 0;
+		size_t m_PeakUsedBytes = 0;
+	};
+} // namespace shz
@@ -0,0 +1,34 @@
+﻿#pragma once
+#include "Primitives/BasicTypes.h"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// Heap allocation counter
+	// - Build with SHZ_TRACK_HEAP_ALLOCATIONS to replace the global
+	//   operator new / new[] (plain, aligned and nothrow) with counting
+	//   versions. Code that goes to the CRT directly (the raw allocator,
+	//   arena chunks, RefCountedObject) calls CountHeapAllocation().
+	// - The count is process wide, so a frame measured on the render
+	//   thread also sees its worker threads (and anything else that
+	//   allocates meanwhile, such as asset loading).
+	// - Without the define the count stays 0 and CountHeapAllocation()
+	//   compiles away.
+	// ------------------------------------------------------------
+	constexpr bool IsHeapAllocationTrackingEnabled()
+	{
+#if defined(SHZ_TRACK_HEAP_ALLOCATIONS)
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	uint64 GetHeapAllocationCount() noexcept;
+
+#if defined(SHZ_TRACK_HEAP_ALLOCATIONS)
+	void CountHeapAllocation() noexcept;
+#else
+	inline void CountHeapAllocation() noexcept {}
+#endif
+} // namespace shz
@@ -0,0 +1,141 @@
+﻿#pragma once
+#include "Primitives/BasicTypes.h"
+#include "Primitives/DebugUtilities.hpp"
+
+// Set to 0 to compile the per-allocation accounting out (RecordAlloc/RecordFree become no-ops).
+#ifndef SHZ_MEMORY_TRACKING
+#define SHZ_MEMORY_TRACKING 1
+#endif
+
+namespace shz
+{
+	enum class EMemoryTag : uint8
+	{
+		Unknown = 0,
+		Renderer,
+		Physics,
+		ECS,
+		Image,
+
+		Count
+	};
+
+	const char* GetMemoryTagName(EMemoryTag tag);
+
+	struct MemoryTagStats final
+	{
+		uint64 CurrentBytes = 0;
+
+		// High-water mark, sampled at CaptureSnapshot().
+		uint64 PeakBytes = 0;
+
+		// 0 = no budget
+		uint64 BudgetBytes = 0;
+
+		uint64 AllocCount = 0;
+		uint64 FreeCount = 0;
+	};
+
+	struct MemorySnapshot final
+	{
+		uint64 SnapshotIndex = 0;
+		MemoryTagStats Tags[static_cast<size_t>(EMemoryTag::Count)] = {};
+
+		const MemoryTagStats& operator[](EMemoryTag tag) const { return Tags[static_cast<size_t>(tag)]; }
+	};
+
+	// Called from CaptureSnapshot() when a tag goes over its budget (once per crossing).
+	using MemoryBudgetCallback = void (*)(EMemoryTag tag, uint64 currentBytes, uint64 budgetBytes, void* pUserData);
+
+	namespace MemoryTrackerDetail
+	{
+		constexpr size_t TAG_COUNT = static_cast<size_t>(EMemoryTag::Count);
+
+		// A thread publishes its deltas once it has spent FLUSH_CREDIT: each
+		// recorded block costs 1 plus one per 16 KiB, so at most 64 blocks or
+		// ~1 MiB sit unpublished per thread.
+		constexpr int64 FLUSH_CREDIT = 64;
+		constexpr uint32 FLUSH_CREDIT_BYTE_SHIFT = 14;
+
+		// Trivial on purpose: no TLS init guard on the hot path.
+		struct ThreadMemoryDeltas final
+		{
+			uint64 AllocBytes[TAG_COUNT];
+			uint64 FreeBytes[TAG_COUNT];
+			uint32 AllocCount[TAG_COUNT];
+			uint32 FreeCount[TAG_COUNT];
+
+			// Starts at 0, so the first record of a thread flushes and sets it up.
+			int64 Credit;
+			bool bRetirerRegistered;
+			bool bRetired;
+		};
+
+		extern constinit thread_local ThreadMemoryDeltas t_Deltas;
+
+		void FlushThreadDeltas() noexcept;
+	} // namespace MemoryTrackerDetail
+
+	// ------------------------------------------------------------
+	// MemoryTracker
+	// - Per-subsystem byte/count accounting.
+	// - RecordAlloc/RecordFree add to plain counters owned by the calling
+	//   thread and publish them to shared per-tag atomics when the thread's
+	//   FLUSH_CREDIT runs out, and when the thread exits. Counters are monotonic, so a block freed on another
+	//   thread still sums up correctly.
+	// - CaptureSnapshot() publishes the calling thread and reads the shared
+	//   totals; other threads may lag by less than one flush each.
+	// ------------------------------------------------------------
+	class MemoryTracker final
+	{
+	public:
+#if SHZ_MEMORY_TRACKING
+		// count > 1 records that many blocks totalling bytes at once.
+		static void RecordAlloc(EMemoryTag tag, uint64 bytes, uint32 count = 1) noexcept
+		{
+			using namespace MemoryTrackerDetail;
+
+			const size_t i = static_cast<size_t>(tag);
+			ASSERT(i < TAG_COUNT, "Invalid memory tag.");
+
+			ThreadMemoryDeltas& d = t_Deltas;
+			d.AllocBytes[i] += bytes;
+			d.AllocCount[i] += count;
+			d.Credit -= count + static_cast<int64>(bytes >> FLUSH_CREDIT_BYTE_SHIFT);
+			if (d.Credit <= 0)
+			{
+				FlushThreadDeltas();
+			}
+		}
+
+		static void RecordFree(EMemoryTag tag, uint64 bytes, uint32 count = 1) noexcept
+		{
+			using namespace MemoryTrackerDetail;
+
+			const size_t i = static_cast<size_t>(tag);
+			ASSERT(i < TAG_COUNT, "Invalid memory tag.");
+
+			ThreadMemoryDeltas& d = t_Deltas;
+			d.FreeBytes[i] += bytes;
+			d.FreeCount[i] += count;
+			d.Credit -= count + static_cast<int64>(bytes >> FLUSH_CREDIT_BYTE_SHIFT);
+			if (d.Credit <= 0)
+			{
+				FlushThreadDeltas();
+			}
+		}
+#else
+		static void RecordAlloc(EMemoryTag, uint64, uint32 = 1) noexcept {}
+		static void RecordFree(EMemoryTag, uint64, uint32 = 1) noexcept {}
+#endif
+
+		static void SetBudget(EMemoryTag tag, uint64 budgetBytes);
+		static void SetBudgetCallback(MemoryBudgetCallback callback, void* pUserData);
+
+		// Publishes the calling thread, updates peaks and fires budget callbacks.
+		static void CaptureSnapshot(MemorySnapshot& outSnapshot);
+
+		// Last result of CaptureSnapshot().
+		static MemorySnapshot GetLastSnapshot();
+	};
+} // namespace shz
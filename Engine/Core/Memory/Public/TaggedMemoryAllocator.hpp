@@ -0,0 +1,59 @@
+﻿#pragma once
+
+// \file
+// Defines shz::TaggedMemoryAllocator class
+
+#include "Primitives/IMemoryAllocator.h"
+#include "Engine/Core/Memory/Public/MemoryTracker.h"
+#include "Engine/Core/Memory/Public/DefaultRawMemoryAllocator.hpp"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// TaggedMemoryAllocator
+	// - Reports every block to MemoryTracker under the allocator's tag.
+	//   Blocks carry no header: free a block through an allocator with the
+	//   same tag as the one that allocated it.
+	// - Blocks up to SMALL_BLOCK_MAX_SIZE come from size-class slabs in one
+	//   reserved address range, where the class (and so the size) is looked
+	//   up by address. Each thread keeps its own free lists, so the common
+	//   alloc/free is a list pop/push plus the tracker's thread-local add.
+	//   Slabs are kept for reuse, not returned to the system.
+	// - Larger blocks, and small ones once the range is used up, go to the
+	//   CRT (DefaultRawMemoryAllocator, called directly) and are counted at
+	//   the CRT's usable size.
+	// - AllocateAligned() pads the block and keeps the base pointer just
+	//   below the payload, as _aligned_malloc does.
+	// ------------------------------------------------------------
+	class TaggedMemoryAllocator final : public IMemoryAllocator
+	{
+	public:
+		static constexpr size_t SMALL_BLOCK_MAX_SIZE = 16u << 10;
+
+		explicit TaggedMemoryAllocator(EMemoryTag tag);
+
+		virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber) override;
+		virtual void Free(void* Ptr) override;
+
+		virtual void* AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber) override;
+		virtual void FreeAligned(void* Ptr) override;
+
+		// Resizes a block returned by Allocate() (not AllocateAligned()) of an
+		// allocator with the same tag. Returns null and keeps the original
+		// block on failure.
+		void* Reallocate(void* Ptr, size_t Size, const Char* dbgDescription, const char* dbgFileName, const int32 dbgLineNumber);
+
+		EMemoryTag GetTag() const { return m_Tag; }
+
+		// Usable size of a block returned by Allocate() or Reallocate()
+		// (at least the requested size); what the tracker is told.
+		static size_t GetAllocationSize(const void* Ptr);
+
+		// Shared per-tag instances.
+		static TaggedMemoryAllocator& GetAllocator(EMemoryTag tag);
+
+	private:
+		EMemoryTag m_Tag = EMemoryTag::Unknown;
+		DefaultRawMemoryAllocator& m_RawAllocator;
+	};
+} // namespace shz
@@ -1,8 +1,60 @@
 #include "pch.h"
 #include "Engine/ECS/Public/EcsWorld.h"
+#include "Engine/Core/Memory/Public/TaggedMemoryAllocator.hpp"
+
+#include <cstring>
 
 namespace shz
 {
+	// ------------------------------------------------------------
+	// flecs allocation hooks
+	// - Routes flecs heap traffic through the ECS-tagged allocator so it
+	//   shows up in MemoryTracker. Must run before the first world is created.
+	// ------------------------------------------------------------
+	static void* ecsMalloc(ecs_size_t size)
+	{
+		return TaggedMemoryAllocator::GetAllocator(EMemoryTag::ECS).Allocate(static_cast<size_t>(size), "flecs", __FILE__, __LINE__);
+	}
+
+	static void* ecsCalloc(ecs_size_t size)
+	{
+		void* p = ecsMalloc(size);
+		if (p)
+		{
+			std::memset(p, 0, static_cast<size_t>(size));
+		}
+		return p;
+	}
+
+	static void ecsFree(void* p)
+	{
+		TaggedMemoryAllocator::GetAllocator(EMemoryTag::ECS).Free(p);
+	}
+
+	static void* ecsRealloc(void* p, ecs_size_t size)
+	{
+		return TaggedMemoryAllocator::GetAllocator(EMemoryTag::ECS).Reallocate(p, static_cast<size_t>(size), "flecs", __FILE__, __LINE__);
+	}
+
+	static void installEcsAllocationHooks()
+	{
+		static const bool s_Installed = []()
+			{
+				ecs_os_set_api_defaults();
+
+				ecs_os_api_t api = ecs_os_api;
+				api.malloc_ = ecsMalloc;
+				api.calloc_ = ecsCalloc;
+				api.realloc_ = ecsRealloc;
+				api.free_ = ecsFree;
+				ecs_os_set_api(&api);
+
+				return true;
+			}();
+
+		(void)s_Installed;
+	}
+
 	EcsWorld::EcsWorld() = default;
 
 	EcsWorld::~EcsWorld()
@@ -16,6 +68,8 @@ namespace shz
 
 		m_CI = ci;
 
+		installEcsAllocationHooks();
+
 		m_pWorld = std::make_unique<flecs::world>(m_CI.Argc, m_CI.Argv);
 
 		m_DeltaTime = 0.0f;
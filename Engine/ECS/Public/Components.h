@@ -4,6 +4,7 @@
 
 #include "Engine/AssetManager/Public/AssetRef.hpp"
 #include "Engine/RuntimeData/Public/StaticMesh.h"
+#include "Engine/RuntimeData/Public/TerrainHeightField.h"
 #include "Engine/Renderer/Public/RenderScene.h"
 #include "Engine/Physics/Public/Physics.h"
 
@@ -68,13 +69,8 @@ namespace shz
 
 	COMPONENT CHeightFieldCollider final
 	{
-		uint32 Width = 0;
-		uint32 Height = 0;
-		float CellSizeX = 1.0f;
-		float CellSizeZ = 1.0f;
-		float HeightScale = 1.0f;
-		float HeightOffset = 0.0f;
-		std::vector<float> Heights = {};
+		// Samples, spacing and height scale / offset are read from the asset (no copy).
+		AssetRef<TerrainHeightField> HeightFieldRef = {};
 
 		bool bIsSensor = false;
 
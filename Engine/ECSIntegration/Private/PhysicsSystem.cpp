@@ -7,6 +7,7 @@ namespace shz
 	void PhysicsSystem::Initialize(const CreateInfo& ci)
 	{
 		m_Physics.Initialize(ci.PhysicsCI);
+		m_pAssetManager = ci.pAssetManager;
 		m_bInstalled = false;
 	}
 
@@ -24,6 +25,36 @@ namespace shz
 		m_Physics.ConsumeContactEvents(&m_FrameContactEvents);
 	}
 
+	void PhysicsSystem::PatchHeightField(const CHeightFieldCollider& hf, const CRigidbody& rb, const TerrainDirtyRect& rect)
+	{
+		if (rect.IsEmpty() || hf.ShapeHandle == 0)
+		{
+			return;
+		}
+
+		ASSERT(m_pAssetManager, "AssetManager is null.");
+
+		AssetPtr<TerrainHeightField> terrain = m_pAssetManager->LoadBlocking(hf.HeightFieldRef);
+		ASSERT(terrain && terrain->IsValid(), "Height field asset is not loaded.");
+
+		const Physics::HeightFieldCreateInfo hci = makeHeightFieldCreateInfo(*terrain);
+
+		PhysicsShapeHandle shape = {};
+		shape.Value = hf.ShapeHandle;
+
+		if (!m_Physics.UpdateHeightFieldShape(shape, hci, rect.X0, rect.Z0, rect.X1 - rect.X0, rect.Z1 - rect.Z0))
+		{
+			return;
+		}
+
+		if (rb.BodyHandle != 0)
+		{
+			PhysicsBodyHandle bh = {};
+			bh.Value = rb.BodyHandle;
+			m_Physics.NotifyShapeChanged(bh);
+		}
+	}
+
 	// Install Flecs systems
 	void PhysicsSystem::InstallEcsSystems(EcsWorld& ecs)
 	{
@@ -142,22 +173,31 @@ namespace shz
 		sphere.ShapeHandle = shape.Value;
 	}
 
+	Physics::HeightFieldCreateInfo PhysicsSystem::makeHeightFieldCreateInfo(const TerrainHeightField& terrain)
+	{
+		Physics::HeightFieldCreateInfo hci = {};
+		hci.pHeightsU16 = terrain.GetDataU16().data();
+		hci.Width = terrain.GetWidth();
+		hci.Height = terrain.GetHeight();
+		hci.CellSizeX = terrain.GetWorldSpacingX();
+		hci.CellSizeZ = terrain.GetWorldSpacingZ();
+		hci.HeightScale = terrain.GetHeightScale();
+		hci.HeightOffset = terrain.GetHeightOffset();
+		return hci;
+	}
+
 	void PhysicsSystem::ensureShapeCreated_HeightField(CHeightFieldCollider& heightField)
 	{
 		ASSERT(heightField.ShapeHandle == 0, "Shape already created");
-		ASSERT(heightField.Width > 1 && heightField.Height > 1, "Invalid height field resolution.");
-		ASSERT(heightField.Heights.size() == size_t(heightField.Width) * size_t(heightField.Height), "Height field size mismatch.");
+		ASSERT(heightField.HeightFieldRef, "Height field collider has no asset.");
+		ASSERT(m_pAssetManager, "AssetManager is null.");
 
-		Physics::HeightFieldCreateInfo hci = {};
-		hci.pHeights = heightField.Heights.data();
-		hci.Width = heightField.Width;
-		hci.Height = heightField.Height;
-		hci.CellSizeX = heightField.CellSizeX;
-		hci.CellSizeZ = heightField.CellSizeZ;
-		hci.HeightScale = heightField.HeightScale;
-		hci.HeightOffset = heightField.HeightOffset;
-
-		const PhysicsShapeHandle shape = m_Physics.CreateHeightFieldShape(hci);
+		// Built straight from the asset's uint16 samples; the asset stays the only copy.
+		AssetPtr<TerrainHeightField> terrain = m_pAssetManager->LoadBlocking(heightField.HeightFieldRef);
+		ASSERT(terrain && terrain->IsValid(), "Failed to load height field asset.");
+		ASSERT(terrain->GetWidth() > 1 && terrain->GetHeight() > 1, "Invalid height field resolution.");
+
+		const PhysicsShapeHandle shape = m_Physics.CreateHeightFieldShape(makeHeightFieldCreateInfo(*terrain));
 		heightField.ShapeHandle = shape.Value;
 	}
 
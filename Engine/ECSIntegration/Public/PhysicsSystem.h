@@ -5,6 +5,8 @@
 #include "Engine/ECS/Public/Components.h"
 #include "Engine/ECS/Public/EcsWorld.h"
 
+#include "Engine/AssetManager/Public/AssetManager.h"
+
 namespace shz
 {
 	class PhysicsSystem final
@@ -13,6 +15,9 @@ namespace shz
 		struct CreateInfo final
 		{
 			Physics::CreateInfo PhysicsCI = {};
+
+			// Resolves CHeightFieldCollider::HeightFieldRef
+			AssetManager* pAssetManager = nullptr;
 		};
 
 	public:
@@ -28,10 +33,14 @@ namespace shz
 
 		const std::vector<ContactEvent>& GetContactEvents() const { return m_FrameContactEvents; }
 
+		// Pushes an edited region (sample space) of the collider's height field asset into the live Jolt shape.
+		void PatchHeightField(const CHeightFieldCollider& hf, const CRigidbody& rb, const TerrainDirtyRect& rect);
+
 	private:
 		void ensureShapeCreated_Box(CBoxCollider& box);
 		void ensureShapeCreated_Sphere(CSphereCollider& sph);
 		void ensureShapeCreated_HeightField(CHeightFieldCollider& hf);
+		static Physics::HeightFieldCreateInfo makeHeightFieldCreateInfo(const TerrainHeightField& terrain);
 
 		void ensureBodyCreated(
 			CTransform& tr,
@@ -44,6 +53,7 @@ namespace shz
 
 	private:
 		Physics m_Physics = {};
+		AssetManager* m_pAssetManager = nullptr;
 		bool m_bInstalled = false;
 
 		std::vector<ContactEvent> m_FrameContactEvents;
@@ -0,0 +1,518 @@
+#include "pch.h"
+#include "Engine/GraphicsTools/Public/RenderStateArchive.h"
+
+#include <cstdio>
+
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/FileWrapper.hpp"
+#include "Engine/Core/Common/Public/Timer.hpp"
+
+#include "Engine/GraphicsArchiver/Public/SerializationDevice.h"
+#include "Engine/GraphicsUtils/Public/GraphicsUtils.hpp"
+#include "Engine/GraphicsTools/Public/GraphicsUtilities.h"
+#include "Engine/GraphicsTools/Public/XXH128Hasher.hpp"
+#include "Engine/ShaderTools/Public/DXCompiler.hpp"
+
+namespace shz
+{
+	static std::string formatHash(const char* prefix, const XXH128Hash& hash)
+	{
+		char name[48] = {};
+		std::snprintf(name, sizeof(name), "%s%016llx%016llx", prefix,
+			static_cast<unsigned long long>(hash.HighPart),
+			static_cast<unsigned long long>(hash.LowPart));
+		return name;
+	}
+
+	bool RenderStateArchive::Load(IRenderDevice* pDevice, const std::string& filePath)
+	{
+		ASSERT(pDevice, "Device is null.");
+
+		Shutdown();
+
+		if (filePath.empty())
+		{
+			return false;
+		}
+
+		Timer timer;
+
+		// Only the header and the resource index are read here; the objects a run
+		// never unpacks are never paged in.
+		RefCntAutoPtr<IDataBlob> pData;
+		if (!FileSystem::MapFile(filePath.c_str(), &pData))
+		{
+			return false;
+		}
+
+		DearchiverCreateInfo dearchiverCI = {};
+		dearchiverCI.LazyResourceIndex = true;
+
+		RefCntAutoPtr<IDearchiver> pDearchiver;
+		pDevice->GetEngineFactory()->CreateDearchiver(dearchiverCI, &pDearchiver);
+		if (!pDearchiver)
+		{
+			LOG_WARNING_MESSAGE("This backend has no dearchiver; render state archive '", filePath, "' is ignored.");
+			return false;
+		}
+
+		if (!pDearchiver->LoadArchive(pData, CONTENT_VERSION))
+		{
+			LOG_WARNING_MESSAGE("Render state archive '", filePath, "' is invalid or out of date and is ignored.");
+			return false;
+		}
+
+		m_pDevice = pDevice;
+		m_DeviceType = pDevice->GetDeviceInfo().Type;
+		m_pDearchiver = pDearchiver;
+		m_pArchiveData = pData;
+
+		m_Stats.LoadMilliseconds = timer.GetElapsedTime() * 1000.0;
+		return true;
+	}
+
+	bool RenderStateArchive::BeginCook(IRenderDevice* pDevice, IArchiverFactory* pArchiverFactory, RENDER_DEVICE_TYPE targetType)
+	{
+		ASSERT(pDevice, "Device is null.");
+		ASSERT(pArchiverFactory, "Archiver factory is null.");
+
+		Shutdown();
+
+		const RenderDeviceInfo& deviceInfo = pDevice->GetDeviceInfo();
+		const RENDER_DEVICE_TYPE deviceType = (targetType != RENDER_DEVICE_TYPE_UNDEFINED) ? targetType : deviceInfo.Type;
+
+		// The archived bytecode comes from pDevice; only DXIL/DXBC can be re-targeted (to D3D12).
+		if (deviceType != deviceInfo.Type && deviceType != RENDER_DEVICE_TYPE_D3D12)
+		{
+			LOG_ERROR_MESSAGE("Render states for another backend can only be cooked for D3D12.");
+			return false;
+		}
+
+		SerializationDeviceCreateInfo ci = {};
+		ci.DeviceInfo = deviceInfo;
+		ci.DeviceInfo.Type = deviceType;
+		ci.AdapterInfo = pDevice->GetAdapterInfo();
+
+		IDXCompiler* pDXCompiler = GetDeviceDXCompiler(pDevice);
+		const Char* dxCompilerPath = (pDXCompiler != nullptr) ? pDXCompiler->GetLibraryName().c_str() : nullptr;
+
+		// Shaders are archived from their runtime bytecode, which text-based backends do not have.
+		switch (deviceType)
+		{
+		case RENDER_DEVICE_TYPE_D3D11:
+			ci.D3D11.FeatureLevel = deviceInfo.APIVersion;
+			break;
+
+		case RENDER_DEVICE_TYPE_D3D12:
+			ci.D3D12.ShaderVersion = deviceInfo.MaxShaderVersion.HLSL;
+			ci.D3D12.DxCompilerPath = dxCompilerPath;
+			break;
+
+		case RENDER_DEVICE_TYPE_VULKAN:
+			ci.Vulkan.ApiVersion = deviceInfo.APIVersion;
+			ci.Vulkan.DxCompilerPath = dxCompilerPath;
+			break;
+
+		default:
+			LOG_ERROR_MESSAGE("Render states can only be cooked on D3D11, D3D12 or Vulkan devices.");
+			return false;
+		}
+
+		pArchiverFactory->CreateSerializationDevice(ci, &m_pSerializationDevice);
+		if (!m_pSerializationDevice)
+		{
+			LOG_ERROR_MESSAGE("Failed to create the serialization device.");
+			return false;
+		}
+
+		if (deviceType == deviceInfo.Type)
+		{
+			m_pSerializationDevice->AddRenderDevice(pDevice);
+		}
+
+		pArchiverFactory->CreateArchiver(m_pSerializationDevice, &m_pArchiver);
+		if (!m_pArchiver)
+		{
+			LOG_ERROR_MESSAGE("Failed to create the archiver.");
+			m_pSerializationDevice.Release();
+			return false;
+		}
+
+		m_pDevice = pDevice;
+		m_DeviceType = deviceType;
+		m_DeviceFlags = RenderDeviceTypeToArchiveDataFlag(m_DeviceType);
+		return true;
+	}
+
+	bool RenderStateArchive::SaveCooked(const std::string& filePath)
+	{
+		if (!m_pArchiver || filePath.empty())
+		{
+			return false;
+		}
+
+		RefCntAutoPtr<IDataBlob> pData;
+		if (!m_pArchiver->SerializeToBlob(CONTENT_VERSION, &pData) || !pData)
+		{
+			LOG_ERROR_MESSAGE("Failed to serialize the render state archive.");
+			return false;
+		}
+
+		std::string directory;
+		FileSystem::GetPathComponents(filePath, &directory, nullptr);
+		if (!directory.empty() && !FileSystem::PathExists(directory.c_str()))
+		{
+			FileSystem::CreateDirectory(directory.c_str());
+		}
+
+		if (!FileWrapper::WriteFile(filePath.c_str(), pData->GetConstDataPtr(), pData->GetSize()))
+		{
+			LOG_ERROR_MESSAGE("Failed to write render state archive '", filePath, "'.");
+			return false;
+		}
+
+		LOG_INFO_MESSAGE("Render state archive '", filePath, "': ", m_Stats.CookedShaders, " shaders, ",
+			m_Stats.CookedPipelines, " pipelines, ", m_Stats.SkippedObjects, " skipped (", pData->GetSize() / 1024, " KB).");
+		return true;
+	}
+
+	void RenderStateArchive::Shutdown()
+	{
+		m_SerializedShaders.clear();
+		m_SerializedRenderPasses.clear();
+		m_pArchiver.Release();
+		m_pSerializationDevice.Release();
+		m_DeviceFlags = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+
+		m_pDearchiver.Release();
+		m_pArchiveData.Release();
+
+		m_pDevice.Release();
+		m_DeviceType = RENDER_DEVICE_TYPE_UNDEFINED;
+		m_Stats = {};
+	}
+
+	bool RenderStateArchive::UnpackShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+	{
+		ASSERT(ppShader && *ppShader == nullptr, "ppShader must point to a null pointer.");
+
+		if (!m_pDearchiver)
+		{
+			return false;
+		}
+
+		Timer timer;
+
+		const std::string name = makeShaderName(ShaderCI);
+
+		ShaderUnpackInfo unpackInfo = {};
+		unpackInfo.pDevice = m_pDevice;
+		unpackInfo.Name = name.c_str();
+		if (ShaderCI.Desc.Name != nullptr)
+		{
+			// Archived shaders are named by hash; keep the debug name.
+			unpackInfo.ModifyShaderDesc = [](ShaderDesc& desc, void* pUserData) {
+				desc.Name = static_cast<const Char*>(pUserData);
+			};
+			unpackInfo.pUserData = const_cast<Char*>(ShaderCI.Desc.Name);
+		}
+		m_pDearchiver->UnpackShader(unpackInfo, ppShader);
+
+		m_Stats.UnpackMilliseconds += timer.GetElapsedTime() * 1000.0;
+
+		if (*ppShader == nullptr)
+		{
+			++m_Stats.ShaderMisses;
+			return false;
+		}
+
+		++m_Stats.UnpackedShaders;
+		return true;
+	}
+
+	RefCntAutoPtr<IPipelineState> RenderStateArchive::UnpackGraphicsPipeline(
+		const GraphicsPipelineStateCreateInfo& psoCI,
+		const char* name,
+		IPipelineStateCache* pCache)
+	{
+		if (!m_pDearchiver)
+		{
+			return {};
+		}
+
+		PipelineStateUnpackInfo unpackInfo = {};
+		unpackInfo.Name = name;
+		unpackInfo.PipelineType = PIPELINE_TYPE_GRAPHICS;
+		unpackInfo.SRBAllocationGranularity = psoCI.PSODesc.SRBAllocationGranularity;
+		unpackInfo.ImmediateContextMask = psoCI.PSODesc.ImmediateContextMask;
+		unpackInfo.pCache = pCache;
+
+		if (psoCI.GraphicsPipeline.pRenderPass != nullptr)
+		{
+			// Framebuffers are created against the live render pass, not the archived copy.
+			unpackInfo.ModifyPipelineStateCreateInfo = [](PipelineStateCreateInfo& ci, void* pUserData) {
+				static_cast<GraphicsPipelineStateCreateInfo&>(ci).GraphicsPipeline.pRenderPass = static_cast<IRenderPass*>(pUserData);
+			};
+			unpackInfo.pUserData = psoCI.GraphicsPipeline.pRenderPass;
+		}
+
+		return unpackPipeline(unpackInfo);
+	}
+
+	RefCntAutoPtr<IPipelineState> RenderStateArchive::UnpackComputePipeline(
+		const ComputePipelineStateCreateInfo& psoCI,
+		const char* name,
+		IPipelineStateCache* pCache)
+	{
+		if (!m_pDearchiver)
+		{
+			return {};
+		}
+
+		PipelineStateUnpackInfo unpackInfo = {};
+		unpackInfo.Name = name;
+		unpackInfo.PipelineType = PIPELINE_TYPE_COMPUTE;
+		unpackInfo.SRBAllocationGranularity = psoCI.PSODesc.SRBAllocationGranularity;
+		unpackInfo.ImmediateContextMask = psoCI.PSODesc.ImmediateContextMask;
+		unpackInfo.pCache = pCache;
+
+		return unpackPipeline(unpackInfo);
+	}
+
+	RefCntAutoPtr<IPipelineState> RenderStateArchive::unpackPipeline(PipelineStateUnpackInfo& unpackInfo)
+	{
+		Timer timer;
+
+		unpackInfo.pDevice = m_pDevice;
+
+		RefCntAutoPtr<IPipelineState> pso;
+		m_pDearchiver->UnpackPipelineState(unpackInfo, &pso);
+
+		m_Stats.UnpackMilliseconds += timer.GetElapsedTime() * 1000.0;
+
+		if (!pso)
+		{
+			++m_Stats.PipelineMisses;
+			return {};
+		}
+
+		++m_Stats.UnpackedPipelines;
+		return pso;
+	}
+
+	void RenderStateArchive::CookShader(const ShaderCreateInfo& ShaderCI, IShader* pShader)
+	{
+		if (!m_pArchiver || pShader == nullptr)
+		{
+			return;
+		}
+
+		const std::string name = makeShaderName(ShaderCI);
+		if (m_pArchiver->GetShader(name.c_str()) != nullptr)
+		{
+			return;
+		}
+
+		IShader* pSerialized = serializeShader(pShader, name.c_str());
+		if (pSerialized == nullptr)
+		{
+			return;
+		}
+
+		if (!m_pArchiver->AddShader(pSerialized))
+		{
+			LOG_ERROR_MESSAGE("Failed to archive shader '", name, "'.");
+			++m_Stats.SkippedObjects;
+			return;
+		}
+
+		++m_Stats.CookedShaders;
+	}
+
+	void RenderStateArchive::CookGraphicsPipeline(const GraphicsPipelineStateCreateInfo& psoCI, const char* name)
+	{
+		if (!m_pArchiver || m_pArchiver->GetPipelineState(PIPELINE_TYPE_GRAPHICS, name) != nullptr)
+		{
+			return;
+		}
+
+		if (psoCI.ResourceSignaturesCount != 0)
+		{
+			// Explicit signatures would have to be mirrored as well; no renderer pipeline uses them.
+			++m_Stats.SkippedObjects;
+			return;
+		}
+
+		GraphicsPipelineStateCreateInfo ci = psoCI;
+		ci.PSODesc.Name = name;
+		ci.pPSOCache = nullptr;
+
+		if (!serializeShaders({ &ci.pVS, &ci.pPS, &ci.pDS, &ci.pHS, &ci.pGS, &ci.pAS, &ci.pMS }))
+		{
+			++m_Stats.SkippedObjects;
+			return;
+		}
+
+		if (ci.GraphicsPipeline.pRenderPass != nullptr)
+		{
+			ci.GraphicsPipeline.pRenderPass = serializeRenderPass(ci.GraphicsPipeline.pRenderPass);
+			if (ci.GraphicsPipeline.pRenderPass == nullptr)
+			{
+				++m_Stats.SkippedObjects;
+				return;
+			}
+		}
+
+		PipelineStateArchiveInfo archiveInfo = {};
+		archiveInfo.DeviceFlags = m_DeviceFlags;
+
+		RefCntAutoPtr<IPipelineState> pSerializedPSO;
+		m_pSerializationDevice->CreateGraphicsPipelineState(ci, archiveInfo, &pSerializedPSO);
+		addPipeline(pSerializedPSO, name);
+	}
+
+	void RenderStateArchive::CookComputePipeline(const ComputePipelineStateCreateInfo& psoCI, const char* name)
+	{
+		if (!m_pArchiver || m_pArchiver->GetPipelineState(PIPELINE_TYPE_COMPUTE, name) != nullptr)
+		{
+			return;
+		}
+
+		if (psoCI.ResourceSignaturesCount != 0)
+		{
+			++m_Stats.SkippedObjects;
+			return;
+		}
+
+		ComputePipelineStateCreateInfo ci = psoCI;
+		ci.PSODesc.Name = name;
+		ci.pPSOCache = nullptr;
+
+		if (!serializeShaders({ &ci.pCS }))
+		{
+			++m_Stats.SkippedObjects;
+			return;
+		}
+
+		PipelineStateArchiveInfo archiveInfo = {};
+		archiveInfo.DeviceFlags = m_DeviceFlags;
+
+		RefCntAutoPtr<IPipelineState> pSerializedPSO;
+		m_pSerializationDevice->CreateComputePipelineState(ci, archiveInfo, &pSerializedPSO);
+		addPipeline(pSerializedPSO, name);
+	}
+
+	void RenderStateArchive::addPipeline(IPipelineState* pSerializedPSO, const char* name)
+	{
+		if (pSerializedPSO == nullptr || !m_pArchiver->AddPipelineState(pSerializedPSO))
+		{
+			LOG_ERROR_MESSAGE("Failed to archive pipeline '", name, "'.");
+			++m_Stats.SkippedObjects;
+			return;
+		}
+
+		++m_Stats.CookedPipelines;
+	}
+
+	std::string RenderStateArchive::makeShaderName(const ShaderCreateInfo& ShaderCI)
+	{
+		XXH128State hasher;
+		hasher.Update(ShaderCI);
+		return formatHash("SH_", hasher.Digest());
+	}
+
+	IShader* RenderStateArchive::serializeShader(IShader* pShader, const char* name)
+	{
+		auto it = m_SerializedShaders.find(pShader);
+		if (it != m_SerializedShaders.end())
+		{
+			return it->second.pSerialized;
+		}
+
+		if (pShader->GetStatus(/*WaitForCompletion*/ true) != SHADER_STATUS_READY)
+		{
+			return nullptr;
+		}
+
+		ShaderCreateInfo ci = {};
+		ci.Desc = pShader->GetDesc();
+		if (name != nullptr)
+		{
+			ci.Desc.Name = name;
+		}
+
+		uint64 size = 0;
+		pShader->GetBytecode(&ci.ByteCode, size);
+		ci.ByteCodeSize = static_cast<size_t>(size);
+		if (ci.ByteCode == nullptr || ci.ByteCodeSize == 0)
+		{
+			LOG_WARNING_MESSAGE("Shader '", pShader->GetDesc().Name, "' has no bytecode and cannot be archived.");
+			return nullptr;
+		}
+
+		ShaderArchiveInfo archiveInfo = {};
+		archiveInfo.DeviceFlags = m_DeviceFlags;
+
+		RefCntAutoPtr<IShader> pSerialized;
+		m_pSerializationDevice->CreateShader(ci, archiveInfo, &pSerialized);
+		if (!pSerialized)
+		{
+			LOG_ERROR_MESSAGE("Failed to serialize shader '", pShader->GetDesc().Name, "'.");
+			return nullptr;
+		}
+
+		SerializedObject<IShader>& entry = m_SerializedShaders[pShader];
+		entry.pRuntime = pShader;
+		entry.pSerialized = std::move(pSerialized);
+		return entry.pSerialized;
+	}
+
+	bool RenderStateArchive::serializeShaders(std::initializer_list<IShader**> ppShaders)
+	{
+		for (IShader** ppShader : ppShaders)
+		{
+			if (*ppShader == nullptr)
+			{
+				continue;
+			}
+
+			*ppShader = serializeShader(*ppShader, nullptr);
+			if (*ppShader == nullptr)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	IRenderPass* RenderStateArchive::serializeRenderPass(IRenderPass* pRenderPass)
+	{
+		auto it = m_SerializedRenderPasses.find(pRenderPass);
+		if (it != m_SerializedRenderPasses.end())
+		{
+			return it->second.pSerialized;
+		}
+
+		// Render passes are archived by name; make it unique per description.
+		RenderPassDesc desc = pRenderPass->GetDesc();
+
+		XXH128State hasher;
+		hasher.Update(desc);
+		const std::string name = formatHash("RP_", hasher.Digest());
+		desc.Name = name.c_str();
+
+		RefCntAutoPtr<IRenderPass> pSerialized;
+		m_pSerializationDevice->CreateRenderPass(desc, &pSerialized);
+		if (!pSerialized)
+		{
+			LOG_ERROR_MESSAGE("Failed to serialize render pass '", pRenderPass->GetDesc().Name, "'.");
+			return nullptr;
+		}
+
+		SerializedObject<IRenderPass>& entry = m_SerializedRenderPasses[pRenderPass];
+		entry.pRuntime = pRenderPass;
+		entry.pSerialized = std::move(pSerialized);
+		return entry.pSerialized;
+	}
+
+} // namespace shz
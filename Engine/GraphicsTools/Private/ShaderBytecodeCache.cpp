@@ -0,0 +1,232 @@
+#include "pch.h"
+#include "Engine/GraphicsTools/Public/ShaderBytecodeCache.h"
+
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/FileWrapper.hpp"
+#include "Engine/Core/Common/Public/Timer.hpp"
+#include "Engine/Core/Memory/Public/DataBlobImpl.hpp"
+#include "Engine/Core/Memory/Public/EngineMemory.h"
+
+namespace shz
+{
+	void ShaderBytecodeCache::Initialize(RENDER_DEVICE_TYPE deviceType, const std::string& filePath, bool asyncCompile)
+	{
+		Shutdown();
+
+		m_bAsyncCompile = asyncCompile;
+
+		BytecodeCacheCreateInfo ci = {};
+		ci.DeviceType = deviceType;
+		CreateBytecodeCache(ci, &m_pCache);
+		ASSERT(m_pCache, "Failed to create bytecode cache.");
+
+		m_FilePath = filePath;
+		if (m_FilePath.empty() || !m_pCache)
+		{
+			return;
+		}
+
+		RefCntAutoPtr<IDataBlob> pData;
+		if (!FileWrapper::ReadWholeFile(m_FilePath.c_str(), &pData, /*Silent*/ true) || !pData || pData->GetSize() == 0)
+		{
+			return;
+		}
+
+		// Load() keeps whatever it read before a failure; start clean instead.
+		if (!m_pCache->Load(pData))
+		{
+			LOG_WARNING_MESSAGE("Shader bytecode cache '", m_FilePath, "' is invalid and will be rebuilt.");
+			m_pCache->Clear();
+		}
+	}
+
+	bool ShaderBytecodeCache::Save()
+	{
+		ResolvePending();
+
+		if (!m_pCache || m_FilePath.empty() || !m_bDirty)
+		{
+			return true;
+		}
+
+		RefCntAutoPtr<IDataBlob> pData;
+		m_pCache->Store(&pData);
+		if (!pData)
+		{
+			return false;
+		}
+
+		std::string directory;
+		FileSystem::GetPathComponents(m_FilePath, &directory, nullptr);
+		if (!directory.empty() && !FileSystem::PathExists(directory.c_str()))
+		{
+			FileSystem::CreateDirectory(directory.c_str());
+		}
+
+		if (!FileWrapper::WriteFile(m_FilePath.c_str(), pData->GetConstDataPtr(), pData->GetSize()))
+		{
+			LOG_ERROR_MESSAGE("Failed to write shader bytecode cache '", m_FilePath, "'.");
+			return false;
+		}
+
+		m_bDirty = false;
+		return true;
+	}
+
+	void ShaderBytecodeCache::ResolvePending()
+	{
+		if (m_Pending.empty())
+		{
+			return;
+		}
+
+		Timer timer;
+
+		for (PendingShader& pending : m_Pending)
+		{
+			// Failed compiles are reported by the device; they are simply not cached.
+			if (pending.pShader->GetStatus(/*WaitForCompletion*/ true) == SHADER_STATUS_READY)
+			{
+				addBytecode(pending.CreateInfo, pending.pShader);
+			}
+		}
+		m_Pending.clear();
+
+		m_Stats.ResolveMilliseconds += timer.GetElapsedTime() * 1000.0;
+	}
+
+	void ShaderBytecodeCache::Shutdown()
+	{
+		// Outstanding compiles only hold references to their shaders; dropping them is safe.
+		m_Pending.clear();
+		m_pCache.Release();
+		m_pArchive = nullptr;
+		m_pPreprocess = nullptr;
+		m_FilePath.clear();
+		m_bAsyncCompile = false;
+		m_bDirty = false;
+		m_Stats = {};
+	}
+
+	void ShaderBytecodeCache::CreateShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+	{
+		ASSERT(pDevice, "Device is null.");
+		ASSERT(ppShader && *ppShader == nullptr, "ppShader must point to a null pointer.");
+		ASSERT(ShaderCI.ByteCode == nullptr, "Cached shaders must be created from source.");
+
+		if (m_pPreprocess != nullptr && ShaderCI.Source == nullptr && ShaderCI.FilePath != nullptr &&
+			ShaderCI.pShaderSourceStreamFactory == m_pPreprocess->GetFactory())
+		{
+			RefCntAutoPtr<IDataBlob> pSource = m_pPreprocess->GetExpandedSource(ShaderCI);
+			if (pSource)
+			{
+				ShaderCreateInfo expandedCI = ShaderCI;
+				expandedCI.Source = static_cast<const Char*>(pSource->GetConstDataPtr());
+				expandedCI.SourceLength = pSource->GetSize();
+				expandedCI.FilePath = nullptr;
+				if (expandedCI.Desc.Name == nullptr)
+				{
+					expandedCI.Desc.Name = ShaderCI.FilePath;
+				}
+
+				createArchivedShader(pDevice, expandedCI, ppShader);
+				return;
+			}
+
+			// A file of the closure is missing: let the compiler report it.
+		}
+
+		createArchivedShader(pDevice, ShaderCI, ppShader);
+	}
+
+	void ShaderBytecodeCache::createArchivedShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+	{
+		if (m_pArchive != nullptr && m_pArchive->UnpackShader(ShaderCI, ppShader))
+		{
+			++m_Stats.ArchiveHits;
+			return;
+		}
+
+		createShader(pDevice, ShaderCI, ppShader);
+
+		// Cooking waits for asynchronous compiles, since the archive stores bytecode.
+		if (m_pArchive != nullptr && m_pArchive->IsCooking() && *ppShader != nullptr)
+		{
+			m_pArchive->CookShader(ShaderCI, *ppShader);
+		}
+	}
+
+	void ShaderBytecodeCache::createShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader)
+	{
+		if (!m_pCache)
+		{
+			pDevice->CreateShader(ShaderCI, ppShader);
+			return;
+		}
+
+		Timer timer;
+
+		RefCntAutoPtr<IDataBlob> pBytecode;
+		m_pCache->GetBytecode(ShaderCI, &pBytecode);
+		if (pBytecode)
+		{
+			ShaderCreateInfo bytecodeCI = ShaderCI;
+			bytecodeCI.Source = nullptr;
+			bytecodeCI.FilePath = nullptr;
+			bytecodeCI.ByteCode = pBytecode->GetConstDataPtr();
+			bytecodeCI.ByteCodeSize = pBytecode->GetSize();
+
+			pDevice->CreateShader(bytecodeCI, ppShader);
+			if (*ppShader != nullptr)
+			{
+				++m_Stats.Hits;
+				m_Stats.HitMilliseconds += timer.GetElapsedTime() * 1000.0;
+				return;
+			}
+
+			// Stale entry (e.g. compiled by a different compiler version); rebuild it.
+			m_pCache->RemoveBytecode(ShaderCI);
+			m_bDirty = true;
+		}
+
+		++m_Stats.Misses;
+
+		if (m_bAsyncCompile && pDevice->GetShaderCompilationThreadPool() != nullptr)
+		{
+			ShaderCreateInfo asyncCI = ShaderCI;
+			asyncCI.CompileFlags |= SHADER_COMPILE_FLAG_ASYNCHRONOUS;
+
+			pDevice->CreateShader(asyncCI, ppShader);
+			if (*ppShader != nullptr)
+			{
+				++m_Stats.AsyncMisses;
+				m_Pending.push_back({ ShaderCreateInfoWrapper{ ShaderCI, GetRawAllocator() }, RefCntAutoPtr<IShader>{ *ppShader } });
+			}
+		}
+		else
+		{
+			pDevice->CreateShader(ShaderCI, ppShader);
+			if (*ppShader != nullptr)
+			{
+				addBytecode(ShaderCI, *ppShader);
+			}
+		}
+
+		m_Stats.MissMilliseconds += timer.GetElapsedTime() * 1000.0;
+	}
+
+	void ShaderBytecodeCache::addBytecode(const ShaderCreateInfo& ShaderCI, IShader* pShader)
+	{
+		const void* pData = nullptr;
+		uint64 size = 0;
+		pShader->GetBytecode(&pData, size);
+
+		if (pData != nullptr && size != 0)
+		{
+			RefCntAutoPtr<DataBlobImpl> pBlob = DataBlobImpl::Create(static_cast<size_t>(size), pData);
+			m_pCache->AddBytecode(ShaderCI, pBlob);
+			m_bDirty = true;
+		}
+	}
+
+} // namespace shz
@@ -0,0 +1,548 @@
+#include "pch.h"
+#include "Engine/GraphicsTools/Public/ShaderPreprocessCache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/ObjectBase.hpp"
+#include "Engine/Core/Common/Public/MemoryFileStream.hpp"
+#include "Engine/Core/Memory/Public/DataBlobImpl.hpp"
+
+#include "Engine/GraphicsTools/Public/XXH128Hasher.hpp"
+#include "Engine/ShaderTools/Public/ShaderToolsCommon.hpp"
+
+namespace shz
+{
+	// DXC hands includes over as "./File.hlsli" or "Dir\..\File.hlsli"; key every file
+	// by the same lexically normal name with forward slashes.
+	static std::string normalizeSourceName(const std::string& name)
+	{
+		if (name.empty())
+		{
+			return name;
+		}
+
+		std::string key = name;
+		std::replace(key.begin(), key.end(), '\\', '/');
+		return std::filesystem::path(key).lexically_normal().generic_string();
+	}
+
+	// #line must start a line; an inlined file may end without a newline.
+	static void appendLineDirective(std::string& out, size_t line, const std::string& file)
+	{
+		if (!out.empty() && out.back() != '\n')
+		{
+			out += '\n';
+		}
+		out += "#line ";
+		out += std::to_string(line);
+		out += " \"";
+		out += file;
+		out += "\"\n";
+	}
+
+	class ShaderPreprocessCache::CachingSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+	{
+	public:
+		using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+		CachingSourceFactory(IReferenceCounters* pRefCounters, IShaderSourceInputStreamFactory* pSourceFactory)
+			: TBase{ pRefCounters }
+			, m_pSourceFactory{ pSourceFactory }
+		{
+		}
+
+		IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase);
+
+		virtual void SHZ_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+		{
+			CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+		}
+
+		virtual void SHZ_CALL_TYPE CreateInputStream2(
+			const Char* Name,
+			CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+			IFileStream** ppStream) override final
+		{
+			ASSERT_EXPR(ppStream != nullptr && *ppStream == nullptr);
+
+			FileEntry entry = {};
+			if (!acquire(normalizeSourceName(Name != nullptr ? Name : ""), Flags, entry))
+			{
+				return;
+			}
+
+			RefCntAutoPtr<MemoryFileStream> pMemStream{ MakeNewRCObj<MemoryFileStream>()(entry.pData) };
+			pMemStream->QueryInterface(IID_FileStream, ppStream);
+		}
+
+		RefCntAutoPtr<IDataBlob> GetExpandedSource(const ShaderCreateInfo& ShaderCI)
+		{
+			if (ShaderCI.FilePath == nullptr || ShaderCI.Source != nullptr)
+			{
+				return {};
+			}
+
+			const std::string root = normalizeSourceName(ShaderCI.FilePath);
+			const bool bLineDirectives =
+				ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_DEFAULT ||
+				ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL;
+
+			// Snapshot the closure in expansion order. Once every file is cached
+			// this is a map lookup per file: no IO and no include scanning.
+			std::unordered_map<std::string, FileEntry> closure;
+			std::vector<std::string> order;
+			if (!collectClosure(root, closure, order))
+			{
+				return {};
+			}
+
+			XXH128State hasher;
+			hasher.Update(bLineDirectives);
+			for (const std::string& key : order)
+			{
+				hasher.Update(key);
+				hasher.UpdateRaw(&closure.at(key).Hash, sizeof(XXH128Hash));
+			}
+			const XXH128Hash closureHash = hasher.Digest();
+
+			{
+				std::lock_guard<std::mutex> lock{ m_Mtx };
+				auto it = m_Units.find(closureHash);
+				if (it != m_Units.end())
+				{
+					++m_Stats.UnitHits;
+					return it->second.pSource;
+				}
+			}
+
+			std::string text;
+			std::unordered_set<std::string> expanded = { root };
+			expand(root, closure, expanded, bLineDirectives, text);
+
+			RefCntAutoPtr<IDataBlob> pSource{ DataBlobImpl::Create(text.size(), text.data()) };
+
+			std::lock_guard<std::mutex> lock{ m_Mtx };
+			auto [it, inserted] = m_Units.try_emplace(closureHash, ExpandedUnit{ root, pSource });
+			if (inserted)
+			{
+				++m_Stats.UnitBuilds;
+			}
+			return it->second.pSource;
+		}
+
+		std::vector<std::string> Refresh(const std::vector<std::string>* pKeys)
+		{
+			std::vector<std::string> keys;
+			if (pKeys != nullptr)
+			{
+				keys = *pKeys;
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock{ m_Mtx };
+				keys.reserve(m_Files.size());
+				for (const auto& [key, entry] : m_Files)
+				{
+					keys.push_back(key);
+				}
+			}
+
+			std::vector<std::string> changed;
+			for (const std::string& key : keys)
+			{
+				FileEntry fresh = {};
+				const bool bRead = readFile(key, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, fresh);
+
+				std::lock_guard<std::mutex> lock{ m_Mtx };
+				auto it = m_Files.find(key);
+				if (it == m_Files.end())
+				{
+					continue;
+				}
+
+				if (!bRead)
+				{
+					// Keep the includers on the list; their next compile reports the missing file.
+					LOG_WARNING_MESSAGE("Shader source '", key, "' can no longer be read.");
+					unlinkIncludes(key, it->second.Includes);
+					m_Files.erase(it);
+					changed.push_back(key);
+					continue;
+				}
+
+				if (it->second.Hash == fresh.Hash)
+				{
+					continue;
+				}
+
+				unlinkIncludes(key, it->second.Includes);
+				it->second = std::move(fresh);
+				linkIncludes(key, it->second.Includes);
+				changed.push_back(key);
+			}
+
+			std::lock_guard<std::mutex> lock{ m_Mtx };
+			m_Stats.ChangedFiles += static_cast<uint32>(changed.size());
+
+			std::vector<std::string> dependents = collectDependents(changed);
+
+			// Units of the dependents are stale; their new closure hashes will not find them.
+			if (!changed.empty())
+			{
+				const std::unordered_set<std::string> stale(dependents.begin(), dependents.end());
+				std::erase_if(m_Units, [&](const auto& unit) { return stale.count(unit.second.Root) != 0; });
+			}
+			return dependents;
+		}
+
+		std::vector<std::string> GetDependents(const std::string& filePath) const
+		{
+			std::lock_guard<std::mutex> lock{ m_Mtx };
+			return collectDependents({ normalizeSourceName(filePath) });
+		}
+
+		std::vector<std::string> GetIncludes(const std::string& filePath) const
+		{
+			std::lock_guard<std::mutex> lock{ m_Mtx };
+			auto it = m_Files.find(normalizeSourceName(filePath));
+			if (it == m_Files.end())
+			{
+				return {};
+			}
+
+			std::vector<std::string> includes;
+			includes.reserve(it->second.Includes.size());
+			for (const IncludeRef& include : it->second.Includes)
+			{
+				includes.push_back(include.Key);
+			}
+			return includes;
+		}
+
+		ShaderPreprocessCacheStats GetStats() const
+		{
+			std::lock_guard<std::mutex> lock{ m_Mtx };
+			return m_Stats;
+		}
+
+	private:
+		struct IncludeRef final
+		{
+			// Resolved, normalized name of the included file.
+			std::string Key;
+
+			// The directive spans [Start, End) of the including file.
+			size_t Start = 0;
+			size_t End = 0;
+		};
+
+		struct FileEntry final
+		{
+			RefCntAutoPtr<IDataBlob> pData;
+			XXH128Hash Hash = {};
+
+			// In the order they appear in the file.
+			std::vector<IncludeRef> Includes = {};
+		};
+
+		struct ExpandedUnit final
+		{
+			std::string Root;
+			RefCntAutoPtr<IDataBlob> pSource;
+		};
+
+		// Copies the entry of key into outEntry, reading the file on first use.
+		bool acquire(const std::string& key, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS flags, FileEntry& outEntry)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ m_Mtx };
+				auto it = m_Files.find(key);
+				if (it != m_Files.end())
+				{
+					outEntry = it->second;
+					++m_Stats.CachedReads;
+					return true;
+				}
+			}
+
+			// Read outside the lock so compile threads do not queue behind each other's IO.
+			FileEntry entry = {};
+			if (!readFile(key, flags, entry))
+			{
+				return false;
+			}
+
+			std::lock_guard<std::mutex> lock{ m_Mtx };
+			auto [it, inserted] = m_Files.try_emplace(key, std::move(entry));
+			if (inserted)
+			{
+				linkIncludes(key, it->second.Includes);
+				++m_Stats.FileReads;
+			}
+			outEntry = it->second;
+			return true;
+		}
+
+		// Depth-first, each file once, in the order expand() inlines them.
+		bool collectClosure(const std::string& key, std::unordered_map<std::string, FileEntry>& closure, std::vector<std::string>& order)
+		{
+			auto [it, inserted] = closure.try_emplace(key);
+			if (!inserted)
+			{
+				return true;
+			}
+
+			// Element references survive rehashing; iterators do not.
+			FileEntry& entry = it->second;
+			if (!acquire(key, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, entry))
+			{
+				return false;
+			}
+
+			order.push_back(key);
+			for (const IncludeRef& include : entry.Includes)
+			{
+				if (!collectClosure(include.Key, closure, order))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Same output as UnrollShaderIncludes(), plus #line directives when requested.
+		static void expand(
+			const std::string& key,
+			const std::unordered_map<std::string, FileEntry>& closure,
+			std::unordered_set<std::string>& expanded,
+			bool bLineDirectives,
+			std::string& out)
+		{
+			const FileEntry& entry = closure.at(key);
+			const Char* pSource = static_cast<const Char*>(entry.pData->GetConstDataPtr());
+			const size_t size = entry.pData->GetSize();
+
+			if (bLineDirectives)
+			{
+				appendLineDirective(out, 1, key);
+			}
+
+			size_t prevEnd = 0;
+			size_t line = 1;
+			for (const IncludeRef& include : entry.Includes)
+			{
+				out.append(pSource + prevEnd, include.Start - prevEnd);
+				line += static_cast<size_t>(std::count(pSource + prevEnd, pSource + include.Start, '\n'));
+
+				if (expanded.insert(include.Key).second)
+				{
+					expand(include.Key, closure, expanded, bLineDirectives, out);
+					if (bLineDirectives)
+					{
+						// The rest of the directive's line follows.
+						appendLineDirective(out, line, key);
+					}
+				}
+
+				prevEnd = include.End;
+			}
+			out.append(pSource + prevEnd, size - prevEnd);
+		}
+
+		// Quoted-include rules: next to the including file first, then the name
+		// as written, which the wrapped factory looks up in its search paths.
+		std::string resolveInclude(const std::string& includerKey, const std::string& name) const
+		{
+			const std::string asWritten = normalizeSourceName(name);
+
+			const size_t slash = includerKey.find_last_of('/');
+			if (slash == std::string::npos)
+			{
+				return asWritten;
+			}
+
+			const std::string relative = normalizeSourceName(includerKey.substr(0, slash + 1) + name);
+			if (relative == asWritten)
+			{
+				return asWritten;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock{ m_Mtx };
+				if (m_Files.count(relative) != 0)
+				{
+					return relative;
+				}
+			}
+
+			RefCntAutoPtr<IFileStream> pStream;
+			m_pSourceFactory->CreateInputStream2(relative.c_str(), CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+			return pStream ? relative : asWritten;
+		}
+
+		bool readFile(const std::string& key, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS flags, FileEntry& outEntry) const
+		{
+			RefCntAutoPtr<IFileStream> pStream;
+			m_pSourceFactory->CreateInputStream2(key.c_str(), flags, &pStream);
+			if (!pStream)
+			{
+				return false;
+			}
+
+			RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create();
+			pStream->ReadBlob(pData);
+
+			XXH128State hasher;
+			hasher.UpdateRaw(pData->GetConstDataPtr(), pData->GetSize());
+			outEntry.Hash = hasher.Digest();
+
+			std::vector<ShaderIncludeDirective> includes;
+			FindShaderIncludes(static_cast<const Char*>(pData->GetConstDataPtr()), pData->GetSize(), includes);
+
+			outEntry.Includes.clear();
+			outEntry.Includes.reserve(includes.size());
+			for (const ShaderIncludeDirective& include : includes)
+			{
+				outEntry.Includes.push_back({ resolveInclude(key, include.FilePath), include.Start, include.End });
+			}
+
+			outEntry.pData = pData;
+			return true;
+		}
+
+		void linkIncludes(const std::string& key, const std::vector<IncludeRef>& includes)
+		{
+			for (const IncludeRef& include : includes)
+			{
+				m_IncludedBy[include.Key].insert(key);
+			}
+		}
+
+		void unlinkIncludes(const std::string& key, const std::vector<IncludeRef>& includes)
+		{
+			for (const IncludeRef& include : includes)
+			{
+				auto it = m_IncludedBy.find(include.Key);
+				if (it != m_IncludedBy.end())
+				{
+					it->second.erase(key);
+					if (it->second.empty())
+					{
+						m_IncludedBy.erase(it);
+					}
+				}
+			}
+		}
+
+		// Breadth-first walk over the reverse include edges.
+		std::vector<std::string> collectDependents(const std::vector<std::string>& roots) const
+		{
+			std::vector<std::string> result;
+			std::unordered_set<std::string> visited;
+
+			for (const std::string& root : roots)
+			{
+				if (visited.insert(root).second)
+				{
+					result.push_back(root);
+				}
+			}
+
+			for (size_t i = 0; i < result.size(); ++i)
+			{
+				auto it = m_IncludedBy.find(result[i]);
+				if (it == m_IncludedBy.end())
+				{
+					continue;
+				}
+
+				for (const std::string& includer : it->second)
+				{
+					if (visited.insert(includer).second)
+					{
+						result.push_back(includer);
+					}
+				}
+			}
+
+			return result;
+		}
+
+	private:
+		RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pSourceFactory;
+
+		mutable std::mutex m_Mtx;
+		std::unordered_map<std::string, FileEntry> m_Files;
+		std::unordered_map<std::string, std::unordered_set<std::string>> m_IncludedBy;
+
+		// Keyed by the include-closure hash computed in GetExpandedSource().
+		std::unordered_map<XXH128Hash, ExpandedUnit> m_Units;
+
+		ShaderPreprocessCacheStats m_Stats = {};
+	};
+
+	ShaderPreprocessCache::ShaderPreprocessCache() = default;
+
+	ShaderPreprocessCache::~ShaderPreprocessCache() = default;
+
+	void ShaderPreprocessCache::Initialize(IShaderSourceInputStreamFactory* pSourceFactory)
+	{
+		ASSERT(pSourceFactory, "Shader source factory is null.");
+
+		Shutdown();
+		m_pFactory = RefCntAutoPtr<CachingSourceFactory>{ MakeNewRCObj<CachingSourceFactory>()(pSourceFactory) };
+	}
+
+	void ShaderPreprocessCache::Shutdown()
+	{
+		// Shaders that are still compiling keep the factory alive through their own references.
+		m_pFactory.Release();
+	}
+
+	bool ShaderPreprocessCache::IsInitialized() const noexcept
+	{
+		return m_pFactory != nullptr;
+	}
+
+	IShaderSourceInputStreamFactory* ShaderPreprocessCache::GetFactory() const noexcept
+	{
+		return m_pFactory.RawPtr();
+	}
+
+	std::vector<std::string> ShaderPreprocessCache::Refresh()
+	{
+		return m_pFactory ? m_pFactory->Refresh(nullptr) : std::vector<std::string>{};
+	}
+
+	std::vector<std::string> ShaderPreprocessCache::Invalidate(const std::string& filePath)
+	{
+		const std::vector<std::string> keys = { normalizeSourceName(filePath) };
+		return m_pFactory ? m_pFactory->Refresh(&keys) : std::vector<std::string>{};
+	}
+
+	std::vector<std::string> ShaderPreprocessCache::GetDependents(const std::string& filePath) const
+	{
+		return m_pFactory ? m_pFactory->GetDependents(filePath) : std::vector<std::string>{};
+	}
+
+	std::vector<std::string> ShaderPreprocessCache::GetIncludes(const std::string& filePath) const
+	{
+		return m_pFactory ? m_pFactory->GetIncludes(filePath) : std::vector<std::string>{};
+	}
+
+	RefCntAutoPtr<IDataBlob> ShaderPreprocessCache::GetExpandedSource(const ShaderCreateInfo& ShaderCI)
+	{
+		return m_pFactory ? m_pFactory->GetExpandedSource(ShaderCI) : RefCntAutoPtr<IDataBlob>{};
+	}
+
+	ShaderPreprocessCacheStats ShaderPreprocessCache::GetStats() const
+	{
+		return m_pFactory ? m_pFactory->GetStats() : ShaderPreprocessCacheStats{};
+	}
+
+} // namespace shz
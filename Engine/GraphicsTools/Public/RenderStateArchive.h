@@ -0,0 +1,133 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <initializer_list>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+
+#include "Engine/RHI/Interface/IRenderDevice.h"
+#include "Engine/RHI/Interface/IShader.h"
+#include "Engine/RHI/Interface/IPipelineState.h"
+#include "Engine/RHI/Interface/IPipelineStateCache.h"
+#include "Engine/RHI/Interface/IRenderPass.h"
+#include "Engine/RHI/Interface/IDearchiver.h"
+
+#include "Engine/GraphicsArchiver/Public/ArchiverFactory.h"
+
+namespace shz
+{
+	struct RenderStateArchiveStats final
+	{
+		// Objects created from the loaded archive.
+		uint32 UnpackedShaders = 0;
+		uint32 UnpackedPipelines = 0;
+
+		// Lookups the archive could not answer (the caller builds those from source).
+		uint32 ShaderMisses = 0;
+		uint32 PipelineMisses = 0;
+
+		// Objects added to the archive being cooked.
+		uint32 CookedShaders = 0;
+		uint32 CookedPipelines = 0;
+
+		// Objects that could not be cooked (no bytecode, explicit signatures, ...).
+		uint32 SkippedObjects = 0;
+
+		// Reading the file / creating objects from it.
+		double LoadMilliseconds = 0.0;
+		double UnpackMilliseconds = 0.0;
+	};
+
+	// ------------------------------------------------------------
+	// RenderStateArchive
+	// - One file holding device-ready shaders and pipelines (with their
+	//   implicit signatures and render passes), read through the engine
+	//   IDearchiver. The file is memory-mapped and opened through its
+	//   resource index, so only the objects that are unpacked are read.
+	// - Shaders are named after the XXH128 of their create info (sources,
+	//   includes, macros, flags); pipelines after the PipelineStateManager
+	//   key. Editing a shader renames it, so a stale archive costs misses
+	//   and never returns the wrong object.
+	// - Cooking (offline, see App/RenderStateCooker): every shader and
+	//   pipeline the renderer creates is passed to Cook*(). The runtime
+	//   bytecode is re-wrapped on a serialization device (nothing is
+	//   compiled twice) and added to an IArchiver. SaveCooked() writes the file.
+	// - Unpacked graphics pipelines are bound to the caller's render pass,
+	//   not to the copy stored in the archive.
+	// ------------------------------------------------------------
+	class RenderStateArchive final
+	{
+	public:
+		// Archives written with another content version are ignored.
+		static constexpr uint32 CONTENT_VERSION = 1;
+
+		RenderStateArchive() = default;
+		RenderStateArchive(const RenderStateArchive&) = delete;
+		RenderStateArchive& operator=(const RenderStateArchive&) = delete;
+		~RenderStateArchive() { Shutdown(); }
+
+		// A missing or incompatible file is not an error (nothing is unpacked).
+		bool Load(IRenderDevice* pDevice, const std::string& filePath);
+
+		// Starts collecting objects for a new archive (bytecode backends only).
+		// targetType UNDEFINED cooks for pDevice's own backend. Another target needs a device
+		// producing its bytecode: the null device compiles DXIL/DXBC, so it can cook for D3D12.
+		bool BeginCook(IRenderDevice* pDevice, IArchiverFactory* pArchiverFactory, RENDER_DEVICE_TYPE targetType = RENDER_DEVICE_TYPE_UNDEFINED);
+		bool SaveCooked(const std::string& filePath);
+
+		void Shutdown();
+
+		bool IsLoaded() const noexcept { return m_pDearchiver != nullptr; }
+		bool IsCooking() const noexcept { return m_pArchiver != nullptr; }
+
+		// Return false / null when the object is not in the archive.
+		bool UnpackShader(const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+		RefCntAutoPtr<IPipelineState> UnpackGraphicsPipeline(const GraphicsPipelineStateCreateInfo& psoCI, const char* name, IPipelineStateCache* pCache = nullptr);
+		RefCntAutoPtr<IPipelineState> UnpackComputePipeline(const ComputePipelineStateCreateInfo& psoCI, const char* name, IPipelineStateCache* pCache = nullptr);
+
+		// pShader must have been created from ShaderCI; asynchronous compiles are waited for.
+		void CookShader(const ShaderCreateInfo& ShaderCI, IShader* pShader);
+		void CookGraphicsPipeline(const GraphicsPipelineStateCreateInfo& psoCI, const char* name);
+		void CookComputePipeline(const ComputePipelineStateCreateInfo& psoCI, const char* name);
+
+		const RenderStateArchiveStats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		// The runtime object is kept alive so its address is not reused.
+		template <typename T>
+		struct SerializedObject final
+		{
+			RefCntAutoPtr<T> pRuntime;
+			RefCntAutoPtr<T> pSerialized;
+		};
+
+		static std::string makeShaderName(const ShaderCreateInfo& ShaderCI);
+
+		// Return null if the object cannot be serialized.
+		IShader* serializeShader(IShader* pShader, const char* name);
+		IRenderPass* serializeRenderPass(IRenderPass* pRenderPass);
+		bool serializeShaders(std::initializer_list<IShader**> ppShaders);
+		void addPipeline(IPipelineState* pSerializedPSO, const char* name);
+
+		RefCntAutoPtr<IPipelineState> unpackPipeline(PipelineStateUnpackInfo& unpackInfo);
+
+	private:
+		RefCntAutoPtr<IRenderDevice> m_pDevice;
+		RENDER_DEVICE_TYPE m_DeviceType = RENDER_DEVICE_TYPE_UNDEFINED;
+
+		// Loaded archive
+		RefCntAutoPtr<IDearchiver> m_pDearchiver;
+		RefCntAutoPtr<IDataBlob> m_pArchiveData;
+
+		// Archive being cooked
+		RefCntAutoPtr<ISerializationDevice> m_pSerializationDevice;
+		RefCntAutoPtr<IArchiver> m_pArchiver;
+		ARCHIVE_DEVICE_DATA_FLAGS m_DeviceFlags = ARCHIVE_DEVICE_DATA_FLAG_NONE;
+		std::unordered_map<IShader*, SerializedObject<IShader>> m_SerializedShaders;
+		std::unordered_map<IRenderPass*, SerializedObject<IRenderPass>> m_SerializedRenderPasses;
+
+		RenderStateArchiveStats m_Stats = {};
+	};
+
+} // namespace shz
@@ -0,0 +1,123 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+
+#include "Engine/RHI/Interface/IRenderDevice.h"
+#include "Engine/RHI/Interface/IShader.h"
+#include "Engine/RHI/Public/ShaderBase.hpp"
+
+#include "Engine/GraphicsTools/Public/BytecodeCache.h"
+#include "Engine/GraphicsTools/Public/RenderStateArchive.h"
+#include "Engine/GraphicsTools/Public/ShaderPreprocessCache.h"
+
+namespace shz
+{
+	struct ShaderBytecodeCacheStats final
+	{
+		// Shaders unpacked from the render state archive.
+		uint32 ArchiveHits = 0;
+
+		// Shaders created from cached bytecode.
+		uint32 Hits = 0;
+
+		// Shaders compiled from source (and added to the cache).
+		uint32 Misses = 0;
+
+		// Misses handed to the device compilation thread pool.
+		uint32 AsyncMisses = 0;
+
+		// Time spent in CreateShader() for hits / misses.
+		double HitMilliseconds = 0.0;
+		double MissMilliseconds = 0.0;
+
+		// Time ResolvePending() spent waiting for asynchronous compiles.
+		double ResolveMilliseconds = 0.0;
+	};
+
+	// ------------------------------------------------------------
+	// ShaderBytecodeCache
+	// - Persistent front end for IBytecodeCache.
+	// - The key is the XXH128 hash of the ShaderCreateInfo, which covers
+	//   the source of the shader file and every file it includes, the
+	//   macros, entry point and compile flags. Editing any included
+	//   header therefore produces a miss.
+	// - Hits create the shader from bytecode; reflection (including
+	//   constant buffer reflection) is rebuilt from the bytecode.
+	// - The file is only rewritten by Save() when new bytecode was added.
+	// - With asyncCompile, misses are compiled on the device shader
+	//   compilation thread pool (one DXC instance per task). CreateShader()
+	//   then returns a shader that may still be SHADER_STATUS_COMPILING;
+	//   its bytecode is added to the cache by ResolvePending().
+	// - With a render state archive, shaders are unpacked from it first;
+	//   while the archive is cooking, every created shader is added to it.
+	// - With a preprocess cache, shaders read through its factory are
+	//   created from their expanded unit: the key hashes one in-memory
+	//   string and DXC resolves no includes.
+	// ------------------------------------------------------------
+	class ShaderBytecodeCache final
+	{
+	public:
+		ShaderBytecodeCache() = default;
+		ShaderBytecodeCache(const ShaderBytecodeCache&) = delete;
+		ShaderBytecodeCache& operator=(const ShaderBytecodeCache&) = delete;
+		~ShaderBytecodeCache() = default;
+
+		// filePath may be empty: the cache is then kept in memory only.
+		// A missing or incompatible file is not an error (cold start).
+		void Initialize(RENDER_DEVICE_TYPE deviceType, const std::string& filePath, bool asyncCompile = false);
+
+		// Writes the cache file if anything was added since Initialize()/Save().
+		// Waits for pending asynchronous compiles first.
+		bool Save();
+
+		// Waits for every asynchronous compile started by CreateShader() and
+		// adds the successfully compiled bytecode to the cache.
+		void ResolvePending();
+
+		void Shutdown();
+
+		// The archive is not owned and must outlive the cache (or be reset to null).
+		void SetRenderStateArchive(RenderStateArchive* pArchive) noexcept { m_pArchive = pArchive; }
+
+		// Not owned either; must outlive the cache (or be reset to null).
+		void SetPreprocessCache(ShaderPreprocessCache* pPreprocess) noexcept { m_pPreprocess = pPreprocess; }
+
+		// Drop-in replacement for IRenderDevice::CreateShader().
+		// ShaderCI must describe the shader by Source or FilePath (not ByteCode).
+		void CreateShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+
+		bool IsInitialized() const noexcept { return m_pCache != nullptr; }
+		bool IsAsyncCompile() const noexcept { return m_bAsyncCompile; }
+		uint32 GetPendingCount() const noexcept { return static_cast<uint32>(m_Pending.size()); }
+		const std::string& GetFilePath() const noexcept { return m_FilePath; }
+		const ShaderBytecodeCacheStats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		// The create info is kept as GetBytecode() saw it (expanded source or
+		// FilePath) so the cache key matches the one used for the miss.
+		struct PendingShader final
+		{
+			ShaderCreateInfoWrapper CreateInfo;
+			RefCntAutoPtr<IShader> pShader;
+		};
+
+		void createArchivedShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+		void createShader(IRenderDevice* pDevice, const ShaderCreateInfo& ShaderCI, IShader** ppShader);
+		void addBytecode(const ShaderCreateInfo& ShaderCI, IShader* pShader);
+
+	private:
+		RefCntAutoPtr<IBytecodeCache> m_pCache;
+		std::string m_FilePath = {};
+		std::vector<PendingShader> m_Pending = {};
+		RenderStateArchive* m_pArchive = nullptr;
+		ShaderPreprocessCache* m_pPreprocess = nullptr;
+
+		bool m_bAsyncCompile = false;
+		bool m_bDirty = false;
+		ShaderBytecodeCacheStats m_Stats = {};
+	};
+
+} // namespace shz
@@ -0,0 +1,89 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Primitives/BasicTypes.h"
+#include "Primitives/DataBlob.h"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+
+#include "Engine/RHI/Interface/IShader.h"
+
+namespace shz
+{
+	struct ShaderPreprocessCacheStats final
+	{
+		// Source files read through the wrapped factory (first use or after a change).
+		uint32 FileReads = 0;
+
+		// Requests served from memory.
+		uint32 CachedReads = 0;
+
+		// Files whose content changed, over all Refresh()/Invalidate() calls.
+		uint32 ChangedFiles = 0;
+
+		// GetExpandedSource() calls served from a cached unit, and units built.
+		uint32 UnitHits = 0;
+		uint32 UnitBuilds = 0;
+	};
+
+	// ------------------------------------------------------------
+	// ShaderPreprocessCache
+	// - Wraps a shader source factory. Every file is read and scanned
+	//   for #include directives once; later requests are served from
+	//   memory.
+	// - Quoted includes are looked up next to the including file first,
+	//   then by the name as written (the wrapped factory's search paths).
+	// - GetExpandedSource() returns the shader file with its includes
+	//   expanded in place, cached by the hash of its include closure.
+	//   ShaderBytecodeCache compiles from it, so the bytecode cache key
+	//   and DXC both read one in-memory unit instead of walking includes.
+	// - Records the include graph and a content hash per file.
+	//   Refresh() re-reads the cached files, and reports the changed ones
+	//   plus every file that transitively includes them. Only the shaders
+	//   on that list need to be recompiled.
+	// - The factory is thread safe, so asynchronous compiles may share it.
+	// ------------------------------------------------------------
+	class ShaderPreprocessCache final
+	{
+	public:
+		ShaderPreprocessCache();
+		ShaderPreprocessCache(const ShaderPreprocessCache&) = delete;
+		ShaderPreprocessCache& operator=(const ShaderPreprocessCache&) = delete;
+		~ShaderPreprocessCache();
+
+		void Initialize(IShaderSourceInputStreamFactory* pSourceFactory);
+		void Shutdown();
+
+		bool IsInitialized() const noexcept;
+
+		// Pass this wherever a IShaderSourceInputStreamFactory is expected.
+		IShaderSourceInputStreamFactory* GetFactory() const noexcept;
+
+		// Re-reads every cached file and updates the ones whose content changed.
+		// Returns the changed files and all of their (transitive) includers.
+		std::vector<std::string> Refresh();
+
+		// Same as Refresh(), limited to one file (e.g. reported by a file watcher).
+		std::vector<std::string> Invalidate(const std::string& filePath);
+
+		// filePath plus every cached file that includes it, directly or not.
+		std::vector<std::string> GetDependents(const std::string& filePath) const;
+
+		// Files included directly by filePath (empty if it was never read).
+		std::vector<std::string> GetIncludes(const std::string& filePath) const;
+
+		// ShaderCI.FilePath with every include expanded in place, each file once
+		// (in the order UnrollShaderIncludes() uses). HLSL units carry #line
+		// directives so compiler messages name the original files.
+		// Null if ShaderCI has no FilePath or a file of the closure cannot be read.
+		RefCntAutoPtr<IDataBlob> GetExpandedSource(const ShaderCreateInfo& ShaderCI);
+
+		ShaderPreprocessCacheStats GetStats() const;
+
+	private:
+		class CachingSourceFactory;
+
+		RefCntAutoPtr<CachingSourceFactory> m_pFactory;
+	};
+
+} // namespace shz
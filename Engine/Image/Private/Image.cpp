@@ -45,6 +45,7 @@
 
 #include "Engine/Core/Common/Public/Errors.hpp"
 #include "Engine/Core/Memory/Public/DataBlobImpl.hpp"
+#include "Engine/Core/Memory/Public/EngineMemory.h"
 #include "Engine/Core/Common/Public/ProxyDataBlob.hpp"
 #include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
 #include "Engine/Core/Common/Public/BasicFileStream.hpp"
@@ -447,7 +448,7 @@ namespace shz
 
 	Image::Image(IReferenceCounters* pRefCounters, const void* pSrcData, size_t SrcDataSize, const ImageLoadInfo& LoadInfo)
 		: TBase{ pRefCounters }
-		, m_pData{ DataBlobImpl::Create(LoadInfo.pAllocator) }
+		, m_pData{ DataBlobImpl::Create(LoadInfo.pAllocator != nullptr ? LoadInfo.pAllocator : &GetTaggedAllocator(EMemoryTag::Image)) }
 	{
 		if (!Load(LoadInfo.Format, pSrcData, SrcDataSize, m_pData, m_Desc))
 		{
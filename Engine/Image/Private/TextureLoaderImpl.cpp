@@ -42,6 +42,7 @@
 #include "Engine/Image/Public/Image.h"
 #include "Engine/Core/Common/Public/FileWrapper.hpp"
 #include "Engine/Core/Memory/Public/DataBlobImpl.hpp"
+#include "Engine/Core/Memory/Public/EngineMemory.h"
 #include "Primitives/Align.hpp"
 
 #define STB_DXT_STATIC
@@ -50,6 +51,12 @@
 
 namespace shz
 {
+	// Pixel data without a user allocator is accounted under EMemoryTag::Image.
+	static IMemoryAllocator* GetImageDataAllocator(IMemoryAllocator* pAllocator)
+	{
+		return pAllocator != nullptr ? pAllocator : &GetTaggedAllocator(EMemoryTag::Image);
+	}
+
 	static TextureDesc TexDescFromTexLoadInfo(const TextureLoadInfo& TexLoadInfo, const std::string& Name)
 	{
 		TextureDesc TexDesc;
@@ -188,7 +195,7 @@ namespace shz
 		{
 			uint32 DstStride = ImgDesc.Width * NumComponents * TexFmtDesc.ComponentSize;
 			DstStride = AlignUp(DstStride, uint32{ 4 });
-			m_Mips[0] = DataBlobImpl::Create(TexLoadInfo.pAllocator, size_t{ DstStride } *size_t{ ImgDesc.Height });
+			m_Mips[0] = DataBlobImpl::Create(GetImageDataAllocator(TexLoadInfo.pAllocator), size_t{ DstStride } *size_t{ ImgDesc.Height });
 			m_SubResources[0].pData = m_Mips[0]->GetDataPtr();
 			m_SubResources[0].Stride = DstStride;
 
@@ -259,7 +266,7 @@ namespace shz
 				RowSize = AlignUp(RowSize, uint64{ 4 });
 				MipSize = RowSize * MipLevelProps.LogicalHeight;
 			}
-			m_Mips[m] = DataBlobImpl::Create(TexLoadInfo.pAllocator, StaticCast<size_t>(MipSize));
+			m_Mips[m] = DataBlobImpl::Create(GetImageDataAllocator(TexLoadInfo.pAllocator), StaticCast<size_t>(MipSize));
 			m_SubResources[m].pData = m_Mips[m]->GetDataPtr();
 			m_SubResources[m].Stride = RowSize;
 
@@ -337,7 +344,7 @@ namespace shz
 				const uint32             MaxCol = CompressedMipProps.LogicalWidth - 1;
 				const uint32             MaxRow = CompressedMipProps.LogicalHeight - 1;
 				const size_t             CompressedStride = static_cast<size_t>(CompressedMipProps.RowSize);
-				CompressedMip = DataBlobImpl::Create(TexLoadInfo.pAllocator, CompressedStride * CompressedMipProps.StorageHeight);
+				CompressedMip = DataBlobImpl::Create(GetImageDataAllocator(TexLoadInfo.pAllocator), CompressedStride * CompressedMipProps.StorageHeight);
 
 				for (uint32 row = 0; row < CompressedMipProps.StorageHeight; row += FmtAttribs.BlockHeight)
 				{
@@ -423,7 +430,7 @@ namespace shz
 			if (!File)
 				LOG_ERROR_AND_THROW("Failed to open file '", FilePath, "'.");
 
-			RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create(TexLoadInfo.pAllocator);
+			RefCntAutoPtr<DataBlobImpl> pFileData = DataBlobImpl::Create(GetImageDataAllocator(TexLoadInfo.pAllocator));
 			File->Read(pFileData);
 
 			RefCntAutoPtr<TextureLoaderImpl> pTexLoader{
@@ -451,7 +458,7 @@ namespace shz
 			RefCntAutoPtr<IDataBlob> pDataCopy;
 			if (MakeDataCopy)
 			{
-				pDataCopy = DataBlobImpl::Create(TexLoadInfo.pAllocator, Size, pData);
+				pDataCopy = DataBlobImpl::Create(GetImageDataAllocator(TexLoadInfo.pAllocator), Size, pData);
 				pData = pDataCopy->GetConstDataPtr();
 			}
 			RefCntAutoPtr<ITextureLoader> pTexLoader{ MakeNewRCObj<TextureLoaderImpl>()(TexLoadInfo, reinterpret_cast<const uint8*>(pData), Size, std::move(pDataCopy)) };
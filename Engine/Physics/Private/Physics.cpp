@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Engine/Physics/Public/Physics.h"
 #include "Engine/Physics/Public/PhysicsEvent.h"
+#include "Engine/Core/Memory/Public/TaggedMemoryAllocator.hpp"
 
 namespace shz
 {
@@ -58,6 +59,17 @@ namespace shz
 		return float3{ rollX, pitchY, yawZ };
 	}
 
+	static inline float heightFieldSample(const Physics::HeightFieldCreateInfo& ci, size_t idx)
+	{
+		if (ci.pHeightsU16)
+		{
+			const float n = static_cast<float>(ci.pHeightsU16[idx]) * (1.0f / 65535.0f);
+			return ci.HeightOffset + n * ci.HeightScale;
+		}
+
+		return ci.pHeights[idx] * ci.HeightScale + ci.HeightOffset;
+	}
+
 	static inline JPH::EMotionType toJPHMotionType(ERigidbodyType t)
 	{
 		switch (t)
@@ -75,6 +87,46 @@ namespace shz
 		return static_cast<JPH::ObjectLayer>(layer);
 	}
 
+	// ------------------------------------------------------------------------
+	// Jolt allocation hooks
+	// - Every Jolt heap block (bodies, shapes, broadphase, the temp allocator
+	//   buffer) goes through the Physics-tagged allocator.
+	// - Installed once and never removed: Jolt may free blocks after Shutdown.
+	// ------------------------------------------------------------------------
+	static void* joltAllocate(size_t size)
+	{
+		return TaggedMemoryAllocator::GetAllocator(EMemoryTag::Physics).Allocate(size, "Jolt", __FILE__, __LINE__);
+	}
+
+	static void* joltReallocate(void* pBlock, size_t /*oldSize*/, size_t newSize)
+	{
+		return TaggedMemoryAllocator::GetAllocator(EMemoryTag::Physics).Reallocate(pBlock, newSize, "Jolt", __FILE__, __LINE__);
+	}
+
+	static void joltFree(void* pBlock)
+	{
+		TaggedMemoryAllocator::GetAllocator(EMemoryTag::Physics).Free(pBlock);
+	}
+
+	static void* joltAlignedAllocate(size_t size, size_t alignment)
+	{
+		return TaggedMemoryAllocator::GetAllocator(EMemoryTag::Physics).AllocateAligned(size, alignment, "Jolt", __FILE__, __LINE__);
+	}
+
+	static void joltAlignedFree(void* pBlock)
+	{
+		TaggedMemoryAllocator::GetAllocator(EMemoryTag::Physics).FreeAligned(pBlock);
+	}
+
+	static void installJoltAllocationHooks()
+	{
+		JPH::Allocate = joltAllocate;
+		JPH::Reallocate = joltReallocate;
+		JPH::Free = joltFree;
+		JPH::AlignedAllocate = joltAlignedAllocate;
+		JPH::AlignedFree = joltAlignedFree;
+	}
+
 	// ------------------------------------------------------------------------
 	// Layers / filters (2-layer setup)
 	// ------------------------------------------------------------------------
@@ -181,6 +233,10 @@ namespace shz
 		uint64 NextShapeId = 1;
 		std::unordered_map<uint64, JPH::RefConst<JPH::Shape>> Shapes = {};
 
+		// Height fields are patched in place (UpdateHeightFieldShape), so they are also
+		// kept mutable from creation. Same handles as Shapes.
+		std::unordered_map<uint64, JPH::Ref<JPH::HeightFieldShape>> HeightFieldShapes = {};
+
 		// Contact
 		std::mutex ContactMutex = {};
 		std::vector<ContactEvent> ContactEvents = {}; // step  
@@ -226,6 +282,21 @@ namespace shz
 			return out;
 		}
 
+		PhysicsShapeHandle StoreHeightFieldShape(JPH::Ref<JPH::HeightFieldShape> shape)
+		{
+			ASSERT(shape, "Shape is null.");
+
+			std::scoped_lock lock(ShapeMutex);
+
+			const uint64 id = NextShapeId++;
+			Shapes.emplace(id, shape.GetPtr());
+			HeightFieldShapes.emplace(id, std::move(shape));
+
+			PhysicsShapeHandle out = {};
+			out.Value = id;
+			return out;
+		}
+
 		JPH::RefConst<JPH::Shape> GetShape(PhysicsShapeHandle h) const
 		{
 			ASSERT(h.IsValid(), "Invalid handle");
@@ -246,6 +317,7 @@ namespace shz
 
 			std::scoped_lock lock(ShapeMutex);
 			Shapes.erase(h.Value);
+			HeightFieldShapes.erase(h.Value);
 		}
 		
 		class ContactListenerImpl final : public JPH::ContactListener
@@ -347,7 +419,7 @@ namespace shz
 		}
 
 		// Jolt global init
-		JPH::RegisterDefaultAllocator();
+		installJoltAllocationHooks();
 		JPH::Factory::sInstance = new JPH::Factory();
 		JPH::RegisterTypes();
 
@@ -404,6 +476,7 @@ namespace shz
 			// Still, clear shape table.
 			std::scoped_lock lock(I.ShapeMutex);
 			I.Shapes.clear();
+			I.HeightFieldShapes.clear();
 		}
 
 		delete I.pJobSystem;
@@ -481,47 +554,102 @@ namespace shz
 
 		Impl& I = *m_pImpl;
 
-		ASSERT(ci.pHeights && ci.Width > 1 && ci.Height > 2, "Invalid height params.");
+		ASSERT((ci.pHeights != nullptr) != (ci.pHeightsU16 != nullptr), "Exactly one of pHeights / pHeightsU16 must be set.");
+		ASSERT(ci.Width > 1 && ci.Height > 2, "Invalid height params.");
 
-		// Jolt expects samples in float array. We'll bake scale/offset into sample values here.
+		// World-space scale for XZ cell sizes. Heights are baked below.
+		JPH::HeightFieldShapeSettings settings;
+		settings.mOffset = JPH::Vec3(0, 0, 0);
+		settings.mScale = JPH::Vec3(ci.CellSizeX, 1.0f, ci.CellSizeZ);
+		settings.mSampleCount = ci.Width;
+
+		// Jolt only takes float input, so bake scale/offset straight into the settings array
+		// (the only transient copy; the shape compresses it on Create).
 		// Layout: row-major, x changes fastest.
-		std::vector<float> samples;
-		samples.resize(static_cast<size_t>(ci.Width) * static_cast<size_t>(ci.Height));
+		const size_t sampleCount = static_cast<size_t>(ci.Width) * static_cast<size_t>(ci.Height);
+		settings.mHeightSamples.resize(sampleCount);
+
+		for (size_t idx = 0; idx < sampleCount; ++idx)
+		{
+			settings.mHeightSamples[idx] = heightFieldSample(ci, idx);
+		}
+
+		JPH::ShapeSettings::ShapeResult res = settings.Create();
+		if (res.HasError())
+		{
+			ASSERT(false, "Shape creation failed.\nERROR MESSAGE : %s", res.GetError().c_str());
+			return {};
+		}
+
+		return I.StoreHeightFieldShape(static_cast<JPH::HeightFieldShape*>(res.Get().GetPtr()));
+	}
+
+	// HeightFieldShape::SetHeights / GetBlockSize (in-place terrain edits) need Jolt 5.0 or later.
+	static_assert(JPH_VERSION_MAJOR >= 5, "UpdateHeightFieldShape requires Jolt 5.0+.");
+
+	bool Physics::UpdateHeightFieldShape(PhysicsShapeHandle shape, const HeightFieldCreateInfo& ci, uint32 x, uint32 z, uint32 sizeX, uint32 sizeZ)
+	{
+		ASSERT(m_pImpl && m_pImpl->bInitialized, "Physics not initialized.");
+
+		Impl& I = *m_pImpl;
+
+		ASSERT((ci.pHeights != nullptr) != (ci.pHeightsU16 != nullptr), "Exactly one of pHeights / pHeightsU16 must be set.");
+		ASSERT(ci.Width > 1 && ci.Height > 1, "Invalid height params.");
 
-		for (uint32 z = 0; z < ci.Height; ++z)
+		if (sizeX == 0 || sizeZ == 0)
 		{
-			for (uint32 x = 0; x < ci.Width; ++x)
+			return true;
+		}
+
+		JPH::Ref<JPH::HeightFieldShape> pHF = nullptr;
+		{
+			std::scoped_lock lock(I.ShapeMutex);
+			auto it = I.HeightFieldShapes.find(shape.Value);
+			if (it != I.HeightFieldShapes.end())
 			{
-				const size_t idx = static_cast<size_t>(z) * ci.Width + x;
-				float h = ci.pHeights[idx];
-				h = h * ci.HeightScale + ci.HeightOffset;
-				samples[idx] = h;
+				pHF = it->second;
 			}
 		}
 
-		// World-space scale for XZ cell sizes. Heights are already baked above.
-		const JPH::Vec3 offset = JPH::Vec3(0, 0, 0);
-		const JPH::Vec3 scale = JPH::Vec3(ci.CellSizeX, 1.0f, ci.CellSizeZ);
-		const uint32 numSamples = ci.Width;
+		if (!pHF)
+		{
+			ASSERT(false, "Shape is not a height field created by CreateHeightFieldShape.");
+			return false;
+		}
 
+		// Jolt only rewrites whole blocks
+		const uint32 block = pHF->GetBlockSize();
+		const uint32 sampleCount = pHF->GetSampleCount();
 
-		JPH::HeightFieldShapeSettings settings(
-			samples.data(),
-			offset,
-			scale,
-			numSamples,
-			nullptr,
-			JPH::PhysicsMaterialList());
+		const uint32 bx0 = (x / block) * block;
+		const uint32 bz0 = (z / block) * block;
+		const uint32 bx1 = std::min(((x + sizeX + block - 1) / block) * block, sampleCount);
+		const uint32 bz1 = std::min(((z + sizeZ + block - 1) / block) * block, sampleCount);
 
-		// Keep a copy of samples alive until shape is created
-		JPH::ShapeSettings::ShapeResult res = settings.Create();
-		if (res.HasError())
+		if (bx0 >= bx1 || bz0 >= bz1)
 		{
-			ASSERT(false, "Shape creation failed.\nERROR MESSAGE : %s", res.GetError().c_str());
-			return {};
+			return true;
 		}
 
-		return I.StoreShape(res.Get());
+		const uint32 w = bx1 - bx0;
+		const uint32 h = bz1 - bz0;
+
+		// Same baking as CreateHeightFieldShape. Jolt may pad the grid past the source size;
+		// padded samples repeat the last source row / column.
+		std::vector<float> samples(static_cast<size_t>(w) * h);
+
+		for (uint32 j = 0; j < h; ++j)
+		{
+			const uint32 sz = std::min(bz0 + j, ci.Height - 1);
+			for (uint32 i = 0; i < w; ++i)
+			{
+				const uint32 sx = std::min(bx0 + i, ci.Width - 1);
+				samples[static_cast<size_t>(j) * w + i] = heightFieldSample(ci, static_cast<size_t>(sz) * ci.Width + sx);
+			}
+		}
+
+		pHF->SetHeights(bx0, bz0, w, h, samples.data(), static_cast<intptr_t>(w), *I.pTempAllocator);
+		return true;
 	}
 
 	void Physics::ReleaseShape(PhysicsShapeHandle shape)
@@ -605,6 +733,23 @@ namespace shz
 		BI.DestroyBody(id);
 	}
 
+	void Physics::NotifyShapeChanged(PhysicsBodyHandle body)
+	{
+		ASSERT(m_pImpl && m_pImpl->bInitialized, "Physics not initialized.");
+		ASSERT(body.IsValid(), "Body is invalid.");
+
+		Impl& I = *m_pImpl;
+
+		const JPH::BodyID id = Impl::ToBodyID(body);
+		ASSERT(!id.IsInvalid(), "Invalid BodyID.");
+
+		JPH::BodyInterface& BI = I.BodyIF();
+
+		// Only used for in-place edits that keep the center of mass (height fields report zero)
+		const JPH::Vec3 com = BI.GetShape(id)->GetCenterOfMass();
+		BI.NotifyShapeChanged(id, com, false, JPH::EActivation::DontActivate);
+	}
+
 	void Physics::SetBodyTransform(PhysicsBodyHandle body, const float3& pos, const float3& rotEulerRad, bool bActivate)
 	{
 		ASSERT(m_pImpl && m_pImpl->bInitialized, "Physics not initialized.");
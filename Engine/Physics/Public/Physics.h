@@ -57,7 +57,11 @@ namespace shz
 
 		struct HeightFieldCreateInfo final
 		{
+			// Exactly one source. Float samples map to h * HeightScale + HeightOffset,
+			// uint16 samples to HeightOffset + (v / 65535) * HeightScale (TerrainHeightField encoding).
 			const float* pHeights = nullptr;
+			const uint16* pHeightsU16 = nullptr;
+
 			uint32 Width = 0;
 			uint32 Height = 0;
 
@@ -82,11 +86,19 @@ namespace shz
 		PhysicsShapeHandle CreateBoxShape(const float3& halfExtent);
 		PhysicsShapeHandle CreateSphereShape(float radius);
 		PhysicsShapeHandle CreateHeightFieldShape(const HeightFieldCreateInfo& ci);
+
+		// Re-reads samples [x, x + sizeX) x [z, z + sizeZ) of a height field shape from ci
+		// (the full source grid). The region is widened to the shape's block size.
+		// Bodies using the shape need NotifyShapeChanged afterwards.
+		bool UpdateHeightFieldShape(PhysicsShapeHandle shape, const HeightFieldCreateInfo& ci, uint32 x, uint32 z, uint32 sizeX, uint32 sizeZ);
 		void ReleaseShape(PhysicsShapeHandle shape);
 
 		PhysicsBodyHandle CreateBody(const BodyCreateInfo& ci);
 		void DestroyBody(PhysicsBodyHandle body);
 
+		// Refreshes broad phase bounds after the body's shape was modified in place.
+		void NotifyShapeChanged(PhysicsBodyHandle body);
+
 		void SetBodyTransform(PhysicsBodyHandle body, const float3& pos, const float3& rotEulerRad, bool bActivate);
 		void GetBodyTransform(PhysicsBodyHandle body, float3* outPos, float3* outRotEulerRad) const;
 
@@ -57,6 +57,12 @@ namespace shz
 	struct DearchiverCreateInfo
 	{
 		void* pDummy = nullptr;
+
+		// Archives are opened through the resource index stored in the file: LoadArchive()
+		// only reads the header and the index, and every resource is deserialized the first
+		// time it is unpacked. Use this with memory-mapped archives that hold many more
+		// objects than the application unpacks.
+		bool LazyResourceIndex = false;
 	};
 
 	// Engine factory base interface
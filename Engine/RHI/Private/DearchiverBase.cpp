@@ -28,6 +28,7 @@
 #include "DearchiverBase.hpp"
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "Engine/RHI/Interface/IEngineFactory.h"
 
 namespace shz
 {
@@ -95,6 +96,12 @@ namespace shz
 	} // namespace
 
 
+	DearchiverBase::DearchiverBase(IReferenceCounters* pRefCounters, const DearchiverCreateInfo& CI) noexcept
+		: TObjectBase{ pRefCounters }
+		, m_LazyResourceIndex{ CI.LazyResourceIndex }
+	{
+	}
+
 	DearchiverBase::DeviceType DearchiverBase::GetArchiveDeviceType(const IRenderDevice* pDevice)
 	{
 		ASSERT_EXPR(pDevice != nullptr);
@@ -493,11 +500,11 @@ namespace shz
 		ASSERT_EXPR(ResType != ResourceType::Undefined);
 		ASSERT_EXPR(ResName != nullptr);
 
-		const auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{ ResType, ResName });
-		if (archive_idx_it == m_ResNameToArchiveIdx.end())
+		const size_t ArchiveIdx = FindArchiveIndex(ResType, ResName);
+		if (ArchiveIdx >= m_Archives.size())
 			return nullptr;
 
-		ArchiveData& Archive = m_Archives[archive_idx_it->second];
+		ArchiveData& Archive = m_Archives[ArchiveIdx];
 		if (!Archive.pObjArchive)
 		{
 			ASSERT(false, "Null object archives should never be added to the list. This is a bug.");
@@ -507,6 +514,24 @@ namespace shz
 		return &Archive;
 	}
 
+	size_t DearchiverBase::FindArchiveIndex(ResourceType ResType, const char* ResName) const
+	{
+		if (!m_LazyResourceIndex)
+		{
+			const auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{ ResType, ResName });
+			return archive_idx_it != m_ResNameToArchiveIdx.end() ? archive_idx_it->second : m_Archives.size();
+		}
+
+		// Same precedence as m_ResNameToArchiveIdx: the first loaded archive wins.
+		for (size_t i = 0; i < m_Archives.size(); ++i)
+		{
+			if (m_Archives[i].pObjArchive && m_Archives[i].pObjArchive->HasResource(ResType, ResName))
+				return i;
+		}
+
+		return m_Archives.size();
+	}
+
 	template <typename PSOCreateInfoType>
 	static bool ModifyPipelineStateCreateInfo(PSOCreateInfoType& CreateInfo, const PipelineStateUnpackInfo& UnpackInfo)
 	{
@@ -664,9 +689,16 @@ namespace shz
 		}
 
 		std::unique_ptr<DeviceObjectArchive> pObjArchive = std::make_unique<DeviceObjectArchive>();
-		if (!pObjArchive->Deserialize(DeviceObjectArchive::CreateInfo{ pArchiveData, ContentVersion, MakeCopy }))
+		if (!pObjArchive->Deserialize(DeviceObjectArchive::CreateInfo{ pArchiveData, ContentVersion, MakeCopy, m_LazyResourceIndex }))
 			return false;
 
+		if (m_LazyResourceIndex)
+		{
+			// Resources are looked up in the archive index on first use (see FindArchiveIndex).
+			m_Archives.emplace_back(std::move(pObjArchive));
+			return true;
+		}
+
 		const size_t ArchiveIdx = m_Archives.size();
 
 		const auto& ArchiveResources = pObjArchive->GetNamedResources();
@@ -28,6 +28,7 @@
 #include "DeviceObjectArchive.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "Engine/RHI/Interface/IShader.h"
@@ -145,6 +146,53 @@ namespace shz
 			return true;
 		}
 
+		// FNV-1a; stored in the archive, so it must not depend on the platform.
+		uint32 HashResourceName(const char* Name)
+		{
+			uint32 Hash = 2166136261u;
+			for (const char* c = Name; c != nullptr && *c != '\0'; ++c)
+			{
+				Hash ^= static_cast<uint8>(*c);
+				Hash *= 16777619u;
+			}
+			return Hash;
+		}
+
+		// Reads the type and the name of the indexed resource and, if pResData is not null, its data.
+		bool ReadIndexedResource(const IDataBlob&                               ArchiveData,
+			const DeviceObjectArchive::ResourceIndexEntry& Entry,
+			DeviceObjectArchive::ResourceType&             Type,
+			const char*&                                   Name,
+			DeviceObjectArchive::ResourceData*             pResData)
+		{
+			const size_t ArchiveSize = ArchiveData.GetSize();
+			if (Entry.Offset > ArchiveSize || Entry.Size > ArchiveSize - Entry.Offset)
+				return false;
+
+			const uint8* pBytes = static_cast<const uint8*>(ArchiveData.GetConstDataPtr()) + Entry.Offset;
+
+			Serializer<SerializerMode::Read> Reader{ SerializedData{ const_cast<uint8*>(pBytes), static_cast<size_t>(Entry.Size) } };
+			if (!Reader(Type, Name) || Type != Entry.Type)
+				return false;
+
+			if (pResData == nullptr)
+				return true;
+
+			return ArchiveSerializer<SerializerMode::Read>{ Reader }.SerializeResourceData(*pResData);
+		}
+
+		bool ReadShaders(const SerializedData& ShaderData, std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceObjectArchive::DeviceType::Count)>& DeviceShaders)
+		{
+			Serializer<SerializerMode::Read> Reader{ ShaderData };
+			ArchiveSerializer<SerializerMode::Read> ArchiveReader{ Reader };
+			for (std::vector<SerializedData>& Shaders : DeviceShaders)
+			{
+				if (!ArchiveReader.SerializeShaders(Shaders))
+					return false;
+			}
+			return true;
+		}
+
 	} // namespace
 
 	DeviceObjectArchive::DeviceObjectArchive(uint32 ContentVersion) noexcept
@@ -156,6 +204,12 @@ namespace shz
 	{
 		m_NamedResources.clear();
 		m_DeviceShaders = {};
+		m_pIndex = nullptr;
+		m_NumIndexEntries = 0;
+		m_ShaderData = {};
+		m_LazyIndex = false;
+		m_AllResourcesLoaded = true;
+		m_ShadersLoaded = true;
 		m_pArchiveData.Release();
 		m_ContentVersion = 0;
 	}
@@ -180,10 +234,13 @@ namespace shz
 
 		m_pArchiveData = CI.MakeCopy ? DataBlobImpl::MakeCopy(CI.pData) : const_cast<IDataBlob*>(CI.pData); // Need to remove const for AddRef/Release
 
+		const size_t ArchiveSize = m_pArchiveData->GetSize();
+		uint8* const pArchiveBytes = static_cast<uint8*>(const_cast<void*>(m_pArchiveData->GetConstDataPtr()));
+
 		Serializer<SerializerMode::Read> Reader{
 			SerializedData{
-				const_cast<void*>(CI.pData->GetConstDataPtr()),
-				CI.pData->GetSize(),
+				pArchiveBytes,
+				ArchiveSize,
 			},
 		};
 		ArchiveSerializer<SerializerMode::Read> ArchiveReader{ Reader };
@@ -209,30 +266,133 @@ namespace shz
 
 		CHECK_ARCHIVE(ArchiveReader.Ser(Header.GitHash), "Failed to read Git Hash.");
 
-		uint32 NumResources = 0;
-		CHECK_ARCHIVE(Reader(NumResources), "Failed to read the number of named resources in the device object archive.");
+		// NB: this must match resource index serialization in DeviceObjectArchive::Serialize
+		uint64 ShaderDataOffset = 0;
+		uint64 ShaderDataSize = 0;
+		CHECK_ARCHIVE(Reader(ShaderDataOffset, ShaderDataSize), "Failed to read the location of the shader data.");
+		CHECK_ARCHIVE(ShaderDataOffset <= ArchiveSize && ShaderDataSize <= ArchiveSize - ShaderDataOffset, "Shader data is out of the archive bounds.");
+		m_ShaderData = SerializedData{ pArchiveBytes + ShaderDataOffset, static_cast<size_t>(ShaderDataSize) };
+
+		const void* pIndexData = nullptr;
+		size_t      IndexSize = 0;
+		CHECK_ARCHIVE(Reader.SerializeBytes(pIndexData, IndexSize, alignof(ResourceIndexEntry)), "Failed to read the resource index.");
+		CHECK_ARCHIVE(IndexSize % sizeof(ResourceIndexEntry) == 0, "Invalid resource index size: ", IndexSize, '.');
+		CHECK_ARCHIVE(reinterpret_cast<size_t>(pIndexData) % alignof(ResourceIndexEntry) == 0, "Resource index is not properly aligned.");
+		m_pIndex = static_cast<const ResourceIndexEntry*>(pIndexData);
+		m_NumIndexEntries = static_cast<uint32>(IndexSize / sizeof(ResourceIndexEntry));
+
+		if (CI.LazyIndex)
+		{
+			m_LazyIndex = true;
+			m_AllResourcesLoaded = false;
+			m_ShadersLoaded = false;
+			return true;
+		}
 
-		for (uint32 res = 0; res < NumResources; ++res)
+		for (uint32 res = 0; res < m_NumIndexEntries; ++res)
 		{
-			const char* Name = nullptr;
-			ResourceType ResType = ResourceType::Undefined;
-			CHECK_ARCHIVE(Reader(ResType, Name), "Failed to read the type and name of resource ", res, "/", NumResources, '.');
-			ASSERT_EXPR(Name != nullptr);
+			CHECK_ARCHIVE(LoadIndexedResource(m_pIndex[res]) != nullptr, "Failed to read resource ", res, "/", m_NumIndexEntries, '.');
+		}
 
-			// No need to make the name copy as we keep the source data blob alive.
-			constexpr bool MakeNameCopy = false;
-			ResourceData& ResData = m_NamedResources[NamedResourceKey{ ResType, Name, MakeNameCopy }];
+		CHECK_ARCHIVE(ReadShaders(m_ShaderData, m_DeviceShaders), "Failed to read shader data from the device object archive.");
+#undef CHECK_ARCHIVE
+
+		return true;
+	}
+
+	const DeviceObjectArchive::ResourceIndexEntry* DeviceObjectArchive::FindIndexEntry(ResourceType Type, const char* Name) const noexcept
+	{
+		const uint32 NameHash = HashResourceName(Name);
+
+		const ResourceIndexEntry* const pEnd = m_pIndex + m_NumIndexEntries;
+		const ResourceIndexEntry* pEntry = std::lower_bound(m_pIndex, pEnd, std::make_pair(Type, NameHash),
+			[](const ResourceIndexEntry& Entry, const std::pair<ResourceType, uint32>& Key) {
+				return Entry.Type != Key.first ? Entry.Type < Key.first : Entry.NameHash < Key.second;
+			});
 
-			CHECK_ARCHIVE(ArchiveReader.SerializeResourceData(ResData), "Failed to read data of resource '", Name, "'.");
+		// Only the names of the resources that share the hash are read.
+		for (; pEntry != pEnd && pEntry->Type == Type && pEntry->NameHash == NameHash; ++pEntry)
+		{
+			ResourceType EntryType = ResourceType::Undefined;
+			const char*  EntryName = nullptr;
+			if (ReadIndexedResource(*m_pArchiveData, *pEntry, EntryType, EntryName, nullptr) &&
+				std::strcmp(EntryName, Name != nullptr ? Name : "") == 0)
+				return pEntry;
 		}
 
-		for (std::vector<SerializedData>& Shaders : m_DeviceShaders)
+		return nullptr;
+	}
+
+	const DeviceObjectArchive::NamedResourceMap::value_type* DeviceObjectArchive::LoadIndexedResource(const ResourceIndexEntry& Entry) const noexcept
+	{
+		ResourceType ResType = ResourceType::Undefined;
+		const char*  Name = nullptr;
+		ResourceData ResData;
+		if (!ReadIndexedResource(*m_pArchiveData, Entry, ResType, Name, &ResData))
 		{
-			CHECK_ARCHIVE(ArchiveReader.SerializeShaders(Shaders), "Failed to read shader data from the device object archive.");
+			LOG_ERROR_MESSAGE("Failed to read resource data at offset ", Entry.Offset, ". Archive file may be corrupted or invalid.");
+			return nullptr;
 		}
-#undef CHECK_ARCHIVE
+		ASSERT_EXPR(Name != nullptr);
 
-		return true;
+		// No need to make the name copy as we keep the source data blob alive.
+		constexpr bool MakeNameCopy = false;
+		auto it_inserted = m_NamedResources.emplace(NamedResourceKey{ ResType, Name, MakeNameCopy }, std::move(ResData));
+		return &*it_inserted.first;
+	}
+
+	const DeviceObjectArchive::NamedResourceMap::value_type* DeviceObjectArchive::FindResource(ResourceType Type, const char* Name) const noexcept
+	{
+		if (!m_LazyIndex)
+		{
+			auto it = m_NamedResources.find(NamedResourceKey{ Type, Name });
+			return it != m_NamedResources.end() ? &*it : nullptr;
+		}
+
+		std::lock_guard<std::mutex> Lock{ m_LazyMtx };
+
+		auto it = m_NamedResources.find(NamedResourceKey{ Type, Name });
+		if (it != m_NamedResources.end())
+			return &*it;
+
+		if (m_AllResourcesLoaded)
+			return nullptr;
+
+		const ResourceIndexEntry* pEntry = FindIndexEntry(Type, Name);
+		return pEntry != nullptr ? LoadIndexedResource(*pEntry) : nullptr;
+	}
+
+	void DeviceObjectArchive::LoadAllResources() const noexcept
+	{
+		if (!m_LazyIndex)
+			return;
+
+		std::lock_guard<std::mutex> Lock{ m_LazyMtx };
+		if (m_AllResourcesLoaded)
+			return;
+
+		for (uint32 res = 0; res < m_NumIndexEntries; ++res)
+			LoadIndexedResource(m_pIndex[res]);
+
+		m_AllResourcesLoaded = true;
+	}
+
+	void DeviceObjectArchive::LoadShaders() const noexcept
+	{
+		if (!m_LazyIndex)
+			return;
+
+		std::lock_guard<std::mutex> Lock{ m_LazyMtx };
+		if (m_ShadersLoaded)
+			return;
+
+		if (!ReadShaders(m_ShaderData, m_DeviceShaders))
+		{
+			LOG_ERROR_MESSAGE("Failed to read shader data from the device object archive.");
+			m_DeviceShaders = {};
+		}
+
+		m_ShadersLoaded = true;
 	}
 
 	void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
@@ -244,7 +404,75 @@ namespace shz
 		}
 		ASSERT(*ppDataBlob == nullptr, "Data blob object must be null");
 
-		auto SerializeThis = [this](auto& Ser) {
+		LoadAllResources();
+		LoadShaders();
+
+		IMemoryAllocator& Allocator = GetRawAllocator();
+
+		// Serializes Func into a standalone chunk, so that it can later be read from its offset alone.
+		auto SerializeChunk = [&Allocator](const auto& Func) {
+			Serializer<SerializerMode::Measure> Measurer;
+			Func(Measurer);
+
+			SerializedData Chunk = Measurer.AllocateData(Allocator);
+
+			Serializer<SerializerMode::Write> Writer{ Chunk };
+			Func(Writer);
+			ASSERT_EXPR(Writer.IsEnded());
+			return Chunk;
+		};
+
+		struct IndexedResource
+		{
+			ResourceIndexEntry Entry;
+			const char*        Name = nullptr;
+			SerializedData     Data;
+		};
+
+		std::vector<IndexedResource> Resources;
+		Resources.reserve(m_NamedResources.size());
+		for (const auto& res_it : m_NamedResources)
+		{
+			IndexedResource& Res = Resources.emplace_back();
+			Res.Name = res_it.first.GetName();
+			Res.Entry.Type = res_it.first.GetType();
+			Res.Entry.NameHash = HashResourceName(Res.Name);
+			Res.Data = SerializeChunk([&](auto& Ser) {
+				constexpr auto SerMode = std::remove_reference<decltype(Ser)>::type::GetMode();
+
+				auto res = Ser(Res.Entry.Type, Res.Name);
+				ASSERT(res, "Failed to serialize resource type and name");
+
+				res = ArchiveSerializer<SerMode>{ Ser }.SerializeResourceData(res_it.second);
+				ASSERT(res, "Failed to serialize resource data");
+			});
+			Res.Entry.Size = Res.Data.Size();
+		}
+
+		// The index is searched by type and name hash (see FindIndexEntry).
+		std::sort(Resources.begin(), Resources.end(), [](const IndexedResource& lhs, const IndexedResource& rhs) {
+			if (lhs.Entry.Type != rhs.Entry.Type)
+				return lhs.Entry.Type < rhs.Entry.Type;
+			if (lhs.Entry.NameHash != rhs.Entry.NameHash)
+				return lhs.Entry.NameHash < rhs.Entry.NameHash;
+			return std::strcmp(lhs.Name != nullptr ? lhs.Name : "", rhs.Name != nullptr ? rhs.Name : "") < 0;
+		});
+
+		const SerializedData ShaderData = SerializeChunk([this](auto& Ser) {
+			constexpr auto SerMode = std::remove_reference<decltype(Ser)>::type::GetMode();
+			for (const std::vector<SerializedData>& Shaders : m_DeviceShaders)
+			{
+				auto res = ArchiveSerializer<SerMode>{ Ser }.SerializeShaders(Shaders);
+				ASSERT(res, "Failed to serialize shaders");
+			}
+		});
+
+		// Offsets are computed by the Measure pass and written by the Write pass.
+		std::vector<ResourceIndexEntry> Index(Resources.size());
+		uint64 ShaderDataOffset = 0;
+		uint64 ShaderDataSize = ShaderData.Size();
+
+		auto SerializeThis = [&](auto& Ser) {
 			constexpr auto SerMode = std::remove_reference<decltype(Ser)>::type::GetMode();
 			const auto     ArchiveSer = ArchiveSerializer<SerMode>{ Ser };
 
@@ -254,27 +482,25 @@ namespace shz
 			auto res = ArchiveSer.SerializeHeader(Header);
 			ASSERT(res, "Failed to serialize header");
 
-			uint32 NumResources = StaticCast<uint32>(m_NamedResources.size());
-			res = Ser(NumResources);
-			ASSERT(res, "Failed to serialize the number of resources");
+			// NB: this must match resource index deserialization in DeviceObjectArchive::Deserialize
+			res = Ser(ShaderDataOffset, ShaderDataSize);
+			ASSERT(res, "Failed to serialize the shader data location");
 
-			for (const auto& res_it : m_NamedResources)
-			{
-				const char* Name = res_it.first.GetName();
-				const ResourceType ResType = res_it.first.GetType();
-
-				res = Ser(ResType, Name);
-				ASSERT(res, "Failed to serialize resource type and name");
+			res = Ser.SerializeBytes(Index.data(), Index.size() * sizeof(ResourceIndexEntry), alignof(ResourceIndexEntry));
+			ASSERT(res, "Failed to serialize the resource index");
 
-				res = ArchiveSer.SerializeResourceData(res_it.second);
+			for (size_t i = 0; i < Resources.size(); ++i)
+			{
+				res = Ser.Serialize(Resources[i].Data);
 				ASSERT(res, "Failed to serialize resource data");
-			}
 
-			for (const std::vector<SerializedData>& Shaders : m_DeviceShaders)
-			{
-				res = ArchiveSer.SerializeShaders(Shaders);
-				ASSERT(res, "Failed to serialize shaders");
+				Index[i] = Resources[i].Entry;
+				Index[i].Offset = Ser.GetSize() - Resources[i].Data.Size();
 			}
+
+			res = Ser.Serialize(ShaderData);
+			ASSERT(res, "Failed to serialize shaders");
+			ShaderDataOffset = Ser.GetSize() - ShaderData.Size();
 			};
 
 		Serializer<SerializerMode::Measure> Measurer;
@@ -364,6 +590,9 @@ namespace shz
 
 	std::string DeviceObjectArchive::ToString() const
 	{
+		LoadAllResources();
+		LoadShaders();
+
 		std::stringstream Output;
 		Output << "Archive contents:\n";
 
@@ -524,6 +753,9 @@ namespace shz
 
 	void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 	{
+		LoadAllResources();
+		LoadShaders();
+
 		for (auto& res_it : m_NamedResources)
 			res_it.second.DeviceSpecific[static_cast<size_t>(Dev)] = {};
 
@@ -532,6 +764,11 @@ namespace shz
 
 	void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false)
 	{
+		LoadAllResources();
+		LoadShaders();
+		Src.LoadAllResources();
+		Src.LoadShaders();
+
 		IMemoryAllocator& Allocator = GetRawAllocator();
 		for (auto& dst_res_it : m_NamedResources)
 		{
@@ -558,6 +795,11 @@ namespace shz
 
 	void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 	{
+		LoadAllResources();
+		LoadShaders();
+		Src.LoadAllResources();
+		Src.LoadShaders();
+
 		if (m_ContentVersion != Src.m_ContentVersion)
 			LOG_WARNING_MESSAGE("Merging archives with different content versions (", m_ContentVersion, " and ", Src.m_ContentVersion, ").");
 
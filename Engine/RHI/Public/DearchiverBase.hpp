@@ -55,10 +55,7 @@ namespace shz
 	public:
 		using TObjectBase = ObjectBase<IDearchiver>;
 
-		DearchiverBase(IReferenceCounters* pRefCounters, const DearchiverCreateInfo& CI) noexcept
-			: TObjectBase{ pRefCounters }
-		{
-		}
+		DearchiverBase(IReferenceCounters* pRefCounters, const DearchiverCreateInfo& CI) noexcept;
 
 		IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Dearchiver, TObjectBase);
 
@@ -210,7 +207,14 @@ namespace shz
 
 		ArchiveData* FindArchive(ResourceType ResType, const char* ResName);
 
+		// Returns m_Archives.size() if no archive contains the resource.
+		size_t FindArchiveIndex(ResourceType ResType, const char* ResName) const;
+
 	private:
+		// See DearchiverCreateInfo::LazyResourceIndex.
+		// Lazy archives are not added to m_ResNameToArchiveIdx and are searched in load order instead.
+		const bool m_LazyResourceIndex;
+
 		// Resource type and name -> archive index that contains this resource.
 		// Names must be unique for each resource type.
 		using NamedResourceKey = DeviceObjectArchive::NamedResourceKey;
@@ -235,11 +239,11 @@ namespace shz
 		}
 
 		// Find the archive that contains this signature
-		auto archive_idx_it = m_ResNameToArchiveIdx.find(NamedResourceKey{ PRSData::ArchiveResType, DeArchiveInfo.Name });
-		if (archive_idx_it == m_ResNameToArchiveIdx.end())
+		const size_t ArchiveIdx = FindArchiveIndex(PRSData::ArchiveResType, DeArchiveInfo.Name);
+		if (ArchiveIdx >= m_Archives.size())
 			return {};
 
-		const auto& pObjArchive = m_Archives[archive_idx_it->second].pObjArchive;
+		const auto& pObjArchive = m_Archives[ArchiveIdx].pObjArchive;
 		if (!pObjArchive)
 		{
 			ASSERT(false, "Null object archives should never be added to the list. This is a bug.");
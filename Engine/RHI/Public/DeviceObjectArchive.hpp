@@ -32,6 +32,7 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include "Engine/RHI/Interface/GraphicsTypes.h"
 #include "Primitives/FileStream.h"
@@ -44,7 +45,9 @@
 
 // Device object archive structure:
 //
-// | Header |  Resource Data  |  Shader Data  |
+// | Header |  Resource Index  |  Resource Data  |  Shader Data  |
+//
+//     |  Resource Index | = | Shader Data location | N | Entry1 | Entry2 | ... | EntryN |
 //
 //     |  Resource Data  | = | Res1 | Res2 | ... | ResN |
 //
@@ -57,6 +60,10 @@
 // - Archive version
 // - API version
 
+// The resource index is sorted by resource type and name hash. Every entry holds the
+// offset and size of one resource, so a resource can be located and deserialized
+// without reading the others (see CreateInfo::LazyIndex).
+//
 // Resource data contains an array of resources. Each resource contains:
 // - Type (Signature, Graphics Pipeline, Render Pass, etc.)
 // - Name
@@ -128,7 +135,7 @@ namespace shz
 		};
 
 		static constexpr uint32 HeaderMagicNumber = 0xDE00000A;
-		static constexpr uint32 ArchiveVersion = 8;
+		static constexpr uint32 ArchiveVersion = 9;
 
 		struct ArchiveHeader
 		{
@@ -141,6 +148,17 @@ namespace shz
 			const char* GitHash = nullptr;
 		};
 
+		// Resource index entry.
+		// Offset is relative to the start of the archive; the resource data at Offset
+		// contains the type and the name followed by the ResourceData.
+		struct ResourceIndexEntry
+		{
+			ResourceType Type = ResourceType::Undefined;
+			uint32       NameHash = 0;
+			uint64       Offset = 0;
+			uint64       Size = 0;
+		};
+
 		struct ResourceData
 		{
 			// Device-agnostic data (e.g. description)
@@ -230,6 +248,11 @@ namespace shz
 			const IDataBlob* pData = nullptr;
 			uint32           ContentVersion = ~0u;
 			bool             MakeCopy = false;
+
+			// Only read the header and the resource index. Resources and shaders
+			// are deserialized on first use, so the data that is never used is
+			// never touched (pData is typically a memory-mapped file).
+			bool             LazyIndex = false;
 		};
 		// Initializes a new device object archive from pData.
 		explicit DeviceObjectArchive(const CreateInfo& CI) noexcept(false);
@@ -247,22 +270,24 @@ namespace shz
 
 		std::string ToString() const;
 
+		using NamedResourceMap = std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher>;
+
 		template <typename ReourceDataType>
 		bool LoadResourceCommonData(ResourceType     Type,
 			const char* Name,
 			ReourceDataType& ResData) const
 		{
-			auto it = m_NamedResources.find(NamedResourceKey{ Type, Name });
-			if (it == m_NamedResources.end())
+			const NamedResourceMap::value_type* pResource = FindResource(Type, Name);
+			if (pResource == nullptr)
 			{
 				LOG_ERROR_MESSAGE("Resource '", Name, "' is not present in the archive");
 				return false;
 			}
-			ASSERT_EXPR(SafeStrEqual(Name, it->first.GetName()));
+			ASSERT_EXPR(SafeStrEqual(Name, pResource->first.GetName()));
 			// Use string copy from the map
-			Name = it->first.GetName();
+			Name = pResource->first.GetName();
 
-			Serializer<SerializerMode::Read> Ser{ it->second.Common };
+			Serializer<SerializerMode::Read> Ser{ pResource->second.Common };
 
 			auto Res = ResData.Deserialize(Name, Ser);
 			ASSERT_EXPR(Ser.IsEnded());
@@ -273,19 +298,27 @@ namespace shz
 			const char* Name,
 			DeviceType   DevType) const noexcept;
 
+		bool HasResource(ResourceType Type, const char* Name) const noexcept
+		{
+			return FindResource(Type, Name) != nullptr;
+		}
+
 		ResourceData& GetResourceData(ResourceType Type, const char* Name) noexcept
 		{
+			LoadAllResources();
 			constexpr bool MakeCopy = true;
 			return m_NamedResources[NamedResourceKey{ Type, Name, MakeCopy }];
 		}
 
 		auto& GetDeviceShaders(DeviceType Type) noexcept
 		{
+			LoadShaders();
 			return m_DeviceShaders[static_cast<size_t>(Type)];
 		}
 
 		const SerializedData& GetSerializedShader(DeviceType Type, size_t Idx) const noexcept
 		{
+			LoadShaders();
 			const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
 			if (Idx < DeviceShaders.size())
 				return DeviceShaders[Idx];
@@ -294,19 +327,51 @@ namespace shz
 			return NullData;
 		}
 
-		const auto& GetNamedResources() const
+		// With a lazy index, this deserializes every resource that has not been used yet.
+		const NamedResourceMap& GetNamedResources() const
 		{
+			LoadAllResources();
 			return m_NamedResources;
 		}
 
+		bool IsLazyIndex() const noexcept
+		{
+			return m_LazyIndex;
+		}
+
 		void Clear() noexcept;
 
 	private:
-		// Named resources
-		std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
+		// Returns null if the archive has no such resource.
+		const NamedResourceMap::value_type* FindResource(ResourceType Type, const char* Name) const noexcept;
+
+		// Both are no-ops unless the archive was loaded with a lazy index.
+		void LoadAllResources() const noexcept;
+		void LoadShaders() const noexcept;
+
+		const ResourceIndexEntry* FindIndexEntry(ResourceType Type, const char* Name) const noexcept;
+		const NamedResourceMap::value_type* LoadIndexedResource(const ResourceIndexEntry& Entry) const noexcept;
+
+	private:
+		// Named resources (with a lazy index, the ones used so far)
+		mutable NamedResourceMap m_NamedResources;
 
 		// Shaders
-		std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+		mutable std::array<std::vector<SerializedData>, static_cast<size_t>(DeviceType::Count)> m_DeviceShaders;
+
+		// Resource index, points to m_pArchiveData.
+		const ResourceIndexEntry* m_pIndex = nullptr;
+		uint32                    m_NumIndexEntries = 0;
+
+		// Location of the shader data in m_pArchiveData.
+		SerializedData m_ShaderData;
+
+		// Lazy index state. m_LazyMtx guards m_NamedResources and m_DeviceShaders
+		// while they are being filled.
+		bool               m_LazyIndex = false;
+		mutable bool       m_AllResourcesLoaded = true;
+		mutable bool       m_ShadersLoaded = true;
+		mutable std::mutex m_LazyMtx;
 
 		// Strong reference to the original data blob.
 		// Resources will not make copies and reference this data.
@@ -44,15 +44,43 @@ namespace shz
 			false 
 		}
 	{
-		HRESULT hr = pRenderDeviceD3D12->GetD3D12Device1()->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
-		if (FAILED(hr))
-			LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+		ID3D12Device1* pd3d12Device1 = pRenderDeviceD3D12->GetD3D12Device1();
+
+		if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize != 0 && (m_Desc.Mode & PSO_CACHE_MODE_LOAD) != 0)
+		{
+			// The library references the blob for its whole lifetime, so keep a copy.
+			const uint8* pData = static_cast<const uint8*>(CreateInfo.pCacheData);
+			m_CacheData.assign(pData, pData + CreateInfo.CacheDataSize);
+
+			HRESULT hr = pd3d12Device1->CreatePipelineLibrary(m_CacheData.data(), m_CacheData.size(), IID_PPV_ARGS(&m_pLibrary));
+			if (FAILED(hr))
+			{
+				// Data written by another driver or adapter is rejected; start over with an empty library.
+				LOG_WARNING_MESSAGE("D3D12 pipeline library data is incompatible with this device and will be discarded (hr = 0x", std::hex, static_cast<uint32>(hr), ")");
+				m_CacheData.clear();
+				m_pLibrary.Release();
+			}
+		}
+
+		if (!m_pLibrary)
+		{
+			HRESULT hr = pd3d12Device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pLibrary));
+			if (FAILED(hr))
+				LOG_ERROR_AND_THROW("Failed to create D3D12 pipeline library");
+		}
 	}
 
 	PipelineStateCacheD3D12Impl::~PipelineStateCacheD3D12Impl()
 	{
+		// The library is released before the data it was created from (reverse member order).
+		struct LibraryWithData
+		{
+			std::vector<uint8>             Data;
+			CComPtr<ID3D12PipelineLibrary> pLibrary;
+		};
+
 		// D3D12 object can only be destroyed when it is no longer used by the GPU
-		GetDevice()->SafeReleaseDeviceObject(std::move(m_pLibrary), ~uint64{ 0 });
+		GetDevice()->SafeReleaseDeviceObject(LibraryWithData{ std::move(m_CacheData), std::move(m_pLibrary) }, ~uint64{ 0 });
 	}
 
 	CComPtr<ID3D12DeviceChild> PipelineStateCacheD3D12Impl::LoadComputePipeline(const wchar_t* Name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& Desc)
@@ -29,6 +29,8 @@
  // \file
  // Declaration of shz::PipelineStateCacheD3D12Impl class
 
+#include <vector>
+
 #include "EngineD3D12ImplTraits.hpp"
 #include "Engine/RHI/Public/PipelineStateCacheBase.hpp"
 
@@ -55,6 +57,9 @@ namespace shz
 		bool StorePipeline(const wchar_t* Name, ID3D12DeviceChild* pPSO);
 
 	private:
+		// Serialized library the cache was created from; must outlive m_pLibrary.
+		std::vector<uint8> m_CacheData;
+
 		CComPtr<ID3D12PipelineLibrary> m_pLibrary;
 	};
 
@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "BufferNullImpl.hpp"
+
+#include <cstring>
+
+#include "RenderDeviceNullImpl.hpp"
+#include "Engine/GraphicsUtils/Public/GraphicsUtils.hpp"
+
+namespace shz
+{
+
+	BufferNullImpl::BufferNullImpl(
+		IReferenceCounters* pRefCounters,
+		FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
+		RenderDeviceNullImpl* pDevice,
+		const BufferDesc& BuffDesc,
+		const BufferData* pBuffData /*= nullptr*/)
+		: TBufferBase{
+			pRefCounters,
+			BuffViewObjMemAllocator,
+			pDevice,
+			BuffDesc,
+			false }
+	{
+		ValidateBufferInitData(m_Desc, pBuffData);
+
+		m_Data.resize(static_cast<size_t>(m_Desc.Size));
+
+		if (pBuffData != nullptr && pBuffData->pData != nullptr)
+		{
+			const size_t CopySize = static_cast<size_t>((std::min)(pBuffData->DataSize, m_Desc.Size));
+			std::memcpy(m_Data.data(), pBuffData->pData, CopySize);
+			SetState(RESOURCE_STATE_COPY_DEST);
+		}
+		else
+		{
+			SetState(RESOURCE_STATE_UNDEFINED);
+		}
+	}
+
+	void BufferNullImpl::CreateViewInternal(const BufferViewDesc& OrigViewDesc, IBufferView** ppView, bool bIsDefaultView)
+	{
+		ASSERT(ppView != nullptr, "Null pointer provided");
+		if (!ppView) return;
+		ASSERT(*ppView == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+		*ppView = nullptr;
+
+		try
+		{
+			RenderDeviceNullImpl* pDeviceNullImpl = GetDevice();
+			FixedBlockMemoryAllocator& BuffViewAllocator = pDeviceNullImpl->GetBuffViewObjAllocator();
+			ASSERT(&BuffViewAllocator == &m_dbgBuffViewAllocator, "Buff view allocator does not match allocator provided at buffer initialization");
+
+			BufferViewDesc ViewDesc = OrigViewDesc;
+			ValidateAndCorrectBufferViewDesc(m_Desc, ViewDesc, pDeviceNullImpl->GetAdapterInfo().Buffer.StructuredBufferOffsetAlignment);
+
+			*ppView = NEW_RC_OBJ(BuffViewAllocator, "BufferViewNullImpl instance", BufferViewNullImpl, bIsDefaultView ? this : nullptr)(pDeviceNullImpl, ViewDesc, this, bIsDefaultView);
+
+			if (!bIsDefaultView && *ppView)
+				(*ppView)->AddRef();
+		}
+		catch (const std::runtime_error&)
+		{
+			const char* ViewTypeName = GetBufferViewTypeLiteralName(OrigViewDesc.ViewType);
+			LOG_ERROR("Failed to create view \"", OrigViewDesc.Name ? OrigViewDesc.Name : "", "\" (", ViewTypeName, ") for buffer \"", m_Desc.Name, "\"");
+		}
+	}
+
+} // namespace shz
@@ -0,0 +1,52 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::BufferNullImpl class
+
+#include <vector>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/BufferBase.hpp"
+#include "BufferViewNullImpl.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Buffer implementation in the null backend.
+
+	// The buffer keeps its contents in system memory so that MapBuffer() and
+	// UpdateBuffer() behave like on a real device; texture contents are not kept.
+	class BufferNullImpl final : public BufferBase<EngineNullImplTraits>
+	{
+	public:
+		using TBufferBase = BufferBase<EngineNullImplTraits>;
+
+		BufferNullImpl(IReferenceCounters* pRefCounters,
+			FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
+			RenderDeviceNullImpl* pDevice,
+			const BufferDesc& BuffDesc,
+			const BufferData* pBuffData = nullptr);
+
+		// Implementation of IBuffer::GetNativeHandle() in the null backend.
+		virtual uint64 SHZ_CALL_TYPE GetNativeHandle() override final
+		{
+			return reinterpret_cast<uint64>(m_Data.data());
+		}
+
+		// Implementation of IBuffer::GetSparseProperties() in the null backend.
+		virtual SparseBufferProperties SHZ_CALL_TYPE GetSparseProperties() const override final
+		{
+			return {};
+		}
+
+		uint8* GetCPUData() { return m_Data.data(); }
+
+	protected:
+		virtual void CreateViewInternal(const BufferViewDesc& ViewDesc, IBufferView** ppView, bool bIsDefaultView) override final;
+
+	private:
+		std::vector<uint8> m_Data;
+	};
+
+} // namespace shz
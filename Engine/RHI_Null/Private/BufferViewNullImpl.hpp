@@ -0,0 +1,29 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::BufferViewNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/BufferViewBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Buffer view implementation in the null backend.
+	class BufferViewNullImpl final : public BufferViewBase<EngineNullImplTraits>
+	{
+	public:
+		using TBufferViewBase = BufferViewBase<EngineNullImplTraits>;
+
+		BufferViewNullImpl(IReferenceCounters* pRefCounters,
+			RenderDeviceNullImpl* pDevice,
+			const BufferViewDesc& ViewDesc,
+			IBuffer* pBuffer,
+			bool bIsDefaultView)
+			: TBufferViewBase{ pRefCounters, pDevice, ViewDesc, pBuffer, bIsDefaultView }
+		{
+		}
+	};
+
+} // namespace shz
@@ -0,0 +1,41 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::CommandListNullImpl class
+
+#include <vector>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/CommandListBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Command list implementation in the null backend. Owns the commands
+	// recorded by a deferred context until the list is executed.
+	class CommandListNullImpl final : public CommandListBase<EngineNullImplTraits>
+	{
+	public:
+		using TCommandListBase = CommandListBase<EngineNullImplTraits>;
+
+		CommandListNullImpl(IReferenceCounters* pRefCounters,
+			RenderDeviceNullImpl* pDevice,
+			DeviceContextNullImpl* pDeferredCtx,
+			std::vector<NullCommand>&& Commands,
+			const NullCommandCounters& Counters)
+			: TCommandListBase{ pRefCounters, pDevice, pDeferredCtx }
+			, m_Commands{ std::move(Commands) }
+			, m_Counters{ Counters }
+		{
+		}
+
+		const std::vector<NullCommand>& GetCommands() const { return m_Commands; }
+		const NullCommandCounters& GetCounters() const { return m_Counters; }
+
+	private:
+		std::vector<NullCommand> m_Commands;
+		NullCommandCounters m_Counters;
+	};
+
+} // namespace shz
@@ -0,0 +1,604 @@
+#include "pch.h"
+#include "DeviceContextNullImpl.hpp"
+
+#include <cstring>
+
+#include "FenceNullImpl.hpp"
+#include "TextureViewNullImpl.hpp"
+#include "Engine/GraphicsUtils/Public/GraphicsUtils.hpp"
+
+namespace shz
+{
+
+	namespace
+	{
+		static inline int32 objectId(const IDeviceObject* pObj)
+		{
+			return pObj != nullptr ? pObj->GetUniqueID() : 0;
+		}
+
+		static inline uint32 lowBits(uint64 Value)
+		{
+			return static_cast<uint32>(Value & 0xFFFFFFFFu);
+		}
+
+		static inline uint32 highBits(uint64 Value)
+		{
+			return static_cast<uint32>(Value >> 32);
+		}
+	} // namespace
+
+	DeviceContextNullImpl::DeviceContextNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const DeviceContextDesc& Desc)
+		: TDeviceContextBase{ pRefCounters, pDevice, Desc }
+		, m_CmdListAllocator{ GetRawAllocator(), sizeof(CommandListNullImpl), 64 }
+	{
+	}
+
+	DeviceContextNullImpl::~DeviceContextNullImpl()
+	{
+		if (IsDeferred() && !m_Commands.empty())
+		{
+			LOG_ERROR_MESSAGE("There are outstanding commands in deferred context #", GetContextId(),
+				" being destroyed, which indicates that FinishCommandList() has not been called.");
+		}
+	}
+
+	void DeviceContextNullImpl::record(NULL_COMMAND_TYPE Type, int32 ObjectId, uint32 Arg0, uint32 Arg1, uint32 Arg2, uint32 Arg3)
+	{
+		NullCommand& Cmd = m_Commands.emplace_back();
+		Cmd.Type = Type;
+		Cmd.ObjectId = ObjectId;
+		Cmd.Args[0] = Arg0;
+		Cmd.Args[1] = Arg1;
+		Cmd.Args[2] = Arg2;
+		Cmd.Args[3] = Arg3;
+
+		++m_Counters.Commands[Type];
+	}
+
+	void DeviceContextNullImpl::transitionResource(IDeviceObject* pResource, RESOURCE_STATE NewState, RESOURCE_STATE_TRANSITION_MODE Mode)
+	{
+		if (pResource == nullptr || Mode != RESOURCE_STATE_TRANSITION_MODE_TRANSITION)
+			return;
+
+		StateTransitionDesc Barrier;
+		Barrier.pResource = pResource;
+		Barrier.OldState = RESOURCE_STATE_UNKNOWN;
+		Barrier.NewState = NewState;
+		Barrier.Flags = STATE_TRANSITION_FLAG_UPDATE_STATE;
+		TransitionResourceStates(1, &Barrier);
+	}
+
+	void DeviceContextNullImpl::Begin(uint32 ImmediateContextId)
+	{
+		ASSERT(ImmediateContextId < m_pDevice->GetCommandQueueCount(), "ImmediateContextId is out of range");
+		TDeviceContextBase::Begin(DeviceContextIndex{ ImmediateContextId }, COMMAND_QUEUE_TYPE_GRAPHICS);
+	}
+
+	void DeviceContextNullImpl::SetPipelineState(IPipelineState* pPipelineState)
+	{
+		if (!TDeviceContextBase::SetPipelineState(pPipelineState, PipelineStateNullImpl::IID_InternalImpl))
+			return;
+
+		record(NULL_COMMAND_SET_PIPELINE_STATE, objectId(pPipelineState));
+	}
+
+	void DeviceContextNullImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+	{
+		TDeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0);
+
+		// SRBs are not device objects; identify them by their pipeline.
+		ShaderResourceBindingNullImpl* pSRB = ClassPtrCast<ShaderResourceBindingNullImpl>(pShaderResourceBinding);
+		record(NULL_COMMAND_COMMIT_SHADER_RESOURCES, objectId(pSRB->GetPipelineState()), pSRB->GetNumBoundObjects());
+	}
+
+	void DeviceContextNullImpl::SetStencilRef(uint32 StencilRef)
+	{
+		TDeviceContextBase::SetStencilRef(StencilRef, 0);
+	}
+
+	void DeviceContextNullImpl::SetBlendFactors(const float* pBlendFactors)
+	{
+		TDeviceContextBase::SetBlendFactors(pBlendFactors, 0);
+	}
+
+	void DeviceContextNullImpl::SetVertexBuffers(
+		uint32 StartSlot,
+		uint32 NumBuffersSet,
+		IBuffer* const* ppBuffers,
+		const uint64* pOffsets,
+		RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+		SET_VERTEX_BUFFERS_FLAGS Flags)
+	{
+		TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
+
+		for (uint32 i = 0; i < NumBuffersSet; ++i)
+			transitionResource(ppBuffers != nullptr ? ppBuffers[i] : nullptr, RESOURCE_STATE_VERTEX_BUFFER, StateTransitionMode);
+
+		record(NULL_COMMAND_SET_VERTEX_BUFFERS, NumBuffersSet > 0 && ppBuffers != nullptr ? objectId(ppBuffers[0]) : 0, StartSlot, NumBuffersSet);
+	}
+
+	void DeviceContextNullImpl::InvalidateState()
+	{
+		TDeviceContextBase::InvalidateState();
+	}
+
+	void DeviceContextNullImpl::SetIndexBuffer(IBuffer* pIndexBuffer, uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+	{
+		TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
+		transitionResource(pIndexBuffer, RESOURCE_STATE_INDEX_BUFFER, StateTransitionMode);
+		record(NULL_COMMAND_SET_INDEX_BUFFER, objectId(pIndexBuffer), lowBits(ByteOffset), highBits(ByteOffset));
+	}
+
+	void DeviceContextNullImpl::SetViewports(uint32 NumViewports, const Viewport* pViewports, uint32 RTWidth, uint32 RTHeight)
+	{
+		TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
+		record(NULL_COMMAND_SET_VIEWPORTS, 0, m_NumViewports, RTWidth, RTHeight);
+	}
+
+	void DeviceContextNullImpl::SetScissorRects(uint32 NumRects, const Rect* pRects, uint32 RTWidth, uint32 RTHeight)
+	{
+		TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
+		record(NULL_COMMAND_SET_SCISSOR_RECTS, 0, m_NumScissorRects, RTWidth, RTHeight);
+	}
+
+	void DeviceContextNullImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
+	{
+		ASSERT(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
+
+		if (TDeviceContextBase::SetRenderTargets(Attribs))
+		{
+			for (uint32 rt = 0; rt < m_NumBoundRenderTargets; ++rt)
+			{
+				if (TextureViewNullImpl* pRTV = m_pBoundRenderTargets[rt])
+					transitionResource(pRTV->GetTexture(), RESOURCE_STATE_RENDER_TARGET, Attribs.StateTransitionMode);
+			}
+			if (m_pBoundDepthStencil)
+				transitionResource(m_pBoundDepthStencil->GetTexture(), RESOURCE_STATE_DEPTH_WRITE, Attribs.StateTransitionMode);
+
+			record(NULL_COMMAND_SET_RENDER_TARGETS, objectId(m_pBoundDepthStencil), m_NumBoundRenderTargets, m_FramebufferWidth, m_FramebufferHeight);
+
+			// Set the viewport to match the render target size
+			SetViewports(1, nullptr, 0, 0);
+		}
+	}
+
+	void DeviceContextNullImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
+	{
+		TDeviceContextBase::BeginRenderPass(Attribs);
+		record(NULL_COMMAND_BEGIN_RENDER_PASS, objectId(Attribs.pRenderPass), objectId(Attribs.pFramebuffer), Attribs.ClearValueCount);
+	}
+
+	void DeviceContextNullImpl::NextSubpass()
+	{
+		TDeviceContextBase::NextSubpass();
+		record(NULL_COMMAND_NEXT_SUBPASS, objectId(m_pActiveRenderPass), m_SubpassIndex);
+	}
+
+	void DeviceContextNullImpl::EndRenderPass()
+	{
+		const int32 RenderPassId = objectId(m_pActiveRenderPass);
+		TDeviceContextBase::EndRenderPass();
+		record(NULL_COMMAND_END_RENDER_PASS, RenderPassId);
+	}
+
+	// ------------------------------------------------------------
+	// Draw and dispatch
+	// ------------------------------------------------------------
+	void DeviceContextNullImpl::Draw(const DrawAttribs& Attribs)
+	{
+		TDeviceContextBase::Draw(Attribs, 0);
+		record(NULL_COMMAND_DRAW, objectId(m_pPipelineState), Attribs.NumVertices, Attribs.NumInstances, Attribs.StartVertexLocation, Attribs.FirstInstanceLocation);
+	}
+
+	void DeviceContextNullImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
+	{
+		TDeviceContextBase::DrawIndexed(Attribs, 0);
+		record(NULL_COMMAND_DRAW_INDEXED, objectId(m_pPipelineState), Attribs.NumIndices, Attribs.NumInstances, Attribs.FirstIndexLocation, Attribs.FirstInstanceLocation);
+	}
+
+	void DeviceContextNullImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
+	{
+		TDeviceContextBase::DrawIndirect(Attribs, 0);
+		record(NULL_COMMAND_DRAW_INDIRECT, objectId(m_pPipelineState), Attribs.DrawCount, objectId(Attribs.pAttribsBuffer));
+	}
+
+	void DeviceContextNullImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
+	{
+		TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
+		record(NULL_COMMAND_DRAW_INDEXED_INDIRECT, objectId(m_pPipelineState), Attribs.DrawCount, objectId(Attribs.pAttribsBuffer));
+	}
+
+	void DeviceContextNullImpl::DrawMesh(const DrawMeshAttribs& Attribs)
+	{
+		TDeviceContextBase::DrawMesh(Attribs, 0);
+		record(NULL_COMMAND_DRAW, objectId(m_pPipelineState), Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
+	}
+
+	void DeviceContextNullImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs)
+	{
+		TDeviceContextBase::DrawMeshIndirect(Attribs, 0);
+		record(NULL_COMMAND_DRAW_INDIRECT, objectId(m_pPipelineState), Attribs.CommandCount, objectId(Attribs.pAttribsBuffer));
+	}
+
+	void DeviceContextNullImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+	{
+		TDeviceContextBase::MultiDraw(Attribs, 0);
+		for (uint32 i = 0; i < Attribs.DrawCount; ++i)
+		{
+			const MultiDrawItem& Item = Attribs.pDrawItems[i];
+			record(NULL_COMMAND_DRAW, objectId(m_pPipelineState), Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+		}
+	}
+
+	void DeviceContextNullImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+	{
+		TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
+		for (uint32 i = 0; i < Attribs.DrawCount; ++i)
+		{
+			const MultiDrawIndexedItem& Item = Attribs.pDrawItems[i];
+			record(NULL_COMMAND_DRAW_INDEXED, objectId(m_pPipelineState), Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Attribs.FirstInstanceLocation);
+		}
+	}
+
+	void DeviceContextNullImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
+	{
+		TDeviceContextBase::DispatchCompute(Attribs, 0);
+		record(NULL_COMMAND_DISPATCH_COMPUTE, objectId(m_pPipelineState), Attribs.ThreadGroupCountX, Attribs.ThreadGroupCountY, Attribs.ThreadGroupCountZ);
+	}
+
+	void DeviceContextNullImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
+	{
+		TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
+		record(NULL_COMMAND_DISPATCH_COMPUTE_INDIRECT, objectId(m_pPipelineState), objectId(Attribs.pAttribsBuffer));
+	}
+
+	// ------------------------------------------------------------
+	// Clears and resource updates
+	// ------------------------------------------------------------
+	void DeviceContextNullImpl::ClearDepthStencil(
+		ITextureView* pView,
+		CLEAR_DEPTH_STENCIL_FLAGS ClearFlags,
+		float fDepth,
+		uint8 Stencil,
+		RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+	{
+		TDeviceContextBase::ClearDepthStencil(pView);
+
+		transitionResource(pView->GetTexture(), RESOURCE_STATE_DEPTH_WRITE, StateTransitionMode);
+		record(NULL_COMMAND_CLEAR_DEPTH_STENCIL, objectId(pView->GetTexture()), ClearFlags, Stencil);
+	}
+
+	void DeviceContextNullImpl::ClearRenderTarget(ITextureView* pView, const void* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+	{
+		TDeviceContextBase::ClearRenderTarget(pView);
+
+		transitionResource(pView->GetTexture(), RESOURCE_STATE_RENDER_TARGET, StateTransitionMode);
+		record(NULL_COMMAND_CLEAR_RENDER_TARGET, objectId(pView->GetTexture()));
+	}
+
+	void DeviceContextNullImpl::UpdateBuffer(
+		IBuffer* pBuffer,
+		uint64 Offset,
+		uint64 Size,
+		const void* pData,
+		RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+	{
+		TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
+
+		BufferNullImpl* pBufferNull = ClassPtrCast<BufferNullImpl>(pBuffer);
+		std::memcpy(pBufferNull->GetCPUData() + Offset, pData, static_cast<size_t>(Size));
+
+		transitionResource(pBuffer, RESOURCE_STATE_COPY_DEST, StateTransitionMode);
+		record(NULL_COMMAND_UPDATE_BUFFER, objectId(pBuffer), lowBits(Size), highBits(Size));
+		m_Counters.BytesUploaded += Size;
+	}
+
+	void DeviceContextNullImpl::CopyBuffer(
+		IBuffer* pSrcBuffer,
+		uint64 SrcOffset,
+		RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+		IBuffer* pDstBuffer,
+		uint64 DstOffset,
+		uint64 Size,
+		RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+	{
+		TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+
+		BufferNullImpl* pSrcBufferNull = ClassPtrCast<BufferNullImpl>(pSrcBuffer);
+		BufferNullImpl* pDstBufferNull = ClassPtrCast<BufferNullImpl>(pDstBuffer);
+		std::memmove(pDstBufferNull->GetCPUData() + DstOffset, pSrcBufferNull->GetCPUData() + SrcOffset, static_cast<size_t>(Size));
+
+		transitionResource(pSrcBuffer, RESOURCE_STATE_COPY_SOURCE, SrcBufferTransitionMode);
+		transitionResource(pDstBuffer, RESOURCE_STATE_COPY_DEST, DstBufferTransitionMode);
+		record(NULL_COMMAND_COPY_BUFFER, objectId(pDstBuffer), lowBits(Size), highBits(Size), static_cast<uint32>(objectId(pSrcBuffer)));
+	}
+
+	void DeviceContextNullImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, void*& pMappedData)
+	{
+		TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
+
+		BufferNullImpl* pBufferNull = ClassPtrCast<BufferNullImpl>(pBuffer);
+		pMappedData = pBufferNull->GetCPUData();
+
+		const uint64 Size = pBuffer->GetDesc().Size;
+		record(NULL_COMMAND_MAP_BUFFER, objectId(pBuffer), lowBits(Size), highBits(Size), MapType);
+		if (MapType != MAP_READ)
+			m_Counters.BytesUploaded += Size;
+	}
+
+	void DeviceContextNullImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
+	{
+		TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
+	}
+
+	void DeviceContextNullImpl::UpdateTexture(
+		ITexture* pTexture,
+		uint32 MipLevel,
+		uint32 Slice,
+		const IBox& DstBox,
+		const TextureSubResData& SubresData,
+		RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+		RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode)
+	{
+		TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferTransitionMode, TextureTransitionMode);
+
+		transitionResource(pTexture, RESOURCE_STATE_COPY_DEST, TextureTransitionMode);
+		record(NULL_COMMAND_UPDATE_TEXTURE, objectId(pTexture), MipLevel, Slice, DstBox.Width(), DstBox.Height());
+	}
+
+	void DeviceContextNullImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
+	{
+		TDeviceContextBase::CopyTexture(CopyAttribs);
+
+		transitionResource(CopyAttribs.pSrcTexture, RESOURCE_STATE_COPY_SOURCE, CopyAttribs.SrcTextureTransitionMode);
+		transitionResource(CopyAttribs.pDstTexture, RESOURCE_STATE_COPY_DEST, CopyAttribs.DstTextureTransitionMode);
+		record(NULL_COMMAND_COPY_TEXTURE, objectId(CopyAttribs.pDstTexture), CopyAttribs.DstMipLevel, CopyAttribs.DstSlice, static_cast<uint32>(objectId(CopyAttribs.pSrcTexture)));
+	}
+
+	void DeviceContextNullImpl::MapTextureSubresource(
+		ITexture* pTexture,
+		uint32 MipLevel,
+		uint32 ArraySlice,
+		MAP_TYPE MapType,
+		MAP_FLAGS MapFlags,
+		const IBox* pMapRegion,
+		MappedTextureSubresource& MappedData)
+	{
+		TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
+
+		// Texture contents are not kept; hand out scratch memory of the right size.
+		const MipLevelProperties MipProps = GetMipLevelProperties(pTexture->GetDesc(), MipLevel);
+		m_ScratchSpace.resize(static_cast<size_t>(MipProps.MipSize));
+
+		MappedData.pData = m_ScratchSpace.data();
+		MappedData.Stride = MipProps.RowSize;
+		MappedData.DepthStride = MipProps.DepthSliceSize;
+	}
+
+	void DeviceContextNullImpl::UnmapTextureSubresource(ITexture* pTexture, uint32 MipLevel, uint32 ArraySlice)
+	{
+		TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
+	}
+
+	void DeviceContextNullImpl::GenerateMips(ITextureView* pTexView)
+	{
+		TDeviceContextBase::GenerateMips(pTexView);
+		record(NULL_COMMAND_GENERATE_MIPS, objectId(pTexView->GetTexture()));
+	}
+
+	void DeviceContextNullImpl::ResolveTextureSubresource(ITexture* pSrcTexture, ITexture* pDstTexture, const ResolveTextureSubresourceAttribs& ResolveAttribs)
+	{
+		TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
+
+		transitionResource(pSrcTexture, RESOURCE_STATE_RESOLVE_SOURCE, ResolveAttribs.SrcTextureTransitionMode);
+		transitionResource(pDstTexture, RESOURCE_STATE_RESOLVE_DEST, ResolveAttribs.DstTextureTransitionMode);
+		record(NULL_COMMAND_COPY_TEXTURE, objectId(pDstTexture), ResolveAttribs.DstMipLevel, ResolveAttribs.DstSlice, static_cast<uint32>(objectId(pSrcTexture)));
+	}
+
+	void DeviceContextNullImpl::TransitionResourceStates(uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers)
+	{
+		ASSERT(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
+
+		for (uint32 i = 0; i < BarrierCount; ++i)
+		{
+			const StateTransitionDesc& Barrier = pResourceBarriers[i];
+			const bool bUpdateState = (Barrier.Flags & STATE_TRANSITION_FLAG_UPDATE_STATE) != 0;
+
+			RESOURCE_STATE OldState = Barrier.OldState;
+			if (RefCntAutoPtr<TextureNullImpl> pTexture{ Barrier.pResource, IID_Texture })
+			{
+				if (OldState == RESOURCE_STATE_UNKNOWN)
+					OldState = pTexture->GetState();
+				if (OldState == Barrier.NewState && OldState != RESOURCE_STATE_UNORDERED_ACCESS)
+					continue;
+				if (bUpdateState)
+					pTexture->SetState(Barrier.NewState);
+			}
+			else if (RefCntAutoPtr<BufferNullImpl> pBuffer{ Barrier.pResource, IID_Buffer })
+			{
+				if (OldState == RESOURCE_STATE_UNKNOWN)
+					OldState = pBuffer->GetState();
+				if (OldState == Barrier.NewState && OldState != RESOURCE_STATE_UNORDERED_ACCESS)
+					continue;
+				if (bUpdateState)
+					pBuffer->SetState(Barrier.NewState);
+			}
+
+			record(NULL_COMMAND_RESOURCE_BARRIER, objectId(Barrier.pResource), OldState, Barrier.NewState);
+		}
+	}
+
+	// ------------------------------------------------------------
+	// Submission and synchronization
+	// ------------------------------------------------------------
+	void DeviceContextNullImpl::FinishCommandList(ICommandList** ppCommandList)
+	{
+		ASSERT(IsDeferred(), "Only deferred context can record command list");
+		ASSERT(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
+
+		CommandListNullImpl* pCmdListNull(NEW_RC_OBJ(m_CmdListAllocator, "CommandListNullImpl instance", CommandListNullImpl)(m_pDevice, this, std::move(m_Commands), m_Counters));
+		pCmdListNull->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+		m_Commands.clear();
+		m_Counters = {};
+
+		InvalidateState();
+
+		TDeviceContextBase::FinishCommandList();
+	}
+
+	void DeviceContextNullImpl::ExecuteCommandLists(uint32 NumCommandLists, ICommandList* const* ppCommandLists)
+	{
+		ASSERT(!IsDeferred(), "Only immediate context can execute command list");
+
+		if (NumCommandLists == 0)
+			return;
+		ASSERT(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
+
+		for (uint32 i = 0; i < NumCommandLists; ++i)
+		{
+			const CommandListNullImpl* pCmdList = ClassPtrCast<const CommandListNullImpl>(ppCommandLists[i]);
+			const std::vector<NullCommand>& Commands = pCmdList->GetCommands();
+			const NullCommandCounters& Counters = pCmdList->GetCounters();
+
+			record(NULL_COMMAND_EXECUTE_COMMAND_LIST, 0, static_cast<uint32>(Commands.size()));
+			m_Commands.insert(m_Commands.end(), Commands.begin(), Commands.end());
+
+			for (uint32 t = 0; t < NULL_COMMAND_TYPE_COUNT; ++t)
+				m_Counters.Commands[t] += Counters.Commands[t];
+			m_Counters.BytesUploaded += Counters.BytesUploaded;
+		}
+
+		InvalidateState();
+	}
+
+	void DeviceContextNullImpl::EnqueueSignal(IFence* pFence, uint64 Value)
+	{
+		TDeviceContextBase::EnqueueSignal(pFence, Value, 0);
+
+		// Commands complete as they are recorded.
+		ClassPtrCast<FenceNullImpl>(pFence)->Signal(Value);
+	}
+
+	void DeviceContextNullImpl::DeviceWaitForFence(IFence* pFence, uint64 Value)
+	{
+		TDeviceContextBase::DeviceWaitForFence(pFence, Value, 0);
+	}
+
+	void DeviceContextNullImpl::BeginQuery(IQuery* pQuery)
+	{
+		TDeviceContextBase::BeginQuery(pQuery, 0);
+	}
+
+	void DeviceContextNullImpl::EndQuery(IQuery* pQuery)
+	{
+		TDeviceContextBase::EndQuery(pQuery, 0);
+	}
+
+	void DeviceContextNullImpl::Flush()
+	{
+		ASSERT(!IsDeferred(), "Flush() should only be called for immediate contexts.");
+		ASSERT(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
+
+		record(NULL_COMMAND_FLUSH, 0);
+	}
+
+	void DeviceContextNullImpl::FinishFrame()
+	{
+		if (!IsDeferred())
+			record(NULL_COMMAND_FINISH_FRAME, 0, static_cast<uint32>(m_FrameNumber));
+
+		EndFrame();
+	}
+
+	// ------------------------------------------------------------
+	// Unsupported features
+	// ------------------------------------------------------------
+	void DeviceContextNullImpl::BuildBLAS(const BuildBLASAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::BuildTLAS(const BuildTLASAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::CopyBLAS(const CopyBLASAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::CopyTLAS(const CopyTLASAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::WriteBLASCompactedSize(const WriteBLASCompactedSizeAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::WriteTLASCompactedSize(const WriteTLASCompactedSizeAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::TraceRays(const TraceRaysAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::TraceRaysIndirect(const TraceRaysIndirectAttribs& Attribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndirectRTBufferAttribs* pUpdateIndirectBufferAttribs)
+	{
+		ASSERT(false, "Ray tracing is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::BeginDebugGroup(const Char* Name, const float* pColor)
+	{
+		TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
+	}
+
+	void DeviceContextNullImpl::EndDebugGroup()
+	{
+		TDeviceContextBase::EndDebugGroup(0);
+	}
+
+	void DeviceContextNullImpl::InsertDebugLabel(const Char* Label, const float* pColor)
+	{
+		TDeviceContextBase::InsertDebugLabel(Label, pColor, 0);
+	}
+
+	void DeviceContextNullImpl::SetShadingRate(SHADING_RATE BaseRate, SHADING_RATE_COMBINER PrimitiveCombiner, SHADING_RATE_COMBINER TextureCombiner)
+	{
+		ASSERT(false, "Variable rate shading is not supported by the null backend");
+	}
+
+	void DeviceContextNullImpl::BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs)
+	{
+		ASSERT(false, "Sparse resources are not supported by the null backend");
+	}
+
+	// ------------------------------------------------------------
+	// IDeviceContextNull
+	// ------------------------------------------------------------
+	const NullCommand* DeviceContextNullImpl::GetCommandStream(uint32& NumCommands) const
+	{
+		NumCommands = static_cast<uint32>(m_Commands.size());
+		return m_Commands.data();
+	}
+
+	void DeviceContextNullImpl::ResetCommandStream()
+	{
+		m_Commands.clear();
+		m_Counters = {};
+	}
+
+} // namespace shz
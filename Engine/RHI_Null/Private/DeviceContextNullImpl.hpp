@@ -0,0 +1,299 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::DeviceContextNullImpl class
+
+#include <vector>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/DeviceContextBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+#include "BufferNullImpl.hpp"
+#include "TextureNullImpl.hpp"
+#include "QueryNullImpl.hpp"
+#include "FramebufferNullImpl.hpp"
+#include "RenderPassNullImpl.hpp"
+#include "PipelineStateNullImpl.hpp"
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "CommandListNullImpl.hpp"
+
+namespace shz
+{
+
+	// Device context implementation in the null backend.
+
+	// Every command goes through the same validation and statistics as in the other
+	// backends (DeviceContextBase) and is then appended to a command stream instead
+	// of a GPU command list. Buffer writes land in the buffer's system memory copy;
+	// resource state transitions update the tracked states immediately.
+	class DeviceContextNullImpl final : public DeviceContextBase<EngineNullImplTraits>
+	{
+	public:
+		using TDeviceContextBase = DeviceContextBase<EngineNullImplTraits>;
+
+		DeviceContextNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const DeviceContextDesc& Desc);
+		~DeviceContextNullImpl();
+
+		IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DeviceContextNull, TDeviceContextBase);
+
+		// Implementation of IDeviceContext::Begin() in the null backend.
+		virtual void SHZ_CALL_TYPE Begin(uint32 ImmediateContextId) override final;
+
+		// Implementation of IDeviceContext::SetPipelineState() in the null backend.
+		virtual void SHZ_CALL_TYPE SetPipelineState(IPipelineState* pPipelineState) override final;
+
+		// Implementation of IDeviceContext::TransitionShaderResources() in the null backend.
+		virtual void SHZ_CALL_TYPE TransitionShaderResources(IShaderResourceBinding* pShaderResourceBinding) override final {}
+
+		// Implementation of IDeviceContext::CommitShaderResources() in the null backend.
+		virtual void SHZ_CALL_TYPE CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
+
+		// Implementation of IDeviceContext::SetStencilRef() in the null backend.
+		virtual void SHZ_CALL_TYPE SetStencilRef(uint32 StencilRef) override final;
+
+		// Implementation of IDeviceContext::SetBlendFactors() in the null backend.
+		virtual void SHZ_CALL_TYPE SetBlendFactors(const float* pBlendFactors = nullptr) override final;
+
+		// Implementation of IDeviceContext::SetVertexBuffers() in the null backend.
+		virtual void SHZ_CALL_TYPE SetVertexBuffers(
+			uint32 StartSlot,
+			uint32 NumBuffersSet,
+			IBuffer* const* ppBuffers,
+			const uint64* pOffsets,
+			RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
+			SET_VERTEX_BUFFERS_FLAGS Flags) override final;
+
+		// Implementation of IDeviceContext::InvalidateState() in the null backend.
+		virtual void SHZ_CALL_TYPE InvalidateState() override final;
+
+		// Implementation of IDeviceContext::SetIndexBuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE SetIndexBuffer(
+			IBuffer* pIndexBuffer,
+			uint64 ByteOffset,
+			RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
+
+		// Implementation of IDeviceContext::SetViewports() in the null backend.
+		virtual void SHZ_CALL_TYPE SetViewports(
+			uint32 NumViewports,
+			const Viewport* pViewports,
+			uint32 RTWidth,
+			uint32 RTHeight) override final;
+
+		// Implementation of IDeviceContext::SetScissorRects() in the null backend.
+		virtual void SHZ_CALL_TYPE SetScissorRects(
+			uint32 NumRects,
+			const Rect* pRects,
+			uint32 RTWidth,
+			uint32 RTHeight) override final;
+
+		// Implementation of IDeviceContext::SetRenderTargetsExt() in the null backend.
+		virtual void SHZ_CALL_TYPE SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::BeginRenderPass() in the null backend.
+		virtual void SHZ_CALL_TYPE BeginRenderPass(const BeginRenderPassAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::NextSubpass() in the null backend.
+		virtual void SHZ_CALL_TYPE NextSubpass() override final;
+
+		// Implementation of IDeviceContext::EndRenderPass() in the null backend.
+		virtual void SHZ_CALL_TYPE EndRenderPass() override final;
+
+		// Implementation of IDeviceContext::Draw() in the null backend.
+		virtual void SHZ_CALL_TYPE Draw(const DrawAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::DrawIndexed() in the null backend.
+		virtual void SHZ_CALL_TYPE DrawIndexed(const DrawIndexedAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::DrawIndirect() in the null backend.
+		virtual void SHZ_CALL_TYPE DrawIndirect(const DrawIndirectAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::DrawIndexedIndirect() in the null backend.
+		virtual void SHZ_CALL_TYPE DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::DrawMesh() in the null backend.
+		virtual void SHZ_CALL_TYPE DrawMesh(const DrawMeshAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::DrawMeshIndirect() in the null backend.
+		virtual void SHZ_CALL_TYPE DrawMeshIndirect(const DrawMeshIndirectAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::MultiDraw() in the null backend.
+		virtual void SHZ_CALL_TYPE MultiDraw(const MultiDrawAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::MultiDrawIndexed() in the null backend.
+		virtual void SHZ_CALL_TYPE MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::DispatchCompute() in the null backend.
+		virtual void SHZ_CALL_TYPE DispatchCompute(const DispatchComputeAttribs& Attribs) override final;
+		// Implementation of IDeviceContext::DispatchComputeIndirect() in the null backend.
+		virtual void SHZ_CALL_TYPE DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::ClearDepthStencil() in the null backend.
+		virtual void SHZ_CALL_TYPE ClearDepthStencil(
+			ITextureView* pView,
+			CLEAR_DEPTH_STENCIL_FLAGS ClearFlags,
+			float fDepth,
+			uint8 Stencil,
+			RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
+
+		// Implementation of IDeviceContext::ClearRenderTarget() in the null backend.
+		virtual void SHZ_CALL_TYPE ClearRenderTarget(
+			ITextureView* pView,
+			const void* RGBA,
+			RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
+
+		// Implementation of IDeviceContext::UpdateBuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE UpdateBuffer(
+			IBuffer* pBuffer,
+			uint64 Offset,
+			uint64 Size,
+			const void* pData,
+			RESOURCE_STATE_TRANSITION_MODE StateTransitionMode) override final;
+
+		// Implementation of IDeviceContext::CopyBuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE CopyBuffer(
+			IBuffer* pSrcBuffer,
+			uint64 SrcOffset,
+			RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+			IBuffer* pDstBuffer,
+			uint64 DstOffset,
+			uint64 Size,
+			RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode) override final;
+
+		// Implementation of IDeviceContext::MapBuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE MapBuffer(
+			IBuffer* pBuffer,
+			MAP_TYPE MapType,
+			MAP_FLAGS MapFlags,
+			void*& pMappedData) override final;
+
+		// Implementation of IDeviceContext::UnmapBuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType) override final;
+
+		// Implementation of IDeviceContext::UpdateTexture() in the null backend.
+		virtual void SHZ_CALL_TYPE UpdateTexture(
+			ITexture* pTexture,
+			uint32 MipLevel,
+			uint32 Slice,
+			const IBox& DstBox,
+			const TextureSubResData& SubresData,
+			RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+			RESOURCE_STATE_TRANSITION_MODE TextureTransitionMode) override final;
+
+		// Implementation of IDeviceContext::CopyTexture() in the null backend.
+		virtual void SHZ_CALL_TYPE CopyTexture(const CopyTextureAttribs& CopyAttribs) override final;
+
+		// Implementation of IDeviceContext::MapTextureSubresource() in the null backend.
+		virtual void SHZ_CALL_TYPE MapTextureSubresource(
+			ITexture* pTexture,
+			uint32 MipLevel,
+			uint32 ArraySlice,
+			MAP_TYPE MapType,
+			MAP_FLAGS MapFlags,
+			const IBox* pMapRegion,
+			MappedTextureSubresource& MappedData) override final;
+
+		// Implementation of IDeviceContext::UnmapTextureSubresource() in the null backend.
+		virtual void SHZ_CALL_TYPE UnmapTextureSubresource(ITexture* pTexture, uint32 MipLevel, uint32 ArraySlice) override final;
+
+		// Implementation of IDeviceContext::GenerateMips() in the null backend.
+		virtual void SHZ_CALL_TYPE GenerateMips(ITextureView* pTexView) override final;
+
+		// Implementation of IDeviceContext::FinishFrame() in the null backend.
+		virtual void SHZ_CALL_TYPE FinishFrame() override final;
+
+		// Implementation of IDeviceContext::TransitionResourceStates() in the null backend.
+		virtual void SHZ_CALL_TYPE TransitionResourceStates(uint32 BarrierCount, const StateTransitionDesc* pResourceBarriers) override final;
+
+		// Implementation of IDeviceContext::ResolveTextureSubresource() in the null backend.
+		virtual void SHZ_CALL_TYPE ResolveTextureSubresource(ITexture* pSrcTexture, ITexture* pDstTexture, const ResolveTextureSubresourceAttribs& ResolveAttribs) override final;
+
+		// Implementation of IDeviceContext::FinishCommandList() in the null backend.
+		virtual void SHZ_CALL_TYPE FinishCommandList(ICommandList** ppCommandList) override final;
+
+		// Implementation of IDeviceContext::ExecuteCommandLists() in the null backend.
+		virtual void SHZ_CALL_TYPE ExecuteCommandLists(uint32 NumCommandLists, ICommandList* const* ppCommandLists) override final;
+
+		// Implementation of IDeviceContext::EnqueueSignal() in the null backend.
+		virtual void SHZ_CALL_TYPE EnqueueSignal(IFence* pFence, uint64 Value) override final;
+
+		// Implementation of IDeviceContext::DeviceWaitForFence() in the null backend.
+		virtual void SHZ_CALL_TYPE DeviceWaitForFence(IFence* pFence, uint64 Value) override final;
+
+		// Implementation of IDeviceContext::WaitForIdle() in the null backend.
+		virtual void SHZ_CALL_TYPE WaitForIdle() override final {}
+
+		// Implementation of IDeviceContext::BeginQuery() in the null backend.
+		virtual void SHZ_CALL_TYPE BeginQuery(IQuery* pQuery) override final;
+
+		// Implementation of IDeviceContext::EndQuery() in the null backend.
+		virtual void SHZ_CALL_TYPE EndQuery(IQuery* pQuery) override final;
+
+		// Implementation of IDeviceContext::Flush() in the null backend.
+		virtual void SHZ_CALL_TYPE Flush() override final;
+
+		// Implementation of IDeviceContext::BuildBLAS() in the null backend.
+		virtual void SHZ_CALL_TYPE BuildBLAS(const BuildBLASAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::BuildTLAS() in the null backend.
+		virtual void SHZ_CALL_TYPE BuildTLAS(const BuildTLASAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::CopyBLAS() in the null backend.
+		virtual void SHZ_CALL_TYPE CopyBLAS(const CopyBLASAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::CopyTLAS() in the null backend.
+		virtual void SHZ_CALL_TYPE CopyTLAS(const CopyTLASAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::WriteBLASCompactedSize() in the null backend.
+		virtual void SHZ_CALL_TYPE WriteBLASCompactedSize(const WriteBLASCompactedSizeAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::WriteTLASCompactedSize() in the null backend.
+		virtual void SHZ_CALL_TYPE WriteTLASCompactedSize(const WriteTLASCompactedSizeAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::TraceRays() in the null backend.
+		virtual void SHZ_CALL_TYPE TraceRays(const TraceRaysAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::TraceRaysIndirect() in the null backend.
+		virtual void SHZ_CALL_TYPE TraceRaysIndirect(const TraceRaysIndirectAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContext::UpdateSBT() in the null backend.
+		virtual void SHZ_CALL_TYPE UpdateSBT(IShaderBindingTable* pSBT, const UpdateIndirectRTBufferAttribs* pUpdateIndirectBufferAttribs) override final;
+
+		// Implementation of IDeviceContext::BeginDebugGroup() in the null backend.
+		virtual void SHZ_CALL_TYPE BeginDebugGroup(const Char* Name, const float* pColor) override final;
+
+		// Implementation of IDeviceContext::EndDebugGroup() in the null backend.
+		virtual void SHZ_CALL_TYPE EndDebugGroup() override final;
+
+		// Implementation of IDeviceContext::InsertDebugLabel() in the null backend.
+		virtual void SHZ_CALL_TYPE InsertDebugLabel(const Char* Label, const float* pColor) override final;
+
+		// Implementation of IDeviceContext::LockCommandQueue() in the null backend.
+		virtual ICommandQueue* SHZ_CALL_TYPE LockCommandQueue() override final { return nullptr; }
+
+		// Implementation of IDeviceContext::UnlockCommandQueue() in the null backend.
+		virtual void SHZ_CALL_TYPE UnlockCommandQueue() override final {}
+
+		// Implementation of IDeviceContext::SetShadingRate() in the null backend.
+		virtual void SHZ_CALL_TYPE SetShadingRate(
+			SHADING_RATE BaseRate,
+			SHADING_RATE_COMBINER PrimitiveCombiner,
+			SHADING_RATE_COMBINER TextureCombiner) override final;
+
+		// Implementation of IDeviceContext::BindSparseResourceMemory() in the null backend.
+		virtual void SHZ_CALL_TYPE BindSparseResourceMemory(const BindSparseResourceMemoryAttribs& Attribs) override final;
+
+		// Implementation of IDeviceContextNull::GetCommandStream().
+		virtual const NullCommand* SHZ_CALL_TYPE GetCommandStream(uint32& NumCommands) const override final;
+
+		// Implementation of IDeviceContextNull::GetCommandCounters().
+		virtual const NullCommandCounters& SHZ_CALL_TYPE GetCommandCounters() const override final { return m_Counters; }
+
+		// Implementation of IDeviceContextNull::ResetCommandStream().
+		virtual void SHZ_CALL_TYPE ResetCommandStream() override final;
+
+	private:
+		void record(NULL_COMMAND_TYPE Type, int32 ObjectId, uint32 Arg0 = 0, uint32 Arg1 = 0, uint32 Arg2 = 0, uint32 Arg3 = 0);
+
+		void transitionResource(IDeviceObject* pResource, RESOURCE_STATE NewState, RESOURCE_STATE_TRANSITION_MODE Mode);
+
+	private:
+		std::vector<NullCommand> m_Commands;
+		NullCommandCounters m_Counters;
+
+		FixedBlockMemoryAllocator m_CmdListAllocator;
+	};
+
+} // namespace shz
@@ -0,0 +1,272 @@
+ // \file
+ // Routines that initialize the null engine implementation
+
+#include "pch.h"
+
+#include "Engine/RHI_Null/Public/IEngineFactoryNull.h"
+
+#include <cstring>
+
+#include "RenderDeviceNullImpl.hpp"
+#include "DeviceContextNullImpl.hpp"
+#include "SwapChainNullImpl.hpp"
+#include "Engine/RHI/Public/EngineFactoryBase.hpp"
+#include "Engine/Core/Memory/Public/EngineMemory.h"
+
+namespace shz
+{
+
+	// Engine factory for the null implementation
+	class EngineFactoryNullImpl : public EngineFactoryBase<IEngineFactoryNull>
+	{
+	public:
+		static EngineFactoryNullImpl* GetInstance()
+		{
+			static EngineFactoryNullImpl TheFactory;
+			return &TheFactory;
+		}
+
+		using TBase = EngineFactoryBase<IEngineFactoryNull>;
+
+		EngineFactoryNullImpl()
+			: TBase{ IID_EngineFactoryNull }
+		{
+		}
+
+		virtual void SHZ_CALL_TYPE CreateDeviceAndContextsNull(
+			const EngineNullCreateInfo& EngineCI,
+			IRenderDevice** ppDevice,
+			IDeviceContext** ppContexts) override final;
+
+		virtual void SHZ_CALL_TYPE CreateSwapChainNull(
+			IRenderDevice* pDevice,
+			IDeviceContext* pImmediateContext,
+			const SwapChainDesc& SCDesc,
+			ISwapChain** ppSwapChain) override final;
+
+		virtual void SHZ_CALL_TYPE EnumerateAdapters(
+			Version MinFeatureLevel,
+			uint32& NumAdapters,
+			GraphicsAdapterInfo* Adapters) const override final;
+
+		virtual void SHZ_CALL_TYPE CreateDearchiver(
+			const DearchiverCreateInfo& CreateInfo,
+			IDearchiver** ppDearchiver) const override final;
+
+	private:
+		static GraphicsAdapterInfo GetNullAdapterInfo();
+	};
+
+	GraphicsAdapterInfo EngineFactoryNullImpl::GetNullAdapterInfo()
+	{
+		GraphicsAdapterInfo AdapterInfo;
+
+		strncpy(AdapterInfo.Description, "Null adapter", sizeof(AdapterInfo.Description) - 1);
+		AdapterInfo.Type = ADAPTER_TYPE_SOFTWARE;
+		AdapterInfo.Vendor = ADAPTER_VENDOR_UNKNOWN;
+
+		// Everything the renderer may query is reported as supported, except for the features
+		// whose objects the null device does not implement.
+		AdapterInfo.Features = DeviceFeatures{ DEVICE_FEATURE_STATE_ENABLED };
+		AdapterInfo.Features.RayTracing = DEVICE_FEATURE_STATE_DISABLED;
+		AdapterInfo.Features.SparseResources = DEVICE_FEATURE_STATE_DISABLED;
+		AdapterInfo.Features.VariableRateShading = DEVICE_FEATURE_STATE_DISABLED;
+		AdapterInfo.Features.TileShaders = DEVICE_FEATURE_STATE_DISABLED;
+		AdapterInfo.Features.SubpassFramebufferFetch = DEVICE_FEATURE_STATE_DISABLED;
+		AdapterInfo.Features.TextureComponentSwizzle = DEVICE_FEATURE_STATE_DISABLED;
+
+		{
+			TextureProperties& TexProps = AdapterInfo.Texture;
+			TexProps.MaxTexture1DDimension = 16384;
+			TexProps.MaxTexture1DArraySlices = 2048;
+			TexProps.MaxTexture2DDimension = 16384;
+			TexProps.MaxTexture2DArraySlices = 2048;
+			TexProps.MaxTexture3DDimension = 2048;
+			TexProps.MaxTextureCubeDimension = 16384;
+			TexProps.Texture2DMSSupported = true;
+			TexProps.Texture2DMSArraySupported = true;
+			TexProps.TextureViewSupported = true;
+			TexProps.CubemapArraysSupported = true;
+			TexProps.TextureView2DOn3DSupported = true;
+		}
+
+		{
+			BufferProperties& BufProps = AdapterInfo.Buffer;
+			BufProps.ConstantBufferOffsetAlignment = 256;
+			BufProps.StructuredBufferOffsetAlignment = 16;
+		}
+
+		{
+			SamplerProperties& SamProps = AdapterInfo.Sampler;
+			SamProps.BorderSamplingModeSupported = true;
+			SamProps.MaxAnisotropy = 16;
+			SamProps.LODBiasSupported = true;
+		}
+
+		{
+			ComputeShaderProperties& CompProps = AdapterInfo.ComputeShader;
+			CompProps.SharedMemorySize = 32768;
+			CompProps.MaxThreadGroupInvocations = 1024;
+			CompProps.MaxThreadGroupSizeX = 1024;
+			CompProps.MaxThreadGroupSizeY = 1024;
+			CompProps.MaxThreadGroupSizeZ = 64;
+			CompProps.MaxThreadGroupCountX = 65535;
+			CompProps.MaxThreadGroupCountY = 65535;
+			CompProps.MaxThreadGroupCountZ = 65535;
+		}
+
+		{
+			DrawCommandProperties& DrawCommandProps = AdapterInfo.DrawCommand;
+			DrawCommandProps.CapFlags =
+				DRAW_COMMAND_CAP_FLAG_BASE_VERTEX |
+				DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT |
+				DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_FIRST_INSTANCE;
+			DrawCommandProps.MaxIndexValue = ~0u;
+			DrawCommandProps.MaxDrawIndirectCount = ~0u;
+		}
+
+		// Single graphics queue
+		AdapterInfo.NumQueues = 1;
+		AdapterInfo.Queues[0].QueueType = COMMAND_QUEUE_TYPE_GRAPHICS;
+		AdapterInfo.Queues[0].MaxDeviceContexts = 1;
+		AdapterInfo.Queues[0].TextureCopyGranularity[0] = 1;
+		AdapterInfo.Queues[0].TextureCopyGranularity[1] = 1;
+		AdapterInfo.Queues[0].TextureCopyGranularity[2] = 1;
+
+		return AdapterInfo;
+	}
+
+	void EngineFactoryNullImpl::EnumerateAdapters(Version MinFeatureLevel,
+		uint32& NumAdapters,
+		GraphicsAdapterInfo* Adapters) const
+	{
+		if (Adapters == nullptr)
+		{
+			NumAdapters = 1;
+			return;
+		}
+
+		if (NumAdapters > 0)
+		{
+			Adapters[0] = GetNullAdapterInfo();
+			NumAdapters = 1;
+		}
+	}
+
+	void EngineFactoryNullImpl::CreateDearchiver(const DearchiverCreateInfo& CreateInfo,
+		IDearchiver** ppDearchiver) const
+	{
+		if (ppDearchiver != nullptr)
+			*ppDearchiver = nullptr;
+
+		LOG_ERROR_MESSAGE("Device object archives are not supported by the null backend");
+	}
+
+	void EngineFactoryNullImpl::CreateDeviceAndContextsNull(
+		const EngineNullCreateInfo& EngineCI,
+		IRenderDevice** ppDevice,
+		IDeviceContext** ppContexts)
+	{
+		ASSERT(ppDevice && ppContexts, "Null pointer provided");
+		if (!ppDevice || !ppContexts)
+			return;
+
+		ImmediateContextCreateInfo DefaultImmediateCtxCI;
+
+		const uint32                            NumImmediateContexts = EngineCI.NumImmediateContexts > 0 ? EngineCI.NumImmediateContexts : 1;
+		const ImmediateContextCreateInfo* const pImmediateContextInfo = EngineCI.NumImmediateContexts > 0 ? EngineCI.pImmediateContextInfo : &DefaultImmediateCtxCI;
+
+		*ppDevice = nullptr;
+		memset(ppContexts, 0, sizeof(*ppContexts) * (size_t{ NumImmediateContexts } + size_t{ EngineCI.NumDeferredContexts }));
+
+		try
+		{
+			IMemoryAllocator& RawMemAllocator = GetRawAllocator();
+
+			const GraphicsAdapterInfo AdapterInfo = GetNullAdapterInfo();
+			VerifyEngineCreateInfo(EngineCI, AdapterInfo);
+
+			RenderDeviceNullImpl* pRenderDeviceNull{
+				NEW_RC_OBJ(RawMemAllocator, "RenderDeviceNullImpl instance", RenderDeviceNullImpl)(RawMemAllocator, this, EngineCI, AdapterInfo) };
+			pRenderDeviceNull->QueryInterface(IID_RenderDevice, ppDevice);
+
+			for (uint32 CtxInd = 0; CtxInd < NumImmediateContexts; ++CtxInd)
+			{
+				RefCntAutoPtr<DeviceContextNullImpl> pImmediateCtxNull{
+					NEW_RC_OBJ(RawMemAllocator, "DeviceContextNullImpl instance", DeviceContextNullImpl)(
+						pRenderDeviceNull,
+						DeviceContextDesc{
+							pImmediateContextInfo[CtxInd].Name,
+							COMMAND_QUEUE_TYPE_GRAPHICS,
+							false,   // IsDeferred
+							CtxInd,  // Context index
+							0}       // Queue index
+						) };
+				// The device keeps a weak reference to the context
+				pImmediateCtxNull->QueryInterface(IID_DeviceContext, ppContexts + CtxInd);
+				pRenderDeviceNull->SetImmediateContext(CtxInd, pImmediateCtxNull);
+			}
+
+			for (uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+			{
+				pRenderDeviceNull->CreateDeferredContext(ppContexts + NumImmediateContexts + DeferredCtx);
+			}
+		}
+		catch (const std::runtime_error&)
+		{
+			if (*ppDevice)
+			{
+				(*ppDevice)->Release();
+				*ppDevice = nullptr;
+			}
+			for (uint32 ctx = 0; ctx < NumImmediateContexts + EngineCI.NumDeferredContexts; ++ctx)
+			{
+				if (ppContexts[ctx] != nullptr)
+				{
+					ppContexts[ctx]->Release();
+					ppContexts[ctx] = nullptr;
+				}
+			}
+
+			LOG_ERROR("Failed to create device and contexts");
+		}
+	}
+
+	void EngineFactoryNullImpl::CreateSwapChainNull(IRenderDevice* pDevice,
+		IDeviceContext* pImmediateContext,
+		const SwapChainDesc& SCDesc,
+		ISwapChain** ppSwapChain)
+	{
+		ASSERT(ppSwapChain, "Null pointer provided");
+		if (!ppSwapChain)
+			return;
+
+		*ppSwapChain = nullptr;
+
+		try
+		{
+			RenderDeviceNullImpl* pDeviceNull = ClassPtrCast<RenderDeviceNullImpl>(pDevice);
+			DeviceContextNullImpl* pDeviceContextNull = ClassPtrCast<DeviceContextNullImpl>(pImmediateContext);
+			IMemoryAllocator& RawMemAllocator = GetRawAllocator();
+
+			SwapChainNullImpl* pSwapChainNull = NEW_RC_OBJ(RawMemAllocator, "SwapChainNullImpl instance", SwapChainNullImpl)(SCDesc, pDeviceNull, pDeviceContextNull);
+			pSwapChainNull->QueryInterface(IID_SwapChain, ppSwapChain);
+		}
+		catch (const std::runtime_error&)
+		{
+			if (*ppSwapChain)
+			{
+				(*ppSwapChain)->Release();
+				*ppSwapChain = nullptr;
+			}
+
+			LOG_ERROR("Failed to create the swap chain");
+		}
+	}
+
+	IEngineFactoryNull* GetEngineFactoryNull()
+	{
+		return EngineFactoryNullImpl::GetInstance();
+	}
+
+} // namespace shz
@@ -0,0 +1,111 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::EngineNullImplTraits struct
+
+#include "Engine/RHI/Interface/IRenderDevice.h"
+#include "Engine/RHI/Interface/IPipelineState.h"
+#include "Engine/RHI/Interface/IShaderResourceBinding.h"
+#include "Engine/RHI/Interface/IBuffer.h"
+#include "Engine/RHI/Interface/IBufferView.h"
+#include "Engine/RHI/Interface/ITexture.h"
+#include "Engine/RHI/Interface/ITextureView.h"
+#include "Engine/RHI/Interface/IShader.h"
+#include "Engine/RHI/Interface/ISampler.h"
+#include "Engine/RHI/Interface/IFence.h"
+#include "Engine/RHI/Interface/IQuery.h"
+#include "Engine/RHI/Interface/IRenderPass.h"
+#include "Engine/RHI/Interface/IFramebuffer.h"
+#include "Engine/RHI/Interface/ICommandList.h"
+#include "Engine/RHI/Interface/IBottomLevelAS.h"
+#include "Engine/RHI/Interface/ITopLevelAS.h"
+#include "Engine/RHI/Interface/IShaderBindingTable.h"
+#include "Engine/RHI/Interface/IPipelineResourceSignature.h"
+#include "Engine/RHI/Interface/IDeviceMemory.h"
+#include "Engine/RHI/Interface/IPipelineStateCache.h"
+#include "Engine/RHI/Interface/ICommandQueue.h"
+#include "Engine/RHI_D3DBase/Public/ShaderD3D.h"
+#include "Engine/RHI_Null/Public/IDeviceContextNull.h"
+
+namespace shz
+{
+
+	class RenderDeviceNullImpl;
+	class DeviceContextNullImpl;
+	class PipelineStateNullImpl;
+	class ShaderResourceBindingNullImpl;
+	class BufferNullImpl;
+	class BufferViewNullImpl;
+	class TextureNullImpl;
+	class TextureViewNullImpl;
+	class ShaderNullImpl;
+	class SamplerNullImpl;
+	class FenceNullImpl;
+	class QueryNullImpl;
+	class RenderPassNullImpl;
+	class FramebufferNullImpl;
+	class CommandListNullImpl;
+
+	class FixedBlockMemoryAllocator;
+
+	// Placeholder for object types the null backend does not implement
+	// (ray tracing, resource signatures, device memory, PSO caches).
+	class NullObjectStub
+	{};
+
+	struct EngineNullImplTraits
+	{
+		static constexpr RENDER_DEVICE_TYPE DeviceType = RENDER_DEVICE_TYPE_UNDEFINED;
+
+		using RenderDeviceInterface = IRenderDevice;
+		using DeviceContextInterface = IDeviceContextNull;
+		using PipelineStateInterface = IPipelineState;
+		using ShaderResourceBindingInterface = IShaderResourceBinding;
+		using BufferInterface = IBuffer;
+		using BufferViewInterface = IBufferView;
+		using TextureInterface = ITexture;
+		using TextureViewInterface = ITextureView;
+		using ShaderInterface = IShaderD3D;
+		using SamplerInterface = ISampler;
+		using FenceInterface = IFence;
+		using QueryInterface = IQuery;
+		using RenderPassInterface = IRenderPass;
+		using FramebufferInterface = IFramebuffer;
+		using CommandListInterface = ICommandList;
+		using BottomLevelASInterface = IBottomLevelAS;
+		using TopLevelASInterface = ITopLevelAS;
+		using ShaderBindingTableInterface = IShaderBindingTable;
+		using PipelineResourceSignatureInterface = IPipelineResourceSignature;
+		using CommandQueueInterface = ICommandQueue;
+		using DeviceMemoryInterface = IDeviceMemory;
+		using PipelineStateCacheInterface = IPipelineStateCache;
+
+		using RenderDeviceImplType = RenderDeviceNullImpl;
+		using DeviceContextImplType = DeviceContextNullImpl;
+		using PipelineStateImplType = PipelineStateNullImpl;
+		using ShaderResourceBindingImplType = ShaderResourceBindingNullImpl;
+		using BufferImplType = BufferNullImpl;
+		using BufferViewImplType = BufferViewNullImpl;
+		using TextureImplType = TextureNullImpl;
+		using TextureViewImplType = TextureViewNullImpl;
+		using ShaderImplType = ShaderNullImpl;
+		using SamplerImplType = SamplerNullImpl;
+		using FenceImplType = FenceNullImpl;
+		using QueryImplType = QueryNullImpl;
+		using RenderPassImplType = RenderPassNullImpl;
+		using FramebufferImplType = FramebufferNullImpl;
+		using CommandListImplType = CommandListNullImpl;
+		using BottomLevelASImplType = NullObjectStub;
+		using TopLevelASImplType = NullObjectStub;
+		using ShaderBindingTableImplType = NullObjectStub;
+		using PipelineResourceSignatureImplType = NullObjectStub;
+		using DeviceMemoryImplType = NullObjectStub;
+		using PipelineStateCacheImplType = NullObjectStub;
+
+		using BuffViewObjAllocatorType = FixedBlockMemoryAllocator;
+		using TexViewObjAllocatorType = FixedBlockMemoryAllocator;
+
+		using ShaderResourceCacheImplType = NullObjectStub;
+	};
+
+} // namespace shz
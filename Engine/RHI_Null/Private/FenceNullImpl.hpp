@@ -0,0 +1,47 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::FenceNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/FenceBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Fence implementation in the null backend.
+
+	// There is no GPU timeline: a value is complete as soon as it is signaled,
+	// either from the CPU or through IDeviceContext::EnqueueSignal().
+	class FenceNullImpl final : public FenceBase<EngineNullImplTraits>
+	{
+	public:
+		using TFenceBase = FenceBase<EngineNullImplTraits>;
+
+		FenceNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const FenceDesc& Desc)
+			: TFenceBase{ pRefCounters, pDevice, Desc }
+		{
+		}
+
+		// Implementation of IFence::GetCompletedValue() in the null backend.
+		virtual uint64 SHZ_CALL_TYPE GetCompletedValue() override final
+		{
+			return m_LastCompletedFenceValue.load();
+		}
+
+		// Implementation of IFence::Signal() in the null backend.
+		virtual void SHZ_CALL_TYPE Signal(uint64 Value) override final
+		{
+			DvpSignal(Value);
+			UpdateLastCompletedFenceValue(Value);
+		}
+
+		// Implementation of IFence::Wait() in the null backend.
+		virtual void SHZ_CALL_TYPE Wait(uint64 Value) override final
+		{
+			ASSERT(Value <= m_LastCompletedFenceValue.load(), "Waiting for fence value ", Value, " that has never been signaled will never complete");
+		}
+	};
+
+} // namespace shz
@@ -0,0 +1,25 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::FramebufferNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/FramebufferBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Framebuffer implementation in the null backend.
+	class FramebufferNullImpl final : public FramebufferBase<EngineNullImplTraits>
+	{
+	public:
+		using TFramebufferBase = FramebufferBase<EngineNullImplTraits>;
+
+		FramebufferNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const FramebufferDesc& Desc)
+			: TFramebufferBase{ pRefCounters, pDevice, Desc }
+		{
+		}
+	};
+
+} // namespace shz
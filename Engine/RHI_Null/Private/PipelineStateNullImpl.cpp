@@ -0,0 +1,339 @@
+#include "pch.h"
+#include "PipelineStateNullImpl.hpp"
+
+#include <cstring>
+
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "ShaderNullImpl.hpp"
+#include "Engine/RHI/Interface/IResourceMapping.h"
+
+namespace shz
+{
+
+	constexpr INTERFACE_ID PipelineStateNullImpl::IID_InternalImpl;
+
+	namespace
+	{
+		static void addShaderStage(SHADER_TYPE& Stages, const IShader* pShader)
+		{
+			if (pShader != nullptr)
+				Stages |= pShader->GetDesc().ShaderType;
+		}
+
+		static bool matchesBindFlags(SHADER_RESOURCE_VARIABLE_TYPE Type, BIND_SHADER_RESOURCES_FLAGS Flags)
+		{
+			if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
+				Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
+
+			return (Flags & (1u << Type)) != 0;
+		}
+	} // namespace
+
+	PipelineStateNullImpl::PipelineStateNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const GraphicsPipelineStateCreateInfo& CreateInfo)
+		: TDeviceObjectBase{ pRefCounters, pDevice, CreateInfo.PSODesc }
+		, m_GraphicsPipeline{ CreateInfo.GraphicsPipeline }
+		, m_pRenderPass{ CreateInfo.GraphicsPipeline.pRenderPass }
+		, m_StaticVariables{ *this }
+	{
+		ASSERT(m_Desc.IsAnyGraphicsPipeline(), "Graphics pipeline is expected");
+
+		addShaderStage(m_ActiveStages, CreateInfo.pVS);
+		addShaderStage(m_ActiveStages, CreateInfo.pPS);
+		addShaderStage(m_ActiveStages, CreateInfo.pDS);
+		addShaderStage(m_ActiveStages, CreateInfo.pHS);
+		addShaderStage(m_ActiveStages, CreateInfo.pGS);
+		addShaderStage(m_ActiveStages, CreateInfo.pAS);
+		addShaderStage(m_ActiveStages, CreateInfo.pMS);
+
+		const InputLayoutDesc& InputLayout = CreateInfo.GraphicsPipeline.InputLayout;
+		m_LayoutElements.assign(InputLayout.LayoutElements, InputLayout.LayoutElements + InputLayout.NumElements);
+		m_LayoutSemantics.reserve(m_LayoutElements.size());
+		for (LayoutElement& Elem : m_LayoutElements)
+		{
+			m_LayoutSemantics.emplace_back(Elem.HLSLSemantic != nullptr ? Elem.HLSLSemantic : "ATTRIB");
+			Elem.HLSLSemantic = m_LayoutSemantics.back().c_str();
+		}
+		m_GraphicsPipeline.InputLayout.LayoutElements = m_LayoutElements.empty() ? nullptr : m_LayoutElements.data();
+		m_GraphicsPipeline.InputLayout.NumElements = static_cast<uint32>(m_LayoutElements.size());
+
+		initResourceLayout(CreateInfo, { CreateInfo.pVS, CreateInfo.pPS, CreateInfo.pDS, CreateInfo.pHS, CreateInfo.pGS, CreateInfo.pAS, CreateInfo.pMS });
+	}
+
+	PipelineStateNullImpl::PipelineStateNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const ComputePipelineStateCreateInfo& CreateInfo)
+		: TDeviceObjectBase{ pRefCounters, pDevice, CreateInfo.PSODesc }
+		, m_StaticVariables{ *this }
+	{
+		ASSERT(m_Desc.IsComputePipeline(), "Compute pipeline is expected");
+
+		addShaderStage(m_ActiveStages, CreateInfo.pCS);
+		initResourceLayout(CreateInfo, { CreateInfo.pCS });
+	}
+
+	PipelineStateNullImpl::~PipelineStateNullImpl()
+	{
+	}
+
+	void PipelineStateNullImpl::initResourceLayout(const PipelineStateCreateInfo& CreateInfo, std::initializer_list<IShader*> Shaders)
+	{
+		if (CreateInfo.ResourceSignaturesCount != 0)
+		{
+			LOG_ERROR_AND_THROW("Pipeline '", m_Desc.Name, "': explicit resource signatures are not supported by the null backend");
+		}
+
+		const PipelineResourceLayoutDesc& ResourceLayout = CreateInfo.PSODesc.ResourceLayout;
+
+		// Own the variable names: the create info only lives for the duration of the call.
+		m_LayoutVariables.reserve(ResourceLayout.NumVariables);
+		for (uint32 i = 0; i < ResourceLayout.NumVariables; ++i)
+		{
+			const ShaderResourceVariableDesc& Var = ResourceLayout.Variables[i];
+			m_LayoutVariables.push_back({ Var.ShaderStages, Var.Name, Var.Type });
+		}
+
+		m_LayoutVariableDescs.reserve(ResourceLayout.NumVariables);
+		for (uint32 i = 0; i < ResourceLayout.NumVariables; ++i)
+		{
+			ShaderResourceVariableDesc VarDesc = ResourceLayout.Variables[i];
+			VarDesc.Name = m_LayoutVariables[i].Name.c_str();
+			m_LayoutVariableDescs.push_back(VarDesc);
+		}
+
+		m_Desc.ResourceLayout.Variables = m_LayoutVariableDescs.empty() ? nullptr : m_LayoutVariableDescs.data();
+		m_Desc.ResourceLayout.NumVariables = static_cast<uint32>(m_LayoutVariableDescs.size());
+
+		for (IShader* pShader : Shaders)
+		{
+			if (pShader != nullptr)
+				reflectShader(pShader, ResourceLayout);
+		}
+
+		for (const ReflectedResource& Res : m_Resources)
+		{
+			if (Res.VarType == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+			{
+				const ShaderResourceDesc ResDesc = Res.GetDesc();
+				m_StaticVariables.GetOrCreateVariable(Res.ShaderStage, Res.Name.c_str(), Res.VarType, &ResDesc);
+			}
+		}
+
+		// Immutable samplers have been applied above and are not kept.
+		m_Desc.ResourceLayout.ImmutableSamplers = nullptr;
+		m_Desc.ResourceLayout.NumImmutableSamplers = 0;
+	}
+
+	void PipelineStateNullImpl::reflectShader(IShader* pShader, const PipelineResourceLayoutDesc& ResourceLayout)
+	{
+		RefCntAutoPtr<ShaderNullImpl> pShaderNull{ pShader, ShaderNullImpl::IID_InternalImpl };
+		if (!pShaderNull)
+			return;
+
+		if (pShaderNull->GetStatus(/*WaitForCompletion = */ true) != SHADER_STATUS_READY)
+		{
+			LOG_ERROR_AND_THROW("Pipeline '", m_Desc.Name, "': shader '", pShader->GetDesc().Name, "' failed to compile");
+		}
+
+		const ShaderDesc& ShDesc = pShader->GetDesc();
+		const SHADER_TYPE Stage = ShDesc.ShaderType;
+		const Char* SamplerSuffix = ShDesc.UseCombinedTextureSamplers ? ShDesc.CombinedSamplerSuffix : nullptr;
+
+		// With combined texture samplers a sampler follows its texture: it takes the
+		// texture's variable type and is covered by the texture's immutable sampler.
+		auto getAssignedName = [SamplerSuffix](const std::string& Name, SHADER_RESOURCE_TYPE Type) {
+			if (Type != SHADER_RESOURCE_TYPE_SAMPLER || SamplerSuffix == nullptr)
+				return Name;
+
+			const size_t SuffixLen = strlen(SamplerSuffix);
+			if (Name.size() > SuffixLen && Name.compare(Name.size() - SuffixLen, SuffixLen, SamplerSuffix) == 0)
+				return Name.substr(0, Name.size() - SuffixLen);
+
+			return Name;
+		};
+
+		const uint32 ResCount = pShaderNull->GetResourceCount();
+		for (uint32 r = 0; r < ResCount; ++r)
+		{
+			ShaderResourceDesc ResDesc;
+			pShaderNull->GetResourceDesc(r, ResDesc);
+
+			ReflectedResource Res{ Stage, ResDesc.Name, ResDesc.Type, ResDesc.ArraySize };
+			const std::string AssignedName = getAssignedName(Res.Name, Res.Type);
+
+			if (Res.Type == SHADER_RESOURCE_TYPE_SAMPLER)
+			{
+				bool bImmutable = false;
+				for (uint32 s = 0; s < ResourceLayout.NumImmutableSamplers && !bImmutable; ++s)
+				{
+					const ImmutableSamplerDesc& ImtblSam = ResourceLayout.ImmutableSamplers[s];
+					bImmutable = (ImtblSam.ShaderStages & Stage) != 0 && ImtblSam.SamplerOrTextureName != nullptr &&
+						(Res.Name == ImtblSam.SamplerOrTextureName || AssignedName == ImtblSam.SamplerOrTextureName);
+				}
+				if (bImmutable)
+					continue;
+			}
+
+			Res.VarType = GetVariableType(Stage, AssignedName.c_str());
+			m_Resources.push_back(std::move(Res));
+		}
+
+		m_ReflectedStages |= Stage;
+	}
+
+	SHADER_RESOURCE_VARIABLE_TYPE PipelineStateNullImpl::GetVariableType(SHADER_TYPE ShaderType, const Char* Name) const
+	{
+		for (const LayoutVariable& Var : m_LayoutVariables)
+		{
+			if ((Var.ShaderStages & ShaderType) != 0 && Var.Name == Name)
+				return Var.Type;
+		}
+		return m_Desc.ResourceLayout.DefaultVariableType;
+	}
+
+	const GraphicsPipelineDesc& PipelineStateNullImpl::GetGraphicsPipelineDesc() const
+	{
+		ASSERT(m_Desc.IsAnyGraphicsPipeline(), "This is not a graphics pipeline");
+		return m_GraphicsPipeline;
+	}
+
+	const RayTracingPipelineDesc& PipelineStateNullImpl::GetRayTracingPipelineDesc() const
+	{
+		ASSERT(false, "Ray tracing pipelines are not supported by the null backend");
+		static const RayTracingPipelineDesc NullDesc{};
+		return NullDesc;
+	}
+
+	const TilePipelineDesc& PipelineStateNullImpl::GetTilePipelineDesc() const
+	{
+		ASSERT(false, "Tile pipelines are not supported by the null backend");
+		static const TilePipelineDesc NullDesc{};
+		return NullDesc;
+	}
+
+	void PipelineStateNullImpl::BindStaticResources(SHADER_TYPE ShaderStages, IResourceMapping* pResourceMapping, BIND_SHADER_RESOURCES_FLAGS Flags)
+	{
+		if (pResourceMapping == nullptr)
+			return;
+
+		if (!matchesBindFlags(SHADER_RESOURCE_VARIABLE_TYPE_STATIC, Flags))
+			return;
+
+		// Reflected stages already have all their static variables. In the other stages only
+		// names declared in the layout are known before they are requested.
+		for (const LayoutVariable& Var : m_LayoutVariables)
+		{
+			if (Var.Type != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+				continue;
+
+			for (SHADER_TYPE Stages = Var.ShaderStages & ShaderStages & m_ActiveStages & ~m_ReflectedStages; Stages != SHADER_TYPE_UNKNOWN;)
+				m_StaticVariables.GetOrCreateVariable(ExtractLSB(Stages), Var.Name.c_str(), Var.Type);
+		}
+
+		for (SHADER_TYPE Stages = ShaderStages & m_ActiveStages; Stages != SHADER_TYPE_UNKNOWN;)
+		{
+			const SHADER_TYPE Stage = ExtractLSB(Stages);
+			const uint32 NumVars = m_StaticVariables.GetVariableCount(Stage);
+			for (uint32 v = 0; v < NumVars; ++v)
+			{
+				ShaderVariableNullImpl* pVar = m_StaticVariables.GetVariableByIndex(Stage, v);
+				if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) != 0 && pVar->Get(0) != nullptr)
+					continue;
+
+				if (IDeviceObject* pObj = pResourceMapping->GetResource(pVar->GetName().c_str()))
+					pVar->Set(pObj, SET_SHADER_RESOURCE_FLAG_NONE);
+			}
+		}
+	}
+
+	uint32 PipelineStateNullImpl::GetStaticVariableCount(SHADER_TYPE ShaderType) const
+	{
+		return m_StaticVariables.GetVariableCount(ShaderType);
+	}
+
+	IShaderResourceVariable* PipelineStateNullImpl::GetStaticVariableByName(SHADER_TYPE ShaderType, const Char* Name)
+	{
+		if ((ShaderType & m_ActiveStages) == 0)
+			return nullptr;
+
+		if ((ShaderType & m_ReflectedStages) != 0)
+			return m_StaticVariables.FindVariable(ShaderType, Name);
+
+		if (GetVariableType(ShaderType, Name) != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+			return nullptr;
+
+		return m_StaticVariables.GetOrCreateVariable(ShaderType, Name, SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+	}
+
+	IShaderResourceVariable* PipelineStateNullImpl::GetStaticVariableByIndex(SHADER_TYPE ShaderType, uint32 Index)
+	{
+		return m_StaticVariables.GetVariableByIndex(ShaderType, Index);
+	}
+
+	void PipelineStateNullImpl::CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources)
+	{
+		ShaderResourceBindingNullImpl* pSRB = NEW_RC_OBJ(GetDevice()->GetSRBAllocator(), "ShaderResourceBindingNullImpl instance", ShaderResourceBindingNullImpl)(this);
+		pSRB->QueryInterface(IID_ShaderResourceBinding, reinterpret_cast<IObject**>(ppShaderResourceBinding));
+
+		if (InitStaticResources)
+			InitializeStaticSRBResources(pSRB);
+	}
+
+	void PipelineStateNullImpl::InitializeStaticSRBResources(IShaderResourceBinding* pShaderResourceBinding) const
+	{
+		ASSERT(pShaderResourceBinding != nullptr, "SRB must not be null");
+
+		ShaderResourceBindingNullImpl* pSRB = ClassPtrCast<ShaderResourceBindingNullImpl>(pShaderResourceBinding);
+		if (pSRB->StaticResourcesInitialized())
+		{
+			LOG_WARNING_MESSAGE("Static resources have already been initialized in this shader resource binding object.");
+			return;
+		}
+
+		m_StaticVariables.CopyBindings(pSRB->GetVariables(), SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+		pSRB->SetStaticResourcesInitialized();
+	}
+
+	void PipelineStateNullImpl::CopyStaticResources(IPipelineState* pDstPipeline) const
+	{
+		ASSERT(pDstPipeline != nullptr, "Destination pipeline must not be null");
+
+		PipelineStateNullImpl* pDstPSO = ClassPtrCast<PipelineStateNullImpl>(pDstPipeline);
+		m_StaticVariables.CopyBindings(pDstPSO->m_StaticVariables, SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+	}
+
+	bool PipelineStateNullImpl::IsCompatibleWith(const IPipelineState* pPSO) const
+	{
+		ASSERT(pPSO != nullptr, "pPSO must not be null");
+
+		if (pPSO == this)
+			return true;
+
+		RefCntAutoPtr<PipelineStateNullImpl> pPSONull{ const_cast<IPipelineState*>(pPSO), IID_InternalImpl };
+		if (!pPSONull)
+			return false;
+
+		if (m_Desc.ResourceLayout.DefaultVariableType != pPSONull->m_Desc.ResourceLayout.DefaultVariableType ||
+			m_LayoutVariables.size() != pPSONull->m_LayoutVariables.size() ||
+			m_ReflectedStages != pPSONull->m_ReflectedStages ||
+			m_Resources.size() != pPSONull->m_Resources.size())
+			return false;
+
+		for (size_t i = 0; i < m_Resources.size(); ++i)
+		{
+			const ReflectedResource& Res0 = m_Resources[i];
+			const ReflectedResource& Res1 = pPSONull->m_Resources[i];
+			if (Res0.ShaderStage != Res1.ShaderStage || Res0.Type != Res1.Type || Res0.ArraySize != Res1.ArraySize ||
+				Res0.VarType != Res1.VarType || Res0.Name != Res1.Name)
+				return false;
+		}
+
+		for (size_t i = 0; i < m_LayoutVariables.size(); ++i)
+		{
+			const LayoutVariable& Var0 = m_LayoutVariables[i];
+			const LayoutVariable& Var1 = pPSONull->m_LayoutVariables[i];
+			if (Var0.ShaderStages != Var1.ShaderStages || Var0.Type != Var1.Type || Var0.Name != Var1.Name)
+				return false;
+		}
+
+		return true;
+	}
+
+} // namespace shz
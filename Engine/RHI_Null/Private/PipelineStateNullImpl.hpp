@@ -0,0 +1,134 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::PipelineStateNullImpl class
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/DeviceObjectBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+#include "ShaderVariableNullImpl.hpp"
+
+namespace shz
+{
+
+	// Pipeline state object implementation in the null backend.
+
+	// Resources are taken from the reflection of the null shaders, so static variables exist
+	// as soon as the pipeline is created and every SRB starts with its mutable and dynamic
+	// ones, as with the D3D12 backend. The resource layout gives each resource its variable
+	// type; names it does not list get ResourceLayout.DefaultVariableType.
+	// Stages whose shader is not a null shader have no reflection: their variables are the
+	// ones declared in the layout plus any other name, created on first access.
+	class PipelineStateNullImpl final : public DeviceObjectBase<IPipelineState, RenderDeviceNullImpl, PipelineStateDesc>
+	{
+	public:
+		using TDeviceObjectBase = DeviceObjectBase<IPipelineState, RenderDeviceNullImpl, PipelineStateDesc>;
+
+		// {8F1D2C6B-47A0-4E3B-A5C9-0D6E71B3F248}
+		static constexpr INTERFACE_ID IID_InternalImpl =
+		{ 0x8f1d2c6b, 0x47a0, 0x4e3b, {0xa5, 0xc9, 0xd, 0x6e, 0x71, 0xb3, 0xf2, 0x48} };
+
+		PipelineStateNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const GraphicsPipelineStateCreateInfo& CreateInfo);
+		PipelineStateNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const ComputePipelineStateCreateInfo& CreateInfo);
+		~PipelineStateNullImpl();
+
+		IMPLEMENT_QUERY_INTERFACE2_IN_PLACE(IID_PipelineState, IID_InternalImpl, TDeviceObjectBase);
+
+		// Implementation of IPipelineState::GetGraphicsPipelineDesc() in the null backend.
+		virtual const GraphicsPipelineDesc& SHZ_CALL_TYPE GetGraphicsPipelineDesc() const override final;
+
+		// Implementation of IPipelineState::GetRayTracingPipelineDesc() in the null backend.
+		virtual const RayTracingPipelineDesc& SHZ_CALL_TYPE GetRayTracingPipelineDesc() const override final;
+
+		// Implementation of IPipelineState::GetTilePipelineDesc() in the null backend.
+		virtual const TilePipelineDesc& SHZ_CALL_TYPE GetTilePipelineDesc() const override final;
+
+		// Implementation of IPipelineState::BindStaticResources() in the null backend.
+		virtual void SHZ_CALL_TYPE BindStaticResources(SHADER_TYPE ShaderStages, IResourceMapping* pResourceMapping, BIND_SHADER_RESOURCES_FLAGS Flags) override final;
+
+		// Implementation of IPipelineState::GetStaticVariableCount() in the null backend.
+		virtual uint32 SHZ_CALL_TYPE GetStaticVariableCount(SHADER_TYPE ShaderType) const override final;
+
+		// Implementation of IPipelineState::GetStaticVariableByName() in the null backend.
+		virtual IShaderResourceVariable* SHZ_CALL_TYPE GetStaticVariableByName(SHADER_TYPE ShaderType, const Char* Name) override final;
+
+		// Implementation of IPipelineState::GetStaticVariableByIndex() in the null backend.
+		virtual IShaderResourceVariable* SHZ_CALL_TYPE GetStaticVariableByIndex(SHADER_TYPE ShaderType, uint32 Index) override final;
+
+		// Implementation of IPipelineState::CreateShaderResourceBinding() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateShaderResourceBinding(IShaderResourceBinding** ppShaderResourceBinding, bool InitStaticResources) override final;
+
+		// Implementation of IPipelineState::InitializeStaticSRBResources() in the null backend.
+		virtual void SHZ_CALL_TYPE InitializeStaticSRBResources(IShaderResourceBinding* pShaderResourceBinding) const override final;
+
+		// Implementation of IPipelineState::CopyStaticResources() in the null backend.
+		virtual void SHZ_CALL_TYPE CopyStaticResources(IPipelineState* pDstPipeline) const override final;
+
+		// Implementation of IPipelineState::IsCompatibleWith() in the null backend.
+		virtual bool SHZ_CALL_TYPE IsCompatibleWith(const IPipelineState* pPSO) const override final;
+
+		// Implementation of IPipelineState::GetResourceSignatureCount() in the null backend.
+		virtual uint32 SHZ_CALL_TYPE GetResourceSignatureCount() const override final { return 0; }
+
+		// Implementation of IPipelineState::GetResourceSignature() in the null backend.
+		virtual IPipelineResourceSignature* SHZ_CALL_TYPE GetResourceSignature(uint32 Index) const override final { return nullptr; }
+
+		// Implementation of IPipelineState::GetStatus() in the null backend.
+		virtual PIPELINE_STATE_STATUS SHZ_CALL_TYPE GetStatus(bool WaitForCompletion) override final { return PIPELINE_STATE_STATUS_READY; }
+
+		// Returns the type of the variable Name in the given stage as declared by the resource layout.
+		SHADER_RESOURCE_VARIABLE_TYPE GetVariableType(SHADER_TYPE ShaderType, const Char* Name) const;
+
+		// Returns the shader stages the pipeline was created with.
+		SHADER_TYPE GetActiveShaderStages() const { return m_ActiveStages; }
+
+		// Returns the shader stages whose resources are known from reflection.
+		SHADER_TYPE GetReflectedShaderStages() const { return m_ReflectedStages; }
+
+		struct ReflectedResource
+		{
+			SHADER_TYPE ShaderStage = SHADER_TYPE_UNKNOWN;
+			std::string Name;
+			SHADER_RESOURCE_TYPE Type = SHADER_RESOURCE_TYPE_UNKNOWN;
+			uint32 ArraySize = 0;
+			SHADER_RESOURCE_VARIABLE_TYPE VarType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+
+			ShaderResourceDesc GetDesc() const { return ShaderResourceDesc{ Name.c_str(), Type, ArraySize }; }
+		};
+
+		// Resources of all reflected stages, except samplers replaced by immutable ones.
+		const std::vector<ReflectedResource>& GetReflectedResources() const { return m_Resources; }
+
+	private:
+		void initResourceLayout(const PipelineStateCreateInfo& CreateInfo, std::initializer_list<IShader*> Shaders);
+		void reflectShader(IShader* pShader, const PipelineResourceLayoutDesc& ResourceLayout);
+
+	private:
+		struct LayoutVariable
+		{
+			SHADER_TYPE ShaderStages = SHADER_TYPE_UNKNOWN;
+			std::string Name;
+			SHADER_RESOURCE_VARIABLE_TYPE Type = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+		};
+
+		std::vector<LayoutVariable> m_LayoutVariables;
+		std::vector<ShaderResourceVariableDesc> m_LayoutVariableDescs;
+
+		GraphicsPipelineDesc m_GraphicsPipeline;
+		std::vector<LayoutElement> m_LayoutElements;
+		std::vector<std::string> m_LayoutSemantics;
+		RefCntAutoPtr<IRenderPass> m_pRenderPass;
+
+		SHADER_TYPE m_ActiveStages = SHADER_TYPE_UNKNOWN;
+		SHADER_TYPE m_ReflectedStages = SHADER_TYPE_UNKNOWN;
+
+		std::vector<ReflectedResource> m_Resources;
+
+		ShaderVariableManagerNull m_StaticVariables;
+	};
+
+} // namespace shz
@@ -0,0 +1,46 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::QueryNullImpl class
+
+#include <cstring>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/QueryBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Query implementation in the null backend. Ended queries are immediately
+	// available and report zero results.
+	class QueryNullImpl final : public QueryBase<EngineNullImplTraits>
+	{
+	public:
+		using TQueryBase = QueryBase<EngineNullImplTraits>;
+
+		QueryNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const QueryDesc& Desc)
+			: TQueryBase{ pRefCounters, pDevice, Desc }
+		{
+		}
+
+		// Implementation of IQuery::GetData() in the null backend.
+		virtual bool SHZ_CALL_TYPE GetData(void* pData, uint32 DataSize, bool AutoInvalidate) override final
+		{
+			TQueryBase::CheckQueryDataPtr(pData, DataSize);
+
+			if (pData != nullptr)
+			{
+				std::memset(pData, 0, DataSize);
+			}
+
+			if (AutoInvalidate)
+			{
+				Invalidate();
+			}
+
+			return true;
+		}
+	};
+
+} // namespace shz
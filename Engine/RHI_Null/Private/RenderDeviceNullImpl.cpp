@@ -0,0 +1,181 @@
+#include "pch.h"
+#include "RenderDeviceNullImpl.hpp"
+
+#include "PipelineStateNullImpl.hpp"
+#include "ShaderResourceBindingNullImpl.hpp"
+#include "ShaderNullImpl.hpp"
+#include "TextureNullImpl.hpp"
+#include "TextureViewNullImpl.hpp"
+#include "SamplerNullImpl.hpp"
+#include "BufferNullImpl.hpp"
+#include "BufferViewNullImpl.hpp"
+#include "DeviceContextNullImpl.hpp"
+#include "FenceNullImpl.hpp"
+#include "QueryNullImpl.hpp"
+#include "RenderPassNullImpl.hpp"
+#include "FramebufferNullImpl.hpp"
+
+namespace shz
+{
+
+	RenderDeviceNullImpl::RenderDeviceNullImpl(
+		IReferenceCounters* pRefCounters,
+		IMemoryAllocator& RawMemAllocator,
+		IEngineFactory* pEngineFactory,
+		const EngineNullCreateInfo& EngineCI,
+		const GraphicsAdapterInfo& AdapterInfo)
+		: TRenderDeviceBase{
+			pRefCounters,
+			RawMemAllocator,
+			pEngineFactory,
+			EngineCI,
+			AdapterInfo }
+		, m_pDxCompiler{ CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, EngineCI.pDxCompilerPath) }
+	{
+		m_DeviceInfo.Type = RENDER_DEVICE_TYPE_UNDEFINED;
+		m_DeviceInfo.APIVersion = { 1, 0 };
+		m_DeviceInfo.Features = EnableDeviceFeatures(m_AdapterInfo.Features, EngineCI.Features);
+
+		// Match D3D conventions so that the renderer takes the same code paths as with the D3D12 backend.
+		m_DeviceInfo.NDC = NDCAttribs{ 0.0f, 1.0f, -0.5f };
+		m_DeviceInfo.MaxShaderVersion.HLSL = (m_pDxCompiler && m_pDxCompiler->IsLoaded()) ? m_pDxCompiler->GetMaxShaderModel() : ShaderVersion{ 5, 1 };
+
+		InitShaderCompilationThreadPool(EngineCI.pAsyncShaderCompilationThreadPool, EngineCI.NumAsyncShaderCompilationThreads);
+
+		for (uint32 Fmt = TEX_FORMAT_UNKNOWN + 1; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt)
+			m_TextureFormatsInfo[Fmt].Supported = true;
+	}
+
+	RenderDeviceNullImpl::~RenderDeviceNullImpl()
+	{
+	}
+
+	void RenderDeviceNullImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
+	{
+		TextureFormatInfoExt& TexFormatInfo = m_TextureFormatsInfo[TexFormat];
+		ASSERT(TexFormatInfo.Supported, "Texture format is not supported");
+
+		// Nothing is ever sampled or rendered, so every format accepts every usage.
+		TexFormatInfo.Filterable = true;
+
+		TexFormatInfo.BindFlags = BIND_SHADER_RESOURCE | BIND_RENDER_TARGET | BIND_UNORDERED_ACCESS;
+		if (TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH || TexFormatInfo.ComponentType == COMPONENT_TYPE_DEPTH_STENCIL)
+			TexFormatInfo.BindFlags = BIND_SHADER_RESOURCE | BIND_DEPTH_STENCIL;
+
+		TexFormatInfo.Dimensions =
+			RESOURCE_DIMENSION_SUPPORT_TEX_1D | RESOURCE_DIMENSION_SUPPORT_TEX_1D_ARRAY |
+			RESOURCE_DIMENSION_SUPPORT_TEX_2D | RESOURCE_DIMENSION_SUPPORT_TEX_2D_ARRAY |
+			RESOURCE_DIMENSION_SUPPORT_TEX_3D |
+			RESOURCE_DIMENSION_SUPPORT_TEX_CUBE | RESOURCE_DIMENSION_SUPPORT_TEX_CUBE_ARRAY;
+
+		TexFormatInfo.SampleCounts = SAMPLE_COUNT_1 | SAMPLE_COUNT_2 | SAMPLE_COUNT_4 | SAMPLE_COUNT_8;
+	}
+
+	void RenderDeviceNullImpl::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+	{
+		CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
+	}
+
+	void RenderDeviceNullImpl::CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+	{
+		CreatePipelineStateImpl(ppPipelineState, PSOCreateInfo);
+	}
+
+	void RenderDeviceNullImpl::CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState)
+	{
+		LOG_ERROR_MESSAGE("Ray tracing pipelines are not supported by the null backend");
+		*ppPipelineState = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)
+	{
+		CreateBufferImpl(ppBuffer, BuffDesc, pBuffData);
+	}
+
+	void RenderDeviceNullImpl::CreateShader(
+		const ShaderCreateInfo& ShaderCI,
+		IShader** ppShader,
+		IDataBlob** ppCompilerOutput)
+	{
+		const ShaderNullImpl::TShaderBase::CreateInfo NullShaderCI{
+			GetDeviceInfo(),
+			GetAdapterInfo(),
+			GetDxCompiler(),
+			ppCompilerOutput,
+			m_pShaderCompilationThreadPool,
+		};
+		CreateShaderImpl(ppShader, ShaderCI, NullShaderCI);
+	}
+
+	void RenderDeviceNullImpl::CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture)
+	{
+		CreateTextureImpl(ppTexture, TexDesc, pData);
+	}
+
+	void RenderDeviceNullImpl::CreateSampler(const SamplerDesc& SamplerDesc, ISampler** ppSampler)
+	{
+		CreateSamplerImpl(ppSampler, SamplerDesc);
+	}
+
+	void RenderDeviceNullImpl::CreateFence(const FenceDesc& Desc, IFence** ppFence)
+	{
+		CreateFenceImpl(ppFence, Desc);
+	}
+
+	void RenderDeviceNullImpl::CreateQuery(const QueryDesc& Desc, IQuery** ppQuery)
+	{
+		CreateQueryImpl(ppQuery, Desc);
+	}
+
+	void RenderDeviceNullImpl::CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass)
+	{
+		CreateRenderPassImpl(ppRenderPass, Desc);
+	}
+
+	void RenderDeviceNullImpl::CreateFramebuffer(const FramebufferDesc& Desc, IFramebuffer** ppFramebuffer)
+	{
+		CreateFramebufferImpl(ppFramebuffer, Desc);
+	}
+
+	void RenderDeviceNullImpl::CreateBLAS(const BottomLevelASDesc& Desc, IBottomLevelAS** ppBLAS)
+	{
+		LOG_ERROR_MESSAGE("Bottom-level acceleration structures are not supported by the null backend");
+		*ppBLAS = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreateTLAS(const TopLevelASDesc& Desc, ITopLevelAS** ppTLAS)
+	{
+		LOG_ERROR_MESSAGE("Top-level acceleration structures are not supported by the null backend");
+		*ppTLAS = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreateSBT(const ShaderBindingTableDesc& Desc, IShaderBindingTable** ppSBT)
+	{
+		LOG_ERROR_MESSAGE("Shader binding tables are not supported by the null backend");
+		*ppSBT = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreatePipelineResourceSignature(const PipelineResourceSignatureDesc& Desc, IPipelineResourceSignature** ppSignature)
+	{
+		LOG_ERROR_MESSAGE("Pipeline resource signatures are not supported by the null backend");
+		*ppSignature = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreateDeviceMemory(const DeviceMemoryCreateInfo& CreateInfo, IDeviceMemory** ppMemory)
+	{
+		LOG_ERROR_MESSAGE("Device memory objects are not supported by the null backend");
+		*ppMemory = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo, IPipelineStateCache** ppPSOCache)
+	{
+		LOG_INFO_MESSAGE("Pipeline state cache is not supported");
+		*ppPSOCache = nullptr;
+	}
+
+	void RenderDeviceNullImpl::CreateDeferredContext(IDeviceContext** ppContext)
+	{
+		CreateDeferredContextImpl(ppContext);
+	}
+
+} // namespace shz
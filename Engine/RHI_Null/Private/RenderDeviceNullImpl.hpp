@@ -0,0 +1,123 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::RenderDeviceNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/RenderDeviceBase.hpp"
+#include "Engine/ShaderTools/Public/DXCompiler.hpp"
+#include "Engine/RHI_Null/Public/IEngineFactoryNull.h"
+
+namespace shz
+{
+
+	// Render device implementation in the null backend.
+
+	// Every object is a plain CPU object; nothing is ever submitted to a GPU.
+	// Shaders are compiled and reflected on the CPU, as in the D3D12 backend.
+	// Ray tracing, sparse resources, resource signatures, device memory objects
+	// and PSO caches are not supported.
+	class RenderDeviceNullImpl final : public RenderDeviceBase<EngineNullImplTraits>
+	{
+	public:
+		using TRenderDeviceBase = RenderDeviceBase<EngineNullImplTraits>;
+
+		RenderDeviceNullImpl(
+			IReferenceCounters* pRefCounters,
+			IMemoryAllocator& RawMemAllocator,
+			IEngineFactory* pEngineFactory,
+			const EngineNullCreateInfo& EngineCI,
+			const GraphicsAdapterInfo& AdapterInfo) noexcept(false);
+		~RenderDeviceNullImpl();
+
+		// Implementation of IRenderDevice::CreateGraphicsPipelineState() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
+
+		// Implementation of IRenderDevice::CreateComputePipelineState() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateComputePipelineState(const ComputePipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
+
+		// Implementation of IRenderDevice::CreateRayTracingPipelineState() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateRayTracingPipelineState(const RayTracingPipelineStateCreateInfo& PSOCreateInfo, IPipelineState** ppPipelineState) override final;
+
+		// Implementation of IRenderDevice::CreateBuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateBuffer(const BufferDesc& BuffDesc,
+			const BufferData* pBuffData,
+			IBuffer** ppBuffer) override final;
+
+		// Implementation of IRenderDevice::CreateShader() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateShader(
+			const ShaderCreateInfo& ShaderCreateInfo,
+			IShader** ppShader,
+			IDataBlob** ppCompilerOutput) override final;
+
+		// Implementation of IRenderDevice::CreateTexture() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateTexture(
+			const TextureDesc& TexDesc,
+			const TextureData* pData,
+			ITexture** ppTexture) override final;
+
+		// Implementation of IRenderDevice::CreateSampler() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateSampler(const SamplerDesc& SamplerDesc, ISampler** ppSampler) override final;
+
+		// Implementation of IRenderDevice::CreateFence() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateFence(const FenceDesc& Desc, IFence** ppFence) override final;
+
+		// Implementation of IRenderDevice::CreateQuery() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateQuery(const QueryDesc& Desc, IQuery** ppQuery) override final;
+
+		// Implementation of IRenderDevice::CreateRenderPass() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateRenderPass(const RenderPassDesc& Desc, IRenderPass** ppRenderPass) override final;
+
+		// Implementation of IRenderDevice::CreateFramebuffer() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateFramebuffer(const FramebufferDesc& Desc, IFramebuffer** ppFramebuffer) override final;
+
+		// Implementation of IRenderDevice::CreateBLAS() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateBLAS(const BottomLevelASDesc& Desc, IBottomLevelAS** ppBLAS) override final;
+
+		// Implementation of IRenderDevice::CreateTLAS() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateTLAS(const TopLevelASDesc& Desc, ITopLevelAS** ppTLAS) override final;
+
+		// Implementation of IRenderDevice::CreateSBT() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateSBT(const ShaderBindingTableDesc& Desc, IShaderBindingTable** ppSBT) override final;
+
+		// Implementation of IRenderDevice::CreatePipelineResourceSignature() in the null backend.
+		virtual void SHZ_CALL_TYPE CreatePipelineResourceSignature(const PipelineResourceSignatureDesc& Desc, IPipelineResourceSignature** ppSignature) override final;
+
+		// Implementation of IRenderDevice::CreateDeviceMemory() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateDeviceMemory(const DeviceMemoryCreateInfo& CreateInfo, IDeviceMemory** ppMemory) override final;
+
+		// Implementation of IRenderDevice::CreatePipelineStateCache() in the null backend.
+		virtual void SHZ_CALL_TYPE CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo, IPipelineStateCache** ppPSOCache) override final;
+
+		// Implementation of IRenderDevice::CreateDeferredContext() in the null backend.
+		virtual void SHZ_CALL_TYPE CreateDeferredContext(IDeviceContext** ppContext) override final;
+
+		// Implementation of IRenderDevice::GetSparseTextureFormatInfo() in the null backend.
+		virtual SparseTextureFormatInfo SHZ_CALL_TYPE GetSparseTextureFormatInfo(
+			TEXTURE_FORMAT TexFormat,
+			RESOURCE_DIMENSION Dimension,
+			uint32 SampleCount) const override final
+		{
+			return {};
+		}
+
+		// Implementation of IRenderDevice::ReleaseStaleResources() in the null backend.
+		virtual void SHZ_CALL_TYPE ReleaseStaleResources(bool ForceRelease = false) override final {}
+
+		// Implementation of IRenderDevice::IdleGPU() in the null backend.
+		virtual void SHZ_CALL_TYPE IdleGPU() override final {}
+
+		// The null backend has a single software queue.
+		uint64 GetCommandQueueMask() const { return 1; }
+		size_t GetCommandQueueCount() const { return 1; }
+
+		IDXCompiler* GetDxCompiler() const { return m_pDxCompiler.get(); }
+
+	protected:
+		virtual void TestTextureFormat(TEXTURE_FORMAT TexFormat) override final;
+
+	private:
+		std::unique_ptr<IDXCompiler> m_pDxCompiler;
+	};
+
+} // namespace shz
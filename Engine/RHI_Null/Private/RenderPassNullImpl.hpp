@@ -0,0 +1,25 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::RenderPassNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/RenderPassBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Render pass implementation in the null backend.
+	class RenderPassNullImpl final : public RenderPassBase<EngineNullImplTraits>
+	{
+	public:
+		using TRenderPassBase = RenderPassBase<EngineNullImplTraits>;
+
+		RenderPassNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const RenderPassDesc& Desc)
+			: TRenderPassBase{ pRefCounters, pDevice, Desc }
+		{
+		}
+	};
+
+} // namespace shz
@@ -0,0 +1,25 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::SamplerNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/SamplerBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Sampler object implementation in the null backend.
+	class SamplerNullImpl final : public SamplerBase<EngineNullImplTraits>
+	{
+	public:
+		using TSamplerBase = SamplerBase<EngineNullImplTraits>;
+
+		SamplerNullImpl(IReferenceCounters* pRefCounters, RenderDeviceNullImpl* pDevice, const SamplerDesc& SamplerDesc)
+			: TSamplerBase{ pRefCounters, pDevice, SamplerDesc }
+		{
+		}
+	};
+
+} // namespace shz
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "ShaderNullImpl.hpp"
+
+#include "Engine/ShaderTools/Public/DXCompiler.hpp"
+
+namespace shz
+{
+
+	constexpr INTERFACE_ID ShaderNullImpl::IID_InternalImpl;
+
+	namespace
+	{
+		// Same rules as the D3D12 backend: the requested model, limited by the compiler
+		// (FXC stops at 5.1) and by default to 6.6.
+		static ShaderVersion getNullShaderModel(const ShaderCreateInfo& ShaderCI, IDXCompiler* pDXCompiler)
+		{
+			if (ShaderCI.Source == nullptr && ShaderCI.FilePath == nullptr)
+				return ShaderCI.HLSLVersion;
+
+			ShaderVersion CompilerSM = ShaderVersion{ 5, 1 };
+			if (ShaderCI.ShaderCompiler == SHADER_COMPILER_DXC)
+			{
+				if (pDXCompiler != nullptr && pDXCompiler->IsLoaded())
+					CompilerSM = pDXCompiler->GetMaxShaderModel();
+				else
+					LOG_ERROR_MESSAGE("DXC compiler is not loaded");
+			}
+
+			if (ShaderCI.HLSLVersion == ShaderVersion{ 0, 0 })
+				return ShaderVersion::Min(CompilerSM, ShaderVersion{ 6, 6 });
+
+			return ShaderVersion::Min(ShaderCI.HLSLVersion, CompilerSM);
+		}
+	} // namespace
+
+	ShaderNullImpl::ShaderNullImpl(
+		IReferenceCounters* pRefCounters,
+		RenderDeviceNullImpl* pDevice,
+		const ShaderCreateInfo& ShaderCI,
+		const TShaderBase::CreateInfo& NullShaderCI)
+		: TShaderBase{
+			pRefCounters,
+			pDevice,
+			ShaderCI,
+			NullShaderCI,
+			false,
+			getNullShaderModel(ShaderCI, NullShaderCI.pDXCompiler),
+			[pDXCompiler = NullShaderCI.pDXCompiler,
+			 LoadCBReflection = ShaderCI.LoadConstantBufferReflection](const ShaderDesc& Desc, IDataBlob* pShaderByteCode) {
+				IMemoryAllocator& Allocator = GetRawAllocator();
+				ShaderResourcesD3D12* pRawMem = ALLOCATE(Allocator, "Allocator for ShaderResources", ShaderResourcesD3D12, 1);
+				ShaderResourcesD3D12* pResources = new (pRawMem) ShaderResourcesD3D12 //
+					{
+						pShaderByteCode,
+						Desc,
+						Desc.UseCombinedTextureSamplers ? Desc.CombinedSamplerSuffix : nullptr,
+						pDXCompiler,
+						LoadCBReflection,
+					};
+				return std::shared_ptr<const ShaderResourcesD3D12>{pResources, STDDeleterRawMem<ShaderResourcesD3D12>(Allocator)};
+			},
+		}
+	{
+	}
+
+	ShaderNullImpl::~ShaderNullImpl()
+	{
+		// The asynchronous compile references the shader object.
+		GetStatus(/*WaitForCompletion = */ true);
+	}
+
+	void ShaderNullImpl::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
+	{
+		if (ppInterface == nullptr)
+			return;
+
+		if (IID == IID_ShaderD3D || IID == IID_InternalImpl)
+		{
+			*ppInterface = this;
+			(*ppInterface)->AddRef();
+		}
+		else
+		{
+			TShaderBase::QueryInterface(IID, ppInterface);
+		}
+	}
+
+} // namespace shz
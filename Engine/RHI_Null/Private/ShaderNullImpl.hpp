@@ -0,0 +1,39 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::ShaderNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/ShaderBase.hpp"
+#include "Engine/RHI_D3DBase/Public/ShaderD3DBase.hpp"
+#include "Engine/RHI_D3D12/Private/ShaderResourcesD3D12.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Shader implementation in the null backend.
+
+	// Shaders are compiled to DXIL (or DXBC with FXC) exactly as in the D3D12 backend and
+	// reflected from the bytecode, so the null device reports the same resources, constant
+	// buffer layouts and bytecode as a D3D12 device. Nothing is ever executed.
+	class ShaderNullImpl final : public ShaderD3DBase<EngineNullImplTraits, ShaderResourcesD3D12>
+	{
+	public:
+		using TShaderBase = ShaderD3DBase<EngineNullImplTraits, ShaderResourcesD3D12>;
+
+		// {4C2B7E19-0A63-4F8D-9E51-B6D3A07C2F84}
+		static constexpr INTERFACE_ID IID_InternalImpl =
+		{ 0x4c2b7e19, 0xa63, 0x4f8d, {0x9e, 0x51, 0xb6, 0xd3, 0xa0, 0x7c, 0x2f, 0x84} };
+
+		ShaderNullImpl(IReferenceCounters* pRefCounters,
+			RenderDeviceNullImpl* pDevice,
+			const ShaderCreateInfo& ShaderCI,
+			const TShaderBase::CreateInfo& NullShaderCI);
+		~ShaderNullImpl();
+
+		virtual void SHZ_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
+		using IObject::QueryInterface;
+	};
+
+} // namespace shz
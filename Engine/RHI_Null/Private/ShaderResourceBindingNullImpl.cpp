@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "ShaderResourceBindingNullImpl.hpp"
+
+#include "PipelineStateNullImpl.hpp"
+#include "Engine/RHI/Interface/IResourceMapping.h"
+
+namespace shz
+{
+
+	ShaderResourceBindingNullImpl::ShaderResourceBindingNullImpl(IReferenceCounters* pRefCounters, PipelineStateNullImpl* pPSO)
+		: TObjectBase{ pRefCounters }
+		, m_pPSO{ pPSO }
+		, m_Variables{ *this }
+	{
+		ASSERT(pPSO != nullptr, "Pipeline state must not be null");
+
+		for (const PipelineStateNullImpl::ReflectedResource& Res : pPSO->GetReflectedResources())
+		{
+			if (Res.VarType != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+			{
+				const ShaderResourceDesc ResDesc = Res.GetDesc();
+				m_Variables.GetOrCreateVariable(Res.ShaderStage, Res.Name.c_str(), Res.VarType, &ResDesc);
+			}
+		}
+	}
+
+	ShaderResourceBindingNullImpl::~ShaderResourceBindingNullImpl()
+	{
+	}
+
+	void ShaderResourceBindingNullImpl::BindResources(SHADER_TYPE ShaderStages, IResourceMapping* pResMapping, BIND_SHADER_RESOURCES_FLAGS Flags)
+	{
+		if (pResMapping == nullptr)
+			return;
+
+		if ((Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) == 0)
+			Flags |= BIND_SHADER_RESOURCES_UPDATE_ALL;
+
+		// Stages without reflection only know the layout-declared names up front.
+		const SHADER_TYPE UnreflectedStages = m_pPSO->GetActiveShaderStages() & ~m_pPSO->GetReflectedShaderStages();
+		const PipelineStateDesc& PSODesc = m_pPSO->GetDesc();
+		for (uint32 i = 0; i < PSODesc.ResourceLayout.NumVariables; ++i)
+		{
+			const ShaderResourceVariableDesc& Var = PSODesc.ResourceLayout.Variables[i];
+			if (Var.Type != SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+			{
+				for (SHADER_TYPE Stages = Var.ShaderStages & ShaderStages & UnreflectedStages; Stages != SHADER_TYPE_UNKNOWN;)
+					m_Variables.GetOrCreateVariable(ExtractLSB(Stages), Var.Name, Var.Type);
+			}
+		}
+
+		for (SHADER_TYPE Stages = ShaderStages; Stages != SHADER_TYPE_UNKNOWN;)
+		{
+			const SHADER_TYPE Stage = ExtractLSB(Stages);
+			const uint32 NumVars = m_Variables.GetVariableCount(Stage);
+			for (uint32 v = 0; v < NumVars; ++v)
+			{
+				ShaderVariableNullImpl* pVar = m_Variables.GetVariableByIndex(Stage, v);
+				if (pVar->GetType() == SHADER_RESOURCE_VARIABLE_TYPE_STATIC || (Flags & (1u << pVar->GetType())) == 0)
+					continue;
+
+				if ((Flags & BIND_SHADER_RESOURCES_KEEP_EXISTING) != 0 && pVar->Get(0) != nullptr)
+					continue;
+
+				if (IDeviceObject* pObj = pResMapping->GetResource(pVar->GetName().c_str()))
+					pVar->Set(pObj, SET_SHADER_RESOURCE_FLAG_NONE);
+			}
+		}
+	}
+
+	SHADER_RESOURCE_VARIABLE_TYPE_FLAGS ShaderResourceBindingNullImpl::CheckResources(
+		SHADER_TYPE ShaderStages,
+		IResourceMapping* pResMapping,
+		BIND_SHADER_RESOURCES_FLAGS Flags) const
+	{
+		SHADER_RESOURCE_VARIABLE_TYPE_FLAGS StaleVarTypes = SHADER_RESOURCE_VARIABLE_TYPE_FLAG_NONE;
+		if (pResMapping == nullptr)
+			return StaleVarTypes;
+
+		for (SHADER_TYPE Stages = ShaderStages; Stages != SHADER_TYPE_UNKNOWN;)
+		{
+			const SHADER_TYPE Stage = ExtractLSB(Stages);
+			const uint32 NumVars = m_Variables.GetVariableCount(Stage);
+			for (uint32 v = 0; v < NumVars; ++v)
+			{
+				const ShaderVariableNullImpl* pVar = m_Variables.GetVariableByIndex(Stage, v);
+				IDeviceObject* pBound = pVar->Get(0);
+				IDeviceObject* pMapped = pResMapping->GetResource(pVar->GetName().c_str());
+
+				const bool bMismatch = (Flags & BIND_SHADER_RESOURCES_UPDATE_ALL) != 0 && pMapped != nullptr && pBound != pMapped;
+				const bool bUnresolved = (Flags & BIND_SHADER_RESOURCES_VERIFY_ALL_RESOLVED) != 0 && pBound == nullptr;
+				if (bMismatch || bUnresolved)
+					StaleVarTypes |= static_cast<SHADER_RESOURCE_VARIABLE_TYPE_FLAGS>(1u << pVar->GetType());
+			}
+		}
+
+		return StaleVarTypes;
+	}
+
+	IShaderResourceVariable* ShaderResourceBindingNullImpl::GetVariableByName(SHADER_TYPE ShaderType, const Char* Name)
+	{
+		if ((ShaderType & m_pPSO->GetActiveShaderStages()) == 0)
+			return nullptr;
+
+		if ((ShaderType & m_pPSO->GetReflectedShaderStages()) != 0)
+		{
+			// Static resources copied from the pipeline are not SRB variables.
+			ShaderVariableNullImpl* pVar = m_Variables.FindVariable(ShaderType, Name);
+			return (pVar != nullptr && pVar->GetType() != SHADER_RESOURCE_VARIABLE_TYPE_STATIC) ? pVar : nullptr;
+		}
+
+		const SHADER_RESOURCE_VARIABLE_TYPE Type = m_pPSO->GetVariableType(ShaderType, Name);
+		if (Type == SHADER_RESOURCE_VARIABLE_TYPE_STATIC)
+			return nullptr;
+
+		return m_Variables.GetOrCreateVariable(ShaderType, Name, Type);
+	}
+
+	uint32 ShaderResourceBindingNullImpl::GetVariableCount(SHADER_TYPE ShaderType) const
+	{
+		return m_Variables.GetVariableCount(ShaderType);
+	}
+
+	IShaderResourceVariable* ShaderResourceBindingNullImpl::GetVariableByIndex(SHADER_TYPE ShaderType, uint32 Index)
+	{
+		return m_Variables.GetVariableByIndex(ShaderType, Index);
+	}
+
+} // namespace shz
@@ -0,0 +1,70 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::ShaderResourceBindingNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/Core/Common/Public/ObjectBase.hpp"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+#include "ShaderVariableNullImpl.hpp"
+
+namespace shz
+{
+
+	class PipelineStateNullImpl;
+
+	// Shader resource binding object implementation in the null backend.
+
+	// Holds mutable and dynamic variables of the pipeline. Those of reflected stages are
+	// created with the SRB; in other stages they are created on first access. Names that
+	// the pipeline declares as static are not exposed.
+	class ShaderResourceBindingNullImpl final : public ObjectBase<IShaderResourceBinding>
+	{
+	public:
+		using TObjectBase = ObjectBase<IShaderResourceBinding>;
+
+		ShaderResourceBindingNullImpl(IReferenceCounters* pRefCounters, PipelineStateNullImpl* pPSO);
+		~ShaderResourceBindingNullImpl();
+
+		IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ShaderResourceBinding, TObjectBase);
+
+		// Implementation of IShaderResourceBinding::GetPipelineResourceSignature() in the null backend.
+		virtual IPipelineResourceSignature* SHZ_CALL_TYPE GetPipelineResourceSignature() const override final { return nullptr; }
+
+		// Implementation of IShaderResourceBinding::BindResources() in the null backend.
+		virtual void SHZ_CALL_TYPE BindResources(SHADER_TYPE ShaderStages, IResourceMapping* pResMapping, BIND_SHADER_RESOURCES_FLAGS Flags) override final;
+
+		// Implementation of IShaderResourceBinding::CheckResources() in the null backend.
+		virtual SHADER_RESOURCE_VARIABLE_TYPE_FLAGS SHZ_CALL_TYPE CheckResources(
+			SHADER_TYPE ShaderStages,
+			IResourceMapping* pResMapping,
+			BIND_SHADER_RESOURCES_FLAGS Flags) const override final;
+
+		// Implementation of IShaderResourceBinding::GetVariableByName() in the null backend.
+		virtual IShaderResourceVariable* SHZ_CALL_TYPE GetVariableByName(SHADER_TYPE ShaderType, const Char* Name) override final;
+
+		// Implementation of IShaderResourceBinding::GetVariableCount() in the null backend.
+		virtual uint32 SHZ_CALL_TYPE GetVariableCount(SHADER_TYPE ShaderType) const override final;
+
+		// Implementation of IShaderResourceBinding::GetVariableByIndex() in the null backend.
+		virtual IShaderResourceVariable* SHZ_CALL_TYPE GetVariableByIndex(SHADER_TYPE ShaderType, uint32 Index) override final;
+
+		// Implementation of IShaderResourceBinding::StaticResourcesInitialized() in the null backend.
+		virtual bool SHZ_CALL_TYPE StaticResourcesInitialized() const override final { return m_bStaticResourcesInitialized; }
+
+		PipelineStateNullImpl* GetPipelineState() const { return m_pPSO; }
+
+		ShaderVariableManagerNull& GetVariables() { return m_Variables; }
+
+		// Number of objects bound to the SRB, including static resources copied from the PSO.
+		uint32 GetNumBoundObjects() const { return m_Variables.GetNumBoundObjects(); }
+
+		void SetStaticResourcesInitialized() { m_bStaticResourcesInitialized = true; }
+
+	private:
+		RefCntAutoPtr<PipelineStateNullImpl> m_pPSO;
+		ShaderVariableManagerNull m_Variables;
+		bool m_bStaticResourcesInitialized = false;
+	};
+
+} // namespace shz
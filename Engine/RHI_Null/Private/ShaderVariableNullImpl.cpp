@@ -0,0 +1,194 @@
+#include "pch.h"
+#include "ShaderVariableNullImpl.hpp"
+
+#include <cstring>
+
+namespace shz
+{
+
+	ShaderVariableNullImpl::ShaderVariableNullImpl(
+		ShaderVariableManagerNull& ParentManager,
+		SHADER_TYPE ShaderType,
+		const Char* Name,
+		SHADER_RESOURCE_VARIABLE_TYPE Type,
+		uint32 Index,
+		SHADER_RESOURCE_TYPE ResourceType,
+		uint32 ArraySize)
+		: m_ParentManager{ ParentManager }
+		, m_ShaderType{ ShaderType }
+		, m_Name{ Name }
+		, m_Type{ Type }
+		, m_Index{ Index }
+		, m_ResourceType{ ResourceType }
+		, m_ReflectedArraySize{ ArraySize }
+	{
+		m_Objects.resize(m_ReflectedArraySize);
+	}
+
+	void ShaderVariableNullImpl::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
+	{
+		if (ppInterface == nullptr)
+			return;
+
+		*ppInterface = nullptr;
+		if (IID == IID_ShaderResourceVariable || IID == IID_Unknown)
+		{
+			*ppInterface = this;
+			(*ppInterface)->AddRef();
+		}
+	}
+
+	ReferenceCounterValueType ShaderVariableNullImpl::AddRef()
+	{
+		return m_ParentManager.GetOwner().AddRef();
+	}
+
+	ReferenceCounterValueType ShaderVariableNullImpl::Release()
+	{
+		return m_ParentManager.GetOwner().Release();
+	}
+
+	IReferenceCounters* ShaderVariableNullImpl::GetReferenceCounters() const
+	{
+		return m_ParentManager.GetOwner().GetReferenceCounters();
+	}
+
+	void ShaderVariableNullImpl::bindObject(uint32 ArrayIndex, IDeviceObject* pObject)
+	{
+		if (ArrayIndex >= m_Objects.size())
+			m_Objects.resize(ArrayIndex + 1);
+
+		m_Objects[ArrayIndex] = pObject;
+	}
+
+	void ShaderVariableNullImpl::Set(IDeviceObject* pObject, SET_SHADER_RESOURCE_FLAGS Flags)
+	{
+		bindObject(0, pObject);
+	}
+
+	void ShaderVariableNullImpl::SetArray(
+		IDeviceObject* const* ppObjects,
+		uint32 FirstElement,
+		uint32 NumElements,
+		SET_SHADER_RESOURCE_FLAGS Flags)
+	{
+		for (uint32 elem = 0; elem < NumElements; ++elem)
+			bindObject(FirstElement + elem, ppObjects[elem]);
+	}
+
+	void ShaderVariableNullImpl::SetBufferRange(
+		IDeviceObject* pObject,
+		uint64 Offset,
+		uint64 Size,
+		uint32 ArrayIndex,
+		SET_SHADER_RESOURCE_FLAGS Flags)
+	{
+		bindObject(ArrayIndex, pObject);
+	}
+
+	void ShaderVariableNullImpl::GetResourceDesc(ShaderResourceDesc& ResourceDesc) const
+	{
+		ResourceDesc.Name = m_Name.c_str();
+		ResourceDesc.Type = m_ResourceType;
+		ResourceDesc.ArraySize = (std::max)(static_cast<uint32>(m_Objects.size()), 1u);
+	}
+
+	IDeviceObject* ShaderVariableNullImpl::Get(uint32 ArrayIndex) const
+	{
+		return ArrayIndex < m_Objects.size() ? m_Objects[ArrayIndex].RawPtr() : nullptr;
+	}
+
+	uint32 ShaderVariableNullImpl::GetNumBoundObjects() const
+	{
+		uint32 Count = 0;
+		for (const RefCntAutoPtr<IDeviceObject>& pObj : m_Objects)
+		{
+			if (pObj)
+				++Count;
+		}
+		return Count;
+	}
+
+	// ------------------------------------------------------------
+	// ShaderVariableManagerNull
+	// ------------------------------------------------------------
+	ShaderVariableNullImpl* ShaderVariableManagerNull::GetOrCreateVariable(
+		SHADER_TYPE ShaderType,
+		const Char* Name,
+		SHADER_RESOURCE_VARIABLE_TYPE Type,
+		const ShaderResourceDesc* pResDesc)
+	{
+		ASSERT(Name != nullptr, "Variable name must not be null");
+
+		if (ShaderVariableNullImpl* pVar = FindVariable(ShaderType, Name))
+			return pVar;
+
+		const uint32 Index = GetVariableCount(ShaderType);
+		m_Variables.emplace_back(std::make_unique<ShaderVariableNullImpl>(
+			*this,
+			ShaderType,
+			Name,
+			Type,
+			Index,
+			pResDesc != nullptr ? pResDesc->Type : SHADER_RESOURCE_TYPE_UNKNOWN,
+			pResDesc != nullptr ? pResDesc->ArraySize : 0));
+		return m_Variables.back().get();
+	}
+
+	ShaderVariableNullImpl* ShaderVariableManagerNull::FindVariable(SHADER_TYPE ShaderType, const Char* Name) const
+	{
+		for (const std::unique_ptr<ShaderVariableNullImpl>& pVar : m_Variables)
+		{
+			if (pVar->GetShaderType() == ShaderType && pVar->GetName() == Name)
+				return pVar.get();
+		}
+		return nullptr;
+	}
+
+	uint32 ShaderVariableManagerNull::GetVariableCount(SHADER_TYPE ShaderType) const
+	{
+		uint32 Count = 0;
+		for (const std::unique_ptr<ShaderVariableNullImpl>& pVar : m_Variables)
+		{
+			if (pVar->GetShaderType() == ShaderType)
+				++Count;
+		}
+		return Count;
+	}
+
+	ShaderVariableNullImpl* ShaderVariableManagerNull::GetVariableByIndex(SHADER_TYPE ShaderType, uint32 Index) const
+	{
+		for (const std::unique_ptr<ShaderVariableNullImpl>& pVar : m_Variables)
+		{
+			if (pVar->GetShaderType() == ShaderType && pVar->GetIndex() == Index)
+				return pVar.get();
+		}
+		return nullptr;
+	}
+
+	void ShaderVariableManagerNull::CopyBindings(ShaderVariableManagerNull& Dst, SHADER_RESOURCE_VARIABLE_TYPE Type) const
+	{
+		for (const std::unique_ptr<ShaderVariableNullImpl>& pSrcVar : m_Variables)
+		{
+			ShaderResourceDesc ResDesc;
+			pSrcVar->GetResourceDesc(ResDesc);
+
+			ShaderVariableNullImpl* pDstVar = Dst.GetOrCreateVariable(pSrcVar->GetShaderType(), pSrcVar->GetName().c_str(), Type,
+				ResDesc.Type != SHADER_RESOURCE_TYPE_UNKNOWN ? &ResDesc : nullptr);
+			for (uint32 elem = 0; elem < pSrcVar->GetArraySize(); ++elem)
+			{
+				if (IDeviceObject* pObj = pSrcVar->Get(elem))
+					pDstVar->SetArray(&pObj, elem, 1, SET_SHADER_RESOURCE_FLAG_NONE);
+			}
+		}
+	}
+
+	uint32 ShaderVariableManagerNull::GetNumBoundObjects() const
+	{
+		uint32 Count = 0;
+		for (const std::unique_ptr<ShaderVariableNullImpl>& pVar : m_Variables)
+			Count += pVar->GetNumBoundObjects();
+		return Count;
+	}
+
+} // namespace shz
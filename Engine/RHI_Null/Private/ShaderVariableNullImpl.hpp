@@ -0,0 +1,122 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::ShaderVariableNullImpl and shz::ShaderVariableManagerNull classes
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Interface/IShaderResourceVariable.h"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+
+namespace shz
+{
+
+	class ShaderVariableManagerNull;
+
+	// Shader resource variable implementation in the null backend.
+
+	// Variables of reflected shaders carry the resource type and array size from the
+	// bytecode; variables of unreflected stages are created on first request with an
+	// unknown type. Any object is accepted. Lifetime is controlled by the owner (PSO or SRB).
+	class ShaderVariableNullImpl final : public IShaderResourceVariable
+	{
+	public:
+		ShaderVariableNullImpl(ShaderVariableManagerNull& ParentManager,
+			SHADER_TYPE ShaderType,
+			const Char* Name,
+			SHADER_RESOURCE_VARIABLE_TYPE Type,
+			uint32 Index,
+			SHADER_RESOURCE_TYPE ResourceType = SHADER_RESOURCE_TYPE_UNKNOWN,
+			uint32 ArraySize = 0);
+
+		virtual void SHZ_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
+
+		virtual ReferenceCounterValueType SHZ_CALL_TYPE AddRef() override final;
+		virtual ReferenceCounterValueType SHZ_CALL_TYPE Release() override final;
+		virtual IReferenceCounters* SHZ_CALL_TYPE GetReferenceCounters() const override final;
+
+		virtual void SHZ_CALL_TYPE Set(IDeviceObject* pObject, SET_SHADER_RESOURCE_FLAGS Flags) override final;
+
+		virtual void SHZ_CALL_TYPE SetArray(
+			IDeviceObject* const* ppObjects,
+			uint32 FirstElement,
+			uint32 NumElements,
+			SET_SHADER_RESOURCE_FLAGS Flags) override final;
+
+		virtual void SHZ_CALL_TYPE SetBufferRange(
+			IDeviceObject* pObject,
+			uint64 Offset,
+			uint64 Size,
+			uint32 ArrayIndex,
+			SET_SHADER_RESOURCE_FLAGS Flags) override final;
+
+		virtual void SHZ_CALL_TYPE SetBufferOffset(uint32 Offset, uint32 ArrayIndex) override final {}
+
+		virtual SHADER_RESOURCE_VARIABLE_TYPE SHZ_CALL_TYPE GetType() const override final { return m_Type; }
+
+		virtual void SHZ_CALL_TYPE GetResourceDesc(ShaderResourceDesc& ResourceDesc) const override final;
+
+		virtual uint32 SHZ_CALL_TYPE GetIndex() const override final { return m_Index; }
+
+		virtual IDeviceObject* SHZ_CALL_TYPE Get(uint32 ArrayIndex) const override final;
+
+		SHADER_TYPE GetShaderType() const { return m_ShaderType; }
+		const std::string& GetName() const { return m_Name; }
+		uint32 GetArraySize() const { return static_cast<uint32>(m_Objects.size()); }
+		uint32 GetNumBoundObjects() const;
+
+	private:
+		void bindObject(uint32 ArrayIndex, IDeviceObject* pObject);
+
+	private:
+		ShaderVariableManagerNull& m_ParentManager;
+		const SHADER_TYPE m_ShaderType;
+		const std::string m_Name;
+		const SHADER_RESOURCE_VARIABLE_TYPE m_Type;
+		const uint32 m_Index;
+		const SHADER_RESOURCE_TYPE m_ResourceType;
+		const uint32 m_ReflectedArraySize;
+
+		std::vector<RefCntAutoPtr<IDeviceObject>> m_Objects;
+	};
+
+	// Owns the variables of one PSO (static) or SRB (mutable and dynamic).
+	class ShaderVariableManagerNull
+	{
+	public:
+		explicit ShaderVariableManagerNull(IObject& Owner)
+			: m_Owner{ Owner }
+		{
+		}
+
+		IObject& GetOwner() const { return m_Owner; }
+
+		// Returns the variable with the given name, creating it if it does not exist yet.
+		// pResDesc is the reflected resource, or null if the stage has no reflection.
+		ShaderVariableNullImpl* GetOrCreateVariable(SHADER_TYPE ShaderType,
+			const Char* Name,
+			SHADER_RESOURCE_VARIABLE_TYPE Type,
+			const ShaderResourceDesc* pResDesc = nullptr);
+
+		// Returns the variable with the given name, or null if it does not exist.
+		ShaderVariableNullImpl* FindVariable(SHADER_TYPE ShaderType, const Char* Name) const;
+
+		uint32 GetVariableCount(SHADER_TYPE ShaderType) const;
+		ShaderVariableNullImpl* GetVariableByIndex(SHADER_TYPE ShaderType, uint32 Index) const;
+
+		// Binds every object bound in this manager to the same-named variable in Dst.
+		void CopyBindings(ShaderVariableManagerNull& Dst, SHADER_RESOURCE_VARIABLE_TYPE Type) const;
+
+		uint32 GetNumBoundObjects() const;
+
+	private:
+		IObject& m_Owner;
+
+		// Stored by pointer so that handed out variable addresses stay valid.
+		std::vector<std::unique_ptr<ShaderVariableNullImpl>> m_Variables;
+	};
+
+} // namespace shz
@@ -0,0 +1,143 @@
+#include "pch.h"
+#include "SwapChainNullImpl.hpp"
+
+#include <string>
+
+#include "RenderDeviceNullImpl.hpp"
+#include "DeviceContextNullImpl.hpp"
+#include "Engine/GraphicsUtils/Public/GraphicsUtils.hpp"
+
+namespace shz
+{
+
+	SwapChainNullImpl::SwapChainNullImpl(
+		IReferenceCounters* pRefCounters,
+		const SwapChainDesc& SCDesc,
+		RenderDeviceNullImpl* pRenderDevice,
+		DeviceContextNullImpl* pDeviceContext)
+		: TSwapChainBase{ pRefCounters, pRenderDevice, pDeviceContext, SCDesc }
+	{
+		if (m_SwapChainDesc.Width == 0 || m_SwapChainDesc.Height == 0)
+			LOG_ERROR_AND_THROW("Null swap chain requires non-zero width and height");
+
+		if (m_SwapChainDesc.BufferCount == 0)
+			m_SwapChainDesc.BufferCount = 1;
+
+		if (m_SwapChainDesc.PreTransform == SURFACE_TRANSFORM_OPTIMAL)
+			m_SwapChainDesc.PreTransform = SURFACE_TRANSFORM_IDENTITY;
+
+		initBuffersAndViews();
+	}
+
+	SwapChainNullImpl::~SwapChainNullImpl()
+	{
+	}
+
+	void SwapChainNullImpl::initBuffersAndViews()
+	{
+		m_pBackBufferRTV.resize(m_SwapChainDesc.BufferCount);
+		for (uint32 backbuff = 0; backbuff < m_SwapChainDesc.BufferCount; ++backbuff)
+		{
+			const std::string Name = "Main back buffer " + std::to_string(backbuff);
+
+			TextureDesc BackBufferDesc;
+			BackBufferDesc.Name = Name.c_str();
+			BackBufferDesc.Type = RESOURCE_DIM_TEX_2D;
+			BackBufferDesc.Width = m_SwapChainDesc.Width;
+			BackBufferDesc.Height = m_SwapChainDesc.Height;
+			BackBufferDesc.Format = m_SwapChainDesc.ColorBufferFormat;
+			BackBufferDesc.Usage = USAGE_DEFAULT;
+			BackBufferDesc.BindFlags = BIND_RENDER_TARGET;
+			if ((m_SwapChainDesc.Usage & SWAP_CHAIN_USAGE_SHADER_RESOURCE) != 0)
+				BackBufferDesc.BindFlags |= BIND_SHADER_RESOURCE;
+
+			RefCntAutoPtr<ITexture> pBackBufferTex;
+			m_pRenderDevice->CreateTexture(BackBufferDesc, nullptr, &pBackBufferTex);
+			if (!pBackBufferTex)
+				LOG_ERROR_AND_THROW("Failed to create back buffer ", backbuff);
+
+			m_pBackBufferRTV[backbuff] = pBackBufferTex->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+		}
+
+		if (m_SwapChainDesc.DepthBufferFormat != TEX_FORMAT_UNKNOWN)
+		{
+			TextureDesc DepthBufferDesc;
+			DepthBufferDesc.Type = RESOURCE_DIM_TEX_2D;
+			DepthBufferDesc.Width = m_SwapChainDesc.Width;
+			DepthBufferDesc.Height = m_SwapChainDesc.Height;
+			DepthBufferDesc.Format = m_SwapChainDesc.DepthBufferFormat;
+			DepthBufferDesc.SampleCount = 1;
+			DepthBufferDesc.Usage = USAGE_DEFAULT;
+			DepthBufferDesc.BindFlags = BIND_DEPTH_STENCIL;
+
+			DepthBufferDesc.ClearValue.Format = GetDefaultTextureViewFormat(DepthBufferDesc.Format, TEXTURE_VIEW_DEPTH_STENCIL, DepthBufferDesc.BindFlags);
+			DepthBufferDesc.ClearValue.DepthStencil.Depth = m_SwapChainDesc.DefaultDepthValue;
+			DepthBufferDesc.ClearValue.DepthStencil.Stencil = m_SwapChainDesc.DefaultStencilValue;
+			DepthBufferDesc.Name = "Main depth buffer";
+
+			RefCntAutoPtr<ITexture> pDepthBufferTex;
+			m_pRenderDevice->CreateTexture(DepthBufferDesc, nullptr, &pDepthBufferTex);
+			if (!pDepthBufferTex)
+				LOG_ERROR_AND_THROW("Failed to create the depth buffer");
+
+			m_pDepthBufferDSV = pDepthBufferTex->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+		}
+	}
+
+	void SwapChainNullImpl::Present(uint32 SyncInterval)
+	{
+		RefCntAutoPtr<IDeviceContext> pDeviceContext = m_wpDeviceContext.Lock();
+		if (!pDeviceContext)
+		{
+			LOG_ERROR_MESSAGE("Immediate context has been released");
+			return;
+		}
+
+		DeviceContextNullImpl* pImmediateCtxNull = pDeviceContext.RawPtr<DeviceContextNullImpl>();
+
+		TextureNullImpl* pBackBuffer = ClassPtrCast<TextureNullImpl>(GetCurrentBackBufferRTV()->GetTexture());
+		pImmediateCtxNull->UnbindTextureFromFramebuffer(pBackBuffer, false);
+		pBackBuffer->SetState(RESOURCE_STATE_PRESENT);
+
+		pImmediateCtxNull->Flush();
+
+		if (m_SwapChainDesc.IsPrimary)
+			pImmediateCtxNull->FinishFrame();
+
+		m_CurrentBackBufferIndex = (m_CurrentBackBufferIndex + 1) % m_SwapChainDesc.BufferCount;
+	}
+
+	void SwapChainNullImpl::Resize(uint32 NewWidth, uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform)
+	{
+		if (!TSwapChainBase::Resize(NewWidth, NewHeight, NewPreTransform))
+			return;
+
+		if (RefCntAutoPtr<IDeviceContext> pDeviceContext = m_wpDeviceContext.Lock())
+		{
+			DeviceContextNullImpl* pImmediateCtxNull = pDeviceContext.RawPtr<DeviceContextNullImpl>();
+
+			bool RenderTargetsReset = false;
+			for (size_t i = 0; i < m_pBackBufferRTV.size() && !RenderTargetsReset; ++i)
+			{
+				TextureNullImpl* pCurrentBackBuffer = ClassPtrCast<TextureNullImpl>(m_pBackBufferRTV[i]->GetTexture());
+				RenderTargetsReset = pImmediateCtxNull->UnbindTextureFromFramebuffer(pCurrentBackBuffer, false);
+			}
+
+			if (RenderTargetsReset)
+			{
+				LOG_INFO_MESSAGE_ONCE("Resizing the swap chain requires back and depth-stencil buffers to be unbound from the device context. "
+					"An application should use SetRenderTargets() to restore them.");
+			}
+		}
+
+		m_pBackBufferRTV.clear();
+		m_pDepthBufferDSV.Release();
+		m_CurrentBackBufferIndex = 0;
+
+		if (m_SwapChainDesc.PreTransform == SURFACE_TRANSFORM_OPTIMAL)
+			m_SwapChainDesc.PreTransform = SURFACE_TRANSFORM_IDENTITY;
+
+		initBuffersAndViews();
+	}
+
+} // namespace shz
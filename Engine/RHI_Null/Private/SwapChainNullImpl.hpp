@@ -0,0 +1,64 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::SwapChainNullImpl class
+
+#include <vector>
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/SwapChainBase.hpp"
+
+namespace shz
+{
+
+	class RenderDeviceNullImpl;
+	class DeviceContextNullImpl;
+
+	// Swap chain implementation in the null backend.
+
+	// Back buffers are ordinary render target textures; nothing is displayed.
+	// Present() finishes the frame on the immediate context so that per-frame
+	// bookkeeping runs exactly as with a real swap chain.
+	class SwapChainNullImpl final : public SwapChainBase<ISwapChain>
+	{
+	public:
+		using TSwapChainBase = SwapChainBase<ISwapChain>;
+
+		SwapChainNullImpl(
+			IReferenceCounters* pRefCounters,
+			const SwapChainDesc& SCDesc,
+			RenderDeviceNullImpl* pRenderDevice,
+			DeviceContextNullImpl* pDeviceContext);
+		~SwapChainNullImpl();
+
+		// Implementation of ISwapChain::Present() in the null backend.
+		virtual void SHZ_CALL_TYPE Present(uint32 SyncInterval) override final;
+
+		// Implementation of ISwapChain::Resize() in the null backend.
+		virtual void SHZ_CALL_TYPE Resize(uint32 NewWidth, uint32 NewHeight, SURFACE_TRANSFORM NewPreTransform) override final;
+
+		// Implementation of ISwapChain::SetFullscreenMode() in the null backend.
+		virtual void SHZ_CALL_TYPE SetFullscreenMode(const DisplayModeAttribs& DisplayMode) override final {}
+
+		// Implementation of ISwapChain::SetWindowedMode() in the null backend.
+		virtual void SHZ_CALL_TYPE SetWindowedMode() override final {}
+
+		// Implementation of ISwapChain::GetCurrentBackBufferRTV() in the null backend.
+		virtual ITextureView* SHZ_CALL_TYPE GetCurrentBackBufferRTV() override final
+		{
+			return m_pBackBufferRTV[m_CurrentBackBufferIndex];
+		}
+
+		// Implementation of ISwapChain::GetDepthBufferDSV() in the null backend.
+		virtual ITextureView* SHZ_CALL_TYPE GetDepthBufferDSV() override final { return m_pDepthBufferDSV; }
+
+	private:
+		void initBuffersAndViews();
+
+	private:
+		std::vector<RefCntAutoPtr<ITextureView>> m_pBackBufferRTV;
+		RefCntAutoPtr<ITextureView> m_pDepthBufferDSV;
+		uint32 m_CurrentBackBufferIndex = 0;
+	};
+
+} // namespace shz
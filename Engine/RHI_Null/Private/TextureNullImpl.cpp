@@ -0,0 +1,53 @@
+#include "pch.h"
+#include "TextureNullImpl.hpp"
+
+#include "RenderDeviceNullImpl.hpp"
+#include "Engine/GraphicsUtils/Public/GraphicsUtils.hpp"
+
+namespace shz
+{
+
+	TextureNullImpl::TextureNullImpl(
+		IReferenceCounters* pRefCounters,
+		FixedBlockMemoryAllocator& TexViewObjAllocator,
+		RenderDeviceNullImpl* pDevice,
+		const TextureDesc& TexDesc,
+		const TextureData* pInitData /*= nullptr*/)
+		: TTextureBase{ pRefCounters, TexViewObjAllocator, pDevice, TexDesc }
+	{
+		if (m_Desc.Usage == USAGE_IMMUTABLE && (pInitData == nullptr || pInitData->pSubResources == nullptr))
+			LOG_ERROR_AND_THROW("Immutable textures must be initialized with data at creation time: pInitData can't be null");
+
+		SetState(pInitData != nullptr && pInitData->pSubResources != nullptr ? RESOURCE_STATE_COPY_DEST : RESOURCE_STATE_UNDEFINED);
+	}
+
+	void TextureNullImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView)
+	{
+		ASSERT(ppView != nullptr, "View pointer address is null");
+		if (!ppView) return;
+		ASSERT(*ppView == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+		*ppView = nullptr;
+
+		try
+		{
+			RenderDeviceNullImpl* pDeviceNullImpl = GetDevice();
+			FixedBlockMemoryAllocator& TexViewAllocator = pDeviceNullImpl->GetTexViewObjAllocator();
+			ASSERT(&TexViewAllocator == &m_dbgTexViewObjAllocator, "Texture view allocator does not match allocator provided during texture initialization");
+
+			TextureViewDesc UpdatedViewDesc = ViewDesc;
+			ValidatedAndCorrectTextureViewDesc(m_Desc, UpdatedViewDesc);
+
+			*ppView = NEW_RC_OBJ(TexViewAllocator, "TextureViewNullImpl instance", TextureViewNullImpl, bIsDefaultView ? this : nullptr)(pDeviceNullImpl, UpdatedViewDesc, this, bIsDefaultView);
+
+			if (!bIsDefaultView && *ppView)
+				(*ppView)->AddRef();
+		}
+		catch (const std::runtime_error&)
+		{
+			const char* ViewTypeName = GetTexViewTypeLiteralName(ViewDesc.ViewType);
+			LOG_ERROR("Failed to create view \"", ViewDesc.Name ? ViewDesc.Name : "", "\" (", ViewTypeName, ") for texture \"", m_Desc.Name ? m_Desc.Name : "", "\"");
+		}
+	}
+
+} // namespace shz
@@ -0,0 +1,36 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::TextureNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/TextureBase.hpp"
+#include "TextureViewNullImpl.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Texture implementation in the null backend. Texel data is never stored.
+	class TextureNullImpl final : public TextureBase<EngineNullImplTraits>
+	{
+	public:
+		using TTextureBase = TextureBase<EngineNullImplTraits>;
+
+		TextureNullImpl(IReferenceCounters* pRefCounters,
+			FixedBlockMemoryAllocator& TexViewObjAllocator,
+			RenderDeviceNullImpl* pDevice,
+			const TextureDesc& TexDesc,
+			const TextureData* pInitData = nullptr);
+
+		// Implementation of ITexture::GetNativeHandle() in the null backend.
+		virtual uint64 SHZ_CALL_TYPE GetNativeHandle() override final
+		{
+			return static_cast<uint64>(GetUniqueID());
+		}
+
+	protected:
+		virtual void CreateViewInternal(const TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override final;
+	};
+
+} // namespace shz
@@ -0,0 +1,29 @@
+#pragma once
+
+ // \file
+ // Declaration of shz::TextureViewNullImpl class
+
+#include "EngineNullImplTraits.hpp"
+#include "Engine/RHI/Public/TextureViewBase.hpp"
+#include "RenderDeviceNullImpl.hpp"
+
+namespace shz
+{
+
+	// Texture view implementation in the null backend.
+	class TextureViewNullImpl final : public TextureViewBase<EngineNullImplTraits>
+	{
+	public:
+		using TTextureViewBase = TextureViewBase<EngineNullImplTraits>;
+
+		TextureViewNullImpl(IReferenceCounters* pRefCounters,
+			RenderDeviceNullImpl* pDevice,
+			const TextureViewDesc& ViewDesc,
+			ITexture* pTexture,
+			bool bIsDefaultView)
+			: TTextureViewBase{ pRefCounters, pDevice, ViewDesc, pTexture, bIsDefaultView }
+		{
+		}
+	};
+
+} // namespace shz
@@ -0,0 +1,94 @@
+#pragma once
+
+ // \file
+ // Definition of the shz::IDeviceContextNull interface
+
+#include "Engine/RHI/Interface/IDeviceContext.h"
+
+namespace shz
+{
+
+	// {5E0B7C3A-2F61-4D8E-9B47-1C6A3D90E2F4}
+	static constexpr INTERFACE_ID IID_DeviceContextNull =
+	{ 0x5e0b7c3a, 0x2f61, 0x4d8e, {0x9b, 0x47, 0x1c, 0x6a, 0x3d, 0x90, 0xe2, 0xf4} };
+
+	// Command types recorded by the null backend.
+	enum NULL_COMMAND_TYPE : uint8
+	{
+		NULL_COMMAND_SET_PIPELINE_STATE = 0,
+		NULL_COMMAND_COMMIT_SHADER_RESOURCES,
+		NULL_COMMAND_SET_VERTEX_BUFFERS,
+		NULL_COMMAND_SET_INDEX_BUFFER,
+		NULL_COMMAND_SET_VIEWPORTS,
+		NULL_COMMAND_SET_SCISSOR_RECTS,
+		NULL_COMMAND_SET_RENDER_TARGETS,
+		NULL_COMMAND_BEGIN_RENDER_PASS,
+		NULL_COMMAND_NEXT_SUBPASS,
+		NULL_COMMAND_END_RENDER_PASS,
+		NULL_COMMAND_DRAW,
+		NULL_COMMAND_DRAW_INDEXED,
+		NULL_COMMAND_DRAW_INDIRECT,
+		NULL_COMMAND_DRAW_INDEXED_INDIRECT,
+		NULL_COMMAND_DISPATCH_COMPUTE,
+		NULL_COMMAND_DISPATCH_COMPUTE_INDIRECT,
+		NULL_COMMAND_CLEAR_RENDER_TARGET,
+		NULL_COMMAND_CLEAR_DEPTH_STENCIL,
+		NULL_COMMAND_UPDATE_BUFFER,
+		NULL_COMMAND_COPY_BUFFER,
+		NULL_COMMAND_MAP_BUFFER,
+		NULL_COMMAND_UPDATE_TEXTURE,
+		NULL_COMMAND_COPY_TEXTURE,
+		NULL_COMMAND_GENERATE_MIPS,
+		NULL_COMMAND_RESOURCE_BARRIER,
+		NULL_COMMAND_EXECUTE_COMMAND_LIST,
+		NULL_COMMAND_FLUSH,
+		NULL_COMMAND_FINISH_FRAME,
+
+		NULL_COMMAND_TYPE_COUNT
+	};
+
+	// One recorded command.
+	// ObjectId is the unique ID of the main object of the command (PSO, SRB, buffer, texture,
+	// command list, ...), or 0 if there is none. The meaning of Args depends on the command:
+	//  - DRAW / DRAW_INDEXED:        vertex or index count, instance count, first vertex/index, first instance
+	//  - DISPATCH_COMPUTE:           thread group counts X, Y, Z
+	//  - COMMIT_SHADER_RESOURCES:    number of bound resources
+	//  - SET_VERTEX_BUFFERS:         start slot, number of buffers
+	//  - UPDATE_BUFFER / MAP_BUFFER: size in bytes (low, high), map type
+	//  - RESOURCE_BARRIER:           old state, new state
+	//  - EXECUTE_COMMAND_LIST:       number of commands in the list
+	struct NullCommand
+	{
+		NULL_COMMAND_TYPE Type = NULL_COMMAND_TYPE_COUNT;
+		int32 ObjectId = 0;
+		uint32 Args[4] = {};
+	};
+
+	// Per-type counters of recorded commands.
+	struct NullCommandCounters
+	{
+		uint32 Commands[NULL_COMMAND_TYPE_COUNT] = {};
+
+		// Bytes written through UpdateBuffer() and MapBuffer(MAP_WRITE).
+		uint64 BytesUploaded = 0;
+	};
+
+	// Exposes the command stream recorded by a null-backend device context.
+	struct SHZ_INTERFACE IDeviceContextNull : public IDeviceContext
+	{
+		// Returns the commands recorded since the last ResetCommandStream().
+
+		// \param [out] NumCommands - Number of commands in the returned array.
+		//
+		// \remarks Commands recorded by a deferred context are moved to the immediate
+		//          context when the command list is executed.
+		virtual const NullCommand* GetCommandStream(uint32& NumCommands) const = 0;
+
+		// Returns the command counters accumulated since the last ResetCommandStream().
+		virtual const NullCommandCounters& GetCommandCounters() const = 0;
+
+		// Clears the recorded command stream and the command counters.
+		virtual void ResetCommandStream() = 0;
+	};
+
+} // namespace shz
@@ -0,0 +1,69 @@
+#pragma once
+
+ // \file
+ // Declaration of functions that initialize the null (headless) rendering backend
+
+#include "Engine/RHI/Interface/IEngineFactory.h"
+#include "Engine/RHI/Interface/IRenderDevice.h"
+#include "Engine/RHI/Interface/IDeviceContext.h"
+#include "Engine/RHI/Interface/ISwapChain.h"
+
+namespace shz
+{
+
+	// Attributes of the null engine implementation
+	struct EngineNullCreateInfo : public EngineCreateInfo
+	{
+		// Path to DirectX Shader Compiler. Shaders are compiled and reflected as in the
+		// D3D12 backend; without DXC only FXC (shader model 5.1) is available.
+
+		// By default, the engine will search for "dxcompiler.dll".
+		const Char* pDxCompilerPath = nullptr;
+	};
+
+	// {A3C4E1D7-6B0F-4F52-8E1A-94D2B7C5F068}
+	static constexpr INTERFACE_ID IID_EngineFactoryNull =
+	{ 0xa3c4e1d7, 0x6b0f, 0x4f52, {0x8e, 0x1a, 0x94, 0xd2, 0xb7, 0xc5, 0xf0, 0x68} };
+
+	// Engine factory for the null rendering backend.
+
+	// The null backend creates every device object as a plain CPU object and records
+	// device context commands into an inspectable stream (see shz::IDeviceContextNull)
+	// instead of submitting them to a GPU. It needs no window or driver, so the renderer
+	// can be driven headlessly, e.g. to benchmark CPU-side frame cost. Shaders are
+	// compiled on the CPU so that they report their real resources and bytecode.
+	struct SHZ_INTERFACE IEngineFactoryNull : public IEngineFactory
+	{
+		// Creates a render device and device contexts for the null backend.
+
+		// \param [in] EngineCI    - Engine creation info. Only NumImmediateContexts,
+		//                           NumDeferredContexts, the asynchronous shader compilation
+		//                           settings and pDxCompilerPath are used.
+		// \param [out] ppDevice   - Address of the memory location where pointer to
+		//                           the created device will be written.
+		// \param [out] ppContexts - Address of the memory location where pointers to
+		//                           the contexts will be written. Immediate context goes at
+		//                           position 0. If `EngineCI.NumDeferredContexts > 0`,
+		//                           pointers to the deferred contexts are written afterwards.
+		virtual void CreateDeviceAndContextsNull(
+			const EngineNullCreateInfo& EngineCI,
+			IRenderDevice** ppDevice,
+			IDeviceContext** ppContexts) = 0;
+
+		// Creates an offscreen swap chain for the null backend.
+
+		// \param [in] pDevice           - Pointer to the render device.
+		// \param [in] pImmediateContext - Pointer to the immediate device context.
+		// \param [in] SCDesc            - Swap chain description. Width and Height must not be zero.
+		// \param [out] ppSwapChain      - Address of the memory location where pointer to the new
+		//                                 swap chain will be written.
+		virtual void CreateSwapChainNull(
+			IRenderDevice* pDevice,
+			IDeviceContext* pImmediateContext,
+			const SwapChainDesc& SCDesc,
+			ISwapChain** ppSwapChain) = 0;
+	};
+
+	struct IEngineFactoryNull* GetEngineFactoryNull();
+
+} // namespace shz
@@ -0,0 +1,24 @@
+// pch.h: This is a precompiled header file.
+// Files listed below are compiled only once, improving build performance for future builds.
+// This also affects IntelliSense performance, including code completion and many code browsing features.
+// However, files listed here are ALL re-compiled if any one of them is updated between builds.
+// Do not add files here that you will be updating frequently as this negates the performance advantage.
+
+#ifndef PCH_H
+#define PCH_H
+
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+#include "Primitives/BasicTypes.h"
+#include "Primitives/DebugUtilities.hpp"
+#include "Primitives/FlagEnum.h"
+#include "Platforms/Common/PlatformDefinitions.h"
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+#include "Engine/Core/Common/Public/Cast.hpp"
+#include "Engine/Core/Memory/Public/STDAllocator.hpp"
+
+
+#endif //PCH_H
@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "Engine/RenderPass/Public/BarrierBatch.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Engine/Core/Common/Public/Errors.hpp"
+
+namespace shz
+{
+	namespace
+	{
+		static inline bool isReadOnlyState(RESOURCE_STATE state)
+		{
+			return state != RESOURCE_STATE_UNKNOWN && (state & ~RESOURCE_STATE_GENERIC_READ) == 0;
+		}
+
+		// UAV barriers also order accesses, so they are never considered redundant.
+		static inline bool isAlreadyInState(RESOURCE_STATE current, RESOURCE_STATE target)
+		{
+			if (current == RESOURCE_STATE_UNKNOWN || (target & RESOURCE_STATE_UNORDERED_ACCESS) != 0)
+			{
+				return false;
+			}
+
+			return (current & target) == target;
+		}
+	} // namespace
+
+	void BarrierBatch::Reset()
+	{
+		advanceGeneration();
+		m_Entries.clear();
+		m_Barriers.clear();
+		m_Stats = {};
+	}
+
+	void BarrierBatch::Push(IDeviceObject* pResource, int32 uniqueID, RESOURCE_STATE currentState, RESOURCE_STATE from, RESOURCE_STATE to)
+	{
+		ASSERT(pResource, "Device object is null.");
+		ASSERT(uniqueID > 0, "Device object has no unique ID.");
+
+		++m_Stats.Pushed;
+
+		// Keep the table at most half full so probe runs stay short.
+		if ((m_Entries.size() + 1) * 2 > m_Slots.size())
+		{
+			growSlots();
+		}
+
+		Slot& slot = findSlot(uniqueID);
+		if (slot.Generation == m_Generation)
+		{
+			++m_Stats.Merged;
+
+			StateTransitionDesc& b = m_Entries[slot.EntryIndex].Barrier;
+			ASSERT(b.pResource == pResource, "Unique ID collision in barrier batch.");
+
+			if (b.OldState != from)
+			{
+				b.OldState = RESOURCE_STATE_UNKNOWN;
+			}
+
+			if (b.NewState != to)
+			{
+				if (isReadOnlyState(b.NewState) && isReadOnlyState(to))
+				{
+					b.NewState |= to;
+				}
+				else
+				{
+					LOG_WARNING_MESSAGE("Conflicting barrier states (", static_cast<uint32>(b.NewState), " and ", static_cast<uint32>(to),
+						") for resource ", uniqueID, " in one batch. The last one wins.");
+					b.NewState = to;
+				}
+			}
+			return;
+		}
+
+		slot.Generation = m_Generation;
+		slot.UniqueID = uniqueID;
+		slot.EntryIndex = static_cast<uint32>(m_Entries.size());
+
+		Entry e = {};
+		e.UniqueID = uniqueID;
+		e.CurrentState = currentState;
+		e.Barrier.pResource = pResource;
+		e.Barrier.OldState = from;
+		e.Barrier.NewState = to;
+		e.Barrier.Flags = STATE_TRANSITION_FLAG_UPDATE_STATE;
+		m_Entries.push_back(e);
+	}
+
+	std::span<const StateTransitionDesc> BarrierBatch::Finalize()
+	{
+		m_Barriers.clear();
+		m_Stats.Skipped = 0;
+
+		// Sort first: the slot table is only needed while pushing.
+		std::sort(m_Entries.begin(), m_Entries.end(),
+			[](const Entry& a, const Entry& b) { return a.UniqueID < b.UniqueID; });
+
+		m_Barriers.reserve(m_Entries.size());
+		for (const Entry& e : m_Entries)
+		{
+			if (isAlreadyInState(e.CurrentState, e.Barrier.NewState))
+			{
+				++m_Stats.Skipped;
+				continue;
+			}
+
+			m_Barriers.push_back(e.Barrier);
+		}
+
+		// Entries are out of push order now; further pushes would hit stale slots.
+		advanceGeneration();
+		m_Entries.clear();
+
+		m_Stats.Emitted = static_cast<uint32>(m_Barriers.size());
+		return { m_Barriers.data(), m_Barriers.size() };
+	}
+
+	BarrierBatch::Slot& BarrierBatch::findSlot(int32 uniqueID)
+	{
+		// Fibonacci hashing: unique IDs are sequential, the top bits spread them.
+		const size_t mask = m_Slots.size() - 1;
+		size_t i = (static_cast<uint32>(uniqueID) * 0x9E3779B1u) >> m_SlotShift;
+		while (m_Slots[i].Generation == m_Generation && m_Slots[i].UniqueID != uniqueID)
+		{
+			i = (i + 1) & mask;
+		}
+		return m_Slots[i];
+	}
+
+	void BarrierBatch::growSlots()
+	{
+		const size_t slotCount = std::max(MIN_SLOT_COUNT, m_Slots.size() * 2);
+		m_Slots.assign(slotCount, Slot{});
+		m_SlotShift = 32 - static_cast<uint32>(std::countr_zero(slotCount));
+
+		for (uint32 i = 0; i < static_cast<uint32>(m_Entries.size()); ++i)
+		{
+			Slot& slot = findSlot(m_Entries[i].UniqueID);
+			slot.Generation = m_Generation;
+			slot.UniqueID = m_Entries[i].UniqueID;
+			slot.EntryIndex = i;
+		}
+	}
+
+	void BarrierBatch::advanceGeneration()
+	{
+		// Nothing was inserted under the current stamp.
+		if (m_Entries.empty())
+		{
+			return;
+		}
+
+		// Only a wrap needs the table cleared (stamp 0 is never current).
+		if (++m_Generation == 0)
+		{
+			std::fill(m_Slots.begin(), m_Slots.end(), Slot{});
+			m_Generation = 1;
+		}
+	}
+} // namespace shz
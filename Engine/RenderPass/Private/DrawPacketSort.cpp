@@ -0,0 +1,124 @@
+#include "pch.h"
+#include "Engine/RenderPass/Public/DrawPacketSort.h"
+
+#include <cstring>
+
+namespace shz
+{
+	namespace
+	{
+		static inline uint64 foldId(uint32 id, uint32 bits)
+		{
+			const uint32 mask = (1u << bits) - 1u;
+			return static_cast<uint64>((id ^ (id >> bits)) & mask);
+		}
+
+		static inline uint32 objectId(const IDeviceObject* pObj)
+		{
+			return pObj ? static_cast<uint32>(pObj->GetUniqueID()) : 0u;
+		}
+
+		// SRBs are not device objects; their address is stable for the frame.
+		static inline uint32 pointerId(const void* p)
+		{
+			const uint64 v = static_cast<uint64>(reinterpret_cast<uintptr_t>(p)) >> 4;
+			return static_cast<uint32>(v ^ (v >> 32));
+		}
+
+		struct SortEntry final
+		{
+			uint64 Key;
+			uint32 Index;
+		};
+
+		constexpr uint32 RADIX_BITS = 8;
+		constexpr uint32 RADIX_SIZE = 1u << RADIX_BITS;
+		constexpr uint32 RADIX_PASSES = 64 / RADIX_BITS;
+	} // namespace
+
+	uint64 DrawSortKey::Make(const DrawPacket& pkt, float viewDepth)
+	{
+		const uint32 vb = objectId(pkt.VertexBuffer);
+		const uint32 ib = objectId(pkt.IndexBuffer);
+
+		// Positive floats compare like their bit patterns; keep the top DEPTH_BITS below the sign.
+		uint32 depthBits = 0;
+		if (viewDepth > 0.f)
+		{
+			std::memcpy(&depthBits, &viewDepth, sizeof(depthBits));
+			depthBits >>= (31 - DEPTH_BITS);
+		}
+
+		return (foldId(objectId(pkt.PSO), PSO_BITS) << PSO_SHIFT)
+			| (foldId(pointerId(pkt.SRB), SRB_BITS) << SRB_SHIFT)
+			| (foldId(vb ^ (ib << 7), GEOMETRY_BITS) << GEOMETRY_SHIFT)
+			| (static_cast<uint64>(depthBits) << DEPTH_SHIFT);
+	}
+
+	void SortDrawPackets(ArenaVector<DrawPacket>& packets, ArenaAllocator& scratch)
+	{
+		const size_t count = packets.size();
+		if (count < 2)
+		{
+			return;
+		}
+
+		ArenaVector<SortEntry> a(STD_ARENA_ALLOCATOR(SortEntry, scratch, "DrawPacketSortA"));
+		ArenaVector<SortEntry> b(STD_ARENA_ALLOCATOR(SortEntry, scratch, "DrawPacketSortB"));
+		a.resize(count);
+		b.resize(count);
+
+		// All digit histograms in one read.
+		uint32 histograms[RADIX_PASSES][RADIX_SIZE] = {};
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint64 key = packets[i].SortKey;
+			a[i] = { key, static_cast<uint32>(i) };
+
+			for (uint32 p = 0; p < RADIX_PASSES; ++p)
+			{
+				++histograms[p][(key >> (p * RADIX_BITS)) & (RADIX_SIZE - 1)];
+			}
+		}
+
+		SortEntry* pSrc = a.data();
+		SortEntry* pDst = b.data();
+
+		for (uint32 p = 0; p < RADIX_PASSES; ++p)
+		{
+			uint32* hist = histograms[p];
+			const uint32 shift = p * RADIX_BITS;
+
+			// Every key shares this digit: the pass would be a plain copy.
+			if (hist[(pSrc[0].Key >> shift) & (RADIX_SIZE - 1)] == count)
+			{
+				continue;
+			}
+
+			uint32 offset = 0;
+			for (uint32 d = 0; d < RADIX_SIZE; ++d)
+			{
+				const uint32 c = hist[d];
+				hist[d] = offset;
+				offset += c;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const SortEntry& e = pSrc[i];
+				pDst[hist[(e.Key >> shift) & (RADIX_SIZE - 1)]++] = e;
+			}
+
+			std::swap(pSrc, pDst);
+		}
+
+		ArenaVector<DrawPacket> sorted(STD_ARENA_ALLOCATOR(DrawPacket, scratch, "SortedDrawPackets"));
+		sorted.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			sorted.push_back(packets[pSrc[i].Index]);
+		}
+
+		std::copy(sorted.begin(), sorted.end(), packets.begin());
+	}
+} // namespace shz
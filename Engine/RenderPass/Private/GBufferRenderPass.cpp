@@ -3,6 +3,7 @@
 #include "Engine/RenderPass/Public/RenderPassContext.h"
 
 #include "Engine/RHI/Interface/GraphicsTypes.h"
+#include "Engine/Core/Common/Public/Timer.hpp"
 
 #include "Engine/Renderer/Public/ViewFamily.h"
 #include "Engine/Renderer/Public/RenderScene.h"
@@ -42,6 +43,7 @@ namespace shz
 	{
 		(void)ctx;
 		m_DrawCallCount = 0;
+		m_StateChangeStats = {};
 	}
 
 	void GBufferRenderPass::Execute(RenderPassContext& ctx)
@@ -50,20 +52,42 @@ namespace shz
 
 		IDeviceContext* pContext = ctx.pImmediateContext;
 
-		const std::vector<DrawPacket>& packets = ctx.GBufferDrawPackets;
+		PushPreBarriers(ctx);
+		ctx.FlushBarriers(pContext);
 
-		// RT/DS transitions
-		{
-			StateTransitionDesc tr[] =
-			{
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer0_Albedo")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer1_Normal")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer2_MRAO")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer3_Emissive")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBufferDepth")),      RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_DEPTH_WRITE,   STATE_TRANSITION_FLAG_UPDATE_STATE },
-			};
-			pContext->TransitionResourceStates(_countof(tr), tr);
+		Record(ctx, pContext);
+
+		PushPostBarriers(ctx);
+		ctx.FlushPostBarriers(pContext);
+	}
+
+	void GBufferRenderPass::PushPreBarriers(RenderPassContext& ctx)
+	{
+		ctx.PushBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer0_Albedo")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET);
+		ctx.PushBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer1_Normal")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET);
+		ctx.PushBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer2_MRAO")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET);
+		ctx.PushBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer3_Emissive")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET);
+		ctx.PushBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBufferDepth")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_DEPTH_WRITE);
+	}
+
+	void GBufferRenderPass::PushPostBarriers(RenderPassContext& ctx)
+	{
+		// Outputs -> SRV
+		ctx.PushPostBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer0_Albedo")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+		ctx.PushPostBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer1_Normal")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+		ctx.PushPostBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer2_MRAO")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+		ctx.PushPostBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBuffer3_Emissive")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+		ctx.PushPostBarrier(ctx.pRegistry->GetTexture(STRING_HASH("GBufferDepth")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+	}
+
+	void GBufferRenderPass::Record(RenderPassContext& ctx, IDeviceContext* pContext)
+	{
+		ASSERT(pContext, "Context is null.");
+
+		// Sorted by DrawPacket::SortKey, so equal state is contiguous.
+		const std::span<const DrawPacket> packets = ctx.GBufferDrawPackets;
 
+		{
 			OptimizedClearValue clearVals[5] = {};
 			for (int i = 0; i < 4; ++i)
 			{
@@ -84,11 +108,21 @@ namespace shz
 			pContext->BeginRenderPass(rp);
 		}
 
+		// Instance stream: the object index rides in VB slot 1, nothing is uploaded per draw.
+		const bool bObjectIndexStream = (ctx.DrawInstanceOffsetMode == EDrawInstanceOffsetMode::InstanceStream);
+		IBuffer* pObjectIndexStream = bObjectIndexStream ? ctx.pRegistry->GetBuffer(kRes_ObjectIndexVB) : nullptr;
+		IBuffer* pDrawCB = ctx.pRegistry->GetBuffer(kRes_DrawCB);
+		ASSERT(!bObjectIndexStream || pObjectIndexStream, "Object index stream is null.");
+
 		IPipelineState* pLastPSO = nullptr;
 		IShaderResourceBinding* pLastSRB = nullptr;
 		IBuffer* pLastVB = nullptr;
 		IBuffer* pLastIB = nullptr;
 
+#ifdef PROFILING
+		Timer recordTimer;
+#endif
+
 		for (const DrawPacket& pkt : packets)
 		{
 			ASSERT(pkt.PSO && pkt.SRB && pkt.VertexBuffer && pkt.IndexBuffer, "Invalid draw packet values.");
@@ -99,6 +133,9 @@ namespace shz
 				pLastPSO = pkt.PSO;
 				pLastSRB = nullptr;
 				pContext->SetPipelineState(pLastPSO);
+#ifdef PROFILING
+				++m_StateChangeStats.PSOBinds;
+#endif
 			}
 
 			// Bind SRB
@@ -106,38 +143,48 @@ namespace shz
 			{
 				pLastSRB = pkt.SRB;
 				pContext->CommitShaderResources(pLastSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+#ifdef PROFILING
+				++m_StateChangeStats.SRBBinds;
+#endif
 			}
 
 			// VB/IB binding (ONLY mesh VB)
 			if (pLastVB != pkt.VertexBuffer)
 			{
-				IBuffer* ppVertexBuffers[] = { pkt.VertexBuffer };
-				uint64 pOffsets[] = { 0 };
+				IBuffer* ppVertexBuffers[] = { pkt.VertexBuffer, pObjectIndexStream };
+				uint64 pOffsets[] = { 0, 0 };
 
 				pContext->SetVertexBuffers(
 					0,
-					1,
+					bObjectIndexStream ? 2 : 1,
 					ppVertexBuffers,
 					pOffsets,
 					RESOURCE_STATE_TRANSITION_MODE_VERIFY,
 					SET_VERTEX_BUFFERS_FLAG_RESET);
 
 				pLastVB = pkt.VertexBuffer;
+#ifdef PROFILING
+				++m_StateChangeStats.VBBinds;
+#endif
 			}
 
 			if (pLastIB != pkt.IndexBuffer)
 			{
 				pContext->SetIndexBuffer(pkt.IndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 				pLastIB = pkt.IndexBuffer;
+#ifdef PROFILING
+				++m_StateChangeStats.IBBinds;
+#endif
 			}
 
-			// Per-draw: StartInstanceLocation -> DrawCB
 			DrawIndexedAttribs dia = pkt.DrawAttribs;
 #ifdef SHZ_DEBUG
 			if (dia.Flags == DRAW_FLAG_NONE) dia.Flags = DRAW_FLAG_VERIFY_ALL;
 #endif
+			// Per-draw: StartInstanceLocation -> DrawCB
+			if (!bObjectIndexStream)
 			{
-				MapHelper<hlsl::DrawConstants> map(pContext, ctx.pRegistry->GetBuffer(kRes_DrawCB), MAP_WRITE, MAP_FLAG_DISCARD);
+				MapHelper<hlsl::DrawConstants> map(pContext, pDrawCB, MAP_WRITE, MAP_FLAG_DISCARD);
 				hlsl::DrawConstants* dst = map;
 
 				dst->StartInstanceLocation = dia.FirstInstanceLocation;
@@ -146,23 +193,15 @@ namespace shz
 			pContext->DrawIndexed(dia);
 #ifdef PROFILING
 			++m_DrawCallCount;
+			++m_StateChangeStats.Draws;
 #endif
 		}
 
-		pContext->EndRenderPass();
+#ifdef PROFILING
+		m_StateChangeStats.RecordMilliseconds = recordTimer.GetElapsedTime() * 1000.0;
+#endif
 
-		// Outputs -> SRV
-		{
-			StateTransitionDesc tr2[] =
-			{
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer0_Albedo")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer1_Normal")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer2_MRAO")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBuffer3_Emissive")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
-				{ ctx.pRegistry->GetTexture(STRING_HASH("GBufferDepth")),      RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
-			};
-			pContext->TransitionResourceStates(_countof(tr2), tr2);
-		}
+		pContext->EndRenderPass();
 	}
 
 	void GBufferRenderPass::EndFrame(RenderPassContext& ctx)
@@ -68,6 +68,7 @@ namespace shz
 		ASSERT(ctx.pDevice, "Device is null.");
 		ASSERT(ctx.pSwapChain, "SwapChain is null.");
 		ASSERT(ctx.pShaderSourceFactory, "ShaderSourceFactory is null.");
+		ASSERT(ctx.pShaderCache, "ShaderCache is null.");
 
 		// ------------------------------------------------------------
 		// Create RenderPass (Color=LOAD, Depth=LOAD)
@@ -248,23 +249,124 @@ namespace shz
 		}
 
 		// ------------------------------------------------------------
-		// Compute PSO #1: GenerateGrassInstances
+		// Shaders (pipelines are created in CreatePipelines())
+		// ------------------------------------------------------------
+		{
+			const bool ok = createShaders(ctx, m_PendingShaders);
+			ASSERT(ok, "Failed to create grass pass shaders.");
+		}
+
 		// ------------------------------------------------------------
+		// Framebuffer for current back buffer
+		// ------------------------------------------------------------
+		buildFramebufferForCurrentBackBuffer(ctx);
+	}
+
+	bool GrassRenderPass::CreatePipelines(RenderPassContext& ctx)
+	{
+		const bool ok = createPipelines(ctx, m_PendingShaders);
+		ASSERT(ok, "Failed to create grass pass pipelines.");
+
+		m_PendingShaders = {};
+		return ok;
+	}
+
+	bool GrassRenderPass::createShaders(RenderPassContext& ctx, ShaderSet& out)
+	{
+		auto create = [&](const char* name, SHADER_TYPE type, const std::string& filePath, const char* entryPoint, RefCntAutoPtr<IShader>& outShader)
 		{
 			ShaderCreateInfo sci = {};
 			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+			sci.Desc.ShaderType = type;
 			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
 			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
 
-			sci.Desc.Name = "GrassGenerateInstancesCS";
-			sci.EntryPoint = "GenerateGrassInstances";
-			sci.FilePath = "GrassBuildInstances.hlsl";
+			sci.Desc.Name = name;
+			sci.EntryPoint = entryPoint;
+			sci.FilePath = filePath.c_str();
 
-			RefCntAutoPtr<IShader> pCS;
-			ctx.pDevice->CreateShader(sci, &pCS);
-			ASSERT(pCS, "CreateShader(GrassGenerateInstancesCS) failed.");
+			outShader.Release();
+			ctx.pShaderCache->CreateShader(ctx.pDevice, sci, &outShader);
+			if (!outShader)
+			{
+				LOG_ERROR_MESSAGE("CreateShader(", name, ") failed.");
+			}
+		};
 
+		create("GrassGenerateInstancesCS", SHADER_TYPE_COMPUTE, m_BuildInstancesCS, "GenerateGrassInstances", out.GenCS);
+		create("GrassWriteIndirectArgsCS", SHADER_TYPE_COMPUTE, m_BuildInstancesCS, "WriteIndirectArgs", out.ArgsCS);
+		create("GrassVS", SHADER_TYPE_VERTEX, m_VS, "main", out.VS);
+		create("GrassPS", SHADER_TYPE_PIXEL, m_PS, "main", out.PS);
+		create("InteractionDecayCS", SHADER_TYPE_COMPUTE, m_InteractionCS, "DecayInteractionField", out.DecayCS);
+		create("InteractionApplyStampsCS", SHADER_TYPE_COMPUTE, m_InteractionCS, "ApplyInteractionStamps", out.ApplyCS);
+
+		return out.GenCS && out.ArgsCS && out.VS && out.PS && out.DecayCS && out.ApplyCS;
+	}
+
+	bool GrassRenderPass::RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles)
+	{
+		bool bAffected = false;
+		for (const std::string* pPath : { &m_BuildInstancesCS, &m_VS, &m_PS, &m_InteractionCS })
+		{
+			bAffected = bAffected || changedFiles.count(*pPath) != 0;
+		}
+
+		if (!bAffected)
+		{
+			return false;
+		}
+
+		// Unchanged stages are bytecode cache hits.
+		m_PendingShaders = {};
+		createShaders(ctx, m_PendingShaders);
+		return true;
+	}
+
+	bool GrassRenderPass::FinishShaderReload(RenderPassContext& ctx)
+	{
+		const ShaderSet& pending = m_PendingShaders;
+
+		bool bReady = true;
+		for (IShader* pShader : { pending.GenCS.RawPtr(), pending.ArgsCS.RawPtr(), pending.VS.RawPtr(), pending.PS.RawPtr(), pending.DecayCS.RawPtr(), pending.ApplyCS.RawPtr() })
+		{
+			if (pShader != nullptr && pShader->GetStatus() == SHADER_STATUS_COMPILING)
+			{
+				return false;
+			}
+			bReady = bReady && pShader != nullptr && pShader->GetStatus() == SHADER_STATUS_READY;
+		}
+
+		if (bReady)
+		{
+			// createPipelines() binds the pass buffers again; per-frame inputs are bound in Execute().
+			m_pGenCSRB.Release();
+			m_pGenCSO.Release();
+			m_pArgsCSRB.Release();
+			m_pArgsCSO.Release();
+			m_pGrassSRB.Release();
+			m_pGrassPSO.Release();
+			m_pInteractionDecaySRB.Release();
+			m_pInteractionDecayCSO.Release();
+			m_pInteractionApplySRB.Release();
+			m_pInteractionApplyCSO.Release();
+
+			createPipelines(ctx, pending);
+		}
+		else
+		{
+			LOG_ERROR_MESSAGE("Grass shaders failed to compile; keeping the previous pipelines.");
+		}
+
+		m_PendingShaders = {};
+		return true;
+	}
+
+	bool GrassRenderPass::createPipelines(RenderPassContext& ctx, const ShaderSet& shaders)
+	{
+		// ------------------------------------------------------------
+		// Compute PSO #1: GenerateGrassInstances
+		// ------------------------------------------------------------
+		{
 			ComputePipelineStateCreateInfo psoCI = {};
 			psoCI.PSODesc.Name = "PSO_GrassGenerateInstances";
 			psoCI.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
@@ -298,9 +400,9 @@ namespace shz
 			rl.ImmutableSamplers = samplers;
 			rl.NumImmutableSamplers = _countof(samplers);
 
-			psoCI.pCS = pCS;
+			psoCI.pCS = shaders.GenCS;
 
-			ctx.pDevice->CreateComputePipelineState(psoCI, &m_pGenCSO);
+			m_pGenCSO = ctx.pPipelineStateManager->AcquireCompute(psoCI);
 			ASSERT(m_pGenCSO, "CreateComputePipelineState(PSO_GrassGenerateInstances) failed.");
 
 			if (auto* var = m_pGenCSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "FRAME_CONSTANTS"))
@@ -331,21 +433,6 @@ namespace shz
 		// Compute PSO #2: WriteIndirectArgs
 		// ------------------------------------------------------------
 		{
-			ShaderCreateInfo sci = {};
-			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.Desc.ShaderType = SHADER_TYPE_COMPUTE;
-			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-			sci.Desc.UseCombinedTextureSamplers = false;
-
-			sci.Desc.Name = "GrassWriteIndirectArgsCS";
-			sci.EntryPoint = "WriteIndirectArgs";
-			sci.FilePath = "GrassBuildInstances.hlsl";
-
-			RefCntAutoPtr<IShader> pCS;
-			ctx.pDevice->CreateShader(sci, &pCS);
-			ASSERT(pCS, "CreateShader(GrassWriteIndirectArgsCS) failed.");
-
 			ComputePipelineStateCreateInfo psoCI = {};
 			psoCI.PSODesc.Name = "PSO_GrassWriteIndirectArgs";
 			psoCI.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
@@ -361,9 +448,9 @@ namespace shz
 			rl.Variables = vars;
 			rl.NumVariables = _countof(vars);
 
-			psoCI.pCS = pCS;
+			psoCI.pCS = shaders.ArgsCS;
 
-			ctx.pDevice->CreateComputePipelineState(psoCI, &m_pArgsCSO);
+			m_pArgsCSO = ctx.pPipelineStateManager->AcquireCompute(psoCI);
 			ASSERT(m_pArgsCSO, "CreateComputePipelineState(PSO_GrassWriteIndirectArgs) failed.");
 
 			m_pArgsCSO->CreateShaderResourceBinding(&m_pArgsCSRB, true);
@@ -380,29 +467,6 @@ namespace shz
 		// Graphics PSO: Grass
 		// ------------------------------------------------------------
 		{
-			ShaderCreateInfo vsCI = {};
-			vsCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			vsCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
-			vsCI.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-			vsCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-			vsCI.Desc.Name = "GrassVS";
-			vsCI.EntryPoint = "main";
-			vsCI.FilePath = "GrassForward.vsh";
-
-			ShaderCreateInfo psCI = {};
-			psCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			psCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
-			psCI.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-			psCI.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-			psCI.Desc.Name = "GrassPS";
-			psCI.EntryPoint = "main";
-			psCI.FilePath = "GrassForward.psh";
-
-			RefCntAutoPtr<IShader> vs, ps;
-			ctx.pDevice->CreateShader(vsCI, &vs);
-			ctx.pDevice->CreateShader(psCI, &ps);
-			ASSERT(vs && ps, "CreateShader(GrassVS/PS) failed.");
-
 			GraphicsPipelineStateCreateInfo psoCI = {};
 			psoCI.PSODesc.Name = "PSO_Grass";
 			psoCI.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
@@ -465,8 +529,8 @@ namespace shz
 			gp.DepthStencilDesc.DepthWriteEnable = true;
 			gp.DepthStencilDesc.DepthFunc = COMPARISON_FUNC_LESS_EQUAL;
 
-			psoCI.pVS = vs;
-			psoCI.pPS = ps;
+			psoCI.pVS = shaders.VS;
+			psoCI.pPS = shaders.PS;
 
 			static LayoutElement layoutElems[] =
 			{
@@ -478,7 +542,7 @@ namespace shz
 			gp.InputLayout.LayoutElements = layoutElems;
 			gp.InputLayout.NumElements = _countof(layoutElems);
 
-			ctx.pDevice->CreatePipelineState(psoCI, &m_pGrassPSO);
+			m_pGrassPSO = ctx.pPipelineStateManager->AcquireGraphics(psoCI);
 			ASSERT(m_pGrassPSO, "CreatePipelineState(PSO_Grass) failed.");
 
 			if (auto* var = m_pGrassPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "FRAME_CONSTANTS"))
@@ -533,20 +597,6 @@ namespace shz
 		// Compute PSO: Interaction Decay
 		// ------------------------------------------------------------
 		{
-			ShaderCreateInfo sci = {};
-			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.Desc.ShaderType = SHADER_TYPE_COMPUTE;
-			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-
-			sci.Desc.Name = "InteractionDecayCS";
-			sci.EntryPoint = "DecayInteractionField";
-			sci.FilePath = "InteractionFieldUpdate.hlsl";
-
-			RefCntAutoPtr<IShader> pCS;
-			ctx.pDevice->CreateShader(sci, &pCS);
-			ASSERT(pCS, "CreateShader(InteractionDecayCS) failed.");
-
 			ComputePipelineStateCreateInfo psoCI = {};
 			psoCI.PSODesc.Name = "PSO_InteractionDecay";
 			psoCI.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
@@ -562,9 +612,9 @@ namespace shz
 			rl.Variables = vars;
 			rl.NumVariables = _countof(vars);
 
-			psoCI.pCS = pCS;
+			psoCI.pCS = shaders.DecayCS;
 
-			ctx.pDevice->CreateComputePipelineState(psoCI, &m_pInteractionDecayCSO);
+			m_pInteractionDecayCSO = ctx.pPipelineStateManager->AcquireCompute(psoCI);
 			ASSERT(m_pInteractionDecayCSO, "CreateComputePipelineState(PSO_InteractionDecay) failed.");
 
 			m_pInteractionDecayCSO->CreateShaderResourceBinding(&m_pInteractionDecaySRB, true);
@@ -578,20 +628,6 @@ namespace shz
 		// Compute PSO: Interaction Apply Stamps
 		// ------------------------------------------------------------
 		{
-			ShaderCreateInfo sci = {};
-			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.Desc.ShaderType = SHADER_TYPE_COMPUTE;
-			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-
-			sci.Desc.Name = "InteractionApplyStampsCS";
-			sci.EntryPoint = "ApplyInteractionStamps";
-			sci.FilePath = "InteractionFieldUpdate.hlsl";
-
-			RefCntAutoPtr<IShader> pCS;
-			ctx.pDevice->CreateShader(sci, &pCS);
-			ASSERT(pCS, "CreateShader(InteractionApplyStampsCS) failed.");
-
 			ComputePipelineStateCreateInfo psoCI = {};
 			psoCI.PSODesc.Name = "PSO_InteractionApplyStamps";
 			psoCI.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
@@ -621,9 +657,9 @@ namespace shz
 			rl.ImmutableSamplers = samplers;
 			rl.NumImmutableSamplers = _countof(samplers);
 
-			psoCI.pCS = pCS;
+			psoCI.pCS = shaders.ApplyCS;
 
-			ctx.pDevice->CreateComputePipelineState(psoCI, &m_pInteractionApplyCSO);
+			m_pInteractionApplyCSO = ctx.pPipelineStateManager->AcquireCompute(psoCI);
 			ASSERT(m_pInteractionApplyCSO, "CreateComputePipelineState(PSO_InteractionApplyStamps) failed.");
 
 			m_pInteractionApplyCSO->CreateShaderResourceBinding(&m_pInteractionApplySRB, true);
@@ -636,10 +672,7 @@ namespace shz
 				var->Set(m_pInteractionStampBuffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE));
 		}
 
-		// ------------------------------------------------------------
-		// Framebuffer for current back buffer
-		// ------------------------------------------------------------
-		buildFramebufferForCurrentBackBuffer(ctx);
+		return m_pGenCSO && m_pArgsCSO && m_pGrassPSO && m_pInteractionDecayCSO && m_pInteractionApplyCSO;
 	}
 
 	GrassRenderPass::~GrassRenderPass()
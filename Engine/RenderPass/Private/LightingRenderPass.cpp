@@ -17,6 +17,7 @@ namespace shz
 		ASSERT(ctx.pImmediateContext, "Context is null.");
 		ASSERT(ctx.pSwapChain, "SwapChain is null.");
 		ASSERT(ctx.pShaderSourceFactory, "ShaderSourceFactory is null.");
+		ASSERT(ctx.pShaderCache, "ShaderCache is null.");
 
 		const uint32 w = (ctx.BackBufferWidth != 0) ? ctx.BackBufferWidth : 1;
 		const uint32 h = (ctx.BackBufferHeight != 0) ? ctx.BackBufferHeight : 1;
@@ -26,10 +27,20 @@ namespace shz
 		ok = createPassObjects(ctx);
 		ASSERT(ok, "Failed to create ligting pass objects.");
 
-		ok = createPSO(ctx);
+		ok = createShaders(ctx, &m_pPendingVS, &m_pPendingPS);
+		ASSERT(ok, "Failed to create ligting pass shaders.");
+	}
+
+	bool LightingRenderPass::CreatePipelines(RenderPassContext& ctx)
+	{
+		const bool ok = createPSO(ctx, m_pPendingVS, m_pPendingPS);
 		ASSERT(ok, "Failed to create ligting pass PSO.");
 
 		bindInputs(ctx);
+
+		m_pPendingVS.Release();
+		m_pPendingPS.Release();
+		return ok;
 	}
 
 	LightingRenderPass::~LightingRenderPass()
@@ -101,7 +112,77 @@ namespace shz
 		return true;
 	}
 
-	bool LightingRenderPass::createPSO(RenderPassContext& ctx)
+	bool LightingRenderPass::createShaders(RenderPassContext& ctx, IShader** ppVS, IShader** ppPS)
+	{
+		ShaderCreateInfo sci = {};
+		sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+		sci.EntryPoint = "main";
+		sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
+		sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+
+		sci.Desc = {};
+		sci.Desc.Name = "Lighting VS";
+		sci.Desc.ShaderType = SHADER_TYPE_VERTEX;
+		sci.FilePath = m_VS.c_str();
+		sci.Desc.UseCombinedTextureSamplers = false;
+		ctx.pShaderCache->CreateShader(ctx.pDevice, sci, ppVS);
+
+		sci.Desc = {};
+		sci.Desc.Name = "Lighting PS";
+		sci.Desc.ShaderType = SHADER_TYPE_PIXEL;
+		sci.FilePath = m_PS.c_str();
+		sci.Desc.UseCombinedTextureSamplers = false;
+		ctx.pShaderCache->CreateShader(ctx.pDevice, sci, ppPS);
+
+		return *ppVS != nullptr && *ppPS != nullptr;
+	}
+
+	bool LightingRenderPass::RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles)
+	{
+		if (changedFiles.count(m_VS) == 0 && changedFiles.count(m_PS) == 0)
+		{
+			return false;
+		}
+
+		m_pPendingVS.Release();
+		m_pPendingPS.Release();
+		createShaders(ctx, &m_pPendingVS, &m_pPendingPS);
+		return true;
+	}
+
+	bool LightingRenderPass::FinishShaderReload(RenderPassContext& ctx)
+	{
+		for (IShader* pShader : { m_pPendingVS.RawPtr(), m_pPendingPS.RawPtr() })
+		{
+			if (pShader != nullptr && pShader->GetStatus() == SHADER_STATUS_COMPILING)
+			{
+				return false;
+			}
+		}
+
+		const bool bReady =
+			m_pPendingVS && m_pPendingVS->GetStatus() == SHADER_STATUS_READY &&
+			m_pPendingPS && m_pPendingPS->GetStatus() == SHADER_STATUS_READY;
+
+		if (bReady)
+		{
+			m_pSRB.Release();
+			m_pPSO.Release();
+
+			createPSO(ctx, m_pPendingVS, m_pPendingPS);
+			bindInputs(ctx);
+		}
+		else
+		{
+			LOG_ERROR_MESSAGE("Lighting shaders failed to compile; keeping the previous pipeline.");
+		}
+
+		m_pPendingVS.Release();
+		m_pPendingPS.Release();
+		return true;
+	}
+
+	bool LightingRenderPass::createPSO(RenderPassContext& ctx, IShader* pVS, IShader* pPS)
 	{
 		ASSERT(ctx.pDevice, "Device is null.");
 
@@ -125,36 +206,8 @@ namespace shz
 		gp.RasterizerDesc.FrontCounterClockwise = true;
 		gp.DepthStencilDesc.DepthEnable = false;
 
-		ShaderCreateInfo sci = {};
-		sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-		sci.EntryPoint = "main";
-		sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-		sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-
-		RefCntAutoPtr<IShader> vs;
-		{
-			sci.Desc = {};
-			sci.Desc.Name = "Lighting VS";
-			sci.Desc.ShaderType = SHADER_TYPE_VERTEX;
-			sci.FilePath = m_VS.c_str();
-			sci.Desc.UseCombinedTextureSamplers = false;
-			ctx.pDevice->CreateShader(sci, &vs);
-			ASSERT(vs, "Failed to create DeferredLighting VS.");
-		}
-
-		RefCntAutoPtr<IShader> ps;
-		{
-			sci.Desc = {};
-			sci.Desc.Name = "Lighting PS";
-			sci.Desc.ShaderType = SHADER_TYPE_PIXEL;
-			sci.FilePath = m_PS.c_str();
-			sci.Desc.UseCombinedTextureSamplers = false;
-			ctx.pDevice->CreateShader(sci, &ps);
-			ASSERT(ps, "Failed to create DeferredLighting PS.");
-		}
-
-		psoCi.pVS = vs;
-		psoCi.pPS = ps;
+		psoCi.pVS = pVS;
+		psoCi.pPS = pPS;
 
 		psoCi.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
@@ -16,6 +16,7 @@ namespace shz
 		ASSERT(ctx.pImmediateContext, "Context is null.");
 		ASSERT(ctx.pSwapChain, "SwapChain is null.");
 		ASSERT(ctx.pShaderSourceFactory, "ShaderSourceFactory is null.");
+		ASSERT(ctx.pShaderCache, "ShaderCache is null.");
 
 		// Create render pass
 		{
@@ -50,91 +51,145 @@ namespace shz
 			ASSERT(m_pRenderPass, "CreateRenderPass(RP_Post) failed.");
 		}
 
-		// Create PSO
+		// Request shaders; the PSO is created in CreatePipelines().
 		{
-			ASSERT(!m_pPSO && !m_pSRB, "PSO/SRB is already initialized.");
+			const bool ok = createShaders(ctx, &m_pPendingVS, &m_pPendingPS);
+			ASSERT(ok, "Failed to create PostCopy shaders.");
+		}
+	}
 
-			GraphicsPipelineStateCreateInfo psoCi = {};
-			psoCi.PSODesc.Name = "Post Copy PSO";
-			psoCi.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+	bool PostRenderPass::CreatePipelines(RenderPassContext& ctx)
+	{
+		createPSO(ctx, m_pPendingVS, m_pPendingPS);
 
-			GraphicsPipelineDesc& gp = psoCi.GraphicsPipeline;
-			gp.pRenderPass = m_pRenderPass;
-			gp.SubpassIndex = 0;
+		m_pPendingVS.Release();
+		m_pPendingPS.Release();
+		return m_pPSO != nullptr;
+	}
 
-			// Render targets defined by render pass
-			gp.NumRenderTargets = 0;
-			gp.RTVFormats[0] = TEX_FORMAT_UNKNOWN;
-			gp.DSVFormat = TEX_FORMAT_UNKNOWN;
+	bool PostRenderPass::createShaders(RenderPassContext& ctx, IShader** ppVS, IShader** ppPS)
+	{
+		ShaderCreateInfo sci = {};
+		sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+		sci.EntryPoint = "main";
+		sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
+		sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+
+		sci.Desc = {};
+		sci.Desc.Name = "PostCopy VS";
+		sci.Desc.ShaderType = SHADER_TYPE_VERTEX;
+		sci.FilePath = m_VS.c_str();
+		sci.Desc.UseCombinedTextureSamplers = false;
+		ctx.pShaderCache->CreateShader(ctx.pDevice, sci, ppVS);
+
+		sci.Desc = {};
+		sci.Desc.Name = "PostCopy PS";
+		sci.Desc.ShaderType = SHADER_TYPE_PIXEL;
+		sci.FilePath = m_PS.c_str();
+		sci.Desc.UseCombinedTextureSamplers = false;
+		ctx.pShaderCache->CreateShader(ctx.pDevice, sci, ppPS);
+
+		return *ppVS != nullptr && *ppPS != nullptr;
+	}
 
-			gp.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-			gp.RasterizerDesc.CullMode = CULL_MODE_BACK;
-			gp.RasterizerDesc.FrontCounterClockwise = true;
-			gp.DepthStencilDesc.DepthEnable = false;
+	void PostRenderPass::createPSO(RenderPassContext& ctx, IShader* pVS, IShader* pPS)
+	{
+		ASSERT(!m_pPSO && !m_pSRB, "PSO/SRB is already initialized.");
 
-			ShaderCreateInfo sci = {};
-			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.EntryPoint = "main";
-			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+		GraphicsPipelineStateCreateInfo psoCi = {};
+		psoCi.PSODesc.Name = "Post Copy PSO";
+		psoCi.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
 
-			RefCntAutoPtr<IShader> vs;
-			{
-				sci.Desc = {};
-				sci.Desc.Name = "PostCopy VS";
-				sci.Desc.ShaderType = SHADER_TYPE_VERTEX;
-				sci.FilePath = m_VS.c_str();
-				sci.Desc.UseCombinedTextureSamplers = false;
-
-				ctx.pDevice->CreateShader(sci, &vs);
-				ASSERT(vs, "Failed to create PostCopy VS.");
-			}
+		GraphicsPipelineDesc& gp = psoCi.GraphicsPipeline;
+		gp.pRenderPass = m_pRenderPass;
+		gp.SubpassIndex = 0;
 
-			RefCntAutoPtr<IShader> ps;
-			{
-				sci.Desc = {};
-				sci.Desc.Name = "PostCopy PS";
-				sci.Desc.ShaderType = SHADER_TYPE_PIXEL;
-				sci.FilePath = m_PS.c_str();
-				sci.Desc.UseCombinedTextureSamplers = false;
-
-				ctx.pDevice->CreateShader(sci, &ps);
-				ASSERT(ps, "Failed to create PostCopy PS.");
-			}
+		// Render targets defined by render pass
+		gp.NumRenderTargets = 0;
+		gp.RTVFormats[0] = TEX_FORMAT_UNKNOWN;
+		gp.DSVFormat = TEX_FORMAT_UNKNOWN;
 
-			psoCi.pVS = vs;
-			psoCi.pPS = ps;
+		gp.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		gp.RasterizerDesc.CullMode = CULL_MODE_BACK;
+		gp.RasterizerDesc.FrontCounterClockwise = true;
+		gp.DepthStencilDesc.DepthEnable = false;
 
-			psoCi.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
+		psoCi.pVS = pVS;
+		psoCi.pPS = pPS;
 
-			ShaderResourceVariableDesc vars[] =
-			{
-				{ SHADER_TYPE_PIXEL, "g_InputColor", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE },
-			};
-			psoCi.PSODesc.ResourceLayout.Variables = vars;
-			psoCi.PSODesc.ResourceLayout.NumVariables = _countof(vars);
+		psoCi.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
-			SamplerDesc linearClamp =
-			{
-				FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR,
-				TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP
-			};
+		ShaderResourceVariableDesc vars[] =
+		{
+			{ SHADER_TYPE_PIXEL, "g_InputColor", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE },
+		};
+		psoCi.PSODesc.ResourceLayout.Variables = vars;
+		psoCi.PSODesc.ResourceLayout.NumVariables = _countof(vars);
+
+		SamplerDesc linearClamp =
+		{
+			FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR, FILTER_TYPE_LINEAR,
+			TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP
+		};
+
+		ImmutableSamplerDesc samplers[] =
+		{
+			{ SHADER_TYPE_PIXEL, "g_LinearClampSampler", linearClamp },
+		};
+		psoCi.PSODesc.ResourceLayout.ImmutableSamplers = samplers;
+		psoCi.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(samplers);
+
+		m_pPSO = ctx.pPipelineStateManager->AcquireGraphics(psoCi);
+		ASSERT(m_pPSO, "Failed to acquire Post PSO.");
 
-			ImmutableSamplerDesc samplers[] =
+		m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
+		ASSERT(m_pSRB, "Failed to create SRB_Post.");
+	}
+
+	bool PostRenderPass::RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles)
+	{
+		if (changedFiles.count(m_VS) == 0 && changedFiles.count(m_PS) == 0)
+		{
+			return false;
+		}
+
+		m_pPendingVS.Release();
+		m_pPendingPS.Release();
+		createShaders(ctx, &m_pPendingVS, &m_pPendingPS);
+		return true;
+	}
+
+	bool PostRenderPass::FinishShaderReload(RenderPassContext& ctx)
+	{
+		for (IShader* pShader : { m_pPendingVS.RawPtr(), m_pPendingPS.RawPtr() })
+		{
+			if (pShader != nullptr && pShader->GetStatus() == SHADER_STATUS_COMPILING)
 			{
-				{ SHADER_TYPE_PIXEL, "g_LinearClampSampler", linearClamp },
-			};
-			psoCi.PSODesc.ResourceLayout.ImmutableSamplers = samplers;
-			psoCi.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(samplers);
+				return false;
+			}
+		}
 
-			m_pPSO = ctx.pPipelineStateManager->AcquireGraphics(psoCi);
-			ASSERT(m_pPSO, "Failed to acquire Post PSO.");
+		const bool bReady =
+			m_pPendingVS && m_pPendingVS->GetStatus() == SHADER_STATUS_READY &&
+			m_pPendingPS && m_pPendingPS->GetStatus() == SHADER_STATUS_READY;
 
-			m_pPSO->CreateShaderResourceBinding(&m_pSRB, true);
-			ASSERT(m_pSRB, "Failed to create SRB_Post.");
+		if (bReady)
+		{
+			// g_InputColor is bound in Execute(), so the new SRB needs nothing else.
+			m_pSRB.Release();
+			m_pPSO.Release();
+			createPSO(ctx, m_pPendingVS, m_pPendingPS);
+		}
+		else
+		{
+			LOG_ERROR_MESSAGE("PostCopy shaders failed to compile; keeping the previous pipeline.");
 		}
 
+		m_pPendingVS.Release();
+		m_pPendingPS.Release();
+		return true;
 	}
+
 	PostRenderPass::~PostRenderPass()
 	{
 		m_pFramebufferCurrentBB.Release();
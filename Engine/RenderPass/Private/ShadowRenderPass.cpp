@@ -3,6 +3,7 @@
 #include "Engine/RenderPass/Public/RenderPassContext.h"
 
 #include "Engine/RHI/Interface/GraphicsTypes.h"
+#include "Engine/Core/Common/Public/Timer.hpp"
 #include "Engine/GraphicsTools/Public/GraphicsUtilities.h"
 
 #include "Engine/Renderer/Public/ViewFamily.h"
@@ -22,6 +23,7 @@ namespace shz
 		ASSERT(ctx.pDevice, "Device is null.");
 		ASSERT(ctx.pImmediateContext, "ImmediateContext is null.");
 		ASSERT(ctx.pShaderSourceFactory, "Shader source factory is null.");
+		ASSERT(ctx.pShaderCache, "Shader cache is null.");
 
 		// ------------------------------------------------------------
 		// Create RenderPass + Framebuffer (depth-only)
@@ -74,6 +76,112 @@ namespace shz
 			}
 		}
 
+		// Shaders compile while the other passes are constructed; see CreatePipelines().
+		const bool ok = createShaders(ctx, m_PendingShaders);
+		ASSERT(ok, "Failed to create shadow pass shaders.");
+	}
+
+	bool ShadowRenderPass::CreatePipelines(RenderPassContext& ctx)
+	{
+		const bool ok = createPSOs(ctx, m_PendingShaders);
+		ASSERT(ok, "Failed to create shadow pass PSOs.");
+
+		m_PendingShaders = {};
+		return ok;
+	}
+
+	bool ShadowRenderPass::createShaders(RenderPassContext& ctx, ShaderSet& out)
+	{
+		const bool bObjectIndexStream = (ctx.DrawInstanceOffsetMode == EDrawInstanceOffsetMode::InstanceStream);
+		const ShaderMacro objectIndexMacros[] = { { OBJECT_INDEX_STREAM_MACRO, "1" } };
+
+		ShaderCreateInfo sci = {};
+		sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+		sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
+		sci.EntryPoint = "main";
+		sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+		sci.Macros = { objectIndexMacros, bObjectIndexStream ? 1u : 0u };
+
+		auto create = [&](const char* name, SHADER_TYPE type, const std::string& path, RefCntAutoPtr<IShader>& outShader)
+		{
+			sci.Desc = {};
+			sci.Desc.Name = name;
+			sci.Desc.ShaderType = type;
+			sci.FilePath = path.c_str();
+			sci.Desc.UseCombinedTextureSamplers = false;
+
+			outShader.Release();
+			ctx.pShaderCache->CreateShader(ctx.pDevice, sci, &outShader);
+			if (!outShader)
+			{
+				LOG_ERROR_MESSAGE("Failed to create ", name, '.');
+			}
+		};
+
+		create("Shadow VS", SHADER_TYPE_VERTEX, m_VS, out.VS);
+		create("Shadow PS", SHADER_TYPE_PIXEL, m_PS, out.PS);
+		create("Shadow Masked VS", SHADER_TYPE_VERTEX, m_MaskedVS, out.MaskedVS);
+		create("Shadow Masked PS", SHADER_TYPE_PIXEL, m_MaskedPS, out.MaskedPS);
+
+		return out.VS && out.PS && out.MaskedVS && out.MaskedPS;
+	}
+
+	bool ShadowRenderPass::RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles)
+	{
+		bool bAffected = false;
+		for (const std::string* pPath : { &m_VS, &m_PS, &m_MaskedVS, &m_MaskedPS })
+		{
+			bAffected = bAffected || changedFiles.count(*pPath) != 0;
+		}
+
+		if (!bAffected)
+		{
+			return false;
+		}
+
+		// Unchanged stages are bytecode cache hits.
+		m_PendingShaders = {};
+		createShaders(ctx, m_PendingShaders);
+		return true;
+	}
+
+	bool ShadowRenderPass::FinishShaderReload(RenderPassContext& ctx)
+	{
+		const ShaderSet& pending = m_PendingShaders;
+
+		bool bReady = true;
+		for (IShader* pShader : { pending.VS.RawPtr(), pending.PS.RawPtr(), pending.MaskedVS.RawPtr(), pending.MaskedPS.RawPtr() })
+		{
+			if (pShader != nullptr && pShader->GetStatus() == SHADER_STATUS_COMPILING)
+			{
+				return false;
+			}
+			bReady = bReady && pShader != nullptr && pShader->GetStatus() == SHADER_STATUS_READY;
+		}
+
+		if (bReady)
+		{
+			// Renderer rebuilds the masked material SRBs if the new masked PSO is not compatible with them.
+			m_pSRB.Release();
+			m_pShadowPSO.Release();
+			m_pShadowMaskedPSO.Release();
+			createPSOs(ctx, pending);
+		}
+		else
+		{
+			LOG_ERROR_MESSAGE("Shadow shaders failed to compile; keeping the previous pipelines.");
+		}
+
+		m_PendingShaders = {};
+		return true;
+	}
+
+	bool ShadowRenderPass::createPSOs(RenderPassContext& ctx, const ShaderSet& shaders)
+	{
+		ASSERT(m_pRenderPass, "Shadow render pass is null.");
+
+		const bool bObjectIndexStream = (ctx.DrawInstanceOffsetMode == EDrawInstanceOffsetMode::InstanceStream);
+
 		// ------------------------------------------------------------
 		// Create Opaque Shadow PSO + SRB (same as old createShadowPso)
 		// ------------------------------------------------------------
@@ -104,42 +212,15 @@ namespace shz
 			LayoutElement layoutElems[] =
 			{
 				LayoutElement{0, 0, 3, VT_FLOAT32, false}, // ATTRIB0 Position (vertex stream)
+				MakeObjectIndexStreamLayoutElement(),      // instance stream mode only (last)
 			};
 			layoutElems[0].Stride = sizeof(float) * 11;
 
 			gp.InputLayout.LayoutElements = layoutElems;
-			gp.InputLayout.NumElements = _countof(layoutElems);
-
-			ShaderCreateInfo sci = {};
-			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-			sci.EntryPoint = "main";
-			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
+			gp.InputLayout.NumElements = _countof(layoutElems) - (bObjectIndexStream ? 0 : 1);
 
-			RefCntAutoPtr<IShader> vs;
-			{
-				sci.Desc = {};
-				sci.Desc.Name = "Shadow VS";
-				sci.Desc.ShaderType = SHADER_TYPE_VERTEX;
-				sci.FilePath = m_VS.c_str();
-				sci.Desc.UseCombinedTextureSamplers = false;
-				ctx.pDevice->CreateShader(sci, &vs);
-				ASSERT(vs, "Failed to create Shadow VS.");
-			}
-
-			RefCntAutoPtr<IShader> ps;
-			{
-				sci.Desc = {};
-				sci.Desc.Name = "Shadow PS";
-				sci.Desc.ShaderType = SHADER_TYPE_PIXEL;
-				sci.FilePath = m_PS.c_str();
-				sci.Desc.UseCombinedTextureSamplers = false;
-				ctx.pDevice->CreateShader(sci, &ps);
-				ASSERT(ps, "Failed to create Shadow PS.");
-			}
-
-			psoCi.pVS = vs;
-			psoCi.pPS = ps;
+			psoCi.pVS = shaders.VS;
+			psoCi.pPS = shaders.PS;
 
 			psoCi.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 			psoCi.PSODesc.ResourceLayout.Variables = nullptr;
@@ -199,43 +280,16 @@ namespace shz
 			{
 				LayoutElement{0, 0, 3, VT_FLOAT32, false}, // Pos
 				LayoutElement{1, 0, 2, VT_FLOAT32, false}, // UV
+				MakeObjectIndexStreamLayoutElement(),      // instance stream mode only (last)
 			};
 			layoutElems[0].Stride = sizeof(float) * 11;
 			layoutElems[1].Stride = sizeof(float) * 11;
 
 			gp.InputLayout.LayoutElements = layoutElems;
-			gp.InputLayout.NumElements = _countof(layoutElems);
+			gp.InputLayout.NumElements = _countof(layoutElems) - (bObjectIndexStream ? 0 : 1);
 
-			ShaderCreateInfo sci = {};
-			sci.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
-			sci.pShaderSourceStreamFactory = ctx.pShaderSourceFactory;
-			sci.EntryPoint = "main";
-			sci.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
-
-			RefCntAutoPtr<IShader> vs;
-			{
-				sci.Desc = {};
-				sci.Desc.Name = "Shadow Masked VS";
-				sci.Desc.ShaderType = SHADER_TYPE_VERTEX;
-				sci.FilePath = m_MaskedVS.c_str();
-				sci.Desc.UseCombinedTextureSamplers = false;
-				ctx.pDevice->CreateShader(sci, &vs);
-				ASSERT(vs, "Failed to create ShadowMasked VS.");
-			}
-
-			RefCntAutoPtr<IShader> ps;
-			{
-				sci.Desc = {};
-				sci.Desc.Name = "Shadow Masked PS";
-				sci.Desc.ShaderType = SHADER_TYPE_PIXEL;
-				sci.FilePath = m_MaskedPS.c_str();
-				sci.Desc.UseCombinedTextureSamplers = false;
-				ctx.pDevice->CreateShader(sci, &ps);
-				ASSERT(ps, "Failed to create ShadowMasked PS.");
-			}
-
-			psoCi.pVS = vs;
-			psoCi.pPS = ps;
+			psoCi.pVS = shaders.MaskedVS;
+			psoCi.pPS = shaders.MaskedPS;
 
 			ShaderResourceVariableDesc vars[] =
 			{
@@ -280,6 +334,8 @@ namespace shz
 				}
 			}
 		}
+
+		return m_pShadowPSO && m_pShadowMaskedPSO && m_pSRB;
 	}
 
 	ShadowRenderPass::~ShadowRenderPass()
@@ -297,6 +353,7 @@ namespace shz
 	{
 		(void)ctx;
 		m_DrawCallCount = 0;
+		m_StateChangeStats = {};
 	}
 
 	void ShadowRenderPass::Execute(RenderPassContext& ctx)
@@ -305,19 +362,32 @@ namespace shz
 
 		IDeviceContext* pCtx = ctx.pImmediateContext;
 
-		const std::vector<DrawPacket>& packets = ctx.ShadowDrawPackets;
+		PushPreBarriers(ctx);
+		ctx.FlushBarriers(pCtx);
 
-		// To DEPTH_WRITE
-		{
-			StateTransitionDesc tr =
-			{
-				ctx.pRegistry->GetTexture(STRING_HASH("ShadowMap")),
-				RESOURCE_STATE_UNKNOWN,
-				RESOURCE_STATE_DEPTH_WRITE,
-				STATE_TRANSITION_FLAG_UPDATE_STATE
-			};
-			pCtx->TransitionResourceStates(1, &tr);
-		}
+		Record(ctx, pCtx);
+
+		PushPostBarriers(ctx);
+		ctx.FlushPostBarriers(pCtx);
+	}
+
+	void ShadowRenderPass::PushPreBarriers(RenderPassContext& ctx)
+	{
+		ctx.PushBarrier(ctx.pRegistry->GetTexture(STRING_HASH("ShadowMap")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_DEPTH_WRITE);
+	}
+
+	void ShadowRenderPass::PushPostBarriers(RenderPassContext& ctx)
+	{
+		// Shadow -> SRV
+		ctx.PushPostBarrier(ctx.pRegistry->GetTexture(STRING_HASH("ShadowMap")), RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+	}
+
+	void ShadowRenderPass::Record(RenderPassContext& ctx, IDeviceContext* pCtx)
+	{
+		ASSERT(pCtx, "Context is null.");
+
+		// Sorted by DrawPacket::SortKey, so equal state is contiguous.
+		const std::span<const DrawPacket> packets = ctx.ShadowDrawPackets;
 
 		Viewport vp = {};
 		vp.Width = float(ctx.ShadowMapResolution);
@@ -338,11 +408,21 @@ namespace shz
 
 		pCtx->BeginRenderPass(rp);
 
+		// Instance stream: the object index rides in VB slot 1, nothing is uploaded per draw.
+		const bool bObjectIndexStream = (ctx.DrawInstanceOffsetMode == EDrawInstanceOffsetMode::InstanceStream);
+		IBuffer* pObjectIndexStream = bObjectIndexStream ? ctx.pRegistry->GetBuffer(kRes_ObjectIndexVB) : nullptr;
+		IBuffer* pDrawCB = ctx.pRegistry->GetBuffer(kRes_DrawCB);
+		ASSERT(!bObjectIndexStream || pObjectIndexStream, "Object index stream is null.");
+
 		IPipelineState* pLastPSO = nullptr;
 		IShaderResourceBinding* pLastSRB = nullptr;
 		IBuffer* pLastVB = nullptr;
 		IBuffer* pLastIB = nullptr;
 
+#ifdef PROFILING
+		Timer recordTimer;
+#endif
+
 		for (const DrawPacket& pkt : packets)
 		{
 			ASSERT(pkt.PSO && pkt.SRB && pkt.VertexBuffer && pkt.IndexBuffer, "Invalid draw packet values.");
@@ -353,6 +433,9 @@ namespace shz
 				pLastPSO = pkt.PSO;
 				pLastSRB = nullptr;
 				pCtx->SetPipelineState(pLastPSO);
+#ifdef PROFILING
+				++m_StateChangeStats.PSOBinds;
+#endif
 			}
 
 			// Bind SRB
@@ -360,38 +443,48 @@ namespace shz
 			{
 				pLastSRB = pkt.SRB;
 				pCtx->CommitShaderResources(pLastSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+#ifdef PROFILING
+				++m_StateChangeStats.SRBBinds;
+#endif
 			}
 
 			// VB/IB binding (ONLY mesh VB)
 			if (pLastVB != pkt.VertexBuffer)
 			{
-				IBuffer* ppVertexBuffers[] = { pkt.VertexBuffer };
-				uint64 pOffsets[] = { 0 };
+				IBuffer* ppVertexBuffers[] = { pkt.VertexBuffer, pObjectIndexStream };
+				uint64 pOffsets[] = { 0, 0 };
 
 				pCtx->SetVertexBuffers(
 					0,
-					1,
+					bObjectIndexStream ? 2 : 1,
 					ppVertexBuffers,
 					pOffsets,
 					RESOURCE_STATE_TRANSITION_MODE_VERIFY,
 					SET_VERTEX_BUFFERS_FLAG_RESET);
 
 				pLastVB = pkt.VertexBuffer;
+#ifdef PROFILING
+				++m_StateChangeStats.VBBinds;
+#endif
 			}
 
 			if (pLastIB != pkt.IndexBuffer)
 			{
 				pCtx->SetIndexBuffer(pkt.IndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 				pLastIB = pkt.IndexBuffer;
+#ifdef PROFILING
+				++m_StateChangeStats.IBBinds;
+#endif
 			}
 
-			// Per-draw: StartInstanceLocation -> DrawCB
 			DrawIndexedAttribs dia = pkt.DrawAttribs;
 #ifdef SHZ_DEBUG
 			if (dia.Flags == DRAW_FLAG_NONE) dia.Flags = DRAW_FLAG_VERIFY_ALL;
 #endif
+			// Per-draw: StartInstanceLocation -> DrawCB
+			if (!bObjectIndexStream)
 			{
-				MapHelper<hlsl::DrawConstants> map(pCtx, ctx.pRegistry->GetBuffer(kRes_DrawCB), MAP_WRITE, MAP_FLAG_DISCARD);
+				MapHelper<hlsl::DrawConstants> map(pCtx, pDrawCB, MAP_WRITE, MAP_FLAG_DISCARD);
 				hlsl::DrawConstants* dst = map;
 
 				dst->StartInstanceLocation = dia.FirstInstanceLocation;
@@ -400,22 +493,15 @@ namespace shz
 			pCtx->DrawIndexed(dia);
 #ifdef PROFILING
 			++m_DrawCallCount;
+			++m_StateChangeStats.Draws;
 #endif
 		}
 
-		pCtx->EndRenderPass();
+#ifdef PROFILING
+		m_StateChangeStats.RecordMilliseconds = recordTimer.GetElapsedTime() * 1000.0;
+#endif
 
-		// Shadow -> SRV
-		{
-			StateTransitionDesc tr2 =
-			{
-				ctx.pRegistry->GetTexture(STRING_HASH("ShadowMap")),
-				RESOURCE_STATE_UNKNOWN,
-				RESOURCE_STATE_SHADER_RESOURCE,
-				STATE_TRANSITION_FLAG_UPDATE_STATE
-			};
-			pCtx->TransitionResourceStates(1, &tr2);
-		}
+		pCtx->EndRenderPass();
 	}
 
 	void ShadowRenderPass::EndFrame(RenderPassContext& ctx)
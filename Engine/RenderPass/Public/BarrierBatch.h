@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <span>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/RHI/Interface/GraphicsTypes.h"
+#include "Engine/RHI/Interface/IDeviceObject.h"
+#include "Engine/RHI/Interface/IDeviceContext.h"
+
+namespace shz
+{
+	struct BarrierBatchStats final
+	{
+		// PushBarrier() calls this frame.
+		uint32 Pushed = 0;
+
+		// Pushes folded into an earlier barrier for the same resource.
+		uint32 Merged = 0;
+
+		// Resources already in the requested state (no barrier emitted).
+		uint32 Skipped = 0;
+
+		// Barriers handed to TransitionResourceStates.
+		uint32 Emitted = 0;
+	};
+
+	// ------------------------------------------------------------
+	// BarrierBatch
+	// - Collects the frame's pre-pass barriers, one per resource.
+	// - Duplicates are found through a small open-addressing table keyed by
+	//   the device object unique ID. It is sized to the batch (at most half
+	//   full), so it does not grow with the number of objects ever created,
+	//   and pushing does not allocate once warmed up.
+	// - Slots are stamped with a batch generation; stale stamps read as
+	//   empty, so starting a batch does not touch the table.
+	// - Read-only states requested for the same resource are merged.
+	// - Resources whose tracked state already covers the request are
+	//   dropped in Finalize(); the rest are sorted by unique ID.
+	// - Does not talk to the device, so it can be driven headlessly.
+	// ------------------------------------------------------------
+	class BarrierBatch final
+	{
+	public:
+		void Reset();
+
+		// uniqueID       : IDeviceObject::GetUniqueID() of pResource (> 0).
+		// currentState   : tracked state at push time, RESOURCE_STATE_UNKNOWN if not tracked.
+		// Read-only states for a resource already in the batch are merged; any other
+		// conflict is logged and the last push wins.
+		void Push(IDeviceObject* pResource, int32 uniqueID, RESOURCE_STATE currentState, RESOURCE_STATE from, RESOURCE_STATE to);
+
+		// Drops already-correct barriers and sorts the rest. Valid until the next Reset()/Finalize().
+		std::span<const StateTransitionDesc> Finalize();
+
+		bool IsEmpty() const noexcept { return m_Entries.empty(); }
+		const BarrierBatchStats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		// Generation != m_Generation: empty.
+		struct Slot final
+		{
+			uint32 Generation = 0;
+			int32 UniqueID = 0;
+			uint32 EntryIndex = 0;
+		};
+
+		struct Entry final
+		{
+			int32 UniqueID = 0;
+			RESOURCE_STATE CurrentState = RESOURCE_STATE_UNKNOWN;
+			StateTransitionDesc Barrier = {};
+		};
+
+	private:
+		Slot& findSlot(int32 uniqueID);
+		void growSlots();
+		void advanceGeneration();
+
+	private:
+		static constexpr size_t MIN_SLOT_COUNT = 64;
+
+		std::vector<Slot> m_Slots = {};
+		std::vector<Entry> m_Entries = {};
+		std::vector<StateTransitionDesc> m_Barriers = {};
+
+		uint32 m_SlotShift = 32;
+		uint32 m_Generation = 1;
+		BarrierBatchStats m_Stats = {};
+	};
+} // namespace shz
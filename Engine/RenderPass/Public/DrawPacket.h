@@ -5,9 +5,39 @@
 #include "Engine/RHI/Interface/IDeviceContext.h"
 #include "Engine/RHI/Interface/IPipelineState.h"
 #include "Engine/RHI/Interface/IShaderResourceBinding.h"
+#include "Engine/RHI/Interface/InputLayout.h"
 
 namespace shz
 {
+	// How a draw tells the vertex shader where its instances start in the object table.
+	enum class EDrawInstanceOffsetMode : uint8
+	{
+		// Map/discard DRAW_CONSTANTS before every draw.
+		ConstantBuffer = 0,
+
+		// Per-instance stream holding 0..N-1. The input assembler adds
+		// FirstInstanceLocation when fetching it, so nothing is uploaded per draw.
+		InstanceStream,
+	};
+
+	// Instance stream contract (shaders test OBJECT_INDEX_STREAM_MACRO and read ATTRIB7).
+	static constexpr uint32 OBJECT_INDEX_STREAM_SLOT = 1;
+	static constexpr uint32 OBJECT_INDEX_STREAM_ATTRIB = 7;
+	static constexpr const char* OBJECT_INDEX_STREAM_MACRO = "SHZ_OBJECT_INDEX_STREAM";
+
+	inline LayoutElement MakeObjectIndexStreamLayoutElement()
+	{
+		return LayoutElement{
+			OBJECT_INDEX_STREAM_ATTRIB,
+			OBJECT_INDEX_STREAM_SLOT,
+			1,
+			VT_UINT32,
+			false,
+			LAYOUT_ELEMENT_AUTO_OFFSET,
+			LAYOUT_ELEMENT_AUTO_STRIDE,
+			INPUT_ELEMENT_FREQUENCY_PER_INSTANCE };
+	}
+
 	struct DrawPacket final
 	{
 		IBuffer* VertexBuffer = nullptr;
@@ -18,6 +48,9 @@ namespace shz
 
 		uint32 ObjectIndex = std::numeric_limits<uint32>::max();
 
+		// See DrawSortKey (DrawPacketSort.h). Passes submit packets in ascending key order.
+		uint64 SortKey = 0;
+
 		DrawIndexedAttribs DrawAttribs = {};
 	};
 
@@ -0,0 +1,40 @@
+#pragma once
+#include "Primitives/BasicTypes.h"
+
+#include "Engine/Core/Memory/Public/ArenaAllocator.h"
+#include "Engine/RenderPass/Public/DrawPacket.h"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// Draw packet sort key (64-bit, ascending = submission order)
+	//   [63:52] PSO          (12)
+	//   [51:36] SRB          (16)
+	//   [35:20] VB/IB pair   (16)
+	//   [19: 0] depth bucket (20)
+	// - IDs are device object unique IDs (SRB: address) folded into their
+	//   field; a collision only costs an extra bind, never a wrong draw.
+	// - Depth is the bit pattern of a non-negative float, which orders
+	//   the same as the value, so equal state draws go front to back.
+	// ------------------------------------------------------------
+	namespace DrawSortKey
+	{
+		static constexpr uint32 PSO_BITS = 12;
+		static constexpr uint32 SRB_BITS = 16;
+		static constexpr uint32 GEOMETRY_BITS = 16;
+		static constexpr uint32 DEPTH_BITS = 20;
+
+		static constexpr uint32 DEPTH_SHIFT = 0;
+		static constexpr uint32 GEOMETRY_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+		static constexpr uint32 SRB_SHIFT = GEOMETRY_SHIFT + GEOMETRY_BITS;
+		static constexpr uint32 PSO_SHIFT = SRB_SHIFT + SRB_BITS;
+
+		static_assert(PSO_SHIFT + PSO_BITS == 64, "Sort key fields must fill 64 bits.");
+
+		// viewDepth: any non-negative, monotonic distance measure (e.g. squared distance). 0 = no depth ordering.
+		uint64 Make(const DrawPacket& pkt, float viewDepth);
+	} // namespace DrawSortKey
+
+	// Stable LSD radix sort on DrawPacket::SortKey. Scratch comes from the given arena.
+	void SortDrawPackets(ArenaVector<DrawPacket>& packets, ArenaAllocator& scratch);
+} // namespace shz
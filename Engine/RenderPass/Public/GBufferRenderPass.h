@@ -27,6 +27,11 @@ namespace shz
 		void Execute(RenderPassContext& ctx) override;
 		void EndFrame(RenderPassContext& ctx) override;
 
+		bool SupportsParallelRecording() const override { return true; }
+		void PushPreBarriers(RenderPassContext& ctx) override;
+		void PushPostBarriers(RenderPassContext& ctx) override;
+		void Record(RenderPassContext& ctx, IDeviceContext* pContext) override;
+
 		void ReleaseSwapChainBuffers(RenderPassContext& ctx) override;
 		void OnResize(RenderPassContext& ctx, uint32 width, uint32 height) override;
 
@@ -6,6 +6,7 @@
 #include "Engine/RHI/Interface/IRenderPass.h"
 #include "Engine/RHI/Interface/IFramebuffer.h"
 #include "Engine/RHI/Interface/IPipelineState.h"
+#include "Engine/RHI/Interface/IShader.h"
 #include "Engine/RHI/Interface/IShaderResourceBinding.h"
 #include "Engine/RHI/Interface/IBuffer.h"
 
@@ -28,15 +29,32 @@ namespace shz
 		void Execute(RenderPassContext& ctx) override;
 		void EndFrame(RenderPassContext& ctx) override;
 
+		bool CreatePipelines(RenderPassContext& ctx) override;
+
 		void ReleaseSwapChainBuffers(RenderPassContext& ctx) override;
 		void OnResize(RenderPassContext& ctx, uint32 width, uint32 height) override;
 
+		bool RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles) override;
+		bool FinishShaderReload(RenderPassContext& ctx) override;
+
 		IRenderPass* GetRHIRenderPass() override { return m_pRenderPass; };
 
 		void SetGrassModel(RenderPassContext& ctx, const StaticMeshRenderData& mesh);
 		void SetGrassDensityField(RenderPassContext& ctx, const TextureRenderData& tex);
 	private:
+		struct ShaderSet final
+		{
+			RefCntAutoPtr<IShader> GenCS;
+			RefCntAutoPtr<IShader> ArgsCS;
+			RefCntAutoPtr<IShader> VS;
+			RefCntAutoPtr<IShader> PS;
+			RefCntAutoPtr<IShader> DecayCS;
+			RefCntAutoPtr<IShader> ApplyCS;
+		};
+
 		bool buildFramebufferForCurrentBackBuffer(RenderPassContext& ctx);
+		bool createShaders(RenderPassContext& ctx, ShaderSet& out);
+		bool createPipelines(RenderPassContext& ctx, const ShaderSet& shaders);
 
 	private:
 		RefCntAutoPtr<IRenderPass>   m_pRenderPass;
@@ -84,5 +102,13 @@ namespace shz
 
 		RefCntAutoPtr<IPipelineState> m_pInteractionApplyCSO;
 		RefCntAutoPtr<IShaderResourceBinding> m_pInteractionApplySRB;
+
+		std::string m_BuildInstancesCS = "GrassBuildInstances.hlsl";
+		std::string m_VS = "GrassForward.vsh";
+		std::string m_PS = "GrassForward.psh";
+		std::string m_InteractionCS = "InteractionFieldUpdate.hlsl";
+
+		// Shaders requested at construction or by a reload in progress.
+		ShaderSet m_PendingShaders;
 	};
 } // namespace shz
@@ -6,6 +6,7 @@
 #include "Engine/RHI/Interface/IRenderPass.h"
 #include "Engine/RHI/Interface/IFramebuffer.h"
 #include "Engine/RHI/Interface/IPipelineState.h"
+#include "Engine/RHI/Interface/IShader.h"
 #include "Engine/RHI/Interface/IShaderResourceBinding.h"
 
 #include "Engine/RenderPass/Public/RenderPassBase.h"
@@ -25,12 +26,19 @@ namespace shz
 		void Execute(RenderPassContext& ctx) override;
 		void EndFrame(RenderPassContext& ctx) override;
 
+		bool CreatePipelines(RenderPassContext& ctx) override;
+
 		void ReleaseSwapChainBuffers(RenderPassContext& ctx) override;
 		void OnResize(RenderPassContext& ctx, uint32 width, uint32 height) override;
 
+		bool RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles) override;
+		bool FinishShaderReload(RenderPassContext& ctx) override;
+
 		IRenderPass* GetRHIRenderPass() override { return m_pRenderPass; };
 	private:
 		bool buildFramebufferForCurrentBackBuffer(RenderPassContext& ctx);
+		bool createShaders(RenderPassContext& ctx, IShader** ppVS, IShader** ppPS);
+		void createPSO(RenderPassContext& ctx, IShader* pVS, IShader* pPS);
 
 	private:
 		RefCntAutoPtr<IRenderPass> m_pRenderPass;
@@ -41,5 +49,9 @@ namespace shz
 
 		std::string m_VS = "FullScreen.vsh";
 		std::string m_PS = "PostCopy.psh";
+
+		// Shaders requested at construction or by a reload in progress.
+		RefCntAutoPtr<IShader> m_pPendingVS;
+		RefCntAutoPtr<IShader> m_pPendingPS;
 	};
 } // namespace shz
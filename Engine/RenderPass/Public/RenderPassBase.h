@@ -1,12 +1,30 @@
 #pragma once
+#include <string>
+#include <unordered_set>
+
 #include "Primitives/BasicTypes.h"
 
 namespace shz
 {
 	struct RenderPassContext;
+	struct IDeviceContext;
 	class RenderScene;
 	struct ViewFamily;
 
+	// Per-frame bind counters of a packet-driven pass.
+	// Binds skipped because the state matched the previous draw = Draws - <X>Binds.
+	struct DrawStateChangeStats final
+	{
+		uint64 Draws = 0;
+		uint64 PSOBinds = 0;
+		uint64 SRBBinds = 0;
+		uint64 VBBinds = 0;
+		uint64 IBBinds = 0;
+
+		// CPU time spent recording the draw loop.
+		double RecordMilliseconds = 0.0;
+	};
+
 	class RenderPassBase
 	{
 	public:
@@ -21,14 +39,54 @@ namespace shz
 		virtual void Execute(RenderPassContext& ctx) = 0;
 		virtual void EndFrame(RenderPassContext& ctx) = 0;
 
+		// ------------------------------------------------------------
+		// Pipeline creation
+		// - Constructors create pass objects and only request their shaders,
+		//   which compile asynchronously when the shader cache allows it.
+		// - Renderer calls CreatePipelines() once every pass is constructed,
+		//   so the shaders of all passes compile together and pipeline
+		//   creation waits on them only after the last request.
+		// ------------------------------------------------------------
+		virtual bool CreatePipelines(RenderPassContext& ctx) { (void)ctx; return true; }
+
+		// ------------------------------------------------------------
+		// Parallel recording
+		// - A pass that returns true keeps Record() free of side effects
+		//   outside pContext: its transitions are pushed through
+		//   PushPreBarriers()/PushPostBarriers() and emitted by Renderer
+		//   on the immediate context.
+		// - Renderer may then call Record() on a deferred context from a
+		//   worker thread instead of calling Execute().
+		// ------------------------------------------------------------
+		virtual bool SupportsParallelRecording() const { return false; }
+		virtual void PushPreBarriers(RenderPassContext& ctx) { (void)ctx; }
+		virtual void PushPostBarriers(RenderPassContext& ctx) { (void)ctx; }
+		virtual void Record(RenderPassContext& ctx, IDeviceContext* pContext) { (void)ctx; (void)pContext; }
+
+		// ------------------------------------------------------------
+		// Shader hot reload
+		// - changedFiles holds shader source names (as passed to the shader
+		//   source factory) that changed, including every file that includes
+		//   them.
+		// - RequestShaderReload() returns true if the pass uses one of them;
+		//   it then starts compiling the new shaders without blocking.
+		// - Renderer calls FinishShaderReload() between frames until it
+		//   returns true. The pass swaps in its new pipelines there, or keeps
+		//   the old ones if a shader failed to compile.
+		// ------------------------------------------------------------
+		virtual bool RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles) { (void)ctx; (void)changedFiles; return false; }
+		virtual bool FinishShaderReload(RenderPassContext& ctx) { (void)ctx; return true; }
+
 		virtual void ReleaseSwapChainBuffers(RenderPassContext& ctx) = 0;
 		virtual void OnResize(RenderPassContext& ctx, uint32 width, uint32 height) = 0;
 
 		virtual IRenderPass* GetRHIRenderPass() = 0;
 
 		uint64_t GetDrawCallCount() const { return m_DrawCallCount; }
+		const DrawStateChangeStats& GetStateChangeStats() const { return m_StateChangeStats; }
 
 	protected:
 		uint64_t m_DrawCallCount = 0;;
+		DrawStateChangeStats m_StateChangeStats = {};
 	};
 } // namespace shz
@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <span>
 
 #include "Primitives/BasicTypes.h"
 
@@ -12,8 +13,12 @@
 #include "Engine/RHI/Interface/GraphicsTypes.h"
 
 #include "Engine/GraphicsTools/Public/MapHelper.hpp"
+#include "Engine/GraphicsTools/Public/ShaderBytecodeCache.h"
+
+#include "Engine/Core/Memory/Public/ArenaAllocator.h"
 
 #include "Engine/RenderPass/Public/DrawPacket.h"
+#include "Engine/RenderPass/Public/BarrierBatch.h"
 
 #include "Engine/Renderer/Public/PipelineStateManager.h"
 #include "Engine/Renderer/Public/RenderData.h"
@@ -37,6 +42,9 @@ namespace shz
 
 		IShaderSourceInputStreamFactory* pShaderSourceFactory = nullptr;
 
+		// Passes create their shaders through this cache (owned by Renderer).
+		ShaderBytecodeCache* pShaderCache = nullptr;
+
 		AssetManager* pAssetManager = nullptr;
 		PipelineStateManager* pPipelineStateManager = nullptr;
 
@@ -47,9 +55,14 @@ namespace shz
 		// ------------------------------------------------------------
 		// Per-pass packets (Renderer ä)
 		// ------------------------------------------------------------
-		std::vector<DrawPacket> GBufferDrawPackets = {};
-		std::vector<DrawPacket> GrassDrawPackets = {};
-		std::vector<DrawPacket> ShadowDrawPackets = {};
+		// Views into frame-arena memory; valid until the frame arena cycles back.
+		std::span<const DrawPacket> GBufferDrawPackets = {};
+		std::span<const DrawPacket> GrassDrawPackets = {};
+		std::span<const DrawPacket> ShadowDrawPackets = {};
+
+		// Frame-lifetime scratch memory (Renderer rotates it in BeginFrame).
+		// Use STDArenaAllocator / ArenaVector for containers that die with the frame.
+		ArenaAllocator* pFrameAllocator = nullptr;
 
 		// ------------------------------------------------------------
 		// Common resources wired by Renderer
@@ -58,33 +71,77 @@ namespace shz
 		uint32 BackBufferHeight = 0;
 		uint32 ShadowMapResolution = 4096;
 
+		// Fixed at Renderer::Initialize (PSOs and shaders depend on it).
+		EDrawInstanceOffsetMode DrawInstanceOffsetMode = EDrawInstanceOffsetMode::InstanceStream;
+
 		const TextureRenderData* pHeightMap = nullptr;
 		std::vector<hlsl::InteractionStamp> InteractionStamps = {};
 
 		// ------------------------------------------------------------
-		// Per-frame barrier list
+		// Per-frame barrier list (deduplicated per resource)
 		// ------------------------------------------------------------
-		std::vector<StateTransitionDesc> PreBarriers = {};
+		BarrierBatch PreBarriers = {};
+
+		// Transitions of passes recorded on deferred contexts, emitted after their command lists.
+		BarrierBatch PostBarriers = {};
 
 		void ResetFrame()
 		{
-			GBufferDrawPackets.clear();
-			GrassDrawPackets.clear();
-			ShadowDrawPackets.clear();
+			GBufferDrawPackets = {};
+			GrassDrawPackets = {};
+			ShadowDrawPackets = {};
 
-			PreBarriers.clear();
+			PreBarriers.Reset();
+			PostBarriers.Reset();
+		}
+
+		void PushBarrier(IBuffer* pBuffer, RESOURCE_STATE from, RESOURCE_STATE to)
+		{
+			ASSERT(pBuffer, "Buffer is null.");
+			PreBarriers.Push(pBuffer, pBuffer->GetUniqueID(), pBuffer->GetState(), from, to);
+		}
+
+		void PushBarrier(ITexture* pTexture, RESOURCE_STATE from, RESOURCE_STATE to)
+		{
+			ASSERT(pTexture, "Texture is null.");
+			PreBarriers.Push(pTexture, pTexture->GetUniqueID(), pTexture->GetState(), from, to);
 		}
 
+		// State of other object types is not tracked here, so these are never skipped.
 		void PushBarrier(IDeviceObject* pObj, RESOURCE_STATE from, RESOURCE_STATE to)
 		{
 			ASSERT(pObj, "Device object is null.");
+			PreBarriers.Push(pObj, pObj->GetUniqueID(), RESOURCE_STATE_UNKNOWN, from, to);
+		}
+
+		void PushPostBarrier(ITexture* pTexture, RESOURCE_STATE from, RESOURCE_STATE to)
+		{
+			ASSERT(pTexture, "Texture is null.");
+			PostBarriers.Push(pTexture, pTexture->GetUniqueID(), pTexture->GetState(), from, to);
+		}
 
-			StateTransitionDesc b = {};
-			b.pResource = pObj;
-			b.OldState = from;
-			b.NewState = to;
-			b.Flags = STATE_TRANSITION_FLAG_UPDATE_STATE;
-			PreBarriers.push_back(b);
+		// Emits the batched barriers; returns the number of transitions issued.
+		uint32 FlushBarriers(IDeviceContext* pContext)
+		{
+			return flushBarrierBatch(pContext, PreBarriers);
+		}
+
+		uint32 FlushPostBarriers(IDeviceContext* pContext)
+		{
+			return flushBarrierBatch(pContext, PostBarriers);
+		}
+
+		static uint32 flushBarrierBatch(IDeviceContext* pContext, BarrierBatch& batch)
+		{
+			ASSERT(pContext, "Context is null.");
+			ASSERT(!pContext->GetDesc().IsDeferred, "Tracked transitions must be issued on the immediate context.");
+
+			const std::span<const StateTransitionDesc> barriers = batch.Finalize();
+			if (!barriers.empty())
+			{
+				pContext->TransitionResourceStates(static_cast<uint32>(barriers.size()), barriers.data());
+			}
+			return static_cast<uint32>(barriers.size());
 		}
 
 		//void UploadObjectIndexInstance(uint32 objectIndex) const
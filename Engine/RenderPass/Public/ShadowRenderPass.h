@@ -8,6 +8,7 @@
 #include "Engine/RHI/Interface/IRenderPass.h"
 #include "Engine/RHI/Interface/IFramebuffer.h"
 #include "Engine/RHI/Interface/IPipelineState.h"
+#include "Engine/RHI/Interface/IShader.h"
 #include "Engine/RHI/Interface/IShaderResourceBinding.h"
 
 #include "Engine/RenderPass/Public/RenderPassBase.h"
@@ -27,15 +28,37 @@ namespace shz
 		void Execute(RenderPassContext& ctx) override;
 		void EndFrame(RenderPassContext& ctx) override;
 
+		bool CreatePipelines(RenderPassContext& ctx) override;
+
+		bool SupportsParallelRecording() const override { return true; }
+		void PushPreBarriers(RenderPassContext& ctx) override;
+		void PushPostBarriers(RenderPassContext& ctx) override;
+		void Record(RenderPassContext& ctx, IDeviceContext* pCtx) override;
+
 		void ReleaseSwapChainBuffers(RenderPassContext& ctx) override;
 		void OnResize(RenderPassContext& ctx, uint32 width, uint32 height) override;
 
+		bool RequestShaderReload(RenderPassContext& ctx, const std::unordered_set<std::string>& changedFiles) override;
+		bool FinishShaderReload(RenderPassContext& ctx) override;
+
 		IRenderPass* GetRHIRenderPass() override { return m_pRenderPass; };
 	public:
 		IPipelineState* GetShadowMaskedPSO() const noexcept { return m_pShadowMaskedPSO.RawPtr(); }
 		IPipelineState* GetShadowPSO() const noexcept { return m_pShadowPSO.RawPtr(); }
 		IShaderResourceBinding* GetOpaqueShadowSRB() const noexcept { return m_pSRB.RawPtr(); }
 
+	private:
+		struct ShaderSet final
+		{
+			RefCntAutoPtr<IShader> VS;
+			RefCntAutoPtr<IShader> PS;
+			RefCntAutoPtr<IShader> MaskedVS;
+			RefCntAutoPtr<IShader> MaskedPS;
+		};
+
+		bool createShaders(RenderPassContext& ctx, ShaderSet& out);
+		bool createPSOs(RenderPassContext& ctx, const ShaderSet& shaders);
+
 	private:
 		RefCntAutoPtr<IRenderPass> m_pRenderPass;
 		RefCntAutoPtr<IFramebuffer> m_pFramebuffer;
@@ -49,5 +72,8 @@ namespace shz
 
 		std::string m_MaskedVS = "ShadowMasked.vsh";
 		std::string m_MaskedPS = "ShadowMasked.psh";
+
+		// Shaders requested at construction or by a reload in progress.
+		ShaderSet m_PendingShaders;
 	};
 } // namespace shz
@@ -0,0 +1,206 @@
+#include "pch.h"
+#include "Engine/Renderer/Public/MaterialConstantPages.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Primitives/Align.hpp"
+#include "Engine/Core/Common/Public/Errors.hpp"
+
+namespace shz
+{
+	void MaterialConstantPages::Initialize(uint32 pageSize, uint32 alignment)
+	{
+		Reset();
+
+		m_Alignment = (alignment != 0) ? alignment : 256;
+		m_PageSize = AlignUp(std::max(pageSize, MAX_ALLOCATION_SIZE), m_Alignment);
+	}
+
+	void MaterialConstantPages::Reset()
+	{
+		m_Pages.clear();
+		m_FreeLists.clear();
+		m_Stats = {};
+	}
+
+	bool MaterialConstantPages::isAllocatable(uint32 size) const
+	{
+		return size != 0 && size <= MAX_ALLOCATION_SIZE;
+	}
+
+	bool MaterialConstantPages::NeedsNewPage(uint32 size) const
+	{
+		if (!isAllocatable(size))
+		{
+			return false;
+		}
+
+		const uint32 alignedSize = AlignUp(size, m_Alignment);
+
+		auto freeIt = m_FreeLists.find(alignedSize);
+		if (freeIt != m_FreeLists.end() && !freeIt->second.empty())
+		{
+			return false;
+		}
+
+		return m_Pages.empty() || m_Pages.back().UsedBytes + alignedSize > m_PageSize;
+	}
+
+	void MaterialConstantPages::AddPage()
+	{
+		Page page = {};
+		page.Data.assign(m_PageSize, 0);
+
+		// A fresh buffer has undefined contents; upload the zeroed copy with the first flush.
+		page.DirtyRanges.push_back({ 0, m_PageSize });
+
+		m_Pages.push_back(std::move(page));
+		m_Stats.PageCount = static_cast<uint32>(m_Pages.size());
+	}
+
+	MaterialConstantAllocation MaterialConstantPages::Allocate(uint32 size)
+	{
+		if (size == 0)
+		{
+			return {};
+		}
+
+		if (size > MAX_ALLOCATION_SIZE)
+		{
+			LOG_ERROR_MESSAGE("Material constants (", size, " bytes) exceed the ", MAX_ALLOCATION_SIZE, " byte limit.");
+			return {};
+		}
+
+		const uint32 alignedSize = AlignUp(size, m_Alignment);
+
+		MaterialConstantAllocation alloc = {};
+
+		auto freeIt = m_FreeLists.find(alignedSize);
+		if (freeIt != m_FreeLists.end() && !freeIt->second.empty())
+		{
+			alloc = freeIt->second.back();
+			freeIt->second.pop_back();
+		}
+		else
+		{
+			if (m_Pages.empty() || m_Pages.back().UsedBytes + alignedSize > m_PageSize)
+			{
+				AddPage();
+			}
+
+			Page& page = m_Pages.back();
+			alloc.Page = static_cast<uint32>(m_Pages.size() - 1);
+			alloc.Offset = page.UsedBytes;
+			alloc.Size = alignedSize;
+			page.UsedBytes += alignedSize;
+		}
+
+		++m_Stats.AllocationCount;
+		m_Stats.AllocatedBytes += alignedSize;
+		return alloc;
+	}
+
+	void MaterialConstantPages::Free(const MaterialConstantAllocation& alloc)
+	{
+		if (!alloc.IsValid())
+		{
+			return;
+		}
+
+		ASSERT(alloc.Page < m_Pages.size(), "Out of bounds.");
+
+		m_FreeLists[alloc.Size].push_back(alloc);
+
+		--m_Stats.AllocationCount;
+		m_Stats.AllocatedBytes -= alloc.Size;
+	}
+
+	void MaterialConstantPages::Write(const MaterialConstantAllocation& alloc, const void* pData, uint32 size)
+	{
+		ASSERT(alloc.IsValid() && alloc.Page < m_Pages.size(), "Invalid allocation.");
+		ASSERT(pData || size == 0, "pData is null.");
+		ASSERT(size <= alloc.Size, "Write exceeds the allocation.");
+
+		++m_Stats.Writes;
+
+		Page& page = m_Pages[alloc.Page];
+		uint8* pDst = page.Data.data() + alloc.Offset;
+		const uint8* pSrc = static_cast<const uint8*>(pData);
+
+		// Most frames re-write unchanged constants; one memcmp settles those.
+		if (std::memcmp(pDst, pSrc, size) == 0)
+		{
+			++m_Stats.UnchangedWrites;
+			return;
+		}
+
+		// Narrow the write to the span that actually differs.
+		uint32 begin = 0;
+		while (pDst[begin] == pSrc[begin])
+		{
+			++begin;
+		}
+
+		uint32 end = size;
+		while (end > begin && pDst[end - 1] == pSrc[end - 1])
+		{
+			--end;
+		}
+
+		std::memcpy(pDst + begin, pSrc + begin, end - begin);
+		page.DirtyRanges.push_back({ alloc.Offset + begin, alloc.Offset + end });
+	}
+
+	void MaterialConstantPages::CollectUploads(std::vector<MaterialConstantUpload>& out)
+	{
+		m_Stats.FlushedRanges = 0;
+		m_Stats.FlushedBytes = 0;
+
+		for (uint32 pageIndex = 0; pageIndex < m_Pages.size(); ++pageIndex)
+		{
+			Page& page = m_Pages[pageIndex];
+			if (page.DirtyRanges.empty())
+			{
+				continue;
+			}
+
+			std::sort(page.DirtyRanges.begin(), page.DirtyRanges.end(),
+				[](const DirtyRange& a, const DirtyRange& b) { return a.Begin < b.Begin; });
+
+			// Ranges closer than one alignment unit are uploaded together:
+			// re-sending a few clean bytes is cheaper than another copy command.
+			DirtyRange current = page.DirtyRanges.front();
+			auto emit = [&](const DirtyRange& range)
+				{
+					out.push_back({ pageIndex, range.Begin, range.End });
+
+					++m_Stats.FlushedRanges;
+					m_Stats.FlushedBytes += range.End - range.Begin;
+				};
+
+			for (size_t i = 1; i < page.DirtyRanges.size(); ++i)
+			{
+				const DirtyRange& next = page.DirtyRanges[i];
+				if (next.Begin <= current.End + m_Alignment)
+				{
+					current.End = std::max(current.End, next.End);
+				}
+				else
+				{
+					emit(current);
+					current = next;
+				}
+			}
+			emit(current);
+
+			page.DirtyRanges.clear();
+		}
+	}
+
+	const uint8* MaterialConstantPages::GetPageData(uint32 page) const
+	{
+		ASSERT(page < m_Pages.size(), "Out of bounds.");
+		return m_Pages[page].Data.data();
+	}
+} // namespace shz
@@ -0,0 +1,99 @@
+#include "pch.h"
+#include "Engine/Renderer/Public/MaterialConstantPool.h"
+
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/Timer.hpp"
+
+namespace shz
+{
+	bool MaterialConstantPool::Initialize(IRenderDevice* pDevice, uint32 pageSize)
+	{
+		ASSERT(pDevice, "Device is null.");
+
+		Shutdown();
+		m_pDevice = pDevice;
+
+		m_Pages.Initialize(pageSize, pDevice->GetAdapterInfo().Buffer.ConstantBufferOffsetAlignment);
+
+		if (!addBuffer())
+		{
+			return false;
+		}
+		m_Pages.AddPage();
+		return true;
+	}
+
+	void MaterialConstantPool::Shutdown()
+	{
+		m_Pages.Reset();
+		m_Buffers.clear();
+		m_Uploads.clear();
+		m_pDevice = nullptr;
+	}
+
+	bool MaterialConstantPool::addBuffer()
+	{
+		ASSERT(m_pDevice, "MaterialConstantPool is not initialized.");
+
+		BufferDesc desc = {};
+		desc.Name = "MaterialConstants";
+		desc.Usage = USAGE_DEFAULT;
+		desc.BindFlags = BIND_UNIFORM_BUFFER;
+		desc.CPUAccessFlags = CPU_ACCESS_NONE;
+		desc.Size = m_Pages.GetPageSize();
+
+		RefCntAutoPtr<IBuffer> pBuffer;
+		m_pDevice->CreateBuffer(desc, nullptr, &pBuffer);
+		if (!pBuffer)
+		{
+			LOG_ERROR_MESSAGE("Failed to create material constant page (", desc.Size, " bytes).");
+			return false;
+		}
+
+		m_Buffers.push_back(std::move(pBuffer));
+		return true;
+	}
+
+	MaterialConstantAllocation MaterialConstantPool::Allocate(uint32 size)
+	{
+		ASSERT(m_pDevice, "MaterialConstantPool is not initialized.");
+
+		if (m_Pages.NeedsNewPage(size) && !addBuffer())
+		{
+			return {};
+		}
+
+		const MaterialConstantAllocation alloc = m_Pages.Allocate(size);
+		ASSERT(m_Buffers.size() == m_Pages.GetPageCount(), "Every page must have a buffer.");
+		return alloc;
+	}
+
+	void MaterialConstantPool::Flush(IDeviceContext* pContext)
+	{
+		ASSERT(pContext, "Context is null.");
+
+		Timer timer;
+
+		m_Uploads.clear();
+		m_Pages.CollectUploads(m_Uploads);
+
+		for (const MaterialConstantUpload& upload : m_Uploads)
+		{
+			pContext->UpdateBuffer(m_Buffers[upload.Page], upload.Begin, upload.End - upload.Begin,
+				m_Pages.GetPageData(upload.Page) + upload.Begin, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+		}
+
+		m_Pages.SetFlushMilliseconds(timer.GetElapsedTime() * 1000.0);
+	}
+
+	IBuffer* MaterialConstantPool::GetBuffer(const MaterialConstantAllocation& alloc) const
+	{
+		if (!alloc.IsValid())
+		{
+			return nullptr;
+		}
+
+		ASSERT(alloc.Page < m_Buffers.size(), "Out of bounds.");
+		return m_Buffers[alloc.Page];
+	}
+} // namespace shz
@@ -1,54 +1,289 @@
 #include "pch.h"
 #include "Engine/Renderer/Public/PipelineStateManager.h"
 
+#include <cstdio>
+
+#include "Engine/Core/Common/Public/ByteKeyWriter.hpp"
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/FileWrapper.hpp"
+#include "Engine/Core/Common/Public/Timer.hpp"
+
 namespace shz
 {
-	void PipelineStateManager::Initialize(IRenderDevice* pDevice)
+	// Shaders are identified by stage and bytecode, not by object, so equal shaders
+	// created twice (e.g. by two templates) still share pipelines.
+	static void writeShaderKey(ByteKeyWriter& writer, IShader* pShader)
+	{
+		if (pShader == nullptr)
+		{
+			writer(SHADER_TYPE_UNKNOWN);
+			return;
+		}
+
+		// Asynchronously compiled shaders only have bytecode once they are ready.
+		pShader->GetStatus(/*WaitForCompletion*/ true);
+
+		const void* pBytecode = nullptr;
+		uint64 size = 0;
+		pShader->GetBytecode(&pBytecode, size);
+		ASSERT(pBytecode != nullptr && size != 0, "Shader '", pShader->GetDesc().Name, "' has no bytecode.");
+
+		XXH128State hasher;
+		hasher.UpdateRaw(pBytecode, size);
+		const XXH128Hash bytecodeHash = hasher.Digest();
+
+		writer(pShader->GetDesc().ShaderType, size, bytecodeHash.LowPart, bytecodeHash.HighPart);
+	}
+
+	static XXH128Hash hashKey(const std::vector<uint8>& key)
+	{
+		XXH128State hasher;
+		hasher.UpdateRaw(key.data(), key.size());
+		return hasher.Digest();
+	}
+
+	void PipelineStateManager::Initialize(IRenderDevice* pDevice, const std::string& psoCachePath, RenderStateArchive* pArchive)
 	{
+		ASSERT(pDevice, "Device is null.");
+
+		Clear();
 		m_pDevice = pDevice;
+		m_PSOCachePath = psoCachePath;
+		m_pArchive = pArchive;
+		m_Stats = {};
+
+		if (m_PSOCachePath.empty())
+		{
+			return;
+		}
+
+		RefCntAutoPtr<IDataBlob> pData;
+		FileWrapper::ReadWholeFile(m_PSOCachePath.c_str(), &pData, /*Silent*/ true);
+
+		PipelineStateCacheCreateInfo ci = {};
+		ci.Desc.Name = "PipelineStateManager PSO cache";
+		ci.Desc.Mode = PSO_CACHE_MODE_LOAD_STORE;
+		if (pData)
+		{
+			ci.pCacheData = pData->GetConstDataPtr();
+			ci.CacheDataSize = static_cast<uint32>(pData->GetSize());
+		}
+
+		// Not every backend has a pipeline cache; pipelines are then only shared in memory.
+		m_pDevice->CreatePipelineStateCache(ci, &m_pPSOCache);
 	}
 
 	void PipelineStateManager::Clear()
 	{
-		m_GraphicsPSOMap.clear();
-		m_ComputePSOMap.clear();
+		m_PSOMap.clear();
+		m_pPSOCache.Release();
+		m_bCacheDirty = false;
+	}
+
+	bool PipelineStateManager::SaveCache()
+	{
+		if (!m_pPSOCache || m_PSOCachePath.empty() || !m_bCacheDirty)
+		{
+			return true;
+		}
+
+		RefCntAutoPtr<IDataBlob> pData;
+		m_pPSOCache->GetData(&pData);
+		if (!pData)
+		{
+			return false;
+		}
+
+		std::string directory;
+		FileSystem::GetPathComponents(m_PSOCachePath, &directory, nullptr);
+		if (!directory.empty() && !FileSystem::PathExists(directory.c_str()))
+		{
+			FileSystem::CreateDirectory(directory.c_str());
+		}
+
+		if (!FileWrapper::WriteFile(m_PSOCachePath.c_str(), pData->GetConstDataPtr(), pData->GetSize()))
+		{
+			LOG_ERROR_MESSAGE("Failed to write pipeline state cache '", m_PSOCachePath, "'.");
+			return false;
+		}
+
+		m_bCacheDirty = false;
+		return true;
 	}
 
 	RefCntAutoPtr<IPipelineState> PipelineStateManager::AcquireGraphics(const GraphicsPipelineStateCreateInfo& desc)
 	{
-		std::hash<GraphicsPipelineStateCreateInfo> hasher;
-		size_t psoHash = hasher(desc);
+		ASSERT(m_pDevice, "PipelineStateManager is not initialized.");
+
+		Timer keyTimer;
+
+		std::vector<uint8> key;
+		{
+			ByteKeyWriter writer{ key };
+			writer(static_cast<const PipelineStateCreateInfo&>(desc), desc.GraphicsPipeline);
+			for (IShader* pShader : { desc.pVS, desc.pPS, desc.pDS, desc.pHS, desc.pGS, desc.pAS, desc.pMS })
+			{
+				writeShaderKey(writer, pShader);
+			}
+		}
+		const XXH128Hash hash = hashKey(key);
 
-		auto it = m_GraphicsPSOMap.find(psoHash);
-		if (it != m_GraphicsPSOMap.end())
+		m_Stats.KeyMilliseconds += keyTimer.GetElapsedTime() * 1000.0;
+
+		if (IPipelineState* pCached = find(hash, key))
 		{
-			return it->second;
+			++m_Stats.Hits;
+			return RefCntAutoPtr<IPipelineState>{ pCached };
 		}
 
+		Timer createTimer;
+
+		const std::string cacheName = makeCacheName(hash);
+
 		RefCntAutoPtr<IPipelineState> pso;
-		m_pDevice->CreateGraphicsPipelineState(desc, &pso);
+		if (m_pArchive != nullptr)
+		{
+			pso = m_pArchive->UnpackGraphicsPipeline(desc, cacheName.c_str(), m_pPSOCache);
+			if (pso)
+			{
+				++m_Stats.ArchiveHits;
+				m_bCacheDirty |= (m_pPSOCache != nullptr);
+			}
+		}
+
+		if (!pso && m_pPSOCache)
+		{
+			GraphicsPipelineStateCreateInfo cachedDesc = desc;
+			cachedDesc.PSODesc.Name = cacheName.c_str();
+			cachedDesc.pPSOCache = m_pPSOCache;
+			m_pDevice->CreateGraphicsPipelineState(cachedDesc, &pso);
+			m_bCacheDirty = true;
+		}
+		else if (!pso)
+		{
+			m_pDevice->CreateGraphicsPipelineState(desc, &pso);
+		}
 		ASSERT(pso, "Failed to create graphics pipeline state");
-		m_GraphicsPSOMap[psoHash] = pso;
 
-		return m_GraphicsPSOMap[psoHash];
+		if (pso && m_pArchive != nullptr && m_pArchive->IsCooking())
+		{
+			m_pArchive->CookGraphicsPipeline(desc, cacheName.c_str());
+		}
+
+		m_Stats.CreateMilliseconds += createTimer.GetElapsedTime() * 1000.0;
+
+		if (!pso)
+		{
+			return {};
+		}
+
+		++m_Stats.UniqueGraphics;
+		insert(hash, std::move(key), pso);
+		return pso;
 	}
 
 	RefCntAutoPtr<IPipelineState> PipelineStateManager::AcquireCompute(const ComputePipelineStateCreateInfo& desc)
 	{
-		std::hash<ComputePipelineStateCreateInfo> hasher;
-		size_t psoHash = hasher(desc);
+		ASSERT(m_pDevice, "PipelineStateManager is not initialized.");
+
+		Timer keyTimer;
 
-		auto it = m_ComputePSOMap.find(psoHash);
-		if (it != m_ComputePSOMap.end())
+		std::vector<uint8> key;
 		{
-			return it->second;
+			ByteKeyWriter writer{ key };
+			writer(static_cast<const PipelineStateCreateInfo&>(desc));
+			writeShaderKey(writer, desc.pCS);
 		}
+		const XXH128Hash hash = hashKey(key);
+
+		m_Stats.KeyMilliseconds += keyTimer.GetElapsedTime() * 1000.0;
+
+		if (IPipelineState* pCached = find(hash, key))
+		{
+			++m_Stats.Hits;
+			return RefCntAutoPtr<IPipelineState>{ pCached };
+		}
+
+		Timer createTimer;
+
+		const std::string cacheName = makeCacheName(hash);
 
 		RefCntAutoPtr<IPipelineState> pso;
-		m_pDevice->CreateComputePipelineState(desc, &pso);
+		if (m_pArchive != nullptr)
+		{
+			pso = m_pArchive->UnpackComputePipeline(desc, cacheName.c_str(), m_pPSOCache);
+			if (pso)
+			{
+				++m_Stats.ArchiveHits;
+				m_bCacheDirty |= (m_pPSOCache != nullptr);
+			}
+		}
+
+		if (!pso && m_pPSOCache)
+		{
+			ComputePipelineStateCreateInfo cachedDesc = desc;
+			cachedDesc.PSODesc.Name = cacheName.c_str();
+			cachedDesc.pPSOCache = m_pPSOCache;
+			m_pDevice->CreateComputePipelineState(cachedDesc, &pso);
+			m_bCacheDirty = true;
+		}
+		else if (!pso)
+		{
+			m_pDevice->CreateComputePipelineState(desc, &pso);
+		}
 		ASSERT(pso, "Failed to create compute pipeline state");
-		m_ComputePSOMap[psoHash] = pso;
 
-		return m_ComputePSOMap[psoHash];
+		if (pso && m_pArchive != nullptr && m_pArchive->IsCooking())
+		{
+			m_pArchive->CookComputePipeline(desc, cacheName.c_str());
+		}
+
+		m_Stats.CreateMilliseconds += createTimer.GetElapsedTime() * 1000.0;
+
+		if (!pso)
+		{
+			return {};
+		}
+
+		++m_Stats.UniqueCompute;
+		insert(hash, std::move(key), pso);
+		return pso;
+	}
+
+	IPipelineState* PipelineStateManager::find(const XXH128Hash& hash, const std::vector<uint8>& key)
+	{
+		auto it = m_PSOMap.find(hash);
+		if (it == m_PSOMap.end())
+		{
+			return nullptr;
+		}
+
+		for (const Entry& entry : it->second)
+		{
+			if (entry.Key == key)
+			{
+				return entry.pPSO;
+			}
+		}
+
+		++m_Stats.HashCollisions;
+		return nullptr;
+	}
+
+	void PipelineStateManager::insert(const XXH128Hash& hash, std::vector<uint8>&& key, IPipelineState* pPSO)
+	{
+		Entry entry = {};
+		entry.Key = std::move(key);
+		entry.pPSO = pPSO;
+		m_PSOMap[hash].push_back(std::move(entry));
+	}
+
+	std::string PipelineStateManager::makeCacheName(const XXH128Hash& hash)
+	{
+		char name[40] = {};
+		std::snprintf(name, sizeof(name), "PSO_%016llx%016llx",
+			static_cast<unsigned long long>(hash.HighPart),
+			static_cast<unsigned long long>(hash.LowPart));
+		return name;
 	}
-} // namespace shz
\ No newline at end of file
+} // namespace shz
@@ -1,6 +1,10 @@
 #include "pch.h"
 #include "RenderScene.h"
 
+#include <algorithm>
+
+#include "Engine/Core/Common/Public/Errors.hpp"
+
 namespace shz
 {
 	// ------------------------------------------------------------
@@ -39,7 +43,7 @@ namespace shz
 		m_DirtyOcIndices.clear();
 
 		m_pTerrainHeightMap = nullptr;
-		m_TerrainMesh = {};
+		m_TerrainObjects.clear();
 	}
 
 	void RenderScene::ClearDirtyOcIndices()
@@ -59,7 +63,11 @@ namespace shz
 	{
 		UniqueHandle<SceneObject> owner = UniqueHandle<SceneObject>::Make();
 		const Handle<SceneObject> h = owner.Get();
-		ASSERT(h.IsValid(), "Failed to allocate SceneObject handle.");
+		if (!h.IsValid())
+		{
+			LOG_ERROR_MESSAGE("Failed to allocate SceneObject handle: the handle pool is exhausted.");
+			return {};
+		}
 
 		const uint32 handleIndex = h.GetIndex();
 		ensureCapacity(handleIndex, m_ObjectSlots);
@@ -244,7 +252,11 @@ namespace shz
 	{
 		UniqueHandle<LightObject> owner = UniqueHandle<LightObject>::Make();
 		const Handle<LightObject> h = owner.Get();
-		ASSERT(h.IsValid(), "Failed to allocate LightObject handle.");
+		if (!h.IsValid())
+		{
+			LOG_ERROR_MESSAGE("Failed to allocate LightObject handle: the handle pool is exhausted.");
+			return {};
+		}
 
 		const uint32 handleIndex = h.GetIndex();
 		ensureCapacity(handleIndex, m_LightSlots);
@@ -336,9 +348,10 @@ namespace shz
 	// ------------------------------------------------------------
 	void RenderScene::BuildDrawList(
 		uint64 passKey,
-		const std::vector<uint32>& visibleObjectDenseIndices,
-		std::vector<DrawItem>& outDrawItems,
-		std::vector<uint32>& outInstanceRemap) const
+		const ArenaVector<uint32>& visibleObjectDenseIndices,
+		ArenaVector<DrawItem>& outDrawItems,
+		ArenaVector<uint32>& outInstanceRemap,
+		const ArenaVector<uint8>* pVisibleObjectLods) const
 	{
 		outDrawItems.clear();
 		outInstanceRemap.clear();
@@ -348,17 +361,20 @@ namespace shz
 			return;
 		}
 
-		// OcIndex visibility mask
-		std::vector<uint8> ocVisible;
+		ASSERT(!pVisibleObjectLods || pVisibleObjectLods->size() == visibleObjectDenseIndices.size(), "LOD list size mismatch.");
+
+		// OcIndex visibility mask (0 = hidden, otherwise selected LOD + 1)
+		ArenaVector<uint8> ocVisible(outDrawItems.get_allocator());
 		ocVisible.resize(m_ObjectTableCPU.size(), 0);
 
-		for (uint32 objDense : visibleObjectDenseIndices)
+		for (size_t i = 0; i < visibleObjectDenseIndices.size(); ++i)
 		{
+			const uint32 objDense = visibleObjectDenseIndices[i];
 			ASSERT(objDense < static_cast<uint32>(m_ObjectDense.size()), "Object dense index out of bounds.");
 
 			const uint32 oc = m_ObjectDense[objDense].OcIndex;
 			ASSERT(oc != INVALID_INDEX && oc < static_cast<uint32>(ocVisible.size()), "Invalid object constant index.");
-			ocVisible[oc] = 1;
+			ocVisible[oc] = static_cast<uint8>((pVisibleObjectLods ? (*pVisibleObjectLods)[i] : 0) + 1);
 		}
 
 		// Iterate batches -> select instances whose OcIndex is visible
@@ -383,11 +399,13 @@ namespace shz
 			const uint32 start = static_cast<uint32>(outInstanceRemap.size());
 			uint32 count = 0;
 
+			const uint8 visibleTag = static_cast<uint8>(b.pMesh->Sections[b.SectionIndex].LodIndex + 1);
+
 			for (const BatchInstance& inst : b.Instances)
 			{
 				const uint32 oc = inst.OcIndex;
 				ASSERT(oc < static_cast<uint32>(ocVisible.size()), "Object constant index out of bounds.");
-				if (ocVisible[oc])
+				if (ocVisible[oc] == visibleTag)
 				{
 					outInstanceRemap.push_back(oc);
 					++count;
@@ -419,22 +437,288 @@ namespace shz
 		return true;
 	}
 
+	// ------------------------------------------------------------
+	// LOD selection
+	// ------------------------------------------------------------
+	// Rows are the transformed basis vectors (row-vector convention)
+	static void getAxisScaleRange(const Matrix4x4& world, float& outMin, float& outMax) noexcept
+	{
+		const float sx = float3(world._m00, world._m01, world._m02).Length();
+		const float sy = float3(world._m10, world._m11, world._m12).Length();
+		const float sz = float3(world._m20, world._m21, world._m22).Length();
+
+		outMin = std::min(sx, std::min(sy, sz));
+		outMax = std::max(sx, std::max(sy, sz));
+	}
+
+	uint32 RenderScene::SelectLod(const SceneObject& obj, const float3& cameraPosWS) noexcept
+	{
+		ASSERT(obj.pMesh, "Invalid scene object.");
+
+		const std::vector<float>& distances = obj.pMesh->LodSwitchDistances;
+		if (distances.empty())
+		{
+			return 0;
+		}
+
+		float minScale = 0.f;
+		float maxScale = 0.f;
+		getAxisScaleRange(obj.World, minScale, maxScale);
+
+		const Box& b = obj.pMesh->LocalBounds;
+		const float3 centerWS = obj.World.TransformPosition((b.Min + b.Max) * 0.5f);
+		const float radius = (b.Max - b.Min).Length() * 0.5f * maxScale;
+
+		const float dist = std::max(0.f, (centerWS - cameraPosWS).Length() - radius);
+
+		uint32 lod = 0;
+		while (lod < static_cast<uint32>(distances.size()) && dist >= distances[lod])
+		{
+			++lod;
+		}
+		return lod;
+	}
+
+	// ------------------------------------------------------------
+	// Cluster culling
+	// ------------------------------------------------------------
+	// Number of ranges left once gaps of at most maxGap indices are closed.
+	static size_t countRangesAfterMerge(const ArenaVector<RenderScene::IndexRange>& ranges, uint32 maxGap) noexcept
+	{
+		size_t count = ranges.empty() ? 0 : 1;
+		for (size_t i = 1; i < ranges.size(); ++i)
+		{
+			const uint32 prevEnd = ranges[i - 1].FirstIndex + ranges[i - 1].IndexCount;
+			count += (ranges[i].FirstIndex - prevEnd > maxGap) ? 1 : 0;
+		}
+		return count;
+	}
+
+	// Joins ranges (sorted, non-overlapping) separated by at most maxGap indices.
+	static void mergeIndexRanges(ArenaVector<RenderScene::IndexRange>& ranges, uint32 maxGap) noexcept
+	{
+		if (ranges.size() < 2)
+		{
+			return;
+		}
+
+		size_t last = 0;
+		for (size_t i = 1; i < ranges.size(); ++i)
+		{
+			RenderScene::IndexRange& prev = ranges[last];
+			const RenderScene::IndexRange& cur = ranges[i];
+
+			const uint32 prevEnd = prev.FirstIndex + prev.IndexCount;
+			ASSERT(cur.FirstIndex >= prevEnd, "Index ranges must be sorted.");
+
+			if (cur.FirstIndex - prevEnd <= maxGap)
+			{
+				prev.IndexCount = cur.FirstIndex + cur.IndexCount - prev.FirstIndex;
+			}
+			else
+			{
+				ranges[++last] = cur;
+			}
+		}
+		ranges.resize(last + 1);
+	}
+
+	void RenderScene::CullSectionClusters(
+		const StaticMeshRenderData& mesh,
+		uint32 sectionIndex,
+		const Matrix4x4& world,
+		const ViewFrustum& frustum,
+		const float3* pCameraPosWS,
+		ArenaVector<IndexRange>& outRanges,
+		ClusterCullStats* pStats,
+		const ClusterRangeSettings* pSettings)
+	{
+		outRanges.clear();
+
+		ASSERT(sectionIndex < static_cast<uint32>(mesh.Sections.size()), "SectionIndex OOB.");
+		const StaticMeshRenderData::Section& sec = mesh.Sections[sectionIndex];
+
+		if (sec.ClusterCount == 0)
+		{
+			outRanges.push_back(IndexRange{ sec.FirstIndex, sec.IndexCount });
+
+			if (pStats)
+			{
+				pStats->TrianglesTested += sec.IndexCount / 3;
+				pStats->TrianglesKept += sec.IndexCount / 3;
+				pStats->TrianglesDrawn += sec.IndexCount / 3;
+				pStats->RangesEmitted += 1;
+				pStats->SectionsDrawnWhole += 1;
+			}
+			return;
+		}
+
+		static const ClusterRangeSettings s_DefaultSettings = {};
+		const ClusterRangeSettings& settings = pSettings ? *pSettings : s_DefaultSettings;
+
+		ASSERT(sec.FirstCluster + sec.ClusterCount <= static_cast<uint32>(mesh.Clusters.size()), "Cluster range OOB.");
+
+		float minScale = 0.f;
+		float maxScale = 0.f;
+		getAxisScaleRange(world, minScale, maxScale);
+
+		// Cone axes only stay valid under uniform scale; otherwise skip the cone test.
+		const bool bConeTest =
+			pCameraPosWS != nullptr &&
+			sec.bBackFaceCulled &&
+			minScale > 0.f &&
+			(maxScale - minScale) <= maxScale * 1e-3f;
+
+		// Cone axes point out of clockwise front faces
+		const float invScale = (maxScale > 0.f) ? (1.f / maxScale) : 0.f;
+		const float coneScale = sec.bFrontCounterClockwise ? -invScale : invScale;
+
+		// Frustum planes are not normalized
+		float planeLen[ViewFrustum::NUM_PLANES] = {};
+		for (uint32 p = 0; p < ViewFrustum::NUM_PLANES; ++p)
+		{
+			planeLen[p] = frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(p)).Normal.Length();
+		}
+
+		uint64 clustersKept = 0;
+		uint64 trianglesKept = 0;
+
+		for (uint32 c = sec.FirstCluster; c < sec.FirstCluster + sec.ClusterCount; ++c)
+		{
+			const StaticMeshRenderData::Cluster& cl = mesh.Clusters[c];
+
+			const float3 center = world.TransformPosition(cl.Center);
+			const float radius = cl.Radius * maxScale;
+
+			bool bVisible = true;
+
+			for (uint32 p = 0; p < ViewFrustum::NUM_PLANES; ++p)
+			{
+				const Plane& plane = frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(p));
+				if (Vector3::Dot(center, plane.Normal) + plane.Distance < -radius * planeLen[p])
+				{
+					bVisible = false;
+					break;
+				}
+			}
+
+			if (bVisible && bConeTest && cl.ConeCutoff < 1.f)
+			{
+				const float3 axis = world.TransformDirection(cl.ConeAxis) * coneScale;
+				const float3 toCenter = center - *pCameraPosWS;
+
+				if (Vector3::Dot(toCenter, axis) >= cl.ConeCutoff * toCenter.Length() + radius)
+				{
+					bVisible = false;
+				}
+			}
+
+			if (!bVisible)
+			{
+				continue;
+			}
+
+			++clustersKept;
+			trianglesKept += cl.IndexCount / 3;
+
+			if (!outRanges.empty() && outRanges.back().FirstIndex + outRanges.back().IndexCount == cl.FirstIndex)
+			{
+				outRanges.back().IndexCount += cl.IndexCount;
+			}
+			else
+			{
+				outRanges.push_back(IndexRange{ cl.FirstIndex, cl.IndexCount });
+			}
+		}
+
+		// Close small gaps. If the section still needs more than MaxRanges draws, search
+		// for the smallest gap width whose closing brings it under the cap.
+		uint32 maxGap = settings.MergeGapIndices;
+
+		const size_t maxRanges = std::max(settings.MaxRanges, 1u);
+		if (countRangesAfterMerge(outRanges, maxGap) > maxRanges)
+		{
+			uint32 lo = maxGap + 1;
+			uint32 hi = sec.IndexCount;
+			while (lo < hi)
+			{
+				const uint32 mid = lo + (hi - lo) / 2;
+				if (countRangesAfterMerge(outRanges, mid) > maxRanges)
+				{
+					lo = mid + 1;
+				}
+				else
+				{
+					hi = mid;
+				}
+			}
+			maxGap = lo;
+		}
+
+		mergeIndexRanges(outRanges, maxGap);
+
+		uint64 indicesDrawn = 0;
+		for (const IndexRange& r : outRanges)
+		{
+			indicesDrawn += r.IndexCount;
+		}
+
+		const bool bWholeSection =
+			!outRanges.empty() &&
+			static_cast<float>(indicesDrawn) >= settings.WholeSectionRatio * static_cast<float>(sec.IndexCount);
+
+		if (bWholeSection)
+		{
+			outRanges.clear();
+			outRanges.push_back(IndexRange{ sec.FirstIndex, sec.IndexCount });
+			indicesDrawn = sec.IndexCount;
+		}
+
+		if (pStats)
+		{
+			pStats->ClustersTested += sec.ClusterCount;
+			pStats->ClustersKept += clustersKept;
+			pStats->TrianglesTested += sec.IndexCount / 3;
+			pStats->TrianglesKept += trianglesKept;
+			pStats->TrianglesDrawn += indicesDrawn / 3;
+			pStats->RangesEmitted += outRanges.size();
+			pStats->SectionsDrawnWhole += bWholeSection ? 1 : 0;
+		}
+	}
+
 	void RenderScene::SetTerrain(const TextureRenderData& heightMap, const StaticMeshRenderData& terrainMesh, const Matrix4x4& world)
 	{
 		// Remove the existing terrain if present
 		ClearTerrain();
 
 		m_pTerrainHeightMap = &heightMap;
-		m_TerrainMesh = AddObject(terrainMesh, world, /*bCastShadow=*/true);
+		m_TerrainObjects.push_back(AddObject(terrainMesh, world, /*bCastShadow=*/true));
+	}
+
+	void RenderScene::SetTerrain(const TextureRenderData& heightMap, const std::vector<const StaticMeshRenderData*>& chunkMeshes, const Matrix4x4& world)
+	{
+		ClearTerrain();
+
+		m_pTerrainHeightMap = &heightMap;
+
+		m_TerrainObjects.reserve(chunkMeshes.size());
+		for (const StaticMeshRenderData* pChunk : chunkMeshes)
+		{
+			ASSERT(pChunk, "Terrain chunk mesh is null.");
+			m_TerrainObjects.push_back(AddObject(*pChunk, world, /*bCastShadow=*/true));
+		}
 	}
 
 	void RenderScene::ClearTerrain()
 	{
-		if (m_TerrainMesh.IsValid() && m_TerrainMesh.IsAlive())
+		for (const Handle<SceneObject>& h : m_TerrainObjects)
 		{
-			RemoveObject(m_TerrainMesh);
-			m_TerrainMesh = {};
+			if (h.IsValid() && h.IsAlive())
+			{
+				RemoveObject(h);
+			}
 		}
+		m_TerrainObjects.clear();
 
 		m_pTerrainHeightMap = nullptr;
 	}
@@ -1,9 +1,9 @@
 ﻿#include "pch.h"
 #include "Engine/Renderer/Public/Renderer.h"
 
-#include <unordered_set>
-
 #include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Memory/Public/HeapAllocationCounter.h"
+#include "Engine/Core/Common/Public/Timer.hpp"
 #include "Engine/AssetManager/Public/AssetManager.h"
 #include "Engine/GraphicsTools/Public/GraphicsUtilities.h"
 #include "Engine/GraphicsTools/Public/MapHelper.hpp"
@@ -17,6 +17,7 @@
 #include "Engine/RenderPass/Public/PostRenderPass.h"
 #include "Engine/RenderPass/Public/GrassRenderPass.h"
 #include "Engine/RenderPass/Public/DrawPacket.h"
+#include "Engine/RenderPass/Public/DrawPacketSort.h"
 
 #include "Engine/Renderer/Public/CommonResourceId.h"
 
@@ -109,7 +110,36 @@ namespace shz
 		m_pDeferredContexts = createInfo.pDeferredContexts;
 		m_pSwapChain = createInfo.pSwapChain;
 		m_pAssetManager = createInfo.pAssetManager;
-		m_pShaderSourceFactory = createInfo.pShaderSourceFactory;
+
+		// Includes shared by several shaders are read and scanned once for all compiles.
+		m_ShaderSources.Initialize(createInfo.pShaderSourceFactory);
+		m_pShaderSourceFactory = m_ShaderSources.GetFactory();
+
+		m_ShaderCache.Initialize(m_pDevice->GetDeviceInfo().Type, createInfo.ShaderBytecodeCachePath, createInfo.AsyncShaderCompilation);
+		m_ShaderCache.SetPreprocessCache(&m_ShaderSources);
+
+		// The renderer only reads archives; they are written offline by App/RenderStateCooker.
+		m_pRenderStates = nullptr;
+		if (createInfo.pCookArchive != nullptr)
+		{
+			ASSERT(createInfo.pCookArchive->IsCooking(), "pCookArchive must be started with BeginCook().");
+			m_pRenderStates = createInfo.pCookArchive;
+		}
+		else if (m_RenderStates.Load(m_pDevice, createInfo.RenderStateArchivePath))
+		{
+			m_pRenderStates = &m_RenderStates;
+		}
+
+		if (m_pRenderStates != nullptr)
+		{
+			m_ShaderCache.SetRenderStateArchive(m_pRenderStates);
+		}
+
+		// Template shaders are requested here and finished just before the passes are
+		// created, so their compilation overlaps the texture loads in between.
+		m_ShaderStartupStats = {};
+		m_ShaderStartupStats.AsyncCompile = createInfo.AsyncShaderCompilation && m_pDevice->GetShaderCompilationThreadPool() != nullptr;
+		Timer shaderStartupTimer;
 
 		m_pRegistry = std::make_unique<RenderResourceRegistry>();
 		m_pRegistry->Initialize();
@@ -134,6 +164,11 @@ namespace shz
 					sVS.CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
 					sVS.UseCombinedTextureSamplers = false;
 
+					if (createInfo.DrawInstanceOffsetMode == EDrawInstanceOffsetMode::InstanceStream)
+					{
+						sVS.Macros.push_back({ OBJECT_INDEX_STREAM_MACRO, "1" });
+					}
+
 					MaterialShaderStageDesc sPS = {};
 					sPS.ShaderType = SHADER_TYPE_PIXEL;
 					sPS.DebugName = "PS";
@@ -146,15 +181,19 @@ namespace shz
 					tci.ShaderStages.push_back(sVS);
 					tci.ShaderStages.push_back(sPS);
 
-					return outTmpl.Initialize(m_pDevice, m_pShaderSourceFactory, tci);
+					return outTmpl.BeginInitialize(m_pDevice, m_pShaderSourceFactory, tci, &m_ShaderCache);
 				};
 
+			Timer timer;
+
 			MaterialTemplate gbufferTemplate;
 			const bool ok0 = makeTemplate(gbufferTemplate, "DefaultLit", "GBuffer.vsh", "GBuffer.psh");
 			ASSERT(ok0, "Build initial material templates failed.");
 
-			m_TemplateLibrary[gbufferTemplate.GetName()] = gbufferTemplate;
+			m_TemplateLibrary[gbufferTemplate.GetName()] = std::move(gbufferTemplate);
 			Material::RegisterTemplateLibrary(&m_TemplateLibrary);
+
+			m_ShaderStartupStats.TemplateRequestMilliseconds = timer.GetElapsedTime() * 1000.0;
 		}
 
 		const SwapChainDesc& scDesc = m_pSwapChain->GetDesc();
@@ -162,7 +201,12 @@ namespace shz
 		m_Height = (m_CreateInfo.BackBufferHeight != 0) ? m_CreateInfo.BackBufferHeight : scDesc.Height;
 
 		m_pPipelineStateManager = std::make_unique<PipelineStateManager>();
-		m_pPipelineStateManager->Initialize(m_pDevice);
+		m_pPipelineStateManager->Initialize(m_pDevice, createInfo.PipelineStateCachePath, m_pRenderStates);
+
+		if (!m_MaterialConstants.Initialize(m_pDevice, createInfo.MaterialConstantPageSize))
+		{
+			return false;
+		}
 
 		// -----------------------------------------------------------------
 		// Create error texture -> register to registry
@@ -235,16 +279,26 @@ namespace shz
 			m_pRegistry->RegisterBuffer(kRes_DrawCB, std::move(drawCB));
 			m_pRegistry->RegisterBuffer(kRes_ShadowCB, std::move(shadowCB));
 
-			// ObjectIndexInstanceVB
+			// Object index instance stream: element i holds i. Bound per-instance, the
+			// input assembler fetches FirstInstanceLocation + SV_InstanceID from it.
 			{
+				std::vector<uint32> indices(static_cast<size_t>(DEFAULT_MAX_OBJECT_COUNT));
+				for (size_t i = 0; i < indices.size(); ++i)
+				{
+					indices[i] = static_cast<uint32>(i);
+				}
+
 				BufferDesc desc = {};
 				desc.Name = "ObjectIndexInstanceVB";
-				desc.Usage = USAGE_DYNAMIC;
+				desc.Usage = USAGE_IMMUTABLE;
 				desc.BindFlags = BIND_VERTEX_BUFFER;
-				desc.CPUAccessFlags = CPU_ACCESS_WRITE;
-				desc.Size = sizeof(uint32);
+				desc.Size = sizeof(uint32) * DEFAULT_MAX_OBJECT_COUNT;
+
+				BufferData data = {};
+				data.pData = indices.data();
+				data.DataSize = desc.Size;
 
-				RefCntAutoPtr<IBuffer> vb = CreateBuffer(desc, nullptr);
+				RefCntAutoPtr<IBuffer> vb = CreateBuffer(desc, &data);
 				ASSERT(vb, "Object index VB create failed.");
 
 				m_pRegistry->RegisterBuffer(kRes_ObjectIndexVB, std::move(vb));
@@ -316,12 +370,17 @@ namespace shz
 		m_PassCtx.pImmediateContext = m_pImmediateContext.RawPtr();
 		m_PassCtx.pSwapChain = m_pSwapChain.RawPtr();
 		m_PassCtx.pShaderSourceFactory = m_pShaderSourceFactory.RawPtr();
+		m_PassCtx.pShaderCache = &m_ShaderCache;
 		m_PassCtx.pAssetManager = m_pAssetManager;
 		m_PassCtx.pPipelineStateManager = m_pPipelineStateManager.get();
 		m_PassCtx.pRegistry = m_pRegistry.get();
 
 		m_PassCtx.BackBufferWidth = m_Width;
 		m_PassCtx.BackBufferHeight = m_Height;
+		m_PassCtx.DrawInstanceOffsetMode = m_CreateInfo.DrawInstanceOffsetMode;
+
+		m_FrameArena.Initialize(FRAME_ARENA_FRAME_COUNT, FRAME_ARENA_INITIAL_BYTES, EMemoryTag::Renderer);
+		m_PassCtx.pFrameAllocator = &m_FrameArena.Get();
 
 		// -----------------------------------------------------------------
 		// Create common resources for passes
@@ -427,6 +486,10 @@ namespace shz
 			ASSERT(m_Passes.empty(), "m_Passes are already initilaized.");
 			ASSERT(m_PassOrder.empty(), "m_PassOrder are already initilaized.");
 
+			// Pass constructors only request their shaders. Every pass and template
+			// shader is in flight before anything waits on one.
+			Timer passTimer;
+
 			addPass(std::make_unique<ShadowRenderPass>(m_PassCtx));
 			addPass(std::make_unique<GBufferRenderPass>(m_PassCtx));
 			addPass(std::make_unique<LightingRenderPass>(m_PassCtx));
@@ -434,6 +497,49 @@ namespace shz
 			addPass(std::make_unique<GrassRenderPass>(m_PassCtx));
 			addPass(std::make_unique<PostRenderPass>(m_PassCtx));
 
+			m_ShaderStartupStats.PassMilliseconds = passTimer.GetElapsedTime() * 1000.0;
+
+			{
+				Timer timer;
+				for (auto& [name, tmpl] : m_TemplateLibrary)
+				{
+					const bool ok = tmpl.EndInitialize();
+					ASSERT(ok, "Failed to finish material template '%s'.", name.c_str());
+				}
+				m_ShaderStartupStats.TemplateFinishMilliseconds = timer.GetElapsedTime() * 1000.0;
+			}
+
+			{
+				Timer timer;
+				for (const std::string& name : m_PassOrder)
+				{
+					const bool ok = m_Passes[name]->CreatePipelines(m_PassCtx);
+					ASSERT(ok, "Failed to create the pipelines of pass '%s'.", name.c_str());
+				}
+				m_ShaderStartupStats.PipelineMilliseconds = timer.GetElapsedTime() * 1000.0;
+			}
+
+			// PSO creation already waited for the pass shaders; this only moves their bytecode into the cache.
+			m_ShaderCache.ResolvePending();
+			m_ShaderStartupStats.TotalMilliseconds = shaderStartupTimer.GetElapsedTime() * 1000.0;
+
+			LOG_INFO_MESSAGE("Shader startup: ", m_ShaderStartupStats.TotalMilliseconds, " ms (templates ",
+				m_ShaderStartupStats.TemplateRequestMilliseconds + m_ShaderStartupStats.TemplateFinishMilliseconds, " ms, passes ",
+				m_ShaderStartupStats.PassMilliseconds, " + ", m_ShaderStartupStats.PipelineMilliseconds, " ms, ", m_ShaderCache.GetStats().Misses, " compiled",
+				m_ShaderStartupStats.AsyncCompile ? " in parallel, " : ", ",
+				GetRenderStateArchiveStats().UnpackedShaders, " shaders and ", GetRenderStateArchiveStats().UnpackedPipelines,
+				" pipelines from the render state archive)");
+
+			m_bShaderHotReload = !createInfo.ShaderHotReloadDirectory.empty();
+			if (m_bShaderHotReload)
+			{
+				m_pShaderWatch = FileSystem::WatchDirectory(createInfo.ShaderHotReloadDirectory.c_str(), true);
+				if (!m_pShaderWatch)
+				{
+					LOG_WARNING_MESSAGE("Cannot watch '", createInfo.ShaderHotReloadDirectory, "'; shaders reload only through ReloadShaders().");
+				}
+			}
+
 			AssetRef<StaticMesh> grassRef = m_pAssetManager->RegisterAsset<StaticMesh>("C:/Dev/ShizenEngine/Assets/Exported/GrassBlade.shzmesh.json");
 			AssetPtr<StaticMesh> grassPtr = m_pAssetManager->LoadBlocking<StaticMesh>(grassRef);
 			ASSERT(grassPtr&& grassPtr->IsValid(), "Failed to load grass mesh.");
@@ -454,6 +560,24 @@ namespace shz
 			const TextureRenderData* grassDensityFieldTex = &CreateTextureRenderData(perlin);
 			static_cast<GrassRenderPass*>(m_Passes["Grass"].get())->SetGrassDensityField(m_PassCtx, *grassDensityFieldTex);
 		}
+
+		// -----------------------------------------------------------------
+		// Parallel pass recording
+		// -----------------------------------------------------------------
+		{
+			const size_t numLists = std::min(m_pDeferredContexts.size(), size_t(MAX_RECORD_COMMAND_LISTS));
+			if (numLists >= 2)
+			{
+				ThreadPoolCreateInfo tpci = {};
+				tpci.NumThreads = numLists - 1;
+				m_pRecordThreadPool = CreateThreadPool(tpci);
+				ASSERT(m_pRecordThreadPool, "Failed to create record thread pool.");
+			}
+
+			m_RecordCommandLists.resize(numLists);
+			m_RecordTasks.reserve(numLists);
+			m_PassRecordTimings.reserve(m_PassOrder.size());
+		}
 		return true;
 	}
 
@@ -461,6 +585,15 @@ namespace shz
 	{
 		ReleaseSwapChainBuffers();
 
+		if (m_pRecordThreadPool)
+		{
+			m_pRecordThreadPool->StopThreads();
+			m_pRecordThreadPool.Release();
+		}
+		m_RecordTasks.clear();
+		m_RecordCommandLists.clear();
+		m_PassRecordTimings.clear();
+
 		m_Passes.clear();
 		m_PassOrder.clear();
 		m_RHIRenderPasses.clear();
@@ -468,20 +601,41 @@ namespace shz
 		m_TextureCache.Clear();
 		m_StaticMeshCache.Clear();
 		m_MaterialCache.Clear();
+		m_ContentMaterials.clear();
+		m_MaterialConstants.Shutdown();
+		m_MaterialRenderDataStats = {};
+
+		if (m_pShaderWatch)
+		{
+			FileSystem::CloseDirectoryWatch(m_pShaderWatch);
+			m_pShaderWatch = nullptr;
+		}
+		m_PendingTemplates.clear();
+		m_PendingPasses.clear();
+		m_MaterialSources.clear();
+		m_bShaderHotReload = false;
 
 		if (m_pPipelineStateManager)
 		{
+			m_pPipelineStateManager->SaveCache();
 			m_pPipelineStateManager->Clear();
 			m_pPipelineStateManager.reset();
 		}
 
 		m_pShaderSourceFactory.Release();
+		m_ShaderCache.SetPreprocessCache(nullptr);
+		m_ShaderSources.Shutdown();
+		m_ShaderCache.Save();
+		m_ShaderCache.Shutdown();
+		m_RenderStates.Shutdown();
+		m_pRenderStates = nullptr;
 		m_pAssetManager = nullptr;
 
 		m_pRegistry->Shutdown();
 
 		m_CreateInfo = {};
 		m_PassCtx = {};
+		m_FrameArena.Shutdown();
 		m_Width = 0;
 		m_Height = 0;
 
@@ -493,6 +647,14 @@ namespace shz
 
 	void Renderer::BeginFrame()
 	{
+		m_FrameArena.BeginFrame();
+		m_PassCtx.pFrameAllocator = &m_FrameArena.Get();
+
+		if (m_bShaderHotReload)
+		{
+			updateShaderReload();
+		}
+
 		for (const std::string& name : m_PassOrder)
 		{
 			RenderPassBase* pass = m_Passes[name].get();
@@ -509,6 +671,11 @@ namespace shz
 		IDeviceContext* ctx = m_PassCtx.pImmediateContext;
 		m_PassCtx.ResetFrame();
 
+		const uint64 heapAllocationsAtStart = GetHeapAllocationCount();
+
+		// Everything below that dies with the frame lives in the frame arena.
+		ArenaAllocator& frameArena = *m_PassCtx.pFrameAllocator;
+
 		// ---------------------------------------------------------------------
 		// Pull shared renderer resources from registry
 		// ---------------------------------------------------------------------
@@ -556,7 +723,7 @@ namespace shz
 		// ------------------------------------------------------------
 		Matrix4x4 lightViewProj = {};
 		{
-			MapHelper<hlsl::FrameConstants> cb(ctx, pFrameCB, MAP_WRITE, MAP_FLAG_DISCARD);
+			hlsl::FrameConstants* cb = &m_FrameConstants;
 
 			cb->View = view.ViewMatrix;
 			cb->Proj = view.ProjMatrix;
@@ -706,10 +873,8 @@ namespace shz
 			cb->LightViewProj = lightViewProj;
 		}
 
-		{
-			MapHelper<hlsl::ShadowConstants> cb(ctx, pShadowCB, MAP_WRITE, MAP_FLAG_DISCARD);
-			cb->LightViewProj = lightViewProj;
-		}
+		m_ShadowConstants.LightViewProj = lightViewProj;
+		uploadPassConstants(ctx);
 
 		ViewFrustumExt frustumShadow = {};
 		ExtractViewFrustumPlanesFromMatrix(lightViewProj, frustumShadow);
@@ -717,39 +882,48 @@ namespace shz
 		// ------------------------------------------------------------
 		// Visibility (dense object indices)
 		// ------------------------------------------------------------
-		std::vector<uint32> visibleObjectIndexMain = {};
-		std::vector<uint32> visibleObjectIndexShadow = {};
+		ArenaVector<uint32> visibleObjectIndexMain(STD_ARENA_ALLOCATOR(uint32, frameArena, "VisibleObjectIndexMain"));
+		ArenaVector<uint32> visibleObjectIndexShadow(STD_ARENA_ALLOCATOR(uint32, frameArena, "VisibleObjectIndexShadow"));
+
+		// LOD per visible object (parallel arrays). Shadows use the camera LOD so they match the lit surface.
+		ArenaVector<uint8> visibleObjectLodMain(STD_ARENA_ALLOCATOR(uint8, frameArena, "VisibleObjectLodMain"));
+		ArenaVector<uint8> visibleObjectLodShadow(STD_ARENA_ALLOCATOR(uint8, frameArena, "VisibleObjectLodShadow"));
 		{
 			const uint32 count = scene.GetObjectDenseCount();
 
-			visibleObjectIndexMain.clear();
-			visibleObjectIndexShadow.clear();
-
 			visibleObjectIndexMain.reserve(count);
 			visibleObjectIndexShadow.reserve(count);
+			visibleObjectLodMain.reserve(count);
+			visibleObjectLodShadow.reserve(count);
 
 			for (uint32 i = 0; i < count; ++i)
 			{
 				const RenderScene::SceneObject& obj = scene.GetObjectByDenseIndex(i);
 				ASSERT(obj.pMesh, "Invalid scene object.");
 
-				const Box& localBounds = obj.pMesh->LocalBounds;
+				const Box worldBounds = obj.World.TransformBox(obj.pMesh->LocalBounds);
+				const uint8 lod = static_cast<uint8>(RenderScene::SelectLod(obj, view.CameraPosition));
 
-				if (IntersectsFrustum(frustumMain, localBounds, obj.World, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM))
+				if (IntersectsFrustum(frustumMain, worldBounds, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM))
 				{
 					visibleObjectIndexMain.push_back(i);
+					visibleObjectLodMain.push_back(lod);
 				}
 
 				if (obj.bCastShadow)
 				{
-					if (IntersectsFrustum(frustumShadow, localBounds, obj.World, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM))
+					if (IntersectsFrustum(frustumShadow, worldBounds, FRUSTUM_PLANE_FLAG_FULL_FRUSTUM))
 					{
 						visibleObjectIndexShadow.push_back(i);
+						visibleObjectLodShadow.push_back(lod);
 					}
 				}
 			}
 		}
 
+		// Constants written by CreateMaterialRenderData / UpdateMaterialRenderData since the last frame.
+		m_MaterialConstants.Flush(ctx);
+
 		// ------------------------------------------------------------
 		// Common barriers
 		// ------------------------------------------------------------
@@ -760,6 +934,7 @@ namespace shz
 		m_PassCtx.PushBarrier(pObjSB_GB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
 		m_PassCtx.PushBarrier(pObjSB_Grass, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
 		m_PassCtx.PushBarrier(pObjSB_Shadow, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+		m_PassCtx.PushBarrier(pObjIndexVB, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER);
 
 		m_PassCtx.PushBarrier(pEnvTex, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
 		m_PassCtx.PushBarrier(pEnvDiffTex, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
@@ -769,20 +944,13 @@ namespace shz
 		m_PassCtx.PushBarrier(pErrorTex, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
 
 		// ------------------------------------------------------------
-		// Visible objects: VB/IB + Material textures/CB barriers (dedup)
+		// Visible objects: VB/IB + Material textures/CB barriers
+		// (PreBarriers keeps one barrier per resource)
 		// ------------------------------------------------------------
-		std::unordered_set<const MaterialRenderData*> appliedRD;
-		appliedRD.reserve(1024);
-
 		auto applyMaterialIfNeeded = [&](const MaterialRenderData* rd)
 			{
 				ASSERT(rd, "Material render data is null.");
 
-				if (appliedRD.find(rd) != appliedRD.end())
-					return;
-
-				appliedRD.insert(rd);
-
 				if (rd->ConstantBuffer)
 				{
 					m_PassCtx.PushBarrier(rd->ConstantBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_CONSTANT_BUFFER);
@@ -829,15 +997,25 @@ namespace shz
 			}
 		}
 
-		if (!m_PassCtx.PreBarriers.empty())
+		// Passes that may record on deferred contexts have their transitions hoisted here.
+		for (const std::string& name : m_PassOrder)
 		{
-			ctx->TransitionResourceStates(static_cast<uint32>(m_PassCtx.PreBarriers.size()), m_PassCtx.PreBarriers.data());
+			RenderPassBase* pass = m_Passes[name].get();
+			ASSERT(pass, "Pass is null.");
+
+			if (pass->SupportsParallelRecording())
+			{
+				pass->PushPreBarriers(m_PassCtx);
+			}
 		}
 
+		m_PassCtx.FlushBarriers(ctx);
+		m_BarrierStats = m_PassCtx.PreBarriers.GetStats();
+
 		// ------------------------------------------------------------
 		// Helper: pack object table using instanceRemap
 		// ------------------------------------------------------------
-		auto packObjectTableFromRemap = [&](IBuffer* pObjectTableSB, const std::vector<uint32>& remap)
+		auto packObjectTableFromRemap = [&](IBuffer* pObjectTableSB, const ArenaVector<uint32>& remap)
 			{
 				ASSERT(pObjectTableSB, "ObjectTableSB is null.");
 				const std::vector<hlsl::ObjectConstants>& tableCPU = scene.GetObjectConstantsTableCPU();
@@ -856,11 +1034,22 @@ namespace shz
 		// ------------------------------------------------------------
 		// Helper: build packets from draw items
 		// ------------------------------------------------------------
-		auto buildPacketsFromDrawItems = [&](uint64 passKey, const std::vector<RenderScene::DrawItem>& items) -> std::vector<DrawPacket>
+		ArenaVector<RenderScene::IndexRange> clusterRanges(STD_ARENA_ALLOCATOR(RenderScene::IndexRange, frameArena, "ClusterRanges"));
+		m_ClusterCullStats = {};
+
+		auto buildPacketsFromDrawItems = [&](
+			uint64 passKey,
+			const ArenaVector<RenderScene::DrawItem>& items,
+			const ArenaVector<uint32>& remap,
+			const ViewFrustum& frustum,
+			const float3* pCameraPosWS,
+			ArenaVector<DrawPacket>& out)
 			{
-				std::vector<DrawPacket> out;
+				out.clear();
 				out.reserve(items.size());
 
+				const std::vector<hlsl::ObjectConstants>& tableCPU = scene.GetObjectConstantsTableCPU();
+
 				// Shadow PSO/SRB sources
 				IPipelineState* shadowPSO = nullptr;
 				IPipelineState* shadowMaskedPSO = nullptr;
@@ -931,32 +1120,88 @@ namespace shz
 					}
 
 					pkt.ObjectIndex = 0;
+
+					// Nearest instance decides the batch depth (squared distance keeps the order).
+					float viewDepth = 0.f;
+					if (pCameraPosWS)
+					{
+						const float3 localCenter = (mesh->LocalBounds.Min + mesh->LocalBounds.Max) * 0.5f;
+
+						viewDepth = std::numeric_limits<float>::max();
+						for (uint32 k = 0; k < di.InstanceCount; ++k)
+						{
+							const uint32 oc = remap[di.StartInstanceLocation + k];
+							ASSERT(oc < static_cast<uint32>(tableCPU.size()), "OcIndex OOB.");
+
+							const float3 centerWS = tableCPU[oc].World.TransformPosition(localCenter);
+							viewDepth = std::min(viewDepth, (centerWS - *pCameraPosWS).SqrMagnitude());
+						}
+					}
+					pkt.SortKey = DrawSortKey::Make(pkt, viewDepth);
+
+					// Single-instance draws of clustered sections (terrain, large props):
+					// split into the index ranges whose clusters survive culling.
+					if (di.InstanceCount == 1 && sec.ClusterCount >= CLUSTER_CULL_MIN_CLUSTERS)
+					{
+						const uint32 oc = remap[di.StartInstanceLocation];
+						ASSERT(oc < static_cast<uint32>(tableCPU.size()), "OcIndex OOB.");
+
+						RenderScene::CullSectionClusters(
+							*mesh,
+							bv.SectionIndex,
+							tableCPU[oc].World,
+							frustum,
+							pCameraPosWS,
+							clusterRanges,
+							&m_ClusterCullStats);
+
+						for (const RenderScene::IndexRange& r : clusterRanges)
+						{
+							DrawPacket rangePkt = pkt;
+							rangePkt.DrawAttribs.NumIndices = r.IndexCount;
+							rangePkt.DrawAttribs.FirstIndexLocation = r.FirstIndex;
+							out.push_back(rangePkt);
+						}
+						continue;
+					}
+
 					out.push_back(pkt);
 				}
-
-				return out;
 			};
 
 		// ------------------------------------------------------------
 		// Build draw lists + pack object tables + build packets
 		// ------------------------------------------------------------
-		std::vector<RenderScene::DrawItem> drawItems;
-		std::vector<uint32> instanceRemap;
+		ArenaVector<RenderScene::DrawItem> drawItems(STD_ARENA_ALLOCATOR(RenderScene::DrawItem, frameArena, "DrawItems"));
+		ArenaVector<uint32> instanceRemap(STD_ARENA_ALLOCATOR(uint32, frameArena, "InstanceRemap"));
+
+		// m_PassCtx keeps spans over the packet lists past Render() (EndFrame, the
+		// worker-recorded passes), so the lists themselves live in the frame arena
+		// and are never destroyed; the memory goes back when the arena slot is reused.
+		ArenaVector<DrawPacket>& gbufferPackets = *frameArena.New<ArenaVector<DrawPacket>>(STD_ARENA_ALLOCATOR(DrawPacket, frameArena, "GBufferDrawPackets"));
+		ArenaVector<DrawPacket>& grassPackets = *frameArena.New<ArenaVector<DrawPacket>>(STD_ARENA_ALLOCATOR(DrawPacket, frameArena, "GrassDrawPackets"));
+		ArenaVector<DrawPacket>& shadowPackets = *frameArena.New<ArenaVector<DrawPacket>>(STD_ARENA_ALLOCATOR(DrawPacket, frameArena, "ShadowDrawPackets"));
 
 		// GBuffer
-		scene.BuildDrawList(kPassGBuffer, visibleObjectIndexMain, drawItems, instanceRemap);
+		scene.BuildDrawList(kPassGBuffer, visibleObjectIndexMain, drawItems, instanceRemap, &visibleObjectLodMain);
 		packObjectTableFromRemap(pObjSB_GB, instanceRemap);
-		m_PassCtx.GBufferDrawPackets = buildPacketsFromDrawItems(kPassGBuffer, drawItems);
+		buildPacketsFromDrawItems(kPassGBuffer, drawItems, instanceRemap, frustumMain, &view.CameraPosition, gbufferPackets);
+		SortDrawPackets(gbufferPackets, frameArena);
+		m_PassCtx.GBufferDrawPackets = gbufferPackets;
 
 		// Grass
-		scene.BuildDrawList(kPassGrass, visibleObjectIndexMain, drawItems, instanceRemap);
+		scene.BuildDrawList(kPassGrass, visibleObjectIndexMain, drawItems, instanceRemap, &visibleObjectLodMain);
 		packObjectTableFromRemap(pObjSB_Grass, instanceRemap);
-		m_PassCtx.GrassDrawPackets = buildPacketsFromDrawItems(kPassGrass, drawItems);
+		buildPacketsFromDrawItems(kPassGrass, drawItems, instanceRemap, frustumMain, &view.CameraPosition, grassPackets);
+		m_PassCtx.GrassDrawPackets = grassPackets;
 
 		// Shadow
-		scene.BuildDrawList(kPassShadow, visibleObjectIndexShadow, drawItems, instanceRemap);
+		scene.BuildDrawList(kPassShadow, visibleObjectIndexShadow, drawItems, instanceRemap, &visibleObjectLodShadow);
 		packObjectTableFromRemap(pObjSB_Shadow, instanceRemap);
-		m_PassCtx.ShadowDrawPackets = buildPacketsFromDrawItems(kPassShadow, drawItems);
+		// No cone test for shadows: back faces still cast.
+		buildPacketsFromDrawItems(kPassShadow, drawItems, instanceRemap, frustumShadow, nullptr, shadowPackets);
+		SortDrawPackets(shadowPackets, frameArena);
+		m_PassCtx.ShadowDrawPackets = shadowPackets;
 
 		// Sanity: if this is 0, you will see nothing (this is the #1 failure)
 		// (leave as ASSERT while migrating; you can relax later)
@@ -965,12 +1210,9 @@ namespace shz
 		// ------------------------------------------------------------
 		// Execute passes
 		// ------------------------------------------------------------
-		for (const std::string& name : m_PassOrder)
-		{
-			RenderPassBase* pass = m_Passes[name].get();
-			ASSERT(pass, "Pass is null.");
-			pass->Execute(m_PassCtx);
-		}
+		executePasses();
+
+		m_LastFrameHeapAllocations = GetHeapAllocationCount() - heapAllocationsAtStart;
 	}
 
 	void Renderer::EndFrame()
@@ -1094,6 +1336,8 @@ namespace shz
 		const MaterialRenderData* cached = m_MaterialCache.Acquire(key);
 		if (cached)
 		{
+			++m_MaterialRenderDataStats.Requests;
+			++m_MaterialRenderDataStats.SharedRequests;
 			return *cached;
 		}
 
@@ -1113,11 +1357,46 @@ namespace shz
 	const MaterialRenderData& Renderer::CreateMaterialRenderData(const Material& material, uint64 key, const std::string& name)
 	{
 		ASSERT(m_pDevice, "Device is null.");
+		++m_MaterialRenderDataStats.Requests;
+
+		MaterialRenderData* pTarget = nullptr;
 		if (key == 0)
 		{
-			key = std::rand(); // TODO: better hash or REMOVE CreateMaterial overload
+			// Content keys live apart from explicit ones and compare their bytes,
+			// so a hash collision can never hand out (or free) another material's data.
+			auto [it, bInserted] = m_ContentMaterials.try_emplace(material.BuildKey());
+			if (!bInserted)
+			{
+				++m_MaterialRenderDataStats.SharedRequests;
+				return it->second;
+			}
+
+			pTarget = &it->second;
+			++m_MaterialRenderDataStats.Unique;
+		}
+		else
+		{
+			pTarget = m_MaterialCache.Acquire(key);
+			if (!pTarget)
+			{
+				m_MaterialCache.Store(key, MaterialRenderData{});
+				pTarget = m_MaterialCache.Acquire(key);
+				++m_MaterialRenderDataStats.Unique;
+			}
+		}
+
+		if (m_bShaderHotReload)
+		{
+			m_MaterialSources.erase(pTarget);
+			m_MaterialSources.emplace(pTarget, material);
 		}
 
+		buildMaterialRenderData(material, *pTarget);
+		return *pTarget;
+	}
+
+	void Renderer::buildMaterialRenderData(const Material& material, MaterialRenderData& target)
+	{
 		MaterialRenderData out = {};
 		out.RenderPassId = STRING_HASH(material.GetRenderPassName());
 
@@ -1140,6 +1419,18 @@ namespace shz
 				GraphicsPipelineStateCreateInfo psoCI = material.BuildGraphicsPipelineStateCreateInfo(m_RHIRenderPasses);
 				ASSERT(psoCI.GraphicsPipeline.pRenderPass != nullptr, "Render pass is null.");
 
+				// Templates are compiled with the instance stream input; append its element.
+				std::vector<LayoutElement> layoutElems;
+				if (m_PassCtx.DrawInstanceOffsetMode == EDrawInstanceOffsetMode::InstanceStream)
+				{
+					const InputLayoutDesc& il = psoCI.GraphicsPipeline.InputLayout;
+					layoutElems.assign(il.LayoutElements, il.LayoutElements + il.NumElements);
+					layoutElems.push_back(MakeObjectIndexStreamLayoutElement());
+
+					psoCI.GraphicsPipeline.InputLayout.LayoutElements = layoutElems.data();
+					psoCI.GraphicsPipeline.InputLayout.NumElements = static_cast<uint32>(layoutElems.size());
+				}
+
 				out.PSO = m_pPipelineStateManager->AcquireGraphics(psoCI);
 				ASSERT(out.PSO, "Failed to create PSO.");
 			}
@@ -1186,23 +1477,14 @@ namespace shz
 			out.PSO->CreateShaderResourceBinding(&out.SRB, true);
 			ASSERT(out.SRB, "Failed to create SRB.");
 
-			// Create dynamic material constants buffer if template has cbuffers.
+			// Material constants live in a range of a shared pool page.
 			const uint32 cbCount = material.GetTemplate().GetCBufferCount();
 			if (cbCount > 0)
 			{
 				const MaterialCBufferDesc& cb = material.GetTemplate().GetCBuffer(out.CBIndex);
 
-				BufferDesc desc = {};
-				desc.Name = "MaterialConstants";
-				desc.Usage = USAGE_DEFAULT;
-				desc.BindFlags = BIND_UNIFORM_BUFFER;
-				desc.CPUAccessFlags = CPU_ACCESS_NONE;
-				desc.Size = cb.ByteSize;
-
-				RefCntAutoPtr<IBuffer> pBuf;
-				m_pDevice->CreateBuffer(desc, nullptr, &pBuf);
-
-				out.ConstantBuffer = pBuf;
+				out.Constants = m_MaterialConstants.Allocate(cb.ByteSize);
+				out.ConstantBuffer = m_MaterialConstants.GetBuffer(out.Constants);
 
 				if (out.ConstantBuffer)
 				{
@@ -1216,7 +1498,7 @@ namespace shz
 						IShaderResourceVariable* var = out.SRB->GetVariableByName(st, MaterialTemplate::MATERIAL_CBUFFER_NAME);
 						if (var)
 						{
-							var->Set(out.ConstantBuffer);
+							var->SetBufferRange(out.ConstantBuffer, out.Constants.Offset, out.Constants.Size);
 						}
 					}
 				}
@@ -1236,12 +1518,12 @@ namespace shz
 
 				if (IShaderResourceVariable* var = out.ShadowSRB->GetVariableByName(SHADER_TYPE_VERTEX, MaterialTemplate::MATERIAL_CBUFFER_NAME))
 				{
-					var->Set(out.ConstantBuffer);
+					var->SetBufferRange(out.ConstantBuffer, out.Constants.Offset, out.Constants.Size);
 				}
 
 				if (IShaderResourceVariable* var = out.ShadowSRB->GetVariableByName(SHADER_TYPE_PIXEL, MaterialTemplate::MATERIAL_CBUFFER_NAME))
 				{
-					var->Set(out.ConstantBuffer);
+					var->SetBufferRange(out.ConstantBuffer, out.Constants.Offset, out.Constants.Size);
 				}
 			}
 		}
@@ -1256,15 +1538,10 @@ namespace shz
 				const uint8* pBlob = material.GetCBufferBlobData(out.CBIndex);
 				const uint32 blobSize = material.GetCBufferBlobSize(out.CBIndex);
 				ASSERT(pBlob && blobSize > 0, "Invalid blob data.");
-				ASSERT(blobSize <= out.ConstantBuffer->GetDesc().Size, "Blob size exceeds CB size.");
-
-				m_pImmediateContext->UpdateBuffer(
-					out.ConstantBuffer,
-					0,
-					blobSize,
-					pBlob,
-					RESOURCE_STATE_TRANSITION_MODE_TRANSITION
-				);
+				ASSERT(blobSize <= out.Constants.Size, "Blob size exceeds CB size.");
+
+				// Uploaded with the other dirty material constants at the next Render().
+				m_MaterialConstants.Write(out.Constants, pBlob, blobSize);
 			}
 
 			// Bind all textures
@@ -1321,8 +1598,41 @@ namespace shz
 			}
 		}
 
-		m_MaterialCache.Store(key, std::move(out));
-		return *m_MaterialCache.Acquire(key);
+		// Rebuilding releases the previous range (a new entry has none).
+		m_MaterialConstants.Free(target.Constants);
+		target = std::move(out);
+	}
+
+	bool Renderer::UpdateMaterialRenderData(uint64 key, const Material& material)
+	{
+		MaterialRenderData* pData = m_MaterialCache.Acquire(key);
+		if (!pData)
+		{
+			ASSERT(false, "MaterialRenderData not found.");
+			return false;
+		}
+
+		// A reload rebuilds from this copy, so it must carry the edited values.
+		if (m_bShaderHotReload)
+		{
+			m_MaterialSources.erase(pData);
+			m_MaterialSources.emplace(pData, material);
+		}
+
+		if (!pData->Constants.IsValid())
+		{
+			return true;
+		}
+
+		if (pData->CBIndex >= material.GetCBufferBlobCount()
+			|| material.GetCBufferBlobSize(pData->CBIndex) > pData->Constants.Size)
+		{
+			ASSERT(false, "UpdateMaterialRenderData: material constant layout changed.");
+			return false;
+		}
+
+		m_MaterialConstants.Write(pData->Constants, material.GetCBufferBlobData(pData->CBIndex), material.GetCBufferBlobSize(pData->CBIndex));
+		return true;
 	}
 
 	const StaticMeshRenderData& Renderer::CreateStaticMeshRenderData(const AssetRef<StaticMesh>& assetRef, const std::string& name)
@@ -1347,53 +1657,92 @@ namespace shz
 		}
 	}
 
-	const StaticMeshRenderData& Renderer::CreateStaticMeshRenderData(const StaticMesh& mesh, uint64 key, const std::string& name)
+	struct PackedStaticVertex final
 	{
-		if (key == 0)
+		float3 Pos;
+		float2 UV;
+		float3 Normal;
+		float3 Tangent;
+	};
+
+	static void packStaticVertices(const StaticMesh& mesh, uint32 firstVertex, uint32 vtxCount, std::vector<PackedStaticVertex>& outPacked)
+	{
+		ASSERT(firstVertex + vtxCount <= mesh.GetVertexCount(), "Vertex range OOB.");
+		outPacked.resize(vtxCount);
+
+		const std::vector<float3>& positions = mesh.GetPositions();
+		const std::vector<float3>& normals = mesh.GetNormals();
+		const std::vector<float3>& tangents = mesh.GetTangents();
+		const std::vector<float2>& texCoords = mesh.GetTexCoords();
+
+		const bool bHasNormals = (!normals.empty() && normals.size() == positions.size());
+		const bool bHasTangents = (!tangents.empty() && tangents.size() == positions.size());
+		const bool bHasUV = (!texCoords.empty() && texCoords.size() == positions.size());
+
+		for (uint32 k = 0; k < vtxCount; ++k)
 		{
-			key = std::rand(); // TODO: better hash or REMOVE CreateStaticMesh overload
+			const uint32 i = firstVertex + k;
+
+			PackedStaticVertex v{};
+			v.Pos = positions[i];
+			v.Normal = bHasNormals ? normals[i] : float3(0.0f, 1.0f, 0.0f);
+			v.Tangent = bHasTangents ? tangents[i] : float3(1.0f, 0.0f, 0.0f);
+			v.UV = bHasUV ? texCoords[i] : float2(0.0f, 0.0f);
+			outPacked[k] = v;
 		}
+	}
 
-		struct PackedStaticVertex final
-		{
-			float3 Pos;
-			float2 UV;
-			float3 Normal;
-			float3 Tangent;
-		};
+	static void packStaticVertices(const StaticMesh& mesh, std::vector<PackedStaticVertex>& outPacked)
+	{
+		packStaticVertices(mesh, 0, mesh.GetVertexCount(), outPacked);
+	}
 
-		std::vector<PackedStaticVertex> packed;
-		// Build packed vertex buffer data
+	static void copyStaticMeshClusters(const StaticMesh& mesh, StaticMeshRenderData& out)
+	{
+		out.Clusters.clear();
+		out.Clusters.reserve(mesh.GetClusterCount());
+		for (const auto& c : mesh.GetClusters())
 		{
-			const uint32 vtxCount = mesh.GetVertexCount();
-			packed.resize(vtxCount);
+			StaticMeshRenderData::Cluster d{};
+			d.FirstIndex = c.FirstIndex;
+			d.IndexCount = c.IndexCount;
+			d.Center = c.Center;
+			d.Radius = c.Radius;
+			d.ConeAxis = c.ConeAxis;
+			d.ConeCutoff = c.ConeCutoff;
+
+			out.Clusters.push_back(d);
+		}
+	}
 
-			const std::vector<float3>& positions = mesh.GetPositions();
-			const std::vector<float3>& normals = mesh.GetNormals();
-			const std::vector<float3>& tangents = mesh.GetTangents();
-			const std::vector<float2>& texCoords = mesh.GetTexCoords();
+	const StaticMeshRenderData& Renderer::CreateStaticMeshRenderData(const StaticMesh& mesh, uint64 key, const std::string& name, bool bAllowUpdates)
+	{
+		return createStaticMeshRenderData(mesh, nullptr, key, bAllowUpdates);
+	}
 
-			const bool bHasNormals = (!normals.empty() && normals.size() == positions.size());
-			const bool bHasTangents = (!tangents.empty() && tangents.size() == positions.size());
-			const bool bHasUV = (!texCoords.empty() && texCoords.size() == positions.size());
+	const StaticMeshRenderData& Renderer::CreateStaticMeshRenderData(const StaticMesh& mesh, const Material& sharedMaterial, uint64 key, const std::string& name, bool bAllowUpdates)
+	{
+		return createStaticMeshRenderData(mesh, &sharedMaterial, key, bAllowUpdates);
+	}
 
-			for (uint32 i = 0; i < vtxCount; ++i)
-			{
-				PackedStaticVertex v{};
-				v.Pos = positions[i];
-				v.Normal = bHasNormals ? normals[i] : float3(0.0f, 1.0f, 0.0f);
-				v.Tangent = bHasTangents ? tangents[i] : float3(1.0f, 0.0f, 0.0f);
-				v.UV = bHasUV ? texCoords[i] : float2(0.0f, 0.0f);
-				packed[i] = v;
-			}
+	const StaticMeshRenderData& Renderer::createStaticMeshRenderData(const StaticMesh& mesh, const Material* pSharedMaterial, uint64 key, bool bAllowUpdates)
+	{
+		if (key == 0)
+		{
+			key = std::rand(); // TODO: better hash or REMOVE CreateStaticMesh overload
 		}
 
-		auto createImmutableBuffer = [](IRenderDevice* device, const char* name, BIND_FLAGS bindFlags, const void* pData, uint32 dataSize) -> RefCntAutoPtr<IBuffer>
+		std::vector<PackedStaticVertex> packed;
+		packStaticVertices(mesh, packed);
+
+		const USAGE usage = bAllowUpdates ? USAGE_DEFAULT : USAGE_IMMUTABLE;
+
+		auto createMeshBuffer = [usage](IRenderDevice* device, const char* name, BIND_FLAGS bindFlags, const void* pData, uint32 dataSize) -> RefCntAutoPtr<IBuffer>
 			{
 				BufferDesc desc = {};
 				desc.Name = name;
 				desc.Size = dataSize;
-				desc.Usage = USAGE_IMMUTABLE;
+				desc.Usage = usage;
 				desc.BindFlags = bindFlags;
 				BufferData initData = {};
 				initData.pData = pData;
@@ -1404,14 +1753,14 @@ namespace shz
 			};
 
 		const uint32 vbBytes = static_cast<uint32>(packed.size() * sizeof(PackedStaticVertex));
-		RefCntAutoPtr<IBuffer> pVB = createImmutableBuffer(m_pDevice, "StaticMesh_VB", BIND_VERTEX_BUFFER, packed.data(), vbBytes);
+		RefCntAutoPtr<IBuffer> pVB = createMeshBuffer(m_pDevice, "StaticMesh_VB", BIND_VERTEX_BUFFER, packed.data(), vbBytes);
 		ASSERT(pVB, "Failed to create vertex buffer for StaticMesh.");
 
 		const void* pIndexData = mesh.GetIndexData();
 		const uint32 ibBytes = mesh.GetIndexDataSizeBytes();
 		ASSERT(pIndexData && ibBytes > 0, "Invalid index data in StaticMeshAsset.");
 
-		RefCntAutoPtr<IBuffer> pIB = createImmutableBuffer(m_pDevice, "StaticMesh_IB", BIND_INDEX_BUFFER, pIndexData, ibBytes);
+		RefCntAutoPtr<IBuffer> pIB = createMeshBuffer(m_pDevice, "StaticMesh_IB", BIND_INDEX_BUFFER, pIndexData, ibBytes);
 		ASSERT(pIB, "Failed to create index buffer for StaticMesh.");
 
 		StaticMeshRenderData out = {};
@@ -1423,6 +1772,10 @@ namespace shz
 		out.IndexType = mesh.GetIndexType();
 		out.LocalBounds = mesh.GetBounds();
 
+		// One lookup per slot. Slots are content-keyed, so equal materials of other meshes share the same render data.
+		// A shared material is looked up once and used by every section.
+		std::vector<const MaterialRenderData*> slotMaterials(pSharedMaterial ? 1 : mesh.GetMaterialSlotCount(), nullptr);
+
 		out.Sections.reserve(mesh.GetSections().size());
 		for (const auto& s : mesh.GetSections())
 		{
@@ -1431,17 +1784,116 @@ namespace shz
 			d.IndexCount = s.IndexCount;
 			d.BaseVertex = s.BaseVertex;
 			d.LocalBounds = s.LocalBounds;
+			d.FirstCluster = s.FirstCluster;
+			d.ClusterCount = s.ClusterCount;
+			d.LodIndex = s.LodIndex;
+
+			const uint32 slot = pSharedMaterial ? 0 : s.MaterialSlot;
+			const Material& material = pSharedMaterial ? *pSharedMaterial : mesh.GetMaterialSlot(slot);
+			d.bBackFaceCulled = (material.GetCullMode() == CULL_MODE_BACK);
+			d.bFrontCounterClockwise = material.GetFrontCounterClockwise();
 
-			d.pMaterial = &CreateMaterialRenderData(mesh.GetMaterialSlot(s.MaterialSlot));
+			if (!slotMaterials[slot])
+			{
+				slotMaterials[slot] = &CreateMaterialRenderData(material);
+			}
+			d.pMaterial = slotMaterials[slot];
 
 			out.Sections.push_back(d);
 		}
 
+		out.LodSwitchDistances = mesh.GetLodSwitchDistances();
+
+		copyStaticMeshClusters(mesh, out);
+
 		m_StaticMeshCache.Store(key, std::move(out));
 		return *m_StaticMeshCache.Acquire(key);
 	}
 
-	const TextureRenderData& Renderer::CreateTextureRenderDataFromHeightField(const TerrainHeightField& terrain)
+	bool Renderer::UpdateStaticMeshRenderData(uint64 key, const StaticMesh& mesh)
+	{
+		const StaticMesh::VertexRange all = { 0, mesh.GetVertexCount() };
+		return UpdateStaticMeshRenderData(key, mesh, std::span<const StaticMesh::VertexRange>(&all, 1), 0, mesh.GetIndexCount());
+	}
+
+	bool Renderer::UpdateStaticMeshRenderData(uint64 key, const StaticMesh& mesh, std::span<const StaticMesh::VertexRange> dirtyVertices, uint32 dirtyFirstIndex, uint32 dirtyIndexCount)
+	{
+		StaticMeshRenderData* pData = m_StaticMeshCache.Acquire(key);
+		if (!pData)
+		{
+			ASSERT(false, "StaticMeshRenderData not found.");
+			return false;
+		}
+
+		ASSERT(pData->VertexBuffer->GetDesc().Usage == USAGE_DEFAULT, "StaticMeshRenderData was not created with bAllowUpdates.");
+
+		if (pData->VertexCount != mesh.GetVertexCount()
+			|| pData->IndexCount != mesh.GetIndexCount()
+			|| pData->IndexType != mesh.GetIndexType()
+			|| pData->Sections.size() != mesh.GetSections().size())
+		{
+			ASSERT(false, "UpdateStaticMeshRenderData: mesh layout changed.");
+			return false;
+		}
+
+		std::vector<PackedStaticVertex> packed;
+		for (const StaticMesh::VertexRange& r : dirtyVertices)
+		{
+			if (r.VertexCount == 0)
+			{
+				continue;
+			}
+
+			packStaticVertices(mesh, r.FirstVertex, r.VertexCount, packed);
+
+			UpdateBuffer(m_pImmediateContext, pData->VertexBuffer,
+				static_cast<uint32>(r.FirstVertex * sizeof(PackedStaticVertex)),
+				static_cast<uint32>(packed.size() * sizeof(PackedStaticVertex)), packed.data());
+		}
+
+		if (dirtyIndexCount > 0)
+		{
+			ASSERT(dirtyFirstIndex + dirtyIndexCount <= mesh.GetIndexCount(), "Index range OOB.");
+
+			const uint32 indexSize = (mesh.GetIndexType() == VT_UINT16) ? 2u : 4u;
+			UpdateBuffer(m_pImmediateContext, pData->IndexBuffer,
+				dirtyFirstIndex * indexSize, dirtyIndexCount * indexSize,
+				static_cast<const uint8*>(mesh.GetIndexData()) + static_cast<size_t>(dirtyFirstIndex) * indexSize);
+		}
+
+		pData->LocalBounds = mesh.GetBounds();
+
+		for (size_t i = 0; i < pData->Sections.size(); ++i)
+		{
+			const StaticMesh::Section& s = mesh.GetSections()[i];
+			StaticMeshRenderData::Section& d = pData->Sections[i];
+
+			d.LocalBounds = s.LocalBounds;
+			d.FirstCluster = s.FirstCluster;
+			d.ClusterCount = s.ClusterCount;
+		}
+
+		copyStaticMeshClusters(mesh, *pData);
+
+		return true;
+	}
+
+	const TextureRenderData& Renderer::CreateTextureRenderDataFromHeightField(const AssetRef<TerrainHeightField>& assetRef)
+	{
+		uint64 key = std::hash<AssetID>{}(assetRef.GetID());
+		const TextureRenderData* cached = m_TextureCache.Acquire(key);
+		if (cached)
+		{
+			return *cached;
+		}
+
+		AssetPtr<TerrainHeightField> assetPtr = m_pAssetManager->LoadBlocking(assetRef);
+		ASSERT(assetPtr, "Failed to acquire TerrainHeightField.");
+
+		return CreateTextureRenderDataFromHeightField(*assetPtr, key);
+	}
+
+	const TextureRenderData& Renderer::CreateTextureRenderDataFromHeightField(const TerrainHeightField& terrain, uint64 key)
 	{
 		TextureRenderData out = {};
 
@@ -1483,12 +1935,45 @@ namespace shz
 
 		out.Sampler = nullptr;
 
-		uint64 key = std::rand(); // TODO: better hash or REMOVE CreateStaticMesh overload
+		if (key == 0)
+		{
+			key = std::rand(); // TODO: better hash or REMOVE CreateStaticMesh overload
+		}
 
 		m_TextureCache.Store(key, std::move(out));
 		return *m_TextureCache.Acquire(key);
 	}
 
+	void Renderer::UpdateTextureRenderDataFromHeightField(const TextureRenderData& heightMap, const TerrainHeightField& terrain, const TerrainDirtyRect& rect)
+	{
+		ASSERT(heightMap.Texture, "Height map texture is null.");
+
+		if (rect.IsEmpty())
+		{
+			return;
+		}
+
+		const uint32 width = terrain.GetWidth();
+		ASSERT(rect.X1 <= width && rect.Z1 <= terrain.GetHeight(), "Dirty rect out of range.");
+
+		// Source points at the rect origin inside the full row-major array
+		TextureSubResData sr = {};
+		sr.pData = terrain.GetDataU16().data() + static_cast<size_t>(rect.Z0) * width + rect.X0;
+		sr.Stride = width * sizeof(uint16);
+		sr.DepthStride = 0;
+
+		const IBox box = { rect.X0, rect.X1, rect.Z0, rect.Z1 };
+
+		m_pImmediateContext->UpdateTexture(
+			heightMap.Texture,
+			0,
+			0,
+			box,
+			sr,
+			RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+			RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+	}
+
 	const std::unordered_map<std::string, uint64> Renderer::GetPassDrawCallCountTable() const
 	{
 		std::unordered_map<std::string, uint64> drawCallTable;
@@ -1501,6 +1986,16 @@ namespace shz
 		return drawCallTable;
 	}
 
+	const std::unordered_map<std::string, DrawStateChangeStats> Renderer::GetPassStateChangeTable() const
+	{
+		std::unordered_map<std::string, DrawStateChangeStats> stateChangeTable;
+		for (auto& passPair : m_Passes)
+		{
+			stateChangeTable[passPair.first] = passPair.second->GetStateChangeStats();
+		}
+		return stateChangeTable;
+	}
+
 	const MaterialTemplate& Renderer::GetMaterialTemplate(const std::string& name) const
 	{
 		auto it = m_TemplateLibrary.find(name);
@@ -1518,15 +2013,353 @@ namespace shz
 		return names;
 	}
 
-	void Renderer::uploadObjectIndexInstance(IDeviceContext* pCtx, uint32 objectIndex)
+	void Renderer::ReloadShaders()
 	{
-		ASSERT(pCtx, "Context is null.");
+		if (!m_bShaderHotReload)
+		{
+			LOG_WARNING_MESSAGE("ReloadShaders: RendererCreateInfo::ShaderHotReloadDirectory is empty.");
+			return;
+		}
+
+		const std::vector<std::string> changedList = m_ShaderSources.Refresh();
+		if (changedList.empty())
+		{
+			return;
+		}
+
+		const std::unordered_set<std::string> changedFiles(changedList.begin(), changedList.end());
 
-		IBuffer* pVB = m_pRegistry->GetBuffer(kRes_ObjectIndexVB);
-		ASSERT(pVB, "Object index VB is null.");
+		++m_ShaderReloadStats.Reloads;
+		m_ShaderReloadTimer.Restart();
 
-		MapHelper<uint32> map(pCtx, pVB, MAP_WRITE, MAP_FLAG_DISCARD);
-		*map = objectIndex;
+		for (auto& [name, tmpl] : m_TemplateLibrary)
+		{
+			bool bAffected = false;
+			for (const MaterialShaderStageDesc& stage : tmpl.GetCreateInfo().ShaderStages)
+			{
+				bAffected = bAffected || changedFiles.count(stage.FilePath) != 0;
+			}
+
+			if (!bAffected)
+			{
+				continue;
+			}
+
+			// A template still compiling from an earlier edit restarts from the newest sources.
+			std::erase_if(m_PendingTemplates, [&name](const PendingTemplateReload& p) { return p.Name == name; });
+
+			PendingTemplateReload pending = {};
+			pending.Name = name;
+			if (!pending.Template.BeginInitialize(m_pDevice, m_pShaderSourceFactory, tmpl.GetCreateInfo(), &m_ShaderCache))
+			{
+				LOG_ERROR_MESSAGE("Material template '", name, "' failed to reload; keeping the previous shaders.");
+				++m_ShaderReloadStats.FailedReloads;
+				continue;
+			}
+			m_PendingTemplates.push_back(std::move(pending));
+		}
+
+		// The GBuffer pass draws with the template pipelines rebuilt above; the
+		// other passes own their pipelines and reload them themselves.
+		for (const std::string& passName : m_PassOrder)
+		{
+			RenderPassBase* pass = m_Passes[passName].get();
+			if (pass->RequestShaderReload(m_PassCtx, changedFiles)
+				&& std::find(m_PendingPasses.begin(), m_PendingPasses.end(), pass) == m_PendingPasses.end())
+			{
+				m_PendingPasses.push_back(pass);
+			}
+		}
+
+		LOG_INFO_MESSAGE("Shader reload: ", changedList.size(), " changed files, ",
+			m_PendingTemplates.size(), " templates and ", m_PendingPasses.size(), " passes rebuilding.");
+	}
+
+	void Renderer::updateShaderReload()
+	{
+		if (m_pShaderWatch && FileSystem::PollDirectoryChange(m_pShaderWatch))
+		{
+			ReloadShaders();
+		}
+
+		if (!IsShaderReloadPending())
+		{
+			return;
+		}
+
+		Timer swapTimer;
+
+		// Masked materials own SRBs created from the shadow pass's masked PSO. The old
+		// PSO is held until the swap is done so its address cannot be reused.
+		auto* shadowPass = static_cast<ShadowRenderPass*>(m_Passes["Shadow"].get());
+		RefCntAutoPtr<IPipelineState> pOldMaskedShadowPSO(shadowPass->GetShadowMaskedPSO());
+
+		// Passes swap on their own; a pass returns false while its new shaders are still compiling.
+		std::erase_if(m_PendingPasses, [this](RenderPassBase* pass)
+			{
+				if (!pass->FinishShaderReload(m_PassCtx))
+				{
+					return false;
+				}
+				++m_ShaderReloadStats.ReloadedPasses;
+				return true;
+			});
+
+		IPipelineState* pMaskedShadowPSO = shadowPass->GetShadowMaskedPSO();
+		if (pMaskedShadowPSO != nullptr && pMaskedShadowPSO != pOldMaskedShadowPSO && !pMaskedShadowPSO->IsCompatibleWith(pOldMaskedShadowPSO))
+		{
+			for (const auto& [pData, material] : m_MaterialSources)
+			{
+				if (material.GetBlendMode() == MATERIAL_BLEND_MODE_MASKED)
+				{
+					buildMaterialRenderData(material, *pData);
+					++m_ShaderReloadStats.ReloadedMaterials;
+				}
+			}
+		}
+
+		// Templates are swapped together, so materials sharing shaders never mix old and new ones.
+		for (const PendingTemplateReload& pending : m_PendingTemplates)
+		{
+			if (pending.Template.IsCompiling())
+			{
+				return;
+			}
+		}
+
+		std::unordered_set<std::string> swappedTemplates;
+		for (PendingTemplateReload& pending : m_PendingTemplates)
+		{
+			auto it = m_TemplateLibrary.find(pending.Name);
+			if (it == m_TemplateLibrary.end())
+			{
+				continue;
+			}
+
+			if (!pending.Template.EndInitialize())
+			{
+				LOG_ERROR_MESSAGE("Material template '", pending.Name, "' failed to reload; keeping the previous shaders.");
+				++m_ShaderReloadStats.FailedReloads;
+				continue;
+			}
+
+			// Materials built their constant blobs and variables from the old layout.
+			if (!pending.Template.HasSameLayout(it->second))
+			{
+				LOG_WARNING_MESSAGE("Material template '", pending.Name, "' changed its constants or resources; restart to pick up the edit.");
+				++m_ShaderReloadStats.FailedReloads;
+				continue;
+			}
+
+			it->second = std::move(pending.Template);
+			swappedTemplates.insert(pending.Name);
+			++m_ShaderReloadStats.ReloadedTemplates;
+		}
+		m_PendingTemplates.clear();
+
+		if (!swappedTemplates.empty())
+		{
+			for (const auto& [pData, material] : m_MaterialSources)
+			{
+				if (swappedTemplates.count(material.GetTemplateName()) != 0)
+				{
+					buildMaterialRenderData(material, *pData);
+					++m_ShaderReloadStats.ReloadedMaterials;
+				}
+			}
+		}
+
+		m_ShaderReloadStats.LastSwapMilliseconds = swapTimer.GetElapsedTime() * 1000.0;
+		if (!IsShaderReloadPending())
+		{
+			// Everything compiled by now; this only moves the new bytecode into the cache.
+			m_ShaderCache.ResolvePending();
+			m_ShaderReloadStats.LastReloadMilliseconds = m_ShaderReloadTimer.GetElapsedTime() * 1000.0;
+		}
+	}
+
+	void Renderer::executePasses()
+	{
+		m_PassRecordTimings.clear();
+		m_ParallelRecordStats = {};
+
+		// Consecutive parallel-capable passes are recorded together; the rest run in order on the immediate context.
+		ArenaVector<RenderPassBase*> parallelRun(STD_ARENA_ALLOCATOR(RenderPassBase*, *m_PassCtx.pFrameAllocator, "ParallelPassRun"));
+		parallelRun.reserve(m_PassOrder.size());
+
+		for (const std::string& name : m_PassOrder)
+		{
+			RenderPassBase* pass = m_Passes[name].get();
+			ASSERT(pass, "Pass is null.");
+
+			if (pass->SupportsParallelRecording())
+			{
+				parallelRun.push_back(pass);
+				continue;
+			}
+
+			if (!parallelRun.empty())
+			{
+				recordParallelPasses(parallelRun);
+				parallelRun.clear();
+			}
+
+			PassRecordTiming& timing = m_PassRecordTimings.emplace_back();
+			timing.PassName = pass->GetName();
+
+#ifdef PROFILING
+			Timer timer;
+#endif
+			pass->Execute(m_PassCtx);
+#ifdef PROFILING
+			timing.CpuMilliseconds = timer.GetElapsedTime() * 1000.0;
+#endif
+		}
+
+		if (!parallelRun.empty())
+		{
+			recordParallelPasses(parallelRun);
+		}
+	}
+
+	void Renderer::recordParallelPasses(std::span<RenderPassBase* const> passes)
+	{
+		IDeviceContext* pImmediate = m_PassCtx.pImmediateContext;
+
+		// Sized up front: workers write their own entries, nothing may reallocate meanwhile.
+		const size_t timingBase = m_PassRecordTimings.size();
+		m_PassRecordTimings.resize(timingBase + passes.size());
+		for (size_t i = 0; i < passes.size(); ++i)
+		{
+			m_PassRecordTimings[timingBase + i].PassName = passes[i]->GetName();
+		}
+
+		auto recordPass = [this, passes, timingBase](size_t i, IDeviceContext* pContext, uint32 threadIndex)
+			{
+				PassRecordTiming& timing = m_PassRecordTimings[timingBase + i];
+				timing.ThreadIndex = threadIndex;
+				timing.bDeferred = pContext->GetDesc().IsDeferred;
+
+#ifdef PROFILING
+				Timer timer;
+#endif
+				passes[i]->Record(m_PassCtx, pContext);
+#ifdef PROFILING
+				timing.CpuMilliseconds = timer.GetElapsedTime() * 1000.0;
+#endif
+			};
+
+		const uint32 numLists = static_cast<uint32>(std::min({ passes.size(), m_pDeferredContexts.size(), size_t(MAX_RECORD_COMMAND_LISTS) }));
+
+#ifdef PROFILING
+		Timer recordTimer;
+#endif
+
+		if (numLists < 2 || !m_pRecordThreadPool)
+		{
+			// Nothing to overlap with: record in place.
+			for (size_t i = 0; i < passes.size(); ++i)
+			{
+				recordPass(i, pImmediate, 0);
+			}
+		}
+		else
+		{
+			const uint32 immediateContextId = pImmediate->GetDesc().ContextId;
+
+			// Contiguous chunks, so executing the lists back to back keeps the pass order.
+			auto recordList = [this, passes, numLists, immediateContextId, &recordPass](uint32 listIndex, uint32 threadIndex)
+				{
+					const size_t first = passes.size() * listIndex / numLists;
+					const size_t last = passes.size() * (listIndex + 1) / numLists;
+
+					IDeviceContext* pDeferred = m_pDeferredContexts[listIndex];
+					pDeferred->Begin(immediateContextId);
+
+					// Dynamic buffers are allocated per context.
+					uploadPassConstants(pDeferred);
+
+					for (size_t i = first; i < last; ++i)
+					{
+						recordPass(i, pDeferred, threadIndex);
+					}
+
+					pDeferred->FinishCommandList(&m_RecordCommandLists[listIndex]);
+				};
+
+			m_RecordTasks.clear();
+			for (uint32 listIndex = 1; listIndex < numLists; ++listIndex)
+			{
+				m_RecordTasks.push_back(EnqueueAsyncWork(m_pRecordThreadPool,
+					[&recordList, listIndex](uint32 threadId)
+					{
+						recordList(listIndex, threadId + 1);
+						return ASYNC_TASK_STATUS_COMPLETE;
+					}));
+			}
+
+			recordList(0, 0);
+
+			for (const RefCntAutoPtr<IAsyncTask>& pTask : m_RecordTasks)
+			{
+				pTask->WaitForCompletion();
+			}
+			m_RecordTasks.clear();
+		}
+
+#ifdef PROFILING
+		m_ParallelRecordStats.RecordMilliseconds += recordTimer.GetElapsedTime() * 1000.0;
+		Timer submitTimer;
+#endif
+
+		if (numLists >= 2 && m_pRecordThreadPool)
+		{
+			ICommandList* ppCommandLists[MAX_RECORD_COMMAND_LISTS] = {};
+			for (uint32 listIndex = 0; listIndex < numLists; ++listIndex)
+			{
+				ppCommandLists[listIndex] = m_RecordCommandLists[listIndex];
+			}
+
+			pImmediate->ExecuteCommandLists(numLists, ppCommandLists);
+
+			for (uint32 listIndex = 0; listIndex < numLists; ++listIndex)
+			{
+				m_RecordCommandLists[listIndex].Release();
+
+				// Releases the dynamic allocations; the lists referencing them have been submitted.
+				m_pDeferredContexts[listIndex]->FinishFrame();
+			}
+
+			m_ParallelRecordStats.CommandLists += numLists;
+		}
+
+		// State is tracked on the immediate context only, so the outputs are transitioned here.
+		for (RenderPassBase* pass : passes)
+		{
+			pass->PushPostBarriers(m_PassCtx);
+		}
+		m_PassCtx.FlushPostBarriers(pImmediate);
+
+#ifdef PROFILING
+		m_ParallelRecordStats.SubmitMilliseconds += submitTimer.GetElapsedTime() * 1000.0;
+#endif
+	}
+
+	void Renderer::uploadPassConstants(IDeviceContext* pContext)
+	{
+		ASSERT(pContext, "Context is null.");
+
+		{
+			MapHelper<hlsl::FrameConstants> map(pContext, m_PassCtx.pRegistry->GetBuffer(kRes_FrameCB), MAP_WRITE, MAP_FLAG_DISCARD);
+			hlsl::FrameConstants* dst = map;
+			*dst = m_FrameConstants;
+		}
+
+		{
+			MapHelper<hlsl::ShadowConstants> map(pContext, m_PassCtx.pRegistry->GetBuffer(kRes_ShadowCB), MAP_WRITE, MAP_FLAG_DISCARD);
+			hlsl::ShadowConstants* dst = map;
+			*dst = m_ShadowConstants;
+		}
 	}
 
 	void Renderer::addPass(std::unique_ptr<RenderPassBase> pass)
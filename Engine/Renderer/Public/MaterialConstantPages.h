@@ -0,0 +1,114 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+
+#include "Primitives/BasicTypes.h"
+
+namespace shz
+{
+	struct MaterialConstantPoolStats final
+	{
+		uint32 PageCount = 0;
+		uint32 AllocationCount = 0;
+		uint64 AllocatedBytes = 0;
+
+		// Write() calls, and those that found the data already in the pool.
+		uint64 Writes = 0;
+		uint64 UnchangedWrites = 0;
+
+		// Last flush: merged ranges / bytes uploaded, CPU time spent merging and issuing them.
+		uint32 FlushedRanges = 0;
+		uint64 FlushedBytes = 0;
+		double FlushMilliseconds = 0.0;
+	};
+
+	struct MaterialConstantAllocation final
+	{
+		uint32 Page = 0;
+		uint32 Offset = 0;
+		uint32 Size = 0; // aligned, also the size of the bound range
+
+		bool IsValid() const noexcept { return Size != 0; }
+	};
+
+	// One merged span of a page to upload: [Begin, End) bytes.
+	struct MaterialConstantUpload final
+	{
+		uint32 Page = 0;
+		uint32 Begin = 0;
+		uint32 End = 0;
+	};
+
+	// ------------------------------------------------------------
+	// MaterialConstantPages
+	// - CPU side of MaterialConstantPool: page sub-allocation, free lists,
+	//   the CPU copy of every page and the dirty-range tracking. Owns no
+	//   device objects.
+	// - Write() diffs against the copy and records only the bytes that
+	//   changed; CollectUploads() merges the recorded ranges into spans
+	//   for the owner to upload and clears them.
+	// ------------------------------------------------------------
+	class MaterialConstantPages final
+	{
+	public:
+		// A CBV can address at most 64 KB, so larger material constant buffers are not supported.
+		static constexpr uint32 MAX_ALLOCATION_SIZE = 64u << 10;
+
+		void Initialize(uint32 pageSize, uint32 alignment);
+		void Reset();
+
+		// True if Allocate(size) would start a new page. The owner creates the
+		// page's buffer first, so a failed creation leaves the pages untouched.
+		bool NeedsNewPage(uint32 size) const;
+
+		// Starts a new page; later allocations fill it. Allocate() calls this when needed.
+		void AddPage();
+
+		// Returns an invalid allocation if size is 0 or too large.
+		MaterialConstantAllocation Allocate(uint32 size);
+		void Free(const MaterialConstantAllocation& alloc);
+
+		// size may be smaller than the allocation (the tail keeps its contents).
+		void Write(const MaterialConstantAllocation& alloc, const void* pData, uint32 size);
+
+		// Appends the merged dirty spans of every page to out and clears them.
+		void CollectUploads(std::vector<MaterialConstantUpload>& out);
+
+		uint32 GetPageCount() const noexcept { return static_cast<uint32>(m_Pages.size()); }
+		uint32 GetPageSize() const noexcept { return m_PageSize; }
+		uint32 GetAlignment() const noexcept { return m_Alignment; }
+		const uint8* GetPageData(uint32 page) const;
+
+		// The owner times its flush (merging plus issuing the uploads).
+		void SetFlushMilliseconds(double milliseconds) noexcept { m_Stats.FlushMilliseconds = milliseconds; }
+
+		const MaterialConstantPoolStats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		struct DirtyRange final
+		{
+			uint32 Begin = 0;
+			uint32 End = 0;
+		};
+
+		struct Page final
+		{
+			std::vector<uint8> Data = {};
+			uint32 UsedBytes = 0;
+			std::vector<DirtyRange> DirtyRanges = {};
+		};
+
+		bool isAllocatable(uint32 size) const;
+
+	private:
+		uint32 m_PageSize = 256u << 10;
+		uint32 m_Alignment = 256;
+
+		std::vector<Page> m_Pages;
+
+		// Keyed by aligned size.
+		std::unordered_map<uint32, std::vector<MaterialConstantAllocation>> m_FreeLists;
+
+		MaterialConstantPoolStats m_Stats = {};
+	};
+} // namespace shz
@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+
+#include "Engine/RHI/Interface/IRenderDevice.h"
+#include "Engine/RHI/Interface/IDeviceContext.h"
+#include "Engine/RHI/Interface/IBuffer.h"
+
+#include "Engine/Renderer/Public/MaterialConstantPages.h"
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// MaterialConstantPool
+	// - Constants of every material live in a few large uniform buffers
+	//   (pages). A material owns a range aligned to the device constant
+	//   buffer offset alignment and binds it with SetBufferRange().
+	// - Allocation, the CPU copies and dirty-range diffing are done by
+	//   MaterialConstantPages; this class owns one buffer per page and
+	//   Flush() uploads the merged dirty spans.
+	// - Freed ranges are reused by allocations of the same size.
+	// ------------------------------------------------------------
+	class MaterialConstantPool final
+	{
+	public:
+		static constexpr uint32 DEFAULT_PAGE_SIZE = 256u << 10;
+		static constexpr uint32 MAX_ALLOCATION_SIZE = MaterialConstantPages::MAX_ALLOCATION_SIZE;
+
+		MaterialConstantPool() = default;
+		MaterialConstantPool(const MaterialConstantPool&) = delete;
+		MaterialConstantPool& operator=(const MaterialConstantPool&) = delete;
+		~MaterialConstantPool() { Shutdown(); }
+
+		bool Initialize(IRenderDevice* pDevice, uint32 pageSize = DEFAULT_PAGE_SIZE);
+		void Shutdown();
+
+		// Returns an invalid allocation if size is 0 or too large, or a page cannot be created.
+		MaterialConstantAllocation Allocate(uint32 size);
+		void Free(const MaterialConstantAllocation& alloc) { m_Pages.Free(alloc); }
+
+		// size may be smaller than the allocation (the tail keeps its contents).
+		void Write(const MaterialConstantAllocation& alloc, const void* pData, uint32 size) { m_Pages.Write(alloc, pData, size); }
+
+		// Uploads the dirty ranges of every page. Call once per frame before drawing.
+		void Flush(IDeviceContext* pContext);
+
+		IBuffer* GetBuffer(const MaterialConstantAllocation& alloc) const;
+
+		const MaterialConstantPoolStats& GetStats() const noexcept { return m_Pages.GetStats(); }
+
+	private:
+		bool addBuffer();
+
+	private:
+		IRenderDevice* m_pDevice = nullptr;
+
+		MaterialConstantPages m_Pages;
+		std::vector<RefCntAutoPtr<IBuffer>> m_Buffers;
+
+		// Reused by Flush() to avoid a per-frame allocation.
+		std::vector<MaterialConstantUpload> m_Uploads;
+	};
+} // namespace shz
@@ -1,14 +1,57 @@
 #pragma once
+#include <string>
+#include <vector>
 #include <unordered_map>
 
+#include "Primitives/BasicTypes.h"
 #include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
 #include "Engine/Core/Common/Public/HashUtils.hpp"
 
 #include "Engine/RHI/Interface/IRenderDevice.h"
 #include "Engine/RHI/Interface/IPipelineState.h"
+#include "Engine/RHI/Interface/IPipelineStateCache.h"
+
+#include "Engine/GraphicsTools/Public/XXH128Hasher.hpp"
+#include "Engine/GraphicsTools/Public/RenderStateArchive.h"
 
 namespace shz
 {
+	struct PipelineStateManagerStats final
+	{
+		// Distinct pipelines created by the manager.
+		uint32 UniqueGraphics = 0;
+		uint32 UniqueCompute = 0;
+
+		// Acquire calls answered with an existing pipeline.
+		uint32 Hits = 0;
+
+		// Pipelines (among the unique ones) unpacked from the render state archive.
+		uint32 ArchiveHits = 0;
+
+		// Different keys that shared a 128-bit hash (resolved by the full key compare).
+		uint32 HashCollisions = 0;
+
+		// Time spent building keys / creating pipelines on misses.
+		double KeyMilliseconds = 0.0;
+		double CreateMilliseconds = 0.0;
+	};
+
+	// ------------------------------------------------------------
+	// PipelineStateManager
+	// - Pipelines are keyed by a canonical structural key: the create
+	//   info without PSO/render pass names, with every string length
+	//   prefixed and every shader reduced to its type and bytecode hash.
+	//   Materials that describe the same states get the same PSO.
+	// - The map is indexed by the XXH128 of the key; the full key is
+	//   compared on every hit.
+	// - With a cache path, pipelines go through the device
+	//   IPipelineStateCache (the D3D12 pipeline library), which is loaded
+	//   at Initialize() and written back by SaveCache(). Cached pipelines
+	//   are named after their key so the library lookup is stable.
+	// - With a render state archive, misses are unpacked from it (by the
+	//   same name) before anything is created; while the archive is
+	//   cooking, every new pipeline is added to it.
+	// ------------------------------------------------------------
 	class PipelineStateManager
 	{
 	public:
@@ -17,16 +60,44 @@ namespace shz
 		PipelineStateManager& operator=(const PipelineStateManager&) = delete;
 		~PipelineStateManager() { Clear(); }
 
-		void Initialize(IRenderDevice* pDevice);
+		// psoCachePath may be empty: pipelines are then only shared in memory.
+		// pArchive is not owned and must outlive the manager.
+		void Initialize(IRenderDevice* pDevice, const std::string& psoCachePath = {}, RenderStateArchive* pArchive = nullptr);
 		void Clear();
 
+		// Writes the pipeline cache file if any pipeline was created since Initialize()/SaveCache().
+		bool SaveCache();
+
 		RefCntAutoPtr<IPipelineState> AcquireGraphics(const GraphicsPipelineStateCreateInfo& desc);
 		RefCntAutoPtr<IPipelineState> AcquireCompute(const ComputePipelineStateCreateInfo& desc);
 
+		const PipelineStateManagerStats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		struct Entry final
+		{
+			std::vector<uint8> Key = {};
+			RefCntAutoPtr<IPipelineState> pPSO;
+		};
+
+		// Returns the cached pipeline for key, or null (recording a collision if the hash matched).
+		IPipelineState* find(const XXH128Hash& hash, const std::vector<uint8>& key);
+		void insert(const XXH128Hash& hash, std::vector<uint8>&& key, IPipelineState* pPSO);
+
+		static std::string makeCacheName(const XXH128Hash& hash);
+
 	private:
 		IRenderDevice* m_pDevice = nullptr;
 
-		std::unordered_map<size_t, RefCntAutoPtr<IPipelineState>> m_GraphicsPSOMap;
-		std::unordered_map<size_t, RefCntAutoPtr<IPipelineState>> m_ComputePSOMap;
+		// Graphics and compute keys start with the pipeline type, so they share one map.
+		std::unordered_map<XXH128Hash, std::vector<Entry>> m_PSOMap;
+
+		RefCntAutoPtr<IPipelineStateCache> m_pPSOCache;
+		std::string m_PSOCachePath = {};
+		bool m_bCacheDirty = false;
+
+		RenderStateArchive* m_pArchive = nullptr;
+
+		PipelineStateManagerStats m_Stats = {};
 	};
-} // namespace shz
\ No newline at end of file
+} // namespace shz
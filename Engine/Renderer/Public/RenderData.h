@@ -14,6 +14,8 @@
 #include "Engine/RHI/Interface/IPipelineState.h"
 #include "Engine/RHI/Interface/IShaderResourceBinding.h"
 
+#include "Engine/Renderer/Public/MaterialConstantPool.h"
+
 namespace shz
 {
 	struct TextureRenderData final
@@ -33,7 +35,9 @@ namespace shz
 		RefCntAutoPtr<IPipelineState> PSO = {};
 		RefCntAutoPtr<IShaderResourceBinding>  SRB = {};
 
+		// Page of the renderer's MaterialConstantPool; Constants is the range bound as MATERIAL_CONSTANTS.
 		RefCntAutoPtr<IBuffer> ConstantBuffer = {};
+		MaterialConstantAllocation Constants = {};
 		uint32 CBIndex = 0;
 		std::vector<const TextureRenderData*> BoundTextures = {};
 
@@ -68,9 +72,37 @@ namespace shz
 			const MaterialRenderData* pMaterial = {};
 
 			Box LocalBounds = {};
+
+			uint32 FirstCluster = 0;
+			uint32 ClusterCount = 0;
+
+			uint32 LodIndex = 0;
+
+			// False for two-sided materials (normal cone test must be skipped)
+			bool bBackFaceCulled = true;
+
+			// Material winding; the cluster cone axes point out of clockwise front faces
+			bool bFrontCounterClockwise = true;
 		};
 		std::vector<Section> Sections = {};
 
+		// Mirrors StaticMesh::Cluster (local space)
+		struct Cluster final
+		{
+			uint32 FirstIndex = 0;
+			uint32 IndexCount = 0;
+
+			float3 Center = {};
+			float Radius = 0.f;
+
+			float3 ConeAxis = { 0.f, 1.f, 0.f };
+			float ConeCutoff = 1.f;
+		};
+		std::vector<Cluster> Clusters = {};
+
+		// Mirrors StaticMesh LOD switch distances (empty = single LOD)
+		std::vector<float> LodSwitchDistances = {};
+
 		StaticMeshRenderData() = default;
 		StaticMeshRenderData(const StaticMeshRenderData&) = delete;
 		StaticMeshRenderData(StaticMeshRenderData&&) = default;
@@ -109,6 +141,7 @@ namespace shz
 				v.PSO,
 				v.SRB,
 				v.ConstantBuffer,
+				v.Constants.Offset,
 				v.CBIndex,
 				v.ShadowSRB);
 
@@ -135,7 +168,10 @@ namespace shz
 				s.IndexCount,
 				s.BaseVertex,
 				s.pMaterial,
-				s.LocalBounds);
+				s.LocalBounds,
+				s.FirstCluster,
+				s.ClusterCount,
+				s.LodIndex);
 		}
 	};
 
@@ -163,6 +199,8 @@ namespace shz
 			{
 				this->m_Hasher(sec);
 			}
+
+			this->m_Hasher(v.Clusters.size());
 		}
 	};
 
@@ -4,6 +4,7 @@
 #include "Primitives/UniqueHandle.hpp"
 
 #include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Memory/Public/ArenaAllocator.h"
 #include "Engine/Renderer/Public/RenderData.h"
 
 #include "Engine/RuntimeData/Public/TerrainHeightField.h"
@@ -51,6 +52,38 @@ namespace shz
 			uint32 InstanceCount = 0;
 		};
 
+		// Contiguous index range that survived cluster culling
+		struct IndexRange final
+		{
+			uint32 FirstIndex = 0;
+			uint32 IndexCount = 0;
+		};
+
+		// How kept clusters are turned into draws. Each range is one draw call, so a few
+		// culled triangles are drawn rather than splitting a section into many small draws.
+		struct ClusterRangeSettings final
+		{
+			// Ranges separated by at most this many culled indices are drawn as one
+			uint32 MergeGapIndices = 64 * 3;
+
+			// Upper bound on ranges per section; larger gaps are closed until it fits
+			uint32 MaxRanges = 32;
+
+			// Draw the whole section once this share of its triangles would be drawn anyway
+			float WholeSectionRatio = 0.8f;
+		};
+
+		struct ClusterCullStats final
+		{
+			uint64 ClustersTested = 0;
+			uint64 ClustersKept = 0;
+			uint64 TrianglesTested = 0;
+			uint64 TrianglesKept = 0;
+			uint64 TrianglesDrawn = 0;   // Kept + culled triangles inside merged ranges
+			uint64 RangesEmitted = 0;
+			uint64 SectionsDrawnWhole = 0;
+		};
+
 	public:
 		RenderScene() = default;
 		RenderScene(const RenderScene&) = delete;
@@ -106,12 +139,20 @@ namespace shz
 			return m_ObjectDense[denseIndex].OcIndex;
 		}
 
+		// LOD selection: distance from the camera to the object's bounding sphere
+		// against StaticMeshRenderData::LodSwitchDistances. Returns 0 for single-LOD meshes.
+		static uint32 SelectLod(const SceneObject& obj, const float3& cameraPosWS) noexcept;
+
 		// Visible-aware draw list
+		// pVisibleObjectLods (optional) runs parallel to visibleObjectDenseIndices;
+		// only sections whose LodIndex matches the object's LOD are emitted.
+		// Scratch memory comes from outDrawItems' arena.
 		void BuildDrawList(
 			uint64 passKey,
-			const std::vector<uint32>& visibleObjectDenseIndices,
-			std::vector<DrawItem>& outDrawItems,
-			std::vector<uint32>& outInstanceRemap) const;
+			const ArenaVector<uint32>& visibleObjectDenseIndices,
+			ArenaVector<DrawItem>& outDrawItems,
+			ArenaVector<uint32>& outInstanceRemap,
+			const ArenaVector<uint8>* pVisibleObjectLods = nullptr) const;
 
 
 		// Renderer BatchId ¸ ȸ  ְ
@@ -126,16 +167,39 @@ namespace shz
 
 		bool TryGetBatchView(uint32 batchId, BatchView& outView) const noexcept;
 
+		// ------------------------------------------------------------
+		// Cluster culling (CPU)
+		//
+		// Tests every cluster of the section against the frustum and, if pCameraPosWS
+		// is given, against its normal cone. Kept clusters are merged into index ranges
+		// following ClusterRangeSettings (pSettings == nullptr: defaults), so outRanges
+		// is the compacted list to draw. Sections without clusters, or with most of
+		// their triangles kept, produce one range covering the whole section.
+		// ------------------------------------------------------------
+		static void CullSectionClusters(
+			const StaticMeshRenderData& mesh,
+			uint32 sectionIndex,
+			const Matrix4x4& world,
+			const ViewFrustum& frustum,
+			const float3* pCameraPosWS,
+			ArenaVector<IndexRange>& outRanges,
+			ClusterCullStats* pStats = nullptr,
+			const ClusterRangeSettings* pSettings = nullptr);
+
 		// ------------------------------------------------------------
 	   // Height field / Terrain
 	   // ------------------------------------------------------------
 		void SetTerrain(const TextureRenderData& heightMap, const StaticMeshRenderData& terrainMesh, const Matrix4x4& world = Matrix4x4::Identity());
+
+		// Chunked terrain (TerrainMeshBuilder::BuildChunkedStaticMeshes): one scene object per chunk,
+		// so chunks are frustum culled and LOD-selected individually.
+		void SetTerrain(const TextureRenderData& heightMap, const std::vector<const StaticMeshRenderData*>& chunkMeshes, const Matrix4x4& world = Matrix4x4::Identity());
 		void ClearTerrain();
 
-		bool HasTerrain() const noexcept { return m_TerrainMesh.IsValid() && m_TerrainMesh.IsAlive(); }
+		bool HasTerrain() const noexcept { return !m_TerrainObjects.empty(); }
 
 		const TextureRenderData& GetHeightMap() const noexcept { return *m_pTerrainHeightMap; }
-		const Handle<SceneObject>& GetTerrainMeshHandle() const noexcept { return m_TerrainMesh; }
+		const std::vector<Handle<SceneObject>>& GetTerrainObjectHandles() const noexcept { return m_TerrainObjects; }
 		void AddInteractionStamp(const hlsl::InteractionStamp& stamp) { m_InteractionStamps.emplace_back(stamp); }
 		void ConsumeInteractionStamps(std::vector<hlsl::InteractionStamp>* out) { out->swap(m_InteractionStamps); m_InteractionStamps.clear(); }
 
@@ -310,7 +374,7 @@ namespace shz
 		// Terrain / Height field
 		// ------------------------------------------------------------
 		const TextureRenderData* m_pTerrainHeightMap = {};
-		Handle<SceneObject> m_TerrainMesh = {};
+		std::vector<Handle<SceneObject>> m_TerrainObjects;
 
 		std::vector<hlsl::InteractionStamp> m_InteractionStamps;
 	};
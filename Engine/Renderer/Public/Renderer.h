@@ -1,5 +1,6 @@
-#pragma once
+﻿#pragma once
 #include <vector>
+#include <span>
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -8,6 +9,9 @@
 #include "Primitives/Handle.hpp"
 
 #include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+#include "Engine/Core/Common/Public/ThreadPool.hpp"
+#include "Engine/Core/Common/Public/Timer.hpp"
+#include "Engine/Core/Memory/Public/FrameArena.h"
 
 #include "Engine/RHI/Interface/IEngineFactory.h"
 #include "Engine/RHI/Interface/IRenderDevice.h"
@@ -21,6 +25,10 @@
 #include "Engine/RHI/Interface/ITexture.h"
 #include "Engine/RHI/Interface/ITextureView.h"
 
+#include "Engine/GraphicsTools/Public/ShaderBytecodeCache.h"
+#include "Engine/GraphicsTools/Public/ShaderPreprocessCache.h"
+#include "Engine/GraphicsTools/Public/RenderStateArchive.h"
+
 #include "Engine/ImGui/Public/ImGuiImplShizen.hpp"
 
 #include "Engine/RuntimeData/Public/StaticMesh.h"
@@ -29,6 +37,7 @@
 #include "Engine/Renderer/Public/ViewFamily.h"
 #include "Engine/Renderer/Public/RenderResourceCache.hpp"
 #include "Engine/Renderer/Public/PipelineStateManager.h"
+#include "Engine/Renderer/Public/MaterialConstantPool.h"
 
 #include "Engine/RenderPass/Public/RenderPassContext.h"
 #include "Engine/RenderPass/Public/RenderPassBase.h"
@@ -59,6 +68,110 @@ namespace shz
 		std::string DiffuseIrradianceTexPath = "C:/Dev/ShizenEngine/Assets/Cubemap/Sky/skyDiffuseHDR.dds";
 		std::string SpecularIrradianceTexPath = "C:/Dev/ShizenEngine/Assets/Cubemap/Sky/skySpecularHDR.dds";
 		std::string BrdfLUTTexPath = "C:/Dev/ShizenEngine/Assets/Cubemap/Sky/skyBrdf.dds";
+
+		// Compiled shader bytecode, loaded at Initialize and written back at Cleanup.
+		// Empty keeps the cache in memory only.
+		std::string ShaderBytecodeCachePath = "C:/Dev/ShizenEngine/Cache/ShaderBytecode.bin";
+
+		// Driver pipeline cache, loaded at Initialize and written back at Cleanup.
+		// Empty disables it (pipelines are still shared in memory).
+		std::string PipelineStateCachePath = "C:/Dev/ShizenEngine/Cache/PipelineStates.bin";
+
+		// Prebuilt shaders and pipelines (written by App/RenderStateCooker), tried before
+		// the caches above. Empty disables it.
+		std::string RenderStateArchivePath = "C:/Dev/ShizenEngine/Cache/RenderStates.archive";
+
+		// Offline cooking only: an archive started with RenderStateArchive::BeginCook().
+		// RenderStateArchivePath is not read; every shader and pipeline created is added
+		// to this archive, which the caller saves. Not owned; must outlive Cleanup().
+		RenderStateArchive* pCookArchive = nullptr;
+
+		// Compile cache misses on the device shader compilation thread pool
+		// (needs DeviceFeatures::AsyncShaderCompilation, otherwise ignored).
+		bool AsyncShaderCompilation = true;
+
+		// Size of each buffer holding the constants of many materials.
+		uint32 MaterialConstantPageSize = MaterialConstantPool::DEFAULT_PAGE_SIZE;
+
+		// Non-empty: shader files under this directory are watched. Edited shaders are
+		// recompiled in the background and swapped in at BeginFrame once they are ready.
+		std::string ShaderHotReloadDirectory = {};
+
+		// How GBuffer/Shadow draws locate their instances in the object table.
+		EDrawInstanceOffsetMode DrawInstanceOffsetMode = EDrawInstanceOffsetMode::InstanceStream;
+	};
+
+	// CPU cost of one pass in the last Render().
+	struct PassRecordTiming final
+	{
+		const char* PassName = nullptr;
+
+		// 0 = render thread, N = record worker N - 1.
+		uint32 ThreadIndex = 0;
+
+		// Recorded into a deferred context command list.
+		bool bDeferred = false;
+
+		double CpuMilliseconds = 0.0;
+	};
+
+	struct ParallelRecordStats final
+	{
+		// Command lists executed on the immediate context.
+		uint32 CommandLists = 0;
+
+		// Wall time from the first Record() to the last command list being finished.
+		double RecordMilliseconds = 0.0;
+
+		// ExecuteCommandLists + post-pass barriers.
+		double SubmitMilliseconds = 0.0;
+	};
+
+	// Cold-start cost of Initialize() spent on shaders and pipelines.
+	struct ShaderStartupStats final
+	{
+		// Whether cache misses were compiled on the device thread pool.
+		bool AsyncCompile = false;
+
+		// Material templates: requesting the shaders / waiting for them and reflecting.
+		double TemplateRequestMilliseconds = 0.0;
+		double TemplateFinishMilliseconds = 0.0;
+
+		// Render pass construction (pass objects, shader requests) and
+		// CreatePipelines() (waiting for pass shaders, PSOs, SRBs).
+		double PassMilliseconds = 0.0;
+		double PipelineMilliseconds = 0.0;
+
+		// Wall time from the first shader request to the last compile being resolved.
+		double TotalMilliseconds = 0.0;
+	};
+
+	struct MaterialRenderDataStats final
+	{
+		// CreateMaterialRenderData calls, and those answered with existing render data.
+		uint32 Requests = 0;
+		uint32 SharedRequests = 0;
+
+		// MaterialRenderData built (each owns one PSO reference, SRB and constant range).
+		uint32 Unique = 0;
+	};
+
+	struct ShaderReloadStats final
+	{
+		// Shader edits picked up (each may touch several files).
+		uint32 Reloads = 0;
+
+		// Objects rebuilt with the new shaders.
+		uint32 ReloadedTemplates = 0;
+		uint32 ReloadedMaterials = 0;
+		uint32 ReloadedPasses = 0;
+
+		// Templates/passes that kept their previous shaders (compile error or changed material layout).
+		uint32 FailedReloads = 0;
+
+		// Last reload: from the edit being detected to every object being swapped / time spent swapping.
+		double LastReloadMilliseconds = 0.0;
+		double LastSwapMilliseconds = 0.0;
 	};
 
 	class Renderer final
@@ -117,42 +230,133 @@ namespace shz
 		const TextureRenderData& CreateTextureRenderData(const AssetRef<Texture>& assetRef, const std::string& name = "");
 		const TextureRenderData& CreateTextureRenderData(const Texture& texture, uint64 key = 0, const std::string& name = "");
 		const MaterialRenderData& CreateMaterialRenderData(const AssetRef<Material>& assetRef, const std::string& name = "");
+		// key == 0: the material is keyed by its content (Material::BuildKey()), so equal
+		// materials share one MaterialRenderData. Explicit keys always (re)build.
+		// The two never collide: content-keyed data is kept in its own map.
 		const MaterialRenderData& CreateMaterialRenderData(const Material& material, uint64 key = 0, const std::string& name = "");
 		const StaticMeshRenderData& CreateStaticMeshRenderData(const AssetRef<StaticMesh>& assetRef, const std::string& name = "");
-		const StaticMeshRenderData& CreateStaticMeshRenderData(const StaticMesh& mesh, uint64 key = 0, const std::string& name = "");
+		const StaticMeshRenderData& CreateStaticMeshRenderData(const StaticMesh& mesh, uint64 key = 0, const std::string& name = "", bool bAllowUpdates = false);
+		// Every section is drawn with sharedMaterial; the mesh needs no material slots
+		// (terrain chunks: one material for all of them instead of a copy per chunk).
+		const StaticMeshRenderData& CreateStaticMeshRenderData(const StaticMesh& mesh, const Material& sharedMaterial, uint64 key = 0, const std::string& name = "", bool bAllowUpdates = false);
+
+		// Rewrites the GPU buffers and bounds of a mesh created with bAllowUpdates.
+		// Vertex / index counts must be unchanged (e.g. a rebuilt terrain chunk).
+		bool UpdateStaticMeshRenderData(uint64 key, const StaticMesh& mesh);
+
+		// Same, but only the given vertex runs and index range are uploaded
+		// (TerrainChunk::DirtyVertexRanges / DirtyFirstIndex / DirtyIndexCount).
+		bool UpdateStaticMeshRenderData(uint64 key, const StaticMesh& mesh, std::span<const StaticMesh::VertexRange> dirtyVertices, uint32 dirtyFirstIndex, uint32 dirtyIndexCount);
+
+		// Copies the material's constants into the shared material constant buffer.
+		// Only the bytes that changed are uploaded, with the next Render().
+		// Content-keyed render data is shared: use an explicit key for materials edited at runtime.
+		bool UpdateMaterialRenderData(uint64 key, const Material& material);
 
-		const TextureRenderData& CreateTextureRenderDataFromHeightField(const TerrainHeightField& terrain);
+		// Uploads straight from the heightfield's uint16 samples (no intermediate copy).
+		// The AssetRef overload is cached per asset, so every user shares one texture.
+		const TextureRenderData& CreateTextureRenderDataFromHeightField(const AssetRef<TerrainHeightField>& assetRef);
+		const TextureRenderData& CreateTextureRenderDataFromHeightField(const TerrainHeightField& terrain, uint64 key = 0);
+
+		// Uploads only the texels inside rect from the heightfield.
+		void UpdateTextureRenderDataFromHeightField(const TextureRenderData& heightMap, const TerrainHeightField& terrain, const TerrainDirtyRect& rect);
 
 		const std::unordered_map<std::string, uint64> GetPassDrawCallCountTable() const;
+		const std::unordered_map<std::string, DrawStateChangeStats> GetPassStateChangeTable() const;
+		const RenderScene::ClusterCullStats& GetClusterCullStats() const noexcept { return m_ClusterCullStats; }
+		const BarrierBatchStats& GetBarrierStats() const noexcept { return m_BarrierStats; }
+		const std::vector<PassRecordTiming>& GetPassRecordTimings() const noexcept { return m_PassRecordTimings; }
+		const ParallelRecordStats& GetParallelRecordStats() const noexcept { return m_ParallelRecordStats; }
+		const ShaderBytecodeCacheStats& GetShaderCacheStats() const noexcept { return m_ShaderCache.GetStats(); }
+		const ShaderStartupStats& GetShaderStartupStats() const noexcept { return m_ShaderStartupStats; }
+		ShaderPreprocessCacheStats GetShaderPreprocessStats() const { return m_ShaderSources.GetStats(); }
+		const PipelineStateManagerStats& GetPipelineStateStats() const { return m_pPipelineStateManager->GetStats(); }
+		const RenderStateArchiveStats& GetRenderStateArchiveStats() const noexcept { return (m_pRenderStates != nullptr) ? m_pRenderStates->GetStats() : m_RenderStates.GetStats(); }
+		const MaterialConstantPoolStats& GetMaterialConstantStats() const noexcept { return m_MaterialConstants.GetStats(); }
+		const ShaderReloadStats& GetShaderReloadStats() const noexcept { return m_ShaderReloadStats; }
+		const MaterialRenderDataStats& GetMaterialRenderDataStats() const noexcept { return m_MaterialRenderDataStats; }
+
+		// Heap allocations made by any thread during the last Render()
+		// (needs SHZ_TRACK_HEAP_ALLOCATIONS, otherwise always 0).
+		uint64 GetLastFrameHeapAllocationCount() const noexcept { return m_LastFrameHeapAllocations; }
+		const FrameArena& GetFrameArena() const noexcept { return m_FrameArena; }
 
 		const MaterialTemplate& GetMaterialTemplate(const std::string& name) const;
 		std::vector<std::string> GetAllMaterialTemplateNames() const;
 
+		// Re-reads the shader sources used so far and starts rebuilding the templates,
+		// materials and passes that depend on a changed file. Needs ShaderHotReloadDirectory;
+		// BeginFrame() calls it when the directory watcher reports a change.
+		void ReloadShaders();
+		bool IsShaderReloadPending() const noexcept { return !m_PendingTemplates.empty() || !m_PendingPasses.empty(); }
+
 	private:
-		void uploadObjectIndexInstance(IDeviceContext* pCtx, uint32 objectIndex);
 		void addPass(std::unique_ptr<RenderPassBase> pass);
 
+		// Builds into target, releasing the constant range it held before.
+		void buildMaterialRenderData(const Material& material, MaterialRenderData& target);
+
+		// pSharedMaterial == nullptr: sections use the mesh's own material slots.
+		const StaticMeshRenderData& createStaticMeshRenderData(const StaticMesh& mesh, const Material* pSharedMaterial, uint64 key, bool bAllowUpdates);
+
+		// Swaps in whatever finished compiling since the last frame.
+		void updateShaderReload();
+
+		void executePasses();
+		void recordParallelPasses(std::span<RenderPassBase* const> passes);
+		void uploadPassConstants(IDeviceContext* pContext);
+
 	private:
 		static constexpr uint64 DEFAULT_MAX_OBJECT_COUNT = 1ull << 20;
 
+		// Sections with fewer clusters are drawn whole (culling would cost more than it saves)
+		static constexpr uint32 CLUSTER_CULL_MIN_CLUSTERS = 8;
+
+		// Frame data may still be read while the next frame is recorded.
+		static constexpr uint32 FRAME_ARENA_FRAME_COUNT = 2;
+		static constexpr size_t FRAME_ARENA_INITIAL_BYTES = 1u << 20;
+
+		// Upper bound on deferred contexts used for pass recording in one frame.
+		static constexpr uint32 MAX_RECORD_COMMAND_LISTS = 8;
+
 		RendererCreateInfo m_CreateInfo = {};
 		RefCntAutoPtr<IRenderDevice> m_pDevice;
 		RefCntAutoPtr<IDeviceContext> m_pImmediateContext;
 		std::vector<RefCntAutoPtr<IDeviceContext>> m_pDeferredContexts;
 		RefCntAutoPtr<ISwapChain> m_pSwapChain;
 
+		// One worker per deferred context beyond the first; the render thread records the first one.
+		RefCntAutoPtr<IThreadPool> m_pRecordThreadPool;
+		std::vector<RefCntAutoPtr<ICommandList>> m_RecordCommandLists;
+		std::vector<RefCntAutoPtr<IAsyncTask>> m_RecordTasks;
+
+		// CPU copies so deferred contexts can map their own dynamic allocation.
+		hlsl::FrameConstants m_FrameConstants = {};
+		hlsl::ShadowConstants m_ShadowConstants = {};
+
 		AssetManager* m_pAssetManager = nullptr;
 		std::unordered_map<std::string, MaterialTemplate> m_TemplateLibrary = {};
 
 		uint32 m_Width = 0;
 		uint32 m_Height = 0;
 
+		// m_pShaderSourceFactory is m_ShaderSources' caching wrapper around RendererCreateInfo::pShaderSourceFactory.
+		ShaderPreprocessCache m_ShaderSources;
 		RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pShaderSourceFactory;
+
+		// Declared before the caches that point to it. m_pRenderStates is the archive in
+		// use: m_RenderStates once loaded, RendererCreateInfo::pCookArchive, or null.
+		RenderStateArchive m_RenderStates;
+		RenderStateArchive* m_pRenderStates = nullptr;
+		ShaderBytecodeCache m_ShaderCache;
 		std::unique_ptr<PipelineStateManager> m_pPipelineStateManager;
 
 		RenderResourceCache<TextureRenderData> m_TextureCache;
 		RenderResourceCache<StaticMeshRenderData> m_StaticMeshCache;
 		RenderResourceCache<MaterialRenderData> m_MaterialCache;
+		std::unordered_map<MaterialKey, MaterialRenderData> m_ContentMaterials;
+		MaterialConstantPool m_MaterialConstants;
+		MaterialRenderDataStats m_MaterialRenderDataStats = {};
 
 		std::unique_ptr<RenderResourceRegistry> m_pRegistry;
 
@@ -160,5 +364,37 @@ namespace shz
 		std::unordered_map<std::string, std::unique_ptr<RenderPassBase>> m_Passes;
 		std::unordered_map<std::string, IRenderPass*> m_RHIRenderPasses;
 		std::vector<std::string> m_PassOrder;
+
+		RenderScene::ClusterCullStats m_ClusterCullStats = {};
+		BarrierBatchStats m_BarrierStats = {};
+		std::vector<PassRecordTiming> m_PassRecordTimings;
+		ParallelRecordStats m_ParallelRecordStats = {};
+		ShaderStartupStats m_ShaderStartupStats = {};
+
+		// ---------------------------------------------------------------------
+		// Shader hot reload (RendererCreateInfo::ShaderHotReloadDirectory)
+		// - m_MaterialSources keeps the Material each MaterialRenderData was
+		//   built from, so it can be rebuilt against a reloaded template.
+		//   Keyed by address: cache and content map entries never move.
+		// - A template is reinitialized into m_PendingTemplates and moved over
+		//   the library entry once it compiled; the library node (and every
+		//   Material referencing it) stays in place.
+		// ---------------------------------------------------------------------
+		struct PendingTemplateReload final
+		{
+			std::string Name = {};
+			MaterialTemplate Template = {};
+		};
+
+		bool m_bShaderHotReload = false;
+		void* m_pShaderWatch = nullptr;
+		std::unordered_map<MaterialRenderData*, Material> m_MaterialSources;
+		std::vector<PendingTemplateReload> m_PendingTemplates;
+		std::vector<RenderPassBase*> m_PendingPasses;
+		Timer m_ShaderReloadTimer;
+		ShaderReloadStats m_ShaderReloadStats = {};
+
+		FrameArena m_FrameArena;
+		uint64 m_LastFrameHeapAllocations = 0;
 	};
 } // namespace shz
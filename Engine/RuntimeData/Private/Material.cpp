@@ -1,6 +1,8 @@
 #include "pch.h"
 #include "Engine/RuntimeData/Public/Material.h"
 
+#include "Engine/Core/Common/Public/ByteKeyWriter.hpp"
+
 namespace shz
 {
 	Material::Material(const std::string& name, const std::string& templateName)
@@ -37,6 +39,12 @@ namespace shz
 		rebuildAutoResourceLayout();
 	}
 
+	void Material::SetName(const std::string& name)
+	{
+		m_Name = name;
+		syncDescFromOptions(); // PSO name points into m_Name
+	}
+
 	void Material::SetRenderPassName(const std::string& name)
 	{
 		m_RenderPassName = name;
@@ -193,27 +201,88 @@ namespace shz
 		*outResources = m_SnapshotResources;
 	}
 
+	MaterialKey Material::BuildKey() const
+	{
+		MaterialKey key = {};
+		ByteKeyWriter writer{ key.Bytes };
+
+		writer(
+			m_TemplateName,
+			m_RenderPassName,
+			m_Options.BlendMode,
+			m_Options.CullMode,
+			m_Options.FrontCounterClockwise,
+			m_Options.DepthEnable,
+			m_Options.DepthWriteEnable,
+			m_Options.DepthFunc,
+			m_Options.TextureBindingMode,
+			m_Options.LinearWrapSamplerName,
+			m_Options.LinearWrapSamplerDesc);
+
+		writer(static_cast<uint32>(m_CBufferBlobs.size()));
+		for (const std::vector<uint8>& blob : m_CBufferBlobs)
+		{
+			writer(static_cast<uint32>(blob.size()));
+			writer.UpdateRaw(blob.data(), blob.size());
+		}
+
+		writer(static_cast<uint32>(m_TextureBindings.size()));
+		for (const MaterialTextureBinding& binding : m_TextureBindings)
+		{
+			const AssetID textureID = binding.TextureRef.has_value() ? binding.TextureRef->GetID() : AssetID{};
+			writer(textureID.Hi, textureID.Lo, reinterpret_cast<uint64>(binding.pSamplerOverride), binding.bHasSamplerOverride);
+
+			if (binding.bHasSamplerOverride)
+			{
+				writer(binding.SamplerOverrideDesc);
+			}
+		}
+
+		XXH128State hasher;
+		hasher.UpdateRaw(key.Bytes.data(), key.Bytes.size());
+		key.Hash = hasher.Digest();
+		return key;
+	}
+
 	bool Material::writeValueImmediate(const char* name, const void* pData, uint32 byteSize, MATERIAL_VALUE_TYPE expectedType)
 	{
 		ASSERT(name && name[0] != '\0', "Invalid name.");
+
+		const MaterialValueParamId id = m_Template.FindValueParamId(name);
+		if (!id.IsValid())
+		{
+			return false;
+		}
+
+		return writeValue(id, pData, byteSize, expectedType);
+	}
+
+	bool Material::writeValue(const MaterialValueParamId& id, const void* pData, uint32 byteSize, MATERIAL_VALUE_TYPE expectedType)
+	{
 		ASSERT(pData, "pData is null.");
 
-		MaterialValueParamDesc desc = {};
-		if (!m_Template.ValidateSetValue(name, expectedType, &desc))
+		if (!id.IsValid())
 		{
 			return false;
 		}
 
-		ASSERT(desc.CBufferIndex < static_cast<uint32>(m_CBufferBlobs.size()), "Out of bounds.");
+		if (expectedType != MATERIAL_VALUE_TYPE_UNKNOWN && id.Type != expectedType)
+		{
+			return false;
+		}
+
+		ASSERT(id.Index < m_Template.GetValueParamCount() && m_Template.GetValueParam(id.Index).ByteOffset == id.ByteOffset,
+			"Value param id does not belong to the template of material '", m_Name, "'.");
+		ASSERT(id.CBufferIndex < static_cast<uint32>(m_CBufferBlobs.size()), "Out of bounds.");
 		ASSERT(byteSize > 0, "Byte size must be > 0.");
-		ASSERT(byteSize <= desc.ByteSize, "Byte size must be <= variable size (%u).", desc.ByteSize);
+		ASSERT(byteSize <= id.ByteSize, "Byte size must be <= variable size (%u).", id.ByteSize);
 
-		std::vector<uint8>& blob = m_CBufferBlobs[desc.CBufferIndex];
-		const uint32 endOffset = desc.ByteOffset + byteSize;
+		std::vector<uint8>& blob = m_CBufferBlobs[id.CBufferIndex];
+		const uint32 endOffset = id.ByteOffset + byteSize;
 
 		ASSERT(endOffset <= static_cast<uint32>(blob.size()), "Out of bounds.");
 
-		std::memcpy(blob.data() + desc.ByteOffset, pData, byteSize);
+		std::memcpy(blob.data() + id.ByteOffset, pData, byteSize);
 
 		m_bSnapshotDirty = 1;
 		return true;
@@ -305,6 +374,100 @@ namespace shz
 		return writeValueImmediate(name, pData, byteSize, type);
 	}
 
+	bool Material::SetFloat(const MaterialValueParamId& id, float v)
+	{
+		return writeValue(id, &v, sizeof(v), MATERIAL_VALUE_TYPE_FLOAT);
+	}
+
+	bool Material::SetFloat2(const MaterialValueParamId& id, const float2& v)
+	{
+		return writeValue(id, &v, sizeof(float) * 2, MATERIAL_VALUE_TYPE_FLOAT2);
+	}
+
+	bool Material::SetFloat3(const MaterialValueParamId& id, const float3& v)
+	{
+		return writeValue(id, &v, sizeof(float) * 3, MATERIAL_VALUE_TYPE_FLOAT3);
+	}
+
+	bool Material::SetFloat4(const MaterialValueParamId& id, const float4& v)
+	{
+		return writeValue(id, &v, sizeof(float) * 4, MATERIAL_VALUE_TYPE_FLOAT4);
+	}
+
+	bool Material::SetInt(const MaterialValueParamId& id, int32 v)
+	{
+		return writeValue(id, &v, sizeof(v), MATERIAL_VALUE_TYPE_INT);
+	}
+
+	bool Material::SetInt2(const MaterialValueParamId& id, const int32 v[2])
+	{
+		return writeValue(id, v, sizeof(int32) * 2, MATERIAL_VALUE_TYPE_INT2);
+	}
+
+	bool Material::SetInt3(const MaterialValueParamId& id, const int32 v[3])
+	{
+		return writeValue(id, v, sizeof(int32) * 3, MATERIAL_VALUE_TYPE_INT3);
+	}
+
+	bool Material::SetInt4(const MaterialValueParamId& id, const int32 v[4])
+	{
+		return writeValue(id, v, sizeof(int32) * 4, MATERIAL_VALUE_TYPE_INT4);
+	}
+
+	bool Material::SetUint(const MaterialValueParamId& id, uint32 v)
+	{
+		return writeValue(id, &v, sizeof(v), MATERIAL_VALUE_TYPE_UINT);
+	}
+
+	bool Material::SetUint2(const MaterialValueParamId& id, const uint32 v[2])
+	{
+		return writeValue(id, v, sizeof(uint32) * 2, MATERIAL_VALUE_TYPE_UINT2);
+	}
+
+	bool Material::SetUint3(const MaterialValueParamId& id, const uint32 v[3])
+	{
+		return writeValue(id, v, sizeof(uint32) * 3, MATERIAL_VALUE_TYPE_UINT3);
+	}
+
+	bool Material::SetUint4(const MaterialValueParamId& id, const uint32 v[4])
+	{
+		return writeValue(id, v, sizeof(uint32) * 4, MATERIAL_VALUE_TYPE_UINT4);
+	}
+
+	bool Material::SetFloat4x4(const MaterialValueParamId& id, const float m16[16])
+	{
+		return writeValue(id, m16, sizeof(float) * 16, MATERIAL_VALUE_TYPE_FLOAT4X4);
+	}
+
+	bool Material::SetRaw(const MaterialValueParamId& id, const void* pData, uint32 byteSize)
+	{
+		return writeValue(id, pData, byteSize, MATERIAL_VALUE_TYPE_UNKNOWN);
+	}
+
+	bool Material::SetCBufferBlob(uint32 cbufferIndex, const void* pData, uint32 byteSize)
+	{
+		ASSERT(pData || byteSize == 0, "pData is null.");
+
+		if (cbufferIndex >= static_cast<uint32>(m_CBufferBlobs.size()))
+		{
+			return false;
+		}
+
+		std::vector<uint8>& blob = m_CBufferBlobs[cbufferIndex];
+		if (byteSize != static_cast<uint32>(blob.size()))
+		{
+			return false;
+		}
+
+		if (byteSize > 0)
+		{
+			std::memcpy(blob.data(), pData, byteSize);
+		}
+
+		m_bSnapshotDirty = 1;
+		return true;
+	}
+
 	bool Material::setTextureImmediate(const char* name, MATERIAL_RESOURCE_TYPE expectedType, const AssetRef<Texture>& texRef)
 	{
 		ASSERT(name && name[0] != '\0', "Invalid name.");
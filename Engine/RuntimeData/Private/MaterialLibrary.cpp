@@ -0,0 +1,648 @@
+#include "pch.h"
+#include "Engine/RuntimeData/Public/MaterialLibrary.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+#include "Primitives/Align.hpp"
+#include "Engine/Core/Common/Public/ByteKeyWriter.hpp"
+#include "Engine/AssetManager/Public/AssetManager.h"
+#include "Engine/AssetManager/Public/AssetTypeTraits.h"
+#include "Engine/RuntimeData/Public/Texture.h"
+
+namespace shz
+{
+	namespace
+	{
+		constexpr uint32 BLOB_ALIGNMENT = 16;
+
+		// SamplerDesc without its name pointer.
+		struct PackedSampler final
+		{
+			uint8 MinFilter = 0;
+			uint8 MagFilter = 0;
+			uint8 MipFilter = 0;
+			uint8 AddressU = 0;
+			uint8 AddressV = 0;
+			uint8 AddressW = 0;
+			uint8 Flags = 0;
+			uint8 UnnormalizedCoords = 0;
+			float MipLODBias = 0.f;
+			uint32 MaxAnisotropy = 0;
+			uint32 ComparisonFunc = 0;
+			float BorderColor[4] = {};
+			float MinLOD = 0.f;
+			float MaxLOD = 0.f;
+		};
+
+		struct FileHeader final
+		{
+			uint32 Magic = MaterialLibrary::MAGIC;
+			uint32 Version = MaterialLibrary::VERSION;
+
+			uint32 MaterialCount = 0;
+			uint32 CBufferCount = 0;
+			uint32 ResourceCount = 0;
+			uint32 StringTableSize = 0;
+			uint32 BlobSize = 0;
+			uint32 Reserved = 0;
+		};
+
+		static_assert(sizeof(FileHeader) % BLOB_ALIGNMENT == 0, "Records after the header must stay aligned.");
+
+		// String fields are byte offsets into the string table.
+		struct MaterialRecord final
+		{
+			uint64 IdHi = 0;
+			uint64 IdLo = 0;
+
+			uint32 Name = 0;
+			uint32 TemplateName = 0;
+			uint32 RenderPassName = 0;
+			uint32 LinearWrapSamplerName = 0;
+
+			uint8 BlendMode = 0;
+			uint8 CullMode = 0;
+			uint8 FrontCounterClockwise = 0;
+			uint8 DepthEnable = 0;
+			uint8 DepthWriteEnable = 0;
+			uint8 DepthFunc = 0;
+			uint8 TextureBindingMode = 0;
+			uint8 Padding = 0;
+
+			PackedSampler LinearWrapSampler = {};
+
+			uint32 FirstCBuffer = 0;
+			uint32 CBufferCount = 0;
+			uint32 FirstResource = 0;
+			uint32 ResourceCount = 0;
+		};
+
+		struct CBufferRecord final
+		{
+			uint32 BlobOffset = 0;
+			uint32 ByteSize = 0;
+		};
+
+		struct ResourceRecord final
+		{
+			uint32 Name = 0;
+			uint32 TexturePath = 0;
+			uint32 Type = 0;
+			uint32 bHasSamplerOverride = 0;
+			PackedSampler SamplerOverride = {};
+		};
+
+		PackedSampler packSampler(const SamplerDesc& d)
+		{
+			PackedSampler p = {};
+			p.MinFilter = static_cast<uint8>(d.MinFilter);
+			p.MagFilter = static_cast<uint8>(d.MagFilter);
+			p.MipFilter = static_cast<uint8>(d.MipFilter);
+			p.AddressU = static_cast<uint8>(d.AddressU);
+			p.AddressV = static_cast<uint8>(d.AddressV);
+			p.AddressW = static_cast<uint8>(d.AddressW);
+			p.Flags = static_cast<uint8>(d.Flags);
+			p.UnnormalizedCoords = d.UnnormalizedCoords ? 1 : 0;
+			p.MipLODBias = d.MipLODBias;
+			p.MaxAnisotropy = d.MaxAnisotropy;
+			p.ComparisonFunc = static_cast<uint32>(d.ComparisonFunc);
+			std::memcpy(p.BorderColor, d.BorderColor, sizeof(p.BorderColor));
+			p.MinLOD = d.MinLOD;
+			p.MaxLOD = d.MaxLOD;
+			return p;
+		}
+
+		SamplerDesc unpackSampler(const PackedSampler& p)
+		{
+			SamplerDesc d = {};
+			d.MinFilter = static_cast<FILTER_TYPE>(p.MinFilter);
+			d.MagFilter = static_cast<FILTER_TYPE>(p.MagFilter);
+			d.MipFilter = static_cast<FILTER_TYPE>(p.MipFilter);
+			d.AddressU = static_cast<TEXTURE_ADDRESS_MODE>(p.AddressU);
+			d.AddressV = static_cast<TEXTURE_ADDRESS_MODE>(p.AddressV);
+			d.AddressW = static_cast<TEXTURE_ADDRESS_MODE>(p.AddressW);
+			d.Flags = static_cast<SAMPLER_FLAGS>(p.Flags);
+			d.UnnormalizedCoords = p.UnnormalizedCoords != 0;
+			d.MipLODBias = p.MipLODBias;
+			d.MaxAnisotropy = p.MaxAnisotropy;
+			d.ComparisonFunc = static_cast<COMPARISON_FUNCTION>(p.ComparisonFunc);
+			std::memcpy(d.BorderColor, p.BorderColor, sizeof(p.BorderColor));
+			d.MinLOD = p.MinLOD;
+			d.MaxLOD = p.MaxLOD;
+			return d;
+		}
+
+		// Deduplicated string table; offset 0 is the empty string.
+		class StringTableBuilder final
+		{
+		public:
+			StringTableBuilder() { m_Data.push_back('\0'); }
+
+			uint32 Add(const std::string& s)
+			{
+				if (s.empty())
+				{
+					return 0;
+				}
+
+				auto it = m_Offsets.find(s);
+				if (it != m_Offsets.end())
+				{
+					return it->second;
+				}
+
+				const uint32 offset = static_cast<uint32>(m_Data.size());
+				m_Data.insert(m_Data.end(), s.begin(), s.end());
+				m_Data.push_back('\0');
+				m_Offsets.emplace(s, offset);
+				return offset;
+			}
+
+			const std::vector<char>& GetData() const noexcept { return m_Data; }
+
+		private:
+			std::vector<char> m_Data;
+			std::unordered_map<std::string, uint32> m_Offsets;
+		};
+
+		inline void setErr(std::string* out, const std::string& s)
+		{
+			if (out) *out = s;
+		}
+
+		template <typename T>
+		void writeArray(std::ofstream& out, const std::vector<T>& v)
+		{
+			if (!v.empty())
+			{
+				out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+			}
+		}
+
+		AssetID makeID(uint64 hi, uint64 lo)
+		{
+			AssetID id = {};
+			id.Hi = hi;
+			id.Lo = lo;
+			return id;
+		}
+
+		// A validated library file; the pointers view into Bytes.
+		struct LibraryImage final
+		{
+			std::vector<uint8> Bytes;
+			FileHeader Header = {};
+
+			const char* pStrings = nullptr;
+			const MaterialRecord* pMaterials = nullptr;
+			const CBufferRecord* pCBuffers = nullptr;
+			const ResourceRecord* pResources = nullptr;
+			const uint8* pBlobs = nullptr;
+
+			// The table is checked to end in NUL, so a valid offset always finds a terminator.
+			const char* Str(uint32 offset) const noexcept
+			{
+				return (offset < Header.StringTableSize) ? pStrings + offset : "";
+			}
+
+			bool IsInRange(const MaterialRecord& rec) const noexcept
+			{
+				return uint64{ rec.FirstCBuffer } + rec.CBufferCount <= Header.CBufferCount
+					&& uint64{ rec.FirstResource } + rec.ResourceCount <= Header.ResourceCount;
+			}
+		};
+
+		bool readLibrary(const std::string& path, LibraryImage& image, std::string* pOutError)
+		{
+			std::ifstream in(path, std::ios::binary | std::ios::ate);
+			if (!in.is_open())
+			{
+				setErr(pOutError, "MaterialLibrary: failed to open '" + path + "'.");
+				return false;
+			}
+
+			const uint64 fileSize = static_cast<uint64>(in.tellg());
+			image.Bytes.resize(static_cast<size_t>(fileSize));
+			in.seekg(0, std::ios::beg);
+			in.read(reinterpret_cast<char*>(image.Bytes.data()), static_cast<std::streamsize>(fileSize));
+			if (!in.good())
+			{
+				setErr(pOutError, "MaterialLibrary: failed to read '" + path + "'.");
+				return false;
+			}
+
+			FileHeader& header = image.Header;
+			if (fileSize < sizeof(header))
+			{
+				setErr(pOutError, "MaterialLibrary: '" + path + "' is truncated.");
+				return false;
+			}
+			std::memcpy(&header, image.Bytes.data(), sizeof(header));
+
+			if (header.Magic != MaterialLibrary::MAGIC || header.Version != MaterialLibrary::VERSION)
+			{
+				setErr(pOutError, "MaterialLibrary: '" + path + "' has an invalid format/version.");
+				return false;
+			}
+
+			const uint64 stringsOffset = sizeof(header);
+			const uint64 materialsOffset = stringsOffset + header.StringTableSize;
+			const uint64 cbuffersOffset = materialsOffset + uint64{ header.MaterialCount } * sizeof(MaterialRecord);
+			const uint64 resourcesOffset = cbuffersOffset + uint64{ header.CBufferCount } * sizeof(CBufferRecord);
+			const uint64 blobOffset = AlignUp(resourcesOffset + uint64{ header.ResourceCount } * sizeof(ResourceRecord), uint64{ BLOB_ALIGNMENT });
+
+			if (header.StringTableSize == 0 || blobOffset + header.BlobSize > fileSize)
+			{
+				setErr(pOutError, "MaterialLibrary: '" + path + "' is truncated.");
+				return false;
+			}
+
+			const uint8* pData = image.Bytes.data();
+			image.pStrings = reinterpret_cast<const char*>(pData + stringsOffset);
+			image.pMaterials = reinterpret_cast<const MaterialRecord*>(pData + materialsOffset);
+			image.pCBuffers = reinterpret_cast<const CBufferRecord*>(pData + cbuffersOffset);
+			image.pResources = reinterpret_cast<const ResourceRecord*>(pData + resourcesOffset);
+			image.pBlobs = pData + blobOffset;
+
+			if (image.pStrings[header.StringTableSize - 1] != '\0')
+			{
+				setErr(pOutError, "MaterialLibrary: '" + path + "' has a string table that is not NUL-terminated.");
+				return false;
+			}
+			return true;
+		}
+
+		// Collects records for a new file. Strings and materials are deduplicated
+		// (materials by id, which MakeMaterialID derives from their content).
+		class LibraryBuilder final
+		{
+		public:
+			bool Contains(const AssetID& id) const { return m_IDs.count(id) != 0; }
+
+			// Copies a record of an existing library, remapping its strings and blobs.
+			bool AddRecord(const LibraryImage& image, const MaterialRecord& src)
+			{
+				const AssetID id = makeID(src.IdHi, src.IdLo);
+				if (!m_IDs.insert(id).second)
+				{
+					return true;
+				}
+
+				MaterialRecord rec = src;
+				rec.Name = m_Strings.Add(image.Str(src.Name));
+				rec.TemplateName = m_Strings.Add(image.Str(src.TemplateName));
+				rec.RenderPassName = m_Strings.Add(image.Str(src.RenderPassName));
+				rec.LinearWrapSamplerName = m_Strings.Add(image.Str(src.LinearWrapSamplerName));
+
+				rec.FirstCBuffer = static_cast<uint32>(m_CBuffers.size());
+				for (uint32 cb = 0; cb < src.CBufferCount; ++cb)
+				{
+					const CBufferRecord& cbRec = image.pCBuffers[src.FirstCBuffer + cb];
+					if (uint64{ cbRec.BlobOffset } + cbRec.ByteSize > image.Header.BlobSize)
+					{
+						return false;
+					}
+					addBlob(image.pBlobs + cbRec.BlobOffset, cbRec.ByteSize);
+				}
+
+				rec.FirstResource = static_cast<uint32>(m_Resources.size());
+				for (uint32 r = 0; r < src.ResourceCount; ++r)
+				{
+					ResourceRecord resRec = image.pResources[src.FirstResource + r];
+					resRec.Name = m_Strings.Add(image.Str(resRec.Name));
+					resRec.TexturePath = m_Strings.Add(image.Str(resRec.TexturePath));
+					m_Resources.push_back(resRec);
+				}
+
+				m_Materials.push_back(rec);
+				return true;
+			}
+
+			void AddMaterial(const Material& mat, const AssetID& id)
+			{
+				if (!m_IDs.insert(id).second)
+				{
+					return;
+				}
+
+				MaterialRecord rec = {};
+				rec.IdHi = id.Hi;
+				rec.IdLo = id.Lo;
+				rec.Name = m_Strings.Add(mat.GetName());
+				rec.TemplateName = m_Strings.Add(mat.GetTemplateName());
+				rec.RenderPassName = m_Strings.Add(mat.GetRenderPassName());
+				rec.LinearWrapSamplerName = m_Strings.Add(mat.GetLinearWrapSamplerName());
+
+				rec.BlendMode = static_cast<uint8>(mat.GetBlendMode());
+				rec.CullMode = static_cast<uint8>(mat.GetCullMode());
+				rec.FrontCounterClockwise = mat.GetFrontCounterClockwise() ? 1 : 0;
+				rec.DepthEnable = mat.GetDepthEnable() ? 1 : 0;
+				rec.DepthWriteEnable = mat.GetDepthWriteEnable() ? 1 : 0;
+				rec.DepthFunc = static_cast<uint8>(mat.GetDepthFunc());
+				rec.TextureBindingMode = static_cast<uint8>(mat.GetTextureBindingMode());
+				rec.LinearWrapSampler = packSampler(mat.GetLinearWrapSamplerDesc());
+
+				rec.FirstCBuffer = static_cast<uint32>(m_CBuffers.size());
+				rec.CBufferCount = mat.GetCBufferBlobCount();
+				for (uint32 cb = 0; cb < rec.CBufferCount; ++cb)
+				{
+					addBlob(mat.GetCBufferBlobData(cb), mat.GetCBufferBlobSize(cb));
+				}
+
+				rec.FirstResource = static_cast<uint32>(m_Resources.size());
+				for (uint32 r = 0; r < mat.GetResourceBindingCount(); ++r)
+				{
+					const MaterialSerializedResource& res = mat.GetResourceBinding(r);
+
+					ResourceRecord resRec = {};
+					resRec.Name = m_Strings.Add(res.Name);
+					resRec.TexturePath = m_Strings.Add(res.TextureRef.GetID().SourcePath);
+					resRec.Type = static_cast<uint32>(res.Type);
+					resRec.bHasSamplerOverride = res.bHasSamplerOverride ? 1 : 0;
+					if (res.bHasSamplerOverride)
+					{
+						resRec.SamplerOverride = packSampler(res.SamplerOverrideDesc);
+					}
+					m_Resources.push_back(resRec);
+				}
+				rec.ResourceCount = static_cast<uint32>(m_Resources.size()) - rec.FirstResource;
+
+				m_Materials.push_back(rec);
+			}
+
+			bool Save(const std::string& path, std::string* pOutError) const
+			{
+				FileHeader header = {};
+				header.MaterialCount = static_cast<uint32>(m_Materials.size());
+				header.CBufferCount = static_cast<uint32>(m_CBuffers.size());
+				header.ResourceCount = static_cast<uint32>(m_Resources.size());
+				header.StringTableSize = AlignUp(static_cast<uint32>(m_Strings.GetData().size()), BLOB_ALIGNMENT);
+				header.BlobSize = static_cast<uint32>(m_Blobs.size());
+
+				std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+				// The file may hold other meshes' materials: write a copy and swap it in.
+				const std::string tempPath = path + ".tmp";
+				{
+					std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+					if (!out.is_open())
+					{
+						setErr(pOutError, "MaterialLibrary: failed to open '" + tempPath + "' for writing.");
+						return false;
+					}
+
+					std::vector<char> stringTable = m_Strings.GetData();
+					stringTable.resize(header.StringTableSize, '\0');
+
+					// The header and string table are 16-byte multiples, so every record array keeps
+					// its natural alignment; the blob area is padded to BLOB_ALIGNMENT explicitly.
+					out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+					writeArray(out, stringTable);
+					writeArray(out, m_Materials);
+					writeArray(out, m_CBuffers);
+					writeArray(out, m_Resources);
+
+					const uint64 recordBytes = sizeof(header) + stringTable.size() + m_Materials.size() * sizeof(MaterialRecord)
+						+ m_CBuffers.size() * sizeof(CBufferRecord) + m_Resources.size() * sizeof(ResourceRecord);
+					const std::vector<char> blobPadding(AlignUp(recordBytes, uint64{ BLOB_ALIGNMENT }) - recordBytes, '\0');
+					writeArray(out, blobPadding);
+					writeArray(out, m_Blobs);
+
+					if (!out.good())
+					{
+						setErr(pOutError, "MaterialLibrary: failed to write '" + tempPath + "'.");
+						return false;
+					}
+				}
+
+				std::error_code ec;
+				std::filesystem::rename(tempPath, path, ec);
+				if (ec)
+				{
+					setErr(pOutError, "MaterialLibrary: failed to replace '" + path + "': " + ec.message());
+					return false;
+				}
+				return true;
+			}
+
+		private:
+			void addBlob(const void* pData, uint32 size)
+			{
+				CBufferRecord cbRec = {};
+				cbRec.BlobOffset = AlignUp(static_cast<uint32>(m_Blobs.size()), BLOB_ALIGNMENT);
+				cbRec.ByteSize = size;
+
+				m_Blobs.resize(cbRec.BlobOffset + size, 0);
+				if (size > 0)
+				{
+					std::memcpy(m_Blobs.data() + cbRec.BlobOffset, pData, size);
+				}
+				m_CBuffers.push_back(cbRec);
+			}
+
+		private:
+			StringTableBuilder m_Strings;
+			std::vector<MaterialRecord> m_Materials;
+			std::vector<CBufferRecord> m_CBuffers;
+			std::vector<ResourceRecord> m_Resources;
+			std::vector<uint8> m_Blobs;
+			std::unordered_set<AssetID> m_IDs;
+		};
+	} // namespace
+
+	AssetID MaterialLibrary::MakeMaterialID(const Material& material)
+	{
+		// Everything the library stores except the name, so renamed copies share one entry.
+		std::vector<uint8> bytes;
+		ByteKeyWriter writer{ bytes };
+
+		writer(
+			AssetTypeTraits<Material>::TypeID,
+			material.GetTemplateName(),
+			material.GetRenderPassName(),
+			material.GetBlendMode(),
+			material.GetCullMode(),
+			material.GetFrontCounterClockwise(),
+			material.GetDepthEnable(),
+			material.GetDepthWriteEnable(),
+			material.GetDepthFunc(),
+			material.GetTextureBindingMode(),
+			material.GetLinearWrapSamplerName(),
+			material.GetLinearWrapSamplerDesc());
+
+		writer(material.GetCBufferBlobCount());
+		for (uint32 cb = 0; cb < material.GetCBufferBlobCount(); ++cb)
+		{
+			const uint32 size = material.GetCBufferBlobSize(cb);
+			writer(size);
+			writer.UpdateRaw(material.GetCBufferBlobData(cb), size);
+		}
+
+		writer(material.GetResourceBindingCount());
+		for (uint32 r = 0; r < material.GetResourceBindingCount(); ++r)
+		{
+			const MaterialSerializedResource& res = material.GetResourceBinding(r);
+			writer(res.Name, res.TextureRef.GetID().SourcePath, res.Type, res.bHasSamplerOverride);
+			if (res.bHasSamplerOverride)
+			{
+				writer(res.SamplerOverrideDesc);
+			}
+		}
+
+		XXH128State hasher;
+		hasher.UpdateRaw(bytes.data(), bytes.size());
+		const XXH128Hash hash = hasher.Digest();
+		return makeID(hash.HighPart, hash.LowPart);
+	}
+
+	bool MaterialLibrary::Append(const std::string& path, const std::vector<const Material*>& materials, std::vector<AssetID>* pOutIDs, std::string* pOutError)
+	{
+		if (path.empty())
+		{
+			setErr(pOutError, "MaterialLibrary: path is empty.");
+			return false;
+		}
+
+		LibraryBuilder builder;
+
+		// Keep what is already there. A library that fails to read is not overwritten.
+		if (std::filesystem::exists(path))
+		{
+			LibraryImage image;
+			if (!readLibrary(path, image, pOutError))
+			{
+				return false;
+			}
+
+			for (uint32 i = 0; i < image.Header.MaterialCount; ++i)
+			{
+				const MaterialRecord& rec = image.pMaterials[i];
+				if (!image.IsInRange(rec) || !builder.AddRecord(image, rec))
+				{
+					setErr(pOutError, "MaterialLibrary: '" + path + "' has out of range records.");
+					return false;
+				}
+			}
+		}
+
+		if (pOutIDs)
+		{
+			pOutIDs->clear();
+			pOutIDs->reserve(materials.size());
+		}
+
+		for (const Material* pMat : materials)
+		{
+			if (!pMat)
+			{
+				setErr(pOutError, "MaterialLibrary: material is null.");
+				return false;
+			}
+
+			const AssetID id = MakeMaterialID(*pMat);
+			builder.AddMaterial(*pMat, id);
+
+			if (pOutIDs)
+			{
+				pOutIDs->push_back(id);
+			}
+		}
+
+		return builder.Save(path, pOutError);
+	}
+
+	bool MaterialLibrary::Load(AssetManager& assetManager, const std::string& path, std::string* pOutError)
+	{
+		m_Materials.clear();
+		m_MaterialIDs.clear();
+		m_IndexByID.clear();
+		m_FileBytes = 0;
+
+		LibraryImage image;
+		if (!readLibrary(path, image, pOutError))
+		{
+			return false;
+		}
+
+		const FileHeader& header = image.Header;
+		m_Materials.reserve(header.MaterialCount);
+		m_MaterialIDs.reserve(header.MaterialCount);
+		m_IndexByID.reserve(header.MaterialCount);
+
+		for (uint32 i = 0; i < header.MaterialCount; ++i)
+		{
+			const MaterialRecord& rec = image.pMaterials[i];
+
+			if (!image.IsInRange(rec))
+			{
+				setErr(pOutError, "MaterialLibrary: '" + path + "' has out of range records.");
+				m_Materials.clear();
+				m_MaterialIDs.clear();
+				m_IndexByID.clear();
+				return false;
+			}
+
+			Material m(image.Str(rec.Name), image.Str(rec.TemplateName));
+			m.SetRenderPassName(image.Str(rec.RenderPassName));
+
+			m.SetBlendMode(static_cast<MATERIAL_BLEND_MODE>(rec.BlendMode));
+			m.SetCullMode(static_cast<CULL_MODE>(rec.CullMode));
+			m.SetFrontCounterClockwise(rec.FrontCounterClockwise != 0);
+			m.SetDepthEnable(rec.DepthEnable != 0);
+			m.SetDepthWriteEnable(rec.DepthWriteEnable != 0);
+			m.SetDepthFunc(static_cast<COMPARISON_FUNCTION>(rec.DepthFunc));
+			m.SetTextureBindingMode(static_cast<MATERIAL_TEXTURE_BINDING_MODE>(rec.TextureBindingMode));
+			m.SetLinearWrapSamplerName(image.Str(rec.LinearWrapSamplerName));
+			m.SetLinearWrapSamplerDesc(unpackSampler(rec.LinearWrapSampler));
+
+			for (uint32 cb = 0; cb < rec.CBufferCount; ++cb)
+			{
+				const CBufferRecord& cbRec = image.pCBuffers[rec.FirstCBuffer + cb];
+				if (uint64{ cbRec.BlobOffset } + cbRec.ByteSize > header.BlobSize
+					|| !m.SetCBufferBlob(cb, image.pBlobs + cbRec.BlobOffset, cbRec.ByteSize))
+				{
+					LOG_WARNING_MESSAGE("MaterialLibrary: constants of material '", m.GetName(), "' in '", path,
+						"' do not match template '", m.GetTemplateName(), "'; using the template defaults.");
+				}
+			}
+
+			for (uint32 r = 0; r < rec.ResourceCount; ++r)
+			{
+				const ResourceRecord& resRec = image.pResources[rec.FirstResource + r];
+				const char* name = image.Str(resRec.Name);
+				if (name[0] == '\0')
+				{
+					continue;
+				}
+
+				const char* texturePath = image.Str(resRec.TexturePath);
+				if (texturePath[0] != '\0')
+				{
+					m.SetTextureAssetRef(name, static_cast<MATERIAL_RESOURCE_TYPE>(resRec.Type), assetManager.RegisterAsset<Texture>(texturePath));
+				}
+
+				if (resRec.bHasSamplerOverride != 0)
+				{
+					m.SetSamplerOverrideDesc(name, unpackSampler(resRec.SamplerOverride));
+				}
+			}
+
+			const AssetID id = makeID(rec.IdHi, rec.IdLo);
+			m_IndexByID.emplace(id, static_cast<uint32>(m_Materials.size()));
+			m_Materials.push_back(std::move(m));
+			m_MaterialIDs.push_back(id);
+		}
+
+		m_FileBytes = image.Bytes.size();
+		return true;
+	}
+
+	const Material* MaterialLibrary::FindMaterial(const AssetID& id) const noexcept
+	{
+		auto it = m_IndexByID.find(id);
+		return (it != m_IndexByID.end()) ? &m_Materials[it->second] : nullptr;
+	}
+} // namespace shz
@@ -0,0 +1,34 @@
+#include "pch.h"
+#include "Engine/RuntimeData/Public/MaterialLibraryImporter.h"
+
+#include "Engine/AssetManager/Public/AssetManager.h"
+#include "Engine/RuntimeData/Public/MaterialLibrary.h"
+
+namespace shz
+{
+	std::unique_ptr<AssetObject> MaterialLibraryImporter::operator()(
+		AssetManager& assetManager,
+		const AssetMeta& meta,
+		uint64* pOutResidentBytes,
+		std::string* pOutError) const
+	{
+		ASSERT(pOutResidentBytes != nullptr, "pOutResidentBytes is null.");
+		*pOutResidentBytes = 0;
+		if (pOutError) pOutError->clear();
+
+		if (meta.SourcePath.empty())
+		{
+			if (pOutError) *pOutError = "MaterialLibraryImporter: meta.SourcePath is empty.";
+			return {};
+		}
+
+		MaterialLibrary library;
+		if (!library.Load(assetManager, meta.SourcePath, pOutError))
+		{
+			return {};
+		}
+
+		*pOutResidentBytes = library.GetFileBytes();
+		return std::make_unique<TypedAssetObject<MaterialLibrary>>(static_cast<MaterialLibrary&&>(library));
+	}
+}
@@ -163,7 +163,20 @@ namespace shz
 	// MaterialTemplate
 	// ------------------------------------------------------------
 
-	bool MaterialTemplate::Initialize(IRenderDevice* pDevice, IShaderSourceInputStreamFactory* pShaderSourceFactory, const MaterialTemplateCreateInfo& ci)
+	bool MaterialTemplate::Initialize(
+		IRenderDevice* pDevice,
+		IShaderSourceInputStreamFactory* pShaderSourceFactory,
+		const MaterialTemplateCreateInfo& ci,
+		ShaderBytecodeCache* pBytecodeCache)
+	{
+		return BeginInitialize(pDevice, pShaderSourceFactory, ci, pBytecodeCache) && EndInitialize();
+	}
+
+	bool MaterialTemplate::BeginInitialize(
+		IRenderDevice* pDevice,
+		IShaderSourceInputStreamFactory* pShaderSourceFactory,
+		const MaterialTemplateCreateInfo& ci,
+		ShaderBytecodeCache* pBytecodeCache)
 	{
 		ASSERT(pDevice, "Device is null.");
 		ASSERT(pShaderSourceFactory, "Shader source factory is null.");
@@ -211,12 +224,28 @@ namespace shz
 				sci.Desc.UseCombinedTextureSamplers = s.UseCombinedTextureSamplers;
 				sci.FilePath = s.FilePath.c_str();
 
+				std::vector<ShaderMacro> macros;
+				macros.reserve(s.Macros.size());
+				for (const MaterialShaderMacro& m : s.Macros)
+				{
+					macros.emplace_back(m.Name.c_str(), m.Definition.c_str());
+				}
+				sci.Macros = { macros.data(), static_cast<uint32>(macros.size()) };
+
 				RefCntAutoPtr<IShader> pShader;
-				pDevice->CreateShader(sci, &pShader);
+				if (pBytecodeCache)
+				{
+					pBytecodeCache->CreateShader(pDevice, sci, &pShader);
+				}
+				else
+				{
+					pDevice->CreateShader(sci, &pShader);
+				}
 
+				// Not an assert: with shader hot reload, a template is rebuilt from whatever is on disk.
 				if (!pShader)
 				{
-					ASSERT(false, "Failed to create shader: %s", s.FilePath.c_str());
+					LOG_ERROR_MESSAGE("Failed to create shader '", s.FilePath, "' of template '", m_Name, "'.");
 					return false;
 				}
 
@@ -224,6 +253,22 @@ namespace shz
 			}
 		}
 
+		return true;
+	}
+
+	bool MaterialTemplate::EndInitialize()
+	{
+		// Shaders created with SHADER_COMPILE_FLAG_ASYNCHRONOUS have no reflection until they finish.
+		for (const RefCntAutoPtr<IShader>& pShader : m_Shaders)
+		{
+			if (pShader->GetStatus(/*WaitForCompletion*/ true) != SHADER_STATUS_READY)
+			{
+				LOG_ERROR_MESSAGE("Failed to compile shader '", pShader->GetDesc().Name, "' of template '", m_Name, "'.");
+				m_Shaders.clear();
+				return false;
+			}
+		}
+
 		// Build shader reflection
 		{
 			m_ValueParamLut.clear();
@@ -391,6 +436,62 @@ namespace shz
 		return true;
 	}
 
+	bool MaterialTemplate::IsCompiling() const
+	{
+		for (const RefCntAutoPtr<IShader>& pShader : m_Shaders)
+		{
+			if (pShader->GetStatus() == SHADER_STATUS_COMPILING)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool MaterialTemplate::HasSameLayout(const MaterialTemplate& other) const
+	{
+		if (m_CBuffers.size() != other.m_CBuffers.size()
+			|| m_ValueParams.size() != other.m_ValueParams.size()
+			|| m_Resources.size() != other.m_Resources.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < m_CBuffers.size(); ++i)
+		{
+			const MaterialCBufferDesc& a = m_CBuffers[i];
+			const MaterialCBufferDesc& b = other.m_CBuffers[i];
+			if (a.Name != b.Name || a.ByteSize != b.ByteSize)
+			{
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < m_ValueParams.size(); ++i)
+		{
+			const MaterialValueParamDesc& a = m_ValueParams[i];
+			const MaterialValueParamDesc& b = other.m_ValueParams[i];
+			if (a.Name != b.Name || a.Type != b.Type || a.CBufferIndex != b.CBufferIndex
+				|| a.ByteOffset != b.ByteOffset || a.ByteSize != b.ByteSize)
+			{
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < m_Resources.size(); ++i)
+		{
+			const MaterialResourceDesc& a = m_Resources[i];
+			const MaterialResourceDesc& b = other.m_Resources[i];
+			if (a.Name != b.Name || a.Type != b.Type || a.ArraySize != b.ArraySize)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	const MaterialValueParamDesc* MaterialTemplate::FindValueParam(const char* name) const
 	{
 		ASSERT(name && name[0] != '\0', "Invalid name.");
@@ -421,6 +522,32 @@ namespace shz
 		return true;
 	}
 
+	MaterialValueParamId MaterialTemplate::GetValueParamId(uint32 index) const
+	{
+		ASSERT(index < static_cast<uint32>(m_ValueParams.size()), "Out of bounds.");
+
+		const MaterialValueParamDesc& desc = m_ValueParams[index];
+
+		MaterialValueParamId id = {};
+		id.Index = index;
+		id.Type = desc.Type;
+		id.CBufferIndex = desc.CBufferIndex;
+		id.ByteOffset = desc.ByteOffset;
+		id.ByteSize = desc.ByteSize;
+		return id;
+	}
+
+	MaterialValueParamId MaterialTemplate::FindValueParamId(const char* name) const
+	{
+		uint32 index = 0;
+		if (!FindValueParamIndex(name, &index))
+		{
+			return {};
+		}
+
+		return GetValueParamId(index);
+	}
+
 	const MaterialResourceDesc* MaterialTemplate::FindResource(const char* name) const
 	{
 		ASSERT(name && name[0] != '\0', "Invalid name.");
@@ -497,7 +624,8 @@ namespace shz
 		IRenderDevice* pDevice,
 		IShaderSourceInputStreamFactory* pShaderSourceFactory,
 		const char* templateName,
-		std::string* outError)
+		std::string* outError,
+		ShaderBytecodeCache* pBytecodeCache)
 	{
 		if (outError) outError->clear();
 
@@ -568,7 +696,7 @@ namespace shz
 			ci.ShaderStages.push_back(sd);
 		}
 
-		return Initialize(pDevice, pShaderSourceFactory, m_CreateInfo);
+		return Initialize(pDevice, pShaderSourceFactory, m_CreateInfo, pBytecodeCache);
 	}
 
 	bool MaterialTemplate::Save(std::string* outError) const
@@ -2,6 +2,8 @@
 #include "Engine/RuntimeData/Public/StaticMesh.h"
 
 #include <limits>
+#include <cmath>
+#include <algorithm>
 
 namespace shz
 {
@@ -136,6 +138,20 @@ namespace shz
 		}
 	}
 
+	// ------------------------------------------------------------
+	// Clusters
+	// ------------------------------------------------------------
+	void StaticMesh::ClearClusters()
+	{
+		m_Clusters.clear();
+
+		for (Section& sec : m_Sections)
+		{
+			sec.FirstCluster = 0;
+			sec.ClusterCount = 0;
+		}
+	}
+
 	// ------------------------------------------------------------
 	// Material slots
 	// ------------------------------------------------------------
@@ -210,6 +226,11 @@ namespace shz
 				return false;
 			}
 
+			if (sec.LodIndex >= GetLodCount())
+			{
+				return false;
+			}
+
 			// If materials exist, ensure section slot is within range.
 			if (!m_MaterialSlots.empty())
 			{
@@ -277,6 +298,7 @@ namespace shz
 		m_Bounds = Box(minV, maxV);
 
 		RecomputeSectionBounds();
+		RecomputeClusterBounds();
 	}
 
 	void StaticMesh::RecomputeSectionBounds()
@@ -338,6 +360,126 @@ namespace shz
 		}
 	}
 
+	void StaticMesh::RecomputeClusterBounds()
+	{
+		if (m_Clusters.empty() || !HasCPUData())
+		{
+			return;
+		}
+
+		const uint32 vertexCount = static_cast<uint32>(m_Positions.size());
+
+		std::vector<float3> triNormals;
+
+		for (const Section& sec : m_Sections)
+		{
+			for (uint32 c = sec.FirstCluster; c < sec.FirstCluster + sec.ClusterCount; ++c)
+			{
+				ASSERT(c < static_cast<uint32>(m_Clusters.size()), "Cluster index out of range.");
+				Cluster& cl = m_Clusters[c];
+
+				// Bounding sphere: AABB center + farthest vertex
+				float3 minV(
+					+std::numeric_limits<float>::infinity(),
+					+std::numeric_limits<float>::infinity(),
+					+std::numeric_limits<float>::infinity());
+
+				float3 maxV(
+					-std::numeric_limits<float>::infinity(),
+					-std::numeric_limits<float>::infinity(),
+					-std::numeric_limits<float>::infinity());
+
+				const uint32 end = cl.FirstIndex + cl.IndexCount;
+				for (uint32 i = cl.FirstIndex; i < end; ++i)
+				{
+					const uint32 idx = sec.BaseVertex + GetIndexAt(i);
+					if (idx >= vertexCount)
+					{
+						continue;
+					}
+
+					const float3& p = m_Positions[idx];
+
+					if (p.x < minV.x) { minV.x = p.x; }
+					if (p.y < minV.y) { minV.y = p.y; }
+					if (p.z < minV.z) { minV.z = p.z; }
+
+					if (p.x > maxV.x) { maxV.x = p.x; }
+					if (p.y > maxV.y) { maxV.y = p.y; }
+					if (p.z > maxV.z) { maxV.z = p.z; }
+				}
+
+				cl.Center = (minV + maxV) * 0.5f;
+
+				float maxDistSq = 0.f;
+				for (uint32 i = cl.FirstIndex; i < end; ++i)
+				{
+					const uint32 idx = sec.BaseVertex + GetIndexAt(i);
+					if (idx >= vertexCount)
+					{
+						continue;
+					}
+
+					const float distSq = (m_Positions[idx] - cl.Center).SqrMagnitude();
+					maxDistSq = std::max(maxDistSq, distSq);
+				}
+
+				cl.Radius = std::sqrt(maxDistSq);
+
+				// Normal cone over the face normals, oriented by index winding only: this is
+				// what the rasterizer culls by, vertex normals may point anywhere (smoothing, hard edges).
+				cl.ConeAxis = float3{ 0.f, 1.f, 0.f };
+				cl.ConeCutoff = 1.f;
+
+				triNormals.clear();
+				float3 axisSum = {};
+
+				for (uint32 i = cl.FirstIndex; i + 2 < end; i += 3)
+				{
+					const uint32 i0 = sec.BaseVertex + GetIndexAt(i + 0);
+					const uint32 i1 = sec.BaseVertex + GetIndexAt(i + 1);
+					const uint32 i2 = sec.BaseVertex + GetIndexAt(i + 2);
+
+					if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+					{
+						continue;
+					}
+
+					float3 n = (m_Positions[i1] - m_Positions[i0]).Cross(m_Positions[i2] - m_Positions[i0]);
+					const float len = n.Length();
+					if (len <= 1e-12f)
+					{
+						continue; // degenerate
+					}
+
+					n = n * (1.f / len);
+
+					triNormals.push_back(n);
+					axisSum += n;
+				}
+
+				const float axisLen = axisSum.Length();
+				if (triNormals.empty() || axisLen <= 1e-6f)
+				{
+					continue;
+				}
+
+				const float3 axis = axisSum * (1.f / axisLen);
+
+				float minDot = 1.f;
+				for (const float3& n : triNormals)
+				{
+					minDot = std::min(minDot, n.Dot(axis));
+				}
+
+				cl.ConeAxis = axis;
+
+				// Spread >= 90 degrees: some face always points toward any viewer.
+				cl.ConeCutoff = (minDot <= 0.f) ? 1.f : std::sqrt(std::max(0.f, 1.f - minDot * minDot));
+			}
+		}
+	}
+
 	// ------------------------------------------------------------
 	// Memory
 	// ------------------------------------------------------------
@@ -363,6 +505,8 @@ namespace shz
 		m_IndicesU16.clear();
 
 		m_Sections.clear();
+		m_Clusters.clear();
+		m_LodSwitchDistances.clear();
 		m_MaterialSlots.clear();
 
 		m_IndexType = VT_UINT32;
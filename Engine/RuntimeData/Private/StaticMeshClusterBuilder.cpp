@@ -0,0 +1,257 @@
+#include "pch.h"
+#include "Engine/RuntimeData/Public/StaticMeshClusterBuilder.h"
+
+#include <limits>
+#include <algorithm>
+
+namespace shz
+{
+	// ------------------------------------------------------------
+	// Greedy meshlet partition.
+	//
+	// Seed a cluster with the first unassigned triangle, then keep adding the
+	// neighbor (shares a vertex) that introduces the fewest new vertices,
+	// breaking ties by distance to the cluster centroid. This keeps clusters
+	// compact, which is what makes their bounding spheres and cones useful.
+	// ------------------------------------------------------------
+	template <typename IndexType>
+	static void buildSectionClusters(
+		std::vector<IndexType>& indices,
+		const std::vector<float3>& positions,
+		StaticMesh::Section& sec,
+		const StaticMeshClusterBuildSettings& s,
+		std::vector<StaticMesh::Cluster>& outClusters)
+	{
+		const uint32 triCount = sec.IndexCount / 3;
+
+		sec.FirstCluster = static_cast<uint32>(outClusters.size());
+		sec.ClusterCount = 0;
+
+		if (triCount == 0)
+		{
+			return;
+		}
+
+		if (triCount < s.MinSectionTriangles)
+		{
+			StaticMesh::Cluster cl = {};
+			cl.FirstIndex = sec.FirstIndex;
+			cl.IndexCount = triCount * 3;
+			outClusters.push_back(cl);
+			sec.ClusterCount = 1;
+			return;
+		}
+
+		const IndexType* pTri = indices.data() + sec.FirstIndex;
+
+		// Vertex -> triangle adjacency (CSR)
+		uint32 vertexSpan = 0;
+		for (uint32 i = 0; i < triCount * 3; ++i)
+		{
+			vertexSpan = std::max(vertexSpan, static_cast<uint32>(pTri[i]) + 1);
+		}
+
+		std::vector<uint32> adjOffsets(static_cast<size_t>(vertexSpan) + 1, 0);
+		for (uint32 i = 0; i < triCount * 3; ++i)
+		{
+			++adjOffsets[static_cast<size_t>(pTri[i]) + 1];
+		}
+
+		for (uint32 v = 0; v < vertexSpan; ++v)
+		{
+			adjOffsets[v + 1] += adjOffsets[v];
+		}
+
+		std::vector<uint32> adjTris(static_cast<size_t>(triCount) * 3);
+		{
+			std::vector<uint32> cursor(adjOffsets.begin(), adjOffsets.end() - 1);
+			for (uint32 t = 0; t < triCount; ++t)
+			{
+				for (uint32 k = 0; k < 3; ++k)
+				{
+					adjTris[cursor[pTri[t * 3 + k]]++] = t;
+				}
+			}
+		}
+
+		std::vector<float3> triCentroids(triCount);
+		for (uint32 t = 0; t < triCount; ++t)
+		{
+			float3 c = {};
+			for (uint32 k = 0; k < 3; ++k)
+			{
+				const uint32 idx = sec.BaseVertex + static_cast<uint32>(pTri[t * 3 + k]);
+				if (idx < static_cast<uint32>(positions.size()))
+				{
+					c += positions[idx];
+				}
+			}
+			triCentroids[t] = c * (1.f / 3.f);
+		}
+
+		std::vector<uint8> emitted(triCount, 0);
+		std::vector<uint32> vertexStamp(vertexSpan, 0);
+		std::vector<uint32> candidateStamp(triCount, 0);
+
+		std::vector<uint32> order;
+		order.reserve(triCount);
+
+		std::vector<uint32> candidates;
+		candidates.reserve(256);
+
+		uint32 stamp = 0;
+		uint32 seedCursor = 0;
+
+		while (order.size() < triCount)
+		{
+			while (emitted[seedCursor])
+			{
+				++seedCursor;
+			}
+
+			++stamp;
+			candidates.clear();
+
+			const uint32 clusterBegin = static_cast<uint32>(order.size());
+			uint32 clusterVerts = 0;
+			float3 centroidSum = {};
+
+			auto addTriangle = [&](uint32 t)
+				{
+					emitted[t] = 1;
+					order.push_back(t);
+					centroidSum += triCentroids[t];
+
+					for (uint32 k = 0; k < 3; ++k)
+					{
+						const uint32 v = pTri[t * 3 + k];
+						if (vertexStamp[v] != stamp)
+						{
+							vertexStamp[v] = stamp;
+							++clusterVerts;
+						}
+
+						for (uint32 a = adjOffsets[v]; a < adjOffsets[v + 1]; ++a)
+						{
+							const uint32 n = adjTris[a];
+							if (!emitted[n] && candidateStamp[n] != stamp)
+							{
+								candidateStamp[n] = stamp;
+								candidates.push_back(n);
+							}
+						}
+					}
+				};
+
+			addTriangle(seedCursor);
+
+			while (static_cast<uint32>(order.size()) - clusterBegin < s.MaxTriangles)
+			{
+				const float3 center = centroidSum * (1.f / static_cast<float>(order.size() - clusterBegin));
+
+				uint32 best = std::numeric_limits<uint32>::max();
+				uint32 bestNewVerts = 4;
+				float bestDistSq = std::numeric_limits<float>::infinity();
+
+				size_t write = 0;
+				for (size_t r = 0; r < candidates.size(); ++r)
+				{
+					const uint32 t = candidates[r];
+					if (emitted[t])
+					{
+						continue;
+					}
+					candidates[write++] = t;
+
+					uint32 newVerts = 0;
+					for (uint32 k = 0; k < 3; ++k)
+					{
+						newVerts += (vertexStamp[pTri[t * 3 + k]] != stamp) ? 1u : 0u;
+					}
+
+					if (clusterVerts + newVerts > s.MaxVertices)
+					{
+						continue;
+					}
+
+					const float distSq = (triCentroids[t] - center).SqrMagnitude();
+					if (newVerts < bestNewVerts || (newVerts == bestNewVerts && distSq < bestDistSq))
+					{
+						best = t;
+						bestNewVerts = newVerts;
+						bestDistSq = distSq;
+					}
+				}
+				candidates.resize(write);
+
+				if (best == std::numeric_limits<uint32>::max())
+				{
+					break;
+				}
+
+				addTriangle(best);
+			}
+
+			StaticMesh::Cluster cl = {};
+			cl.FirstIndex = sec.FirstIndex + clusterBegin * 3;
+			cl.IndexCount = (static_cast<uint32>(order.size()) - clusterBegin) * 3;
+			outClusters.push_back(cl);
+
+			++sec.ClusterCount;
+		}
+
+		// Rewrite the section in cluster order
+		std::vector<IndexType> reordered(static_cast<size_t>(triCount) * 3);
+		for (uint32 i = 0; i < triCount; ++i)
+		{
+			const uint32 t = order[i];
+			reordered[i * 3 + 0] = pTri[t * 3 + 0];
+			reordered[i * 3 + 1] = pTri[t * 3 + 1];
+			reordered[i * 3 + 2] = pTri[t * 3 + 2];
+		}
+
+		std::copy(reordered.begin(), reordered.end(), indices.begin() + sec.FirstIndex);
+	}
+
+	bool StaticMeshClusterBuilder::Build(StaticMesh* pMesh, const StaticMeshClusterBuildSettings& settings)
+	{
+		ASSERT(pMesh != nullptr, "pMesh is null.");
+		ASSERT(settings.MaxTriangles > 0 && settings.MaxVertices >= 3, "Invalid cluster limits.");
+
+		if (!pMesh->IsValid())
+		{
+			return false;
+		}
+
+		std::vector<StaticMesh::Section>& sections = pMesh->GetSections();
+		const std::vector<float3>& positions = pMesh->GetPositions();
+
+		std::vector<StaticMesh::Cluster> clusters;
+
+		for (StaticMesh::Section& sec : sections)
+		{
+			if (sec.IndexCount % 3 != 0)
+			{
+				ASSERT(false, "Section index count is not a multiple of 3.");
+				pMesh->ClearClusters();
+				return false;
+			}
+
+			if (pMesh->GetIndexType() == VT_UINT32)
+			{
+				buildSectionClusters(pMesh->GetIndicesU32(), positions, sec, settings, clusters);
+			}
+			else
+			{
+				buildSectionClusters(pMesh->GetIndicesU16(), positions, sec, settings, clusters);
+			}
+		}
+
+		pMesh->SetClusters(std::move(clusters));
+
+		// Fills cluster spheres / cones
+		pMesh->RecomputeBounds();
+
+		return true;
+	}
+} // namespace shz
@@ -9,6 +9,7 @@
 
 #include "Engine/RuntimeData/Public/StaticMesh.h"
 #include "Engine/RuntimeData/Public/Material.h"
+#include "Engine/RuntimeData/Public/MaterialLibrary.h"
 #include "Engine/AssetManager/Public/AssetTypeTraits.h"
 
 namespace shz
@@ -102,7 +103,7 @@ namespace shz
 		// JSON header
 		json j;
 		j["Format"] = "shzmesh";
-		j["Version"] = 1;
+		j["Version"] = 2;
 		j["Bin"] = binPath.filename().string();
 
 		j["VertexCount"] = mesh->GetVertexCount();
@@ -132,98 +133,35 @@ namespace shz
 				});
 		}
 
-		// Material slots (inline:   )
-		j["MaterialSlots"] = json::array();
-		for (const Material& m : mesh->GetMaterialSlots())
+		// Material slots: the materials go to the library shared by every mesh in
+		// this directory, the mesh keeps only their ids.
 		{
-			json mj;
-			mj["Name"] = m.GetName();
-			mj["TemplateName"] = m.GetTemplateName();
-			mj["RenderPassName"] = m.GetRenderPassName();
-
-			// Options (MaterialCommonOptions + extra)
-			mj["Options"] = json{
-				{"BlendMode", (int)m.GetBlendMode()},
-				{"CullMode", (int)m.GetCullMode()},
-				{"FrontCounterClockwise", m.GetFrontCounterClockwise()},
-
-				{"DepthEnable", m.GetDepthEnable()},
-				{"DepthWriteEnable", m.GetDepthWriteEnable()},
-				{"DepthFunc", (int)m.GetDepthFunc()},
-
-				{"TextureBindingMode", (int)m.GetTextureBindingMode()},
-				{"LinearWrapSamplerName", m.GetLinearWrapSamplerName()},
-				{"LinearWrapSamplerDesc", json{
-					{"MinFilter",      (int)m.GetLinearWrapSamplerDesc().MinFilter},
-					{"MagFilter",      (int)m.GetLinearWrapSamplerDesc().MagFilter},
-					{"MipFilter",      (int)m.GetLinearWrapSamplerDesc().MipFilter},
-					{"AddressU",       (int)m.GetLinearWrapSamplerDesc().AddressU},
-					{"AddressV",       (int)m.GetLinearWrapSamplerDesc().AddressV},
-					{"AddressW",       (int)m.GetLinearWrapSamplerDesc().AddressW},
-					{"MipLODBias",      m.GetLinearWrapSamplerDesc().MipLODBias},
-					{"MaxAnisotropy",   m.GetLinearWrapSamplerDesc().MaxAnisotropy},
-					{"ComparisonFunc",(int)m.GetLinearWrapSamplerDesc().ComparisonFunc},
-					{"BorderColor", {
-						m.GetLinearWrapSamplerDesc().BorderColor[0],
-						m.GetLinearWrapSamplerDesc().BorderColor[1],
-						m.GetLinearWrapSamplerDesc().BorderColor[2],
-						m.GetLinearWrapSamplerDesc().BorderColor[3],
-					}},
-					{"MinLOD", m.GetLinearWrapSamplerDesc().MinLOD},
-					{"MaxLOD", m.GetLinearWrapSamplerDesc().MaxLOD},
-				}},
-			};
-
-
-			// Values
-			mj["Values"] = json::array();
-			for (uint32 i = 0; i < m.GetValueOverrideCount(); ++i)
+			const std::filesystem::path libPath = jsonPath.parent_path() / MaterialLibrary::SHARED_FILE_NAME;
+
+			std::vector<const Material*> materials;
+			materials.reserve(mesh->GetMaterialSlots().size());
+			for (const Material& m : mesh->GetMaterialSlots())
 			{
-				const auto& v = m.GetValueOverride(i);
-				mj["Values"].push_back(json{
-					{"Name", v.Name},
-					{"Type", (int)v.Type},
-					{"Data", v.Data},
-					});
+				materials.push_back(&m);
 			}
 
-			// Resources
-			mj["Resources"] = json::array();
-			for (uint32 i = 0; i < m.GetResourceBindingCount(); ++i)
+			std::vector<AssetID> ids;
+			std::string libError;
+			if (!MaterialLibrary::Append(libPath.string(), materials, &ids, &libError))
 			{
-				const auto& r = m.GetResourceBinding(i);
-				json rj;
-				rj["Name"] = r.Name;
-				rj["Type"] = (int)r.Type;
-				rj["SourcePath"] = r.TextureRef.GetID().SourcePath;
-
-				const AssetID tid = r.TextureRef.GetID();
-				rj["TextureAssetID"] = json{ {"Hi", tid.Hi}, {"Lo", tid.Lo} };
-
-				rj["HasSamplerOverride"] = r.bHasSamplerOverride;
-				if (r.bHasSamplerOverride)
-				{
-					const auto& sd = r.SamplerOverrideDesc;
-					rj["SamplerOverrideDesc"] = json{
-						{"MinFilter",(int)sd.MinFilter},
-						{"MagFilter",(int)sd.MagFilter},
-						{"MipFilter",(int)sd.MipFilter},
-						{"AddressU",(int)sd.AddressU},
-						{"AddressV",(int)sd.AddressV},
-						{"AddressW",(int)sd.AddressW},
-						{"MipLODBias",sd.MipLODBias},
-						{"MaxAnisotropy",sd.MaxAnisotropy},
-						{"ComparisonFunc",(int)sd.ComparisonFunc},
-						{"BorderColor", json::array({ sd.BorderColor[0], sd.BorderColor[1], sd.BorderColor[2], sd.BorderColor[3] })},
-						{"MinLOD",sd.MinLOD},
-						{"MaxLOD",sd.MaxLOD},
-					};
-				}
-
-				mj["Resources"].push_back(std::move(rj));
+				setErr(pOutError, "StaticMeshAssetExporter: " + libError);
+				return false;
 			}
 
-			j["MaterialSlots"].push_back(std::move(mj));
+			j["MaterialLibrary"] = libPath.filename().string();
+			j["MaterialSlots"] = json::array();
+			for (uint32 i = 0; i < static_cast<uint32>(materials.size()); ++i)
+			{
+				j["MaterialSlots"].push_back(json{
+					{"Name", materials[i]->GetName()},
+					{"AssetID", json{ {"Hi", ids[i].Hi}, {"Lo", ids[i].Lo} }},
+					});
+			}
 		}
 
 		std::ofstream out(jsonPath, std::ios::trunc);
@@ -3,6 +3,8 @@
 
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -10,7 +12,9 @@
 #include "Engine/AssetManager/Public/AssetManager.h"
 #include "Engine/RuntimeData/Public/Texture.h"
 #include "Engine/RuntimeData/Public/StaticMesh.h"
+#include "Engine/RuntimeData/Public/StaticMeshClusterBuilder.h"
 #include "Engine/RuntimeData/Public/Material.h"
+#include "Engine/RuntimeData/Public/MaterialLibrary.h"
 
 namespace shz
 {
@@ -65,6 +69,53 @@ namespace shz
 		return d;
 	}
 
+	// ------------------------------------------------------------
+	// Material libraries of the import session
+	// ------------------------------------------------------------
+	struct StaticMeshImporter::LibraryCache final
+	{
+		std::mutex Mutex;
+		std::unordered_map<std::string, std::shared_ptr<const MaterialLibrary>> ByPath;
+	};
+
+	StaticMeshImporter::StaticMeshImporter()
+		: m_pLibraries(std::make_shared<LibraryCache>())
+	{
+	}
+
+	std::shared_ptr<const MaterialLibrary> StaticMeshImporter::acquireMaterialLibrary(
+		AssetManager& assetManager,
+		const std::string& path,
+		bool bRefresh,
+		std::string* pOutError) const
+	{
+		std::scoped_lock lock(m_pLibraries->Mutex);
+
+		std::shared_ptr<const MaterialLibrary>& entry = m_pLibraries->ByPath[path];
+		if (entry && bRefresh)
+		{
+			std::error_code ec;
+			const uint64 fileBytes = static_cast<uint64>(std::filesystem::file_size(path, ec));
+			if (!ec && fileBytes != entry->GetFileBytes())
+			{
+				entry.reset();
+			}
+		}
+
+		if (!entry)
+		{
+			std::shared_ptr<MaterialLibrary> library = std::make_shared<MaterialLibrary>();
+			if (!library->Load(assetManager, path, pOutError))
+			{
+				m_pLibraries->ByPath.erase(path);
+				return {};
+			}
+			entry = std::move(library);
+		}
+
+		return entry;
+	}
+
 	std::unique_ptr<AssetObject> StaticMeshImporter::operator()(
 		AssetManager& assetManager,
 		const AssetMeta& meta,
@@ -91,7 +142,9 @@ namespace shz
 		json j;
 		in >> j;
 
-		if (j.value("Format", "") != "shzmesh" || j.value("Version", 0) != 1)
+		// Version 1 embeds its materials; version 2 references them in a material library.
+		const int version = j.value("Version", 0);
+		if (j.value("Format", "") != "shzmesh" || (version != 1 && version != 2))
 		{
 			setErr(pOutError, "StaticMeshAssetImporter: invalid format/version.");
 			return {};
@@ -175,8 +228,62 @@ namespace shz
 			mesh.SetSections(std::move(secs));
 		}
 
+		// Material slots (by id, from the material library)
+		if (version >= 2 && j.contains("MaterialLibrary"))
+		{
+			const std::string libPath = (baseDir / j.value("MaterialLibrary", "")).lexically_normal().string();
+
+			std::shared_ptr<const MaterialLibrary> library = acquireMaterialLibrary(assetManager, libPath, false, pOutError);
+			if (!library)
+			{
+				setErr(pOutError, "StaticMeshAssetImporter: failed to load material library '" + libPath + "'.");
+				return {};
+			}
+
+			// The library is shared by the directory: a copy read before another mesh
+			// was exported into it lacks that mesh's materials.
+			bool bRefreshed = false;
+
+			std::vector<Material> mats;
+			for (const auto& sj : j.value("MaterialSlots", json::array()))
+			{
+				const auto& idj = sj.at("AssetID");
+
+				AssetID id = {};
+				id.Hi = idj.value("Hi", 0ull);
+				id.Lo = idj.value("Lo", 0ull);
+
+				const Material* pMaterial = library->FindMaterial(id);
+				if (!pMaterial && !bRefreshed)
+				{
+					bRefreshed = true;
+
+					std::shared_ptr<const MaterialLibrary> refreshed = acquireMaterialLibrary(assetManager, libPath, true, nullptr);
+					if (refreshed)
+					{
+						library = std::move(refreshed);
+						pMaterial = library->FindMaterial(id);
+					}
+				}
+
+				const std::string slotName = sj.value("Name", "");
+				if (!pMaterial)
+				{
+					setErr(pOutError, "StaticMeshAssetImporter: material '" + slotName + "' is not in '" + libPath + "'.");
+					return {};
+				}
+
+				// Library entries are deduplicated by content, so the entry may carry another mesh's name.
+				mats.push_back(*pMaterial);
+				if (!slotName.empty())
+				{
+					mats.back().SetName(slotName);
+				}
+			}
+			mesh.SetMaterialSlots(std::move(mats));
+		}
 		// Material slots (inline)
-		if (j.contains("MaterialSlots"))
+		else if (j.contains("MaterialSlots"))
 		{
 			std::vector<Material> mats;
 			for (const auto& mj : j["MaterialSlots"])
@@ -274,6 +381,13 @@ namespace shz
 			return {};
 		}
 
+		// Meshlets for CPU cluster culling (reorders triangles inside each section)
+		if (!StaticMeshClusterBuilder::Build(&mesh))
+		{
+			setErr(pOutError, "StaticMeshAssetImporter: failed to build clusters.");
+			return {};
+		}
+
 		// Rough resident bytes estimate
 		{
 			uint64 bytes = 0;
@@ -284,6 +398,7 @@ namespace shz
 			bytes += (mesh.GetIndexType() == VT_UINT16)
 				? (uint64)mesh.GetIndicesU16().size() * sizeof(uint16)
 				: (uint64)mesh.GetIndicesU32().size() * sizeof(uint32);
+			bytes += (uint64)mesh.GetClusterCount() * sizeof(StaticMesh::Cluster);
 
 			*pOutResidentBytes = bytes;
 		}
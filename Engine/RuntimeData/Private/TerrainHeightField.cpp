@@ -2,8 +2,10 @@
 #include "Engine/RuntimeData/Public/TerrainHeightField.h"
 
 #include <cmath>
+#include <algorithm>
 
 #include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Common/Public/ParallelFor.hpp"
 
 namespace shz
 {
@@ -48,6 +50,7 @@ namespace shz
 		m_DataU16.clear();
 		m_DataU16.shrink_to_fit();
 		m_CI = {};
+		m_DirtyRect = {};
 	}
 
 	// -----------------------------
@@ -85,55 +88,423 @@ namespace shz
 	}
 
 	// -----------------------------
-	// Sampling
+	// Edits
 	// -----------------------------
 
-	float TerrainHeightField::SampleNormalizedHeight(float worldX, float worldZ) const
+	TerrainDirtyRect TerrainHeightField::ApplyBrush(const TerrainBrush& brush)
 	{
 		ASSERT(IsValid(), "TerrainHeightField is not valid.");
-		ASSERT(m_CI.WorldSpacingX > 0.f, "WorldSpacingX must be greater than zero.");
-		ASSERT(m_CI.WorldSpacingZ > 0.f, "WorldSpacingZ must be greater than zero.");
-
-		// Compute origin used by TerrainMeshBuilder
-		const float sizeX = GetWorldSizeX(); // (Width - 1) * spacingX
-		const float sizeZ = GetWorldSizeZ();
-
-		const float originX = -0.5f * sizeX;
-		const float originZ = -0.5f * sizeZ;
+		ASSERT(brush.Radius > 0.f, "Brush radius must be greater than zero.");
 
-		// World -> grid coordinate (float)
-		const float gx = (worldX - originX) / m_CI.WorldSpacingX;
-		const float gz = (worldZ - originZ) / m_CI.WorldSpacingZ;
+		const float originX = -0.5f * GetWorldSizeX();
+		const float originZ = -0.5f * GetWorldSizeZ();
 
 		const float maxX = static_cast<float>(m_CI.Width - 1);
 		const float maxZ = static_cast<float>(m_CI.Height - 1);
 
-		const float x = Clamp(gx, 0.f, maxX);
-		const float z = Clamp(gz, 0.f, maxZ);
+		// Brush bounds in grid space
+		const float gx0 = (brush.CenterX - brush.Radius - originX) / m_CI.WorldSpacingX;
+		const float gx1 = (brush.CenterX + brush.Radius - originX) / m_CI.WorldSpacingX;
+		const float gz0 = (brush.CenterZ - brush.Radius - originZ) / m_CI.WorldSpacingZ;
+		const float gz1 = (brush.CenterZ + brush.Radius - originZ) / m_CI.WorldSpacingZ;
+
+		if (gx1 < 0.f || gz1 < 0.f || gx0 > maxX || gz0 > maxZ)
+		{
+			return {};
+		}
+
+		TerrainDirtyRect rect = {};
+		rect.X0 = static_cast<uint32>(std::floor(Clamp(gx0, 0.f, maxX)));
+		rect.Z0 = static_cast<uint32>(std::floor(Clamp(gz0, 0.f, maxZ)));
+		rect.X1 = static_cast<uint32>(std::ceil(Clamp(gx1, 0.f, maxX))) + 1;
+		rect.Z1 = static_cast<uint32>(std::ceil(Clamp(gz1, 0.f, maxZ))) + 1;
+
+		const uint32 rectW = rect.X1 - rect.X0;
+		const uint32 rectH = rect.Z1 - rect.Z0;
+
+		// Smooth reads neighbors, so it works from a snapshot (one-sample apron)
+		std::vector<float> snapshot;
+		uint32 snapX0 = 0;
+		uint32 snapZ0 = 0;
+		uint32 snapW = 0;
+
+		if (brush.Mode == ETerrainBrushMode::Smooth)
+		{
+			snapX0 = (rect.X0 > 0) ? (rect.X0 - 1) : 0;
+			snapZ0 = (rect.Z0 > 0) ? (rect.Z0 - 1) : 0;
+			const uint32 snapX1 = std::min(rect.X1 + 1, m_CI.Width);
+			const uint32 snapZ1 = std::min(rect.Z1 + 1, m_CI.Height);
+
+			snapW = snapX1 - snapX0;
+			snapshot.resize(static_cast<size_t>(snapW) * (snapZ1 - snapZ0));
+
+			for (uint32 z = snapZ0; z < snapZ1; ++z)
+			{
+				for (uint32 x = snapX0; x < snapX1; ++x)
+				{
+					snapshot[(z - snapZ0) * snapW + (x - snapX0)] = u16ToNormalized(m_DataU16[getIndex(x, z)]);
+				}
+			}
+		}
+
+		const float falloff = Clamp01(brush.Falloff);
+		const float invRadius = 1.f / brush.Radius;
+
+		for (uint32 j = 0; j < rectH; ++j)
+		{
+			const uint32 z = rect.Z0 + j;
+			const float dz = (originZ + static_cast<float>(z) * m_CI.WorldSpacingZ) - brush.CenterZ;
+
+			for (uint32 i = 0; i < rectW; ++i)
+			{
+				const uint32 x = rect.X0 + i;
+				const float dx = (originX + static_cast<float>(x) * m_CI.WorldSpacingX) - brush.CenterX;
+
+				const float d = std::sqrt(dx * dx + dz * dz) * invRadius;
+				if (d >= 1.f)
+				{
+					continue;
+				}
+
+				// 1 inside the core, smoothstep over the falloff band
+				float weight = 1.f;
+				if (falloff > 0.f && d > 1.f - falloff)
+				{
+					const float t = (1.f - d) / falloff;
+					weight = t * t * (3.f - 2.f * t);
+				}
+
+				const uint32 idx = getIndex(x, z);
+				const float cur = u16ToNormalized(m_DataU16[idx]);
+				float next = cur;
+
+				switch (brush.Mode)
+				{
+				case ETerrainBrushMode::Raise:
+					next = cur + brush.Strength * weight;
+					break;
+				case ETerrainBrushMode::Lower:
+					next = cur - brush.Strength * weight;
+					break;
+				case ETerrainBrushMode::Flatten:
+					next = cur + (brush.TargetHeight - cur) * Clamp01(brush.Strength * weight);
+					break;
+				case ETerrainBrushMode::Smooth:
+				{
+					float sum = 0.f;
+					float count = 0.f;
+					for (int32 oz = -1; oz <= 1; ++oz)
+					{
+						for (int32 ox = -1; ox <= 1; ++ox)
+						{
+							const int64 sx = static_cast<int64>(x) + ox;
+							const int64 sz = static_cast<int64>(z) + oz;
+							if (sx < 0 || sz < 0 || sx >= m_CI.Width || sz >= m_CI.Height)
+							{
+								continue;
+							}
+
+							sum += snapshot[(static_cast<uint32>(sz) - snapZ0) * snapW + (static_cast<uint32>(sx) - snapX0)];
+							count += 1.f;
+						}
+					}
+					next = cur + (sum / count - cur) * Clamp01(brush.Strength * weight);
+					break;
+				}
+				default:
+					ASSERT(false, "Unknown brush mode.");
+					break;
+				}
+
+				m_DataU16[idx] = normalizedToU16(next);
+			}
+		}
+
+		MarkDirty(rect);
+		return rect;
+	}
+
+	void TerrainHeightField::MarkDirty(const TerrainDirtyRect& rect)
+	{
+		TerrainDirtyRect clamped = rect;
+		clamped.X1 = std::min(clamped.X1, m_CI.Width);
+		clamped.Z1 = std::min(clamped.Z1, m_CI.Height);
+
+		m_DirtyRect.Merge(clamped);
+	}
+
+	TerrainDirtyRect TerrainHeightField::ConsumeDirtyRect()
+	{
+		const TerrainDirtyRect rect = m_DirtyRect;
+		m_DirtyRect = {};
+		return rect;
+	}
+
+	// -----------------------------
+	// Sampling
+	// -----------------------------
 
-		const uint32 x0 = static_cast<uint32>(std::floor(x));
-		const uint32 z0 = static_cast<uint32>(std::floor(z));
+	namespace
+	{
+		// Per-call constants, hoisted out of the per-point work.
+		struct SampleSetup final
+		{
+			const uint16* pData;
+			uint32 Width;
+			uint32 Height;
+			float OriginX;
+			float OriginZ;
+			float SpacingX;
+			float SpacingZ;
+			float MaxX;
+			float MaxZ;
+		};
+
+		inline float sampleNormalized(const SampleSetup& s, float worldX, float worldZ)
+		{
+			// World -> grid coordinate (float)
+			const float gx = (worldX - s.OriginX) / s.SpacingX;
+			const float gz = (worldZ - s.OriginZ) / s.SpacingZ;
+
+			const float x = Clamp(gx, 0.f, s.MaxX);
+			const float z = Clamp(gz, 0.f, s.MaxZ);
+
+			const uint32 x0 = static_cast<uint32>(std::floor(x));
+			const uint32 z0 = static_cast<uint32>(std::floor(z));
+
+			const uint32 x1 = (x0 + 1 < s.Width) ? (x0 + 1) : x0;
+			const uint32 z1 = (z0 + 1 < s.Height) ? (z0 + 1) : z0;
+
+			const float tx = x - static_cast<float>(x0);
+			const float tz = z - static_cast<float>(z0);
+
+			const float k = 1.0f / 65535.0f;
+			const float h00 = static_cast<float>(s.pData[z0 * s.Width + x0]) * k;
+			const float h10 = static_cast<float>(s.pData[z0 * s.Width + x1]) * k;
+			const float h01 = static_cast<float>(s.pData[z1 * s.Width + x0]) * k;
+			const float h11 = static_cast<float>(s.pData[z1 * s.Width + x1]) * k;
+
+			const float hx0 = h00 + (h10 - h00) * tx;
+			const float hx1 = h01 + (h11 - h01) * tx;
+			return Clamp01(hx0 + (hx1 - hx0) * tz);
+		}
+
+		inline float3 heightsToNormal(float hL, float hR, float hD, float hU, float spacingX, float spacingZ)
+		{
+			// cross(dZ, dX) with dX = (2sx, hR - hL, 0), dZ = (0, hU - hD, 2sz), scaled by 1/2
+			const float3 n = { (hL - hR) * spacingZ, 2.f * spacingX * spacingZ, (hD - hU) * spacingX };
+			return n.Normalized();
+		}
+
+		constexpr uint32 SAMPLE_BLOCK_SIZE = 4096;
+	}
+
+	static SampleSetup makeSampleSetup(const TerrainHeightField& hf)
+	{
+		ASSERT(hf.IsValid(), "TerrainHeightField is not valid.");
+		ASSERT(hf.GetWorldSpacingX() > 0.f, "WorldSpacingX must be greater than zero.");
+		ASSERT(hf.GetWorldSpacingZ() > 0.f, "WorldSpacingZ must be greater than zero.");
 
-		const uint32 x1 = (x0 + 1 < m_CI.Width) ? (x0 + 1) : x0;
-		const uint32 z1 = (z0 + 1 < m_CI.Height) ? (z0 + 1) : z0;
+		SampleSetup s = {};
+		s.pData = hf.GetDataU16().data();
+		s.Width = hf.GetWidth();
+		s.Height = hf.GetHeight();
 
-		const float tx = x - static_cast<float>(x0);
-		const float tz = z - static_cast<float>(z0);
+		// Origin used by TerrainMeshBuilder
+		s.OriginX = -0.5f * hf.GetWorldSizeX();
+		s.OriginZ = -0.5f * hf.GetWorldSizeZ();
 
-		const float h00 = GetNormalizedHeightAt(x0, z0);
-		const float h10 = GetNormalizedHeightAt(x1, z0);
-		const float h01 = GetNormalizedHeightAt(x0, z1);
-		const float h11 = GetNormalizedHeightAt(x1, z1);
+		s.SpacingX = hf.GetWorldSpacingX();
+		s.SpacingZ = hf.GetWorldSpacingZ();
 
-		const float hx0 = h00 + (h10 - h00) * tx;
-		const float hx1 = h01 + (h11 - h01) * tx;
-		return Clamp01(hx0 + (hx1 - hx0) * tz);
+		s.MaxX = static_cast<float>(s.Width - 1);
+		s.MaxZ = static_cast<float>(s.Height - 1);
+		return s;
 	}
 
+	float TerrainHeightField::SampleNormalizedHeight(float worldX, float worldZ) const
+	{
+		return sampleNormalized(makeSampleSetup(*this), worldX, worldZ);
+	}
 
 	float TerrainHeightField::SampleWorldHeight(float worldX, float worldZ) const
 	{
 		const float n = SampleNormalizedHeight(worldX, worldZ);
 		return m_CI.HeightOffset + n * m_CI.HeightScale;
 	}
+
+	float3 TerrainHeightField::SampleWorldNormal(float worldX, float worldZ) const
+	{
+		const float sx = m_CI.WorldSpacingX;
+		const float sz = m_CI.WorldSpacingZ;
+
+		const float hL = SampleWorldHeight(worldX - sx, worldZ);
+		const float hR = SampleWorldHeight(worldX + sx, worldZ);
+		const float hD = SampleWorldHeight(worldX, worldZ - sz);
+		const float hU = SampleWorldHeight(worldX, worldZ + sz);
+
+		return heightsToNormal(hL, hR, hD, hU, sx, sz);
+	}
+
+	// -----------------------------
+	// Batched sampling
+	// -----------------------------
+
+	void TerrainHeightField::sampleNormalizedRange(const float2* pWorldXZ, float* pOutHeights, uint32 count) const
+	{
+		const SampleSetup s = makeSampleSetup(*this);
+
+		uint32 i = 0;
+
+#if SHZ_HAS_SSE
+		// Same operation order as sampleNormalized() (div, not rcp; no FMA), so every lane
+		// matches the scalar result bit for bit. SSE2 has no gather, so the four texel
+		// fetches per lane stay scalar; everything around them runs four points wide.
+		const __m128 originX = _mm_set1_ps(s.OriginX);
+		const __m128 originZ = _mm_set1_ps(s.OriginZ);
+		const __m128 spacingX = _mm_set1_ps(s.SpacingX);
+		const __m128 spacingZ = _mm_set1_ps(s.SpacingZ);
+		const __m128 maxX = _mm_set1_ps(s.MaxX);
+		const __m128 maxZ = _mm_set1_ps(s.MaxZ);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 k = _mm_set1_ps(1.0f / 65535.0f);
+
+		alignas(16) int32 ix0[4];
+		alignas(16) int32 iz0[4];
+		alignas(16) float h00[4], h10[4], h01[4], h11[4];
+
+		for (; i + 4 <= count; i += 4)
+		{
+			// AoS xz pairs -> SoA
+			const __m128 p01 = _mm_loadu_ps(&pWorldXZ[i + 0].x);
+			const __m128 p23 = _mm_loadu_ps(&pWorldXZ[i + 2].x);
+			const __m128 wx = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m128 wz = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+
+			const __m128 gx = _mm_div_ps(_mm_sub_ps(wx, originX), spacingX);
+			const __m128 gz = _mm_div_ps(_mm_sub_ps(wz, originZ), spacingZ);
+
+			// Operand order reproduces Clamp(): (lo > v ? lo : v), then (hi < v ? hi : v)
+			const __m128 x = _mm_min_ps(maxX, _mm_max_ps(zero, gx));
+			const __m128 z = _mm_min_ps(maxZ, _mm_max_ps(zero, gz));
+
+			// x, z >= 0, so truncation == floor
+			const __m128i x0 = _mm_cvttps_epi32(x);
+			const __m128i z0 = _mm_cvttps_epi32(z);
+
+			const __m128 tx = _mm_sub_ps(x, _mm_cvtepi32_ps(x0));
+			const __m128 tz = _mm_sub_ps(z, _mm_cvtepi32_ps(z0));
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(ix0), x0);
+			_mm_store_si128(reinterpret_cast<__m128i*>(iz0), z0);
+
+			for (uint32 l = 0; l < 4; ++l)
+			{
+				const uint32 lx0 = static_cast<uint32>(ix0[l]);
+				const uint32 lz0 = static_cast<uint32>(iz0[l]);
+				const uint32 lx1 = (lx0 + 1 < s.Width) ? (lx0 + 1) : lx0;
+				const uint32 lz1 = (lz0 + 1 < s.Height) ? (lz0 + 1) : lz0;
+
+				h00[l] = static_cast<float>(s.pData[lz0 * s.Width + lx0]);
+				h10[l] = static_cast<float>(s.pData[lz0 * s.Width + lx1]);
+				h01[l] = static_cast<float>(s.pData[lz1 * s.Width + lx0]);
+				h11[l] = static_cast<float>(s.pData[lz1 * s.Width + lx1]);
+			}
+
+			const __m128 v00 = _mm_mul_ps(_mm_load_ps(h00), k);
+			const __m128 v10 = _mm_mul_ps(_mm_load_ps(h10), k);
+			const __m128 v01 = _mm_mul_ps(_mm_load_ps(h01), k);
+			const __m128 v11 = _mm_mul_ps(_mm_load_ps(h11), k);
+
+			const __m128 hx0 = _mm_add_ps(v00, _mm_mul_ps(_mm_sub_ps(v10, v00), tx));
+			const __m128 hx1 = _mm_add_ps(v01, _mm_mul_ps(_mm_sub_ps(v11, v01), tx));
+			const __m128 h = _mm_add_ps(hx0, _mm_mul_ps(_mm_sub_ps(hx1, hx0), tz));
+
+			_mm_storeu_ps(pOutHeights + i, _mm_min_ps(one, _mm_max_ps(zero, h)));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pOutHeights[i] = sampleNormalized(s, pWorldXZ[i].x, pWorldXZ[i].y);
+		}
+	}
+
+	void TerrainHeightField::sampleWorldNormalRange(const float2* pWorldXZ, float3* pOutNormals, uint32 count) const
+	{
+		const float sx = m_CI.WorldSpacingX;
+		const float sz = m_CI.WorldSpacingZ;
+
+		constexpr uint32 STEP = 256;
+
+		// L, R, D, U taps for up to STEP points
+		float2 taps[STEP * 4];
+		float heights[STEP * 4];
+
+		for (uint32 begin = 0; begin < count; begin += STEP)
+		{
+			const uint32 n = std::min(STEP, count - begin);
+
+			for (uint32 i = 0; i < n; ++i)
+			{
+				const float2& p = pWorldXZ[begin + i];
+				taps[i * 4 + 0] = { p.x - sx, p.y };
+				taps[i * 4 + 1] = { p.x + sx, p.y };
+				taps[i * 4 + 2] = { p.x, p.y - sz };
+				taps[i * 4 + 3] = { p.x, p.y + sz };
+			}
+
+			sampleNormalizedRange(taps, heights, n * 4);
+
+			for (uint32 i = 0; i < n; ++i)
+			{
+				const float* h = heights + i * 4;
+				pOutNormals[begin + i] = heightsToNormal(
+					m_CI.HeightOffset + h[0] * m_CI.HeightScale,
+					m_CI.HeightOffset + h[1] * m_CI.HeightScale,
+					m_CI.HeightOffset + h[2] * m_CI.HeightScale,
+					m_CI.HeightOffset + h[3] * m_CI.HeightScale,
+					sx, sz);
+			}
+		}
+	}
+
+	void TerrainHeightField::SampleNormalizedHeights(const float2* pWorldXZ, float* pOutHeights, uint32 count, uint32 numThreads) const
+	{
+		ASSERT(count == 0 || (pWorldXZ != nullptr && pOutHeights != nullptr), "Null sample buffers.");
+
+		ParallelFor(count, SAMPLE_BLOCK_SIZE, numThreads, [&](uint32 begin, uint32 end)
+			{
+				sampleNormalizedRange(pWorldXZ + begin, pOutHeights + begin, end - begin);
+			});
+	}
+
+	void TerrainHeightField::SampleWorldHeights(const float2* pWorldXZ, float* pOutHeights, uint32 count, uint32 numThreads) const
+	{
+		ASSERT(count == 0 || (pWorldXZ != nullptr && pOutHeights != nullptr), "Null sample buffers.");
+
+		const float offset = m_CI.HeightOffset;
+		const float scale = m_CI.HeightScale;
+
+		ParallelFor(count, SAMPLE_BLOCK_SIZE, numThreads, [&](uint32 begin, uint32 end)
+			{
+				sampleNormalizedRange(pWorldXZ + begin, pOutHeights + begin, end - begin);
+
+				for (uint32 i = begin; i < end; ++i)
+				{
+					pOutHeights[i] = offset + pOutHeights[i] * scale;
+				}
+			});
+	}
+
+	void TerrainHeightField::SampleWorldNormals(const float2* pWorldXZ, float3* pOutNormals, uint32 count, uint32 numThreads) const
+	{
+		ASSERT(count == 0 || (pWorldXZ != nullptr && pOutNormals != nullptr), "Null sample buffers.");
+
+		ParallelFor(count, SAMPLE_BLOCK_SIZE, numThreads, [&](uint32 begin, uint32 end)
+			{
+				sampleWorldNormalRange(pWorldXZ + begin, pOutNormals + begin, end - begin);
+			});
+	}
 }
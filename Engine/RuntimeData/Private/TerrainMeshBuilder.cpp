@@ -1,7 +1,12 @@
 #include "pch.h"
 #include "Engine/RuntimeData/Public/TerrainMeshBuilder.h"
 
+#include <cstring>
+
 #include "Engine/RuntimeData/Public/Material.h"
+#include "Engine/RuntimeData/Public/StaticMeshClusterBuilder.h"
+#include "Engine/Core/Common/Public/ParallelFor.hpp"
+#include "Engine/Core/Common/Public/Errors.hpp"
 
 namespace shz
 {
@@ -21,7 +26,7 @@ namespace shz
 	static float3 computeNormalCentralDiff(
 		const TerrainHeightField& hf,
 		uint32 x, uint32 z,
-		const TerrainMeshBuildSettings& s)
+		float normalUpBias)
 	{
 		const uint32 w = hf.GetWidth();
 		const uint32 h = hf.GetHeight();
@@ -48,7 +53,7 @@ namespace shz
 		// n = normalize( (-dx, upBias, -dz) )  where dx,dz are in world units
 		//
 		// upBias should be scaled relative to spacing to avoid overly steep normals.
-		const float up = std::max(0.001f, s.NormalUpBias);
+		const float up = std::max(0.001f, normalUpBias);
 
 		return float3{ -dx, up, -dz }.Normalized();
 	}
@@ -121,7 +126,7 @@ namespace shz
 
 				if (settings.bGenerateNormals)
 				{
-					normals[i] = computeNormalCentralDiff(hf, x, z, settings);
+					normals[i] = computeNormalCentralDiff(hf, x, z, settings.NormalUpBias);
 				}
 
 				if (settings.bGenerateTexCoords)
@@ -278,6 +283,535 @@ namespace shz
 			return false;
 		}
 
+		// ------------------------------------------------------------
+		// Clusters (lets the renderer skip off-screen / back-facing patches)
+		// ------------------------------------------------------------
+		if (settings.bBuildClusters)
+		{
+			if (!StaticMeshClusterBuilder::Build(pOutMesh))
+			{
+				ASSERT(false, "Failed to build terrain clusters.");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// ------------------------------------------------------------
+	// Chunked build
+	// ------------------------------------------------------------
+
+	// Sample offsets along one chunk axis for a LOD step. The last sample is always
+	// the chunk edge, so partial chunks and neighbors share their border vertices.
+	static void makeLodCoords(uint32 quads, uint32 step, std::vector<uint32>& out)
+	{
+		out.clear();
+		for (uint32 i = 0; i < quads; i += step)
+		{
+			out.push_back(i);
+		}
+		out.push_back(quads);
+	}
+
+	template <typename IndexType>
+	static void emitChunkIndices(
+		const std::vector<float3>& positions,
+		uint32 nx, uint32 nz,
+		const uint32 skirtBase[4],
+		uint32 lodCount,
+		bool bFlipWinding,
+		std::vector<IndexType>& outIndices,
+		std::vector<StaticMesh::Section>& outSections)
+	{
+		const uint32 gridW = nx + 1;
+
+		auto gridIdx = [gridW](uint32 i, uint32 j) { return j * gridW + i; };
+
+		auto pushTri = [&](uint32 a, uint32 b, uint32 c)
+			{
+				outIndices.push_back(static_cast<IndexType>(a));
+				if (!bFlipWinding)
+				{
+					outIndices.push_back(static_cast<IndexType>(b));
+					outIndices.push_back(static_cast<IndexType>(c));
+				}
+				else
+				{
+					outIndices.push_back(static_cast<IndexType>(c));
+					outIndices.push_back(static_cast<IndexType>(b));
+				}
+			};
+
+		// Skirt quad between top edge (ta, tb) and its lowered copy (sa, sb).
+		// Oriented to face 'outward' with the same handedness as the surface triangles.
+		auto pushSkirt = [&](uint32 ta, uint32 tb, uint32 sa, uint32 sb, const float3& outward)
+			{
+				const float3 n = (positions[tb] - positions[ta]).Cross(positions[sa] - positions[ta]);
+				if (n.Dot(outward) < 0.f)
+				{
+					pushTri(ta, tb, sa);
+					pushTri(tb, sb, sa);
+				}
+				else
+				{
+					pushTri(ta, sa, tb);
+					pushTri(tb, sa, sb);
+				}
+			};
+
+		std::vector<uint32> xs;
+		std::vector<uint32> zs;
+
+		for (uint32 lod = 0; lod < lodCount; ++lod)
+		{
+			const uint32 step = 1u << lod;
+			makeLodCoords(nx, step, xs);
+			makeLodCoords(nz, step, zs);
+
+			StaticMesh::Section sec = {};
+			sec.FirstIndex = static_cast<uint32>(outIndices.size());
+			sec.LodIndex = lod;
+			sec.MaterialSlot = 0;
+
+			// Surface: same triangulation as BuildStaticMesh
+			for (size_t zj = 0; zj + 1 < zs.size(); ++zj)
+			{
+				for (size_t xi = 0; xi + 1 < xs.size(); ++xi)
+				{
+					const uint32 i0 = gridIdx(xs[xi], zs[zj]);
+					const uint32 i1 = gridIdx(xs[xi + 1], zs[zj]);
+					const uint32 i2 = gridIdx(xs[xi], zs[zj + 1]);
+					const uint32 i3 = gridIdx(xs[xi + 1], zs[zj + 1]);
+
+					pushTri(i0, i1, i2);
+					pushTri(i1, i3, i2);
+				}
+			}
+
+			// Skirts: -Z, +Z, -X, +X edges
+			for (size_t k = 0; k + 1 < xs.size(); ++k)
+			{
+				pushSkirt(gridIdx(xs[k], 0), gridIdx(xs[k + 1], 0),
+					skirtBase[0] + xs[k], skirtBase[0] + xs[k + 1], float3{ 0.f, 0.f, -1.f });
+
+				pushSkirt(gridIdx(xs[k], nz), gridIdx(xs[k + 1], nz),
+					skirtBase[1] + xs[k], skirtBase[1] + xs[k + 1], float3{ 0.f, 0.f, 1.f });
+			}
+
+			for (size_t k = 0; k + 1 < zs.size(); ++k)
+			{
+				pushSkirt(gridIdx(0, zs[k]), gridIdx(0, zs[k + 1]),
+					skirtBase[2] + zs[k], skirtBase[2] + zs[k + 1], float3{ -1.f, 0.f, 0.f });
+
+				pushSkirt(gridIdx(nx, zs[k]), gridIdx(nx, zs[k + 1]),
+					skirtBase[3] + zs[k], skirtBase[3] + zs[k + 1], float3{ 1.f, 0.f, 0.f });
+			}
+
+			sec.IndexCount = static_cast<uint32>(outIndices.size()) - sec.FirstIndex;
+			outSections.push_back(sec);
+		}
+	}
+
+	static bool buildTerrainChunk(
+		const TerrainHeightField& hf,
+		const TerrainChunkBuildSettings& s,
+		uint32 lodCount,
+		TerrainChunk& chunk)
+	{
+		const uint32 w = hf.GetWidth();
+		const uint32 h = hf.GetHeight();
+
+		const uint32 x0 = chunk.ChunkX * s.ChunkQuads;
+		const uint32 z0 = chunk.ChunkZ * s.ChunkQuads;
+
+		const uint32 nx = std::min(s.ChunkQuads, (w - 1) - x0);
+		const uint32 nz = std::min(s.ChunkQuads, (h - 1) - z0);
+
+		const uint32 gridW = nx + 1;
+		const uint32 gridH = nz + 1;
+		const uint32 gridCount = gridW * gridH;
+		const uint32 vertexCount = gridCount + 2 * gridW + 2 * gridH;
+
+		const float spacingX = hf.GetWorldSpacingX();
+		const float spacingZ = hf.GetWorldSpacingZ();
+
+		const float originX = s.bCenterXZ ? (-0.5f * hf.GetWorldSizeX()) : 0.f;
+		const float originZ = s.bCenterXZ ? (-0.5f * hf.GetWorldSizeZ()) : 0.f;
+		const float originY = s.YOffset;
+
+		// ------------------------------------------------------------
+		// Grid vertices (+ skirt copies of the four borders)
+		// ------------------------------------------------------------
+		std::vector<float3> positions(vertexCount);
+		std::vector<float3> normals;
+		std::vector<float2> uvs;
+
+		if (s.bGenerateNormals)
+		{
+			normals.resize(vertexCount);
+		}
+
+		if (s.bGenerateTexCoords)
+		{
+			uvs.resize(vertexCount);
+		}
+
+		float minH = std::numeric_limits<float>::infinity();
+		float maxH = -std::numeric_limits<float>::infinity();
+
+		for (uint32 j = 0; j < gridH; ++j)
+		{
+			for (uint32 i = 0; i < gridW; ++i)
+			{
+				const uint32 x = x0 + i;
+				const uint32 z = z0 + j;
+				const uint32 v = j * gridW + i;
+
+				const float wy = originY + hf.GetWorldHeightAt(x, z);
+				minH = std::min(minH, wy);
+				maxH = std::max(maxH, wy);
+
+				positions[v] = float3{
+					originX + static_cast<float>(x) * spacingX,
+					wy,
+					originZ + static_cast<float>(z) * spacingZ };
+
+				if (s.bGenerateNormals)
+				{
+					normals[v] = computeNormalCentralDiff(hf, x, z, s.NormalUpBias);
+				}
+
+				if (s.bGenerateTexCoords)
+				{
+					const float u = static_cast<float>(x) / static_cast<float>(w - 1);
+					const float t = static_cast<float>(z) / static_cast<float>(h - 1);
+					uvs[v] = float2{ Clamp01(u), Clamp01(t) };
+				}
+			}
+		}
+
+		// A LOD edge can deviate from its neighbor by at most the chunk height range.
+		const float skirtDepth = (s.SkirtDepth > 0.f)
+			? s.SkirtDepth
+			: (maxH - minH) + std::max(spacingX, spacingZ);
+
+		uint32 skirtBase[4] = {};
+		skirtBase[0] = gridCount;             // -Z edge, indexed by i
+		skirtBase[1] = skirtBase[0] + gridW;  // +Z edge, indexed by i
+		skirtBase[2] = skirtBase[1] + gridW;  // -X edge, indexed by j
+		skirtBase[3] = skirtBase[2] + gridH;  // +X edge, indexed by j
+
+		auto copySkirtVertex = [&](uint32 dst, uint32 src)
+			{
+				positions[dst] = positions[src];
+				positions[dst].y -= skirtDepth;
+
+				if (s.bGenerateNormals)
+				{
+					normals[dst] = normals[src];
+				}
+
+				if (s.bGenerateTexCoords)
+				{
+					uvs[dst] = uvs[src];
+				}
+			};
+
+		for (uint32 i = 0; i < gridW; ++i)
+		{
+			copySkirtVertex(skirtBase[0] + i, i);
+			copySkirtVertex(skirtBase[1] + i, nz * gridW + i);
+		}
+
+		for (uint32 j = 0; j < gridH; ++j)
+		{
+			copySkirtVertex(skirtBase[2] + j, j * gridW);
+			copySkirtVertex(skirtBase[3] + j, j * gridW + nx);
+		}
+
+		// ------------------------------------------------------------
+		// Indices / sections (one per LOD)
+		// ------------------------------------------------------------
+		std::vector<StaticMesh::Section> sections;
+		sections.reserve(lodCount);
+
+		StaticMesh& mesh = chunk.Mesh;
+		mesh.Clear();
+
+		if (vertexCount <= 65535u)
+		{
+			std::vector<uint16> indices;
+			emitChunkIndices(positions, nx, nz, skirtBase, lodCount, s.bFlipWinding, indices, sections);
+			mesh.SetIndicesU16(std::move(indices));
+		}
+		else
+		{
+			std::vector<uint32> indices;
+			emitChunkIndices(positions, nx, nz, skirtBase, lodCount, s.bFlipWinding, indices, sections);
+			mesh.SetIndicesU32(std::move(indices));
+		}
+
+		mesh.SetPositions(std::move(positions));
+
+		if (s.bGenerateNormals)
+		{
+			mesh.SetNormals(std::move(normals));
+		}
+
+		if (s.bGenerateTexCoords)
+		{
+			mesh.SetTexCoords(std::move(uvs));
+		}
+
+		mesh.SetSections(std::move(sections));
+
+		// All chunks switch at the same distances (based on the full chunk size)
+		const float chunkWorldSize = static_cast<float>(s.ChunkQuads) * std::max(spacingX, spacingZ);
+
+		std::vector<float> lodDistances;
+		for (uint32 lod = 1; lod < lodCount; ++lod)
+		{
+			lodDistances.push_back(chunkWorldSize * s.LodDistanceFactor * static_cast<float>(1u << (lod - 1)));
+		}
+		mesh.SetLodSwitchDistances(std::move(lodDistances));
+
+		mesh.RecomputeBounds();
+
+		if (!mesh.IsValid())
+		{
+			return false;
+		}
+
+		if (s.bBuildClusters)
+		{
+			return StaticMeshClusterBuilder::Build(&mesh);
+		}
+
+		return true;
+	}
+
+	static uint32 resolveChunkLodCount(const TerrainChunkBuildSettings& s)
+	{
+		// Coarsest LOD step must still fit in a chunk
+		uint32 lodCount = std::max(s.LodCount, 1u);
+		while (lodCount > 1 && (s.ChunkQuads % (1u << (lodCount - 1))) != 0)
+		{
+			--lodCount;
+		}
+		if (lodCount != std::max(s.LodCount, 1u))
+		{
+			LOG_WARNING_MESSAGE("ChunkQuads (", s.ChunkQuads, ") is not divisible by the coarsest LOD step. LodCount was clamped from ", s.LodCount, " to ", lodCount, ".");
+		}
+
+		return lodCount;
+	}
+
+	bool TerrainMeshBuilder::BuildChunkedStaticMeshes(
+		std::vector<TerrainChunk>* pOutChunks,
+		const TerrainHeightField& hf,
+		const TerrainChunkBuildSettings& settings)
+	{
+		ASSERT(pOutChunks != nullptr, "pOutChunks is null.");
+		ASSERT(hf.IsValid(), "Heightfield is invalid.");
+		ASSERT(settings.ChunkQuads >= 2, "ChunkQuads is too small.");
+
+		const uint32 w = hf.GetWidth();
+		const uint32 h = hf.GetHeight();
+
+		ASSERT(w >= 4 && h >= 4, "Heightfield resolution is too small.");
+
+		pOutChunks->clear();
+
+		const uint32 lodCount = resolveChunkLodCount(settings);
+
+		const uint32 chunkCountX = ((w - 1) + settings.ChunkQuads - 1) / settings.ChunkQuads;
+		const uint32 chunkCountZ = ((h - 1) + settings.ChunkQuads - 1) / settings.ChunkQuads;
+		const uint32 chunkCount = chunkCountX * chunkCountZ;
+
+		pOutChunks->resize(chunkCount);
+
+		for (uint32 cz = 0; cz < chunkCountZ; ++cz)
+		{
+			for (uint32 cx = 0; cx < chunkCountX; ++cx)
+			{
+				TerrainChunk& chunk = (*pOutChunks)[cz * chunkCountX + cx];
+				chunk.ChunkX = cx;
+				chunk.ChunkZ = cz;
+			}
+		}
+
+		std::atomic<bool> bFailed = false;
+
+		ParallelFor(chunkCount, 1, settings.NumWorkerThreads, [&](uint32 begin, uint32 end)
+			{
+				for (uint32 c = begin; c < end; ++c)
+				{
+					if (!buildTerrainChunk(hf, settings, lodCount, (*pOutChunks)[c]))
+					{
+						bFailed.store(true, std::memory_order_relaxed);
+					}
+				}
+			});
+
+		if (bFailed.load())
+		{
+			ASSERT(false, "Failed to build terrain chunk.");
+			pOutChunks->clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	// Changed vertices between two builds of the same chunk layout. Runs closer than
+	// DIRTY_VERTEX_MERGE_GAP are joined: one larger upload is cheaper than many small ones.
+	static constexpr uint32 DIRTY_VERTEX_MERGE_GAP = 64;
+
+	static void diffChunkMesh(const StaticMesh& before, TerrainChunk& chunk)
+	{
+		const StaticMesh& after = chunk.Mesh;
+
+		chunk.DirtyVertexRanges.clear();
+		chunk.DirtyFirstIndex = 0;
+		chunk.DirtyIndexCount = 0;
+
+		const uint32 vertexCount = after.GetVertexCount();
+		if (before.GetVertexCount() != vertexCount || before.GetIndexCount() != after.GetIndexCount())
+		{
+			chunk.DirtyVertexRanges.push_back(StaticMesh::VertexRange{ 0, vertexCount });
+			chunk.DirtyIndexCount = after.GetIndexCount();
+			return;
+		}
+
+		const std::vector<float3>& p0 = before.GetPositions();
+		const std::vector<float3>& p1 = after.GetPositions();
+		const std::vector<float3>& n0 = before.GetNormals();
+		const std::vector<float3>& n1 = after.GetNormals();
+		const bool bCompareNormals = (n0.size() == vertexCount && n1.size() == vertexCount);
+
+		for (uint32 v = 0; v < vertexCount; ++v)
+		{
+			const bool bChanged =
+				std::memcmp(&p0[v], &p1[v], sizeof(float3)) != 0 ||
+				(bCompareNormals && std::memcmp(&n0[v], &n1[v], sizeof(float3)) != 0);
+
+			if (!bChanged)
+			{
+				continue;
+			}
+
+			if (!chunk.DirtyVertexRanges.empty())
+			{
+				StaticMesh::VertexRange& last = chunk.DirtyVertexRanges.back();
+				if (v - (last.FirstVertex + last.VertexCount) <= DIRTY_VERTEX_MERGE_GAP)
+				{
+					last.VertexCount = v + 1 - last.FirstVertex;
+					continue;
+				}
+			}
+			chunk.DirtyVertexRanges.push_back(StaticMesh::VertexRange{ v, 1 });
+		}
+
+		// Clustering orders triangles by position, so a height edit can move indices too.
+		const uint32 indexSize = (after.GetIndexType() == VT_UINT16) ? 2u : 4u;
+		const uint8* i0 = static_cast<const uint8*>(before.GetIndexData());
+		const uint8* i1 = static_cast<const uint8*>(after.GetIndexData());
+		const uint32 indexCount = after.GetIndexCount();
+
+		uint32 first = 0;
+		while (first < indexCount && std::memcmp(i0 + first * indexSize, i1 + first * indexSize, indexSize) == 0)
+		{
+			++first;
+		}
+
+		uint32 end = indexCount;
+		while (end > first && std::memcmp(i0 + (end - 1) * indexSize, i1 + (end - 1) * indexSize, indexSize) == 0)
+		{
+			--end;
+		}
+
+		chunk.DirtyFirstIndex = first;
+		chunk.DirtyIndexCount = end - first;
+	}
+
+	bool TerrainMeshBuilder::RebuildDirtyChunks(
+		std::vector<TerrainChunk>* pChunks,
+		const TerrainHeightField& hf,
+		const TerrainDirtyRect& dirtyRect,
+		const TerrainChunkBuildSettings& settings,
+		std::vector<uint32>* pOutRebuiltChunks)
+	{
+		ASSERT(pChunks != nullptr, "pChunks is null.");
+		ASSERT(hf.IsValid(), "Heightfield is invalid.");
+
+		if (dirtyRect.IsEmpty())
+		{
+			return true;
+		}
+
+		const uint32 w = hf.GetWidth();
+		const uint32 h = hf.GetHeight();
+
+		const uint32 chunkCountX = ((w - 1) + settings.ChunkQuads - 1) / settings.ChunkQuads;
+		const uint32 chunkCountZ = ((h - 1) + settings.ChunkQuads - 1) / settings.ChunkQuads;
+
+		ASSERT(pChunks->size() == static_cast<size_t>(chunkCountX) * chunkCountZ, "Chunk list does not match the heightfield.");
+
+		// Chunk c covers samples [c * Q, c * Q + Q]; its normals read one more sample on each side.
+		auto chunkRange = [&](uint32 first, uint32 last, uint32 chunkCount, uint32& outBegin, uint32& outEnd)
+			{
+				const uint32 lo = (first > 1) ? (first - 1) : 0;
+				outBegin = (lo > 0) ? ((lo - 1) / settings.ChunkQuads) : 0;
+				outEnd = std::min((last + 1) / settings.ChunkQuads + 1, chunkCount);
+			};
+
+		uint32 cxBegin = 0, cxEnd = 0;
+		uint32 czBegin = 0, czEnd = 0;
+		chunkRange(dirtyRect.X0, dirtyRect.X1 - 1, chunkCountX, cxBegin, cxEnd);
+		chunkRange(dirtyRect.Z0, dirtyRect.Z1 - 1, chunkCountZ, czBegin, czEnd);
+
+		std::vector<uint32> dirtyChunks;
+		for (uint32 cz = czBegin; cz < czEnd; ++cz)
+		{
+			for (uint32 cx = cxBegin; cx < cxEnd; ++cx)
+			{
+				dirtyChunks.push_back(cz * chunkCountX + cx);
+			}
+		}
+
+		const uint32 lodCount = resolveChunkLodCount(settings);
+
+		std::atomic<bool> bFailed = false;
+
+		ParallelFor(static_cast<uint32>(dirtyChunks.size()), 1, settings.NumWorkerThreads, [&](uint32 begin, uint32 end)
+			{
+				for (uint32 i = begin; i < end; ++i)
+				{
+					TerrainChunk& chunk = (*pChunks)[dirtyChunks[i]];
+					const StaticMesh before = std::move(chunk.Mesh);
+
+					if (!buildTerrainChunk(hf, settings, lodCount, chunk))
+					{
+						bFailed.store(true, std::memory_order_relaxed);
+						continue;
+					}
+
+					diffChunkMesh(before, chunk);
+				}
+			});
+
+		if (pOutRebuiltChunks)
+		{
+			pOutRebuiltChunks->insert(pOutRebuiltChunks->end(), dirtyChunks.begin(), dirtyChunks.end());
+		}
+
+		if (bFailed.load())
+		{
+			ASSERT(false, "Failed to rebuild terrain chunk.");
+			return false;
+		}
+
 		return true;
 	}
 } // namespace shz
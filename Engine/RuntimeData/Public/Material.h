@@ -12,6 +12,7 @@
 #include "Engine/Core/Common/Public/HashUtils.hpp"
 
 #include "Engine/AssetManager/Public/AssetRef.hpp"
+#include "Engine/GraphicsTools/Public/XXH128Hasher.hpp"
 
 #include "Engine/RHI/Interface/IShader.h"
 #include "Engine/RHI/Interface/IPipelineState.h"
@@ -45,10 +46,19 @@ namespace shz
 		ISampler* pSamplerOverride = nullptr;
 	};
 
+	// ------------------------------------------------------------
+	// MaterialKey
+	// - Canonical bytes of everything the material feeds the GPU
+	//   (see Material::BuildKey), plus their XXH128.
+	// - Equality compares the bytes, so two different materials never
+	//   share a key; the hash only picks the bucket.
+	// ------------------------------------------------------------
 	struct MaterialKey final
 	{
-		size_t Hash = 0;
-		bool operator==(const MaterialKey& rhs) const noexcept { return Hash == rhs.Hash; }
+		std::vector<uint8> Bytes = {};
+		XXH128Hash Hash = {};
+
+		bool operator==(const MaterialKey& rhs) const noexcept { return Hash == rhs.Hash && Bytes == rhs.Bytes; }
 		bool operator!=(const MaterialKey& rhs) const noexcept { return !(*this == rhs); }
 	};
 
@@ -87,6 +97,7 @@ namespace shz
 		static void RegisterTemplateLibrary(const std::unordered_map<std::string, MaterialTemplate>* pLibrary) { m_sTemplateLibrary = pLibrary; }
 
 		const std::string& GetName() const noexcept { return m_Name; }
+		void SetName(const std::string& name);
 		void SetRenderPassName(const std::string& name);
 		const std::string& GetTemplateName() const noexcept { return m_TemplateName; }
 		const std::string& GetRenderPassName() const noexcept { return m_RenderPassName; }
@@ -132,6 +143,10 @@ namespace shz
 
 		void BuildSerializedSnapshot(std::vector<MaterialSerializedValue>* outValues, std::vector<MaterialSerializedResource>* outResources) const;
 
+		// Hash of everything that reaches the GPU: template, pass, options, constant
+		// blobs and texture/sampler bindings. The material name is not part of it.
+		MaterialKey BuildKey() const;
+
 		bool SetFloat(const char* name, float v);
 		bool SetFloat2(const char* name, const float v[2]);
 		bool SetFloat2(const char* name, const float2& v);
@@ -154,6 +169,30 @@ namespace shz
 
 		bool SetRaw(const char* name, MATERIAL_VALUE_TYPE type, const void* pData, uint32 byteSize);
 
+		// Same setters addressed by a resolved id (see MaterialTemplate::FindValueParamId):
+		// no name lookup, the value is copied to the id's offset.
+		bool SetFloat(const MaterialValueParamId& id, float v);
+		bool SetFloat2(const MaterialValueParamId& id, const float2& v);
+		bool SetFloat3(const MaterialValueParamId& id, const float3& v);
+		bool SetFloat4(const MaterialValueParamId& id, const float4& v);
+
+		bool SetInt(const MaterialValueParamId& id, int32 v);
+		bool SetInt2(const MaterialValueParamId& id, const int32 v[2]);
+		bool SetInt3(const MaterialValueParamId& id, const int32 v[3]);
+		bool SetInt4(const MaterialValueParamId& id, const int32 v[4]);
+
+		bool SetUint(const MaterialValueParamId& id, uint32 v);
+		bool SetUint2(const MaterialValueParamId& id, const uint32 v[2]);
+		bool SetUint3(const MaterialValueParamId& id, const uint32 v[3]);
+		bool SetUint4(const MaterialValueParamId& id, const uint32 v[4]);
+
+		bool SetFloat4x4(const MaterialValueParamId& id, const float m16[16]);
+
+		bool SetRaw(const MaterialValueParamId& id, const void* pData, uint32 byteSize);
+
+		// Replaces a whole constant buffer; byteSize must match the template's buffer.
+		bool SetCBufferBlob(uint32 cbufferIndex, const void* pData, uint32 byteSize);
+
 		bool SetTextureAssetRef(const char* resourceName, MATERIAL_RESOURCE_TYPE expectedType, const AssetRef<Texture>& textureRef);
 		bool SetSamplerOverridePtr(const char* resourceName, ISampler* pSampler);
 		bool SetSamplerOverrideDesc(const char* resourceName, const SamplerDesc& desc);
@@ -168,6 +207,7 @@ namespace shz
 
 	private:
 		bool writeValueImmediate(const char* name, const void* pData, uint32 byteSize, MATERIAL_VALUE_TYPE expectedType);
+		bool writeValue(const MaterialValueParamId& id, const void* pData, uint32 byteSize, MATERIAL_VALUE_TYPE expectedType);
 		bool setTextureImmediate(const char* name, MATERIAL_RESOURCE_TYPE expectedType, const AssetRef<Texture>& texRef);
 
 		void rebuildAutoResourceLayout();
@@ -207,3 +247,15 @@ namespace shz
 	};
 
 } // namespace shz
+
+namespace std
+{
+	template<>
+	struct hash<shz::MaterialKey>
+	{
+		size_t operator()(const shz::MaterialKey& key) const noexcept
+		{
+			return std::hash<shz::XXH128Hash>{}(key.Hash);
+		}
+	};
+}
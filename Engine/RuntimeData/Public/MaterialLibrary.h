@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/AssetManager/Public/AssetID.hpp"
+#include "Engine/RuntimeData/Public/Material.h"
+
+namespace shz
+{
+	class AssetManager;
+
+	// ------------------------------------------------------------
+	// MaterialLibrary
+	// - Many materials in one binary file (.shzmatlib), referenced by
+	//   AssetID. Meshes store those ids instead of embedding their materials.
+	// - Ids come from the material content (MakeMaterialID), not from the
+	//   file or slot order, so equal materials of every mesh exported to a
+	//   directory share one entry of its SHARED_FILE_NAME library.
+	// - Layout: header, string table (every name and texture path once,
+	//   NUL-terminated), fixed-size material / constant buffer / resource
+	//   records, then the constant buffer blobs exactly as the template
+	//   lays them out (16-byte aligned).
+	// - Load() reads the file with one read and builds the materials
+	//   straight from the records: no parsing, blobs are copied whole.
+	// - The per-material JSON (MaterialExporter) remains the debug form.
+	// ------------------------------------------------------------
+	class MaterialLibrary final
+	{
+	public:
+		static constexpr uint32 MAGIC = 0x4C4D5A53; // "SZML"
+		static constexpr uint32 VERSION = 1;
+		static constexpr const char* SHARED_FILE_NAME = "Materials.shzmatlib";
+
+		MaterialLibrary() = default;
+		MaterialLibrary(const MaterialLibrary&) = delete;
+		MaterialLibrary& operator=(const MaterialLibrary&) = delete;
+		MaterialLibrary(MaterialLibrary&&) noexcept = default;
+		MaterialLibrary& operator=(MaterialLibrary&&) noexcept = default;
+		~MaterialLibrary() = default;
+
+		// 128-bit hash of everything the library stores for material except its name.
+		static AssetID MakeMaterialID(const Material& material);
+
+		// Adds materials to the library at path (created if missing), skipping those
+		// already in it. pOutIDs receives MakeMaterialID of each material, in order.
+		static bool Append(const std::string& path, const std::vector<const Material*>& materials,
+			std::vector<AssetID>* pOutIDs = nullptr, std::string* pOutError = nullptr);
+
+		// Textures are registered with assetManager (not loaded). Materials whose
+		// template changed its constant buffer sizes keep the template defaults.
+		bool Load(AssetManager& assetManager, const std::string& path, std::string* pOutError = nullptr);
+
+		uint32 GetMaterialCount() const noexcept { return static_cast<uint32>(m_Materials.size()); }
+		const Material& GetMaterial(uint32 index) const { return m_Materials[index]; }
+		const AssetID& GetMaterialID(uint32 index) const { return m_MaterialIDs[index]; }
+
+		// Returns null if id is not in the library.
+		const Material* FindMaterial(const AssetID& id) const noexcept;
+
+		uint64 GetFileBytes() const noexcept { return m_FileBytes; }
+
+	private:
+		std::vector<Material> m_Materials;
+		std::vector<AssetID> m_MaterialIDs;
+		std::unordered_map<AssetID, uint32> m_IndexByID;
+		uint64 m_FileBytes = 0;
+	};
+} // namespace shz
@@ -10,10 +10,18 @@
 #include "Engine/RHI/Interface/IShader.h"
 #include "Engine/RHI/Interface/IRenderDevice.h"
 
+#include "Engine/GraphicsTools/Public/ShaderBytecodeCache.h"
+
 #include "Engine/RuntimeData/Public/MaterialTypes.h"
 
 namespace shz
 {
+	struct MaterialShaderMacro final
+	{
+		std::string Name = {};
+		std::string Definition = {};
+	};
+
 	struct MaterialShaderStageDesc final
 	{
 		SHADER_TYPE ShaderType = SHADER_TYPE_UNKNOWN;
@@ -26,6 +34,8 @@ namespace shz
 		SHADER_COMPILE_FLAGS   CompileFlags = SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR;
 
 		bool UseCombinedTextureSamplers = false;
+
+		std::vector<MaterialShaderMacro> Macros = {};
 	};
 
 	struct MaterialTemplateCreateInfo final
@@ -48,6 +58,22 @@ namespace shz
 		MaterialParamFlags Flags = MaterialParamFlags_None;
 	};
 
+	// Value param resolved once (by name or index) so Material::Set*(id, ...) writes
+	// straight to ByteOffset. Only valid for materials of the template that returned it.
+	struct MaterialValueParamId final
+	{
+		static constexpr uint32 INVALID_INDEX = ~0u;
+
+		uint32 Index = INVALID_INDEX;
+		MATERIAL_VALUE_TYPE Type = MATERIAL_VALUE_TYPE_UNKNOWN;
+
+		uint32 CBufferIndex = 0;
+		uint32 ByteOffset = 0;
+		uint32 ByteSize = 0;
+
+		bool IsValid() const noexcept { return Index != INVALID_INDEX; }
+	};
+
 	struct MaterialCBufferDesc final
 	{
 		std::string Name = {};
@@ -76,8 +102,33 @@ namespace shz
 		MaterialTemplate& operator=(MaterialTemplate&&) noexcept = default;
 
 		// Creates shaders, builds reflection template.
-		bool Initialize(IRenderDevice* pDevice, IShaderSourceInputStreamFactory* pShaderSourceFactory, const MaterialTemplateCreateInfo& ci);
+		// With pBytecodeCache, shaders whose sources are unchanged are created from cached bytecode.
+		bool Initialize(
+			IRenderDevice* pDevice,
+			IShaderSourceInputStreamFactory* pShaderSourceFactory,
+			const MaterialTemplateCreateInfo& ci,
+			ShaderBytecodeCache* pBytecodeCache = nullptr);
+
+		// Initialize() split in two so several templates can compile at once:
+		// BeginInitialize() only requests the shaders (they may still be compiling
+		// when the cache compiles asynchronously), EndInitialize() waits for them
+		// and builds the reflection template.
+		bool BeginInitialize(
+			IRenderDevice* pDevice,
+			IShaderSourceInputStreamFactory* pShaderSourceFactory,
+			const MaterialTemplateCreateInfo& ci,
+			ShaderBytecodeCache* pBytecodeCache = nullptr);
+		bool EndInitialize();
+
+		// True while a shader requested by BeginInitialize() is still compiling
+		// (EndInitialize() would block).
+		bool IsCompiling() const;
+
+		// Same constant buffers, value params and resources: materials built for one
+		// template can switch to the other (e.g. after a shader reload).
+		bool HasSameLayout(const MaterialTemplate& other) const;
 
+		const MaterialTemplateCreateInfo& GetCreateInfo() const { return m_CreateInfo; }
 		const std::string& GetName() const { return m_Name; }
 		MATERIAL_PIPELINE_TYPE GetPipelineType() const { return m_PipelineType; }
 
@@ -90,6 +141,8 @@ namespace shz
 		const MaterialValueParamDesc& GetValueParam(uint32 index) const { return m_ValueParams[index]; }
 		const MaterialValueParamDesc* FindValueParam(const char* name) const;
 		bool FindValueParamIndex(const char* name, uint32* pOutIndex) const;
+		MaterialValueParamId GetValueParamId(uint32 index) const;
+		MaterialValueParamId FindValueParamId(const char* name) const; // invalid id if not found
 
 		// Constant buffers
 		uint32 GetCBufferCount() const { return static_cast<uint32>(m_CBuffers.size()); }
@@ -108,7 +161,8 @@ namespace shz
 			IRenderDevice* pDevice,
 			IShaderSourceInputStreamFactory* pShaderSourceFactory,
 			const char* TemplateName,
-			std::string* outError = nullptr);
+			std::string* outError = nullptr,
+			ShaderBytecodeCache* pBytecodeCache = nullptr);
 
 		bool Save(std::string* outError = nullptr) const;
 
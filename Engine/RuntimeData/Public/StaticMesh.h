@@ -17,8 +17,38 @@ namespace shz
 			uint32 IndexCount = 0;
 			uint32 BaseVertex = 0;     // Optional for some pipelines
 			uint32 MaterialSlot = 0;     // Index into material slots
+			uint32 LodIndex = 0;         // Drawn only when the owner selects this LOD
 
 			Box LocalBounds = {};
+
+			// Range into the cluster list (empty if clusters were not built)
+			uint32 FirstCluster = 0;
+			uint32 ClusterCount = 0;
+		};
+
+		// Small contiguous run of triangles inside a section (meshlet).
+		// Built by StaticMeshClusterBuilder, bounds are refreshed by RecomputeBounds().
+		struct Cluster final
+		{
+			uint32 FirstIndex = 0;
+			uint32 IndexCount = 0;
+
+			// Bounding sphere in mesh local space
+			float3 Center = {};
+			float Radius = 0.f;
+
+			// Normal cone in mesh local space, built from face normals (p1 - p0) x (p2 - p0).
+			// The axis points out of clockwise front faces; users flip it for counter-clockwise ones.
+			// ConeCutoff is sin(spread angle). 1 means the cone is too wide to reject anything.
+			float3 ConeAxis = { 0.f, 1.f, 0.f };
+			float ConeCutoff = 1.f;
+		};
+
+		// Run of vertices, e.g. the part of a rebuilt mesh that changed (partial GPU uploads)
+		struct VertexRange final
+		{
+			uint32 FirstVertex = 0;
+			uint32 VertexCount = 0;
 		};
 
 	public:
@@ -53,6 +83,27 @@ namespace shz
 		std::vector<Section>& GetSections() noexcept { return m_Sections; }
 		const std::vector<Section>& GetSections() const noexcept { return m_Sections; }
 
+		// ------------------------------------------------------------
+		// LODs
+		//
+		// LOD i (i >= 1) is selected once the camera is farther than
+		// LodSwitchDistances[i - 1] from the mesh bounds. Empty means a single LOD.
+		// ------------------------------------------------------------
+		void SetLodSwitchDistances(std::vector<float>&& distances) { m_LodSwitchDistances = std::move(distances); }
+		const std::vector<float>& GetLodSwitchDistances() const noexcept { return m_LodSwitchDistances; }
+
+		uint32 GetLodCount() const noexcept { return static_cast<uint32>(m_LodSwitchDistances.size()) + 1; }
+
+		// ------------------------------------------------------------
+		// Clusters (meshlets)
+		// ------------------------------------------------------------
+		bool HasClusters() const noexcept { return !m_Clusters.empty(); }
+		void SetClusters(std::vector<Cluster>&& clusters) { m_Clusters = std::move(clusters); }
+		void ClearClusters();
+
+		const std::vector<Cluster>& GetClusters() const noexcept { return m_Clusters; }
+		uint32 GetClusterCount() const noexcept { return static_cast<uint32>(m_Clusters.size()); }
+
 		// ------------------------------------------------------------
 		// Materials (slots)
 		// ------------------------------------------------------------
@@ -106,6 +157,7 @@ namespace shz
 	private:
 		uint32 GetIndexAt(uint32 i) const noexcept;
 		void RecomputeSectionBounds();
+		void RecomputeClusterBounds();
 
 	private:
 		std::vector<float3> m_Positions;
@@ -118,6 +170,8 @@ namespace shz
 		std::vector<uint16> m_IndicesU16;
 
 		std::vector<Section> m_Sections;
+		std::vector<Cluster> m_Clusters;
+		std::vector<float> m_LodSwitchDistances;
 		std::vector<Material> m_MaterialSlots;
 
 		Box m_Bounds = {};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Primitives/BasicTypes.h"
+#include "Engine/RuntimeData/Public/StaticMesh.h"
+
+namespace shz
+{
+	struct StaticMeshClusterBuildSettings final
+	{
+		// Hard limits per cluster. 124 triangles / 64 vertices is the usual meshlet budget.
+		uint32 MaxTriangles = 124;
+		uint32 MaxVertices = 64;
+
+		// Sections below this triangle count are kept as a single cluster.
+		uint32 MinSectionTriangles = 256;
+	};
+
+	class StaticMeshClusterBuilder final
+	{
+	public:
+		// Splits every section into spatially coherent clusters.
+		// Triangles are reordered inside each section so that every cluster is
+		// a contiguous index range. Section ranges and materials are unchanged.
+		static bool Build(StaticMesh* pMesh, const StaticMeshClusterBuildSettings& settings = {});
+	};
+} // namespace shz
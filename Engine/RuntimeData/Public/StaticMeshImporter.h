@@ -8,14 +8,38 @@
 namespace shz
 {
 	class AssetManager;
+	class MaterialLibrary;
 
+	// ------------------------------------------------------------
+	// StaticMeshImporter
+	// - Version 2 meshes reference their materials by id in a material library
+	//   (one per export directory). Each library file is read once and kept for
+	//   the importer's lifetime (its import session); copies of the importer share
+	//   the cache.
+	// - A slot id missing from the cached copy re-reads the file once, if it
+	//   changed size since (another mesh was exported into it).
+	// - Each slot takes the name stored in the mesh JSON: the library keeps one
+	//   entry per distinct material content, whatever it was called.
+	// ------------------------------------------------------------
 	class StaticMeshImporter final
 	{
 	public:
+		StaticMeshImporter();
+
 		std::unique_ptr<AssetObject> operator()(
 			AssetManager& assetManager,
 			const AssetMeta& meta,
 			uint64* pOutResidentBytes,
 			std::string* pOutError) const;
+
+	private:
+		// Session copy of the library at path, read on first use. bRefresh re-reads
+		// a cached copy whose size no longer matches the file.
+		std::shared_ptr<const MaterialLibrary> acquireMaterialLibrary(
+			AssetManager& assetManager, const std::string& path, bool bRefresh, std::string* pOutError) const;
+
+	private:
+		struct LibraryCache;
+		std::shared_ptr<LibraryCache> m_pLibraries;
 	};
 } // namespace shz
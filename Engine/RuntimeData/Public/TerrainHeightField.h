@@ -5,6 +5,7 @@
 #include <optional>
 
 #include "Primitives/BasicTypes.h"
+#include "Engine/Core/Math/Math.h"
 
 namespace shz
 {
@@ -38,6 +39,64 @@ namespace shz
 		}
 	};
 
+	// Sample-space rectangle [X0, X1) x [Z0, Z1)
+	struct TerrainDirtyRect final
+	{
+		uint32 X0 = 0;
+		uint32 Z0 = 0;
+		uint32 X1 = 0;
+		uint32 Z1 = 0;
+
+		bool IsEmpty() const { return (X0 >= X1) || (Z0 >= Z1); }
+
+		void Merge(const TerrainDirtyRect& other)
+		{
+			if (other.IsEmpty())
+			{
+				return;
+			}
+
+			if (IsEmpty())
+			{
+				*this = other;
+				return;
+			}
+
+			X0 = (other.X0 < X0) ? other.X0 : X0;
+			Z0 = (other.Z0 < Z0) ? other.Z0 : Z0;
+			X1 = (other.X1 > X1) ? other.X1 : X1;
+			Z1 = (other.Z1 > Z1) ? other.Z1 : Z1;
+		}
+	};
+
+	enum class ETerrainBrushMode : uint8
+	{
+		Raise = 0,
+		Lower,
+		Flatten,
+		Smooth,
+	};
+
+	struct TerrainBrush final
+	{
+		ETerrainBrushMode Mode = ETerrainBrushMode::Raise;
+
+		// World-space center / radius (same XZ convention as SampleWorldHeight)
+		float CenterX = 0.f;
+		float CenterZ = 0.f;
+		float Radius = 10.f;
+
+		// Raise/Lower: normalized height added at the center per application.
+		// Flatten/Smooth: blend factor toward the target at the center.
+		float Strength = 0.01f;
+
+		// Fraction of the radius that fades out (0 = hard edge)
+		float Falloff = 0.5f;
+
+		// Flatten only (normalized)
+		float TargetHeight = 0.5f;
+	};
+
 	class TerrainHeightField final
 	{
 	public:
@@ -71,11 +130,31 @@ namespace shz
 		float GetNormalizedHeightAt(uint32 x, uint32 z) const;
 		float GetWorldHeightAt(uint32 x, uint32 z) const;
 
+		// Does not touch the dirty rect (used by importers to fill the field).
 		void SetNormalizedHeightAt(uint32 x, uint32 z, float normalizedHeight);
 
+		// Edits
+		// Brush edits add the touched samples to the dirty rect. Consumers (chunk meshes,
+		// height texture, physics) pick the rect up once per frame with ConsumeDirtyRect.
+		TerrainDirtyRect ApplyBrush(const TerrainBrush& brush);
+
+		void MarkDirty(const TerrainDirtyRect& rect);
+		bool HasDirtyRect() const { return !m_DirtyRect.IsEmpty(); }
+		const TerrainDirtyRect& GetDirtyRect() const { return m_DirtyRect; }
+		TerrainDirtyRect ConsumeDirtyRect();
+
 		float SampleNormalizedHeight(float worldX, float worldZ) const;
 		float SampleWorldHeight(float worldX, float worldZ) const;
 
+		// Up-facing normal from central differences at +-1 sample spacing.
+		float3 SampleWorldNormal(float worldX, float worldZ) const;
+
+		// Batched sampling. Results are bit-identical to the scalar functions above.
+		// numThreads == 0 means hardware concurrency, 1 runs on the calling thread.
+		void SampleNormalizedHeights(const float2* pWorldXZ, float* pOutHeights, uint32 count, uint32 numThreads = 1) const;
+		void SampleWorldHeights(const float2* pWorldXZ, float* pOutHeights, uint32 count, uint32 numThreads = 1) const;
+		void SampleWorldNormals(const float2* pWorldXZ, float3* pOutNormals, uint32 count, uint32 numThreads = 1) const;
+
 		float GetWorldSizeX() const { return (m_CI.Width > 1) ? (static_cast<float>(m_CI.Width - 1) * m_CI.WorldSpacingX) : 0.f; }
 		float GetWorldSizeZ() const { return (m_CI.Height > 1) ? (static_cast<float>(m_CI.Height - 1) * m_CI.WorldSpacingZ) : 0.f; }
 
@@ -85,9 +164,15 @@ namespace shz
 		static float u16ToNormalized(uint16 v);
 		static uint16 normalizedToU16(float n);
 
+		void sampleNormalizedRange(const float2* pWorldXZ, float* pOutHeights, uint32 count) const;
+		void sampleWorldNormalRange(const float2* pWorldXZ, float3* pOutNormals, uint32 count) const;
+
 	private:
 		TerrainHeightFieldCreateInfo m_CI = {};
 
 		std::vector<uint16> m_DataU16 = {};
+
+		// Union of all edits since the last ConsumeDirtyRect
+		TerrainDirtyRect m_DirtyRect = {};
 	};
 }
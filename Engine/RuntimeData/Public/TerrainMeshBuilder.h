@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "Primitives/BasicTypes.h"
 #include "Engine/RuntimeData/Public/TerrainHeightField.h"
@@ -16,10 +17,52 @@ namespace shz
 		bool bPreferU16Indices = true;
 		bool bFlipWinding = false;
 		bool bCenterXZ = true;
+		bool bBuildClusters = true;
 		float YOffset = 0.f;
 		float NormalUpBias = 2.f;
 	};
 
+	struct TerrainChunkBuildSettings final
+	{
+		// Quads per chunk side at LOD0. Must be divisible by 2^(LodCount - 1).
+		uint32 ChunkQuads = 64;
+		uint32 LodCount = 4;
+
+		// LOD i starts at ChunkWorldSize * LodDistanceFactor * 2^(i - 1)
+		float LodDistanceFactor = 1.5f;
+
+		// Skirt hangs this far below the chunk edge. <= 0 derives it from the chunk height range.
+		float SkirtDepth = 0.f;
+
+		// 0 = hardware concurrency
+		uint32 NumWorkerThreads = 0;
+
+		bool bGenerateTexCoords = true;
+		bool bGenerateNormals = true;
+		bool bFlipWinding = false;
+		bool bCenterXZ = true;
+		bool bBuildClusters = true;
+		float YOffset = 0.f;
+		float NormalUpBias = 2.f;
+	};
+
+	struct TerrainChunk final
+	{
+		uint32 ChunkX = 0;
+		uint32 ChunkZ = 0;
+
+		// One section per LOD (Section::LodIndex), each including its skirts.
+		// No material slots: every chunk is drawn with the one terrain material
+		// (Renderer::CreateStaticMeshRenderData with a shared material).
+		StaticMesh Mesh = {};
+
+		// What the last RebuildDirtyChunks changed, for Renderer::UpdateStaticMeshRenderData:
+		// runs of changed vertices and the changed index range (DirtyIndexCount 0: indices unchanged).
+		std::vector<StaticMesh::VertexRange> DirtyVertexRanges = {};
+		uint32 DirtyFirstIndex = 0;
+		uint32 DirtyIndexCount = 0;
+	};
+
 	class TerrainMeshBuilder final
 	{
 	public:
@@ -30,5 +73,26 @@ namespace shz
 			const TerrainHeightField& hf,
 			Material&& terrainMaterial,
 			const TerrainMeshBuildSettings& settings = {});
+
+		// Builds fixed-size chunks (row-major, ChunkZ * ChunkCountX + ChunkX).
+		// Chunks are independent meshes with their own bounds and LOD chain,
+		// so they can be culled and LOD-selected one by one.
+		// Chunks are built in parallel.
+		static bool BuildChunkedStaticMeshes(
+			std::vector<TerrainChunk>* pOutChunks,
+			const TerrainHeightField& hf,
+			const TerrainChunkBuildSettings& settings = {});
+
+		// Rebuilds only the chunks whose vertices or normals read samples inside dirtyRect.
+		// pChunks must come from BuildChunkedStaticMeshes with the same heightfield size and settings.
+		// Vertex / index counts of a rebuilt chunk do not change, so GPU buffers can be updated in place;
+		// each rebuilt chunk records the vertices and indices that differ from its previous mesh.
+		// Indices of the rebuilt chunks are appended to pOutRebuiltChunks (optional).
+		static bool RebuildDirtyChunks(
+			std::vector<TerrainChunk>* pChunks,
+			const TerrainHeightField& hf,
+			const TerrainDirtyRect& dirtyRect,
+			const TerrainChunkBuildSettings& settings = {},
+			std::vector<uint32>* pOutRebuiltChunks = nullptr);
 	};
 } // namespace shz
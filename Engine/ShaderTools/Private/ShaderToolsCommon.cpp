@@ -459,6 +459,23 @@ namespace shz
 		}
 	}
 
+	bool FindShaderIncludes(const Char* pSource, size_t SourceLength, std::vector<ShaderIncludeDirective>& Includes) noexcept
+	{
+		if (pSource == nullptr)
+			return SourceLength == 0;
+
+		return FindIncludes(
+			pSource, SourceLength,
+			[&](const std::string& FilePath, size_t Start, size_t End) //
+			{
+				Includes.push_back({FilePath, Start, End});
+			},
+			[](const std::string& Error) //
+			{
+				LOG_ERROR_MESSAGE("Failed to find shader includes: ", Error);
+			});
+	}
+
 	static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unordered_set<std::string>& AllIncludes) noexcept(false)
 	{
 		const ShaderSourceFileData SourceData = ReadShaderSourceFile(ShaderCI);
@@ -30,6 +30,7 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "Engine/RHI/Interface/GraphicsTypes.h"
 #include "Engine/RHI/Interface/IShader.h"
@@ -137,6 +138,20 @@ namespace shz
 	// Includes are processed in a depth-first order such that original source file is processed last.
 	bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(const ShaderIncludePreprocessInfo&)> IncludeHandler) noexcept;
 
+	struct ShaderIncludeDirective
+	{
+		// The file name as written between the quotes or angle brackets.
+		std::string FilePath;
+
+		// The directive spans [Start, End) of the source: from '#' to the closing quote or bracket.
+		size_t Start = 0;
+		size_t End   = 0;
+	};
+
+	// Finds the #include directives in the source (comments are skipped) and appends them
+	// to Includes in the order they appear. Nested includes are not followed.
+	bool FindShaderIncludes(const Char* pSource, size_t SourceLength, std::vector<ShaderIncludeDirective>& Includes) noexcept;
+
 	//  Unrolls all include files into a single file
 	std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false);
 
@@ -33,6 +33,10 @@
 
 #include "Platforms/Win64/Public/Win32FileSystem.hpp"
 
+#elif PLATFORM_LINUX
+
+#include "Platforms/Linux/Public/LinuxFileSystem.hpp"
+
 #else
 #    error Unknown platform. Please define one of the following macros as 1:  PLATFORM_WIN32, PLATFORM_UNIVERSAL_WINDOWS, PLATFORM_ANDROID, PLATFORM_LINUX, PLATFORM_MACOS, PLATFORM_IOS.
 #endif
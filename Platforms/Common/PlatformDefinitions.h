@@ -45,6 +45,14 @@
 
 #    include "Platforms/Win64/Public/Win32PlatformDefinitions.h"
 
+#elif PLATFORM_LINUX
+
+#    if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS
+#        error Conflicting platform macros
+#    endif
+
+#    include "Platforms/Linux/Public/LinuxPlatformDefinitions.h"
+
 #else
 
 #    error Unsupported platform
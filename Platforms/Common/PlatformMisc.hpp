@@ -33,6 +33,10 @@
 
 #    include "Platforms/Win64/Public/Win32PlatformMisc.hpp"
 
+#elif PLATFORM_LINUX
+
+#    include "Engine/Core/Common/Public/BasicPlatformMisc.hpp"
+
 #else
 #    error Unknown platform. Please define one of the following macros as 1:  PLATFORM_WIN32, PLATFORM_UNIVERSAL_WINDOWS, PLATFORM_ANDROID, PLATFORM_LINUX, PLATFORM_MACOS, PLATFORM_IOS.
 #endif
@@ -44,6 +48,10 @@ namespace shz
 
 	using PlatformMisc = WindowsMisc;
 
+#elif PLATFORM_LINUX
+
+	using PlatformMisc = BasicPlatformMisc;
+
 #else
 #    error Unknown platform. Please define one of the following macros as 1:  PLATFORM_WIN32, PLATFORM_UNIVERSAL_WINDOWS, PLATFORM_ANDROID, PLATFORM_LINUX, PLATFORM_MACOS, PLATFORM_IOS.
 #endif
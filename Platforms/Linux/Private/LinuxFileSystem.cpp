@@ -0,0 +1,470 @@
+#include "pch.h"
+#include "LinuxFileSystem.hpp"
+#include "Engine/Core/Common/Public/Errors.hpp"
+#include "Engine/Core/Common/Public/SearchRecursive.inl"
+#include "Engine/Core/Common/Public/ObjectBase.hpp"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include <dirent.h>
+#include <glob.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace shz
+{
+
+	namespace
+	{
+		inline bool IsDot(const char* Name)
+		{
+			return Name[0] == '.' && Name[1] == 0;
+		}
+
+		inline bool IsDblDot(const char* Name)
+		{
+			return Name[0] == '.' && Name[1] == '.' && Name[2] == 0;
+		}
+
+		// lstat() so that symlinked directories are not followed (and cannot form cycles).
+		inline bool IsRealDirectory(const std::string& Path)
+		{
+			struct stat st = {};
+			return lstat(Path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+		}
+	} // namespace
+
+	LinuxFile* LinuxFileSystem::OpenFile(const FileOpenAttribs& OpenAttribs)
+	{
+		LinuxFile* pFile = nullptr;
+		try
+		{
+			pFile = new LinuxFile{ OpenAttribs };
+		}
+		catch (const std::runtime_error& /*err*/)
+		{
+		}
+
+		return pFile;
+	}
+
+	bool LinuxFileSystem::FileExists(const Char* strFilePath)
+	{
+		struct stat st = {};
+		if (stat(strFilePath, &st) != 0)
+			return false;
+
+		return !S_ISDIR(st.st_mode);
+	}
+
+	bool LinuxFileSystem::PathExists(const Char* strPath)
+	{
+		return access(strPath, F_OK) == 0;
+	}
+
+	bool LinuxFileSystem::CreateDirectory(const Char* strPath)
+	{
+		if (strPath == nullptr || strPath[0] == '\0')
+		{
+			ASSERT(false, "Path must not be null or empty");
+			return false;
+		}
+
+		// Test all parent directories
+		std::string            DirectoryPath = strPath;
+		std::string::size_type SlashPos = std::string::npos;
+		CorrectSlashes(DirectoryPath);
+
+		do
+		{
+			SlashPos = DirectoryPath.find(SlashSymbol, (SlashPos != std::string::npos) ? SlashPos + 1 : 0);
+
+			const std::string ParentDirPath = (SlashPos != std::string::npos) ? DirectoryPath.substr(0, SlashPos) : DirectoryPath;
+			if (ParentDirPath.empty())
+				continue; // Root of an absolute path
+
+			if (mkdir(ParentDirPath.c_str(), 0777) != 0)
+			{
+				// The directory may exist already or have been created by another thread, which is OK.
+				if (errno != EEXIST)
+					return false;
+
+				struct stat st = {};
+				if (stat(ParentDirPath.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+					return false;
+			}
+		} while (SlashPos != std::string::npos);
+
+		return true;
+	}
+
+	void LinuxFileSystem::ClearDirectory(const Char* strPath, bool Recursive)
+	{
+		DIR* pDir = opendir(strPath);
+		if (pDir == nullptr)
+		{
+			LOG_ERROR_MESSAGE("Failed to open directory '", strPath, "': ", std::strerror(errno));
+			return;
+		}
+
+		std::string Directory = strPath;
+		if (Directory.empty() || !IsSlash(Directory.back()))
+			Directory.push_back(SlashSymbol);
+
+		while (const dirent* pEntry = readdir(pDir))
+		{
+			if (IsDot(pEntry->d_name) || IsDblDot(pEntry->d_name))
+				continue;
+
+			const std::string EntryPath = Directory + pEntry->d_name;
+			if (IsRealDirectory(EntryPath))
+			{
+				if (Recursive)
+				{
+					ClearDirectory(EntryPath.c_str(), Recursive);
+					if (rmdir(EntryPath.c_str()) != 0)
+					{
+						LOG_ERROR_MESSAGE("Failed to remove directory '", EntryPath, "': ", std::strerror(errno));
+					}
+				}
+			}
+			else
+			{
+				DeleteFile(EntryPath.c_str());
+			}
+		}
+
+		closedir(pDir);
+	}
+
+	void LinuxFileSystem::DeleteFile(const Char* strPath)
+	{
+		if (unlink(strPath) != 0)
+		{
+			LOG_ERROR_MESSAGE("Failed to delete file '", strPath, "': ", std::strerror(errno));
+		}
+	}
+
+	void LinuxFileSystem::DeleteDirectory(const Char* strPath)
+	{
+		ClearDirectory(strPath, true);
+
+		if (rmdir(strPath) != 0)
+		{
+			LOG_ERROR_MESSAGE("Failed to remove directory '", strPath, "': ", std::strerror(errno));
+		}
+	}
+
+	bool LinuxFileSystem::IsDirectory(const Char* strPath)
+	{
+		struct stat st = {};
+		if (stat(strPath, &st) != 0)
+		{
+			LOG_WARNING_MESSAGE("Path '", strPath, "' does not exist. Use PathExists function to check if path exists.");
+			return false;
+		}
+
+		return S_ISDIR(st.st_mode);
+	}
+
+	LinuxFileSystem::SearchFilesResult LinuxFileSystem::Search(const Char* SearchPattern)
+	{
+		SearchFilesResult SearchRes;
+
+		glob_t GlobRes = {};
+		if (glob(SearchPattern, GLOB_NOSORT, nullptr, &GlobRes) != 0)
+		{
+			globfree(&GlobRes);
+			return SearchRes;
+		}
+
+		// Like FindFirstFile, report names relative to the searched directory.
+		for (size_t i = 0; i < GlobRes.gl_pathc; ++i)
+		{
+			const char* Path = GlobRes.gl_pathv[i];
+			const char* Name = std::strrchr(Path, SlashSymbol);
+			Name = (Name != nullptr) ? Name + 1 : Path;
+
+			// Skip '.' and '..' that add no value
+			if (IsDot(Name) || IsDblDot(Name))
+				continue;
+
+			struct stat st = {};
+			const bool IsDir = stat(Path, &st) == 0 && S_ISDIR(st.st_mode);
+			SearchRes.emplace_back(FindFileData{ Name, IsDir });
+		}
+
+		globfree(&GlobRes);
+		return SearchRes;
+	}
+
+	LinuxFileSystem::SearchFilesResult LinuxFileSystem::SearchRecursive(const Char* Dir, const Char* SearchPattern)
+	{
+		return shz::SearchRecursive<LinuxFileSystem>(Dir, SearchPattern);
+	}
+
+	std::string LinuxFileSystem::GetCurrentDirectory()
+	{
+		char Path[PATH_MAX] = {};
+		if (getcwd(Path, sizeof(Path)) == nullptr)
+		{
+			LOG_ERROR_MESSAGE("Failed to get the current directory: ", std::strerror(errno));
+			return {};
+		}
+		return Path;
+	}
+
+	std::string LinuxFileSystem::GetLocalAppDataDirectory(const char* AppName, bool Create)
+	{
+		// $XDG_DATA_HOME, or ~/.local/share if it is not set.
+		std::string AppDataDir;
+		if (const char* XdgDataHome = std::getenv("XDG_DATA_HOME"); XdgDataHome != nullptr && XdgDataHome[0] != '\0')
+		{
+			AppDataDir = XdgDataHome;
+		}
+		else if (const char* Home = std::getenv("HOME"); Home != nullptr && Home[0] != '\0')
+		{
+			AppDataDir = Home;
+			AppDataDir += "/.local/share";
+		}
+		else
+		{
+			return {};
+		}
+
+		if (!IsSlash(AppDataDir.back()))
+			AppDataDir.push_back(SlashSymbol);
+
+		if (AppName != nullptr)
+		{
+			AppDataDir.append(AppName);
+		}
+		else
+		{
+			char ExeFilePath[PATH_MAX] = {};
+			const ssize_t Len = readlink("/proc/self/exe", ExeFilePath, sizeof(ExeFilePath) - 1);
+			if (Len > 0)
+			{
+				std::string FileName;
+				GetPathComponents(std::string{ ExeFilePath, static_cast<size_t>(Len) }, nullptr, &FileName);
+				AppDataDir.append(FileName);
+			}
+		}
+
+		if (Create && !PathExists(AppDataDir.c_str()))
+			CreateDirectory(AppDataDir.c_str());
+
+		return AppDataDir;
+	}
+
+	// Read-only view of a mapped file.
+	class MappedFileDataBlob final : public ObjectBase<IDataBlob>
+	{
+	public:
+		using TBase = ObjectBase<IDataBlob>;
+
+		MappedFileDataBlob(IReferenceCounters* pRefCounters, void* pView, size_t Size)
+			: TBase{ pRefCounters }
+			, m_pView{ pView }
+			, m_Size{ Size }
+		{
+		}
+
+		~MappedFileDataBlob()
+		{
+			munmap(m_pView, m_Size);
+		}
+
+		IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase);
+
+		virtual void SHZ_CALL_TYPE Resize(size_t NewSize) override final
+		{
+			ASSERT(false, "Mapped file data blobs can't be resized.");
+		}
+
+		virtual size_t SHZ_CALL_TYPE GetSize() const override final
+		{
+			return m_Size;
+		}
+
+		virtual void* SHZ_CALL_TYPE GetDataPtr(size_t Offset = 0) override final
+		{
+			ASSERT(false, "Mapped file data blobs are read-only; use GetConstDataPtr().");
+			return nullptr;
+		}
+
+		virtual const void* SHZ_CALL_TYPE GetConstDataPtr(size_t Offset = 0) const override final
+		{
+			ASSERT(Offset < m_Size, "Offset (", Offset, ") exceeds the data size (", m_Size, ")");
+			return static_cast<const uint8*>(m_pView) + Offset;
+		}
+
+	private:
+		void* const  m_pView;
+		const size_t m_Size;
+	};
+
+	bool LinuxFileSystem::MapFile(const Char* strFilePath, IDataBlob** ppData)
+	{
+		ASSERT(ppData != nullptr && *ppData == nullptr, "ppData must point to a null pointer.");
+
+		const int Fd = open(strFilePath, O_RDONLY | O_CLOEXEC);
+		if (Fd < 0)
+			return false;
+
+		struct stat st = {};
+		if (fstat(Fd, &st) != 0 || st.st_size == 0)
+		{
+			close(Fd);
+			return false;
+		}
+
+		// The mapping keeps the file open; the descriptor is not needed after this.
+		const size_t Size = static_cast<size_t>(st.st_size);
+		void* pView = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Fd, 0);
+		close(Fd);
+		if (pView == MAP_FAILED)
+		{
+			LOG_ERROR_MESSAGE("Failed to map file '", strFilePath, "'.");
+			return false;
+		}
+
+		RefCntAutoPtr<MappedFileDataBlob> pBlob{ MakeNewRCObj<MappedFileDataBlob>()(pView, Size) };
+		*ppData = pBlob.Detach();
+		return true;
+	}
+
+	namespace
+	{
+		// Same changes as the Windows watch: writes, creations, deletions and renames.
+		constexpr uint32_t DIRECTORY_WATCH_MASK = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+		struct LinuxDirectoryWatch final
+		{
+			int  Fd = -1;
+			bool Recursive = false;
+
+			// Watch descriptor -> watched directory, to add directories created inside it.
+			std::unordered_map<int, std::string> Dirs;
+		};
+
+		void AddDirectoryWatch(LinuxDirectoryWatch& Watch, const std::string& DirPath)
+		{
+			const int Wd = inotify_add_watch(Watch.Fd, DirPath.c_str(), DIRECTORY_WATCH_MASK);
+			if (Wd < 0)
+			{
+				LOG_WARNING_MESSAGE("Failed to watch directory '", DirPath, "': ", std::strerror(errno));
+				return;
+			}
+			Watch.Dirs[Wd] = DirPath;
+
+			if (!Watch.Recursive)
+				return;
+
+			DIR* pDir = opendir(DirPath.c_str());
+			if (pDir == nullptr)
+				return;
+
+			while (const dirent* pEntry = readdir(pDir))
+			{
+				if (IsDot(pEntry->d_name) || IsDblDot(pEntry->d_name))
+					continue;
+
+				const std::string SubDirPath = DirPath + LinuxFileSystem::SlashSymbol + pEntry->d_name;
+				if (IsRealDirectory(SubDirPath))
+					AddDirectoryWatch(Watch, SubDirPath);
+			}
+
+			closedir(pDir);
+		}
+	} // namespace
+
+	void* LinuxFileSystem::WatchDirectory(const Char* strDirPath, bool Recursive)
+	{
+		const int Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (Fd < 0)
+		{
+			LOG_WARNING_MESSAGE("Failed to watch directory '", strDirPath, "': ", std::strerror(errno));
+			return nullptr;
+		}
+
+		auto* pWatch = new LinuxDirectoryWatch{};
+		pWatch->Fd = Fd;
+		pWatch->Recursive = Recursive;
+
+		std::string DirPath = strDirPath;
+		while (DirPath.size() > 1 && IsSlash(DirPath.back()))
+			DirPath.pop_back();
+
+		AddDirectoryWatch(*pWatch, DirPath);
+		if (pWatch->Dirs.empty())
+		{
+			CloseDirectoryWatch(pWatch);
+			return nullptr;
+		}
+
+		return pWatch;
+	}
+
+	bool LinuxFileSystem::PollDirectoryChange(void* pWatch)
+	{
+		if (pWatch == nullptr)
+			return false;
+
+		LinuxDirectoryWatch& Watch = *static_cast<LinuxDirectoryWatch*>(pWatch);
+
+		// Drain every queued event so that one burst of changes is reported once.
+		bool bChanged = false;
+		alignas(inotify_event) char Buffer[4096];
+		for (;;)
+		{
+			const ssize_t Len = read(Watch.Fd, Buffer, sizeof(Buffer));
+			if (Len <= 0)
+				break; // EAGAIN: nothing more queued
+
+			for (ssize_t Offset = 0; Offset < Len;)
+			{
+				const auto* pEvent = reinterpret_cast<const inotify_event*>(Buffer + Offset);
+				Offset += static_cast<ssize_t>(sizeof(inotify_event) + pEvent->len);
+
+				if (pEvent->mask & IN_IGNORED)
+				{
+					// The directory was removed (its deletion was reported to the parent).
+					Watch.Dirs.erase(pEvent->wd);
+					continue;
+				}
+
+				bChanged = true;
+
+				if (Watch.Recursive && (pEvent->mask & IN_ISDIR) && (pEvent->mask & (IN_CREATE | IN_MOVED_TO)) && pEvent->len != 0)
+				{
+					auto DirIt = Watch.Dirs.find(pEvent->wd);
+					if (DirIt != Watch.Dirs.end())
+						AddDirectoryWatch(Watch, DirIt->second + SlashSymbol + pEvent->name);
+				}
+			}
+		}
+
+		return bChanged;
+	}
+
+	void LinuxFileSystem::CloseDirectoryWatch(void* pWatch)
+	{
+		if (pWatch == nullptr)
+			return;
+
+		auto* pLinuxWatch = static_cast<LinuxDirectoryWatch*>(pWatch);
+		close(pLinuxWatch->Fd); // Removes all of its watches
+		delete pLinuxWatch;
+	}
+
+} // namespace shz
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include "Engine/Core/Common/Public/BasicFileSystem.hpp"
+#include "Engine/Core/Common/Public/StandardFile.hpp"
+#include "Primitives/DataBlob.h"
+
+namespace shz
+{
+
+	class LinuxFile : public StandardFile
+	{
+	public:
+		LinuxFile(const FileOpenAttribs& OpenAttribs)
+			: StandardFile{ OpenAttribs }
+		{
+		}
+	};
+
+	struct LinuxFileSystem : public BasicFileSystem
+	{
+	public:
+		static LinuxFile* OpenFile(const FileOpenAttribs& OpenAttribs);
+
+		// Maps the whole file into memory, read-only. Pages are read from the file on first
+		// access, and the mapping is released with the blob. Empty files cannot be mapped.
+		static bool MapFile(const Char* strFilePath, IDataBlob** ppData);
+
+		static bool FileExists(const Char* strFilePath);
+		static bool PathExists(const Char* strPath);
+
+		static bool CreateDirectory(const Char* strPath);
+		static void ClearDirectory(const Char* strPath, bool Recursive = false);
+		static void DeleteFile(const Char* strPath);
+		static void DeleteDirectory(const Char* strPath);
+		static bool IsDirectory(const Char* strPath);
+
+		static SearchFilesResult Search(const Char* SearchPattern);
+		static SearchFilesResult SearchRecursive(const Char* Dir, const Char* SearchPattern);
+
+		static std::string GetCurrentDirectory();
+		static std::string GetLocalAppDataDirectory(const char* AppName = nullptr, bool Create = true);
+
+		// Change notification for a directory (and its subdirectories if Recursive), see
+		// WindowsFileSystem. inotify does not watch subdirectories, so every directory of
+		// the tree gets its own watch, and directories created later are added as they appear.
+		static void* WatchDirectory(const Char* strDirPath, bool Recursive);
+		static bool  PollDirectoryChange(void* pWatch);
+		static void  CloseDirectoryWatch(void* pWatch);
+	};
+
+} // namespace shz
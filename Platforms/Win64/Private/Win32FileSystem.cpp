@@ -30,6 +30,8 @@
 #include "Engine/Core/Common/Public/Errors.hpp"
 #include "Engine/Core/Common/Public/StringTools.hpp"
 #include "Engine/Core/Common/Public/SearchRecursive.inl"
+#include "Engine/Core/Common/Public/ObjectBase.hpp"
+#include "Engine/Core/Common/Public/RefCntAutoPtr.hpp"
 
  // We can't use namespace Diligent before #including <Windows.h> because shz::INTERFACE_ID will conflict with windows InterfaceID
  //using namespace Diligent;
@@ -188,6 +190,17 @@ namespace shz
 			return _wfopen_s(ppFile, m_LongPathW.c_str(), WidenString(Mode).c_str());
 		}
 
+		HANDLE OpenForReading_() const
+		{
+			return CreateFileW(m_LongPathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		}
+
+		HANDLE WatchChanges_(bool Recursive) const
+		{
+			const DWORD Filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME;
+			return FindFirstChangeNotificationW(m_LongPathW.c_str(), Recursive ? TRUE : FALSE, Filter);
+		}
+
 		std::string operator/(const char* Path) const
 		{
 			const auto WndSlash = WindowsFileSystem::SlashSymbol;
@@ -627,4 +640,120 @@ namespace shz
 		return AppDataDir;
 	}
 
+	// Read-only view of a mapped file.
+	class MappedFileDataBlob final : public ObjectBase<IDataBlob>
+	{
+	public:
+		using TBase = ObjectBase<IDataBlob>;
+
+		MappedFileDataBlob(IReferenceCounters* pRefCounters, const void* pView, size_t Size)
+			: TBase{ pRefCounters }
+			, m_pView{ pView }
+			, m_Size{ Size }
+		{
+		}
+
+		~MappedFileDataBlob()
+		{
+			UnmapViewOfFile(m_pView);
+		}
+
+		IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase);
+
+		virtual void SHZ_CALL_TYPE Resize(size_t NewSize) override final
+		{
+			ASSERT(false, "Mapped file data blobs can't be resized.");
+		}
+
+		virtual size_t SHZ_CALL_TYPE GetSize() const override final
+		{
+			return m_Size;
+		}
+
+		virtual void* SHZ_CALL_TYPE GetDataPtr(size_t Offset = 0) override final
+		{
+			ASSERT(false, "Mapped file data blobs are read-only; use GetConstDataPtr().");
+			return nullptr;
+		}
+
+		virtual const void* SHZ_CALL_TYPE GetConstDataPtr(size_t Offset = 0) const override final
+		{
+			ASSERT(Offset < m_Size, "Offset (", Offset, ") exceeds the data size (", m_Size, ")");
+			return static_cast<const uint8*>(m_pView) + Offset;
+		}
+
+	private:
+		const void* const m_pView;
+		const size_t      m_Size;
+	};
+
+	bool WindowsFileSystem::MapFile(const Char* strFilePath, IDataBlob** ppData)
+	{
+		ASSERT(ppData != nullptr && *ppData == nullptr, "ppData must point to a null pointer.");
+
+		const WindowsPathHelper WndPath{ strFilePath };
+
+		HANDLE hFile = WndPath.OpenForReading_();
+		if (hFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER FileSize = {};
+		if (!GetFileSizeEx(hFile, &FileSize) || FileSize.QuadPart == 0)
+		{
+			CloseHandle(hFile);
+			return false;
+		}
+
+		// The view keeps the mapping (and the file) open; the handles are not needed after this.
+		HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(hFile);
+		if (hMapping == NULL)
+			return false;
+
+		const void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(hMapping);
+		if (pView == nullptr)
+		{
+			LOG_ERROR_MESSAGE("Failed to map file '", strFilePath, "'.");
+			return false;
+		}
+
+		RefCntAutoPtr<MappedFileDataBlob> pBlob{ MakeNewRCObj<MappedFileDataBlob>()(pView, static_cast<size_t>(FileSize.QuadPart)) };
+		*ppData = pBlob.Detach();
+		return true;
+	}
+
+	void* WindowsFileSystem::WatchDirectory(const Char* strDirPath, bool Recursive)
+	{
+		const WindowsPathHelper WndPath{ strDirPath };
+
+		HANDLE hChange = WndPath.WatchChanges_(Recursive);
+		if (hChange == INVALID_HANDLE_VALUE)
+		{
+			LOG_WARNING_MESSAGE("Failed to watch directory '", strDirPath, "'.");
+			return nullptr;
+		}
+
+		return hChange;
+	}
+
+	bool WindowsFileSystem::PollDirectoryChange(void* pWatch)
+	{
+		if (pWatch == nullptr)
+			return false;
+
+		if (WaitForSingleObject(static_cast<HANDLE>(pWatch), 0) != WAIT_OBJECT_0)
+			return false;
+
+		// Re-arm; changes made from here on signal the handle again.
+		FindNextChangeNotification(static_cast<HANDLE>(pWatch));
+		return true;
+	}
+
+	void WindowsFileSystem::CloseDirectoryWatch(void* pWatch)
+	{
+		if (pWatch != nullptr)
+			FindCloseChangeNotification(static_cast<HANDLE>(pWatch));
+	}
+
 } // namespace shz
@@ -30,6 +30,7 @@
 #include <memory>
 #include "Engine/Core/Common/Public/BasicFileSystem.hpp"
 #include "Engine/Core/Common/Public/StandardFile.hpp"
+#include "Primitives/DataBlob.h"
 
 #define FILE_DIALOG_SUPPORTED 1
 
@@ -47,6 +48,10 @@ struct WindowsFileSystem : public BasicFileSystem
 public:
     static WindowsFile* OpenFile(const FileOpenAttribs& OpenAttribs);
 
+    // Maps the whole file into memory, read-only. Pages are read from the file on first
+    // access, and the mapping is released with the blob. Empty files cannot be mapped.
+    static bool MapFile(const Char* strFilePath, IDataBlob** ppData);
+
     static bool FileExists(const Char* strFilePath);
     static bool PathExists(const Char* strPath);
 
@@ -66,6 +71,14 @@ public:
 
     static std::string GetCurrentDirectory();
     static std::string GetLocalAppDataDirectory(const char* AppName = nullptr, bool Create = true);
+
+    // Change notification for a directory (and its subdirectories if Recursive).
+    // WatchDirectory() returns null if the directory can't be watched. PollDirectoryChange()
+    // does not block; it returns true once for every burst of writes, creations, deletions
+    // and renames since the previous call. Which files changed is not reported.
+    static void* WatchDirectory(const Char* strDirPath, bool Recursive);
+    static bool  PollDirectoryChange(void* pWatch);
+    static void  CloseDirectoryWatch(void* pWatch);
 };
 
 } // namespace shz
@@ -1,7 +1,9 @@
 #pragma once
 #include <cstdint>
 #include <vector>
-#include <shared_mutex>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <functional>
 
 #include "Primitives/BasicTypes.h"
@@ -26,6 +28,8 @@ namespace shz
 
 		// ------------------------------------------------------------
 		// Type-local pool API
+		// - Create returns Invalid() once every index is live (the pool
+		//   holds CHUNK_SIZE * MAX_CHUNKS handles).
 		// ------------------------------------------------------------
 		static Handle Create()
 		{
@@ -42,6 +46,19 @@ namespace shz
 			return GetPool().IsAlive(h);
 		}
 
+		// Bulk variants. CreateN returns how many handles were created (the rest
+		// are Invalid() when the pool ran out). DestroyN returns how many handles
+		// were actually destroyed (invalid and stale handles are skipped).
+		static uint32 CreateN(Handle* pOutHandles, uint32 count)
+		{
+			return GetPool().CreateN(pOutHandles, count);
+		}
+
+		static uint32 DestroyN(const Handle* pHandles, uint32 count)
+		{
+			return GetPool().DestroyN(pHandles, count);
+		}
+
 		static void ResetPool()
 		{
 			GetPool().Reset();
@@ -86,103 +103,306 @@ namespace shz
 	private:
 		// ------------------------------------------------------------
 		// Pool (one per Handle<T>)
+		//
+		// - Generations live in fixed-size chunks that are never moved, so
+		//   IsAlive is two acquire loads and never takes a lock.
+		// - Destroy bumps the generation with a CAS; losing the race means the
+		//   handle was already stale.
+		// - Free indices are cached per thread and exchanged with the shared
+		//   free list in batches of FREE_BATCH, so the shared mutex is taken
+		//   once per batch instead of once per handle.
 		// ------------------------------------------------------------
 		class Pool final
 		{
 		public:
-			Pool()
+			static constexpr uint32 CHUNK_SHIFT = 14;
+			static constexpr uint32 CHUNK_SIZE = 1u << CHUNK_SHIFT;
+			static constexpr uint32 MAX_CHUNKS = 4096;
+			static constexpr uint32 FREE_BATCH = 64;
+			static constexpr uint64 MAX_INDEX_COUNT = static_cast<uint64>(CHUNK_SIZE) * MAX_CHUNKS;
+
+			Pool() = default;
+
+			Pool(const Pool&) = delete;
+			Pool& operator=(const Pool&) = delete;
+
+			~Pool()
 			{
-				// index 0 reserved for invalid
-				m_Generations.push_back(GenType{ 0 });
+				for (std::atomic<std::atomic<GenType>*>& chunk : m_Chunks)
+				{
+					delete[] chunk.load(std::memory_order_relaxed);
+				}
 			}
 
 			Handle Create()
 			{
-				std::unique_lock lock(m_Mutex);
+				LocalCache& cache = getLocalCache();
+				if (cache.Free.empty() && !refill(cache))
+				{
+					ASSERTION_FAILED("Handle pool exhausted.");
+					return Handle::Invalid();
+				}
 
-				IndexType index = 0;
+				const IndexType index = cache.Free.back();
+				cache.Free.pop_back();
 
-				if (!m_FreeList.empty())
+				return Handle{ Pack(index, generation(index).load(std::memory_order_relaxed)) };
+			}
+
+			uint32 CreateN(Handle* pOut, uint32 count)
+			{
+				ASSERT(pOut != nullptr || count == 0, "pOut is null.");
+
+				LocalCache& cache = getLocalCache();
+				for (uint32 i = 0; i < count; ++i)
 				{
-					index = m_FreeList.back();
-					m_FreeList.pop_back();
+					if (cache.Free.empty() && !refill(cache))
+					{
+						ASSERTION_FAILED("Handle pool exhausted.");
+						std::fill(pOut + i, pOut + count, Handle::Invalid());
+						return i;
+					}
+
+					const IndexType index = cache.Free.back();
+					cache.Free.pop_back();
+
+					pOut[i] = Handle{ Pack(index, generation(index).load(std::memory_order_relaxed)) };
 				}
-				else
+				return count;
+			}
+
+			bool Destroy(Handle h)
+			{
+				if (!retire(h))
 				{
-					index = static_cast<IndexType>(m_Generations.size());
-					m_Generations.push_back(GenType{ 1 }); // start generation at 1
+					return false;
 				}
 
-				const GenType gen = m_Generations[index];
-				return Handle{ Pack(index, gen) };
+				LocalCache& cache = getLocalCache();
+				cache.Free.push_back(h.GetIndex());
+				trim(cache);
+				return true;
 			}
 
-			bool Destroy(Handle h)
+			uint32 DestroyN(const Handle* pHandles, uint32 count)
+			{
+				ASSERT(pHandles != nullptr || count == 0, "pHandles is null.");
+
+				LocalCache& cache = getLocalCache();
+
+				uint32 destroyed = 0;
+				for (uint32 i = 0; i < count; ++i)
+				{
+					if (retire(pHandles[i]))
+					{
+						cache.Free.push_back(pHandles[i].GetIndex());
+						++destroyed;
+					}
+				}
+
+				trim(cache);
+				return destroyed;
+			}
+
+			bool IsAlive(Handle h) const
 			{
 				if (!h.IsValid())
 				{
 					return false;
 				}
 
-				std::unique_lock lock(m_Mutex);
+				const std::atomic<GenType>* pGen = findGeneration(h.GetIndex());
+				return pGen != nullptr && pGen->load(std::memory_order_acquire) == h.GetGeneration();
+			}
+
+			// Invalidates every handle. Must not race with other pool calls;
+			// per-thread caches notice the epoch change and drop their indices.
+			void Reset()
+			{
+				std::lock_guard lock(m_FreeMutex);
+
+				for (std::atomic<std::atomic<GenType>*>& chunk : m_Chunks)
+				{
+					std::atomic<GenType>* pChunk = chunk.load(std::memory_order_relaxed);
+					if (pChunk == nullptr)
+					{
+						continue;
+					}
+
+					for (uint32 i = 0; i < CHUNK_SIZE; ++i)
+					{
+						pChunk[i].store(GenType{ 0 }, std::memory_order_relaxed);
+					}
+				}
+
+				m_FreeList.clear();
+				m_NextIndex.store(1, std::memory_order_relaxed); // index 0 reserved for invalid
+				m_Epoch.fetch_add(1, std::memory_order_release);
+			}
+
+		private:
+			struct LocalCache final
+			{
+				Pool* pOwner = nullptr;
+				uint32 Epoch = 0;
+				std::vector<IndexType> Free;
 
-				const IndexType index = h.GetIndex();
-				if (index == 0 || index >= static_cast<IndexType>(m_Generations.size()))
+				~LocalCache()
+				{
+					// Hand indices back so they are not leaked when the thread exits.
+					if (pOwner != nullptr && !Free.empty())
+					{
+						pOwner->returnToShared(*this, static_cast<uint32>(Free.size()));
+					}
+				}
+			};
+
+			LocalCache& getLocalCache()
+			{
+				static thread_local LocalCache s_Cache;
+
+				const uint32 epoch = m_Epoch.load(std::memory_order_acquire);
+				if (s_Cache.pOwner != this || s_Cache.Epoch != epoch)
+				{
+					s_Cache.pOwner = this;
+					s_Cache.Epoch = epoch;
+					s_Cache.Free.clear();
+				}
+				return s_Cache;
+			}
+
+			// Generation CAS: exactly one caller wins for a live handle.
+			bool retire(Handle h)
+			{
+				if (!h.IsValid())
 				{
 					return false;
 				}
 
-				const GenType gen = h.GetGeneration();
-				if (m_Generations[index] != gen)
+				std::atomic<GenType>* pGen = findGeneration(h.GetIndex());
+				if (pGen == nullptr)
 				{
-					return false; // stale handle
+					return false;
 				}
 
+				GenType expected = h.GetGeneration();
+
 				// bump generation (avoid 0)
-				GenType next = m_Generations[index] + 1;
+				GenType next = expected + 1;
 				if (next == 0)
 				{
 					next = 1;
 				}
-				m_Generations[index] = next;
 
-				m_FreeList.push_back(index);
+				return pGen->compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_relaxed);
+			}
+
+			// Returns false when no index is free and none is left to hand out.
+			bool refill(LocalCache& cache)
+			{
+				{
+					std::lock_guard lock(m_FreeMutex);
+
+					const size_t take = std::min<size_t>(m_FreeList.size(), FREE_BATCH);
+					cache.Free.insert(cache.Free.end(), m_FreeList.end() - take, m_FreeList.end());
+					m_FreeList.resize(m_FreeList.size() - take);
+				}
+
+				if (!cache.Free.empty())
+				{
+					return true;
+				}
+
+				// Fresh indices. Nobody else can see them until we hand them out.
+				// A CAS instead of fetch_add, so failed calls cannot push the counter
+				// past the end and wrap it back onto live indices.
+				IndexType first = m_NextIndex.load(std::memory_order_relaxed);
+				do
+				{
+					if (static_cast<uint64>(first) + FREE_BATCH > MAX_INDEX_COUNT)
+					{
+						return false;
+					}
+				} while (!m_NextIndex.compare_exchange_weak(first, first + FREE_BATCH, std::memory_order_relaxed));
+
+				// Reverse order so Create() hands them out ascending.
+				for (IndexType index = first + FREE_BATCH; index-- > first;)
+				{
+					std::atomic<GenType>* pChunk = ensureChunk(index >> CHUNK_SHIFT);
+					pChunk[index & (CHUNK_SIZE - 1)].store(GenType{ 1 }, std::memory_order_release); // start generation at 1
+					cache.Free.push_back(index);
+				}
 				return true;
 			}
 
-			bool IsAlive(Handle h) const
+			// Keeps FREE_BATCH indices for the next Create calls and hands the rest back
+			// in one lock, however many DestroyN just added.
+			void trim(LocalCache& cache)
 			{
-				if (!h.IsValid())
+				if (cache.Free.size() >= FREE_BATCH * 2)
 				{
-					return false;
+					returnToShared(cache, static_cast<uint32>(cache.Free.size()) - FREE_BATCH);
 				}
+			}
 
-				std::shared_lock lock(m_Mutex);
+			void returnToShared(LocalCache& cache, uint32 count)
+			{
+				std::lock_guard lock(m_FreeMutex);
 
-				const IndexType index = h.GetIndex();
-				if (index == 0 || index >= static_cast<IndexType>(m_Generations.size()))
+				if (cache.Epoch != m_Epoch.load(std::memory_order_relaxed))
 				{
-					return false;
+					cache.Free.clear(); // indices belong to a pool state that was reset
+					return;
 				}
 
-				return m_Generations[index] == h.GetGeneration();
+				m_FreeList.insert(m_FreeList.end(), cache.Free.end() - count, cache.Free.end());
+				cache.Free.resize(cache.Free.size() - count);
 			}
 
-			void Reset()
+			std::atomic<GenType>* ensureChunk(uint32 chunkIndex)
+			{
+				std::atomic<GenType>* pChunk = m_Chunks[chunkIndex].load(std::memory_order_acquire);
+				if (pChunk != nullptr)
+				{
+					return pChunk;
+				}
+
+				std::atomic<GenType>* pNew = new std::atomic<GenType>[CHUNK_SIZE]();
+				if (m_Chunks[chunkIndex].compare_exchange_strong(pChunk, pNew, std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					return pNew;
+				}
+
+				delete[] pNew; // another thread installed it first
+				return pChunk;
+			}
+
+			std::atomic<GenType>* findGeneration(IndexType index) const
 			{
-				std::unique_lock lock(m_Mutex);
+				const uint32 chunkIndex = index >> CHUNK_SHIFT;
+				if (index == 0 || chunkIndex >= MAX_CHUNKS)
+				{
+					return nullptr;
+				}
 
-				m_Generations.clear();
-				m_Generations.push_back(GenType{ 0 });
+				std::atomic<GenType>* pChunk = m_Chunks[chunkIndex].load(std::memory_order_acquire);
+				return (pChunk != nullptr) ? &pChunk[index & (CHUNK_SIZE - 1)] : nullptr;
+			}
 
-				m_FreeList.clear();
+			std::atomic<GenType>& generation(IndexType index)
+			{
+				std::atomic<GenType>* pGen = findGeneration(index);
+				ASSERT(pGen != nullptr, "Handle index has no generation chunk.");
+				return *pGen;
 			}
 
 		private:
-			std::vector<GenType>   m_Generations;
-			std::vector<IndexType> m_FreeList;
+			std::atomic<std::atomic<GenType>*> m_Chunks[MAX_CHUNKS] = {};
+			std::atomic<IndexType> m_NextIndex = 1; // index 0 reserved for invalid
+			std::atomic<uint32> m_Epoch = 0;
 
-			mutable std::shared_mutex m_Mutex;
+			std::vector<IndexType> m_FreeList;
+			std::mutex m_FreeMutex;
 		};
 
 		static Pool& GetPool()
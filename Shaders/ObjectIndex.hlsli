@@ -0,0 +1,25 @@
+#ifndef OBJECT_INDEX_HLSLI
+#define OBJECT_INDEX_HLSLI
+
+// Index of the current instance in g_ObjectTable (include after HLSL_Structures.hlsli).
+//  SHZ_OBJECT_INDEX_STREAM = 1 : per-instance ATTRIB7 stream holding 0..N-1; the input
+//                                assembler offsets it by FirstInstanceLocation.
+//  otherwise                   : DRAW_CONSTANTS written before every draw.
+#ifndef SHZ_OBJECT_INDEX_STREAM
+#define SHZ_OBJECT_INDEX_STREAM 0
+#endif
+
+#if SHZ_OBJECT_INDEX_STREAM
+#define OBJECT_INDEX_VS_INPUT uint ObjectIndex : ATTRIB7;
+#define GET_OBJECT_INDEX(VSIn, instanceID) (VSIn.ObjectIndex)
+#else
+cbuffer DRAW_CONSTANTS
+{
+    DrawConstants g_DrawCB;
+};
+
+#define OBJECT_INDEX_VS_INPUT
+#define GET_OBJECT_INDEX(VSIn, instanceID) (g_DrawCB.StartInstanceLocation + (instanceID))
+#endif
+
+#endif // OBJECT_INDEX_HLSLI